@@ -17,9 +17,12 @@
 #include "file/FileWriter.h"
 #include "file/FileManager.h"
 #include "util/Buffer.h"
+#include "util/ThreadPool.h"
 #include "IReader.h"
 #include "Exception.h"
 
+#include <future>
+
 AUD_NAMESPACE_BEGIN
 
 std::shared_ptr<IWriter> FileWriter::createWriter(std::string filename,DeviceSpecs specs, Container format, Codec codec, unsigned int bitrate)
@@ -29,15 +32,22 @@ std::shared_ptr<IWriter> FileWriter::createWriter(std::string filename,DeviceSpe
 
 void FileWriter::writeReader(std::shared_ptr<IReader> reader, std::shared_ptr<IWriter> writer, unsigned int length, unsigned int buffersize, void(*callback)(float, void*), void* data)
 {
+	// the buffers are used alternately, so that the next block can be read
+	// while the previous one is still being encoded by the write thread
 	Buffer buffer(buffersize * AUD_SAMPLE_SIZE(writer->getSpecs()));
-	sample_t* buf = buffer.getBuffer();
+	Buffer buffer_next(buffersize * AUD_SAMPLE_SIZE(writer->getSpecs()));
+	sample_t* buffers[2] = {buffer.getBuffer(), buffer_next.getBuffer()};
+	ThreadPool write_thread(1);
+	std::future<void> written;
 
 	int len;
 	bool eos = false;
 	int channels = writer->getSpecs().channels;
 
-	for(unsigned int pos = 0; ((pos < length) || (length <= 0)) && !eos; pos += len)
+	for(unsigned int pos = 0, block = 0; ((pos < length) || (length <= 0)) && !eos; pos += len, block++)
 	{
+		sample_t* buf = buffers[block % 2];
+
 		len = buffersize;
 		if((len > length - pos) && (length > 0))
 			len = length - pos;
@@ -52,7 +62,10 @@ void FileWriter::writeReader(std::shared_ptr<IReader> reader, std::shared_ptr<IW
 				buf[i] = -1;
 		}
 
-		writer->write(len, buf);
+		// the previous block has to be written before this one, its buffer is read into next
+		if(written.valid())
+			written.get();
+		written = write_thread.enqueue([writer, len, buf]() { writer->write(len, buf); });
 
 		if(callback)
 		{
@@ -62,41 +75,55 @@ void FileWriter::writeReader(std::shared_ptr<IReader> reader, std::shared_ptr<IW
 			callback(progress, data);
 		}
 	}
+
+	if(written.valid())
+		written.get();
 }
 
 void FileWriter::writeReader(std::shared_ptr<IReader> reader, std::vector<std::shared_ptr<IWriter> >& writers, unsigned int length, unsigned int buffersize, void(*callback)(float, void*), void* data)
 {
+	// see the single writer version above, the channels are split in the write thread
 	Buffer buffer(buffersize * AUD_SAMPLE_SIZE(reader->getSpecs()));
+	Buffer buffer_next(buffersize * AUD_SAMPLE_SIZE(reader->getSpecs()));
+	sample_t* buffers[2] = {buffer.getBuffer(), buffer_next.getBuffer()};
 	Buffer buffer2(buffersize * sizeof(sample_t));
-	sample_t* buf = buffer.getBuffer();
 	sample_t* buf2 = buffer2.getBuffer();
+	ThreadPool write_thread(1);
+	std::future<void> written;
 
 	int len;
 	bool eos = false;
 	int channels = reader->getSpecs().channels;
 
-	for(unsigned int pos = 0; ((pos < length) || (length <= 0)) && !eos; pos += len)
+	for(unsigned int pos = 0, block = 0; ((pos < length) || (length <= 0)) && !eos; pos += len, block++)
 	{
+		sample_t* buf = buffers[block % 2];
+
 		len = buffersize;
 		if((len > length - pos) && (length > 0))
 			len = length - pos;
 		reader->read(len, eos, buf);
 
-		for(int channel = 0; channel < channels; channel++)
+		if(written.valid())
+			written.get();
+		written = write_thread.enqueue([&writers, channels, len, buf, buf2]()
 		{
-			for(int i = 0; i < len; i++)
+			for(int channel = 0; channel < channels; channel++)
 			{
-				// clamping!
-				if(buf[i * channels + channel] > 1)
-					buf2[i] = 1;
-				else if(buf[i * channels + channel] < -1)
-					buf2[i] = -1;
-				else
-					buf2[i] = buf[i * channels + channel];
+				for(int i = 0; i < len; i++)
+				{
+					// clamping!
+					if(buf[i * channels + channel] > 1)
+						buf2[i] = 1;
+					else if(buf[i * channels + channel] < -1)
+						buf2[i] = -1;
+					else
+						buf2[i] = buf[i * channels + channel];
+				}
+
+				writers[channel]->write(len, buf2);
 			}
-
-			writers[channel]->write(len, buf2);
-		}
+		});
 
 		if(callback)
 		{
@@ -106,6 +133,9 @@ void FileWriter::writeReader(std::shared_ptr<IReader> reader, std::vector<std::s
 			callback(progress, data);
 		}
 	}
+
+	if(written.valid())
+		written.get();
 }
 
 AUD_NAMESPACE_END
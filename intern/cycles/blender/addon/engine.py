@@ -67,6 +67,9 @@ def _configure_argument_parser():
     parser.add_argument("--cycles-resumable-end-chunk",
                         help="End chunk to render",
                         default=None)
+    parser.add_argument("--cycles-checkpoint-dir",
+                        help="Directory to store finished tiles in, to resume interrupted renders",
+                        default=None)
     parser.add_argument("--cycles-print-stats",
                         help="Print rendering statistics to stderr",
                         action='store_true')
@@ -103,6 +106,10 @@ def _parse_command_line():
                 int(args.cycles_resumable_start_chunk),
                 int(args.cycles_resumable_end_chunk),
             )
+    if args.cycles_checkpoint_dir:
+        import _cycles
+        _cycles.set_checkpoint_directory(args.cycles_checkpoint_dir)
+
     if args.cycles_print_stats:
         import _cycles
         _cycles.enable_print_stats()
@@ -233,6 +240,12 @@ def system_info():
     return _cycles.system_info()
 
 
+def device_kernel_stats():
+    """Kernel statistics of the GPU devices for the last render with --cycles-print-stats."""
+    import _cycles
+    return _cycles.get_device_kernel_stats()
+
+
 def list_render_passes(scene, srl):
     # Builtin Blender passes.
     yield ("Combined", "RGBA", 'COLOR')
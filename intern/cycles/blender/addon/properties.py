@@ -397,6 +397,12 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         min=0.0, max=1.0,
         default=0.01,
     )
+    use_light_tree: BoolProperty(
+        name="Light Tree",
+        description="Sample lights according to their estimated contribution to the shading point, "
+        "reduces noise in scenes with many lights. Not used when sampling all lights",
+        default=False,
+    )
 
     use_adaptive_sampling: BoolProperty(
         name="Use Adaptive Sampling",
@@ -315,6 +315,7 @@ class CYCLES_RENDER_PT_sampling_advanced(CyclesButtonsPanel, Panel):
         col.prop(cscene, "min_light_bounces")
         col.prop(cscene, "min_transparent_bounces")
         col.prop(cscene, "light_sampling_threshold", text="Light Threshold")
+        col.prop(cscene, "use_light_tree")
 
         if cscene.progressive != 'PATH' and use_branched_path(context):
             col = layout.column(align=True)
@@ -180,6 +180,11 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
   return geom;
 }
 
+bool BlenderSync::geometry_is_synced(Geometry *geom) const
+{
+  return geometry_synced.find(geom) != geometry_synced.end();
+}
+
 void BlenderSync::sync_geometry_motion(BL::Depsgraph &b_depsgraph,
                                        BL::Object &b_ob,
                                        Object *object,
@@ -36,8 +36,33 @@
 
 #include "mikktspace.h"
 
+#include "DNA_meshdata_types.h"
+
 CCL_NAMESPACE_BEGIN
 
+/* Direct Mesh Data Access
+ *
+ * The RNA collections of a mesh are backed by contiguous DNA arrays, reading them directly
+ * avoids the overhead of the RNA API for every element of large meshes. */
+
+template<typename T, typename Collection> static const T *mesh_array(Collection &collection)
+{
+  if (collection.length() == 0) {
+    return NULL;
+  }
+  return static_cast<const T *>(collection[0].ptr.data);
+}
+
+static inline float3 mesh_vertex_co(const MVert &vert)
+{
+  return make_float3(vert.co[0], vert.co[1], vert.co[2]);
+}
+
+static inline float3 mesh_vertex_normal(const MVert &vert)
+{
+  return make_float3(vert.no[0], vert.no[1], vert.no[2]) * (1.0f / 32767.0f);
+}
+
 /* Tangent Space */
 
 struct MikkUserData {
@@ -405,12 +430,15 @@ static void attr_create_uv_map(Scene *scene, Mesh *mesh, BL::Mesh &b_mesh)
         }
 
         float2 *fdata = uv_attr->data_float2();
-
-        for (BL::MeshLoopTriangle &t : b_mesh.loop_triangles) {
-          int3 li = get_int3(t.loops());
-          fdata[0] = get_float2(l.data[li[0]].uv());
-          fdata[1] = get_float2(l.data[li[1]].uv());
-          fdata[2] = get_float2(l.data[li[2]].uv());
+        const MLoopUV *b_uvs = mesh_array<MLoopUV>(l.data);
+        const MLoopTri *b_looptris = mesh_array<MLoopTri>(b_mesh.loop_triangles);
+        const int numtris = b_mesh.loop_triangles.length();
+
+        for (int i = 0; i < numtris; i++) {
+          const unsigned int *li = b_looptris[i].tri;
+          fdata[0] = make_float2(b_uvs[li[0]].uv[0], b_uvs[li[0]].uv[1]);
+          fdata[1] = make_float2(b_uvs[li[1]].uv[0], b_uvs[li[1]].uv[1]);
+          fdata[2] = make_float2(b_uvs[li[2]].uv[0], b_uvs[li[2]].uv[1]);
           fdata += 3;
         }
       }
@@ -472,11 +500,15 @@ static void attr_create_subd_uv_map(Scene *scene, Mesh *mesh, BL::Mesh &b_mesh,
         }
 
         float2 *fdata = uv_attr->data_float2();
-
-        for (BL::MeshPolygon &p : b_mesh.polygons) {
-          int n = p.loop_total();
-          for (int j = 0; j < n; j++) {
-            *(fdata++) = get_float2(l->data[p.loop_start() + j].uv());
+        const MLoopUV *b_uvs = mesh_array<MLoopUV>(l->data);
+        const MPoly *b_polys = mesh_array<MPoly>(b_mesh.polygons);
+        const int numpolys = b_mesh.polygons.length();
+
+        for (int i = 0; i < numpolys; i++) {
+          const MPoly &p = b_polys[i];
+          for (int j = 0; j < p.totloop; j++) {
+            const MLoopUV &uv = b_uvs[p.loopstart + j];
+            *(fdata++) = make_float2(uv.uv[0], uv.uv[1]);
           }
         }
       }
@@ -590,9 +622,10 @@ static void attr_create_pointiness(Scene *scene, Mesh *mesh, BL::Mesh &b_mesh, b
    *         duplicates which gets "welded" together.
    */
   vector<float3> vert_normal(num_verts, make_float3(0.0f, 0.0f, 0.0f));
+  const MVert *b_verts = mesh_array<MVert>(b_mesh.vertices);
   /* First we accumulate all vertex normals in the original index. */
   for (int vert_index = 0; vert_index < num_verts; ++vert_index) {
-    const float3 normal = get_float3(b_mesh.vertices[vert_index].normal());
+    const float3 normal = mesh_vertex_normal(b_verts[vert_index]);
     const int orig_index = vert_orig_index[vert_index];
     vert_normal[orig_index] += normal;
   }
@@ -739,13 +772,18 @@ static void create_mesh(Scene *scene,
     return;
   }
 
+  const MVert *b_verts = mesh_array<MVert>(b_mesh.vertices);
+  const MLoop *b_loops = mesh_array<MLoop>(b_mesh.loops);
+  const MPoly *b_polys = mesh_array<MPoly>(b_mesh.polygons);
+  const int numpolys = b_mesh.polygons.length();
+
   if (!subdivision) {
     numtris = numfaces;
   }
   else {
-    for (BL::MeshPolygon &p : b_mesh.polygons) {
-      numngons += (p.loop_total() == 4) ? 0 : 1;
-      numcorners += p.loop_total();
+    for (int i = 0; i < numpolys; i++) {
+      numngons += (b_polys[i].totloop == 4) ? 0 : 1;
+      numcorners += b_polys[i].totloop;
     }
   }
 
@@ -757,17 +795,15 @@ static void create_mesh(Scene *scene,
   mesh->reserve_mesh(numverts, numtris);
 
   /* create vertex coordinates and normals */
-  BL::Mesh::vertices_iterator v;
-  for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v)
-    mesh->add_vertex(get_float3(v->co()));
+  for (int i = 0; i < numverts; i++)
+    mesh->add_vertex(mesh_vertex_co(b_verts[i]));
 
   AttributeSet &attributes = (subdivision) ? mesh->subd_attributes : mesh->attributes;
   Attribute *attr_N = attributes.add(ATTR_STD_VERTEX_NORMAL);
   float3 *N = attr_N->data_float3();
 
-  for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v, ++N)
-    *N = get_float3(v->normal());
-  N = attr_N->data_float3();
+  for (int i = 0; i < numverts; i++)
+    N[i] = mesh_vertex_normal(b_verts[i]);
 
   /* create generated coordinates from undeformed coordinates */
   const bool need_default_tangent = (subdivision == false) && (b_mesh.uv_layers.length() == 0) &&
@@ -782,6 +818,7 @@ static void create_mesh(Scene *scene,
     float3 *generated = attr->data_float3();
     size_t i = 0;
 
+    BL::Mesh::vertices_iterator v;
     for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v) {
       generated[i++] = get_float3(v->undeformed_co()) * size - loc;
     }
@@ -789,15 +826,20 @@ static void create_mesh(Scene *scene,
 
   /* create faces */
   if (!subdivision) {
-    for (BL::MeshLoopTriangle &t : b_mesh.loop_triangles) {
-      BL::MeshPolygon p = b_mesh.polygons[t.polygon_index()];
-      int3 vi = get_int3(t.vertices());
+    const MLoopTri *b_looptris = mesh_array<MLoopTri>(b_mesh.loop_triangles);
+
+    for (int t = 0; t < numtris; t++) {
+      const MLoopTri &looptri = b_looptris[t];
+      const MPoly &p = b_polys[looptri.poly];
+      int3 vi = make_int3(b_loops[looptri.tri[0]].v,
+                          b_loops[looptri.tri[1]].v,
+                          b_loops[looptri.tri[2]].v);
 
-      int shader = clamp(p.material_index(), 0, used_shaders.size() - 1);
-      bool smooth = p.use_smooth() || use_loop_normals;
+      int shader = clamp((int)p.mat_nr, 0, used_shaders.size() - 1);
+      bool smooth = (p.flag & ME_SMOOTH) || use_loop_normals;
 
       if (use_loop_normals) {
-        BL::Array<float, 9> loop_normals = t.split_normals();
+        BL::Array<float, 9> loop_normals = b_mesh.loop_triangles[t].split_normals();
         for (int i = 0; i < 3; i++) {
           N[vi[i]] = make_float3(
               loop_normals[i * 3], loop_normals[i * 3 + 1], loop_normals[i * 3 + 2]);
@@ -814,15 +856,16 @@ static void create_mesh(Scene *scene,
   else {
     vector<int> vi;
 
-    for (BL::MeshPolygon &p : b_mesh.polygons) {
-      int n = p.loop_total();
-      int shader = clamp(p.material_index(), 0, used_shaders.size() - 1);
-      bool smooth = p.use_smooth() || use_loop_normals;
+    for (int i = 0; i < numpolys; i++) {
+      const MPoly &p = b_polys[i];
+      int n = p.totloop;
+      int shader = clamp((int)p.mat_nr, 0, used_shaders.size() - 1);
+      bool smooth = (p.flag & ME_SMOOTH) || use_loop_normals;
 
       vi.resize(n);
-      for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
         /* NOTE: Autosmooth is already taken care about. */
-        vi[i] = b_mesh.loops[p.loop_start() + i].vertex_index();
+        vi[j] = b_loops[p.loopstart + j].v;
       }
 
       /* create subd faces */
@@ -1125,12 +1168,12 @@ void BlenderSync::sync_mesh_motion(BL::Depsgraph b_depsgraph,
     /* NOTE: We don't copy more that existing amount of vertices to prevent
      * possible memory corruption.
      */
-    BL::Mesh::vertices_iterator v;
-    int i = 0;
-    for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end() && i < numverts; ++v, ++i) {
-      mP[i] = get_float3(v->co());
+    const MVert *b_verts = mesh_array<MVert>(b_mesh.vertices);
+    const size_t num_copy = min(numverts, (size_t)b_mesh.vertices.length());
+    for (size_t i = 0; i < num_copy; i++) {
+      mP[i] = mesh_vertex_co(b_verts[i]);
       if (mN)
-        mN[i] = get_float3(v->normal());
+        mN[i] = mesh_vertex_normal(b_verts[i]);
     }
     if (new_attribute) {
       /* In case of new attribute, we verify if there really was any motion. */
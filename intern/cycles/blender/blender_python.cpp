@@ -949,12 +949,62 @@ static PyObject *clear_resumable_chunk_func(PyObject * /*self*/, PyObject * /*va
   Py_RETURN_NONE;
 }
 
+static PyObject *set_checkpoint_directory_func(PyObject * /*self*/, PyObject *arg)
+{
+  PyObject *directory_string = PyObject_Str(arg);
+  string directory = PyUnicode_AsUTF8(directory_string);
+  Py_DECREF(directory_string);
+
+  if (!path_is_directory(directory)) {
+    fprintf(stderr, "Cycles: Checkpoint directory %s does not exist.\n", directory.c_str());
+    Py_RETURN_FALSE;
+  }
+
+  VLOG(1) << "Render checkpoints in " << directory;
+  BlenderSession::checkpoint_directory = directory;
+
+  printf("Cycles: Will write render checkpoints to %s\n", directory.c_str());
+
+  Py_RETURN_TRUE;
+}
+
 static PyObject *enable_print_stats_func(PyObject * /*self*/, PyObject * /*args*/)
 {
   BlenderSession::print_render_stats = true;
   Py_RETURN_NONE;
 }
 
+static PyObject *get_device_kernel_stats_func(PyObject * /*self*/, PyObject * /*args*/)
+{
+  const DeviceKernelStats &stats = BlenderSession::device_kernel_stats;
+
+  PyObject *kernels = PyDict_New();
+  for (const pair<const string, ProfilingDeviceKernel> &entry : stats.kernels) {
+    const ProfilingDeviceKernel &kernel = entry.second;
+    PyObject *item = Py_BuildValue("{s:K,s:K,s:d}",
+                                   "launches",
+                                   (unsigned long long)kernel.launches,
+                                   "work_size",
+                                   (unsigned long long)kernel.work_size,
+                                   "time",
+                                   kernel.time);
+    PyDict_SetItemString(kernels, entry.first.c_str(), item);
+    Py_DECREF(item);
+  }
+
+  PyObject *result = PyDict_New();
+  PyDict_SetItemString(result, "kernels", kernels);
+  Py_DECREF(kernels);
+
+  if (stats.occupancy >= 0.0) {
+    PyObject *occupancy = PyFloat_FromDouble(stats.occupancy);
+    PyDict_SetItemString(result, "occupancy", occupancy);
+    Py_DECREF(occupancy);
+  }
+
+  return result;
+}
+
 static PyObject *get_device_types_func(PyObject * /*self*/, PyObject * /*args*/)
 {
   vector<DeviceType> device_types = Device::available_types();
@@ -1040,11 +1090,13 @@ static PyMethodDef methods[] = {
 
     /* Statistics. */
     {"enable_print_stats", enable_print_stats_func, METH_NOARGS, ""},
+    {"get_device_kernel_stats", get_device_kernel_stats_func, METH_NOARGS, ""},
 
     /* Resumable render */
     {"set_resumable_chunk", set_resumable_chunk_func, METH_VARARGS, ""},
     {"set_resumable_chunk_range", set_resumable_chunk_range_func, METH_VARARGS, ""},
     {"clear_resumable_chunk", clear_resumable_chunk_func, METH_NOARGS, ""},
+    {"set_checkpoint_directory", set_checkpoint_directory_func, METH_O, ""},
 
     /* Compute Device selection */
     {"get_device_types", get_device_types_func, METH_VARARGS, ""},
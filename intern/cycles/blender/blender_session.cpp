@@ -53,7 +53,9 @@ int BlenderSession::num_resumable_chunks = 0;
 int BlenderSession::current_resumable_chunk = 0;
 int BlenderSession::start_resumable_chunk = 0;
 int BlenderSession::end_resumable_chunk = 0;
+string BlenderSession::checkpoint_directory = "";
 bool BlenderSession::print_render_stats = false;
+DeviceKernelStats BlenderSession::device_kernel_stats;
 
 BlenderSession::BlenderSession(BL::RenderEngine &b_engine,
                                BL::Preferences &b_userpref,
@@ -563,6 +565,16 @@ void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
     /* Update tile manager if we're doing resumable render. */
     update_resumable_tile_manager(effective_layer_samples);
 
+    /* Checkpoint per frame, view layer and view, to continue interrupted renders. */
+    if (!checkpoint_directory.empty() && !b_engine.is_preview()) {
+      const string filename = string_printf("%s_%04d_%s_%s.checkpoint",
+                                            b_scene.name().c_str(),
+                                            b_scene.frame_current(),
+                                            b_rlay_name.c_str(),
+                                            b_rview_name.c_str());
+      session->set_checkpoint_filepath(path_join(checkpoint_directory, filename));
+    }
+
     /* Update session itself. */
     session->reset(buffer_params, effective_layer_samples);
 
@@ -578,6 +590,7 @@ void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
       RenderStats stats;
       session->collect_statistics(&stats);
       printf("Render statistics:\n%s\n", stats.full_report().c_str());
+      device_kernel_stats = stats.device_kernels;
     }
 
     if (session->progress.get_cancel())
@@ -24,6 +24,7 @@
 #include "render/bake.h"
 #include "render/scene.h"
 #include "render/session.h"
+#include "render/stats.h"
 
 #include "util/util_vector.h"
 
@@ -146,8 +147,14 @@ class BlenderSession {
   static int start_resumable_chunk;
   static int end_resumable_chunk;
 
+  /* Directory for checkpoints of background renders, empty when disabled. */
+  static string checkpoint_directory;
+
   static bool print_render_stats;
 
+  /* Kernel statistics of the GPU devices of the last view rendered with print_render_stats. */
+  static DeviceKernelStats device_kernel_stats;
+
  protected:
   void stamp_view_layer_metadata(Scene *scene, const string &view_layer_name);
 
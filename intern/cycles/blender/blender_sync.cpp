@@ -311,6 +311,7 @@ void BlenderSync::sync_integrator()
   integrator->set_sample_all_lights_direct(get_boolean(cscene, "sample_all_lights_direct"));
   integrator->set_sample_all_lights_indirect(get_boolean(cscene, "sample_all_lights_indirect"));
   integrator->set_light_sampling_threshold(get_float(cscene, "light_sampling_threshold"));
+  integrator->set_use_light_tree(get_boolean(cscene, "use_light_tree"));
 
   SamplingPattern sampling_pattern = (SamplingPattern)get_enum(
       cscene, "sampling_pattern", SAMPLING_NUM_PATTERNS, SAMPLING_PATTERN_SOBOL);
@@ -186,6 +186,10 @@ class BlenderSync {
                             bool use_particle_hair,
                             TaskPool *task_pool);
 
+  /* Test if the geometry is synced in this update, its data may still be written by tasks in the
+   * geometry task pool. */
+  bool geometry_is_synced(Geometry *geom) const;
+
   /* Light */
   void sync_light(BL::Object &b_parent,
                   int persistent_id[OBJECT_PERSISTENT_ID_SIZE],
@@ -225,14 +225,23 @@ static void rtc_filter_occluded_func(const RTCFilterFunctionNArguments *args)
 
 static void rtc_filter_func_thick_curve(const RTCFilterFunctionNArguments *args)
 {
-  const RTCRay *ray = (RTCRay *)args->ray;
-  RTCHit *hit = (RTCHit *)args->hit;
+  /* Camera rays may be traced in packets, see scene_intersect_packet8. */
+  const unsigned int N = args->N;
 
-  /* Always ignore backfacing intersections. */
-  if (dot(make_float3(ray->dir_x, ray->dir_y, ray->dir_z),
-          make_float3(hit->Ng_x, hit->Ng_y, hit->Ng_z)) > 0.0f) {
-    *args->valid = 0;
-    return;
+  for (unsigned int i = 0; i < N; i++) {
+    if (args->valid[i] == 0) {
+      continue;
+    }
+
+    /* Always ignore backfacing intersections. */
+    if (dot(make_float3(RTCRayN_dir_x(args->ray, N, i),
+                        RTCRayN_dir_y(args->ray, N, i),
+                        RTCRayN_dir_z(args->ray, N, i)),
+            make_float3(RTCHitN_Ng_x(args->hit, N, i),
+                        RTCHitN_Ng_y(args->hit, N, i),
+                        RTCHitN_Ng_z(args->hit, N, i))) > 0.0f) {
+      args->valid[i] = 0;
+    }
   }
 }
 
@@ -37,6 +37,7 @@
 #  include "util/util_md5.h"
 #  include "util/util_opengl.h"
 #  include "util/util_path.h"
+#  include "util/util_profiling.h"
 #  include "util/util_string.h"
 #  include "util/util_system.h"
 #  include "util/util_time.h"
@@ -1884,15 +1885,19 @@ void CUDADevice::render(DeviceTask &task, RenderTile &rtile, device_vector<WorkT
 
   CUDAContextScope scope(this);
   CUfunction cuRender;
+  const char *kernel_name;
 
   /* Get kernel function. */
   if (rtile.task == RenderTile::BAKE) {
+    kernel_name = "bake";
     cuda_assert(cuModuleGetFunction(&cuRender, cuModule, "kernel_cuda_bake"));
   }
   else if (task.integrator_branched) {
+    kernel_name = "branched_path_trace";
     cuda_assert(cuModuleGetFunction(&cuRender, cuModule, "kernel_cuda_branched_path_trace"));
   }
   else {
+    kernel_name = "path_trace";
     cuda_assert(cuModuleGetFunction(&cuRender, cuModule, "kernel_cuda_path_trace"));
   }
 
@@ -1929,6 +1934,7 @@ void CUDADevice::render(DeviceTask &task, RenderTile &rtile, device_vector<WorkT
   /* Render all samples. */
   int start_sample = rtile.start_sample;
   int end_sample = rtile.start_sample + rtile.num_samples;
+  const bool use_profiling = profiler.is_running();
 
   for (int sample = start_sample; sample < end_sample;) {
     /* Setup and copy work tile to device. */
@@ -1947,9 +1953,17 @@ void CUDADevice::render(DeviceTask &task, RenderTile &rtile, device_vector<WorkT
     /* Launch kernel. */
     void *args[] = {&d_work_tiles, &total_work_size};
 
+    const double kernel_start_time = use_profiling ? time_dt() : 0.0;
+
     cuda_assert(
         cuLaunchKernel(cuRender, num_blocks, 1, 1, num_threads_per_block, 1, 1, 0, 0, args, 0));
 
+    if (use_profiling) {
+      /* Wait for the kernel separately, so the adaptive sampling kernels are not included. */
+      cuda_assert(cuCtxSynchronize());
+      profiler.add_device_kernel(kernel_name, total_work_size, time_dt() - kernel_start_time);
+    }
+
     /* Run the adaptive sampling kernels at selected samples aligned to step samples. */
     uint filter_sample = sample + wtile->num_samples - 1;
     if (task.adaptive_sampling.use && task.adaptive_sampling.need_filter(filter_sample)) {
@@ -2505,9 +2519,11 @@ CUDAContextScope::~CUDAContextScope()
 class CUDASplitKernelFunction : public SplitKernelFunction {
   CUDADevice *device;
   CUfunction func;
+  string name;
 
  public:
-  CUDASplitKernelFunction(CUDADevice *device, CUfunction func) : device(device), func(func)
+  CUDASplitKernelFunction(CUDADevice *device, CUfunction func, const string &name)
+      : device(device), func(func), name(name)
   {
   }
 
@@ -2535,6 +2551,9 @@ class CUDASplitKernelFunction : public SplitKernelFunction {
 
     cuda_assert(cuFuncSetCacheConfig(func, CU_FUNC_CACHE_PREFER_L1));
 
+    const bool use_profiling = device->profiler.is_running();
+    const double kernel_start_time = use_profiling ? time_dt() : 0.0;
+
     cuda_assert(cuLaunchKernel(func,
                                xblocks,
                                1,
@@ -2547,6 +2566,12 @@ class CUDASplitKernelFunction : public SplitKernelFunction {
                                args,
                                0));
 
+    if (use_profiling) {
+      cuda_assert(cuCtxSynchronize());
+      device->profiler.add_device_kernel(
+          name, dim.global_size[0] * dim.global_size[1], time_dt() - kernel_start_time);
+    }
+
     return !device->have_error();
   }
 };
@@ -2677,7 +2702,7 @@ SplitKernelFunction *CUDASplitKernel::get_split_kernel_function(const string &ke
     return NULL;
   }
 
-  return new CUDASplitKernelFunction(device, func);
+  return new CUDASplitKernelFunction(device, func, kernel_name);
 }
 
 int2 CUDASplitKernel::split_kernel_local_size()
@@ -192,6 +192,8 @@ class CPUDevice : public Device {
 #ifdef WITH_EMBREE
   RTCScene embree_scene = NULL;
   RTCDevice embree_device;
+  /* Embree traces packets of 8 rays natively, see path_trace_packet_kernel. */
+  bool embree_native_ray8 = false;
 #endif
 
   bool use_split_kernel;
@@ -199,6 +201,8 @@ class CPUDevice : public Device {
   DeviceRequestedFeatures requested_features;
 
   KernelFunctions<void (*)(KernelGlobals *, float *, int, int, int, int, int)> path_trace_kernel;
+  KernelFunctions<void (*)(KernelGlobals *, float *, int, int, int, int, int, int)>
+      path_trace_packet_kernel;
   KernelFunctions<void (*)(KernelGlobals *, uchar4 *, float *, float, int, int, int, int)>
       convert_to_half_float_kernel;
   KernelFunctions<void (*)(KernelGlobals *, uchar4 *, float *, float, int, int, int, int)>
@@ -285,6 +289,7 @@ class CPUDevice : public Device {
         texture_info(this, "__texture_info", MEM_GLOBAL),
 #define REGISTER_KERNEL(name) name##_kernel(KERNEL_FUNCTIONS(name))
         REGISTER_KERNEL(path_trace),
+        REGISTER_KERNEL(path_trace_packet),
         REGISTER_KERNEL(convert_to_half_float),
         REGISTER_KERNEL(convert_to_byte),
         REGISTER_KERNEL(shader),
@@ -314,6 +319,9 @@ class CPUDevice : public Device {
 #endif
 #ifdef WITH_EMBREE
     embree_device = rtcNewDevice("verbose=0");
+    embree_native_ray8 = rtcGetDeviceProperty(embree_device,
+                                              RTC_DEVICE_PROPERTY_NATIVE_RAY8_SUPPORTED) != 0;
+    VLOG(1) << "Embree native ray packets " << (embree_native_ray8 ? "supported" : "unsupported");
 #endif
     use_split_kernel = DebugFlags().cpu.split_kernel;
     if (use_split_kernel) {
@@ -936,6 +944,13 @@ class CPUDevice : public Device {
   {
     const bool use_coverage = kernel_data.film.cryptomatte_passes & CRYPT_ACCURATE;
 
+    /* Trace camera rays of a row in packets, accurate cryptomatte needs per pixel setup. */
+#ifdef WITH_EMBREE
+    const bool use_packets = embree_native_ray8 && embree_scene && !use_coverage;
+#else
+    const bool use_packets = false;
+#endif
+
     scoped_timer timer(&tile.buffers->render_time);
 
     Coverage coverage(kg, tile);
@@ -961,7 +976,13 @@ class CPUDevice : public Device {
         break;
       }
 
-      if (tile.task == RenderTile::PATH_TRACE) {
+      if (tile.task == RenderTile::PATH_TRACE && use_packets) {
+        for (int y = tile.y; y < tile.y + tile.h; y++) {
+          path_trace_packet_kernel()(
+              kg, render_buffer, sample, tile.x, y, tile.w, tile.offset, tile.stride);
+        }
+      }
+      else if (tile.task == RenderTile::PATH_TRACE) {
         for (int y = tile.y; y < tile.y + tile.h; y++) {
           for (int x = tile.x; x < tile.x + tile.w; x++) {
             if (use_coverage) {
@@ -1014,26 +1035,6 @@ class CPUDevice : public Device {
 #ifdef WITH_OPENIMAGEDENOISE
     assert(openimagedenoise_supported());
 
-    /* Only one at a time, since OpenImageDenoise itself is multithreaded for full
-     * buffers, and for tiled rendering because creating multiple devices and filters
-     * is slow and memory hungry as well.
-     *
-     * TODO: optimize tiled rendering case, by batching together denoising of many
-     * tiles somehow? */
-    static thread_mutex mutex;
-    thread_scoped_lock lock(mutex);
-
-    /* Create device and filter, cached for reuse. */
-    if (!oidn_device) {
-      oidn_device = oidn::newDevice();
-      oidn_device.commit();
-    }
-    if (!oidn_filter) {
-      oidn_filter = oidn_device.newFilter("RT");
-      oidn_filter.set("hdr", true);
-      oidn_filter.set("srgb", false);
-    }
-
     /* Set images with appropriate stride for our interleaved pass storage. */
     struct {
       const char *name;
@@ -1054,35 +1055,73 @@ class CPUDevice : public Device {
                   { NULL,
                     0 }};
 
+    const int64_t pixel_offset = offset + x + y * stride;
+    const int64_t pixel_stride = task.pass_stride;
+    const int64_t row_stride = stride * pixel_stride;
+
+    /* Normalize albedo and normal passes as they are scaled by the number of samples.
+     * For the color passes OIDN will perform auto-exposure making it unnecessary.
+     *
+     * This is done before taking the lock below, so that tiles finishing at the same time
+     * prepare their inputs concurrently and only the filter execution itself is serialized. */
+    if (scale != 1.0f) {
+      for (int i = 0; passes[i].name; i++) {
+        if (!(passes[i].use && passes[i].scale)) {
+          continue;
+        }
+
+        const float *pass_buffer = buffer + pixel_offset * pixel_stride + passes[i].offset;
+        array<float> &scaled_buffer = passes[i].scaled_buffer;
+        scaled_buffer.resize(w * h * 3);
+        float *scaled_data = scaled_buffer.data();
+
+        const int rows_per_task = divide_up(1024, w);
+        parallel_for(blocked_range<size_t>(0, h, rows_per_task),
+                     [&](const blocked_range<size_t> &r) {
+                       for (size_t y = r.begin(); y < r.end(); y++) {
+                         const float *pass_row = pass_buffer + y * row_stride;
+                         float *scaled_row = scaled_data + y * w * 3;
+
+                         for (size_t x = 0; x < w; x++) {
+                           scaled_row[x * 3 + 0] = pass_row[x * pixel_stride + 0] * scale;
+                           scaled_row[x * 3 + 1] = pass_row[x * pixel_stride + 1] * scale;
+                           scaled_row[x * 3 + 2] = pass_row[x * pixel_stride + 2] * scale;
+                         }
+                       }
+                     });
+      }
+    }
+
+    /* Only one at a time, since OpenImageDenoise itself is multithreaded for full
+     * buffers, and for tiled rendering because creating multiple devices and filters
+     * is slow and memory hungry as well.
+     *
+     * TODO: optimize tiled rendering case, by batching together denoising of many
+     * tiles somehow? */
+    static thread_mutex mutex;
+    thread_scoped_lock lock(mutex);
+
+    /* Create device and filter, cached for reuse. */
+    if (!oidn_device) {
+      oidn_device = oidn::newDevice();
+      oidn_device.commit();
+    }
+    if (!oidn_filter) {
+      oidn_filter = oidn_device.newFilter("RT");
+      oidn_filter.set("hdr", true);
+      oidn_filter.set("srgb", false);
+    }
+
     for (int i = 0; passes[i].name; i++) {
       if (!passes[i].use) {
         continue;
       }
 
-      const int64_t pixel_offset = offset + x + y * stride;
       const int64_t buffer_offset = (pixel_offset * task.pass_stride + passes[i].offset);
-      const int64_t pixel_stride = task.pass_stride;
-      const int64_t row_stride = stride * pixel_stride;
 
       if (passes[i].scale && scale != 1.0f) {
-        /* Normalize albedo and normal passes as they are scaled by the number of samples.
-         * For the color passes OIDN will perform auto-exposure making it unnecessary. */
-        array<float> &scaled_buffer = passes[i].scaled_buffer;
-        scaled_buffer.resize(w * h * 3);
-
-        for (int y = 0; y < h; y++) {
-          const float *pass_row = buffer + buffer_offset + y * row_stride;
-          float *scaled_row = scaled_buffer.data() + y * w * 3;
-
-          for (int x = 0; x < w; x++) {
-            scaled_row[x * 3 + 0] = pass_row[x * pixel_stride + 0] * scale;
-            scaled_row[x * 3 + 1] = pass_row[x * pixel_stride + 1] * scale;
-            scaled_row[x * 3 + 2] = pass_row[x * pixel_stride + 2] * scale;
-          }
-        }
-
         oidn_filter.setImage(
-            passes[i].name, scaled_buffer.data(), oidn::Format::Float3, w, h, 0, 0, 0);
+            passes[i].name, passes[i].scaled_buffer.data(), oidn::Format::Float3, w, h, 0, 0, 0);
       }
       else {
         oidn_filter.setImage(passes[i].name,
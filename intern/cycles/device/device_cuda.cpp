@@ -130,6 +130,8 @@ void device_cuda_info(vector<DeviceInfo> &devices)
     info.has_half_images = (major >= 3);
     info.has_volume_decoupled = false;
     info.has_adaptive_stop_per_sample = false;
+    /* Kernels are timed on the host, see Profiler::add_device_kernel. */
+    info.has_profiling = true;
     info.denoisers = DENOISER_NLM;
 
     /* Check if the device has P2P access to any other device in the system. */
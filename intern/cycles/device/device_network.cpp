@@ -122,7 +122,9 @@ class NetworkDevice : public Device {
   {
     thread_scoped_lock lock(rpc_lock);
 
-    size_t data_size = mem.memory_size();
+    /* Only the requested rows are sent back. */
+    size_t offset = (size_t)elem * y * w;
+    size_t size = (size_t)elem * w * h;
 
     RPCSend snd(socket, &error_func, "mem_copy_from");
 
@@ -134,7 +136,7 @@ class NetworkDevice : public Device {
     snd.write();
 
     RPCReceive rcv(socket, &error_func);
-    rcv.read_buffer(mem.host_pointer, data_size);
+    rcv.read_buffer((uint8_t *)mem.host_pointer + offset, size);
   }
 
   void mem_zero(device_memory &mem)
@@ -511,11 +513,12 @@ class DeviceServer {
 
       device->mem_copy_from(mem, y, w, h, elem);
 
-      size_t data_size = mem.memory_size();
+      size_t offset = (size_t)elem * y * w;
+      size_t size = (size_t)elem * w * h;
 
       RPCSend snd(socket, &error_func, "mem_copy_from");
       snd.write();
-      snd.write_buffer((uint8_t *)mem.host_pointer, data_size);
+      snd.write_buffer((uint8_t *)mem.host_pointer + offset, size);
       lock.unlock();
     }
     else if (rcv.name == "mem_zero") {
@@ -29,14 +29,18 @@
 #  include <boost/serialization/vector.hpp>
 #  include <boost/thread.hpp>
 
+#  include <climits>
 #  include <deque>
 #  include <iostream>
 #  include <sstream>
 
+#  include <zlib.h>
+
 #  include "render/buffers.h"
 
 #  include "util/util_foreach.h"
 #  include "util/util_list.h"
+#  include "util/util_logging.h"
 #  include "util/util_map.h"
 #  include "util/util_param.h"
 #  include "util/util_string.h"
@@ -56,6 +60,9 @@ static const int DISCOVER_PORT = 5121;
 static const string DISCOVER_REQUEST_MSG = "REQUEST_RENDER_SERVER_IP";
 static const string DISCOVER_REPLY_MSG = "REPLY_RENDER_SERVER_IP";
 
+/* Buffers smaller than this are sent uncompressed. */
+static const size_t COMPRESS_MIN_SIZE = 4096;
+
 #  if 0
 typedef boost::archive::text_oarchive o_archive;
 typedef boost::archive::text_iarchive i_archive;
@@ -118,7 +125,7 @@ class RPCSend {
   {
     archive &name_;
     error_func = e;
-    fprintf(stderr, "rpc send %s\n", name.c_str());
+    VLOG(3) << "RPC send " << name;
   }
 
   ~RPCSend()
@@ -186,12 +193,40 @@ class RPCSend {
     sent = true;
   }
 
+  /* Buffers are compressed, scene data and render buffers have many zero and repeated values and
+   * fast compression is cheaper than sending them over the network. The size of the compressed
+   * data is sent first, zero when the buffer is sent as is. */
   void write_buffer(void *buffer, size_t size)
   {
     boost::system::error_code error;
 
-    boost::asio::write(
-        socket, boost::asio::buffer(buffer, size), boost::asio::transfer_all(), error);
+    vector<uint8_t> compressed;
+    uint64_t compressed_size = 0;
+
+    if (size >= COMPRESS_MIN_SIZE && size <= UINT_MAX) {
+      uLongf dest_size = compressBound((uLong)size);
+      compressed.resize(dest_size);
+      if (compress2(&compressed[0], &dest_size, (const Bytef *)buffer, (uLong)size, 1) == Z_OK &&
+          dest_size < size) {
+        compressed_size = dest_size;
+      }
+    }
+
+    boost::asio::write(socket,
+                       boost::asio::buffer(&compressed_size, sizeof(compressed_size)),
+                       boost::asio::transfer_all(),
+                       error);
+
+    if (compressed_size) {
+      boost::asio::write(socket,
+                         boost::asio::buffer(&compressed[0], compressed_size),
+                         boost::asio::transfer_all(),
+                         error);
+    }
+    else if (size) {
+      boost::asio::write(
+          socket, boost::asio::buffer(buffer, size), boost::asio::transfer_all(), error);
+    }
 
     if (error.value())
       error_func->network_error(error.message());
@@ -246,7 +281,7 @@ class RPCReceive {
           archive = new i_archive(*archive_stream);
 
           *archive &name;
-          fprintf(stderr, "rpc receive %s\n", name.c_str());
+          VLOG(3) << "RPC receive " << name;
         }
         else {
           error_func->network_error("Network receive error: data size doesn't match header");
@@ -289,10 +324,29 @@ class RPCReceive {
     *archive &data;
   }
 
+  /* Read a buffer sent with RPCSend::write_buffer. */
   void read_buffer(void *buffer, size_t size)
   {
     boost::system::error_code error;
-    size_t len = boost::asio::read(socket, boost::asio::buffer(buffer, size), error);
+
+    uint64_t compressed_size = 0;
+    boost::asio::read(
+        socket, boost::asio::buffer(&compressed_size, sizeof(compressed_size)), error);
+
+    size_t len = 0;
+    if (compressed_size) {
+      vector<uint8_t> compressed(compressed_size);
+      if (boost::asio::read(socket, boost::asio::buffer(compressed), error) == compressed_size) {
+        uLongf dest_size = (uLongf)size;
+        if (uncompress((Bytef *)buffer, &dest_size, &compressed[0], (uLong)compressed_size) ==
+            Z_OK) {
+          len = dest_size;
+        }
+      }
+    }
+    else if (size) {
+      len = boost::asio::read(socket, boost::asio::buffer(buffer, size), error);
+    }
 
     if (error.value()) {
       error_func->network_error(error.message());
@@ -31,6 +31,7 @@
 #  include "util/util_logging.h"
 #  include "util/util_md5.h"
 #  include "util/util_path.h"
+#  include "util/util_profiling.h"
 #  include "util/util_progress.h"
 #  include "util/util_time.h"
 
@@ -766,6 +767,7 @@ class OptiXDevice : public CUDADevice {
                                    thread_index * launch_params.data_elements;
 
     const CUDAContextScope scope(cuContext);
+    const bool use_profiling = profiler.is_running();
 
     for (int sample = rtile.start_sample; sample < end_sample;) {
       // Copy work tile information to device
@@ -795,6 +797,8 @@ class OptiXDevice : public CUDADevice {
       sbt_params.callablesRecordCount = 3;
       sbt_params.callablesRecordStrideInBytes = sizeof(SbtRecord);
 
+      const double kernel_start_time = use_profiling ? time_dt() : 0.0;
+
       // Launch the ray generation program
       check_result_optix(optixLaunch(pipelines[PIP_PATH_TRACE],
                                      cuda_stream[thread_index],
@@ -806,6 +810,14 @@ class OptiXDevice : public CUDADevice {
                                      wtile.h,
                                      1));
 
+      if (use_profiling) {
+        // Wait for the launch separately, so the adaptive sampling kernels are not included
+        check_result_cuda(cuStreamSynchronize(cuda_stream[thread_index]));
+        profiler.add_device_kernel("optix_path_trace",
+                                   (uint64_t)wtile.w * wtile.h * wtile.num_samples,
+                                   time_dt() - kernel_start_time);
+      }
+
       // Run the adaptive sampling kernels at selected samples aligned to step samples.
       uint filter_sample = wtile.start_sample + wtile.num_samples - 1;
       if (task.adaptive_sampling.use && task.adaptive_sampling.need_filter(filter_sample)) {
@@ -20,6 +20,7 @@
 #include "kernel/split/kernel_split_data_types.h"
 
 #include "util/util_logging.h"
+#include "util/util_profiling.h"
 #include "util/util_time.h"
 
 CCL_NAMESPACE_BEGIN
@@ -303,6 +304,10 @@ bool DeviceSplitKernel::path_trace(DeviceTask &task,
 
       activeRaysAvailable = false;
 
+      /* When profiling, count all active rays to measure how many lanes do work. */
+      const bool use_profiling = device->profiler.is_running();
+      uint64_t num_active_rays = 0;
+
       for (int rayStateIter = 0; rayStateIter < global_size[0] * global_size[1]; ++rayStateIter) {
         if (!IS_STATE(ray_state.data(), rayStateIter, RAY_INACTIVE)) {
           if (IS_STATE(ray_state.data(), rayStateIter, RAY_INVALID)) {
@@ -313,10 +318,17 @@ bool DeviceSplitKernel::path_trace(DeviceTask &task,
 
           /* Not all rays are RAY_INACTIVE. */
           activeRaysAvailable = true;
-          break;
+          num_active_rays++;
+          if (!use_profiling) {
+            break;
+          }
         }
       }
 
+      if (use_profiling) {
+        device->profiler.add_device_occupancy(num_active_rays, num_global_elements);
+      }
+
       if (time_dt() > cancel_time) {
         return true;
       }
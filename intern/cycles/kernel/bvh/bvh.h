@@ -236,6 +236,51 @@ ccl_device_intersect bool scene_intersect(KernelGlobals *kg,
 #endif   /* __KERNEL_OPTIX__ */
 }
 
+#ifdef __EMBREE__
+/* Intersect up to 8 coherent rays with a single Embree packet query, which makes better use of
+ * wide SIMD units than tracing the rays one by one. Only rays with active set are traced, a miss
+ * is returned as isect->prim == PRIM_NONE. Returns false without tracing anything when there is
+ * no Embree scene. */
+ccl_device_intersect bool scene_intersect_packet8(KernelGlobals *kg,
+                                                  const Ray *rays,
+                                                  const uint *visibility,
+                                                  const bool *active,
+                                                  const int num_rays,
+                                                  Intersection *isects)
+{
+  if (!kernel_data.bvh.scene) {
+    return false;
+  }
+
+  int valid[8];
+  for (int i = 0; i < 8; i++) {
+    valid[i] = (i < num_rays && active[i] && scene_intersect_valid(&rays[i])) ? -1 : 0;
+  }
+
+  CCLIntersectContext ctx(kg, CCLIntersectContext::RAY_REGULAR);
+  IntersectContext rtc_ctx(&ctx);
+  rtc_ctx.context.flags = RTC_INTERSECT_CONTEXT_FLAG_COHERENT;
+  RTCRayHit8 ray_hit;
+  kernel_embree_setup_rayhit8(rays, visibility, valid, ray_hit);
+  rtcIntersect8(valid, kernel_data.bvh.scene, &rtc_ctx.context, &ray_hit);
+
+  for (int i = 0; i < num_rays; i++) {
+    isects[i].t = rays[i].t;
+    isects[i].prim = PRIM_NONE;
+
+    if (valid[i] && ray_hit.hit.geomID[i] != RTC_INVALID_GEOMETRY_ID &&
+        ray_hit.hit.primID[i] != RTC_INVALID_GEOMETRY_ID) {
+      RTCRay ray;
+      RTCHit hit;
+      kernel_embree_get_rayhit8(ray_hit, i, ray, hit);
+      kernel_embree_convert_hit(kg, &ray, &hit, &isects[i]);
+    }
+  }
+
+  return true;
+}
+#endif /* __EMBREE__ */
+
 #ifdef __BVH_LOCAL__
 ccl_device_intersect bool scene_intersect_local(KernelGlobals *kg,
                                                 const Ray *ray,
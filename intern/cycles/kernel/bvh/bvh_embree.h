@@ -98,6 +98,56 @@ ccl_device_inline void kernel_embree_setup_rayhit(const Ray &ray,
   rayhit.hit.primID = RTC_INVALID_GEOMETRY_ID;
 }
 
+/* Packet of 8 rays, for coherent rays like the camera rays of neighboring pixels. */
+
+ccl_device_inline void kernel_embree_setup_rayhit8(const Ray *rays,
+                                                   const uint *visibility,
+                                                   const int *valid,
+                                                   RTCRayHit8 &rayhit)
+{
+  for (int i = 0; i < 8; i++) {
+    if (!valid[i]) {
+      rayhit.ray.tnear[i] = 0.0f;
+      rayhit.ray.tfar[i] = -FLT_MAX;
+      continue;
+    }
+
+    const Ray &ray = rays[i];
+    rayhit.ray.org_x[i] = ray.P.x;
+    rayhit.ray.org_y[i] = ray.P.y;
+    rayhit.ray.org_z[i] = ray.P.z;
+    rayhit.ray.dir_x[i] = ray.D.x;
+    rayhit.ray.dir_y[i] = ray.D.y;
+    rayhit.ray.dir_z[i] = ray.D.z;
+    rayhit.ray.tnear[i] = 0.0f;
+    rayhit.ray.tfar[i] = ray.t;
+    rayhit.ray.time[i] = ray.time;
+    rayhit.ray.mask[i] = visibility[i];
+    rayhit.ray.flags[i] = 0;
+    rayhit.hit.geomID[i] = RTC_INVALID_GEOMETRY_ID;
+    rayhit.hit.primID[i] = RTC_INVALID_GEOMETRY_ID;
+  }
+}
+
+/* Extract a single ray and hit from a packet, for kernel_embree_convert_hit. */
+ccl_device_inline void kernel_embree_get_rayhit8(const RTCRayHit8 &rayhit,
+                                                 const int i,
+                                                 RTCRay &ray,
+                                                 RTCHit &hit)
+{
+  ray.tfar = rayhit.ray.tfar[i];
+  hit.Ng_x = rayhit.hit.Ng_x[i];
+  hit.Ng_y = rayhit.hit.Ng_y[i];
+  hit.Ng_z = rayhit.hit.Ng_z[i];
+  hit.u = rayhit.hit.u[i];
+  hit.v = rayhit.hit.v[i];
+  hit.primID = rayhit.hit.primID[i];
+  hit.geomID = rayhit.hit.geomID[i];
+  for (int level = 0; level < RTC_MAX_INSTANCE_LEVEL_COUNT; level++) {
+    hit.instID[level] = rayhit.hit.instID[level][i];
+  }
+}
+
 ccl_device_inline void kernel_embree_convert_hit(KernelGlobals *kg,
                                                  const RTCRay *ray,
                                                  const RTCHit *hit,
@@ -15,6 +15,7 @@
  */
 
 #include "kernel_light_background.h"
+#include "kernel_light_tree.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -37,6 +38,22 @@ typedef struct LightSample {
 
 /* Regular Light */
 
+/* Probability of selecting a lamp in light_sample. */
+ccl_device_inline float lamp_light_select_pdf(KernelGlobals *kg,
+                                              int lamp,
+                                              LightType type,
+                                              const float3 P)
+{
+  if (kernel_data.integrator.use_light_tree && type != LIGHT_DISTANT &&
+      type != LIGHT_BACKGROUND) {
+    const int index = kernel_data.integrator.num_distribution -
+                      kernel_data.integrator.num_all_lights + lamp;
+    return light_tree_pdf(kg, P, index);
+  }
+
+  return kernel_data.integrator.pdf_lights;
+}
+
 ccl_device_inline bool lamp_light_sample(
     KernelGlobals *kg, int lamp, float randu, float randv, float3 P, LightSample *ls)
 {
@@ -153,7 +170,7 @@ ccl_device_inline bool lamp_light_sample(
     }
   }
 
-  ls->pdf *= kernel_data.integrator.pdf_lights;
+  ls->pdf *= lamp_light_select_pdf(kg, lamp, type, P);
 
   return (ls->pdf > 0.0f);
 }
@@ -291,7 +308,7 @@ ccl_device bool lamp_light_eval(
     return false;
   }
 
-  ls->pdf *= kernel_data.integrator.pdf_lights;
+  ls->pdf *= lamp_light_select_pdf(kg, lamp, type, P);
 
   return true;
 }
@@ -328,12 +345,25 @@ ccl_device_inline bool triangle_world_space_vertices(
   return has_motion;
 }
 
+/* Probability of selecting a triangle in light_sample, area is the area the light distribution
+ * was computed from. */
+ccl_device_inline float triangle_light_select_pdf(
+    KernelGlobals *kg, int object, int prim, float area, const float3 P)
+{
+  if (kernel_data.integrator.use_light_tree) {
+    const int index = light_tree_triangle_distribution_index(kg, object, prim);
+    return (index >= 0) ? light_tree_pdf(kg, P, index) : 0.0f;
+  }
+
+  return area * kernel_data.integrator.pdf_triangles;
+}
+
 ccl_device_inline float triangle_light_pdf_area(KernelGlobals *kg,
                                                 const float3 Ng,
                                                 const float3 I,
-                                                float t)
+                                                float t,
+                                                float pdf)
 {
-  float pdf = kernel_data.integrator.pdf_triangles;
   float cos_pi = fabsf(dot(Ng, I));
 
   if (cos_pi == 0.0f)
@@ -389,25 +419,25 @@ ccl_device_forceinline float triangle_light_pdf(KernelGlobals *kg, ShaderData *s
       else {
         area = 0.5f * len(N);
       }
-      const float pdf = area * kernel_data.integrator.pdf_triangles;
+      const float pdf = triangle_light_select_pdf(kg, sd->object, sd->prim, area, Px);
       return pdf / solid_angle;
     }
   }
   else {
-    float pdf = triangle_light_pdf_area(kg, sd->Ng, sd->I, t);
+    const float area = 0.5f * len(N);
+    if (UNLIKELY(area == 0.0f)) {
+      return 0.0f;
+    }
+    /* area = the area the sample was taken from
+     * area_pre = the are from which pdf_triangles was calculated from */
+    float area_pre = area;
     if (has_motion) {
-      const float area = 0.5f * len(N);
-      if (UNLIKELY(area == 0.0f)) {
-        return 0.0f;
-      }
-      /* scale the PDF.
-       * area = the area the sample was taken from
-       * area_pre = the are from which pdf_triangles was calculated from */
       triangle_world_space_vertices(kg, sd->object, sd->prim, -1.0f, V);
-      const float area_pre = triangle_area(V[0], V[1], V[2]);
-      pdf = pdf * area_pre / area;
+      area_pre = triangle_area(V[0], V[1], V[2]);
     }
-    return pdf;
+    const float3 Px = sd->P + sd->I * t;
+    const float pdf = triangle_light_select_pdf(kg, sd->object, sd->prim, area_pre, Px);
+    return triangle_light_pdf_area(kg, sd->Ng, sd->I, t, pdf / area);
   }
 }
 
@@ -542,7 +572,7 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals *kg,
         triangle_world_space_vertices(kg, object, prim, -1.0f, V);
         area = triangle_area(V[0], V[1], V[2]);
       }
-      const float pdf = area * kernel_data.integrator.pdf_triangles;
+      const float pdf = triangle_light_select_pdf(kg, object, prim, area, P);
       ls->pdf = pdf / solid_angle;
     }
   }
@@ -564,15 +594,19 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals *kg,
     ls->P = u * V[0] + v * V[1] + t * V[2];
     /* compute incoming direction, distance and pdf */
     ls->D = normalize_len(ls->P - P, &ls->t);
-    ls->pdf = triangle_light_pdf_area(kg, ls->Ng, -ls->D, ls->t);
-    if (has_motion && area != 0.0f) {
-      /* scale the PDF.
-       * area = the area the sample was taken from
-       * area_pre = the are from which pdf_triangles was calculated from */
+    if (UNLIKELY(area == 0.0f)) {
+      ls->pdf = 0.0f;
+      return;
+    }
+    /* area = the area the sample was taken from
+     * area_pre = the are from which pdf_triangles was calculated from */
+    float area_pre = area;
+    if (has_motion) {
       triangle_world_space_vertices(kg, object, prim, -1.0f, V);
-      const float area_pre = triangle_area(V[0], V[1], V[2]);
-      ls->pdf = ls->pdf * area_pre / area;
+      area_pre = triangle_area(V[0], V[1], V[2]);
     }
+    const float pdf = triangle_light_select_pdf(kg, object, prim, area_pre, P);
+    ls->pdf = triangle_light_pdf_area(kg, ls->Ng, -ls->D, ls->t, pdf / area);
     ls->u = u;
     ls->v = v;
   }
@@ -634,7 +668,9 @@ ccl_device_noinline bool light_sample(KernelGlobals *kg,
 {
   if (lamp < 0) {
     /* sample index */
-    int index = light_distribution_sample(kg, &randu);
+    int index = kernel_data.integrator.use_light_tree ?
+                    light_tree_distribution_sample(kg, P, &randu) :
+                    light_distribution_sample(kg, &randu);
 
     /* fetch light data */
     const ccl_global KernelLightDistribution *kdistribution = &kernel_tex_fetch(
@@ -0,0 +1,223 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+CCL_NAMESPACE_BEGIN
+
+/* Light Tree
+ *
+ * Importance sampling of many lights, based on "Importance Sampling of Many Lights with
+ * Adaptive Tree Splitting" by Estevez and Kulla. Triangles and point, spot and area lamps
+ * are stored in a binary tree, built in render/light_tree.cpp. A light is selected by
+ * traversing the tree from the root, choosing a child proportional to an estimate of its
+ * contribution at the shading point, based on the energy, distance and orientation of the
+ * emitters in the node. Distant and background lights are sampled as before.
+ *
+ * The importance only depends on the shading point and not on its normal, so it can also be
+ * evaluated when an emitter is hit for multiple importance sampling. */
+
+ccl_device float light_tree_node_importance(KernelGlobals *kg, const float3 P, int node_index)
+{
+  const ccl_global KernelLightTreeNode *knode = &kernel_tex_fetch(__light_tree_nodes,
+                                                                  node_index);
+
+  const float3 bounds_min = make_float3(
+      knode->bounds_min[0], knode->bounds_min[1], knode->bounds_min[2]);
+  const float3 bounds_max = make_float3(
+      knode->bounds_max[0], knode->bounds_max[1], knode->bounds_max[2]);
+  const float3 axis = make_float3(knode->axis[0], knode->axis[1], knode->axis[2]);
+
+  const float3 centroid = 0.5f * (bounds_min + bounds_max);
+  const float radius_squared = 0.25f * len_squared(bounds_max - bounds_min);
+
+  float distance;
+  const float3 D = normalize_len(P - centroid, &distance);
+  const float distance_squared = distance * distance;
+
+  /* Angle between the axis of the orientation cone and the shading point. */
+  float theta = (distance > 0.0f) ? safe_acosf(dot(axis, D)) : 0.0f;
+  if (knode->two_sided) {
+    theta = min(theta, M_PI_F - theta);
+  }
+
+  /* Angle subtended by the bounds, all directions when the shading point is inside them. */
+  const float theta_u = (distance_squared > radius_squared) ?
+                            safe_asinf(sqrtf(radius_squared / distance_squared)) :
+                            M_PI_F;
+
+  /* Smallest angle between any emitter normal and direction to the shading point. */
+  const float theta_prime = max(theta - knode->theta_o - theta_u, 0.0f);
+  if (theta_prime >= knode->theta_e) {
+    return 0.0f;
+  }
+
+  /* Clamp the distance, to avoid the importance going to infinity close to the emitters. */
+  return knode->energy * max(cosf(theta_prime), 0.0f) / max(distance_squared, radius_squared);
+}
+
+/* Probability of choosing the first child of an interior node. */
+ccl_device float light_tree_child_probability(KernelGlobals *kg, const float3 P, int node_index)
+{
+  const int first_child = node_index + 1;
+  const int second_child = kernel_tex_fetch(__light_tree_nodes, node_index).child_index;
+
+  float importance_first = light_tree_node_importance(kg, P, first_child);
+  float importance_second = light_tree_node_importance(kg, P, second_child);
+
+  if (importance_first + importance_second == 0.0f) {
+    /* Estimates are conservative, fall back to the energy so that no emitter gets a zero
+     * probability because of float precision. */
+    importance_first = kernel_tex_fetch(__light_tree_nodes, first_child).energy;
+    importance_second = kernel_tex_fetch(__light_tree_nodes, second_child).energy;
+
+    if (importance_first + importance_second == 0.0f) {
+      return 0.5f;
+    }
+  }
+
+  return importance_first / (importance_first + importance_second);
+}
+
+/* Probability of choosing an emitter within a leaf, proportional to its energy. */
+ccl_device float light_tree_emitter_probability(KernelGlobals *kg, int leaf, float energy)
+{
+  const ccl_global KernelLightTreeNode *kleaf = &kernel_tex_fetch(__light_tree_nodes, leaf);
+
+  if (kleaf->energy == 0.0f) {
+    return 1.0f / kleaf->num_emitters;
+  }
+
+  return energy / kleaf->energy;
+}
+
+/* Select a light distribution entry by traversing the tree. randu is rescaled so it can be
+ * reused for sampling a point on the emitter. */
+ccl_device int light_tree_sample(KernelGlobals *kg, const float3 P, float *randu)
+{
+  float r = *randu;
+  int node_index = 0;
+
+  while (kernel_tex_fetch(__light_tree_nodes, node_index).num_emitters == 0) {
+    const float probability = light_tree_child_probability(kg, P, node_index);
+
+    if (r < probability) {
+      node_index = node_index + 1;
+      r = r / probability;
+    }
+    else {
+      node_index = kernel_tex_fetch(__light_tree_nodes, node_index).child_index;
+      r = (r - probability) / (1.0f - probability);
+    }
+
+    r = min(r, 1.0f - FLT_EPSILON);
+  }
+
+  const ccl_global KernelLightTreeNode *kleaf = &kernel_tex_fetch(__light_tree_nodes,
+                                                                  node_index);
+  const int first_emitter = kleaf->child_index;
+  const int last_emitter = first_emitter + kleaf->num_emitters - 1;
+
+  for (int i = first_emitter;; i++) {
+    const int distribution_index = kernel_tex_fetch(__light_tree_emitter_order, i);
+    const float energy = kernel_tex_fetch(__light_tree_emitters, distribution_index).energy;
+    const float probability = light_tree_emitter_probability(kg, node_index, energy);
+
+    if (r < probability || i == last_emitter) {
+      *randu = min(r / probability, 1.0f - FLT_EPSILON);
+      return distribution_index;
+    }
+
+    r -= probability;
+  }
+}
+
+/* Probability of light_tree_sample selecting a light distribution entry. */
+ccl_device float light_tree_pdf(KernelGlobals *kg, const float3 P, int distribution_index)
+{
+  const ccl_global KernelLightTreeEmitter *kemitter = &kernel_tex_fetch(__light_tree_emitters,
+                                                                        distribution_index);
+  int node_index = kemitter->leaf;
+  if (node_index < 0) {
+    return 0.0f;
+  }
+
+  float pdf = light_tree_emitter_probability(kg, node_index, kemitter->energy);
+
+  for (;;) {
+    const int parent = kernel_tex_fetch(__light_tree_nodes, node_index).parent;
+    if (parent < 0) {
+      break;
+    }
+
+    const float probability = light_tree_child_probability(kg, P, parent);
+    pdf *= (node_index == parent + 1) ? probability : 1.0f - probability;
+    node_index = parent;
+  }
+
+  return pdf * kernel_data.integrator.light_tree_pdf;
+}
+
+/* Select a light distribution entry, either from the tree or one of the distant and background
+ * lights. These are stored after the emitters of the tree leaves in __light_tree_emitter_order,
+ * and each is selected with probability pdf_lights like without the tree. */
+ccl_device int light_tree_distribution_sample(KernelGlobals *kg, const float3 P, float *randu)
+{
+  const float tree_pdf = kernel_data.integrator.light_tree_pdf;
+  float r = *randu;
+
+  if (r < tree_pdf) {
+    *randu = min(r / tree_pdf, 1.0f - FLT_EPSILON);
+    return light_tree_sample(kg, P, randu);
+  }
+
+  const int num_infinite = kernel_data.integrator.num_light_tree_infinite;
+  r = (r - tree_pdf) / (1.0f - tree_pdf) * num_infinite;
+  const int index = min((int)r, num_infinite - 1);
+  *randu = min(r - index, 1.0f - FLT_EPSILON);
+
+  return kernel_tex_fetch(__light_tree_emitter_order,
+                          kernel_data.integrator.num_light_tree_emitters + index);
+}
+
+/* Find the light distribution entry of an emissive triangle. Triangles come first in the
+ * distribution, sorted by object and primitive. Returns -1 if the triangle is not in it. */
+ccl_device int light_tree_triangle_distribution_index(KernelGlobals *kg, int object, int prim)
+{
+  int first = 0;
+  int last = kernel_data.integrator.num_distribution - kernel_data.integrator.num_all_lights -
+             1;
+
+  while (first <= last) {
+    const int middle = (first + last) >> 1;
+    const ccl_global KernelLightDistribution *kdistribution = &kernel_tex_fetch(
+        __light_distribution, middle);
+    const int middle_object = kdistribution->mesh_light.object_id;
+    const int middle_prim = kdistribution->prim;
+
+    if (middle_object == object && middle_prim == prim) {
+      return middle;
+    }
+    else if (middle_object < object || (middle_object == object && middle_prim < prim)) {
+      first = middle + 1;
+    }
+    else {
+      last = middle - 1;
+    }
+  }
+
+  return -1;
+}
+
+CCL_NAMESPACE_END
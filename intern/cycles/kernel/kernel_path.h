@@ -512,7 +512,8 @@ ccl_device_forceinline void kernel_path_integrate(KernelGlobals *kg,
                                                   Ray *ray,
                                                   PathRadiance *L,
                                                   ccl_global float *buffer,
-                                                  ShaderData *emission_sd)
+                                                  ShaderData *emission_sd,
+                                                  const Intersection *first_isect)
 {
   PROFILING_INIT(kg, PROFILING_PATH_INTEGRATE);
 
@@ -530,7 +531,17 @@ ccl_device_forceinline void kernel_path_integrate(KernelGlobals *kg,
     for (;;) {
       /* Find intersection with objects in scene. */
       Intersection isect;
-      bool hit = kernel_path_scene_intersect(kg, state, ray, &isect, L);
+      bool hit;
+
+      if (first_isect) {
+        /* Camera ray was already traced in a packet, see kernel_path_trace_packet. */
+        isect = *first_isect;
+        hit = (isect.prim != PRIM_NONE);
+        first_isect = NULL;
+      }
+      else {
+        hit = kernel_path_scene_intersect(kg, state, ray, &isect, L);
+      }
 
       /* Find intersection with lamps and compute emission for MIS. */
       kernel_path_lamp_emission(kg, state, ray, throughput, &isect, &sd, L);
@@ -689,11 +700,103 @@ ccl_device void kernel_path_trace(
 #  endif
 
   /* Integrate. */
-  kernel_path_integrate(kg, &state, throughput, &ray, &L, buffer, emission_sd);
+  kernel_path_integrate(kg, &state, throughput, &ray, &L, buffer, emission_sd, NULL);
 
   kernel_write_result(kg, buffer, sample, &L);
 }
 
+#  ifdef __EMBREE__
+
+#    define PATH_PACKET_SIZE 8
+
+/* Path trace num_pixels pixels of a row starting at x. The camera rays of neighboring pixels are
+ * coherent, they are traced in packets for better SIMD utilization. The rest of the path is
+ * traced one ray at a time like in kernel_path_trace. */
+ccl_device void kernel_path_trace_packet(KernelGlobals *kg,
+                                         ccl_global float *buffer,
+                                         int sample,
+                                         int x,
+                                         int y,
+                                         int num_pixels,
+                                         int offset,
+                                         int stride)
+{
+  PROFILING_INIT(kg, PROFILING_RAY_SETUP);
+
+  int pass_stride = kernel_data.film.pass_stride;
+
+  ShaderDataTinyStorage emission_sd_storage;
+  ShaderData *emission_sd = AS_SHADER_DATA(&emission_sd_storage);
+
+  for (int start = 0; start < num_pixels; start += PATH_PACKET_SIZE) {
+    const int num_rays = min(num_pixels - start, PATH_PACKET_SIZE);
+
+    Ray rays[PATH_PACKET_SIZE];
+    uint visibility[PATH_PACKET_SIZE];
+    bool active[PATH_PACKET_SIZE];
+    PathState states[PATH_PACKET_SIZE];
+    ccl_global float *buffers[PATH_PACKET_SIZE];
+
+    /* Initialize random numbers and sample rays. */
+    for (int i = 0; i < num_rays; i++) {
+      int index = offset + x + start + i + y * stride;
+      buffers[i] = buffer + index * pass_stride;
+      active[i] = false;
+      visibility[i] = 0;
+
+      if (kernel_data.film.pass_adaptive_aux_buffer) {
+        ccl_global float4 *aux = (ccl_global float4 *)(buffers[i] +
+                                                       kernel_data.film.pass_adaptive_aux_buffer);
+        if ((*aux).w > 0.0f) {
+          continue;
+        }
+      }
+
+      uint rng_hash;
+      kernel_path_trace_setup(kg, sample, x + start + i, y, &rng_hash, &rays[i]);
+
+      if (rays[i].t == 0.0f) {
+        continue;
+      }
+
+      path_state_init(kg, emission_sd, &states[i], rng_hash, sample, &rays[i]);
+      visibility[i] = path_state_ray_visibility(kg, &states[i]);
+      active[i] = true;
+    }
+
+    /* Intersect camera rays. */
+    Intersection isects[PATH_PACKET_SIZE];
+    const bool traced = scene_intersect_packet8(kg, rays, visibility, active, num_rays, isects);
+
+    /* Integrate. */
+    for (int i = 0; i < num_rays; i++) {
+      if (!active[i]) {
+        continue;
+      }
+
+      float3 throughput = make_float3(1.0f, 1.0f, 1.0f);
+
+      PathRadiance L;
+      path_radiance_init(kg, &L);
+
+      kernel_path_integrate(kg,
+                            &states[i],
+                            throughput,
+                            &rays[i],
+                            &L,
+                            buffers[i],
+                            emission_sd,
+                            traced ? &isects[i] : NULL);
+
+      kernel_write_result(kg, buffers[i], sample, &L);
+    }
+  }
+}
+
+#    undef PATH_PACKET_SIZE
+
+#  endif /* __EMBREE__ */
+
 #endif /* __SPLIT_KERNEL__ */
 
 CCL_NAMESPACE_END
@@ -1387,6 +1387,11 @@ typedef struct KernelIntegrator {
 
   int max_closures;
 
+  /* light tree */
+  int use_light_tree;
+  float light_tree_pdf;
+  int num_light_tree_emitters;
+  int num_light_tree_infinite;
   int pad1, pad2;
 } KernelIntegrator;
 static_assert_align(KernelIntegrator, 16);
@@ -1548,6 +1553,34 @@ typedef struct KernelLightDistribution {
 } KernelLightDistribution;
 static_assert_align(KernelLightDistribution, 16);
 
+/* Node of the light tree used to importance sample many lights, see kernel_light_tree.h. */
+typedef struct KernelLightTreeNode {
+  /* Bounds, total energy and orientation cone of the emitters in the node. */
+  float bounds_min[3];
+  float energy;
+  float bounds_max[3];
+  float theta_o;
+  float axis[3];
+  float theta_e;
+
+  /* Interior node: index of the second child, the first child directly follows the node.
+   * Leaf node: index of the first emitter in __light_tree_emitter_order. */
+  int child_index;
+  /* Zero for interior nodes. */
+  int num_emitters;
+  int parent;
+  /* Emitters may face in both directions of the axis. */
+  int two_sided;
+} KernelLightTreeNode;
+static_assert_align(KernelLightTreeNode, 16);
+
+/* Light tree data of a light distribution entry, leaf is -1 for lights that are not in the
+ * tree. */
+typedef struct KernelLightTreeEmitter {
+  float energy;
+  int leaf;
+} KernelLightTreeEmitter;
+
 typedef struct KernelParticle {
   int index;
   float age;
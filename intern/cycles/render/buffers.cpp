@@ -15,14 +15,17 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "device/device.h"
 #include "render/buffers.h"
 
 #include "util/util_foreach.h"
 #include "util/util_hash.h"
+#include "util/util_logging.h"
 #include "util/util_math.h"
 #include "util/util_opengl.h"
+#include "util/util_path.h"
 #include "util/util_time.h"
 #include "util/util_types.h"
 
@@ -503,6 +506,206 @@ bool RenderBuffers::set_pass_rect(PassType type, int components, float *pixels,
   return false;
 }
 
+/* Render Checkpoint */
+
+static const char checkpoint_magic[8] = {'C', 'Y', 'C', 'L', 'E', 'S', 'C', 'P'};
+static const int checkpoint_version = 1;
+
+struct CheckpointHeader {
+  char magic[8];
+  int version;
+  int width, height;
+  int full_x, full_y;
+  int pass_stride;
+};
+
+struct CheckpointTileHeader {
+  int x, y, w, h;
+  int start_sample, end_sample;
+};
+
+static CheckpointHeader checkpoint_header(const BufferParams &params, int pass_stride)
+{
+  CheckpointHeader header;
+  memcpy(header.magic, checkpoint_magic, sizeof(header.magic));
+  header.version = checkpoint_version;
+  header.width = params.width;
+  header.height = params.height;
+  header.full_x = params.full_x;
+  header.full_y = params.full_y;
+  header.pass_stride = pass_stride;
+  return header;
+}
+
+static bool checkpoint_seek(FILE *file, int64_t offset)
+{
+#ifdef _WIN32
+  return _fseeki64(file, offset, SEEK_SET) == 0;
+#else
+  return fseeko(file, (off_t)offset, SEEK_SET) == 0;
+#endif
+}
+
+RenderCheckpoint::RenderCheckpoint(const string &filepath)
+    : filepath(filepath), file(NULL), file_end(0), pass_stride(0)
+{
+}
+
+RenderCheckpoint::~RenderCheckpoint()
+{
+  if (file) {
+    fclose(file);
+  }
+}
+
+bool RenderCheckpoint::open(const BufferParams &params_)
+{
+  thread_scoped_lock lock(mutex);
+
+  /* Copy is needed for the non-const get_passes_size. */
+  BufferParams params = params_;
+  pass_stride = params.get_passes_size();
+  tiles.clear();
+
+  if (file) {
+    fclose(file);
+  }
+
+  const CheckpointHeader header = checkpoint_header(params, pass_stride);
+  const int64_t file_size = path_exists(filepath) ? (int64_t)path_file_size(filepath) : 0;
+
+  file = (file_size >= (int64_t)sizeof(header)) ? path_fopen(filepath, "r+b") : NULL;
+  if (file) {
+    CheckpointHeader file_header;
+    if (fread(&file_header, sizeof(file_header), 1, file) != 1 ||
+        memcmp(&file_header, &header, sizeof(header)) != 0) {
+      VLOG(1) << "Render checkpoint " << filepath << " doesn't match the render, starting again.";
+      fclose(file);
+      file = NULL;
+    }
+  }
+
+  if (file) {
+    /* Read all complete tiles, a tile that was not fully written when the render was
+     * interrupted is overwritten by the next tile. */
+    file_end = sizeof(header);
+
+    while (file_end + (int64_t)sizeof(CheckpointTileHeader) <= file_size) {
+      CheckpointTileHeader tile_header;
+      if (!checkpoint_seek(file, file_end) ||
+          fread(&tile_header, sizeof(tile_header), 1, file) != 1) {
+        break;
+      }
+
+      if (tile_header.w <= 0 || tile_header.h <= 0 || tile_header.x < params.full_x ||
+          tile_header.y < params.full_y ||
+          tile_header.x + tile_header.w > params.full_x + params.width ||
+          tile_header.y + tile_header.h > params.full_y + params.height ||
+          tile_header.start_sample < 0 || tile_header.end_sample <= tile_header.start_sample) {
+        break;
+      }
+
+      const int64_t data_size = (int64_t)tile_header.w * tile_header.h * pass_stride *
+                                sizeof(float);
+      const int64_t offset = file_end + sizeof(tile_header);
+      if (offset + data_size > file_size) {
+        break;
+      }
+
+      StoredTile tile = {
+          tile_header.w, tile_header.h, tile_header.start_sample, tile_header.end_sample, offset};
+      tiles[make_pair(tile_header.x, tile_header.y)] = tile;
+      file_end = offset + data_size;
+    }
+
+    VLOG(1) << "Read " << tiles.size() << " tiles from render checkpoint " << filepath << ".";
+    return true;
+  }
+
+  file = path_fopen(filepath, "wb");
+  if (file == NULL || fwrite(&header, sizeof(header), 1, file) != 1) {
+    VLOG(1) << "Failed to create render checkpoint " << filepath << ".";
+    if (file) {
+      fclose(file);
+      file = NULL;
+    }
+    return false;
+  }
+
+  file_end = sizeof(header);
+  return true;
+}
+
+void RenderCheckpoint::remove()
+{
+  thread_scoped_lock lock(mutex);
+
+  if (file) {
+    fclose(file);
+    file = NULL;
+  }
+  tiles.clear();
+  path_remove(filepath);
+}
+
+int RenderCheckpoint::read_tile(RenderBuffers *buffers, int start_sample, int end_sample)
+{
+  thread_scoped_lock lock(mutex);
+
+  const BufferParams &params = buffers->params;
+  map<pair<int, int>, StoredTile>::iterator it = tiles.find(
+      make_pair(params.full_x, params.full_y));
+  if (file == NULL || it == tiles.end()) {
+    return start_sample;
+  }
+
+  const StoredTile &tile = it->second;
+  if (tile.w != params.width || tile.h != params.height || tile.start_sample != start_sample ||
+      tile.end_sample > end_sample) {
+    return start_sample;
+  }
+
+  const size_t size = (size_t)tile.w * tile.h * pass_stride;
+  if (buffers->buffer.size() != size || !checkpoint_seek(file, tile.offset) ||
+      fread(buffers->buffer.data(), sizeof(float), size, file) != size) {
+    buffers->zero();
+    return start_sample;
+  }
+
+  return tile.end_sample;
+}
+
+bool RenderCheckpoint::write_tile(RenderBuffers *buffers, int start_sample, int end_sample)
+{
+  thread_scoped_lock lock(mutex);
+
+  if (file == NULL) {
+    return false;
+  }
+
+  const BufferParams &params = buffers->params;
+  const size_t size = (size_t)params.width * params.height * pass_stride;
+  if (buffers->buffer.size() != size) {
+    return false;
+  }
+
+  CheckpointTileHeader tile_header = {
+      params.full_x, params.full_y, params.width, params.height, start_sample, end_sample};
+
+  if (!checkpoint_seek(file, file_end) ||
+      fwrite(&tile_header, sizeof(tile_header), 1, file) != 1 ||
+      fwrite(buffers->buffer.data(), sizeof(float), size, file) != size || fflush(file) != 0) {
+    VLOG(1) << "Failed to write tile to render checkpoint " << filepath << ".";
+    return false;
+  }
+
+  const int64_t offset = file_end + sizeof(tile_header);
+  StoredTile tile = {params.width, params.height, start_sample, end_sample, offset};
+  tiles[make_pair(params.full_x, params.full_y)] = tile;
+  file_end = offset + size * sizeof(float);
+  return true;
+}
+
 /* Display Buffer */
 
 DisplayBuffer::DisplayBuffer(Device *device, bool linear)
@@ -24,6 +24,7 @@
 #include "kernel/kernel_types.h"
 
 #include "util/util_half.h"
+#include "util/util_map.h"
 #include "util/util_string.h"
 #include "util/util_thread.h"
 #include "util/util_types.h"
@@ -95,6 +96,44 @@ class RenderBuffers {
   bool set_pass_rect(PassType type, int components, float *pixels, int samples);
 };
 
+/* Render Checkpoint
+ *
+ * File with the buffers of finished tiles, written during background renders so an interrupted
+ * render can read them back instead of rendering those tiles again. Tiles are stored along with
+ * their sample range, a tile that was rendered with fewer samples continues from there. */
+
+class RenderCheckpoint {
+ public:
+  explicit RenderCheckpoint(const string &filepath);
+  ~RenderCheckpoint();
+
+  /* Open the file and read the tiles stored in it. If it was written for different buffer
+   * parameters, it is started again. */
+  bool open(const BufferParams &params);
+  /* Remove the file, when the render finished. */
+  void remove();
+
+  /* Read the tile starting at start_sample into the buffers, returning the sample to continue
+   * rendering from, or start_sample when it is not stored. */
+  int read_tile(RenderBuffers *buffers, int start_sample, int end_sample);
+  /* Append the host memory of the buffers, rendered from start_sample to end_sample. */
+  bool write_tile(RenderBuffers *buffers, int start_sample, int end_sample);
+
+ protected:
+  struct StoredTile {
+    int w, h;
+    int start_sample, end_sample;
+    int64_t offset;
+  };
+
+  string filepath;
+  FILE *file;
+  int64_t file_end;
+  int pass_stride;
+  map<pair<int, int>, StoredTile> tiles;
+  thread_mutex mutex;
+};
+
 /* Display Buffer
  *
  * The buffer used for drawing during render, filled by converting the render
@@ -1237,6 +1237,11 @@ void GeometryManager::device_update_bvh(Device *device,
   if (!scene->bvh) {
     bvh = scene->bvh = BVH::create(bparams, scene->geometry, scene->objects, device);
   }
+  else {
+    /* Objects can be added or removed without reallocating the geometry data. */
+    bvh->geometry = scene->geometry;
+    bvh->objects = scene->objects;
+  }
 
   device->build_bvh(bvh, progress, can_refit);
 
@@ -1900,7 +1905,7 @@ void GeometryManager::device_update(Device *device,
 
   /* update the bvh even when there is no geometry so the kernel bvh data is still valid,
    * especially when removing all of the objects during interactive renders */
-  bool need_update_scene_bvh = (scene->bvh == nullptr);
+  bool need_update_scene_bvh = (scene->bvh == nullptr || (update_flags & TRANSFORM_MODIFIED));
   {
     scoped_callback_timer timer([scene](double time) {
       if (scene->update_stats) {
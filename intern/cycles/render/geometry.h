@@ -184,6 +184,8 @@ class GeometryManager {
 
     SHADER_ATTRIBUTE_MODIFIED = (1 << 8),
     SHADER_DISPLACEMENT_MODIFIED = (1 << 9),
+    /* Transform of an instance changed, only the scene BVH needs to be updated. */
+    TRANSFORM_MODIFIED = (1 << 10),
 
     GEOMETRY_ADDED = MESH_ADDED | HAIR_ADDED,
     GEOMETRY_REMOVED = MESH_REMOVED | HAIR_REMOVED,
@@ -219,7 +219,8 @@ ImageMetaData::ImageMetaData()
       colorspace(u_colorspace_raw),
       colorspace_file_format(""),
       use_transform_3d(false),
-      compress_as_srgb(false)
+      compress_as_srgb(false),
+      miplevel(0)
 {
 }
 
@@ -274,6 +275,11 @@ ImageLoader::ImageLoader()
 {
 }
 
+int ImageLoader::find_miplevel(const ImageMetaData &, const size_t, size_t *, size_t *)
+{
+  return 0;
+}
+
 ustring ImageLoader::osl_filepath() const
 {
   return ustring();
@@ -499,20 +505,36 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   }
 
   /* Get metadata. */
-  int width = img->metadata.width;
-  int height = img->metadata.height;
-  int depth = img->metadata.depth;
-  int components = img->metadata.channels;
+  ImageMetaData metadata = img->metadata;
+  int width = metadata.width;
+  int height = metadata.height;
+  int depth = metadata.depth;
+  int components = metadata.channels;
 
   /* Read pixels. */
   vector<StorageType> pixels_storage;
   StorageType *pixels;
-  const size_t max_size = max(max(width, height), depth);
+  size_t max_size = max(max(width, height), depth);
   if (max_size == 0) {
     /* Don't bother with empty images. */
     return false;
   }
 
+  /* Load a smaller mip level when the file has one, for example tiled files made with maketx.
+   * This avoids reading the full resolution only to scale it down. */
+  if (texture_limit > 0 && max_size > texture_limit && depth <= 1) {
+    size_t level_width, level_height;
+    const int miplevel = img->loader->find_miplevel(
+        metadata, texture_limit, &level_width, &level_height);
+    if (miplevel > 0) {
+      VLOG(1) << "Loading mip level " << miplevel << " of image " << img->loader->name() << ".";
+      metadata.miplevel = miplevel;
+      metadata.width = width = level_width;
+      metadata.height = height = level_height;
+      max_size = max(width, height);
+    }
+  }
+
   /* Allocate memory as needed, may be smaller to resize down. */
   if (texture_limit > 0 && max_size > texture_limit) {
     pixels_storage.resize(((size_t)width) * height * depth * 4);
@@ -529,8 +551,7 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   }
 
   const size_t num_pixels = ((size_t)width) * height * depth;
-  img->loader->load_pixels(
-      img->metadata, pixels, num_pixels * components, image_associate_alpha(img));
+  img->loader->load_pixels(metadata, pixels, num_pixels * components, image_associate_alpha(img));
 
   /* The kernel can handle 1 and 4 channel images. Anything that is not a single
    * channel image is converted to RGBA format. */
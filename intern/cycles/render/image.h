@@ -91,6 +91,10 @@ class ImageMetaData {
   /* Automatically set. */
   bool compress_as_srgb;
 
+  /* Mip level to load pixels from, set when a smaller level stored in the file is loaded
+   * instead of scaling down the full resolution, see ImageLoader.find_miplevel(). */
+  int miplevel;
+
   ImageMetaData();
   bool operator==(const ImageMetaData &other) const;
   bool is_float() const;
@@ -113,6 +117,13 @@ class ImageLoader {
                            const size_t pixels_size,
                            const bool associate_alpha) = 0;
 
+  /* Optional, find the largest mip level stored in the file that is no larger than max_size.
+   * Returns 0 when there is no such level, otherwise the level and its resolution. */
+  virtual int find_miplevel(const ImageMetaData &metadata,
+                            const size_t max_size,
+                            size_t *r_width,
+                            size_t *r_height);
+
   /* Name for logs and stats. */
   virtual string name() const = 0;
 
@@ -192,6 +192,10 @@ bool OIIOImageLoader::load_pixels(const ImageMetaData &metadata,
     return false;
   }
 
+  if (metadata.miplevel > 0 && !in->seek_subimage(0, metadata.miplevel, spec)) {
+    return false;
+  }
+
   switch (metadata.type) {
     case IMAGE_DATA_TYPE_BYTE:
     case IMAGE_DATA_TYPE_BYTE4:
@@ -219,6 +223,39 @@ bool OIIOImageLoader::load_pixels(const ImageMetaData &metadata,
   return true;
 }
 
+int OIIOImageLoader::find_miplevel(const ImageMetaData &metadata,
+                                   const size_t max_size,
+                                   size_t *r_width,
+                                   size_t *r_height)
+{
+  unique_ptr<ImageInput> in(ImageInput::create(filepath.string()));
+  if (!in) {
+    return 0;
+  }
+
+  ImageSpec spec;
+  if (!in->open(filepath.string(), spec)) {
+    return 0;
+  }
+
+  /* Levels are ordered from large to small, the first that fits is the largest one. */
+  int found_miplevel = 0;
+  for (int miplevel = 1; in->seek_subimage(0, miplevel, spec); miplevel++) {
+    if ((size_t)max(spec.width, spec.height) <= max_size) {
+      /* Pixels are read with the layout of the full resolution. */
+      if (spec.nchannels == metadata.channels && spec.depth <= 1) {
+        found_miplevel = miplevel;
+        *r_width = spec.width;
+        *r_height = spec.height;
+      }
+      break;
+    }
+  }
+
+  in->close();
+  return found_miplevel;
+}
+
 string OIIOImageLoader::name() const
 {
   return path_filename(filepath.string());
@@ -33,6 +33,11 @@ class OIIOImageLoader : public ImageLoader {
                    const size_t pixels_size,
                    const bool associate_alpha) override;
 
+  int find_miplevel(const ImageMetaData &metadata,
+                    const size_t max_size,
+                    size_t *r_width,
+                    size_t *r_height) override;
+
   string name() const override;
 
   ustring osl_filepath() const override;
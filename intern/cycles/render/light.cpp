@@ -20,6 +20,7 @@
 #include "render/film.h"
 #include "render/graph.h"
 #include "render/integrator.h"
+#include "render/light_tree.h"
 #include "render/mesh.h"
 #include "render/nodes.h"
 #include "render/object.h"
@@ -30,6 +31,7 @@
 #include "util/util_foreach.h"
 #include "util/util_hash.h"
 #include "util/util_logging.h"
+#include "util/util_map.h"
 #include "util/util_path.h"
 #include "util/util_progress.h"
 #include "util/util_task.h"
@@ -282,13 +284,24 @@ bool LightManager::object_usable_as_light(Object *object)
   return false;
 }
 
-void LightManager::device_update_distribution(Device *,
+void LightManager::device_update_distribution(Device *device,
                                               DeviceScene *dscene,
                                               Scene *scene,
                                               Progress &progress)
 {
   progress.set_status("Updating Lights", "Computing distribution");
 
+  /* The light tree selects a single light, it is not used when sampling all lights. */
+  Integrator *integrator = scene->integrator;
+  const bool branched = (integrator->get_method() == Integrator::BRANCHED_PATH) &&
+                        device->info.has_branched_path;
+  const bool use_light_tree = integrator->get_use_light_tree() &&
+                              !(branched && (integrator->get_sample_all_lights_direct() ||
+                                             integrator->get_sample_all_lights_indirect()));
+  vector<LightTreeEmitter> tree_emitters;
+  vector<int> tree_infinite_lights;
+  unordered_map<Shader *, float> shader_emission;
+
   /* count */
   size_t num_lights = 0;
   size_t num_portals = 0;
@@ -400,7 +413,31 @@ void LightManager::device_update_distribution(Device *,
           p3 = transform_point(&tfm, p3);
         }
 
-        totarea += triangle_area(p1, p2, p3);
+        const float area = triangle_area(p1, p2, p3);
+        totarea += area;
+
+        if (use_light_tree) {
+          if (shader_emission.find(shader) == shader_emission.end()) {
+            /* Shaders with textured emission get the same weight as an emission of one. */
+            float3 emission;
+            shader_emission[shader] = shader->is_constant_emission(&emission) ?
+                                          average(fabs(emission)) :
+                                          1.0f;
+          }
+
+          LightTreeEmitter emitter;
+          emitter.bounds = BoundBox(p1);
+          emitter.bounds.grow(p2);
+          emitter.bounds.grow(p3);
+          emitter.centroid = (p1 + p2 + p3) * (1.0f / 3.0f);
+          emitter.axis = safe_normalize(cross(p2 - p1, p3 - p1));
+          emitter.theta_o = 0.0f;
+          emitter.theta_e = M_PI_2_F;
+          emitter.two_sided = true;
+          emitter.energy = area * shader_emission[shader];
+          emitter.distribution_id = offset - 1;
+          tree_emitters.push_back(emitter);
+        }
       }
     }
 
@@ -424,6 +461,46 @@ void LightManager::device_update_distribution(Device *,
     distribution[offset].lamp.size = light->size;
     totarea += lightarea;
 
+    if (use_light_tree) {
+      if (light->light_type == LIGHT_DISTANT || light->light_type == LIGHT_BACKGROUND) {
+        tree_infinite_lights.push_back(offset);
+      }
+      else {
+        LightTreeEmitter emitter;
+        emitter.axis = safe_normalize(light->dir);
+        emitter.theta_o = 0.0f;
+        emitter.theta_e = M_PI_2_F;
+        emitter.two_sided = false;
+        emitter.energy = average(fabs(light->strength));
+        emitter.distribution_id = offset;
+
+        if (light->light_type == LIGHT_AREA) {
+          const float3 axisu = light->axisu * (light->sizeu * light->size);
+          const float3 axisv = light->axisv * (light->sizev * light->size);
+          emitter.bounds = BoundBox(light->co - 0.5f * (axisu + axisv));
+          emitter.bounds.grow(light->co + 0.5f * (axisu - axisv));
+          emitter.bounds.grow(light->co + 0.5f * (axisu + axisv));
+          emitter.bounds.grow(light->co - 0.5f * (axisu - axisv));
+        }
+        else {
+          emitter.bounds = BoundBox(light->co - make_float3(light->size),
+                                    light->co + make_float3(light->size));
+
+          /* Points emit in all directions, spots within the spot angle. */
+          if (light->light_type == LIGHT_SPOT) {
+            emitter.theta_o = 0.5f * light->spot_angle;
+          }
+          else {
+            emitter.axis = make_float3(0.0f, 0.0f, 1.0f);
+            emitter.theta_o = M_PI_F;
+          }
+        }
+
+        emitter.centroid = emitter.bounds.center();
+        tree_emitters.push_back(emitter);
+      }
+    }
+
     if (light->light_type == LIGHT_DISTANT) {
       use_lamp_mis |= (light->angle > 0.0f && light->use_mis);
     }
@@ -488,6 +565,17 @@ void LightManager::device_update_distribution(Device *,
 
     kintegrator->use_lamp_mis = use_lamp_mis;
 
+    /* light tree */
+    if (!tree_emitters.empty()) {
+      device_update_light_tree(dscene, tree_emitters, tree_infinite_lights, num_distribution);
+    }
+    else {
+      kintegrator->use_light_tree = false;
+      kintegrator->light_tree_pdf = 0.0f;
+      kintegrator->num_light_tree_emitters = 0;
+      kintegrator->num_light_tree_infinite = 0;
+    }
+
     /* bit of an ugly hack to compensate for emitting triangles influencing
      * amount of samples we get for this pass */
     kfilm->pass_shadow_scale = 1.0f;
@@ -524,6 +612,10 @@ void LightManager::device_update_distribution(Device *,
     kintegrator->pdf_triangles = 0.0f;
     kintegrator->pdf_lights = 0.0f;
     kintegrator->use_lamp_mis = false;
+    kintegrator->use_light_tree = false;
+    kintegrator->light_tree_pdf = 0.0f;
+    kintegrator->num_light_tree_emitters = 0;
+    kintegrator->num_light_tree_infinite = 0;
 
     kbackground->num_portals = 0;
     kbackground->portal_offset = 0;
@@ -535,6 +627,57 @@ void LightManager::device_update_distribution(Device *,
   }
 }
 
+void LightManager::device_update_light_tree(DeviceScene *dscene,
+                                            const vector<LightTreeEmitter> &emitters,
+                                            const vector<int> &infinite_lights,
+                                            size_t num_distribution)
+{
+  KernelIntegrator *kintegrator = &dscene->data.integrator;
+
+  LightTree tree(emitters, LIGHT_TREE_MAX_EMITTERS_IN_LEAF);
+  const vector<KernelLightTreeNode> &tree_nodes = tree.get_nodes();
+  const vector<int> &tree_order = tree.get_emitter_order();
+  const vector<int> &tree_leaves = tree.get_emitter_leaves();
+
+  VLOG(1) << "Light tree with " << tree_nodes.size() << " nodes for " << emitters.size()
+          << " emitters.";
+
+  KernelLightTreeNode *nodes = dscene->light_tree_nodes.alloc(tree_nodes.size());
+  std::copy(tree_nodes.begin(), tree_nodes.end(), nodes);
+
+  KernelLightTreeEmitter *kemitters = dscene->light_tree_emitters.alloc(num_distribution);
+  for (size_t i = 0; i < num_distribution; i++) {
+    kemitters[i].energy = 0.0f;
+    kemitters[i].leaf = -1;
+  }
+  for (size_t i = 0; i < emitters.size(); i++) {
+    KernelLightTreeEmitter &kemitter = kemitters[emitters[i].distribution_id];
+    kemitter.energy = emitters[i].energy;
+    kemitter.leaf = tree_leaves[i];
+  }
+
+  /* Distant and background lights follow the emitters of the tree. */
+  uint *order = dscene->light_tree_emitter_order.alloc(emitters.size() + infinite_lights.size());
+  for (size_t i = 0; i < emitters.size(); i++) {
+    order[i] = emitters[tree_order[i]].distribution_id;
+  }
+  for (size_t i = 0; i < infinite_lights.size(); i++) {
+    order[emitters.size() + i] = infinite_lights[i];
+  }
+
+  dscene->light_tree_nodes.copy_to_device();
+  dscene->light_tree_emitters.copy_to_device();
+  dscene->light_tree_emitter_order.copy_to_device();
+
+  /* Infinite lights keep the probability they have without the tree, so the background and
+   * distant light pdfs don't change. */
+  kintegrator->use_light_tree = true;
+  kintegrator->light_tree_pdf = max(1.0f - infinite_lights.size() * kintegrator->pdf_lights,
+                                    0.0f);
+  kintegrator->num_light_tree_emitters = emitters.size();
+  kintegrator->num_light_tree_infinite = infinite_lights.size();
+}
+
 static void background_cdf(
     int start, int end, int res_x, int res_y, const vector<float3> *pixels, float2 *cond_cdf)
 {
@@ -1014,6 +1157,9 @@ void LightManager::device_free(Device *, DeviceScene *dscene, const bool free_ba
 {
   dscene->light_distribution.free();
   dscene->lights.free();
+  dscene->light_tree_nodes.free();
+  dscene->light_tree_emitters.free();
+  dscene->light_tree_emitter_order.free();
   if (free_background) {
     dscene->light_background_marginal_cdf.free();
     dscene->light_background_conditional_cdf.free();
@@ -38,6 +38,7 @@ class Object;
 class Progress;
 class Scene;
 class Shader;
+struct LightTreeEmitter;
 
 class Light : public Node {
  public:
@@ -100,6 +101,7 @@ class LightManager {
     OBJECT_MANAGER = (1 << 5),
     SHADER_COMPILED = (1 << 6),
     SHADER_MODIFIED = (1 << 7),
+    INTEGRATOR_MODIFIED = (1 << 8),
 
     /* tag everything in the manager for an update */
     UPDATE_ALL = ~0u,
@@ -142,6 +144,10 @@ class LightManager {
                                   DeviceScene *dscene,
                                   Scene *scene,
                                   Progress &progress);
+  void device_update_light_tree(DeviceScene *dscene,
+                                const vector<LightTreeEmitter> &emitters,
+                                const vector<int> &infinite_lights,
+                                size_t num_distribution);
   void device_update_background(Device *device,
                                 DeviceScene *dscene,
                                 Scene *scene,
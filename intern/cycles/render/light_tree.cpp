@@ -0,0 +1,169 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "render/light_tree.h"
+
+#include "util/util_algorithm.h"
+#include "util/util_math.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Orientation cone bounding the normals of a set of emitters. */
+struct LightTreeCone {
+  float3 axis;
+  float theta_o;
+  float theta_e;
+};
+
+/* Smallest cone containing both cones, see "Importance Sampling of Many Lights with Adaptive
+ * Tree Splitting" by Estevez and Kulla. */
+static LightTreeCone light_tree_cone_merge(LightTreeCone a, LightTreeCone b)
+{
+  if (b.theta_o > a.theta_o) {
+    swap(a, b);
+  }
+
+  const float theta_d = safe_acosf(dot(a.axis, b.axis));
+  const float theta_e = max(a.theta_e, b.theta_e);
+
+  if (min(theta_d + b.theta_o, M_PI_F) <= a.theta_o) {
+    /* b is contained in a. */
+    a.theta_e = theta_e;
+    return a;
+  }
+
+  LightTreeCone cone;
+  cone.theta_e = theta_e;
+  cone.theta_o = 0.5f * (a.theta_o + theta_d + b.theta_o);
+
+  const float3 ortho = b.axis - a.axis * dot(a.axis, b.axis);
+  if (cone.theta_o >= M_PI_F || len_squared(ortho) == 0.0f) {
+    cone.axis = a.axis;
+    cone.theta_o = M_PI_F;
+    return cone;
+  }
+
+  /* Rotate the axis of a towards b. */
+  const float theta_r = cone.theta_o - a.theta_o;
+  cone.axis = normalize(a.axis * cosf(theta_r) + normalize(ortho) * sinf(theta_r));
+  return cone;
+}
+
+LightTree::LightTree(const vector<LightTreeEmitter> &emitters, int max_emitters_in_leaf)
+    : emitters(emitters), max_emitters_in_leaf(max(max_emitters_in_leaf, 1))
+{
+  if (emitters.empty()) {
+    return;
+  }
+
+  emitter_order.resize(emitters.size());
+  for (size_t i = 0; i < emitters.size(); i++) {
+    emitter_order[i] = i;
+  }
+  emitter_leaves.resize(emitters.size(), -1);
+
+  nodes.reserve(2 * emitters.size() / this->max_emitters_in_leaf + 1);
+  recursive_build(-1, 0, emitters.size());
+}
+
+int LightTree::recursive_build(int parent, int start, int end)
+{
+  BoundBox bounds = BoundBox::empty;
+  BoundBox centroid_bounds = BoundBox::empty;
+  float energy = 0.0f;
+  bool two_sided = false;
+
+  for (int i = start; i < end; i++) {
+    const LightTreeEmitter &emitter = emitters[emitter_order[i]];
+    bounds.grow(emitter.bounds);
+    centroid_bounds.grow(emitter.centroid);
+    energy += emitter.energy;
+    two_sided |= emitter.two_sided;
+  }
+
+  /* Merge the orientation cones, flipping the axis of emitters that emit in both directions
+   * when the node does too. */
+  LightTreeCone cone;
+  for (int i = start; i < end; i++) {
+    const LightTreeEmitter &emitter = emitters[emitter_order[i]];
+    LightTreeCone emitter_cone = {emitter.axis, emitter.theta_o, emitter.theta_e};
+
+    if (i == start) {
+      cone = emitter_cone;
+      continue;
+    }
+
+    if (two_sided && dot(emitter_cone.axis, cone.axis) < 0.0f) {
+      emitter_cone.axis = -emitter_cone.axis;
+    }
+    cone = light_tree_cone_merge(cone, emitter_cone);
+  }
+
+  const int node_index = nodes.size();
+  nodes.push_back(KernelLightTreeNode());
+
+  KernelLightTreeNode &knode = nodes[node_index];
+  knode.bounds_min[0] = bounds.min.x;
+  knode.bounds_min[1] = bounds.min.y;
+  knode.bounds_min[2] = bounds.min.z;
+  knode.bounds_max[0] = bounds.max.x;
+  knode.bounds_max[1] = bounds.max.y;
+  knode.bounds_max[2] = bounds.max.z;
+  knode.axis[0] = cone.axis.x;
+  knode.axis[1] = cone.axis.y;
+  knode.axis[2] = cone.axis.z;
+  knode.theta_o = cone.theta_o;
+  knode.theta_e = cone.theta_e;
+  knode.energy = energy;
+  knode.parent = parent;
+  knode.two_sided = two_sided;
+
+  if (end - start <= max_emitters_in_leaf) {
+    knode.child_index = start;
+    knode.num_emitters = end - start;
+
+    for (int i = start; i < end; i++) {
+      emitter_leaves[emitter_order[i]] = node_index;
+    }
+
+    return node_index;
+  }
+
+  knode.num_emitters = 0;
+
+  /* Median split along the longest axis of the centroids. */
+  const float3 extent = centroid_bounds.size();
+  const int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 :
+                   (extent.y >= extent.z)                        ? 1 :
+                                                                   2;
+  const int middle = (start + end) / 2;
+
+  std::nth_element(emitter_order.begin() + start,
+                   emitter_order.begin() + middle,
+                   emitter_order.begin() + end,
+                   [&](int a, int b) { return emitters[a].centroid[axis] <
+                                              emitters[b].centroid[axis]; });
+
+  recursive_build(node_index, start, middle);
+  const int second_child = recursive_build(node_index, middle, end);
+
+  /* The vector may have been reallocated by the children. */
+  nodes[node_index].child_index = second_child;
+
+  return node_index;
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __LIGHT_TREE_H__
+#define __LIGHT_TREE_H__
+
+#include "kernel/kernel_types.h"
+
+#include "util/util_boundbox.h"
+#include "util/util_types.h"
+#include "util/util_vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+#define LIGHT_TREE_MAX_EMITTERS_IN_LEAF 8
+
+/* Emitter in the light tree, a triangle or a point, spot or area lamp. */
+struct LightTreeEmitter {
+  BoundBox bounds;
+  float3 centroid;
+
+  /* Orientation cone: the emitter normals are within theta_o of the axis, and light is emitted
+   * within theta_e of the normals. */
+  float3 axis;
+  float theta_o;
+  float theta_e;
+  bool two_sided;
+
+  float energy;
+
+  /* Index in the light distribution. */
+  int distribution_id;
+};
+
+/* Binary tree over the emitters, traversed in the kernel to importance sample lights,
+ * see kernel_light_tree.h. Nodes are stored depth first, so the first child of an
+ * interior node directly follows it. */
+class LightTree {
+ public:
+  LightTree(const vector<LightTreeEmitter> &emitters, int max_emitters_in_leaf);
+
+  const vector<KernelLightTreeNode> &get_nodes() const
+  {
+    return nodes;
+  }
+
+  /* Indices of the emitters in the order they are referenced by the leaves. */
+  const vector<int> &get_emitter_order() const
+  {
+    return emitter_order;
+  }
+
+  /* Leaf node of each emitter. */
+  const vector<int> &get_emitter_leaves() const
+  {
+    return emitter_leaves;
+  }
+
+ protected:
+  int recursive_build(int parent, int start, int end);
+
+  const vector<LightTreeEmitter> &emitters;
+  int max_emitters_in_leaf;
+
+  vector<KernelLightTreeNode> nodes;
+  vector<int> emitter_order;
+  vector<int> emitter_leaves;
+};
+
+CCL_NAMESPACE_END
+
+#endif /* __LIGHT_TREE_H__ */
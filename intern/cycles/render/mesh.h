@@ -194,6 +194,13 @@ class Mesh : public Geometry {
 
   SubdParams *subd_params = nullptr;
 
+  /* Result of the last tessellation, reused when the control mesh did not change and the
+   * dicing camera moved less than SubdParams::cache_threshold, see Mesh::tessellate. */
+  struct TessellationCache;
+  TessellationCache *tessellation_cache = nullptr;
+
+  void free_tessellation_cache();
+
  public:
   /* Functions */
   Mesh();
@@ -25,6 +25,8 @@
 #include "util/util_algorithm.h"
 #include "util/util_foreach.h"
 #include "util/util_hash.h"
+#include "util/util_logging.h"
+#include "util/util_murmurhash.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -369,8 +371,206 @@ struct OsdPatch : Patch {
 
 #endif
 
+/* Tessellation Cache */
+
+struct Mesh::TessellationCache {
+  struct CachedAttribute {
+    ustring name;
+    AttributeStandard std;
+    TypeDesc type;
+    AttributeElement element;
+    uint flags;
+    vector<char> buffer;
+  };
+
+  uint32_t key;
+  bool use_camera;
+  Transform objecttoworld;
+  ProjectionTransform worldtoraster;
+  BoundBox bounds;
+
+  SubdivisionType subdivision_type;
+  array<float3> verts;
+  array<int> triangles;
+  array<int> shader;
+  array<bool> smooth;
+  array<int> triangle_patch;
+  array<float2> vert_patch_uv;
+  size_t num_subd_verts;
+  unordered_map<int, int> vert_to_stitching_key_map;
+  unordered_multimap<int, int> vert_stitching_map;
+  vector<CachedAttribute> attributes;
+  vector<CachedAttribute> subd_attributes;
+
+  TessellationCache() : key(0), bounds(BoundBox::empty)
+  {
+  }
+
+  template<typename T> static uint32_t hash_array(const array<T> &data, uint32_t seed)
+  {
+    return util_murmur_hash3(data.data(), data.size() * sizeof(T), seed);
+  }
+
+  static uint32_t hash_attributes(const AttributeSet &attributes, uint32_t seed)
+  {
+    foreach (const Attribute &attr, attributes.attributes) {
+      seed = util_murmur_hash3(attr.name.c_str(), attr.name.size(), seed);
+      seed = util_murmur_hash3(&attr.element, sizeof(attr.element), seed);
+      seed = util_murmur_hash3(attr.buffer.data(), attr.buffer.size(), seed);
+    }
+    return seed;
+  }
+
+  /* Hash of everything the tessellation depends on, except for the dicing camera and object
+   * transform which are compared in can_reuse(). */
+  static uint32_t compute_key(const Mesh *mesh)
+  {
+    uint32_t key = 0;
+    key = util_murmur_hash3(&mesh->subdivision_type, sizeof(mesh->subdivision_type), key);
+    key = util_murmur_hash3(&mesh->subd_dicing_rate, sizeof(mesh->subd_dicing_rate), key);
+    key = util_murmur_hash3(&mesh->subd_max_level, sizeof(mesh->subd_max_level), key);
+    key = hash_array(mesh->verts, key);
+    key = hash_array(mesh->triangles, key);
+    key = hash_array(mesh->subd_start_corner, key);
+    key = hash_array(mesh->subd_num_corners, key);
+    key = hash_array(mesh->subd_shader, key);
+    key = hash_array(mesh->subd_smooth, key);
+    key = hash_array(mesh->subd_ptex_offset, key);
+    key = hash_array(mesh->subd_face_corners, key);
+    key = hash_array(mesh->subd_creases_edge, key);
+    key = hash_array(mesh->subd_creases_weight, key);
+    key = hash_attributes(mesh->attributes, key);
+    key = hash_attributes(mesh->subd_attributes, key);
+    return key;
+  }
+
+  bool can_reuse(uint32_t key_, const SubdParams &params) const
+  {
+    if (key != key_ || params.cache_threshold < 0.0f) {
+      return false;
+    }
+
+    /* Without camera the edge factors are computed in object space. */
+    if (!params.camera || !use_camera) {
+      return params.camera == NULL && !use_camera;
+    }
+
+    /* Edge factors are measured in raster space, compare how far the corners of the control
+     * mesh bounds moved on screen since the last tessellation. */
+    float max_shift = 0.0f;
+
+    for (int i = 0; i < 8; i++) {
+      float3 P = make_float3((i & 1) ? bounds.max.x : bounds.min.x,
+                             (i & 2) ? bounds.max.y : bounds.min.y,
+                             (i & 4) ? bounds.max.z : bounds.min.z);
+
+      float3 Pprev = transform_perspective(&worldtoraster, transform_point(&objecttoworld, P));
+      float3 Pcurr = transform_perspective(&params.camera->worldtoraster,
+                                           transform_point(&params.objecttoworld, P));
+
+      max_shift = max(max_shift, len(make_float2(Pcurr.x - Pprev.x, Pcurr.y - Pprev.y)));
+    }
+
+    return max_shift <= params.cache_threshold * params.dicing_rate;
+  }
+
+  static void store_attributes(vector<CachedAttribute> &cached, const AttributeSet &attributes)
+  {
+    cached.clear();
+
+    foreach (const Attribute &attr, attributes.attributes) {
+      CachedAttribute cached_attr;
+      cached_attr.name = attr.name;
+      cached_attr.std = attr.std;
+      cached_attr.type = attr.type;
+      cached_attr.element = attr.element;
+      cached_attr.flags = attr.flags;
+      cached_attr.buffer = attr.buffer;
+      cached.push_back(std::move(cached_attr));
+    }
+  }
+
+  static void restore_attributes(AttributeSet &attributes, const vector<CachedAttribute> &cached)
+  {
+    foreach (const CachedAttribute &cached_attr, cached) {
+      Attribute *attr = attributes.add(cached_attr.name, cached_attr.type, cached_attr.element);
+      attr->std = cached_attr.std;
+      attr->flags = cached_attr.flags;
+      attr->buffer = cached_attr.buffer;
+      attr->modified = true;
+    }
+  }
+
+  void store(const Mesh *mesh, uint32_t key_, const SubdParams &params)
+  {
+    key = key_;
+    use_camera = (params.camera != NULL);
+    objecttoworld = params.objecttoworld;
+    if (use_camera) {
+      worldtoraster = params.camera->worldtoraster;
+    }
+
+    /* The control mesh verts come before the diced verts. */
+    bounds = BoundBox::empty;
+    for (size_t i = 0; i < mesh->verts.size() - mesh->num_subd_verts; i++) {
+      bounds.grow(mesh->verts[i]);
+    }
+
+    subdivision_type = mesh->subdivision_type;
+    verts = mesh->verts;
+    triangles = mesh->triangles;
+    shader = mesh->shader;
+    smooth = mesh->smooth;
+    triangle_patch = mesh->triangle_patch;
+    vert_patch_uv = mesh->vert_patch_uv;
+    num_subd_verts = mesh->num_subd_verts;
+    vert_to_stitching_key_map = mesh->vert_to_stitching_key_map;
+    vert_stitching_map = mesh->vert_stitching_map;
+    store_attributes(attributes, mesh->attributes);
+    store_attributes(subd_attributes, mesh->subd_attributes);
+  }
+
+  void restore(Mesh *mesh) const
+  {
+    mesh->subdivision_type = subdivision_type;
+    mesh->verts = verts;
+    mesh->triangles = triangles;
+    mesh->shader = shader;
+    mesh->smooth = smooth;
+    mesh->triangle_patch = triangle_patch;
+    mesh->vert_patch_uv = vert_patch_uv;
+    mesh->num_subd_verts = num_subd_verts;
+    mesh->vert_to_stitching_key_map = vert_to_stitching_key_map;
+    mesh->vert_stitching_map = vert_stitching_map;
+    restore_attributes(mesh->attributes, attributes);
+    restore_attributes(mesh->subd_attributes, subd_attributes);
+
+    mesh->tag_verts_modified();
+    mesh->tag_triangles_modified();
+    mesh->tag_shader_modified();
+    mesh->tag_smooth_modified();
+    mesh->tag_triangle_patch_modified();
+    mesh->tag_vert_patch_uv_modified();
+  }
+};
+
+void Mesh::free_tessellation_cache()
+{
+  delete tessellation_cache;
+  tessellation_cache = NULL;
+}
+
 void Mesh::tessellate(DiagSplit *split)
 {
+  const SubdParams *params = get_subd_params();
+  const uint32_t cache_key = TessellationCache::compute_key(this);
+
+  if (tessellation_cache && tessellation_cache->can_reuse(cache_key, *params)) {
+    VLOG(1) << "Reusing tessellation of mesh " << name;
+    tessellation_cache->restore(this);
+    return;
+  }
+
   /* reset the number of subdivision vertices, in case the Mesh was not cleared
    * between calls or data updates */
   num_subd_verts = 0;
@@ -643,6 +843,16 @@ void Mesh::tessellate(DiagSplit *split)
     patch_table->pack(osd_data.patch_table);
   }
 #endif
+
+  if (params->cache_threshold >= 0.0f) {
+    if (!tessellation_cache) {
+      tessellation_cache = new TessellationCache();
+    }
+    tessellation_cache->store(this, cache_key, *params);
+  }
+  else {
+    free_tessellation_cache();
+  }
 }
 
 CCL_NAMESPACE_END
@@ -221,9 +221,14 @@ void Object::tag_update(Scene *scene)
 
   if (geometry) {
     if (tfm_is_modified()) {
+      if (!geometry->transform_applied) {
+        /* The geometry is instanced, its own BVH and device data don't depend on the transform,
+         * only the scene BVH needs to be rebuilt or refitted. */
+        scene->geometry_manager->tag_update(scene, GeometryManager::TRANSFORM_MODIFIED);
+      }
       /* tag the geometry as modified so the BVH is updated, but do not tag everything as modified
        */
-      if (geometry->is_mesh() || geometry->is_volume()) {
+      else if (geometry->is_mesh() || geometry->is_volume()) {
         Mesh *mesh = static_cast<Mesh *>(geometry);
         mesh->tag_verts_modified();
       }
@@ -895,6 +900,23 @@ void ObjectManager::apply_static_transforms(DeviceScene *dscene, Scene *scene, P
           object->apply_transform(apply_to_motion);
           geom->transform_applied = true;
 
+          /* Object::tag_update() doesn't tag instanced geometry when its object is moved, so
+           * geometry that is transformed now might not be tagged for the device update yet. */
+          if (geom->is_mesh() || geom->is_volume()) {
+            Mesh *mesh = static_cast<Mesh *>(geom);
+            if (!mesh->verts_is_modified()) {
+              mesh->tag_verts_modified();
+              dscene->tri_vnormal.tag_modified();
+            }
+          }
+          else if (geom->is_hair()) {
+            Hair *hair = static_cast<Hair *>(geom);
+            if (!hair->curve_keys_is_modified()) {
+              hair->tag_curve_keys_modified();
+              dscene->curve_keys.tag_modified();
+            }
+          }
+
           if (progress.get_cancel())
             return;
         }
@@ -114,6 +114,9 @@ class DeviceScene {
   /* lights */
   device_vector<KernelLightDistribution> light_distribution;
   device_vector<KernelLight> lights;
+  device_vector<KernelLightTreeNode> light_tree_nodes;
+  device_vector<KernelLightTreeEmitter> light_tree_emitters;
+  device_vector<uint> light_tree_emitter_order;
   device_vector<float2> light_background_marginal_cdf;
   device_vector<float2> light_background_conditional_cdf;
 
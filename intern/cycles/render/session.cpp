@@ -77,6 +77,7 @@ Session::Session(const SessionParams &params_)
 
   buffers = NULL;
   display = NULL;
+  checkpoint = NULL;
 
   /* Validate denoising parameters. */
   set_denoising(params.denoising);
@@ -119,6 +120,7 @@ Session::~Session()
 
   delete buffers;
   delete display;
+  delete checkpoint;
   delete scene;
   delete device;
 
@@ -539,6 +541,17 @@ bool Session::acquire_tile(RenderTile &rtile, Device *tile_device, uint tile_typ
     /* allocate buffers */
     tile->buffers = new RenderBuffers(tile_device);
     tile->buffers->reset(buffer_params);
+
+    /* Continue from the samples stored in the checkpoint. */
+    if (checkpoint && rtile.task == RenderTile::PATH_TRACE) {
+      const int end_sample = rtile.start_sample + rtile.num_samples;
+      const int sample = checkpoint->read_tile(tile->buffers, rtile.start_sample, end_sample);
+      if (sample != rtile.start_sample) {
+        tile->buffers->buffer.copy_to_device();
+        rtile.start_sample = sample;
+        rtile.num_samples = end_sample - sample;
+      }
+    }
   }
   else if (tile->buffers->buffer.device != tile_device) {
     /* Move buffer to current tile device again in case it was stolen before.
@@ -555,7 +568,7 @@ bool Session::acquire_tile(RenderTile &rtile, Device *tile_device, uint tile_typ
 
   rtile.buffer = tile->buffers->buffer.device_pointer;
   rtile.buffers = tile->buffers;
-  rtile.sample = tile_manager.state.sample;
+  rtile.sample = rtile.start_sample;
 
   if (read_bake_tile_cb) {
     /* This will read any passes needed as input for baking. */
@@ -618,6 +631,13 @@ void Session::release_tile(RenderTile &rtile, const bool need_denoise)
 
   progress.add_finished_tile(rtile.task == RenderTile::DENOISE);
 
+  /* Store the tile before it is denoised, so it can be denoised again with its neighbors when
+   * the render is resumed. Tiles that were cancelled store the samples they finished. */
+  if (checkpoint && rtile.task == RenderTile::PATH_TRACE && rtile.sample > rtile.start_sample &&
+      rtile.buffers->copy_from_device()) {
+    checkpoint->write_tile(rtile.buffers, tile_manager.state.sample, rtile.sample);
+  }
+
   bool delete_tile;
 
   if (tile_manager.finish_tile(rtile.tile_index, need_denoise, delete_tile)) {
@@ -877,7 +897,9 @@ void Session::run_cpu()
 
 void Session::run()
 {
-  if (params.use_profiling && (params.device.type == DEVICE_CPU)) {
+  if (params.use_profiling) {
+    /* Samples the render threads on the CPU, GPU devices measure their kernels while the
+     * profiler is running. */
     profiler.start();
   }
 
@@ -893,6 +915,11 @@ void Session::run()
       run_gpu();
     else
       run_cpu();
+
+    /* The checkpoint is not needed anymore once all tiles are rendered. */
+    if (checkpoint && !progress.get_cancel() && !progress.get_error()) {
+      checkpoint->remove();
+    }
   }
 
   profiler.stop();
@@ -924,6 +951,18 @@ void Session::reset_(BufferParams &buffer_params, int samples)
 
   tile_manager.reset(buffer_params, samples);
   stealable_tiles = 0;
+
+  delete checkpoint;
+  checkpoint = NULL;
+  if (!checkpoint_filepath.empty() && !buffers && !params.progressive_refine &&
+      !read_bake_tile_cb) {
+    checkpoint = new RenderCheckpoint(checkpoint_filepath);
+    if (!checkpoint->open(buffer_params)) {
+      delete checkpoint;
+      checkpoint = NULL;
+    }
+  }
+
   tile_stealing_state = NOT_STEALING;
   progress.reset_sample();
 
@@ -1010,6 +1049,11 @@ void Session::set_denoising_start_sample(int sample)
   }
 }
 
+void Session::set_checkpoint_filepath(const string &filepath)
+{
+  checkpoint_filepath = filepath;
+}
+
 void Session::wait()
 {
   if (session_thread) {
@@ -1314,6 +1358,9 @@ void Session::collect_statistics(RenderStats *render_stats)
   if (params.use_profiling && (params.device.type == DEVICE_CPU)) {
     render_stats->collect_profiling(scene, profiler);
   }
+  if (params.use_profiling) {
+    render_stats->collect_device_profiling(profiler);
+  }
 }
 
 CCL_NAMESPACE_END
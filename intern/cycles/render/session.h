@@ -37,6 +37,7 @@ class DeviceRequestedFeatures;
 class DisplayBuffer;
 class Progress;
 class RenderBuffers;
+class RenderCheckpoint;
 class Scene;
 
 /* Session Parameters */
@@ -158,6 +159,11 @@ class Session {
   void set_denoising(const DenoiseParams &denoising);
   void set_denoising_start_sample(int sample);
 
+  /* Write finished tiles to a checkpoint file and read them back when an interrupted render is
+   * started again, empty to disable. Only used for background renders with tiles, the file is
+   * opened on reset and removed when the render finished. */
+  void set_checkpoint_filepath(const string &filepath);
+
   bool update_scene();
 
   void device_free();
@@ -227,6 +233,9 @@ class Session {
   double last_update_time;
   double last_display_time;
 
+  string checkpoint_filepath;
+  RenderCheckpoint *checkpoint;
+
   RenderTile stolen_tile;
   typedef enum {
     NOT_STEALING,     /* There currently is no tile stealing in progress. */
@@ -252,11 +252,46 @@ string ImageStats::full_report(int indent_level)
   return result;
 }
 
+/* Device kernel statistics. */
+
+DeviceKernelStats::DeviceKernelStats() : occupancy(-1.0)
+{
+}
+
+string DeviceKernelStats::full_report(int indent_level)
+{
+  const string indent(indent_level * kIndentNumSpaces, ' ');
+
+  vector<pair<string, ProfilingDeviceKernel>> sorted_kernels(kernels.begin(), kernels.end());
+  sort(sorted_kernels.begin(),
+       sorted_kernels.end(),
+       [](const pair<string, ProfilingDeviceKernel> &a,
+          const pair<string, ProfilingDeviceKernel> &b) { return a.second.time > b.second.time; });
+
+  string result = "";
+  for (const pair<string, ProfilingDeviceKernel> &entry : sorted_kernels) {
+    const ProfilingDeviceKernel &kernel = entry.second;
+    const double launch_time = kernel.time / kernel.launches;
+    result += indent + string_printf("%-32s: %.2fs (%s launches, %.2fms per launch, %s threads)\n",
+                                     entry.first.c_str(),
+                                     kernel.time,
+                                     string_human_readable_number(kernel.launches).c_str(),
+                                     launch_time * 1000.0,
+                                     string_human_readable_number(kernel.work_size).c_str());
+  }
+  if (occupancy >= 0.0) {
+    result += indent +
+              string_printf("%-32s: %.1f%%\n", "Split kernel occupancy", occupancy * 100.0);
+  }
+  return result;
+}
+
 /* Overall statistics. */
 
 RenderStats::RenderStats()
 {
   has_profiling = false;
+  has_device_profiling = false;
 }
 
 void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
@@ -329,6 +364,13 @@ void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
   }
 }
 
+void RenderStats::collect_device_profiling(Profiler &prof)
+{
+  device_kernels.kernels = prof.get_device_kernels();
+  device_kernels.occupancy = prof.get_device_occupancy();
+  has_device_profiling = !device_kernels.kernels.empty();
+}
+
 string RenderStats::full_report()
 {
   string result = "";
@@ -339,8 +381,11 @@ string RenderStats::full_report()
     result += "Shader statistics:\n" + shaders.full_report(1);
     result += "Object statistics:\n" + objects.full_report(1);
   }
-  else {
-    result += "Profiling information not available (only works with CPU rendering)";
+  if (has_device_profiling) {
+    result += "Device kernel statistics:\n" + device_kernels.full_report(1);
+  }
+  if (!has_profiling && !has_device_profiling) {
+    result += "Profiling information not available (only works with CPU and CUDA rendering)";
   }
   return result;
 }
@@ -19,6 +19,7 @@
 
 #include "render/scene.h"
 
+#include "util/util_profiling.h"
 #include "util/util_stats.h"
 #include "util/util_string.h"
 #include "util/util_vector.h"
@@ -173,6 +174,19 @@ class ImageStats {
   NamedSizeStats textures;
 };
 
+/* Statistics about kernels measured by GPU devices. */
+class DeviceKernelStats {
+ public:
+  DeviceKernelStats();
+
+  /* Generate full human-readable report. */
+  string full_report(int indent_level = 0);
+
+  map<string, ProfilingDeviceKernel> kernels;
+  /* Average fraction of active split kernel lanes, negative if not available. */
+  double occupancy;
+};
+
 /* Render process statistics. */
 class RenderStats {
  public:
@@ -184,13 +198,18 @@ class RenderStats {
   /* Collect kernel sampling information from Stats. */
   void collect_profiling(Scene *scene, Profiler &prof);
 
+  /* Collect kernel timings measured by GPU devices. */
+  void collect_device_profiling(Profiler &prof);
+
   bool has_profiling;
+  bool has_device_profiling;
 
   MeshStats mesh;
   ImageStats image;
   NamedNestedSampleStats kernel;
   NamedSampleCountStats shaders;
   NamedSampleCountStats objects;
+  DeviceKernelStats device_kernels;
 };
 
 class UpdateTimeStats {
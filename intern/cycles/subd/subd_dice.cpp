@@ -45,8 +45,12 @@ void EdgeDice::reserve(int num_verts, int num_triangles)
   vert_offset = mesh->get_verts().size();
   tri_offset = mesh->num_triangles();
 
-  mesh->resize_mesh(mesh->get_verts().size() + num_verts, mesh->num_triangles());
-  mesh->reserve_mesh(mesh->get_verts().size() + num_verts, mesh->num_triangles() + num_triangles);
+  mesh->resize_mesh(mesh->get_verts().size() + num_verts, mesh->num_triangles() + num_triangles);
+
+  mesh->tag_triangles_modified();
+  mesh->tag_shader_modified();
+  mesh->tag_smooth_modified();
+  mesh->tag_triangle_patch_modified();
 
   Attribute *attr_vN = mesh->attributes.add(ATTR_STD_VERTEX_NORMAL);
 
@@ -73,8 +77,14 @@ void EdgeDice::add_triangle(Patch *patch, int v0, int v1, int v2)
 {
   Mesh *mesh = params.mesh;
 
-  mesh->add_triangle(v0 + vert_offset, v1 + vert_offset, v2 + vert_offset, patch->shader, true);
-  params.mesh->triangle_patch[params.mesh->num_triangles() - 1] = patch->patch_index;
+  assert(tri_offset < mesh->num_triangles());
+
+  mesh->triangles[tri_offset * 3 + 0] = v0 + vert_offset;
+  mesh->triangles[tri_offset * 3 + 1] = v1 + vert_offset;
+  mesh->triangles[tri_offset * 3 + 2] = v2 + vert_offset;
+  mesh->shader[tri_offset] = patch->shader;
+  mesh->smooth[tri_offset] = true;
+  mesh->triangle_patch[tri_offset] = patch->patch_index;
 
   tri_offset++;
 }
@@ -157,12 +167,18 @@ void QuadDice::set_vert(Subpatch &sub, int index, float u, float v)
   EdgeDice::set_vert(sub.patch, index, map_uv(sub, u, v));
 }
 
-void QuadDice::set_side(Subpatch &sub, int edge)
+void QuadDice::set_side(Subpatch &sub, int edge, const int *vert_owner, int owner)
 {
   int t = sub.edges[edge].T;
 
   /* set verts on the edge of the patch */
   for (int i = 0; i < t; i++) {
+    int index = sub.get_vert_along_edge(edge, i);
+
+    if (vert_owner && vert_owner[index] != owner) {
+      continue;
+    }
+
     float f = i / (float)t;
 
     float u, v;
@@ -186,7 +202,7 @@ void QuadDice::set_side(Subpatch &sub, int edge)
         break;
     }
 
-    set_vert(sub, sub.get_vert_along_edge(edge, i), u, v);
+    set_vert(sub, index, u, v);
   }
 }
 
@@ -224,7 +240,23 @@ float QuadDice::scale_factor(Subpatch &sub, int Mu, int Mv)
   return S;
 }
 
-void QuadDice::add_grid(Subpatch &sub, int Mu, int Mv, int offset)
+void QuadDice::grid_size(Subpatch &sub, int &Mu, int &Mv)
+{
+  /* compute inner grid size with scale factor */
+  Mu = max(sub.edge_u0.T, sub.edge_u1.T);
+  Mv = max(sub.edge_v0.T, sub.edge_v1.T);
+
+#if 0 /* Doesn't work very well, especially at grazing angles. */
+  float S = scale_factor(sub, ef, Mu, Mv);
+#else
+  float S = 1.0f;
+#endif
+
+  Mu = max((int)ceilf(S * Mu), 2);  // XXX handle 0 & 1?
+  Mv = max((int)ceilf(S * Mv), 2);  // XXX handle 0 & 1?
+}
+
+void QuadDice::set_grid_verts(Subpatch &sub, int Mu, int Mv, int offset)
 {
   /* create inner grid */
   float du = 1.0f / (float)Mu;
@@ -236,43 +268,46 @@ void QuadDice::add_grid(Subpatch &sub, int Mu, int Mv, int offset)
       float v = j * dv;
 
       set_vert(sub, offset + (i - 1) + (j - 1) * (Mu - 1), u, v);
-
-      if (i < Mu - 1 && j < Mv - 1) {
-        int i1 = offset + (i - 1) + (j - 1) * (Mu - 1);
-        int i2 = offset + i + (j - 1) * (Mu - 1);
-        int i3 = offset + i + j * (Mu - 1);
-        int i4 = offset + (i - 1) + j * (Mu - 1);
-
-        add_triangle(sub.patch, i1, i2, i3);
-        add_triangle(sub.patch, i1, i3, i4);
-      }
     }
   }
 }
 
-void QuadDice::dice(Subpatch &sub)
+void QuadDice::add_grid_triangles(Subpatch &sub, int Mu, int Mv, int offset)
 {
-  /* compute inner grid size with scale factor */
-  int Mu = max(sub.edge_u0.T, sub.edge_u1.T);
-  int Mv = max(sub.edge_v0.T, sub.edge_v1.T);
-
-#if 0 /* Doesn't work very well, especially at grazing angles. */
-  float S = scale_factor(sub, ef, Mu, Mv);
-#else
-  float S = 1.0f;
-#endif
+  for (int j = 1; j < Mv - 1; j++) {
+    for (int i = 1; i < Mu - 1; i++) {
+      int i1 = offset + (i - 1) + (j - 1) * (Mu - 1);
+      int i2 = offset + i + (j - 1) * (Mu - 1);
+      int i3 = offset + i + j * (Mu - 1);
+      int i4 = offset + (i - 1) + j * (Mu - 1);
+
+      add_triangle(sub.patch, i1, i2, i3);
+      add_triangle(sub.patch, i1, i3, i4);
+    }
+  }
+}
 
-  Mu = max((int)ceilf(S * Mu), 2);  // XXX handle 0 & 1?
-  Mv = max((int)ceilf(S * Mv), 2);  // XXX handle 0 & 1?
+void QuadDice::dice_verts(Subpatch &sub, const int *vert_owner, int owner)
+{
+  int Mu, Mv;
+  grid_size(sub, Mu, Mv);
 
   /* inner grid */
-  add_grid(sub, Mu, Mv, sub.inner_grid_vert_offset);
+  set_grid_verts(sub, Mu, Mv, sub.inner_grid_vert_offset);
 
   /* sides */
-  set_side(sub, 0);
-  set_side(sub, 1);
-  set_side(sub, 2);
-  set_side(sub, 3);
+  set_side(sub, 0, vert_owner, owner);
+  set_side(sub, 1, vert_owner, owner);
+  set_side(sub, 2, vert_owner, owner);
+  set_side(sub, 3, vert_owner, owner);
+}
+
+void QuadDice::dice_triangles(Subpatch &sub)
+{
+  int Mu, Mv;
+  grid_size(sub, Mu, Mv);
+
+  add_grid_triangles(sub, Mu, Mv, sub.inner_grid_vert_offset);
 
   stitch_triangles(sub, 0);
   stitch_triangles(sub, 1);
@@ -280,4 +315,10 @@ void QuadDice::dice(Subpatch &sub)
   stitch_triangles(sub, 3);
 }
 
+void QuadDice::dice(Subpatch &sub)
+{
+  dice_verts(sub);
+  dice_triangles(sub);
+}
+
 CCL_NAMESPACE_END
@@ -44,6 +44,10 @@ struct SubdParams {
   Camera *camera;
   Transform objecttoworld;
 
+  /* Reuse the previous tessellation of an unchanged mesh when its bounds moved less than
+   * this fraction of the dicing rate in raster space, negative to always tessellate again. */
+  float cache_threshold;
+
   SubdParams(Mesh *mesh_, bool ptex_ = false)
   {
     mesh = mesh_;
@@ -54,6 +58,7 @@ struct SubdParams {
     dicing_rate = 1.0f;
     max_level = 12;
     camera = NULL;
+    cache_threshold = 0.5f;
   }
 };
 
@@ -69,6 +74,8 @@ class EdgeDice {
 
   explicit EdgeDice(const SubdParams &params);
 
+  /* Allocate all vertices and triangles up front, so subpatches can be diced in parallel
+   * with each writing its triangles starting at its own tri_offset. */
   void reserve(int num_verts, int num_triangles);
 
   void set_vert(Patch *patch, int index, float2 uv);
@@ -88,13 +95,21 @@ class QuadDice : public EdgeDice {
   float2 map_uv(Subpatch &sub, float u, float v);
   void set_vert(Subpatch &sub, int index, float u, float v);
 
-  void add_grid(Subpatch &sub, int Mu, int Mv, int offset);
+  void grid_size(Subpatch &sub, int &Mu, int &Mv);
+  void set_grid_verts(Subpatch &sub, int Mu, int Mv, int offset);
+  void add_grid_triangles(Subpatch &sub, int Mu, int Mv, int offset);
 
-  void set_side(Subpatch &sub, int edge);
+  /* Only set the verts of the edge for which vert_owner matches owner, when given. */
+  void set_side(Subpatch &sub, int edge, const int *vert_owner = NULL, int owner = 0);
 
   float quad_area(const float3 &a, const float3 &b, const float3 &c, const float3 &d);
   float scale_factor(Subpatch &sub, int Mu, int Mv);
 
+  /* Dicing in two passes: the triangles stitching a subpatch to its edges use the positions
+   * of the edge verts, which may be set by a neighboring subpatch. */
+  void dice_verts(Subpatch &sub, const int *vert_owner = NULL, int owner = 0);
+  void dice_triangles(Subpatch &sub);
+
   void dice(Subpatch &sub);
 };
 
@@ -25,6 +25,7 @@
 #include "util/util_foreach.h"
 #include "util/util_hash.h"
 #include "util/util_math.h"
+#include "util/util_tbb.h"
 #include "util/util_types.h"
 
 CCL_NAMESPACE_BEGIN
@@ -718,28 +719,63 @@ void DiagSplit::post_split()
   /* Dice; TODO(mai): Move this out of split. */
   QuadDice dice(params);
 
+  foreach (Subpatch &sub, subpatches) {
+    sub.edge_u0.T = max(sub.edge_u0.T, 1);
+    sub.edge_u1.T = max(sub.edge_u1.T, 1);
+    sub.edge_v0.T = max(sub.edge_v0.T, 1);
+    sub.edge_v1.T = max(sub.edge_v1.T, 1);
+  }
+
   int num_verts = num_alloced_verts;
   int num_triangles = 0;
 
+  vector<int> sub_tri_offset(subpatches.size());
+
   for (size_t i = 0; i < subpatches.size(); i++) {
     subpatches[i].inner_grid_vert_offset = num_verts;
+    sub_tri_offset[i] = num_triangles;
     num_verts += subpatches[i].calc_num_inner_verts();
     num_triangles += subpatches[i].calc_num_triangles();
   }
 
   dice.reserve(num_verts, num_triangles);
 
-  for (size_t i = 0; i < subpatches.size(); i++) {
-    Subpatch &sub = subpatches[i];
+  /* Verts on edges are shared with neighboring subpatches. Each is set by the last subpatch
+   * using it, same as when dicing one subpatch after the other, so the result does not depend
+   * on the order in which the subpatches are diced. */
+  vector<int> edge_vert_owner(num_alloced_verts, -1);
 
-    sub.edge_u0.T = max(sub.edge_u0.T, 1);
-    sub.edge_u1.T = max(sub.edge_u1.T, 1);
-    sub.edge_v0.T = max(sub.edge_v0.T, 1);
-    sub.edge_v1.T = max(sub.edge_v1.T, 1);
+  for (size_t i = 0; i < subpatches.size(); i++) {
+    const Subpatch &sub = subpatches[i];
 
-    dice.dice(sub);
+    for (int edge = 0; edge < 4; edge++) {
+      for (int j = 0; j < sub.edges[edge].T; j++) {
+        edge_vert_owner[sub.get_vert_along_edge(edge, j)] = i;
+      }
+    }
   }
 
+  /* Dice in parallel, with grain size to avoid too much threading overhead for small
+   * subpatches. All verts have to be set before stitching. */
+  static const int SUBPATCHES_PER_TASK = 16;
+
+  parallel_for(blocked_range<size_t>(0, subpatches.size(), SUBPATCHES_PER_TASK),
+               [&](const blocked_range<size_t> &r) {
+                 QuadDice task_dice(dice);
+                 for (size_t i = r.begin(); i != r.end(); i++) {
+                   task_dice.dice_verts(subpatches[i], edge_vert_owner.data(), i);
+                 }
+               });
+
+  parallel_for(blocked_range<size_t>(0, subpatches.size(), SUBPATCHES_PER_TASK),
+               [&](const blocked_range<size_t> &r) {
+                 QuadDice task_dice(dice);
+                 for (size_t i = r.begin(); i != r.end(); i++) {
+                   task_dice.tri_offset = dice.tri_offset + sub_tri_offset[i];
+                   task_dice.dice_triangles(subpatches[i]);
+                 }
+               });
+
   /* Cleanup */
   subpatches.clear();
   edges.clear();
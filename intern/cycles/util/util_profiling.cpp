@@ -21,7 +21,8 @@
 
 CCL_NAMESPACE_BEGIN
 
-Profiler::Profiler() : do_stop_worker(true), worker(NULL)
+Profiler::Profiler()
+    : device_active_lanes(0), device_num_lanes(0), do_stop_worker(true), worker(NULL)
 {
 }
 
@@ -87,6 +88,10 @@ void Profiler::reset(int num_shaders, int num_objects)
   shader_samples.assign(num_shaders, 0);
   object_samples.assign(num_objects, 0);
 
+  device_kernels.clear();
+  device_active_lanes = 0;
+  device_num_lanes = 0;
+
   if (running) {
     start();
   }
@@ -149,6 +154,24 @@ void Profiler::remove_state(ProfilingState *state)
   }
 }
 
+void Profiler::add_device_kernel(const string &name, uint64_t work_size, double time)
+{
+  thread_scoped_lock lock(mutex);
+
+  ProfilingDeviceKernel &kernel = device_kernels[name];
+  kernel.launches++;
+  kernel.work_size += work_size;
+  kernel.time += time;
+}
+
+void Profiler::add_device_occupancy(uint64_t active_lanes, uint64_t num_lanes)
+{
+  thread_scoped_lock lock(mutex);
+
+  device_active_lanes += active_lanes;
+  device_num_lanes += num_lanes;
+}
+
 uint64_t Profiler::get_event(ProfilingEvent event)
 {
   assert(worker == NULL);
@@ -177,4 +200,19 @@ bool Profiler::get_object(int object, uint64_t &samples, uint64_t &hits)
   return true;
 }
 
+const map<string, ProfilingDeviceKernel> &Profiler::get_device_kernels()
+{
+  assert(worker == NULL);
+  return device_kernels;
+}
+
+double Profiler::get_device_occupancy()
+{
+  assert(worker == NULL);
+  if (device_num_lanes == 0) {
+    return -1.0;
+  }
+  return (double)device_active_lanes / (double)device_num_lanes;
+}
+
 CCL_NAMESPACE_END
@@ -20,6 +20,7 @@
 #include <atomic>
 
 #include "util/util_map.h"
+#include "util/util_string.h"
 #include "util/util_thread.h"
 #include "util/util_vector.h"
 
@@ -87,6 +88,16 @@ struct ProfilingState {
   vector<uint64_t> object_hits;
 };
 
+/* Statistics of a kernel executed on a GPU, where the worker state can't be sampled.
+ * Measured by the device around the kernel launches. */
+struct ProfilingDeviceKernel {
+  uint64_t launches = 0;
+  /* Number of threads the kernel was launched with. */
+  uint64_t work_size = 0;
+  /* Time in seconds until the kernel finished. */
+  double time = 0.0;
+};
+
 class Profiler {
  public:
   Profiler();
@@ -97,13 +108,29 @@ class Profiler {
   void start();
   void stop();
 
+  /* Devices only measure their kernels while the profiler is running, since it requires
+   * synchronizing after every launch. */
+  bool is_running() const
+  {
+    return worker != NULL;
+  }
+
   void add_state(ProfilingState *state);
   void remove_state(ProfilingState *state);
 
+  /* Thread safe, multiple devices may add to the same kernel. */
+  void add_device_kernel(const string &name, uint64_t work_size, double time);
+  void add_device_occupancy(uint64_t active_lanes, uint64_t num_lanes);
+
   uint64_t get_event(ProfilingEvent event);
   bool get_shader(int shader, uint64_t &samples, uint64_t &hits);
   bool get_object(int object, uint64_t &samples, uint64_t &hits);
 
+  const map<string, ProfilingDeviceKernel> &get_device_kernels();
+  /* Average fraction of the lanes of the split kernel with an active path, or -1 if the
+   * split kernel was not used. */
+  double get_device_occupancy();
+
  protected:
   void run();
 
@@ -121,6 +148,11 @@ class Profiler {
   vector<uint64_t> shader_hits;
   vector<uint64_t> object_hits;
 
+  /* Measured by GPU devices, keyed by kernel name. */
+  map<string, ProfilingDeviceKernel> device_kernels;
+  uint64_t device_active_lanes;
+  uint64_t device_num_lanes;
+
   volatile bool do_stop_worker;
   thread *worker;
 
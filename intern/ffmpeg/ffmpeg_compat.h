@@ -136,6 +136,11 @@ int av_sample_fmt_is_planar(enum AVSampleFormat sample_fmt)
 
 #endif
 
+/* Hardware decoding through device contexts (#avcodec_get_hw_config), FFmpeg 4.0 and newer. */
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(58, 18, 100)
+#  define FFMPEG_HAVE_HW_DECODING
+#endif
+
 /* XXX TODO Probably fix to correct modern flags in code? Not sure how old FFMPEG we want to
  * support though, so for now this will do. */
 
@@ -244,6 +244,25 @@ void MEM_use_lockfree_allocator(void);
  * NOTE: The switch between allocator types can only happen before any allocation did happen. */
 void MEM_use_guarded_allocator(void);
 
+/**
+ * Keep a sample of the allocations of the lock-free allocator along with their names, so live
+ * memory can be grouped by name without the overhead of the guarded allocator. Blocks allocated
+ * before this is called are not included. Has no effect with the guarded allocator.
+ */
+void MEM_use_sampled_stats(void);
+
+/**
+ * Call \a func for every block name with sampled live memory. Memory usage and block counts are
+ * estimates extrapolated from the sampled blocks.
+ *
+ * \return false when #MEM_use_sampled_stats has not been called.
+ */
+bool MEM_sampled_stats_foreach(void (*func)(const char *name,
+                                            size_t mem_in_use,
+                                            size_t blocks_num,
+                                            void *user_data),
+                               void *user_data);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -75,6 +75,8 @@ void MEM_init_memleak_detection(void)
    * construction. Therefore, all static variables that own memory have to be constructed after
    * this function has been called.
    */
+  /* Calling this first makes sure the memory usage counters are set up by the main thread. */
+  memory_usage_init();
   static MemLeakPrinter printer;
 }
 
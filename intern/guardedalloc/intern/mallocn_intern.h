@@ -112,6 +112,23 @@ void aligned_free(void *ptr);
 extern bool leak_detector_has_run;
 extern char free_after_leak_detection_message[];
 
+/* Memory usage counters of the lock-free allocator, see memory_usage.cc */
+void memory_usage_init(void);
+void memory_usage_block_alloc(size_t size);
+void memory_usage_block_free(size_t size);
+void memory_usage_block_resize(size_t old_size, size_t new_size);
+size_t memory_usage_block_num(void);
+size_t memory_usage_current(void);
+size_t memory_usage_peak(void);
+void memory_usage_peak_reset(void);
+
+/* Sampled statistics of the lock-free allocator, see memory_sampling.cc */
+extern bool memory_sampling_enabled;
+bool memory_sampling_block_alloc(const void *ptr, size_t len, const char *name);
+void memory_sampling_block_track(const void *ptr, size_t len, const char *name);
+const char *memory_sampling_block_free(const void *ptr);
+void memory_sampling_print_stats(void);
+
 /* Prototypes for counted allocator functions */
 size_t MEM_lockfree_allocN_len(const void *vmemh) ATTR_WARN_UNUSED_RESULT;
 void MEM_lockfree_freeN(void *vmemh);
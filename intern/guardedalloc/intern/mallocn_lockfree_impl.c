@@ -20,6 +20,7 @@
  * Memory allocation which keeps track on allocated memory counters
  */
 
+#include <assert.h>
 #include <stdarg.h>
 #include <stdlib.h>
 #include <string.h> /* memcpy */
@@ -30,7 +31,6 @@
 /* to ensure strict conversions */
 #include "../../source/blender/blenlib/BLI_strict_flags.h"
 
-#include "atomic_ops.h"
 #include "mallocn_intern.h"
 
 typedef struct MemHead {
@@ -43,31 +43,29 @@ typedef struct MemHeadAligned {
   size_t len;
 } MemHeadAligned;
 
-static unsigned int totblock = 0;
-static size_t mem_in_use = 0, peak_mem = 0;
 static bool malloc_debug_memset = false;
 
 static void (*error_callback)(const char *) = NULL;
 
 enum {
   MEMHEAD_ALIGN_FLAG = 1,
+  /** The block is in the table of sampled blocks, see #MEM_use_sampled_stats. */
+  MEMHEAD_SAMPLED_FLAG = 2,
 };
 
 #define MEMHEAD_FROM_PTR(ptr) (((MemHead *)ptr) - 1)
 #define PTR_FROM_MEMHEAD(memhead) (memhead + 1)
 #define MEMHEAD_ALIGNED_FROM_PTR(ptr) (((MemHeadAligned *)ptr) - 1)
 #define MEMHEAD_IS_ALIGNED(memhead) ((memhead)->len & (size_t)MEMHEAD_ALIGN_FLAG)
+#define MEMHEAD_IS_SAMPLED(memhead) ((memhead)->len & (size_t)MEMHEAD_SAMPLED_FLAG)
 
-/* Uncomment this to have proper peak counter. */
-#define USE_ATOMIC_MAX
-
-MEM_INLINE void update_maximum(size_t *maximum_value, size_t value)
+/* Returns the flag to add to the length of a new block. */
+MEM_INLINE size_t memhead_sample_flag(const void *ptr, size_t len, const char *str)
 {
-#ifdef USE_ATOMIC_MAX
-  atomic_fetch_and_update_max_z(maximum_value, value);
-#else
-  *maximum_value = value > *maximum_value ? value : *maximum_value;
-#endif
+  if (UNLIKELY(memory_sampling_enabled) && memory_sampling_block_alloc(ptr, len, str)) {
+    return (size_t)MEMHEAD_SAMPLED_FLAG;
+  }
+  return 0;
 }
 
 #ifdef __GNUC__
@@ -92,7 +90,8 @@ print_error(const char *str, ...)
 size_t MEM_lockfree_allocN_len(const void *vmemh)
 {
   if (vmemh) {
-    return MEMHEAD_FROM_PTR(vmemh)->len & ~((size_t)(MEMHEAD_ALIGN_FLAG));
+    return MEMHEAD_FROM_PTR(vmemh)->len &
+           ~((size_t)(MEMHEAD_ALIGN_FLAG | MEMHEAD_SAMPLED_FLAG));
   }
 
   return 0;
@@ -115,8 +114,10 @@ void MEM_lockfree_freeN(void *vmemh)
     return;
   }
 
-  atomic_sub_and_fetch_u(&totblock, 1);
-  atomic_sub_and_fetch_z(&mem_in_use, len);
+  memory_usage_block_free(len);
+  if (UNLIKELY(MEMHEAD_IS_SAMPLED(memh))) {
+    memory_sampling_block_free(vmemh);
+  }
 
   if (UNLIKELY(malloc_debug_memset && len)) {
     memset(memh + 1, 255, len);
@@ -158,13 +159,38 @@ void *MEM_lockfree_reallocN_id(void *vmemh, size_t len, const char *str)
     size_t old_len = MEM_lockfree_allocN_len(vmemh);
 
     if (LIKELY(!MEMHEAD_IS_ALIGNED(memh))) {
-      newp = MEM_lockfree_mallocN(len, "realloc");
-    }
-    else {
-      MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
-      newp = MEM_lockfree_mallocN_aligned(len, (size_t)memh_aligned->alignment, "realloc");
+      /* Let the system allocator grow or shrink the block in place when possible. This avoids
+       * the copy and having both blocks allocated at the same time. */
+      len = SIZET_ALIGN_4(len);
+      /* Remove the sample before the address can be reused by another thread. */
+      const char *sample_name = NULL;
+      if (UNLIKELY(MEMHEAD_IS_SAMPLED(memh))) {
+        sample_name = memory_sampling_block_free(vmemh);
+      }
+      MemHead *new_memh = (MemHead *)realloc(memh, len + sizeof(MemHead));
+      if (UNLIKELY(new_memh == NULL)) {
+        print_error("Realloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
+                    SIZET_ARG(len),
+                    str,
+                    (unsigned int)memory_usage_current());
+        return NULL;
+      }
+      if (UNLIKELY(malloc_debug_memset && len > old_len)) {
+        memset((char *)(new_memh + 1) + old_len, 255, len - old_len);
+      }
+      new_memh->len = len;
+      memory_usage_block_resize(old_len, len);
+      if (UNLIKELY(sample_name != NULL)) {
+        /* Keep the name of the original allocation. */
+        memory_sampling_block_track(PTR_FROM_MEMHEAD(new_memh), len, sample_name);
+        new_memh->len |= (size_t)MEMHEAD_SAMPLED_FLAG;
+      }
+      return PTR_FROM_MEMHEAD(new_memh);
     }
 
+    MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
+    newp = MEM_lockfree_mallocN_aligned(len, (size_t)memh_aligned->alignment, "realloc");
+
     if (newp) {
       if (len < old_len) {
         /* shrink */
@@ -235,17 +261,15 @@ void *MEM_lockfree_callocN(size_t len, const char *str)
   memh = (MemHead *)calloc(1, len + sizeof(MemHead));
 
   if (LIKELY(memh)) {
-    memh->len = len;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    memh->len = len | memhead_sample_flag(PTR_FROM_MEMHEAD(memh), len, str);
+    memory_usage_block_alloc(len);
 
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Calloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
               SIZET_ARG(len),
               str,
-              (unsigned int)mem_in_use);
+              (unsigned int)memory_usage_current());
   return NULL;
 }
 
@@ -259,7 +283,7 @@ void *MEM_lockfree_calloc_arrayN(size_t len, size_t size, const char *str)
         SIZET_ARG(len),
         SIZET_ARG(size),
         str,
-        (unsigned int)mem_in_use);
+        (unsigned int)memory_usage_current());
     abort();
     return NULL;
   }
@@ -280,17 +304,15 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
       memset(memh + 1, 255, len);
     }
 
-    memh->len = len;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    memh->len = len | memhead_sample_flag(PTR_FROM_MEMHEAD(memh), len, str);
+    memory_usage_block_alloc(len);
 
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Malloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
               SIZET_ARG(len),
               str,
-              (unsigned int)mem_in_use);
+              (unsigned int)memory_usage_current());
   return NULL;
 }
 
@@ -304,7 +326,7 @@ void *MEM_lockfree_malloc_arrayN(size_t len, size_t size, const char *str)
         SIZET_ARG(len),
         SIZET_ARG(size),
         str,
-        (unsigned int)mem_in_use);
+        (unsigned int)memory_usage_current());
     abort();
     return NULL;
   }
@@ -350,18 +372,17 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
       memset(memh + 1, 255, len);
     }
 
-    memh->len = len | (size_t)MEMHEAD_ALIGN_FLAG;
+    memh->len = len | (size_t)MEMHEAD_ALIGN_FLAG |
+                memhead_sample_flag(PTR_FROM_MEMHEAD(memh), len, str);
     memh->alignment = (short)alignment;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    memory_usage_block_alloc(len);
 
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Malloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
               SIZET_ARG(len),
               str,
-              (unsigned int)mem_in_use);
+              (unsigned int)memory_usage_current());
   return NULL;
 }
 
@@ -381,8 +402,10 @@ void MEM_lockfree_callbackmemlist(void (*func)(void *))
 
 void MEM_lockfree_printmemlist_stats(void)
 {
-  printf("\ntotal memory len: %.3f MB\n", (double)mem_in_use / (double)(1024 * 1024));
-  printf("peak memory len: %.3f MB\n", (double)peak_mem / (double)(1024 * 1024));
+  printf("\ntotal memory len: %.3f MB\n",
+         (double)memory_usage_current() / (double)(1024 * 1024));
+  printf("peak memory len: %.3f MB\n", (double)memory_usage_peak() / (double)(1024 * 1024));
+  memory_sampling_print_stats();
   printf(
       "\nFor more detailed per-block statistics run Blender with memory debugging command line "
       "argument.\n");
@@ -410,23 +433,23 @@ void MEM_lockfree_set_memory_debug(void)
 
 size_t MEM_lockfree_get_memory_in_use(void)
 {
-  return mem_in_use;
+  return memory_usage_current();
 }
 
 unsigned int MEM_lockfree_get_memory_blocks_in_use(void)
 {
-  return totblock;
+  return (unsigned int)memory_usage_block_num();
 }
 
 /* dummy */
 void MEM_lockfree_reset_peak_memory(void)
 {
-  peak_mem = mem_in_use;
+  memory_usage_peak_reset();
 }
 
 size_t MEM_lockfree_get_peak_memory(void)
 {
-  return peak_mem;
+  return memory_usage_peak();
 }
 
 #ifndef NDEBUG
@@ -0,0 +1,195 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup MEM
+ *
+ * Sampled memory statistics of the lock-free allocator.
+ *
+ * Unlike the guarded allocator, the lock-free allocator does not store the name of blocks. To
+ * still be able to tell what the memory is used for, a sample of the allocations is kept in a
+ * table together with their name. Each thread samples the allocation which makes the number of
+ * bytes it allocated cross the next multiple of #sample_interval, so all blocks larger than the
+ * interval are sampled and smaller blocks are sampled in proportion to their size. Every sample
+ * stands for #sample_interval bytes, or its own size when larger.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "MEM_guardedalloc.h"
+#include "mallocn_intern.h"
+
+bool memory_sampling_enabled = false;
+
+namespace {
+
+constexpr size_t sample_interval = 256 * 1024;
+
+struct Sample {
+  const char *name;
+  size_t len;
+  /** Estimated number of bytes this sample stands for. */
+  size_t weight;
+};
+
+struct Samples {
+  std::mutex mutex;
+  std::unordered_map<const void *, Sample> map;
+};
+
+/** Never destructed, blocks may still be freed from destructors of static variables. */
+Samples &get_samples()
+{
+  alignas(Samples) static char samples_buffer[sizeof(Samples)];
+  static Samples *samples = new (samples_buffer) Samples();
+  return *samples;
+}
+
+/** Bytes the current thread can allocate before the next sample is taken. */
+thread_local size_t bytes_until_sample = sample_interval;
+
+/**
+ * Set while the current thread is changing the sample table. The table may allocate memory with
+ * the guarded allocator when it overrides the C++ allocation operators, those allocations are
+ * not sampled to avoid recursion.
+ */
+thread_local bool is_sampling = false;
+
+}  // namespace
+
+void memory_sampling_block_track(const void *ptr, size_t len, const char *name)
+{
+  if (is_sampling) {
+    return;
+  }
+  is_sampling = true;
+  {
+    Samples &samples = get_samples();
+    std::lock_guard<std::mutex> lock{samples.mutex};
+    samples.map[ptr] = Sample{name, len, std::max(len, sample_interval)};
+  }
+  is_sampling = false;
+}
+
+bool memory_sampling_block_alloc(const void *ptr, size_t len, const char *name)
+{
+  if (is_sampling) {
+    return false;
+  }
+  if (len < bytes_until_sample) {
+    bytes_until_sample -= len;
+    return false;
+  }
+  bytes_until_sample = sample_interval;
+  memory_sampling_block_track(ptr, len, name);
+  return true;
+}
+
+const char *memory_sampling_block_free(const void *ptr)
+{
+  const char *name = nullptr;
+  is_sampling = true;
+  {
+    Samples &samples = get_samples();
+    std::lock_guard<std::mutex> lock{samples.mutex};
+    auto it = samples.map.find(ptr);
+    if (it != samples.map.end()) {
+      name = it->second.name;
+      samples.map.erase(it);
+    }
+  }
+  is_sampling = false;
+  return name;
+}
+
+void MEM_use_sampled_stats(void)
+{
+  memory_sampling_enabled = true;
+}
+
+bool MEM_sampled_stats_foreach(void (*func)(const char *name,
+                                            size_t mem_in_use,
+                                            size_t blocks_num,
+                                            void *user_data),
+                               void *user_data)
+{
+  if (!memory_sampling_enabled) {
+    return false;
+  }
+
+  struct NameStats {
+    size_t mem_in_use = 0;
+    double blocks_num = 0.0;
+  };
+
+  /* Blocks with the same name may use different string pointers, group them by the content. */
+  std::unordered_map<std::string, NameStats> stats;
+  is_sampling = true;
+  {
+    Samples &samples = get_samples();
+    std::lock_guard<std::mutex> lock{samples.mutex};
+    for (const auto &item : samples.map) {
+      const Sample &sample = item.second;
+      NameStats &name_stats = stats[sample.name];
+      name_stats.mem_in_use += sample.weight;
+      name_stats.blocks_num += (double)sample.weight / (double)std::max<size_t>(sample.len, 1);
+    }
+  }
+  is_sampling = false;
+
+  for (const auto &item : stats) {
+    func(item.first.c_str(), item.second.mem_in_use, (size_t)item.second.blocks_num, user_data);
+  }
+  return true;
+}
+
+void memory_sampling_print_stats(void)
+{
+  struct Item {
+    std::string name;
+    size_t mem_in_use;
+    size_t blocks_num;
+  };
+  std::vector<Item> items;
+  const bool enabled = MEM_sampled_stats_foreach(
+      [](const char *name, size_t mem_in_use, size_t blocks_num, void *user_data) {
+        static_cast<std::vector<Item> *>(user_data)->push_back({name, mem_in_use, blocks_num});
+      },
+      &items);
+  if (!enabled) {
+    return;
+  }
+
+  std::sort(items.begin(), items.end(), [](const Item &a, const Item &b) {
+    return a.mem_in_use > b.mem_in_use;
+  });
+
+  printf("\nestimated memory by name (sampled):\n");
+  printf(" ITEMS   TOTAL-MiB  BLOCK NAME\n");
+  for (const Item &item : items) {
+    printf("%6zu (%8.3f)  %s\n",
+           item.blocks_num,
+           (double)item.mem_in_use / (double)(1024 * 1024),
+           item.name.c_str());
+  }
+}
@@ -0,0 +1,247 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup MEM
+ *
+ * Memory usage counters of the lock-free allocator.
+ *
+ * Every thread counts its own allocations, so that allocating from many threads at the same
+ * time does not make them fight over the cache line of a single global counter. The per-thread
+ * values are only summed up when the totals are queried, which happens rarely.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+#include "MEM_guardedalloc.h"
+#include "mallocn_intern.h"
+
+namespace {
+
+/**
+ * Memory usage counters of a single thread. Only the owning thread changes the values, other
+ * threads only read them when computing the totals.
+ */
+struct Local {
+  /** Threads are kept in a linked list, which unlike a vector does not allocate memory. */
+  Local *prev = nullptr;
+  Local *next = nullptr;
+  /** True when the thread is exiting, any remaining (de)allocations go to the global counters. */
+  bool destructed = false;
+  /** True for the thread which initialized the counters. */
+  bool belongs_to_main_thread = false;
+  /** Signed, because memory may be freed by a different thread than the one allocating it. */
+  std::atomic<int64_t> blocks_num = 0;
+  std::atomic<int64_t> mem_in_use = 0;
+  /** Value of #mem_in_use when the peak memory was last updated by this thread. */
+  int64_t mem_in_use_during_peak_update = 0;
+
+  Local();
+  ~Local();
+};
+
+struct Global {
+  /** Protects the list of #Local counters. */
+  std::mutex locals_mutex;
+  Local *locals_first = nullptr;
+  /** Counters for threads which have exited and for (de)allocations during thread exit. */
+  std::atomic<int64_t> blocks_num_outside_locals = 0;
+  std::atomic<int64_t> mem_in_use_outside_locals = 0;
+  /** Approximate peak memory usage, see #peak_update_threshold. */
+  std::atomic<size_t> peak = 0;
+};
+
+/**
+ * The peak memory is only updated when the memory usage of a thread changed by more than this
+ * amount, so it can be lower than the real peak by up to this amount per thread.
+ */
+constexpr int64_t peak_update_threshold = 1024 * 1024;
+
+/** Set to false once the main thread exits, all counting happens on the global counters then. */
+std::atomic<bool> use_local_counters = true;
+
+/**
+ * The global counters are never destructed, because memory may still be freed from destructors
+ * of other static variables, including the leak detector which queries the totals.
+ */
+Global &get_global()
+{
+  alignas(Global) static char global_buffer[sizeof(Global)];
+  static Global *global = new (global_buffer) Global();
+  return *global;
+}
+
+Local &get_local_data()
+{
+  static thread_local Local local;
+  return local;
+}
+
+Local::Local()
+{
+  Global &global = get_global();
+  std::lock_guard<std::mutex> lock{global.locals_mutex};
+
+  if (global.locals_first == nullptr) {
+    /* The first thread using the allocator is the main thread, see #memory_usage_init. */
+    this->belongs_to_main_thread = true;
+  }
+  else {
+    global.locals_first->prev = this;
+  }
+  this->next = global.locals_first;
+  global.locals_first = this;
+}
+
+Local::~Local()
+{
+  Global &global = get_global();
+  std::lock_guard<std::mutex> lock{global.locals_mutex};
+
+  if (this->prev != nullptr) {
+    this->prev->next = this->next;
+  }
+  else {
+    global.locals_first = this->next;
+  }
+  if (this->next != nullptr) {
+    this->next->prev = this->prev;
+  }
+
+  /* Move the counts of the exiting thread to the global counters. */
+  global.blocks_num_outside_locals.fetch_add(this->blocks_num, std::memory_order_relaxed);
+  global.mem_in_use_outside_locals.fetch_add(this->mem_in_use, std::memory_order_relaxed);
+
+  if (this->belongs_to_main_thread) {
+    /* Other threads may still exist but the program is exiting, their counters may be
+     * destructed in any order from here on. */
+    use_local_counters.store(false, std::memory_order_relaxed);
+  }
+  this->destructed = true;
+}
+
+/** Sum of the memory usage of all threads. Expects the list mutex to be locked. */
+int64_t mem_in_use_sum(Global &global)
+{
+  int64_t mem_in_use = global.mem_in_use_outside_locals;
+  for (Local *local = global.locals_first; local; local = local->next) {
+    mem_in_use += local->mem_in_use;
+  }
+  return mem_in_use;
+}
+
+void update_global_peak()
+{
+  Global &global = get_global();
+  std::lock_guard<std::mutex> lock{global.locals_mutex};
+
+  const size_t mem_in_use = (size_t)std::max<int64_t>(mem_in_use_sum(global), 0);
+  size_t peak = global.peak.load(std::memory_order_relaxed);
+  while (mem_in_use > peak && !global.peak.compare_exchange_weak(peak, mem_in_use)) {
+    /* Pass. */
+  }
+}
+
+void memory_usage_block_add(const int64_t blocks_num, const int64_t size)
+{
+  if (LIKELY(use_local_counters.load(std::memory_order_relaxed))) {
+    Local &local = get_local_data();
+    if (LIKELY(!local.destructed)) {
+      /* Only this thread writes the values, so there is no need for an atomic read-modify-write
+       * operation which would need exclusive access to the cache line. */
+      local.blocks_num.store(local.blocks_num.load(std::memory_order_relaxed) + blocks_num,
+                             std::memory_order_relaxed);
+      const int64_t mem_in_use = local.mem_in_use.load(std::memory_order_relaxed) + size;
+      local.mem_in_use.store(mem_in_use, std::memory_order_relaxed);
+
+      if (UNLIKELY(mem_in_use - local.mem_in_use_during_peak_update > peak_update_threshold)) {
+        local.mem_in_use_during_peak_update = mem_in_use;
+        update_global_peak();
+      }
+      else if (UNLIKELY(local.mem_in_use_during_peak_update - mem_in_use >
+                        peak_update_threshold)) {
+        /* Avoid updating the peak for every allocation after a large block has been freed. */
+        local.mem_in_use_during_peak_update = mem_in_use;
+      }
+      return;
+    }
+  }
+
+  Global &global = get_global();
+  global.blocks_num_outside_locals.fetch_add(blocks_num, std::memory_order_relaxed);
+  global.mem_in_use_outside_locals.fetch_add(size, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+void memory_usage_init(void)
+{
+  /* Makes sure the main thread is the first to register its counters. */
+  get_local_data();
+}
+
+void memory_usage_block_alloc(size_t size)
+{
+  memory_usage_block_add(1, (int64_t)size);
+}
+
+void memory_usage_block_free(size_t size)
+{
+  memory_usage_block_add(-1, -(int64_t)size);
+}
+
+void memory_usage_block_resize(size_t old_size, size_t new_size)
+{
+  memory_usage_block_add(0, (int64_t)new_size - (int64_t)old_size);
+}
+
+size_t memory_usage_block_num(void)
+{
+  Global &global = get_global();
+  std::lock_guard<std::mutex> lock{global.locals_mutex};
+
+  int64_t blocks_num = global.blocks_num_outside_locals;
+  for (Local *local = global.locals_first; local; local = local->next) {
+    blocks_num += local->blocks_num;
+  }
+  return (size_t)std::max<int64_t>(blocks_num, 0);
+}
+
+size_t memory_usage_current(void)
+{
+  Global &global = get_global();
+  std::lock_guard<std::mutex> lock{global.locals_mutex};
+
+  return (size_t)std::max<int64_t>(mem_in_use_sum(global), 0);
+}
+
+size_t memory_usage_peak(void)
+{
+  update_global_peak();
+  return get_global().peak;
+}
+
+void memory_usage_peak_reset(void)
+{
+  Global &global = get_global();
+  std::lock_guard<std::mutex> lock{global.locals_mutex};
+
+  global.peak = (size_t)std::max<int64_t>(mem_in_use_sum(global), 0);
+}
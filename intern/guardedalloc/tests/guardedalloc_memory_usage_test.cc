@@ -0,0 +1,42 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <thread>
+#include <vector>
+
+#include "MEM_guardedalloc.h"
+
+#include "guardedalloc_test_base.h"
+
+TEST_F(LockFreeAllocatorTest, MemoryUsageMultipleThreads)
+{
+  const unsigned int blocks_num_start = MEM_get_memory_blocks_in_use();
+  const size_t mem_in_use_start = MEM_get_memory_in_use();
+
+  const int threads_num = 4;
+  std::vector<void *> blocks(threads_num);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < threads_num; i++) {
+    threads.emplace_back([&blocks, i]() {
+      for (int j = 0; j < 1000; j++) {
+        MEM_freeN(MEM_mallocN(64, __func__));
+      }
+      blocks[i] = MEM_mallocN(1024, __func__);
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  /* Counts of exited threads are kept. */
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_num_start + threads_num);
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_in_use_start + threads_num * 1024);
+
+  /* Free blocks from another thread than the one that allocated them. */
+  for (void *block : blocks) {
+    MEM_freeN(block);
+  }
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_num_start);
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_in_use_start);
+}
@@ -1128,6 +1128,7 @@ static tbool GenerateTSpaces(STSpace psTspace[],
   STSpace *pSubGroupTspace = NULL;
   SSubGroup *pUniSubGroups = NULL;
   int *pTmpMembers = NULL;
+  SVec3 *pProjOs = NULL, *pProjOt = NULL;
   int iMaxNrFaces = 0, iUniqueTspaces = 0, g = 0, i = 0;
   for (g = 0; g < iNrActiveGroups; g++)
     if (iMaxNrFaces < pGroups[g].iNrFaces)
@@ -1140,13 +1141,20 @@ static tbool GenerateTSpaces(STSpace psTspace[],
   pSubGroupTspace = (STSpace *)malloc(sizeof(STSpace) * iMaxNrFaces);
   pUniSubGroups = (SSubGroup *)malloc(sizeof(SSubGroup) * iMaxNrFaces);
   pTmpMembers = (int *)malloc(sizeof(int) * iMaxNrFaces);
-  if (pSubGroupTspace == NULL || pUniSubGroups == NULL || pTmpMembers == NULL) {
+  pProjOs = (SVec3 *)malloc(sizeof(SVec3) * iMaxNrFaces);
+  pProjOt = (SVec3 *)malloc(sizeof(SVec3) * iMaxNrFaces);
+  if (pSubGroupTspace == NULL || pUniSubGroups == NULL || pTmpMembers == NULL ||
+      pProjOs == NULL || pProjOt == NULL) {
     if (pSubGroupTspace != NULL)
       free(pSubGroupTspace);
     if (pUniSubGroups != NULL)
       free(pUniSubGroups);
     if (pTmpMembers != NULL)
       free(pTmpMembers);
+    if (pProjOs != NULL)
+      free(pProjOs);
+    if (pProjOt != NULL)
+      free(pProjOt);
     return TFALSE;
   }
 
@@ -1154,6 +1162,21 @@ static tbool GenerateTSpaces(STSpace psTspace[],
   for (g = 0; g < iNrActiveGroups; g++) {
     const SGroup *pGroup = &pGroups[g];
     int iUniqueSubGroups = 0, s = 0;
+    SVec3 n;
+
+    if (pGroup->iNrFaces == 0)
+      continue;
+
+    // all triangles of the group share the representative vertex and its normal,
+    // which is normalized already
+    n = GetNormal(pContext, pGroup->iVertexRepresentitive);
+
+    // project the tangent and bitangent of every triangle only once, not once per pair
+    for (i = 0; i < pGroup->iNrFaces; i++) {
+      const int t = pGroup->pFaceIndices[i];  // triangle number
+      pProjOs[i] = NormalizeSafe(vsub(pTriInfos[t].vOs, vscale(vdot(n, pTriInfos[t].vOs), n)));
+      pProjOt[i] = NormalizeSafe(vsub(pTriInfos[t].vOt, vscale(vdot(n, pTriInfos[t].vOt), n)));
+    }
 
     for (i = 0; i < pGroup->iNrFaces; i++)  // triangles
     {
@@ -1161,7 +1184,7 @@ static tbool GenerateTSpaces(STSpace psTspace[],
       int index = -1, iVertIndex = -1, iOF_1 = -1, iMembers = 0, j = 0, l = 0;
       SSubGroup tmp_group;
       tbool bFound;
-      SVec3 n, vOs, vOt;
+      SVec3 vOs, vOt;
       if (pTriInfos[f].AssignedGroup[0] == pGroup)
         index = 0;
       else if (pTriInfos[f].AssignedGroup[1] == pGroup)
@@ -1172,13 +1195,10 @@ static tbool GenerateTSpaces(STSpace psTspace[],
 
       iVertIndex = piTriListIn[f * 3 + index];
       assert(iVertIndex == pGroup->iVertexRepresentitive);
+      (void)iVertIndex;
 
-      // is normalized already
-      n = GetNormal(pContext, iVertIndex);
-
-      // project
-      vOs = NormalizeSafe(vsub(pTriInfos[f].vOs, vscale(vdot(n, pTriInfos[f].vOs), n)));
-      vOt = NormalizeSafe(vsub(pTriInfos[f].vOt, vscale(vdot(n, pTriInfos[f].vOt), n)));
+      vOs = pProjOs[i];
+      vOt = pProjOt[i];
 
       // original face number
       iOF_1 = pTriInfos[f].iOrgFaceNumber;
@@ -1188,9 +1208,8 @@ static tbool GenerateTSpaces(STSpace psTspace[],
         const int t = pGroup->pFaceIndices[j];  // triangle number
         const int iOF_2 = pTriInfos[t].iOrgFaceNumber;
 
-        // project
-        SVec3 vOs2 = NormalizeSafe(vsub(pTriInfos[t].vOs, vscale(vdot(n, pTriInfos[t].vOs), n)));
-        SVec3 vOt2 = NormalizeSafe(vsub(pTriInfos[t].vOt, vscale(vdot(n, pTriInfos[t].vOt), n)));
+        const SVec3 vOs2 = pProjOs[j];
+        const SVec3 vOt2 = pProjOt[j];
 
         {
           const tbool bAny = ((pTriInfos[f].iFlag | pTriInfos[t].iFlag) & GROUP_WITH_ANY) != 0 ?
@@ -1241,6 +1260,8 @@ static tbool GenerateTSpaces(STSpace psTspace[],
           free(pUniSubGroups);
           free(pTmpMembers);
           free(pSubGroupTspace);
+          free(pProjOs);
+          free(pProjOt);
           return TFALSE;
         }
         pUniSubGroups[iUniqueSubGroups].iNrFaces = iMembers;
@@ -1286,6 +1307,8 @@ static tbool GenerateTSpaces(STSpace psTspace[],
   free(pUniSubGroups);
   free(pTmpMembers);
   free(pSubGroupTspace);
+  free(pProjOs);
+  free(pProjOt);
 
   return TTRUE;
 }
@@ -252,6 +252,9 @@ class NODE_MT_view(Menu):
         # Auto-offset nodes (called "insert_offset" in code)
         layout.prop(snode, "use_insert_offset")
 
+        if snode.tree_type in {'CompositorNodeTree', 'GeometryNodeTree'}:
+            layout.prop(snode, "show_execution_stats")
+
         layout.separator()
 
         sub = layout.column()
@@ -656,13 +659,19 @@ class NODE_PT_quality(bpy.types.Panel):
         snode = context.space_data
         tree = snode.node_tree
 
+        col = layout.column()
+        col.prop(tree, "execution_mode")
+
         col = layout.column()
         col.prop(tree, "render_quality", text="Render")
         col.prop(tree, "edit_quality", text="Edit")
         col.prop(tree, "chunk_size")
 
         col = layout.column()
+        col.prop(tree, "use_gpu")
         col.prop(tree, "use_opencl")
+        col.prop(tree, "use_half_float")
+        col.prop(tree, "use_parallel_frames")
         col.prop(tree, "use_groupnode_buffer")
         col.prop(tree, "use_two_pass")
         col.prop(tree, "use_viewer_border")
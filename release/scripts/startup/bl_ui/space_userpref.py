@@ -625,6 +625,11 @@ class USERPREF_PT_system_memory(SystemPanel, CenterAlignMixIn, Panel):
 
         layout.separator()
 
+        col = layout.column()
+        col.prop(system, "compositor_cache_limit", text="Compositor Cache Limit")
+
+        layout.separator()
+
         col = layout.column()
         col.prop(system, "texture_time_out", text="Texture Time Out")
         col.prop(system, "texture_collection_rate", text="Garbage Collection Rate")
@@ -634,6 +639,7 @@ class USERPREF_PT_system_memory(SystemPanel, CenterAlignMixIn, Panel):
         col = layout.column()
         col.prop(system, "vbo_time_out", text="Vbo Time Out")
         col.prop(system, "vbo_collection_rate", text="Garbage Collection Rate")
+        col.prop(system, "vbo_memory_limit", text="Memory Limit")
 
 
 class USERPREF_PT_system_video_sequencer(SystemPanel, CenterAlignMixIn, Panel):
@@ -645,6 +651,7 @@ class USERPREF_PT_system_video_sequencer(SystemPanel, CenterAlignMixIn, Panel):
         edit = prefs.edit
 
         layout.prop(system, "memory_cache_limit")
+        layout.prop(system, "use_hardware_movie_decoding")
 
         layout.separator()
 
@@ -2252,6 +2259,7 @@ class USERPREF_PT_experimental_prototypes(ExperimentalPanel, Panel):
             context, (
                 ({"property": "use_new_hair_type"}, "T68981"),
                 ({"property": "use_new_point_cloud_type"}, "T75717"),
+                ({"property": "use_undo_skip_unchanged"}, None),
             ),
         )
 
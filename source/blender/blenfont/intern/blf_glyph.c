@@ -497,7 +497,9 @@ void blf_glyph_render(FontBLF *font, GlyphCacheBLF *gc, GlyphBLF *g, float x, fl
 
     if (bitmap_len > gc->bitmap_len_alloc) {
       int w = font->tex_size_max;
-      int h = bitmap_len / w + 1;
+      /* Grow geometrically, recreating the texture means uploading all glyphs again. */
+      const int h_grow = min_ii(2 * (gc->bitmap_len_alloc / w), GPU_max_texture_layers());
+      int h = max_ii(bitmap_len / w + 1, h_grow);
 
       gc->bitmap_len_alloc = w * h;
       gc->bitmap_result = MEM_reallocN(gc->bitmap_result, (size_t)gc->bitmap_len_alloc);
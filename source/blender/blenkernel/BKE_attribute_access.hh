@@ -34,6 +34,8 @@ using fn::CPPType;
 const CPPType *custom_data_type_to_cpp_type(const CustomDataType type);
 CustomDataType cpp_type_to_custom_data_type(const CPPType &type);
 
+void free_unused_temporary_attribute_buffers();
+
 /**
  * This class offers an indirection for reading an attribute.
  * This is useful for the following reasons:
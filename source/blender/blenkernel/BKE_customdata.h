@@ -265,6 +265,15 @@ void CustomData_bmesh_copy_data_exclude_by_type(const struct CustomData *source,
                                                 void **dest_block,
                                                 const CustomDataMask mask_exclude);
 
+typedef struct CustomDataBMeshCopyMap CustomDataBMeshCopyMap;
+CustomDataBMeshCopyMap *CustomData_bmesh_copy_map_new(const struct CustomData *source,
+                                                      const struct CustomData *dest,
+                                                      const CustomDataMask mask_exclude);
+void CustomData_bmesh_copy_map_free(CustomDataBMeshCopyMap *map);
+void CustomData_bmesh_copy_block_with_map(const CustomDataBMeshCopyMap *map,
+                                          const void *src_block,
+                                          void *dst_block);
+
 /* Copies data of a single layer of a given type. */
 void CustomData_copy_layer_type_data(const struct CustomData *source,
                                      struct CustomData *destination,
@@ -396,6 +405,7 @@ void CustomData_set_layer_flag(struct CustomData *data, int type, int flag);
 void CustomData_clear_layer_flag(struct CustomData *data, int type, int flag);
 
 void CustomData_bmesh_set_default(struct CustomData *data, void **block);
+void CustomData_bmesh_alloc_block(struct CustomData *data, void **block);
 void CustomData_bmesh_free_block(struct CustomData *data, void **block);
 void CustomData_bmesh_free_block_data(struct CustomData *data, void *block);
 void CustomData_bmesh_free_block_data_exclude_by_type(struct CustomData *data,
@@ -49,6 +49,9 @@ int BKE_geometry_set_instances(const struct GeometrySet *geometry_set,
                                float (**r_transforms)[4][4],
                                int **r_ids,
                                struct InstancedData **r_instanced_data);
+void BKE_geometry_set_instances_world_transforms(const struct GeometrySet *geometry_set,
+                                                 const float object_transform[4][4],
+                                                 float (*r_transforms)[4][4]);
 
 #ifdef __cplusplus
 }
@@ -22,6 +22,7 @@
 
 #include <atomic>
 #include <iostream>
+#include <memory>
 
 #include "BLI_float3.hh"
 #include "BLI_float4x4.hh"
@@ -95,6 +96,9 @@ class OutputAttributePtr {
                      std::string name,
                      CustomDataType data_type);
 
+  OutputAttributePtr(OutputAttributePtr &&other) = default;
+  OutputAttributePtr &operator=(OutputAttributePtr &&other) = default;
+
   ~OutputAttributePtr();
 
   /* Returns false, when this wrapper is empty. */
@@ -188,6 +192,13 @@ class GeometryComponent {
   virtual blender::Set<std::string> attribute_names() const;
   virtual bool is_empty() const;
 
+  /* Returns false when the component references data that is owned by someone else, e.g. the
+   * mesh passed to a modifier. */
+  virtual bool owns_direct_data() const;
+  /* Copy referenced data that is not owned by the component, so that it can outlive the data.
+   * This can only be used when the component is mutable. */
+  virtual void ensure_owns_direct_data();
+
   /* Get a read-only attribute for the given domain and data type.
    * Returns null when it does not exist. */
   blender::bke::ReadAttributePtr attribute_try_get_for_read(
@@ -262,6 +273,12 @@ class GeometryComponent {
 template<typename T>
 inline constexpr bool is_geometry_component_v = std::is_base_of_v<GeometryComponent, T>;
 
+/* Joins components of the same type into the (empty) result component. */
+using GeometryComponentJoinFn = void (*)(blender::Span<const GeometryComponent *> components,
+                                         GeometryComponent &r_result);
+
+struct GeometryComponentJoin;
+
 /**
  * A geometry set contains zero or more geometry components. There is at most one component of each
  * type. Individual components might be shared between multiple geometries. Shared components are
@@ -274,6 +291,9 @@ struct GeometrySet {
  private:
   using GeometryComponentPtr = blender::UserCounter<class GeometryComponent>;
   blender::Map<GeometryComponentType, GeometryComponentPtr> components_;
+  /* Components that are only joined into the component of their type when it is accessed, see
+   * #add_components_to_join. The join is shared between copies of the geometry set. */
+  blender::Map<GeometryComponentType, std::shared_ptr<GeometryComponentJoin>> components_to_join_;
 
  public:
   GeometryComponent &get_component_for_write(GeometryComponentType component_type);
@@ -306,6 +326,14 @@ struct GeometrySet {
 
   void add(const GeometryComponent &component);
 
+  void add_components_to_join(GeometryComponentType component_type,
+                              blender::Span<const GeometryComponent *> components,
+                              GeometryComponentJoinFn join_fn);
+  blender::Vector<const GeometryComponent *> components_to_join(
+      GeometryComponentType component_type) const;
+
+  void ensure_owns_direct_data();
+
   void compute_boundbox_without_instances(blender::float3 *r_min, blender::float3 *r_max) const;
 
   friend std::ostream &operator<<(std::ostream &stream, const GeometrySet &geometry_set);
@@ -380,6 +408,9 @@ class MeshComponent : public GeometryComponent {
   blender::Set<std::string> attribute_names() const final;
   bool is_empty() const final;
 
+  bool owns_direct_data() const override;
+  void ensure_owns_direct_data() override;
+
   static constexpr inline GeometryComponentType static_type = GeometryComponentType::Mesh;
 };
 
@@ -422,6 +453,9 @@ class PointCloudComponent : public GeometryComponent {
   blender::Set<std::string> attribute_names() const final;
   bool is_empty() const final;
 
+  bool owns_direct_data() const override;
+  void ensure_owns_direct_data() override;
+
   static constexpr inline GeometryComponentType static_type = GeometryComponentType::PointCloud;
 };
 
@@ -441,12 +475,17 @@ class InstancesComponent : public GeometryComponent {
   void add_instance(Object *object, blender::float4x4 transform, const int id = -1);
   void add_instance(Collection *collection, blender::float4x4 transform, const int id = -1);
   void add_instance(InstancedData data, blender::float4x4 transform, const int id = -1);
+  void add_instances(blender::Span<InstancedData> data,
+                     blender::Span<blender::float4x4> transforms,
+                     blender::Span<int> ids);
 
   blender::Span<InstancedData> instanced_data() const;
   blender::Span<blender::float4x4> transforms() const;
   blender::Span<int> ids() const;
   blender::MutableSpan<blender::float4x4> transforms();
   int instances_amount() const;
+  void compute_world_transforms(const blender::float4x4 &object_transform,
+                                blender::MutableSpan<blender::float4x4> r_transforms) const;
 
   bool is_empty() const final;
 
@@ -472,5 +511,8 @@ class VolumeComponent : public GeometryComponent {
   const Volume *get_for_read() const;
   Volume *get_for_write();
 
+  bool owns_direct_data() const override;
+  void ensure_owns_direct_data() override;
+
   static constexpr inline GeometryComponentType static_type = GeometryComponentType::Volume;
 };
@@ -242,6 +242,14 @@ void BKE_image_user_id_eval_animation(struct Depsgraph *depsgraph, struct ID *id
 
 /* sets index offset for multilayer files */
 struct RenderPass *BKE_image_multilayer_index(struct RenderResult *rr, struct ImageUser *iuser);
+/* Multilayer images are loaded without pixels, passes are read when an image buffer of them is
+ * acquired. Read several passes at once, so the file is only decoded once for all of them.
+ * NULL layer_name or pass_names read the passes of all layers or all passes of the layers. */
+void BKE_image_multilayer_ensure_passes(struct Image *ima,
+                                        struct ImageUser *iuser,
+                                        const char *layer_name,
+                                        const char **pass_names,
+                                        int pass_names_len);
 
 /* sets index offset for multiview files */
 void BKE_image_multiview_index(struct Image *ima, struct ImageUser *iuser);
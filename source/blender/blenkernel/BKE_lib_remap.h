@@ -86,6 +86,11 @@ void BKE_libblock_remap_locked(struct Main *bmain,
                                const short remap_flags) ATTR_NONNULL(1, 2);
 void BKE_libblock_remap(struct Main *bmain, void *old_idv, void *new_idv, const short remap_flags)
     ATTR_NONNULL(1, 2);
+void BKE_libblock_remap_multiple_locked(struct Main *bmain,
+                                        struct ID **old_ids,
+                                        struct ID **new_ids,
+                                        const int ids_len,
+                                        const short remap_flags) ATTR_NONNULL(1, 2);
 
 void BKE_libblock_unlink(struct Main *bmain,
                          void *idv,
@@ -98,6 +103,13 @@ void BKE_libblock_relink_ex(struct Main *bmain,
                             void *new_idv,
                             const short remap_flags) ATTR_NONNULL(1, 2);
 
+void BKE_libblock_relink_multiple(struct Main *bmain,
+                                  struct ID **ids,
+                                  const int ids_len,
+                                  struct ID **old_ids,
+                                  struct ID **new_ids,
+                                  const int remap_len,
+                                  const short remap_flags) ATTR_NONNULL(1, 2, 4);
 void BKE_libblock_relink_to_newid(struct ID *id) ATTR_NONNULL();
 
 typedef void (*BKE_library_free_notifier_reference_cb)(const void *);
@@ -191,6 +191,12 @@ typedef struct Main {
    */
   struct MainIDRelations *relations;
 
+  /**
+   * Names of local IDs, to generate unique names faster, see `BKE_main_namemap.h`.
+   * Only exists while explicitly requested, NULL otherwise.
+   */
+  struct MainNameMap *name_map;
+
   struct MainLock *lock;
 } Main;
 
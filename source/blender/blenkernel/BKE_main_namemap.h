@@ -0,0 +1,63 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#pragma once
+
+/** \file
+ * \ingroup bke
+ *
+ * API to keep a mapping of the names of all local IDs in a Main data-base, used to generate
+ * unique ID names and to look IDs up by name without searching the whole list of IDs.
+ *
+ * The map is only kept up to date by the regular ID management functions (creation, renaming
+ * and deletion of IDs), code writing directly into `ID.name` would make it invalid. So it only
+ * exists between #BKE_main_namemap_ensure and #BKE_main_namemap_clear calls, around operations
+ * which create many IDs at once, like importers.
+ *
+ * \section Function Names
+ *
+ * - `BKE_main_namemap_` Should be used for functions in that file.
+ */
+
+#include "BLI_compiler_attrs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct ID;
+struct Main;
+struct MainNameMap;
+
+void BKE_main_namemap_ensure(struct Main *bmain) ATTR_NONNULL();
+void BKE_main_namemap_clear(struct Main *bmain) ATTR_NONNULL();
+
+bool BKE_main_namemap_has_name(struct Main *bmain, const short id_type, const char *name)
+    ATTR_WARN_UNUSED_RESULT ATTR_NONNULL();
+void BKE_main_namemap_add_id(struct Main *bmain, struct ID *id) ATTR_NONNULL();
+void BKE_main_namemap_remove_id(struct Main *bmain, struct ID *id) ATTR_NONNULL();
+
+int BKE_main_namemap_number_hint_get(struct Main *bmain,
+                                     const short id_type,
+                                     const char *base_name) ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL();
+void BKE_main_namemap_number_hint_set(struct Main *bmain,
+                                      const short id_type,
+                                      const char *base_name,
+                                      const int number) ATTR_NONNULL();
+
+#ifdef __cplusplus
+}
+#endif
@@ -305,6 +305,7 @@ void BKE_mesh_calc_normals_poly(struct MVert *mverts,
                                 const bool only_face_normals);
 void BKE_mesh_calc_normals(struct Mesh *me);
 void BKE_mesh_ensure_normals(struct Mesh *me);
+float (*BKE_mesh_poly_normals_ensure(struct Mesh *mesh))[3];
 void BKE_mesh_ensure_normals_for_display(struct Mesh *mesh);
 void BKE_mesh_calc_normals_looptri(struct MVert *mverts,
                                    int numVerts,
@@ -0,0 +1,50 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#pragma once
+#pragma once
+
+/** \file
+ * \ingroup bke
+ *
+ * Cache of deformed vertex positions of evaluated meshes, per object and frame, so repeated
+ * playback of the same frame range doesn't evaluate rigs and deform modifiers again.
+ */
+
+struct Depsgraph;
+struct Object;
+struct Scene;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool BKE_mesh_playback_cache_use(const struct Depsgraph *depsgraph,
+                                 const struct Scene *scene,
+                                 const struct Object *ob);
+
+float (*BKE_mesh_playback_cache_lookup(const struct Depsgraph *depsgraph,
+                                       const struct Object *ob,
+                                       int verts_len))[3];
+void BKE_mesh_playback_cache_store(const struct Depsgraph *depsgraph,
+                                   const struct Object *ob,
+                                   const float (*vert_coords)[3],
+                                   int verts_len);
+
+void BKE_mesh_playback_cache_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -60,6 +60,7 @@ struct Main;
 struct Material;
 struct PointerRNA;
 struct RenderData;
+struct RenderResult;
 struct Scene;
 struct SpaceNode;
 struct Tex;
@@ -113,6 +114,7 @@ namespace nodes {
 class SocketMFNetworkBuilder;
 class NodeMFNetworkBuilder;
 class GeoNodeExecParams;
+class GeoNodeAttributeNetworkBuilder;
 }  // namespace nodes
 namespace fn {
 class CPPType;
@@ -122,6 +124,8 @@ class MFDataType;
 
 using NodeExpandInMFNetworkFunction = void (*)(blender::nodes::NodeMFNetworkBuilder &builder);
 using NodeGeometryExecFunction = void (*)(blender::nodes::GeoNodeExecParams params);
+using NodeGeometryExpandAttributesFunction =
+    void (*)(blender::nodes::GeoNodeAttributeNetworkBuilder &builder);
 using SocketGetCPPTypeFunction = const blender::fn::CPPType *(*)();
 using SocketGetCPPValueFunction = void (*)(const struct bNodeSocket &socket, void *r_value);
 using SocketExpandInMFNetworkFunction = void (*)(blender::nodes::SocketMFNetworkBuilder &builder);
@@ -130,6 +134,7 @@ using SocketExpandInMFNetworkFunction = void (*)(blender::nodes::SocketMFNetwork
 typedef void *NodeExpandInMFNetworkFunction;
 typedef void *SocketExpandInMFNetworkFunction;
 typedef void *NodeGeometryExecFunction;
+typedef void *NodeGeometryExpandAttributesFunction;
 typedef void *SocketGetCPPTypeFunction;
 typedef void *SocketGetCPPValueFunction;
 #endif
@@ -313,6 +318,11 @@ typedef struct bNodeType {
   /* Execute a geometry node. */
   NodeGeometryExecFunction geometry_node_execute;
 
+  /* Expands an attribute geometry node into a multi-function network computing its result
+   * attribute, so that chains of attribute nodes can be evaluated in a single pass. The node
+   * still needs a #geometry_node_execute callback, used when it is evaluated on its own. */
+  NodeGeometryExpandAttributesFunction geometry_node_expand_attributes;
+
   /* RNA integration */
   ExtensionRNA rna_ext;
 } bNodeType;
@@ -1243,6 +1253,16 @@ void ntreeCompositExecTree(struct Scene *scene,
                            const struct ColorManagedViewSettings *view_settings,
                            const struct ColorManagedDisplaySettings *display_settings,
                            const char *view_name);
+void ntreeCompositExecFrames(struct Scene *scene,
+                             struct bNodeTree *ntree,
+                             struct RenderData *rd,
+                             const int *frames,
+                             struct RenderResult **results,
+                             int num_frames,
+                             const struct ColorManagedViewSettings *view_settings,
+                             const struct ColorManagedDisplaySettings *display_settings,
+                             const char *view_name);
+bool ntreeCompositCanExecFrames(struct bNodeTree *ntree);
 void ntreeCompositTagRender(struct Scene *scene);
 void ntreeCompositUpdateRLayers(struct bNodeTree *ntree);
 void ntreeCompositRegisterPass(struct bNodeTree *ntree,
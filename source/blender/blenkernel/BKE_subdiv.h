@@ -247,6 +247,22 @@ Subdiv *BKE_subdiv_update_from_mesh(Subdiv *subdiv,
 
 void BKE_subdiv_free(Subdiv *subdiv);
 
+/* ================================= CACHE ================================== */
+
+/* Descriptors which are no longer used can be handed over to a small global cache, so that their
+ * topology refiner and evaluator are reused when the same topology is subdivided again. This
+ * happens when evaluated copies of objects are re-created (undo, copy-on-write), or when the
+ * descriptor is only used for a single evaluation (geometry nodes).
+ *
+ * The acquired descriptor is to be passed to #BKE_subdiv_update_from_mesh, which does the exact
+ * topology comparison. */
+
+/* Take ownership of a cached descriptor which was created for a similar topology, or NULL. */
+Subdiv *BKE_subdiv_cache_acquire(const SubdivSettings *settings, const struct Mesh *mesh);
+/* Hand over ownership of a descriptor which is no longer used. */
+void BKE_subdiv_cache_release(Subdiv *subdiv);
+void BKE_subdiv_cache_clear(void);
+
 /* ============================ DISPLACEMENT API ============================ */
 
 void BKE_subdiv_displacement_attach_from_multires(Subdiv *subdiv,
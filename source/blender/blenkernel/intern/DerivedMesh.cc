@@ -58,6 +58,7 @@
 #include "BKE_mesh.h"
 #include "BKE_mesh_iterators.h"
 #include "BKE_mesh_mapping.h"
+#include "BKE_mesh_playback_cache.h"
 #include "BKE_mesh_runtime.h"
 #include "BKE_mesh_tangent.h"
 #include "BKE_mesh_wrapper.h"
@@ -809,19 +810,8 @@ static void mesh_calc_modifier_final_normals(const Mesh *mesh_input,
   /* In case we also need poly normals, add the layer and compute them here
    * (BKE_mesh_calc_normals_split() assumes that if that data exists, it is always valid). */
   if (do_poly_normals) {
-    if (!CustomData_has_layer(&mesh_final->pdata, CD_NORMAL)) {
-      float(*polynors)[3] = (float(*)[3])CustomData_add_layer(
-          &mesh_final->pdata, CD_NORMAL, CD_CALLOC, nullptr, mesh_final->totpoly);
-      BKE_mesh_calc_normals_poly(mesh_final->mvert,
-                                 nullptr,
-                                 mesh_final->totvert,
-                                 mesh_final->mloop,
-                                 mesh_final->mpoly,
-                                 mesh_final->totloop,
-                                 mesh_final->totpoly,
-                                 polynors,
-                                 false);
-    }
+    /* Updates dirty vertex normals too, so they are not computed again for display. */
+    BKE_mesh_poly_normals_ensure(mesh_final);
   }
 
   if (do_loop_normals) {
@@ -1024,6 +1014,15 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
 
   /* Apply all leading deform modifiers. */
   if (useDeform) {
+    /* Positions after the leading deform modifiers might be known from playing the frame before.
+     * The modifiers are still iterated over, to continue with the rest of the stack after them. */
+    const bool use_playback_cache = (index == -1) && (useDeform > 0) &&
+                                    BKE_mesh_playback_cache_use(depsgraph, scene, ob);
+    float(*cached_verts)[3] = (use_playback_cache) ?
+                                  BKE_mesh_playback_cache_lookup(
+                                      depsgraph, ob, num_deformed_verts) :
+                                  nullptr;
+
     for (; md; md = md->next, md_datamask = md_datamask->next) {
       const ModifierTypeInfo *mti = BKE_modifier_get_info((ModifierType)md->type);
 
@@ -1036,6 +1035,9 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
       }
 
       if (mti->type == eModifierTypeType_OnlyDeform && !sculpt_dyntopo) {
+        if (cached_verts) {
+          continue;
+        }
         if (!deformed_verts) {
           deformed_verts = BKE_mesh_vert_coords_alloc(mesh_input, &num_deformed_verts);
         }
@@ -1062,6 +1064,13 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
       }
     }
 
+    if (cached_verts) {
+      deformed_verts = cached_verts;
+    }
+    else if (use_playback_cache && deformed_verts) {
+      BKE_mesh_playback_cache_store(depsgraph, ob, deformed_verts, num_deformed_verts);
+    }
+
     /* Result of all leading deforming modifiers is cached for
      * places that wish to use the original mesh but with deformed
      * coordinates (like vertex paint). */
@@ -1491,19 +1500,8 @@ static void editbmesh_calc_modifier_final_normals(Mesh *mesh_final,
   /* In case we also need poly normals, add the layer and compute them here
    * (BKE_mesh_calc_normals_split() assumes that if that data exists, it is always valid). */
   if (do_poly_normals) {
-    if (!CustomData_has_layer(&mesh_final->pdata, CD_NORMAL)) {
-      float(*polynors)[3] = (float(*)[3])CustomData_add_layer(
-          &mesh_final->pdata, CD_NORMAL, CD_CALLOC, nullptr, mesh_final->totpoly);
-      BKE_mesh_calc_normals_poly(mesh_final->mvert,
-                                 nullptr,
-                                 mesh_final->totvert,
-                                 mesh_final->mloop,
-                                 mesh_final->mpoly,
-                                 mesh_final->totloop,
-                                 mesh_final->totpoly,
-                                 polynors,
-                                 false);
-    }
+    /* Updates dirty vertex normals too, so they are not computed again for display. */
+    BKE_mesh_poly_normals_ensure(mesh_final);
   }
 
   if (do_loop_normals) {
@@ -425,6 +425,51 @@ bool BKE_animsys_store_rna_setting(PointerRNA *ptr,
   return success;
 }
 
+/**
+ * Path of the last successfully resolved F-Curve, the channels of array properties usually
+ * follow each other and then only need to resolve their path once.
+ */
+typedef struct AnimsysPathCache {
+  const char *rna_path;
+  PointerRNA ptr;
+  PropertyRNA *prop;
+  int array_len;
+} AnimsysPathCache;
+
+/**
+ * Same as #BKE_animsys_store_rna_setting, but reuses the property of the previous call when the
+ * path is the same. Only valid while \a ptr and the data it points to stay the same.
+ */
+static bool animsys_store_rna_setting_cached(PointerRNA *ptr,
+                                             const char *rna_path,
+                                             const int array_index,
+                                             AnimsysPathCache *cache,
+                                             PathResolvedRNA *r_result)
+{
+  if (cache == NULL) {
+    return BKE_animsys_store_rna_setting(ptr, rna_path, array_index, r_result);
+  }
+
+  if (rna_path && cache->rna_path && STREQ(rna_path, cache->rna_path) &&
+      !(cache->array_len && array_index >= cache->array_len)) {
+    r_result->ptr = cache->ptr;
+    r_result->prop = cache->prop;
+    r_result->prop_index = cache->array_len ? array_index : -1;
+    return true;
+  }
+
+  if (!BKE_animsys_store_rna_setting(ptr, rna_path, array_index, r_result)) {
+    cache->rna_path = NULL;
+    return false;
+  }
+
+  cache->rna_path = rna_path;
+  cache->ptr = r_result->ptr;
+  cache->prop = r_result->prop;
+  cache->array_len = RNA_property_array_length(&r_result->ptr, r_result->prop);
+  return true;
+}
+
 /* less than 1.0 evaluates to false, use epsilon to avoid float error */
 #define ANIMSYS_FLOAT_AS_BOOL(value) ((value) > ((1.0f - FLT_EPSILON)))
 
@@ -583,7 +628,8 @@ static bool animsys_construct_orig_pointer_rna(const PointerRNA *ptr, PointerRNA
 static void animsys_write_orig_anim_rna(PointerRNA *ptr,
                                         const char *rna_path,
                                         int array_index,
-                                        float value)
+                                        float value,
+                                        AnimsysPathCache *cache)
 {
   PointerRNA ptr_orig;
   if (!animsys_construct_orig_pointer_rna(ptr, &ptr_orig)) {
@@ -591,11 +637,54 @@ static void animsys_write_orig_anim_rna(PointerRNA *ptr,
   }
   PathResolvedRNA orig_anim_rna;
   /* TODO(sergey): Should be possible to cache resolved path in dependency graph somehow. */
-  if (BKE_animsys_store_rna_setting(&ptr_orig, rna_path, array_index, &orig_anim_rna)) {
+  if (animsys_store_rna_setting_cached(
+          &ptr_orig, rna_path, array_index, cache, &orig_anim_rna)) {
     BKE_animsys_write_rna_setting(&orig_anim_rna, value);
   }
 }
 
+/**
+ * Evaluate the F-Curves that animate the elements of one float array property, starting at
+ * \a fcu which is already resolved to \a anim_rna. The array is read and written through RNA
+ * only once, instead of once for every element. Returns the last F-Curve that was handled.
+ */
+static FCurve *animsys_evaluate_fcurves_float_array(PointerRNA *ptr,
+                                                   FCurve *fcu,
+                                                   PathResolvedRNA *anim_rna,
+                                                   const AnimationEvalContext *anim_eval_context,
+                                                   bool flush_to_original,
+                                                   AnimsysPathCache *orig_path_cache)
+{
+  const char *rna_path = fcu->rna_path;
+  const int array_len = RNA_property_array_length(&anim_rna->ptr, anim_rna->prop);
+  float values_old[RNA_MAX_ARRAY_LENGTH];
+  float values[RNA_MAX_ARRAY_LENGTH];
+
+  RNA_property_float_get_array(&anim_rna->ptr, anim_rna->prop, values_old);
+  memcpy(values, values_old, sizeof(float) * array_len);
+
+  FCurve *last_fcu = fcu;
+  for (; fcu && fcu->rna_path && STREQ(fcu->rna_path, rna_path); fcu = fcu->next) {
+    last_fcu = fcu;
+    if (!is_fcurve_evaluatable(fcu) || fcu->array_index < 0 || fcu->array_index >= array_len) {
+      continue;
+    }
+
+    const float curval = calculate_fcurve(anim_rna, fcu, anim_eval_context);
+    values[fcu->array_index] = curval;
+    if (flush_to_original) {
+      animsys_write_orig_anim_rna(ptr, rna_path, fcu->array_index, curval, orig_path_cache);
+    }
+  }
+
+  /* Same as #BKE_animsys_write_rna_setting, skip the write when nothing changed. */
+  if (memcmp(values, values_old, sizeof(float) * array_len) != 0) {
+    RNA_property_float_set_array(&anim_rna->ptr, anim_rna->prop, values);
+  }
+
+  return last_fcu;
+}
+
 /**
  * Evaluate all the F-Curves in the given list
  * This performs a set of standard checks. If extra checks are required,
@@ -606,6 +695,9 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      const AnimationEvalContext *anim_eval_context,
                                      bool flush_to_original)
 {
+  AnimsysPathCache path_cache = {NULL};
+  AnimsysPathCache orig_path_cache = {NULL};
+
   /* Calculate then execute each curve. */
   LISTBASE_FOREACH (FCurve *, fcu, list) {
 
@@ -614,11 +706,20 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
     }
 
     PathResolvedRNA anim_rna;
-    if (BKE_animsys_store_rna_setting(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+    if (animsys_store_rna_setting_cached(
+            ptr, fcu->rna_path, fcu->array_index, &path_cache, &anim_rna)) {
+      if (anim_rna.prop_index != -1 && RNA_property_type(anim_rna.prop) == PROP_FLOAT &&
+          path_cache.array_len <= RNA_MAX_ARRAY_LENGTH) {
+        fcu = animsys_evaluate_fcurves_float_array(
+            ptr, fcu, &anim_rna, anim_eval_context, flush_to_original, &orig_path_cache);
+        continue;
+      }
+
       const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
       BKE_animsys_write_rna_setting(&anim_rna, curval);
       if (flush_to_original) {
-        animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, curval);
+        animsys_write_orig_anim_rna(
+            ptr, fcu->rna_path, fcu->array_index, curval, &orig_path_cache);
       }
     }
   }
@@ -649,6 +750,7 @@ static void animsys_evaluate_drivers(PointerRNA *ptr,
                                      const AnimationEvalContext *anim_eval_context)
 {
   FCurve *fcu;
+  AnimsysPathCache path_cache = {NULL};
 
   /* drivers are stored as F-Curves, but we cannot use the standard code, as we need to check if
    * the depsgraph requested that this driver be evaluated...
@@ -666,7 +768,8 @@ static void animsys_evaluate_drivers(PointerRNA *ptr,
          * NOTE: for 'layering' option later on, we should check if we should remove old value
          * before adding new to only be done when drivers only changed. */
         PathResolvedRNA anim_rna;
-        if (BKE_animsys_store_rna_setting(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+        if (animsys_store_rna_setting_cached(
+                ptr, fcu->rna_path, fcu->array_index, &path_cache, &anim_rna)) {
           const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
           ok = BKE_animsys_write_rna_setting(&anim_rna, curval);
         }
@@ -729,6 +832,7 @@ void animsys_evaluate_action_group(PointerRNA *ptr,
                                    const AnimationEvalContext *anim_eval_context)
 {
   FCurve *fcu;
+  AnimsysPathCache path_cache = {NULL};
 
   /* check if mapper is appropriate for use here (we set to NULL if it's inappropriate) */
   if (ELEM(NULL, act, agrp)) {
@@ -747,7 +851,8 @@ void animsys_evaluate_action_group(PointerRNA *ptr,
     /* check if this curve should be skipped */
     if ((fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED)) == 0 && !BKE_fcurve_is_empty(fcu)) {
       PathResolvedRNA anim_rna;
-      if (BKE_animsys_store_rna_setting(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+      if (animsys_store_rna_setting_cached(
+              ptr, fcu->rna_path, fcu->array_index, &path_cache, &anim_rna)) {
         const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
         BKE_animsys_write_rna_setting(&anim_rna, curval);
       }
@@ -2124,7 +2229,7 @@ void nladata_flush_channels(PointerRNA *ptr,
         }
         BKE_animsys_write_rna_setting(&rna, value);
         if (flush_to_original) {
-          animsys_write_orig_anim_rna(ptr, nec->rna_path, rna.prop_index, value);
+          animsys_write_orig_anim_rna(ptr, nec->rna_path, rna.prop_index, value, NULL);
         }
       }
     }
@@ -3124,7 +3229,7 @@ void BKE_animsys_eval_driver(Depsgraph *depsgraph, ID *id, int driver_index, FCu
 
         /* Flush results & status codes to original data for UI (T59984) */
         if (ok && DEG_is_active(depsgraph)) {
-          animsys_write_orig_anim_rna(&id_ptr, fcu->rna_path, fcu->array_index, curval);
+          animsys_write_orig_anim_rna(&id_ptr, fcu->rna_path, fcu->array_index, curval, NULL);
 
           /* curval is displayed in the UI, and flag contains error-status codes */
           fcu_orig->curval = fcu->curval;
@@ -61,46 +61,38 @@ static CLG_LogRef LOG = {"bke.armature_deform"};
 /** \name Armature Deform Internal Utilities
  * \{ */
 
-/* Add the effect of one bone or B-Bone segment to the accumulated result. */
+/**
+ * Add the effect of one bone or B-Bone segment to the accumulated result.
+ *
+ * For linear blending the weighted matrices are summed, and the vertex is transformed once by the
+ * sum after all bones were added. This is cheaper than transforming the vertex by every bone, and
+ * gives the deform matrix without extra work.
+ */
 static void pchan_deform_accumulate(const DualQuat *deform_dq,
                                     const float deform_mat[4][4],
-                                    const float co_in[3],
                                     float weight,
-                                    float co_accum[3],
-                                    DualQuat *dq_accum,
-                                    float mat_accum[3][3])
+                                    float mat_accum[4][4],
+                                    DualQuat *dq_accum)
 {
   if (weight == 0.0f) {
     return;
   }
 
   if (dq_accum) {
-    BLI_assert(!co_accum);
+    BLI_assert(!mat_accum);
 
     add_weighted_dq_dq(dq_accum, deform_dq, weight);
   }
   else {
-    float tmp[3];
-    mul_v3_m4v3(tmp, deform_mat, co_in);
-
-    sub_v3_v3(tmp, co_in);
-    madd_v3_v3fl(co_accum, tmp, weight);
-
-    if (mat_accum) {
-      float tmpmat[3][3];
-      copy_m3_m4(tmpmat, deform_mat);
-
-      madd_m3_m3m3fl(mat_accum, mat_accum, tmpmat, weight);
-    }
+    madd_m4_m4m4fl(mat_accum, mat_accum, deform_mat, weight);
   }
 }
 
 static void b_bone_deform(const bPoseChannel *pchan,
                           const float co[3],
                           float weight,
-                          float vec[3],
-                          DualQuat *dq,
-                          float defmat[3][3])
+                          float mat_accum[4][4],
+                          DualQuat *dq)
 {
   const DualQuat *quats = pchan->runtime.bbone_dual_quats;
   const Mat4 *mats = pchan->runtime.bbone_deform_mats;
@@ -115,9 +107,8 @@ static void b_bone_deform(const bPoseChannel *pchan,
   BKE_pchan_bbone_deform_segment_index(pchan, y / pchan->bone->length, &index, &blend);
 
   pchan_deform_accumulate(
-      &quats[index], mats[index + 1].mat, co, weight * (1.0f - blend), vec, dq, defmat);
-  pchan_deform_accumulate(
-      &quats[index + 1], mats[index + 2].mat, co, weight * blend, vec, dq, defmat);
+      &quats[index], mats[index + 1].mat, weight * (1.0f - blend), mat_accum, dq);
+  pchan_deform_accumulate(&quats[index + 1], mats[index + 2].mat, weight * blend, mat_accum, dq);
 }
 
 /* using vec with dist to bone b1 - b2 */
@@ -174,8 +165,10 @@ float distfactor_to_bone(
   return 1.0f - (a * a) / (rdist * rdist);
 }
 
-static float dist_bone_deform(
-    bPoseChannel *pchan, float vec[3], DualQuat *dq, float mat[3][3], const float co[3])
+static float dist_bone_deform(bPoseChannel *pchan,
+                              float mat[4][4],
+                              DualQuat *dq,
+                              const float co[3])
 {
   Bone *bone = pchan->bone;
   float fac, contrib = 0.0;
@@ -192,11 +185,10 @@ static float dist_bone_deform(
     contrib = fac;
     if (contrib > 0.0f) {
       if (bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments) {
-        b_bone_deform(pchan, co, fac, vec, dq, mat);
+        b_bone_deform(pchan, co, fac, mat, dq);
       }
       else {
-        pchan_deform_accumulate(
-            &pchan->runtime.deform_dual_quat, pchan->chan_mat, co, fac, vec, dq, mat);
+        pchan_deform_accumulate(&pchan->runtime.deform_dual_quat, pchan->chan_mat, fac, mat, dq);
       }
     }
   }
@@ -206,9 +198,8 @@ static float dist_bone_deform(
 
 static void pchan_bone_deform(bPoseChannel *pchan,
                               float weight,
-                              float vec[3],
+                              float mat[4][4],
                               DualQuat *dq,
-                              float mat[3][3],
                               const float co[3],
                               float *contrib)
 {
@@ -219,11 +210,10 @@ static void pchan_bone_deform(bPoseChannel *pchan,
   }
 
   if (bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments) {
-    b_bone_deform(pchan, co, weight, vec, dq, mat);
+    b_bone_deform(pchan, co, weight, mat, dq);
   }
   else {
-    pchan_deform_accumulate(
-        &pchan->runtime.deform_dual_quat, pchan->chan_mat, co, weight, vec, dq, mat);
+    pchan_deform_accumulate(&pchan->runtime.deform_dual_quat, pchan->chan_mat, weight, mat, dq);
   }
 
   (*contrib) += weight;
@@ -282,8 +272,8 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
   DualQuat sumdq, *dq = NULL;
   bPoseChannel *pchan;
   float *co, dco[3];
-  float sumvec[3], summat[3][3];
-  float *vec = NULL, (*smat)[3] = NULL;
+  float summat[4][4], (*smat)[4] = NULL;
+  float defmat[3][3];
   float contrib = 0.0f;
   float armature_weight = 1.0f; /* default to 1 if no overall def group */
   float prevco_weight = 1.0f;   /* weight for optional cached vertexcos */
@@ -293,13 +283,8 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
     dq = &sumdq;
   }
   else {
-    zero_v3(sumvec);
-    vec = sumvec;
-
-    if (vert_deform_mats) {
-      zero_m3(summat);
-      smat = summat;
-    }
+    zero_m4(summat);
+    smat = summat;
   }
 
   if (armature_def_nr != -1 && dvert) {
@@ -344,14 +329,14 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
               co, bone->arm_head, bone->arm_tail, bone->rad_head, bone->rad_tail, bone->dist);
         }
 
-        pchan_bone_deform(pchan, weight, vec, dq, smat, co, &contrib);
+        pchan_bone_deform(pchan, weight, smat, dq, co, &contrib);
       }
     }
     /* If there are vertex-groups but not groups with bones (like for soft-body groups). */
     if (deformed == 0 && use_envelope) {
       for (pchan = data->ob_arm->pose->chanbase.first; pchan; pchan = pchan->next) {
         if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
-          contrib += dist_bone_deform(pchan, vec, dq, smat, co);
+          contrib += dist_bone_deform(pchan, smat, dq, co);
         }
       }
     }
@@ -359,7 +344,7 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
   else if (use_envelope) {
     for (pchan = data->ob_arm->pose->chanbase.first; pchan; pchan = pchan->next) {
       if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
-        contrib += dist_bone_deform(pchan, vec, dq, smat, co);
+        contrib += dist_bone_deform(pchan, smat, dq, co);
       }
     }
   }
@@ -371,20 +356,21 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
 
       if (armature_weight != 1.0f) {
         copy_v3_v3(dco, co);
-        mul_v3m3_dq(dco, (vert_deform_mats) ? summat : NULL, dq);
+        mul_v3m3_dq(dco, (vert_deform_mats) ? defmat : NULL, dq);
         sub_v3_v3(dco, co);
         mul_v3_fl(dco, armature_weight);
         add_v3_v3(co, dco);
       }
       else {
-        mul_v3m3_dq(co, (vert_deform_mats) ? summat : NULL, dq);
+        mul_v3m3_dq(co, (vert_deform_mats) ? defmat : NULL, dq);
       }
-
-      smat = summat;
     }
     else {
-      mul_v3_fl(vec, armature_weight / contrib);
-      add_v3_v3v3(co, vec, co);
+      /* Offset by the blended matrix, the sum of weights is in the last component since all the
+       * bone matrices are affine. */
+      mul_v3_m4v3(dco, summat, co);
+      madd_v3_v3fl(dco, co, -summat[3][3]);
+      madd_v3_v3fl(co, dco, armature_weight / contrib);
     }
 
     if (vert_deform_mats) {
@@ -395,10 +381,11 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
       copy_m3_m3(tmpmat, vert_deform_mats[i]);
 
       if (!use_quaternion) { /* quaternion already is scale corrected */
-        mul_m3_fl(smat, armature_weight / contrib);
+        copy_m3_m4(defmat, summat);
+        mul_m3_fl(defmat, armature_weight / contrib);
       }
 
-      mul_m3_series(vert_deform_mats[i], post, smat, pre, tmpmat);
+      mul_m3_series(vert_deform_mats[i], post, defmat, pre, tmpmat);
     }
   }
 
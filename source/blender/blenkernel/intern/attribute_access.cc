@@ -14,6 +14,7 @@
  * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+#include <mutex>
 #include <utility>
 
 #include "BKE_attribute_access.hh"
@@ -29,7 +30,9 @@
 
 #include "BLI_color.hh"
 #include "BLI_float2.hh"
+#include "BLI_map.hh"
 #include "BLI_span.hh"
+#include "BLI_vector.hh"
 
 #include "CLG_log.h"
 
@@ -50,6 +53,123 @@ extern "C" MDeformVert *BKE_object_defgroup_data_create(ID *id);
 
 namespace blender::bke {
 
+/* -------------------------------------------------------------------- */
+/** \name Temporary Attribute Buffers
+ *
+ * Attributes that are not stored contiguously (or have to be converted) need a temporary buffer
+ * when a span is requested. Geometry nodes request the same spans on every evaluation, so the
+ * buffers are kept in a pool instead of going through the allocator every time.
+ * \{ */
+
+/* Buffers that have not been reused for this many calls to
+ * #free_unused_temporary_attribute_buffers are freed. */
+static constexpr int temporary_buffer_max_unused_generations = 4;
+
+/* All buffers are allocated with this alignment, so that they can be used for every type. */
+static constexpr int64_t temporary_buffer_alignment = 64;
+
+class TemporaryBufferPool {
+ private:
+  struct FreeBuffer {
+    void *buffer;
+    int64_t generation;
+  };
+
+  std::mutex mutex_;
+  /* Free buffers grouped by their allocated size, which is always a power of two. */
+  Map<int64_t, Vector<FreeBuffer>> free_buffers_;
+  int64_t generation_ = 0;
+
+ public:
+  ~TemporaryBufferPool()
+  {
+    for (Vector<FreeBuffer> &buffers : free_buffers_.values()) {
+      for (FreeBuffer &free_buffer : buffers) {
+        MEM_freeN(free_buffer.buffer);
+      }
+    }
+  }
+
+  void *allocate(const int64_t size)
+  {
+    const int64_t allocated_size = this->allocated_size(size);
+    {
+      std::lock_guard lock{mutex_};
+      Vector<FreeBuffer> *buffers = free_buffers_.lookup_ptr(allocated_size);
+      if (buffers != nullptr && !buffers->is_empty()) {
+        return buffers->pop_last().buffer;
+      }
+    }
+    return MEM_mallocN_aligned(allocated_size, temporary_buffer_alignment, __func__);
+  }
+
+  void free(void *buffer, const int64_t size)
+  {
+    const int64_t allocated_size = this->allocated_size(size);
+    std::lock_guard lock{mutex_};
+    free_buffers_.lookup_or_add_default(allocated_size).append({buffer, generation_});
+  }
+
+  void free_unused()
+  {
+    std::lock_guard lock{mutex_};
+    for (Vector<FreeBuffer> &buffers : free_buffers_.values()) {
+      /* Buffers are appended in order of their generation, so the oldest ones come first. */
+      int64_t unused_amount = 0;
+      while (unused_amount < buffers.size() &&
+             generation_ - buffers[unused_amount].generation >=
+                 temporary_buffer_max_unused_generations) {
+        MEM_freeN(buffers[unused_amount].buffer);
+        unused_amount++;
+      }
+      buffers.remove(0, unused_amount);
+    }
+    generation_++;
+  }
+
+ private:
+  static int64_t allocated_size(const int64_t size)
+  {
+    int64_t allocated_size = temporary_buffer_alignment;
+    while (allocated_size < size) {
+      allocated_size *= 2;
+    }
+    return allocated_size;
+  }
+};
+
+/* Use the "construct on first use" idiom, so that the pool is destructed before the memory leak
+ * detector runs. */
+static TemporaryBufferPool &get_temporary_buffer_pool()
+{
+  static TemporaryBufferPool pool;
+  return pool;
+}
+
+static void *allocate_temporary_buffer(const CPPType &type, const int64_t size)
+{
+  BLI_assert(type.alignment() <= temporary_buffer_alignment);
+  return get_temporary_buffer_pool().allocate(type.size() * size);
+}
+
+static void free_temporary_buffer(const CPPType &type, void *buffer, const int64_t size)
+{
+  type.destruct_n(buffer, size);
+  get_temporary_buffer_pool().free(buffer, type.size() * size);
+}
+
+/**
+ * Free the temporary attribute buffers that have not been reused recently. This is meant to be
+ * called after every evaluation, buffers are kept alive for a few calls so that they can be
+ * reused by the next evaluations.
+ */
+void free_unused_temporary_attribute_buffers()
+{
+  get_temporary_buffer_pool().free_unused();
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Attribute Accessor implementations
  * \{ */
@@ -57,8 +177,7 @@ namespace blender::bke {
 ReadAttribute::~ReadAttribute()
 {
   if (array_is_temporary_ && array_buffer_ != nullptr) {
-    cpp_type_.destruct_n(array_buffer_, size_);
-    MEM_freeN(array_buffer_);
+    free_temporary_buffer(cpp_type_, array_buffer_, size_);
   }
 }
 
@@ -79,7 +198,7 @@ fn::GSpan ReadAttribute::get_span() const
 void ReadAttribute::initialize_span() const
 {
   const int element_size = cpp_type_.size();
-  array_buffer_ = MEM_mallocN_aligned(size_ * element_size, cpp_type_.alignment(), __func__);
+  array_buffer_ = allocate_temporary_buffer(cpp_type_, size_);
   array_is_temporary_ = true;
   for (const int i : IndexRange(size_)) {
     this->get_internal(i, POINTER_OFFSET(array_buffer_, i * element_size));
@@ -92,8 +211,7 @@ WriteAttribute::~WriteAttribute()
     CLOG_ERROR(&LOG, "Forgot to call apply_span.");
   }
   if (array_is_temporary_ && array_buffer_ != nullptr) {
-    cpp_type_.destruct_n(array_buffer_, size_);
-    MEM_freeN(array_buffer_);
+    free_temporary_buffer(cpp_type_, array_buffer_, size_);
   }
 }
 
@@ -127,7 +245,7 @@ fn::GMutableSpan WriteAttribute::get_span_for_write_only()
 void WriteAttribute::initialize_span(const bool write_only)
 {
   const int element_size = cpp_type_.size();
-  array_buffer_ = MEM_mallocN_aligned(element_size * size_, cpp_type_.alignment(), __func__);
+  array_buffer_ = allocate_temporary_buffer(cpp_type_, size_);
   array_is_temporary_ = true;
   if (write_only) {
     /* This does nothing for trivial types, but is necessary for general correctness. */
@@ -273,8 +391,7 @@ class TemporaryWriteAttribute final : public WriteAttribute {
   ~TemporaryWriteAttribute() override
   {
     if (data.data() != nullptr) {
-      cpp_type_.destruct_n(data.data(), data.size());
-      MEM_freeN(data.data());
+      free_temporary_buffer(cpp_type_, data.data(), data.size());
     }
   }
 
@@ -407,8 +524,7 @@ class ConstantReadAttribute final : public ReadAttribute {
 
   void initialize_span() const override
   {
-    const int element_size = cpp_type_.size();
-    array_buffer_ = MEM_mallocN_aligned(size_ * element_size, cpp_type_.alignment(), __func__);
+    array_buffer_ = allocate_temporary_buffer(cpp_type_, size_);
     array_is_temporary_ = true;
     cpp_type_.fill_uninitialized(value_, array_buffer_, size_);
   }
@@ -872,7 +988,7 @@ OutputAttributePtr::OutputAttributePtr(GeometryComponent &component,
   BLI_assert(cpp_type != nullptr);
 
   const int domain_size = component.attribute_domain_size(domain);
-  void *buffer = MEM_malloc_arrayN(domain_size, cpp_type->size(), __func__);
+  void *buffer = blender::bke::allocate_temporary_buffer(*cpp_type, domain_size);
   GMutableSpan new_span{*cpp_type, buffer, domain_size};
 
   /* Copy converted values from conflicting attribute, in case the value is read.
@@ -49,6 +49,7 @@
 #include "BKE_image.h"
 #include "BKE_layer.h"
 #include "BKE_main.h"
+#include "BKE_mesh_playback_cache.h"
 #include "BKE_node.h"
 #include "BKE_report.h"
 #include "BKE_scene.h"
@@ -99,6 +100,7 @@ void BKE_blender_free(void)
   BKE_callback_global_finalize();
 
   IMB_moviecache_destruct();
+  BKE_mesh_playback_cache_clear();
 
   BKE_node_system_exit();
 }
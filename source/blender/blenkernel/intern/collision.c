@@ -670,274 +670,296 @@ static void cloth_collision_impulse_vert(const float clamp_sq,
   vert->impulse_count++;
 }
 
-static int cloth_collision_response_static(ClothModifierData *clmd,
-                                           CollisionModifierData *collmd,
-                                           Object *collob,
-                                           CollPair *collpair,
-                                           uint collision_count,
-                                           const float dt)
-{
-  int result = 0;
-  Cloth *cloth = clmd->clothObject;
-  const float clamp_sq = square_f(clmd->coll_parms->clamp * dt);
-  const float time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
-  const float epsilon2 = BLI_bvhtree_get_epsilon(collmd->bvhtree);
-  const float min_distance = (clmd->coll_parms->epsilon + epsilon2) * (8.0f / 9.0f);
+typedef struct CollPairImpulse {
+  /* Impulses for the vertices of the first and second element of the pair. */
+  float impulse[6][3];
+  bool active;
+} CollPairImpulse;
 
+typedef struct CollisionResponseData {
+  ClothModifierData *clmd;
+  /* Collider, NULL for self collisions. */
+  CollisionModifierData *collmd;
+  Object *collob;
+  CollPair *collisions;
+  CollPairImpulse *impulses;
+  float time_multiplier;
+  float min_distance;
+} CollisionResponseData;
+
+/* Compute the impulses of a single collision pair, only reading the cloth state, so that
+ * pairs can be processed in parallel. Returns false when the pair does not need a response. */
+static bool cloth_collision_response_pair(const CollisionResponseData *data,
+                                          const CollPair *collpair,
+                                          float r_impulse[6][3])
+{
+  const ClothModifierData *clmd = data->clmd;
+  const CollisionModifierData *collmd = data->collmd;
+  const Object *collob = data->collob;
+  const Cloth *cloth = clmd->clothObject;
+  const float time_multiplier = data->time_multiplier;
+  const float min_distance = data->min_distance;
   const bool is_hair = (clmd->hairdata != NULL);
-  for (int i = 0; i < collision_count; i++, collpair++) {
-    float i1[3], i2[3], i3[3];
-    float w1, w2, w3, u1, u2, u3;
-    float v1[3], v2[3], relativeVelocity[3];
-    zero_v3(i1);
-    zero_v3(i2);
-    zero_v3(i3);
-
-    /* Only handle static collisions here. */
-    if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
-      continue;
-    }
 
-    /* Compute barycentric coordinates and relative "velocity" for both collision points. */
-    if (is_hair) {
-      w2 = line_point_factor_v3(
-          collpair->pa, cloth->verts[collpair->ap1].tx, cloth->verts[collpair->ap2].tx);
+  float *i1 = r_impulse[0], *i2 = r_impulse[1], *i3 = r_impulse[2];
+  float w1, w2, w3, u1, u2, u3;
+  float v1[3], v2[3], relativeVelocity[3];
+  zero_v3(i1);
+  zero_v3(i2);
+  zero_v3(i3);
 
-      w1 = 1.0f - w2;
+  /* Only handle static collisions here. */
+  if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
+    return false;
+  }
 
-      interp_v3_v3v3(v1, cloth->verts[collpair->ap1].tv, cloth->verts[collpair->ap2].tv, w2);
-    }
-    else {
-      collision_compute_barycentric(collpair->pa,
-                                    cloth->verts[collpair->ap1].tx,
-                                    cloth->verts[collpair->ap2].tx,
-                                    cloth->verts[collpair->ap3].tx,
-                                    &w1,
-                                    &w2,
-                                    &w3);
-
-      collision_interpolateOnTriangle(v1,
-                                      cloth->verts[collpair->ap1].tv,
-                                      cloth->verts[collpair->ap2].tv,
-                                      cloth->verts[collpair->ap3].tv,
-                                      w1,
-                                      w2,
-                                      w3);
-    }
+  /* Compute barycentric coordinates and relative "velocity" for both collision points. */
+  if (is_hair) {
+    w2 = line_point_factor_v3(
+        collpair->pa, cloth->verts[collpair->ap1].tx, cloth->verts[collpair->ap2].tx);
 
-    collision_compute_barycentric(collpair->pb,
-                                  collmd->current_xnew[collpair->bp1].co,
-                                  collmd->current_xnew[collpair->bp2].co,
-                                  collmd->current_xnew[collpair->bp3].co,
-                                  &u1,
-                                  &u2,
-                                  &u3);
-
-    collision_interpolateOnTriangle(v2,
-                                    collmd->current_v[collpair->bp1].co,
-                                    collmd->current_v[collpair->bp2].co,
-                                    collmd->current_v[collpair->bp3].co,
-                                    u1,
-                                    u2,
-                                    u3);
-
-    sub_v3_v3v3(relativeVelocity, v2, v1);
-
-    /* Calculate the normal component of the relative velocity
-     * (actually only the magnitude - the direction is stored in 'normal'). */
-    const float magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
-    const float d = min_distance - collpair->distance;
-
-    /* If magrelVel < 0 the edges are approaching each other. */
-    if (magrelVel > 0.0f) {
-      /* Calculate Impulse magnitude to stop all motion in normal direction. */
-      float magtangent = 0, repulse = 0;
-      double impulse = 0.0;
-      float vrel_t_pre[3];
-      float temp[3];
-
-      /* Calculate tangential velocity. */
-      copy_v3_v3(temp, collpair->normal);
-      mul_v3_fl(temp, magrelVel);
-      sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
-
-      /* Decrease in magnitude of relative tangential velocity due to coulomb friction
-       * in original formula "magrelVel" should be the
-       * "change of relative velocity in normal direction". */
-      magtangent = min_ff(collob->pd->pdef_cfrict * 0.01f * magrelVel, len_v3(vrel_t_pre));
-
-      /* Apply friction impulse. */
-      if (magtangent > ALMOST_ZERO) {
-        normalize_v3(vrel_t_pre);
-
-        impulse = magtangent / 1.5;
-
-        VECADDMUL(i1, vrel_t_pre, (double)w1 * impulse);
-        VECADDMUL(i2, vrel_t_pre, (double)w2 * impulse);
-
-        if (!is_hair) {
-          VECADDMUL(i3, vrel_t_pre, (double)w3 * impulse);
-        }
-      }
+    w1 = 1.0f - w2;
 
-      /* Apply velocity stopping impulse. */
-      impulse = magrelVel / 1.5f;
+    interp_v3_v3v3(v1, cloth->verts[collpair->ap1].tv, cloth->verts[collpair->ap2].tv, w2);
+  }
+  else {
+    collision_compute_barycentric(collpair->pa,
+                                  cloth->verts[collpair->ap1].tx,
+                                  cloth->verts[collpair->ap2].tx,
+                                  cloth->verts[collpair->ap3].tx,
+                                  &w1,
+                                  &w2,
+                                  &w3);
 
-      VECADDMUL(i1, collpair->normal, (double)w1 * impulse);
-      VECADDMUL(i2, collpair->normal, (double)w2 * impulse);
-      if (!is_hair) {
-        VECADDMUL(i3, collpair->normal, (double)w3 * impulse);
-      }
+    collision_interpolateOnTriangle(v1,
+                                    cloth->verts[collpair->ap1].tv,
+                                    cloth->verts[collpair->ap2].tv,
+                                    cloth->verts[collpair->ap3].tv,
+                                    w1,
+                                    w2,
+                                    w3);
+  }
 
-      if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
-        repulse = MIN2(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
+  collision_compute_barycentric(collpair->pb,
+                                collmd->current_xnew[collpair->bp1].co,
+                                collmd->current_xnew[collpair->bp2].co,
+                                collmd->current_xnew[collpair->bp3].co,
+                                &u1,
+                                &u2,
+                                &u3);
 
-        /* Stay on the safe side and clamp repulse. */
-        if (impulse > ALMOST_ZERO) {
-          repulse = min_ff(repulse, 5.0f * impulse);
-        }
+  collision_interpolateOnTriangle(v2,
+                                  collmd->current_v[collpair->bp1].co,
+                                  collmd->current_v[collpair->bp2].co,
+                                  collmd->current_v[collpair->bp3].co,
+                                  u1,
+                                  u2,
+                                  u3);
 
-        repulse = max_ff(impulse, repulse);
+  sub_v3_v3v3(relativeVelocity, v2, v1);
 
-        impulse = repulse / 1.5f;
+  /* Calculate the normal component of the relative velocity
+   * (actually only the magnitude - the direction is stored in 'normal'). */
+  const float magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
+  const float d = min_distance - collpair->distance;
 
-        VECADDMUL(i1, collpair->normal, impulse);
-        VECADDMUL(i2, collpair->normal, impulse);
-        if (!is_hair) {
-          VECADDMUL(i3, collpair->normal, impulse);
-        }
-      }
+  /* If magrelVel < 0 the edges are approaching each other. */
+  if (magrelVel > 0.0f) {
+    /* Calculate Impulse magnitude to stop all motion in normal direction. */
+    float magtangent = 0, repulse = 0;
+    double impulse = 0.0;
+    float vrel_t_pre[3];
+    float temp[3];
 
-      result = 1;
-    }
-    else if (d > ALMOST_ZERO) {
-      /* Stay on the safe side and clamp repulse. */
-      float repulse = d / time_multiplier;
-      float impulse = repulse / 4.5f;
+    /* Calculate tangential velocity. */
+    copy_v3_v3(temp, collpair->normal);
+    mul_v3_fl(temp, magrelVel);
+    sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
+
+    /* Decrease in magnitude of relative tangential velocity due to coulomb friction
+     * in original formula "magrelVel" should be the
+     * "change of relative velocity in normal direction". */
+    magtangent = min_ff(collob->pd->pdef_cfrict * 0.01f * magrelVel, len_v3(vrel_t_pre));
+
+    /* Apply friction impulse. */
+    if (magtangent > ALMOST_ZERO) {
+      normalize_v3(vrel_t_pre);
 
-      VECADDMUL(i1, collpair->normal, w1 * impulse);
-      VECADDMUL(i2, collpair->normal, w2 * impulse);
+      impulse = magtangent / 1.5;
+
+      VECADDMUL(i1, vrel_t_pre, (double)w1 * impulse);
+      VECADDMUL(i2, vrel_t_pre, (double)w2 * impulse);
 
       if (!is_hair) {
-        VECADDMUL(i3, collpair->normal, w3 * impulse);
+        VECADDMUL(i3, vrel_t_pre, (double)w3 * impulse);
       }
+    }
+
+    /* Apply velocity stopping impulse. */
+    impulse = magrelVel / 1.5f;
 
-      result = 1;
+    VECADDMUL(i1, collpair->normal, (double)w1 * impulse);
+    VECADDMUL(i2, collpair->normal, (double)w2 * impulse);
+    if (!is_hair) {
+      VECADDMUL(i3, collpair->normal, (double)w3 * impulse);
     }
 
-    if (result) {
-      cloth_collision_impulse_vert(clamp_sq, i1, &cloth->verts[collpair->ap1]);
-      cloth_collision_impulse_vert(clamp_sq, i2, &cloth->verts[collpair->ap2]);
+    if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
+      repulse = MIN2(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
+
+      /* Stay on the safe side and clamp repulse. */
+      if (impulse > ALMOST_ZERO) {
+        repulse = min_ff(repulse, 5.0f * impulse);
+      }
+
+      repulse = max_ff(impulse, repulse);
+
+      impulse = repulse / 1.5f;
+
+      VECADDMUL(i1, collpair->normal, impulse);
+      VECADDMUL(i2, collpair->normal, impulse);
       if (!is_hair) {
-        cloth_collision_impulse_vert(clamp_sq, i3, &cloth->verts[collpair->ap3]);
+        VECADDMUL(i3, collpair->normal, impulse);
       }
     }
+
+    return true;
   }
+  if (d > ALMOST_ZERO) {
+    /* Stay on the safe side and clamp repulse. */
+    float repulse = d / time_multiplier;
+    float impulse = repulse / 4.5f;
 
-  return result;
-}
+    VECADDMUL(i1, collpair->normal, w1 * impulse);
+    VECADDMUL(i2, collpair->normal, w2 * impulse);
 
-static int cloth_selfcollision_response_static(ClothModifierData *clmd,
-                                               CollPair *collpair,
-                                               uint collision_count,
-                                               const float dt)
+    if (!is_hair) {
+      VECADDMUL(i3, collpair->normal, w3 * impulse);
+    }
+
+    return true;
+  }
+
+  return false;}
+
+/* Same as #cloth_collision_response_pair for self collisions. */
+static bool cloth_selfcollision_response_pair(const CollisionResponseData *data,
+                                              const CollPair *collpair,
+                                              float r_impulse[6][3])
 {
-  int result = 0;
-  Cloth *cloth = clmd->clothObject;
-  const float clamp_sq = square_f(clmd->coll_parms->self_clamp * dt);
-  const float time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
-  const float min_distance = (2.0f * clmd->coll_parms->selfepsilon) * (8.0f / 9.0f);
-
-  for (int i = 0; i < collision_count; i++, collpair++) {
-    float ia[3][3] = {{0.0f}};
-    float ib[3][3] = {{0.0f}};
-    float w1, w2, w3, u1, u2, u3;
-    float v1[3], v2[3], relativeVelocity[3];
-
-    /* Only handle static collisions here. */
-    if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
-      continue;
+  const ClothModifierData *clmd = data->clmd;
+  const Cloth *cloth = clmd->clothObject;
+  const float time_multiplier = data->time_multiplier;
+  const float min_distance = data->min_distance;
+
+  float(*ia)[3] = &r_impulse[0];
+  float(*ib)[3] = &r_impulse[3];
+  float w1, w2, w3, u1, u2, u3;
+  float v1[3], v2[3], relativeVelocity[3];
+  memset(r_impulse, 0, sizeof(float[6][3]));
+
+  /* Only handle static collisions here. */
+  if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
+    return false;
+  }
+
+  /* Compute barycentric coordinates for both collision points. */
+  collision_compute_barycentric(collpair->pa,
+                                cloth->verts[collpair->ap1].tx,
+                                cloth->verts[collpair->ap2].tx,
+                                cloth->verts[collpair->ap3].tx,
+                                &w1,
+                                &w2,
+                                &w3);
+
+  collision_compute_barycentric(collpair->pb,
+                                cloth->verts[collpair->bp1].tx,
+                                cloth->verts[collpair->bp2].tx,
+                                cloth->verts[collpair->bp3].tx,
+                                &u1,
+                                &u2,
+                                &u3);
+
+  /* Calculate relative "velocity". */
+  collision_interpolateOnTriangle(v1,
+                                  cloth->verts[collpair->ap1].tv,
+                                  cloth->verts[collpair->ap2].tv,
+                                  cloth->verts[collpair->ap3].tv,
+                                  w1,
+                                  w2,
+                                  w3);
+
+  collision_interpolateOnTriangle(v2,
+                                  cloth->verts[collpair->bp1].tv,
+                                  cloth->verts[collpair->bp2].tv,
+                                  cloth->verts[collpair->bp3].tv,
+                                  u1,
+                                  u2,
+                                  u3);
+
+  sub_v3_v3v3(relativeVelocity, v2, v1);
+
+  /* Calculate the normal component of the relative velocity
+   * (actually only the magnitude - the direction is stored in 'normal'). */
+  const float magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
+  const float d = min_distance - collpair->distance;
+
+  /* TODO: Impulses should be weighed by mass as this is self col,
+   * this has to be done after mass distribution is implemented. */
+
+  /* If magrelVel < 0 the edges are approaching each other. */
+  if (magrelVel > 0.0f) {
+    /* Calculate Impulse magnitude to stop all motion in normal direction. */
+    float magtangent = 0, repulse = 0;
+    double impulse = 0.0;
+    float vrel_t_pre[3];
+    float temp[3];
+
+    /* Calculate tangential velocity. */
+    copy_v3_v3(temp, collpair->normal);
+    mul_v3_fl(temp, magrelVel);
+    sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
+
+    /* Decrease in magnitude of relative tangential velocity due to coulomb friction
+     * in original formula "magrelVel" should be the
+     * "change of relative velocity in normal direction". */
+    magtangent = min_ff(clmd->coll_parms->self_friction * 0.01f * magrelVel, len_v3(vrel_t_pre));
+
+    /* Apply friction impulse. */
+    if (magtangent > ALMOST_ZERO) {
+      normalize_v3(vrel_t_pre);
+
+      impulse = magtangent / 1.5;
+
+      VECADDMUL(ia[0], vrel_t_pre, (double)w1 * impulse);
+      VECADDMUL(ia[1], vrel_t_pre, (double)w2 * impulse);
+      VECADDMUL(ia[2], vrel_t_pre, (double)w3 * impulse);
+
+      VECADDMUL(ib[0], vrel_t_pre, (double)u1 * -impulse);
+      VECADDMUL(ib[1], vrel_t_pre, (double)u2 * -impulse);
+      VECADDMUL(ib[2], vrel_t_pre, (double)u3 * -impulse);
     }
 
-    /* Compute barycentric coordinates for both collision points. */
-    collision_compute_barycentric(collpair->pa,
-                                  cloth->verts[collpair->ap1].tx,
-                                  cloth->verts[collpair->ap2].tx,
-                                  cloth->verts[collpair->ap3].tx,
-                                  &w1,
-                                  &w2,
-                                  &w3);
+    /* Apply velocity stopping impulse. */
+    impulse = magrelVel / 3.0f;
 
-    collision_compute_barycentric(collpair->pb,
-                                  cloth->verts[collpair->bp1].tx,
-                                  cloth->verts[collpair->bp2].tx,
-                                  cloth->verts[collpair->bp3].tx,
-                                  &u1,
-                                  &u2,
-                                  &u3);
+    VECADDMUL(ia[0], collpair->normal, (double)w1 * impulse);
+    VECADDMUL(ia[1], collpair->normal, (double)w2 * impulse);
+    VECADDMUL(ia[2], collpair->normal, (double)w3 * impulse);
 
-    /* Calculate relative "velocity". */
-    collision_interpolateOnTriangle(v1,
-                                    cloth->verts[collpair->ap1].tv,
-                                    cloth->verts[collpair->ap2].tv,
-                                    cloth->verts[collpair->ap3].tv,
-                                    w1,
-                                    w2,
-                                    w3);
+    VECADDMUL(ib[0], collpair->normal, (double)u1 * -impulse);
+    VECADDMUL(ib[1], collpair->normal, (double)u2 * -impulse);
+    VECADDMUL(ib[2], collpair->normal, (double)u3 * -impulse);
 
-    collision_interpolateOnTriangle(v2,
-                                    cloth->verts[collpair->bp1].tv,
-                                    cloth->verts[collpair->bp2].tv,
-                                    cloth->verts[collpair->bp3].tv,
-                                    u1,
-                                    u2,
-                                    u3);
-
-    sub_v3_v3v3(relativeVelocity, v2, v1);
-
-    /* Calculate the normal component of the relative velocity
-     * (actually only the magnitude - the direction is stored in 'normal'). */
-    const float magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
-    const float d = min_distance - collpair->distance;
-
-    /* TODO: Impulses should be weighed by mass as this is self col,
-     * this has to be done after mass distribution is implemented. */
-
-    /* If magrelVel < 0 the edges are approaching each other. */
-    if (magrelVel > 0.0f) {
-      /* Calculate Impulse magnitude to stop all motion in normal direction. */
-      float magtangent = 0, repulse = 0;
-      double impulse = 0.0;
-      float vrel_t_pre[3];
-      float temp[3];
-
-      /* Calculate tangential velocity. */
-      copy_v3_v3(temp, collpair->normal);
-      mul_v3_fl(temp, magrelVel);
-      sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
-
-      /* Decrease in magnitude of relative tangential velocity due to coulomb friction
-       * in original formula "magrelVel" should be the
-       * "change of relative velocity in normal direction". */
-      magtangent = min_ff(clmd->coll_parms->self_friction * 0.01f * magrelVel, len_v3(vrel_t_pre));
-
-      /* Apply friction impulse. */
-      if (magtangent > ALMOST_ZERO) {
-        normalize_v3(vrel_t_pre);
-
-        impulse = magtangent / 1.5;
-
-        VECADDMUL(ia[0], vrel_t_pre, (double)w1 * impulse);
-        VECADDMUL(ia[1], vrel_t_pre, (double)w2 * impulse);
-        VECADDMUL(ia[2], vrel_t_pre, (double)w3 * impulse);
-
-        VECADDMUL(ib[0], vrel_t_pre, (double)u1 * -impulse);
-        VECADDMUL(ib[1], vrel_t_pre, (double)u2 * -impulse);
-        VECADDMUL(ib[2], vrel_t_pre, (double)u3 * -impulse);
+    if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
+      repulse = MIN2(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
+
+      if (impulse > ALMOST_ZERO) {
+        repulse = min_ff(repulse, 5.0 * impulse);
       }
 
-      /* Apply velocity stopping impulse. */
-      impulse = magrelVel / 3.0f;
+      repulse = max_ff(impulse, repulse);
+      impulse = repulse / 1.5f;
 
       VECADDMUL(ia[0], collpair->normal, (double)w1 * impulse);
       VECADDMUL(ia[1], collpair->normal, (double)w2 * impulse);
@@ -946,58 +968,127 @@ static int cloth_selfcollision_response_static(ClothModifierData *clmd,
       VECADDMUL(ib[0], collpair->normal, (double)u1 * -impulse);
       VECADDMUL(ib[1], collpair->normal, (double)u2 * -impulse);
       VECADDMUL(ib[2], collpair->normal, (double)u3 * -impulse);
+    }
 
-      if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
-        repulse = MIN2(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
+    return true;
+  }
+  if (d > ALMOST_ZERO) {
+    /* Stay on the safe side and clamp repulse. */
+    float repulse = d * 1.0f / time_multiplier;
+    float impulse = repulse / 9.0f;
 
-        if (impulse > ALMOST_ZERO) {
-          repulse = min_ff(repulse, 5.0 * impulse);
-        }
+    VECADDMUL(ia[0], collpair->normal, w1 * impulse);
+    VECADDMUL(ia[1], collpair->normal, w2 * impulse);
+    VECADDMUL(ia[2], collpair->normal, w3 * impulse);
 
-        repulse = max_ff(impulse, repulse);
-        impulse = repulse / 1.5f;
+    VECADDMUL(ib[0], collpair->normal, u1 * -impulse);
+    VECADDMUL(ib[1], collpair->normal, u2 * -impulse);
+    VECADDMUL(ib[2], collpair->normal, u3 * -impulse);
 
-        VECADDMUL(ia[0], collpair->normal, (double)w1 * impulse);
-        VECADDMUL(ia[1], collpair->normal, (double)w2 * impulse);
-        VECADDMUL(ia[2], collpair->normal, (double)w3 * impulse);
+    return true;
+  }
 
-        VECADDMUL(ib[0], collpair->normal, (double)u1 * -impulse);
-        VECADDMUL(ib[1], collpair->normal, (double)u2 * -impulse);
-        VECADDMUL(ib[2], collpair->normal, (double)u3 * -impulse);
-      }
+  return false;}
 
-      result = 1;
-    }
-    else if (d > ALMOST_ZERO) {
-      /* Stay on the safe side and clamp repulse. */
-      float repulse = d * 1.0f / time_multiplier;
-      float impulse = repulse / 9.0f;
+static void cloth_collision_response_task(void *__restrict userdata,
+                                          const int index,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  CollisionResponseData *data = (CollisionResponseData *)userdata;
+  CollPairImpulse *impulse = &data->impulses[index];
 
-      VECADDMUL(ia[0], collpair->normal, w1 * impulse);
-      VECADDMUL(ia[1], collpair->normal, w2 * impulse);
-      VECADDMUL(ia[2], collpair->normal, w3 * impulse);
+  if (data->collmd) {
+    impulse->active = cloth_collision_response_pair(
+        data, &data->collisions[index], impulse->impulse);
+  }
+  else {
+    impulse->active = cloth_selfcollision_response_pair(
+        data, &data->collisions[index], impulse->impulse);
+  }
+}
 
-      VECADDMUL(ib[0], collpair->normal, u1 * -impulse);
-      VECADDMUL(ib[1], collpair->normal, u2 * -impulse);
-      VECADDMUL(ib[2], collpair->normal, u3 * -impulse);
+/**
+ * Compute the impulses of all pairs in parallel, then accumulate them on the vertices in the
+ * order of the pairs, so the result is the same as when handling the pairs one by one.
+ */
+static int cloth_collision_response_apply(CollisionResponseData *data,
+                                          const uint collision_count,
+                                          const float clamp_sq,
+                                          const int verts_num)
+{
+  ClothVertex *verts = data->clmd->clothObject->verts;
+  int result = 0;
 
-      result = 1;
-    }
+  data->impulses = MEM_mallocN(sizeof(*data->impulses) * collision_count, __func__);
 
-    if (result) {
-      cloth_collision_impulse_vert(clamp_sq, ia[0], &cloth->verts[collpair->ap1]);
-      cloth_collision_impulse_vert(clamp_sq, ia[1], &cloth->verts[collpair->ap2]);
-      cloth_collision_impulse_vert(clamp_sq, ia[2], &cloth->verts[collpair->ap3]);
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = true;
+  BLI_task_parallel_range(0, collision_count, data, cloth_collision_response_task, &settings);
 
-      cloth_collision_impulse_vert(clamp_sq, ib[0], &cloth->verts[collpair->bp1]);
-      cloth_collision_impulse_vert(clamp_sq, ib[1], &cloth->verts[collpair->bp2]);
-      cloth_collision_impulse_vert(clamp_sq, ib[2], &cloth->verts[collpair->bp3]);
+  for (uint i = 0; i < collision_count; i++) {
+    const CollPairImpulse *impulse = &data->impulses[i];
+    if (!impulse->active) {
+      continue;
+    }
+    const CollPair *collpair = &data->collisions[i];
+    const int pair_verts[6] = {collpair->ap1,
+                               collpair->ap2,
+                               collpair->ap3,
+                               collpair->bp1,
+                               collpair->bp2,
+                               collpair->bp3};
+    for (int j = 0; j < verts_num; j++) {
+      cloth_collision_impulse_vert(clamp_sq, impulse->impulse[j], &verts[pair_verts[j]]);
     }
+    result = 1;
   }
 
+  MEM_freeN(data->impulses);
+  data->impulses = NULL;
+
   return result;
 }
 
+static int cloth_collision_response_static(ClothModifierData *clmd,
+                                           CollisionModifierData *collmd,
+                                           Object *collob,
+                                           CollPair *collpair,
+                                           uint collision_count,
+                                           const float dt)
+{
+  const float epsilon2 = BLI_bvhtree_get_epsilon(collmd->bvhtree);
+
+  CollisionResponseData data = {
+      .clmd = clmd,
+      .collmd = collmd,
+      .collob = collob,
+      .collisions = collpair,
+      .time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale),
+      .min_distance = (clmd->coll_parms->epsilon + epsilon2) * (8.0f / 9.0f),
+  };
+
+  const int verts_num = (clmd->hairdata != NULL) ? 2 : 3;
+  return cloth_collision_response_apply(
+      &data, collision_count, square_f(clmd->coll_parms->clamp * dt), verts_num);
+}
+
+static int cloth_selfcollision_response_static(ClothModifierData *clmd,
+                                               CollPair *collpair,
+                                               uint collision_count,
+                                               const float dt)
+{
+  CollisionResponseData data = {
+      .clmd = clmd,
+      .collisions = collpair,
+      .time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale),
+      .min_distance = (2.0f * clmd->coll_parms->selfepsilon) * (8.0f / 9.0f),
+  };
+
+  return cloth_collision_response_apply(
+      &data, collision_count, square_f(clmd->coll_parms->self_clamp * dt), 6);
+}
+
 #ifdef __GNUC__
 #  pragma GCC diagnostic pop
 #endif
@@ -421,25 +421,17 @@ static void curve_deform_coords_impl(const Object *ob_curve,
 #undef DEFORM_OP_CLAMPED
   }
   else {
-    if (cu->flag & CU_DEFORM_BOUNDS_OFF) {
-      for (a = 0; a < vert_coords_len; a++) {
-        mul_m4_v3(cd.curvespace, vert_coords[a]);
-        calc_curve_deform(ob_curve, vert_coords[a], defaxis, &cd, NULL);
-        mul_m4_v3(cd.objectspace, vert_coords[a]);
-      }
+    mul_m4_v3_array(cd.curvespace, vert_coords, vert_coords_len);
+
+    if ((cu->flag & CU_DEFORM_BOUNDS_OFF) == 0) {
+      minmax_v3v3_v3_array(cd.dmin, cd.dmax, (const float(*)[3])vert_coords, vert_coords_len);
     }
-    else {
-      for (a = 0; a < vert_coords_len; a++) {
-        mul_m4_v3(cd.curvespace, vert_coords[a]);
-        minmax_v3v3_v3(cd.dmin, cd.dmax, vert_coords[a]);
-      }
 
-      for (a = 0; a < vert_coords_len; a++) {
-        /* already in 'cd.curvespace', prev for loop */
-        calc_curve_deform(ob_curve, vert_coords[a], defaxis, &cd, NULL);
-        mul_m4_v3(cd.objectspace, vert_coords[a]);
-      }
+    for (a = 0; a < vert_coords_len; a++) {
+      calc_curve_deform(ob_curve, vert_coords[a], defaxis, &cd, NULL);
     }
+
+    mul_m4_v3_array(cd.objectspace, vert_coords, vert_coords_len);
   }
 }
 
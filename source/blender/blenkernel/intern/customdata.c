@@ -2305,11 +2305,15 @@ int CustomData_get_layer_index_n(const struct CustomData *data, int type, int n)
 
 int CustomData_get_named_layer_index(const CustomData *data, int type, const char *name)
 {
-  for (int i = 0; i < data->totlayer; i++) {
-    if (data->layers[i].type == type) {
-      if (STREQ(data->layers[i].name, name)) {
-        return i;
-      }
+  /* Layers are ordered by type, only check the ones of given type. */
+  BLI_assert(customdata_typemap_is_valid(data));
+  const int layer_index = data->typemap[type];
+  if (layer_index == -1) {
+    return -1;
+  }
+  for (int i = layer_index; i < data->totlayer && data->layers[i].type == type; i++) {
+    if (STREQ(data->layers[i].name, name)) {
+      return i;
     }
   }
 
@@ -3626,7 +3630,10 @@ void CustomData_bmesh_free_block_data(CustomData *data, void *block)
   }
 }
 
-static void CustomData_bmesh_alloc_block(CustomData *data, void **block)
+/**
+ * Allocate a block (freeing the existing one), without initializing its layers.
+ */
+void CustomData_bmesh_alloc_block(CustomData *data, void **block)
 {
   if (*block) {
     CustomData_bmesh_free_block(data, block);
@@ -3759,6 +3766,132 @@ void CustomData_bmesh_copy_data(const CustomData *source,
   CustomData_bmesh_copy_data_exclude_by_type(source, dest, src_block, dest_block, 0);
 }
 
+/** A single operation of a #CustomDataBMeshCopyMap, on a range of bytes of the blocks. */
+typedef struct CustomDataBMeshCopyOp {
+  /** Offset in the source block, -1 to set the default value of the layer. */
+  int src_offset;
+  int dst_offset;
+  /** Size in bytes, may span multiple layers which are copied with a plain memory copy. */
+  int size;
+  /** Copy callback of the layer type, or its default value callback when there is no source. */
+  cd_copy copy;
+  void (*set_default)(void *data, int count);
+} CustomDataBMeshCopyOp;
+
+struct CustomDataBMeshCopyMap {
+  CustomDataBMeshCopyOp *ops;
+  int ops_len;
+};
+
+static void customdata_bmesh_copy_map_add(CustomDataBMeshCopyMap *map,
+                                          const LayerTypeInfo *typeInfo,
+                                          const int src_offset,
+                                          const int dst_offset)
+{
+  const bool is_default = (src_offset == -1);
+  const bool is_trivial = is_default ? (typeInfo->set_default == NULL) : (typeInfo->copy == NULL);
+
+  if (is_trivial && map->ops_len > 0) {
+    /* Merge with the previous operation when both are contiguous memory copies or clears. */
+    CustomDataBMeshCopyOp *op_prev = &map->ops[map->ops_len - 1];
+    if (op_prev->copy == NULL && op_prev->set_default == NULL &&
+        op_prev->dst_offset + op_prev->size == dst_offset &&
+        (is_default ? (op_prev->src_offset == -1) :
+                      (op_prev->src_offset != -1 &&
+                       op_prev->src_offset + op_prev->size == src_offset))) {
+      op_prev->size += typeInfo->size;
+      return;
+    }
+  }
+
+  CustomDataBMeshCopyOp *op = &map->ops[map->ops_len++];
+  op->src_offset = src_offset;
+  op->dst_offset = dst_offset;
+  op->size = typeInfo->size;
+  op->copy = is_default ? NULL : typeInfo->copy;
+  op->set_default = is_default ? typeInfo->set_default : NULL;
+}
+
+/**
+ * Precompute how the layers of \a source blocks are copied to \a dest blocks, to copy the
+ * blocks of many elements without matching their layers again for each element.
+ * The layers are matched the same way as #CustomData_bmesh_copy_data_exclude_by_type, which
+ * gives the same result as #CustomData_bmesh_copy_block_with_map on a new block.
+ */
+CustomDataBMeshCopyMap *CustomData_bmesh_copy_map_new(const CustomData *source,
+                                                      const CustomData *dest,
+                                                      const CustomDataMask mask_exclude)
+{
+  CustomDataBMeshCopyMap *map = MEM_mallocN(sizeof(*map), __func__);
+  map->ops = MEM_malloc_arrayN((size_t)max_ii(dest->totlayer, 1), sizeof(*map->ops), __func__);
+  map->ops_len = 0;
+
+  int dest_i = 0;
+  for (int src_i = 0; src_i < source->totlayer && dest_i < dest->totlayer; src_i++) {
+    while (dest_i < dest->totlayer && dest->layers[dest_i].type < source->layers[src_i].type) {
+      customdata_bmesh_copy_map_add(
+          map, layerType_getInfo(dest->layers[dest_i].type), -1, dest->layers[dest_i].offset);
+      dest_i++;
+    }
+    if (dest_i >= dest->totlayer) {
+      break;
+    }
+    if (dest->layers[dest_i].type == source->layers[src_i].type &&
+        STREQ(dest->layers[dest_i].name, source->layers[src_i].name)) {
+      if ((CD_TYPE_AS_MASK(dest->layers[dest_i].type) & mask_exclude) == 0) {
+        customdata_bmesh_copy_map_add(map,
+                                      layerType_getInfo(source->layers[src_i].type),
+                                      source->layers[src_i].offset,
+                                      dest->layers[dest_i].offset);
+      }
+      dest_i++;
+    }
+  }
+  for (; dest_i < dest->totlayer; dest_i++) {
+    customdata_bmesh_copy_map_add(
+        map, layerType_getInfo(dest->layers[dest_i].type), -1, dest->layers[dest_i].offset);
+  }
+
+  return map;
+}
+
+void CustomData_bmesh_copy_map_free(CustomDataBMeshCopyMap *map)
+{
+  MEM_freeN(map->ops);
+  MEM_freeN(map);
+}
+
+/**
+ * Copy \a src_block into \a dst_block (which has to be allocated already) using a map from
+ * #CustomData_bmesh_copy_map_new.
+ */
+void CustomData_bmesh_copy_block_with_map(const CustomDataBMeshCopyMap *map,
+                                          const void *src_block,
+                                          void *dst_block)
+{
+  for (int i = 0; i < map->ops_len; i++) {
+    const CustomDataBMeshCopyOp *op = &map->ops[i];
+    void *dst_data = POINTER_OFFSET(dst_block, op->dst_offset);
+    if (op->src_offset == -1) {
+      if (op->set_default) {
+        op->set_default(dst_data, 1);
+      }
+      else {
+        memset(dst_data, 0, (size_t)op->size);
+      }
+    }
+    else {
+      const void *src_data = POINTER_OFFSET(src_block, op->src_offset);
+      if (op->copy) {
+        op->copy(src_data, dst_data, 1);
+      }
+      else {
+        memcpy(dst_data, src_data, (size_t)op->size);
+      }
+    }
+  }
+}
+
 /* BMesh Custom Data Functions.
  * Should replace edit-mesh ones with these as well, due to more efficient memory alloc.
  */
@@ -40,6 +40,7 @@
 #include "BLI_memarena.h"
 #include "BLI_scanfill.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_anim_path.h"
@@ -1525,6 +1526,265 @@ static void calc_bevfac_mapping(Curve *cu,
   }
 }
 
+static void curve_bevel_spline_to_displist(Depsgraph *depsgraph,
+                                           Scene *scene,
+                                           Curve *cu,
+                                           const ListBase *dlbev,
+                                           const float widfac,
+                                           BevList *bl,
+                                           Nurb *nu,
+                                           ListBase *dispbase)
+{
+  float *data;
+
+  if (bl->nr == 0) { /* blank bevel lists can happen */
+    return;
+  }
+
+  /* exception handling; curve without bevel or extrude, with width correction */
+  if (BLI_listbase_is_empty(dlbev)) {
+    DispList *dl = MEM_callocN(sizeof(DispList), "makeDispListbev");
+    dl->verts = MEM_mallocN(sizeof(float[3]) * bl->nr, "dlverts");
+    BLI_addtail(dispbase, dl);
+
+    if (bl->poly != -1) {
+      dl->type = DL_POLY;
+    }
+    else {
+      dl->type = DL_SEGM;
+      dl->flag = (DL_FRONT_CURVE | DL_BACK_CURVE);
+    }
+
+    dl->parts = 1;
+    dl->nr = bl->nr;
+    dl->col = nu->mat_nr;
+    dl->charidx = nu->charidx;
+
+    /* dl->rt will be used as flag for render face and */
+    /* CU_2D conflicts with R_NOPUNOFLIP */
+    dl->rt = nu->flag & ~CU_2D;
+
+    int a = dl->nr;
+    BevPoint *bevp = bl->bevpoints;
+    data = dl->verts;
+    while (a--) {
+      data[0] = bevp->vec[0] + widfac * bevp->sina;
+      data[1] = bevp->vec[1] + widfac * bevp->cosa;
+      data[2] = bevp->vec[2];
+      bevp++;
+      data += 3;
+    }
+  }
+  else {
+    ListBase bottom_capbase = {NULL, NULL};
+    ListBase top_capbase = {NULL, NULL};
+    float bottom_no[3] = {0.0f};
+    float top_no[3] = {0.0f};
+    float first_blend = 0.0f, last_blend = 0.0f;
+    int start, steps = 0;
+
+    if (nu->flagu & CU_NURB_CYCLIC) {
+      calc_bevfac_mapping_default(bl, &start, &first_blend, &steps, &last_blend);
+    }
+    else {
+      if (fabsf(cu->bevfac2 - cu->bevfac1) < FLT_EPSILON) {
+        return;
+      }
+
+      calc_bevfac_mapping(cu, bl, nu, &start, &first_blend, &steps, &last_blend);
+    }
+
+    LISTBASE_FOREACH (DispList *, dlb, dlbev) {
+      /* for each part of the bevel use a separate displblock */
+      DispList *dl = MEM_callocN(sizeof(DispList), "makeDispListbev1");
+      dl->verts = data = MEM_mallocN(sizeof(float[3]) * dlb->nr * steps, "dlverts");
+      BLI_addtail(dispbase, dl);
+
+      dl->type = DL_SURF;
+
+      dl->flag = dlb->flag & (DL_FRONT_CURVE | DL_BACK_CURVE);
+      if (dlb->type == DL_POLY) {
+        dl->flag |= DL_CYCL_U;
+      }
+      if ((bl->poly >= 0) && (steps > 2)) {
+        dl->flag |= DL_CYCL_V;
+      }
+
+      dl->parts = steps;
+      dl->nr = dlb->nr;
+      dl->col = nu->mat_nr;
+      dl->charidx = nu->charidx;
+
+      /* dl->rt will be used as flag for render face and */
+      /* CU_2D conflicts with R_NOPUNOFLIP */
+      dl->rt = nu->flag & ~CU_2D;
+
+      dl->bevel_split = BLI_BITMAP_NEW(steps, "bevel_split");
+
+      /* for each point of poly make a bevel piece */
+      BevPoint *bevp_first = bl->bevpoints;
+      BevPoint *bevp_last = &bl->bevpoints[bl->nr - 1];
+      BevPoint *bevp = &bl->bevpoints[start];
+      for (int i = start, a = 0; a < steps; i++, bevp++, a++) {
+        float radius_factor = 1.0;
+        float *cur_data = data;
+
+        if (cu->taperobj == NULL) {
+          radius_factor = bevp->radius;
+        }
+        else {
+          float taper_factor;
+          if (cu->flag & CU_MAP_TAPER) {
+            float len = (steps - 3) + first_blend + last_blend;
+
+            if (a == 0) {
+              taper_factor = 0.0f;
+            }
+            else if (a == steps - 1) {
+              taper_factor = 1.0f;
+            }
+            else {
+              taper_factor = ((float)a - (1.0f - first_blend)) / len;
+            }
+          }
+          else {
+            float len = bl->nr - 1;
+            taper_factor = (float)i / len;
+
+            if (a == 0) {
+              taper_factor += (1.0f - first_blend) / len;
+            }
+            else if (a == steps - 1) {
+              taper_factor -= (1.0f - last_blend) / len;
+            }
+          }
+
+          radius_factor = displist_calc_taper(depsgraph, scene, cu->taperobj, taper_factor);
+        }
+
+        if (bevp->split_tag) {
+          BLI_BITMAP_ENABLE(dl->bevel_split, a);
+        }
+
+        /* rotate bevel piece and write in data */
+        if ((a == 0) && (bevp != bevp_last)) {
+          rotateBevelPiece(
+              cu, bevp, bevp + 1, dlb, 1.0f - first_blend, widfac, radius_factor, &data);
+        }
+        else if ((a == steps - 1) && (bevp != bevp_first)) {
+          rotateBevelPiece(
+              cu, bevp, bevp - 1, dlb, 1.0f - last_blend, widfac, radius_factor, &data);
+        }
+        else {
+          rotateBevelPiece(cu, bevp, NULL, dlb, 0.0f, widfac, radius_factor, &data);
+        }
+
+        if ((cu->flag & CU_FILL_CAPS) && !(nu->flagu & CU_NURB_CYCLIC)) {
+          if (a == 1) {
+            fillBevelCap(nu, dlb, cur_data - 3 * dlb->nr, &bottom_capbase);
+            copy_v3_v3(bottom_no, bevp->dir);
+          }
+          if (a == steps - 1) {
+            fillBevelCap(nu, dlb, cur_data, &top_capbase);
+            negate_v3_v3(top_no, bevp->dir);
+          }
+        }
+      }
+
+      /* gl array drawing: using indices */
+      displist_surf_indices(dl);
+    }
+
+    if (bottom_capbase.first) {
+      BKE_displist_fill(&bottom_capbase, dispbase, bottom_no, false);
+      BKE_displist_fill(&top_capbase, dispbase, top_no, false);
+      BKE_displist_free(&bottom_capbase);
+      BKE_displist_free(&top_capbase);
+    }
+  }
+}
+
+typedef struct CurveBevelSplinesData {
+  Depsgraph *depsgraph;
+  Scene *scene;
+  Curve *cu;
+  const ListBase *dlbev;
+  float widfac;
+  BevList **bevlists;
+  Nurb **nurbs;
+  /** Display lists of every spline, joined in order once all are done. */
+  ListBase *dispbases;
+} CurveBevelSplinesData;
+
+static void curve_bevel_spline_to_displist_cb(void *__restrict userdata,
+                                              const int i,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  CurveBevelSplinesData *data = userdata;
+  curve_bevel_spline_to_displist(data->depsgraph,
+                                 data->scene,
+                                 data->cu,
+                                 data->dlbev,
+                                 data->widfac,
+                                 data->bevlists[i],
+                                 data->nurbs[i],
+                                 &data->dispbases[i]);
+}
+
+/**
+ * Splines are bevelled independently of each other, so do that in parallel
+ * and join the results in the order of the splines.
+ */
+static void curve_bevel_to_displist(Depsgraph *depsgraph,
+                                    Scene *scene,
+                                    Curve *cu,
+                                    ListBase *bev,
+                                    ListBase *nubase,
+                                    const ListBase *dlbev,
+                                    ListBase *dispbase)
+{
+  const int splines_len = min_ii(BLI_listbase_count(bev), BLI_listbase_count(nubase));
+  if (splines_len == 0) {
+    return;
+  }
+
+  if (cu->taperobj != NULL) {
+    /* Make sure the taper curve is evaluated before reading it from multiple threads. */
+    displist_calc_taper(depsgraph, scene, cu->taperobj, 0.0f);
+  }
+
+  CurveBevelSplinesData data = {
+      .depsgraph = depsgraph,
+      .scene = scene,
+      .cu = cu,
+      .dlbev = dlbev,
+      .widfac = cu->width - 1.0f,
+      .bevlists = MEM_malloc_arrayN(splines_len, sizeof(BevList *), __func__),
+      .nurbs = MEM_malloc_arrayN(splines_len, sizeof(Nurb *), __func__),
+      .dispbases = MEM_calloc_arrayN(splines_len, sizeof(ListBase), __func__),
+  };
+
+  BevList *bl = bev->first;
+  Nurb *nu = nubase->first;
+  for (int i = 0; i < splines_len; i++, bl = bl->next, nu = nu->next) {
+    data.bevlists[i] = bl;
+    data.nurbs[i] = nu;
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (splines_len > 1);
+  BLI_task_parallel_range(0, splines_len, &data, curve_bevel_spline_to_displist_cb, &settings);
+
+  for (int i = 0; i < splines_len; i++) {
+    BLI_movelisttolist(dispbase, &data.dispbases[i]);
+  }
+
+  MEM_freeN(data.bevlists);
+  MEM_freeN(data.nurbs);
+  MEM_freeN(data.dispbases);
+}
+
 static void do_makeDispListCurveTypes(Depsgraph *depsgraph,
                                       Scene *scene,
                                       Object *ob,
@@ -1582,179 +1842,8 @@ static void do_makeDispListCurveTypes(Depsgraph *depsgraph,
       curve_to_displist(cu, &nubase, dispbase, for_render);
     }
     else {
-      const float widfac = cu->width - 1.0f;
-      BevList *bl = ob->runtime.curve_cache->bev.first;
-      Nurb *nu = nubase.first;
-
-      for (; bl && nu; bl = bl->next, nu = nu->next) {
-        float *data;
-
-        if (bl->nr == 0) { /* blank bevel lists can happen */
-          continue;
-        }
-
-        /* exception handling; curve without bevel or extrude, with width correction */
-        if (BLI_listbase_is_empty(&dlbev)) {
-          DispList *dl = MEM_callocN(sizeof(DispList), "makeDispListbev");
-          dl->verts = MEM_mallocN(sizeof(float[3]) * bl->nr, "dlverts");
-          BLI_addtail(dispbase, dl);
-
-          if (bl->poly != -1) {
-            dl->type = DL_POLY;
-          }
-          else {
-            dl->type = DL_SEGM;
-            dl->flag = (DL_FRONT_CURVE | DL_BACK_CURVE);
-          }
-
-          dl->parts = 1;
-          dl->nr = bl->nr;
-          dl->col = nu->mat_nr;
-          dl->charidx = nu->charidx;
-
-          /* dl->rt will be used as flag for render face and */
-          /* CU_2D conflicts with R_NOPUNOFLIP */
-          dl->rt = nu->flag & ~CU_2D;
-
-          int a = dl->nr;
-          BevPoint *bevp = bl->bevpoints;
-          data = dl->verts;
-          while (a--) {
-            data[0] = bevp->vec[0] + widfac * bevp->sina;
-            data[1] = bevp->vec[1] + widfac * bevp->cosa;
-            data[2] = bevp->vec[2];
-            bevp++;
-            data += 3;
-          }
-        }
-        else {
-          ListBase bottom_capbase = {NULL, NULL};
-          ListBase top_capbase = {NULL, NULL};
-          float bottom_no[3] = {0.0f};
-          float top_no[3] = {0.0f};
-          float first_blend = 0.0f, last_blend = 0.0f;
-          int start, steps = 0;
-
-          if (nu->flagu & CU_NURB_CYCLIC) {
-            calc_bevfac_mapping_default(bl, &start, &first_blend, &steps, &last_blend);
-          }
-          else {
-            if (fabsf(cu->bevfac2 - cu->bevfac1) < FLT_EPSILON) {
-              continue;
-            }
-
-            calc_bevfac_mapping(cu, bl, nu, &start, &first_blend, &steps, &last_blend);
-          }
-
-          LISTBASE_FOREACH (DispList *, dlb, &dlbev) {
-            /* for each part of the bevel use a separate displblock */
-            DispList *dl = MEM_callocN(sizeof(DispList), "makeDispListbev1");
-            dl->verts = data = MEM_mallocN(sizeof(float[3]) * dlb->nr * steps, "dlverts");
-            BLI_addtail(dispbase, dl);
-
-            dl->type = DL_SURF;
-
-            dl->flag = dlb->flag & (DL_FRONT_CURVE | DL_BACK_CURVE);
-            if (dlb->type == DL_POLY) {
-              dl->flag |= DL_CYCL_U;
-            }
-            if ((bl->poly >= 0) && (steps > 2)) {
-              dl->flag |= DL_CYCL_V;
-            }
-
-            dl->parts = steps;
-            dl->nr = dlb->nr;
-            dl->col = nu->mat_nr;
-            dl->charidx = nu->charidx;
-
-            /* dl->rt will be used as flag for render face and */
-            /* CU_2D conflicts with R_NOPUNOFLIP */
-            dl->rt = nu->flag & ~CU_2D;
-
-            dl->bevel_split = BLI_BITMAP_NEW(steps, "bevel_split");
-
-            /* for each point of poly make a bevel piece */
-            BevPoint *bevp_first = bl->bevpoints;
-            BevPoint *bevp_last = &bl->bevpoints[bl->nr - 1];
-            BevPoint *bevp = &bl->bevpoints[start];
-            for (int i = start, a = 0; a < steps; i++, bevp++, a++) {
-              float radius_factor = 1.0;
-              float *cur_data = data;
-
-              if (cu->taperobj == NULL) {
-                radius_factor = bevp->radius;
-              }
-              else {
-                float taper_factor;
-                if (cu->flag & CU_MAP_TAPER) {
-                  float len = (steps - 3) + first_blend + last_blend;
-
-                  if (a == 0) {
-                    taper_factor = 0.0f;
-                  }
-                  else if (a == steps - 1) {
-                    taper_factor = 1.0f;
-                  }
-                  else {
-                    taper_factor = ((float)a - (1.0f - first_blend)) / len;
-                  }
-                }
-                else {
-                  float len = bl->nr - 1;
-                  taper_factor = (float)i / len;
-
-                  if (a == 0) {
-                    taper_factor += (1.0f - first_blend) / len;
-                  }
-                  else if (a == steps - 1) {
-                    taper_factor -= (1.0f - last_blend) / len;
-                  }
-                }
-
-                radius_factor = displist_calc_taper(depsgraph, scene, cu->taperobj, taper_factor);
-              }
-
-              if (bevp->split_tag) {
-                BLI_BITMAP_ENABLE(dl->bevel_split, a);
-              }
-
-              /* rotate bevel piece and write in data */
-              if ((a == 0) && (bevp != bevp_last)) {
-                rotateBevelPiece(
-                    cu, bevp, bevp + 1, dlb, 1.0f - first_blend, widfac, radius_factor, &data);
-              }
-              else if ((a == steps - 1) && (bevp != bevp_first)) {
-                rotateBevelPiece(
-                    cu, bevp, bevp - 1, dlb, 1.0f - last_blend, widfac, radius_factor, &data);
-              }
-              else {
-                rotateBevelPiece(cu, bevp, NULL, dlb, 0.0f, widfac, radius_factor, &data);
-              }
-
-              if ((cu->flag & CU_FILL_CAPS) && !(nu->flagu & CU_NURB_CYCLIC)) {
-                if (a == 1) {
-                  fillBevelCap(nu, dlb, cur_data - 3 * dlb->nr, &bottom_capbase);
-                  copy_v3_v3(bottom_no, bevp->dir);
-                }
-                if (a == steps - 1) {
-                  fillBevelCap(nu, dlb, cur_data, &top_capbase);
-                  negate_v3_v3(top_no, bevp->dir);
-                }
-              }
-            }
-
-            /* gl array drawing: using indices */
-            displist_surf_indices(dl);
-          }
-
-          if (bottom_capbase.first) {
-            BKE_displist_fill(&bottom_capbase, dispbase, bottom_no, false);
-            BKE_displist_fill(&top_capbase, dispbase, top_no, false);
-            BKE_displist_free(&bottom_capbase);
-            BKE_displist_free(&top_capbase);
-          }
-        }
-      }
+      curve_bevel_to_displist(
+          depsgraph, scene, cu, &ob->runtime.curve_cache->bev, &nubase, &dlbev, dispbase);
       BKE_displist_free(&dlbev);
     }
 
@@ -3922,7 +3922,8 @@ typedef struct DynamicPaintPaintData {
   Object *brushOb;
   const Scene *scene;
   const float timescale;
-  const int c_index;
+  /** Surface points to process, gathered from all grid cells the brush intersects. */
+  const int *points;
 
   Mesh *mesh;
   const MVert *mvert;
@@ -3940,6 +3941,22 @@ typedef struct DynamicPaintPaintData {
   float *pointCoord;
 } DynamicPaintPaintData;
 
+/**
+ * Append the surface points of a grid cell to \a r_points, so the points of all cells a brush
+ * intersects can be processed in one parallel loop instead of one (often serial) loop per cell.
+ * \return The new number of points in \a r_points.
+ */
+static int grid_cell_points_append(const VolumeGrid *grid,
+                                   const int c_index,
+                                   int *r_points,
+                                   const int points_num)
+{
+  memcpy(&r_points[points_num],
+         &grid->t_index[grid->s_pos[c_index]],
+         sizeof(*r_points) * grid->s_num[c_index]);
+  return points_num + grid->s_num[c_index];
+}
+
 /*
  * Paint a brush object mesh to the surface
  */
@@ -3951,12 +3968,10 @@ static void dynamic_paint_paint_mesh_cell_point_cb_ex(
   const DynamicPaintSurface *surface = data->surface;
   const PaintSurfaceData *sData = surface->data;
   const PaintBakeData *bData = sData->bData;
-  VolumeGrid *grid = bData->grid;
 
   const DynamicPaintBrushSettings *brush = data->brush;
 
   const float timescale = data->timescale;
-  const int c_index = data->c_index;
 
   const MVert *mvert = data->mvert;
   const MLoop *mloop = data->mloop;
@@ -3967,7 +3982,7 @@ static void dynamic_paint_paint_mesh_cell_point_cb_ex(
 
   BVHTreeFromMesh *treeData = data->treeData;
 
-  const int index = grid->t_index[grid->s_pos[c_index] + id];
+  const int index = data->points[id];
   const int samples = bData->s_num[index];
   int ss;
   float total_sample = (float)samples;
@@ -4345,41 +4360,43 @@ static bool dynamicPaint_paintMesh(Depsgraph *depsgraph,
       if (BKE_bvhtree_from_mesh_get(&treeData, mesh, BVHTREE_FROM_LOOPTRI, 4)) {
         int c_index;
         int total_cells = grid->dim[0] * grid->dim[1] * grid->dim[2];
+        int *points = MEM_mallocN(sizeof(*points) * sData->total_points, __func__);
+        int points_num = 0;
 
-        /* loop through space partitioning grid */
+        /* gather points of the grid cells the brush bounding box intersects */
         for (c_index = 0; c_index < total_cells; c_index++) {
           /* check grid cell bounding box */
           if (!grid->s_num[c_index] ||
               !meshBrush_boundsIntersect(&grid->bounds[c_index], &mesh_bb, brush, brush_radius)) {
             continue;
           }
-
-          /* loop through cell points and process brush */
-          DynamicPaintPaintData data = {
-              .surface = surface,
-              .brush = brush,
-              .brushOb = brushOb,
-              .scene = scene,
-              .timescale = timescale,
-              .c_index = c_index,
-              .mesh = mesh,
-              .mvert = mvert,
-              .mloop = mloop,
-              .mlooptri = mlooptri,
-              .brush_radius = brush_radius,
-              .avg_brushNor = avg_brushNor,
-              .brushVelocity = brushVelocity,
-              .treeData = &treeData,
-          };
-          TaskParallelSettings settings;
-          BLI_parallel_range_settings_defaults(&settings);
-          settings.use_threading = (grid->s_num[c_index] > 250);
-          BLI_task_parallel_range(0,
-                                  grid->s_num[c_index],
-                                  &data,
-                                  dynamic_paint_paint_mesh_cell_point_cb_ex,
-                                  &settings);
+          points_num = grid_cell_points_append(grid, c_index, points, points_num);
         }
+
+        /* loop through gathered points and process brush */
+        DynamicPaintPaintData data = {
+            .surface = surface,
+            .brush = brush,
+            .brushOb = brushOb,
+            .scene = scene,
+            .timescale = timescale,
+            .points = points,
+            .mesh = mesh,
+            .mvert = mvert,
+            .mloop = mloop,
+            .mlooptri = mlooptri,
+            .brush_radius = brush_radius,
+            .avg_brushNor = avg_brushNor,
+            .brushVelocity = brushVelocity,
+            .treeData = &treeData,
+        };
+        TaskParallelSettings settings;
+        BLI_parallel_range_settings_defaults(&settings);
+        settings.use_threading = (points_num > 250);
+        BLI_task_parallel_range(
+            0, points_num, &data, dynamic_paint_paint_mesh_cell_point_cb_ex, &settings);
+
+        MEM_freeN(points);
       }
     }
     /* free bvh tree */
@@ -4406,14 +4423,12 @@ static void dynamic_paint_paint_particle_cell_point_cb_ex(
   const DynamicPaintSurface *surface = data->surface;
   const PaintSurfaceData *sData = surface->data;
   const PaintBakeData *bData = sData->bData;
-  VolumeGrid *grid = bData->grid;
 
   const DynamicPaintBrushSettings *brush = data->brush;
 
   const ParticleSystem *psys = data->psys;
 
   const float timescale = data->timescale;
-  const int c_index = data->c_index;
 
   KDTree_3d *tree = data->treeData;
 
@@ -4422,7 +4437,7 @@ static void dynamic_paint_paint_particle_cell_point_cb_ex(
   const float range = solidradius + smooth;
   const float particle_timestep = 0.04f * psys->part->timetweak;
 
-  const int index = grid->t_index[grid->s_pos[c_index] + id];
+  const int index = data->points[id];
   float disp_intersect = 0.0f;
   float radius = 0.0f;
   float strength = 0.0f;
@@ -4648,36 +4663,38 @@ static bool dynamicPaint_paintParticles(DynamicPaintSurface *surface,
   if (boundsIntersectDist(&grid->grid_bounds, &part_bb, range)) {
     int c_index;
     int total_cells = grid->dim[0] * grid->dim[1] * grid->dim[2];
+    int *points = MEM_mallocN(sizeof(*points) * sData->total_points, __func__);
+    int points_num = 0;
 
     /* balance tree */
     BLI_kdtree_3d_balance(tree);
 
-    /* loop through space partitioning grid */
+    /* gather points of the grid cells close enough to the particles */
     for (c_index = 0; c_index < total_cells; c_index++) {
       /* check cell bounding box */
       if (!grid->s_num[c_index] || !boundsIntersectDist(&grid->bounds[c_index], &part_bb, range)) {
         continue;
       }
-
-      /* loop through cell points */
-      DynamicPaintPaintData data = {
-          .surface = surface,
-          .brush = brush,
-          .psys = psys,
-          .solidradius = solidradius,
-          .timescale = timescale,
-          .c_index = c_index,
-          .treeData = tree,
-      };
-      TaskParallelSettings settings;
-      BLI_parallel_range_settings_defaults(&settings);
-      settings.use_threading = (grid->s_num[c_index] > 250);
-      BLI_task_parallel_range(0,
-                              grid->s_num[c_index],
-                              &data,
-                              dynamic_paint_paint_particle_cell_point_cb_ex,
-                              &settings);
+      points_num = grid_cell_points_append(grid, c_index, points, points_num);
     }
+
+    /* loop through gathered points */
+    DynamicPaintPaintData data = {
+        .surface = surface,
+        .brush = brush,
+        .psys = psys,
+        .solidradius = solidradius,
+        .timescale = timescale,
+        .points = points,
+        .treeData = tree,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (points_num > 250);
+    BLI_task_parallel_range(
+        0, points_num, &data, dynamic_paint_paint_particle_cell_point_cb_ex, &settings);
+
+    MEM_freeN(points);
   }
   BLI_kdtree_3d_free(tree);
 
@@ -80,6 +80,8 @@
 #  include "DEG_depsgraph.h"
 #  include "DEG_depsgraph_query.h"
 
+#  include "PIL_time.h"
+
 #  include "RE_texture.h"
 
 #  include "CLG_log.h"
@@ -3588,6 +3590,10 @@ static int manta_step(
   int mode = fds->cache_type;
   bool mode_replay = (mode == FLUID_DOMAIN_CACHE_REPLAY);
 
+  /* Time spent in the solver, reported with `--log "bke.fluid" --log-level 1`. */
+  double solve_time = 0.0;
+  int solve_steps = 0;
+
   /* Update object state. */
   invert_m4_m4(fds->imat, ob->obmat);
   copy_m4_m4(fds->obmat, ob->obmat);
@@ -3640,7 +3646,11 @@ static int manta_step(
     /* Only bake if the domain is bigger than one cell (important for adaptive domain). */
     if (fds->total_cells > 1) {
       update_effectors(depsgraph, scene, ob, fds, dt);
+
+      const double step_start = PIL_check_seconds_timer();
       manta_bake_data(fds->fluid, fmd, frame);
+      solve_time += PIL_check_seconds_timer() - step_start;
+      solve_steps++;
     }
 
     /* Count for how long this while loop is running. */
@@ -3651,6 +3661,8 @@ static int manta_step(
     fds->time_total = time_total;
   }
 
+  CLOG_INFO(&LOG, 1, "Frame %d: %d solver steps in %.3f s", frame, solve_steps, solve_time);
+
   /* Total time must not exceed framecount times framelength. Correct tiny errors here. */
   CLAMP_MAX(fds->time_total, time_total_old + fds->frame_length);
 
@@ -4114,17 +4126,31 @@ static void BKE_fluid_modifier_processDomain(FluidModifierData *fmd,
     if (baking_data) {
       /* Only save baked data if all of it completed successfully. */
       if (manta_step(depsgraph, scene, ob, me, fmd, scene_framenr)) {
+        const double write_start = PIL_check_seconds_timer();
         manta_write_config(fds->fluid, fmd, scene_framenr);
         manta_write_data(fds->fluid, fmd, scene_framenr);
+        CLOG_INFO(&LOG,
+                  1,
+                  "Frame %d: data cache written in %.3f s",
+                  scene_framenr,
+                  PIL_check_seconds_timer() - write_start);
       }
     }
     if (has_data || baking_data) {
       if (baking_noise && with_smoke && with_noise) {
         /* Ensure that no bake occurs if domain was minimized by adaptive domain. */
+        const double noise_start = PIL_check_seconds_timer();
         if (fds->total_cells > 1) {
           manta_bake_noise(fds->fluid, fmd, scene_framenr);
         }
+        const double write_start = PIL_check_seconds_timer();
         manta_write_noise(fds->fluid, fmd, scene_framenr);
+        CLOG_INFO(&LOG,
+                  1,
+                  "Frame %d: noise solved in %.3f s, cache written in %.3f s",
+                  scene_framenr,
+                  write_start - noise_start,
+                  PIL_check_seconds_timer() - write_start);
       }
       if (baking_mesh && with_liquid && with_mesh) {
         manta_bake_mesh(fds->fluid, fmd, scene_framenr);
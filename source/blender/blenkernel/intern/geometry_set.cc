@@ -14,6 +14,8 @@
  * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+#include <mutex>
+
 #include "BKE_geometry_set.hh"
 #include "BKE_lib_id.h"
 #include "BKE_mesh.h"
@@ -21,12 +23,15 @@
 #include "BKE_pointcloud.h"
 #include "BKE_volume.h"
 
+#include "BLI_task.hh"
+
 #include "DNA_object_types.h"
 
 #include "MEM_guardedalloc.h"
 
 using blender::float3;
 using blender::float4x4;
+using blender::IndexRange;
 using blender::MutableSpan;
 using blender::Span;
 using blender::StringRef;
@@ -90,6 +95,52 @@ bool GeometryComponent::is_empty() const
   return false;
 }
 
+bool GeometryComponent::owns_direct_data() const
+{
+  return true;
+}
+
+void GeometryComponent::ensure_owns_direct_data()
+{
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Geometry Component Join
+ * \{ */
+
+/**
+ * Components that should be joined into one. Joining is deferred until the result is accessed,
+ * so that e.g. a chain of Join Geometry nodes only copies geometry data once.
+ */
+struct GeometryComponentJoin {
+  GeometryComponentType type;
+  GeometryComponentJoinFn join_fn;
+  Vector<blender::UserCounter<GeometryComponent>> components;
+
+  std::mutex mutex;
+  blender::UserCounter<GeometryComponent> result;
+
+  /* Join the components if that has not been done yet. This can be used by multiple threads
+   * at the same time. */
+  blender::UserCounter<GeometryComponent> ensure_joined()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!result) {
+      Vector<const GeometryComponent *> components_to_join;
+      for (const blender::UserCounter<GeometryComponent> &component : components) {
+        components_to_join.append(component.get());
+      }
+      result = blender::UserCounter<GeometryComponent>(GeometryComponent::create(type));
+      join_fn(components_to_join, *result);
+      /* The components are not needed anymore. */
+      components.clear();
+    }
+    return result;
+  }
+};
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -101,6 +152,16 @@ bool GeometryComponent::is_empty() const
  */
 GeometryComponent &GeometrySet::get_component_for_write(GeometryComponentType component_type)
 {
+  std::optional<std::shared_ptr<GeometryComponentJoin>> join = components_to_join_.pop_try(
+      component_type);
+  if (join.has_value()) {
+    GeometryComponentPtr component = (*join)->ensure_joined();
+    /* Release the join, so that the component is not shared anymore if this geometry set was the
+     * only user of the join. */
+    join.reset();
+    components_.add_new(component_type, std::move(component));
+  }
+
   return components_.add_or_modify(
       component_type,
       [&](GeometryComponentPtr *value_ptr) -> GeometryComponent & {
@@ -126,6 +187,12 @@ GeometryComponent &GeometrySet::get_component_for_write(GeometryComponentType co
 const GeometryComponent *GeometrySet::get_component_for_read(
     GeometryComponentType component_type) const
 {
+  const std::shared_ptr<GeometryComponentJoin> *join = components_to_join_.lookup_ptr(
+      component_type);
+  if (join != nullptr) {
+    /* The joined component stays alive as long as the join is referenced by this geometry set. */
+    return (*join)->ensure_joined().get();
+  }
   const GeometryComponentPtr *component = components_.lookup_ptr(component_type);
   if (component != nullptr) {
     return component->get();
@@ -135,22 +202,94 @@ const GeometryComponent *GeometrySet::get_component_for_read(
 
 bool GeometrySet::has(const GeometryComponentType component_type) const
 {
-  return components_.contains(component_type);
+  return components_.contains(component_type) || components_to_join_.contains(component_type);
 }
 
 void GeometrySet::remove(const GeometryComponentType component_type)
 {
   components_.remove(component_type);
+  components_to_join_.remove(component_type);
 }
 
 void GeometrySet::add(const GeometryComponent &component)
 {
-  BLI_assert(!components_.contains(component.type()));
+  BLI_assert(!this->has(component.type()));
   component.user_add();
   GeometryComponentPtr component_ptr{const_cast<GeometryComponent *>(&component)};
   components_.add_new(component.type(), std::move(component_ptr));
 }
 
+/**
+ * Add a component of the given type, that is the result of joining the given components. They
+ * are only joined when the component is accessed, or not at all when the geometry set is freed
+ * before that.
+ */
+void GeometrySet::add_components_to_join(GeometryComponentType component_type,
+                                         Span<const GeometryComponent *> components,
+                                         GeometryComponentJoinFn join_fn)
+{
+  BLI_assert(!this->has(component_type));
+  std::shared_ptr<GeometryComponentJoin> join = std::make_shared<GeometryComponentJoin>();
+  join->type = component_type;
+  join->join_fn = join_fn;
+  for (const GeometryComponent *component : components) {
+    BLI_assert(component->type() == component_type);
+    component->user_add();
+    join->components.append(GeometryComponentPtr{const_cast<GeometryComponent *>(component)});
+  }
+  components_to_join_.add_new(component_type, std::move(join));
+}
+
+/**
+ * The components that will be joined into the component of the given type, when it has not been
+ * accessed yet. This allows joining them together with other components without joining them
+ * first. Empty when nothing is waiting to be joined.
+ */
+Vector<const GeometryComponent *> GeometrySet::components_to_join(
+    GeometryComponentType component_type) const
+{
+  Vector<const GeometryComponent *> components;
+  const std::shared_ptr<GeometryComponentJoin> *join = components_to_join_.lookup_ptr(
+      component_type);
+  if (join != nullptr) {
+    std::lock_guard<std::mutex> lock((*join)->mutex);
+    if ((*join)->result) {
+      components.append((*join)->result.get());
+    }
+    else {
+      for (const GeometryComponentPtr &component : (*join)->components) {
+        components.append(component.get());
+      }
+    }
+  }
+  return components;
+}
+
+/* Make sure that the geometry does not reference data owned by someone else, e.g. before it is
+ * stored somewhere that outlives that data. Components that own their data are not copied. */
+void GeometrySet::ensure_owns_direct_data()
+{
+  /* The joined components own their data, but the components to join might not. */
+  Vector<GeometryComponentType> types_to_join;
+  for (const GeometryComponentType type : components_to_join_.keys()) {
+    types_to_join.append(type);
+  }
+  for (const GeometryComponentType type : types_to_join) {
+    this->get_component_for_write(type);
+  }
+
+  Vector<GeometryComponentType> types_to_copy;
+  for (const GeometryComponentPtr &component_ptr : components_.values()) {
+    const GeometryComponent &component = *component_ptr.get();
+    if (!component.owns_direct_data()) {
+      types_to_copy.append(component.type());
+    }
+  }
+  for (const GeometryComponentType type : types_to_copy) {
+    this->get_component_for_write(type).ensure_owns_direct_data();
+  }
+}
+
 void GeometrySet::compute_boundbox_without_instances(float3 *r_min, float3 *r_max) const
 {
   const PointCloud *pointcloud = this->get_pointcloud_for_read();
@@ -165,7 +304,8 @@ void GeometrySet::compute_boundbox_without_instances(float3 *r_min, float3 *r_ma
 
 std::ostream &operator<<(std::ostream &stream, const GeometrySet &geometry_set)
 {
-  stream << "<GeometrySet at " << &geometry_set << ", " << geometry_set.components_.size()
+  stream << "<GeometrySet at " << &geometry_set << ", "
+         << geometry_set.components_.size() + geometry_set.components_to_join_.size()
          << " components>";
   return stream;
 }
@@ -384,6 +524,20 @@ bool MeshComponent::is_empty() const
   return mesh_ == nullptr;
 }
 
+bool MeshComponent::owns_direct_data() const
+{
+  return ownership_ == GeometryOwnershipType::Owned;
+}
+
+void MeshComponent::ensure_owns_direct_data()
+{
+  BLI_assert(this->is_mutable());
+  if (mesh_ != nullptr && ownership_ != GeometryOwnershipType::Owned) {
+    mesh_ = BKE_mesh_copy_for_eval(mesh_, false);
+    ownership_ = GeometryOwnershipType::Owned;
+  }
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -470,6 +624,20 @@ bool PointCloudComponent::is_empty() const
   return pointcloud_ == nullptr;
 }
 
+bool PointCloudComponent::owns_direct_data() const
+{
+  return ownership_ == GeometryOwnershipType::Owned;
+}
+
+void PointCloudComponent::ensure_owns_direct_data()
+{
+  BLI_assert(this->is_mutable());
+  if (pointcloud_ != nullptr && ownership_ != GeometryOwnershipType::Owned) {
+    pointcloud_ = BKE_pointcloud_copy_for_eval(pointcloud_, false);
+    ownership_ = GeometryOwnershipType::Owned;
+  }
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -484,6 +652,7 @@ GeometryComponent *InstancesComponent::copy() const
 {
   InstancesComponent *new_component = new InstancesComponent();
   new_component->transforms_ = transforms_;
+  new_component->ids_ = ids_;
   new_component->instanced_data_ = instanced_data_;
   return new_component;
 }
@@ -492,6 +661,7 @@ void InstancesComponent::clear()
 {
   instanced_data_.clear();
   transforms_.clear();
+  ids_.clear();
 }
 
 void InstancesComponent::add_instance(Object *object, float4x4 transform, const int id)
@@ -517,6 +687,17 @@ void InstancesComponent::add_instance(InstancedData data, float4x4 transform, co
   ids_.append(id);
 }
 
+void InstancesComponent::add_instances(Span<InstancedData> data,
+                                       Span<float4x4> transforms,
+                                       Span<int> ids)
+{
+  BLI_assert(data.size() == transforms.size());
+  BLI_assert(data.size() == ids.size());
+  instanced_data_.extend(data);
+  transforms_.extend(transforms);
+  ids_.extend(ids);
+}
+
 Span<InstancedData> InstancesComponent::instanced_data() const
 {
   return instanced_data_;
@@ -544,6 +725,21 @@ int InstancesComponent::instances_amount() const
   return size;
 }
 
+/**
+ * Compute the transforms of all instances in the space that the object transform maps to.
+ * This is done in parallel, because there can be many instances.
+ */
+void InstancesComponent::compute_world_transforms(const float4x4 &object_transform,
+                                                  MutableSpan<float4x4> r_transforms) const
+{
+  BLI_assert(r_transforms.size() == transforms_.size());
+  blender::parallel_for(transforms_.index_range(), 1024, [&](IndexRange range) {
+    for (const int i : range) {
+      r_transforms[i] = object_transform * transforms_[i];
+    }
+  });
+}
+
 bool InstancesComponent::is_empty() const
 {
   return transforms_.size() == 0;
@@ -628,6 +824,20 @@ Volume *VolumeComponent::get_for_write()
   return volume_;
 }
 
+bool VolumeComponent::owns_direct_data() const
+{
+  return ownership_ == GeometryOwnershipType::Owned;
+}
+
+void VolumeComponent::ensure_owns_direct_data()
+{
+  BLI_assert(this->is_mutable());
+  if (volume_ != nullptr && ownership_ != GeometryOwnershipType::Owned) {
+    volume_ = BKE_volume_copy_for_eval(volume_, false);
+    ownership_ = GeometryOwnershipType::Owned;
+  }
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -656,8 +866,22 @@ int BKE_geometry_set_instances(const GeometrySet *geometry_set,
   *r_transforms = (float(*)[4][4])component->transforms().data();
   *r_ids = (int *)component->ids().data();
   *r_instanced_data = (InstancedData *)component->instanced_data().data();
-  *r_instanced_data = (InstancedData *)component->instanced_data().data();
   return component->instances_amount();
 }
 
+/* Compute the transforms of all instances multiplied with the object transform. The output array
+ * must have a size of the number of instances. */
+void BKE_geometry_set_instances_world_transforms(const GeometrySet *geometry_set,
+                                                 const float object_transform[4][4],
+                                                 float (*r_transforms)[4][4])
+{
+  const InstancesComponent *component = geometry_set->get_component_for_read<InstancesComponent>();
+  if (component == nullptr) {
+    return;
+  }
+  component->compute_world_transforms(
+      float4x4(object_transform),
+      MutableSpan<float4x4>((float4x4 *)r_transforms, component->instances_amount()));
+}
+
 /** \} */
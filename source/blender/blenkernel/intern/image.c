@@ -4106,7 +4106,8 @@ static ImBuf *load_sequence_single(
   iuser_t.view = view_id;
   BKE_image_user_file_path(&iuser_t, ima, name);
 
-  flag = IB_rect | IB_multilayer | IB_metadata;
+  /* Pixels of multilayer passes are read once they are used, see image_multilayer_pass_ensure. */
+  flag = IB_rect | IB_multilayer | IB_multilayer_deferred | IB_metadata;
   flag |= imbuf_alpha_flags_for_image(ima);
 
   /* read ibuf */
@@ -4202,6 +4203,73 @@ static ImBuf *image_load_sequence_file(Image *ima, ImageUser *iuser, int entry,
   return ibuf;
 }
 
+/* Read the pixels of passes of ima->rr that don't have them yet, the result was loaded with
+ * IB_multilayer_deferred. The caller must hold image_mutex. */
+static void image_multilayer_read_passes(Image *ima,
+                                         ImageUser *iuser,
+                                         RenderLayer *rl,
+                                         const char **pass_names,
+                                         int pass_names_len)
+{
+  ImageUser iuser_t = {0};
+  char filepath[FILE_MAX];
+
+  if (iuser) {
+    iuser_t = *iuser;
+  }
+
+  /* The result is converted from the file of the first view, for the frame it was loaded at. */
+  iuser_t.framenr = ima->rr->framenr;
+  iuser_t.view = 0;
+  BKE_image_user_file_path(&iuser_t, ima, filepath);
+
+  RE_MultilayerReadPasses(ima->rr,
+                          rl,
+                          pass_names,
+                          pass_names_len,
+                          filepath,
+                          ima->colorspace_settings.name,
+                          ima->alpha_mode == IMA_ALPHA_PREMUL);
+}
+
+static void image_multilayer_pass_ensure(Image *ima, ImageUser *iuser, RenderPass *rpass)
+{
+  if (rpass->rect) {
+    return;
+  }
+
+  LISTBASE_FOREACH (RenderLayer *, rl, &ima->rr->layers) {
+    if (BLI_findindex(&rl->passes, rpass) != -1) {
+      const char *pass_name = rpass->name;
+      image_multilayer_read_passes(ima, iuser, rl, &pass_name, 1);
+      return;
+    }
+  }
+}
+
+void BKE_image_multilayer_ensure_passes(Image *ima,
+                                        ImageUser *iuser,
+                                        const char *layer_name,
+                                        const char **pass_names,
+                                        int pass_names_len)
+{
+  BLI_mutex_lock(image_mutex);
+
+  if (ima->type == IMA_TYPE_MULTILAYER && ima->rr) {
+    if (layer_name) {
+      RenderLayer *rl = RE_GetRenderLayer(ima->rr, layer_name);
+      if (rl) {
+        image_multilayer_read_passes(ima, iuser, rl, pass_names, pass_names_len);
+      }
+    }
+    else {
+      image_multilayer_read_passes(ima, iuser, NULL, pass_names, pass_names_len);
+    }
+  }
+
+  BLI_mutex_unlock(image_mutex);
+}
+
 static ImBuf *image_load_sequence_multilayer(Image *ima, ImageUser *iuser, int entry, int frame)
 {
   struct ImBuf *ibuf = NULL;
@@ -4232,6 +4300,10 @@ static ImBuf *image_load_sequence_multilayer(Image *ima, ImageUser *iuser, int e
     RenderPass *rpass = BKE_image_multilayer_index(ima->rr, iuser);
 
     if (rpass) {
+      image_multilayer_pass_ensure(ima, iuser, rpass);
+    }
+
+    if (rpass && rpass->rect) {
       // printf("load from pass %s\n", rpass->name);
       /* since we free  render results, we copy the rect */
       ibuf = IMB_allocImBuf(ima->rr->rectx, ima->rr->recty, 32, 0);
@@ -4414,7 +4486,9 @@ static ImBuf *load_image_single(Image *ima,
   else {
     ImageUser iuser_t;
 
-    flag = IB_rect | IB_multilayer | IB_metadata;
+    /* Pixels of multilayer passes are read once they are used, see image_multilayer_pass_ensure.
+     * Packed files are read at once, for them the file isn't available to read passes later. */
+    flag = IB_rect | IB_multilayer | IB_multilayer_deferred | IB_metadata;
     flag |= imbuf_alpha_flags_for_image(ima);
 
     /* get the correct filepath */
@@ -4561,6 +4635,10 @@ static ImBuf *image_get_ibuf_multilayer(Image *ima, ImageUser *iuser)
     RenderPass *rpass = BKE_image_multilayer_index(ima->rr, iuser);
 
     if (rpass) {
+      image_multilayer_pass_ensure(ima, iuser, rpass);
+    }
+
+    if (rpass && rpass->rect) {
       ibuf = IMB_allocImBuf(ima->rr->rectx, ima->rr->recty, 32, 0);
 
       image_init_after_load(ima, iuser, ibuf);
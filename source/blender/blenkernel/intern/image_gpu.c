@@ -51,6 +51,7 @@ static void gpu_free_unused_buffers(void);
 static void image_free_gpu(Image *ima, const bool immediate);
 static void image_update_gputexture_ex(
     Image *ima, ImageTile *tile, ImBuf *ibuf, int x, int y, int w, int h);
+static void image_update_gputexture_mipmaps(Image *ima, ImageTile *tile);
 
 /* Internal structs. */
 #define IMA_PARTIAL_REFRESH_TILE_SIZE 256
@@ -347,6 +348,7 @@ static GPUTexture *image_get_gpu_texture(Image *ima,
           ima, tile, ibuf, tile_offset_x, tile_offset_y, tile_width, tile_height);
       MEM_freeN(refresh_area);
     }
+    image_update_gputexture_mipmaps(ima, tile);
     ima->gpuflag &= ~IMA_GPU_PARTIAL_REFRESH;
   }
 
@@ -771,7 +773,10 @@ static void gpu_texture_update_from_ibuf(
   if (rect_float && rect_float != ibuf->rect_float) {
     MEM_freeN(rect_float);
   }
+}
 
+static void gpu_texture_update_mipmaps(GPUTexture *tex, Image *ima)
+{
   if (GPU_mipmap_enabled()) {
     GPU_texture_generate_mipmap(tex);
   }
@@ -798,6 +803,21 @@ static void image_update_gputexture_ex(
   }
 }
 
+/* Mipmaps are generated from the whole texture, so this is done once after all the partial
+ * updates instead of after every updated area. */
+static void image_update_gputexture_mipmaps(Image *ima, ImageTile *tile)
+{
+  GPUTexture *tex = ima->gputexture[TEXTARGET_2D][0];
+  if (tex != NULL && tile == ima->tiles.first) {
+    gpu_texture_update_mipmaps(tex, ima);
+  }
+
+  tex = ima->gputexture[TEXTARGET_2D_ARRAY][0];
+  if (tex != NULL) {
+    gpu_texture_update_mipmaps(tex, ima);
+  }
+}
+
 /* Partial update of texture for texture painting. This is often much
  * quicker than fully updating the texture for high resolution images. */
 void BKE_image_update_gputexture(Image *ima, ImageUser *iuser, int x, int y, int w, int h)
@@ -810,6 +830,7 @@ void BKE_image_update_gputexture(Image *ima, ImageUser *iuser, int x, int y, int
     BKE_image_free_gputextures(ima);
   }
   image_update_gputexture_ex(ima, tile, ibuf, x, y, w, h);
+  image_update_gputexture_mipmaps(ima, tile);
   BKE_image_release_ibuf(ima, ibuf, NULL);
 }
 
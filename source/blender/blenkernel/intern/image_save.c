@@ -178,6 +178,11 @@ static bool image_save_single(ReportList *reports,
     }
   }
 
+  /* Passes of multilayer images that weren't used yet have no pixels, read all of them. */
+  if (ima->type == IMA_TYPE_MULTILAYER) {
+    BKE_image_multilayer_ensure_passes(ima, iuser, NULL, NULL, 0);
+  }
+
   /* we need renderresult for exr and rendered multiview */
   rr = BKE_image_acquire_renderresult(opts->scene, ima);
   bool is_mono = rr ? BLI_listbase_count_at_most(&rr->views, 2) < 2 :
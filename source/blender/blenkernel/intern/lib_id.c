@@ -69,6 +69,7 @@
 #include "BKE_lib_query.h"
 #include "BKE_lib_remap.h"
 #include "BKE_main.h"
+#include "BKE_main_namemap.h"
 #include "BKE_node.h"
 #include "BKE_rigidbody.h"
 
@@ -164,7 +165,7 @@ static void lib_id_clear_library_data_ex(Main *bmain, ID *id)
   id->tag &= ~(LIB_TAG_INDIRECT | LIB_TAG_EXTERN);
   id->flag &= ~LIB_INDIRECT_WEAK_LINK;
   if (id_in_mainlist) {
-    if (BKE_id_new_name_validate(which_libbase(bmain, GS(id->name)), id, NULL)) {
+    if (BKE_id_new_name_validate(bmain, which_libbase(bmain, GS(id->name)), id, NULL)) {
       bmain->is_memfile_undo_written = false;
     }
   }
@@ -825,7 +826,7 @@ void BKE_libblock_management_main_add(Main *bmain, void *idv)
   ListBase *lb = which_libbase(bmain, GS(id->name));
   BKE_main_lock(bmain);
   BLI_addtail(lb, id);
-  BKE_id_new_name_validate(lb, id, NULL);
+  BKE_id_new_name_validate(bmain, lb, id, NULL);
   /* alphabetic insertion: is in new_id */
   id->tag &= ~(LIB_TAG_NO_MAIN | LIB_TAG_NO_USER_REFCOUNT);
   bmain->is_memfile_undo_written = false;
@@ -848,6 +849,7 @@ void BKE_libblock_management_main_remove(Main *bmain, void *idv)
 
   ListBase *lb = which_libbase(bmain, GS(id->name));
   BKE_main_lock(bmain);
+  BKE_main_namemap_remove_id(bmain, id);
   BLI_remlink(lb, id);
   id->tag |= LIB_TAG_NO_MAIN;
   bmain->is_memfile_undo_written = false;
@@ -957,7 +959,7 @@ void BKE_main_id_flag_all(Main *bmain, const int flag, const bool value)
   }
 }
 
-void BKE_main_id_repair_duplicate_names_listbase(ListBase *lb)
+void BKE_main_id_repair_duplicate_names_listbase(Main *bmain, ListBase *lb)
 {
   int lb_len = 0;
   LISTBASE_FOREACH (ID *, id, lb) {
@@ -981,7 +983,7 @@ void BKE_main_id_repair_duplicate_names_listbase(ListBase *lb)
   }
   for (i = 0; i < lb_len; i++) {
     if (!BLI_gset_add(gset, id_array[i]->name + 2)) {
-      BKE_id_new_name_validate(lb, id_array[i], NULL);
+      BKE_id_new_name_validate(bmain, lb, id_array[i], NULL);
     }
   }
   BLI_gset_free(gset, NULL);
@@ -1084,7 +1086,7 @@ void *BKE_libblock_alloc(Main *bmain, short type, const char *name, const int fl
 
       BKE_main_lock(bmain);
       BLI_addtail(lb, id);
-      BKE_id_new_name_validate(lb, id, name);
+      BKE_id_new_name_validate(bmain, lb, id, name);
       bmain->is_memfile_undo_written = false;
       /* alphabetic insertion: is in new_id */
       BKE_main_unlock(bmain);
@@ -1322,6 +1324,16 @@ ID *BKE_libblock_find_name(struct Main *bmain, const short type, const char *nam
 {
   ListBase *lb = which_libbase(bmain, type);
   BLI_assert(lb != NULL);
+  if (bmain->name_map != NULL && !BKE_main_namemap_has_name(bmain, type, name)) {
+    /* No local ID uses that name, only linked ones have to be checked. Those are always sorted
+     * after the local ones. */
+    for (ID *id = lb->last; id != NULL && ID_IS_LINKED(id); id = id->prev) {
+      if (STREQ(id->name + 2, name)) {
+        return id;
+      }
+    }
+    return NULL;
+  }
   return BLI_findstring(lb, name, offsetof(ID, name) + 2);
 }
 
@@ -1665,6 +1677,40 @@ static bool check_for_dupid(ListBase *lb, ID *id, char *name, ID **r_id_sorting_
 #undef MAX_NUMBERS_IN_USE
 }
 
+/**
+ * Same as #check_for_dupid, using the name map of \a bmain instead of searching the list of IDs.
+ * The current name of the ID being renamed is expected to not be in the map.
+ *
+ * The numbers used for a base name are checked from the smallest one which may be unused, so
+ * creating many IDs with the same name does not check all the previously used numbers again.
+ */
+static bool check_for_dupid_namemap(Main *bmain, const short id_type, char *name)
+{
+  BLI_assert(strlen(name) < MAX_ID_NAME - 2);
+
+  bool is_name_changed = false;
+  while (BKE_main_namemap_has_name(bmain, id_type, name)) {
+    /* Get the name and number parts ("name.number"). */
+    char base_name[MAX_ID_NAME - 2];
+    int number;
+    size_t base_name_len = BLI_split_name_num(base_name, &number, name, '.');
+
+    number = MAX2(BKE_main_namemap_number_hint_get(bmain, id_type, base_name), MIN_NUMBER);
+
+    /* If id_name_final_build helper returns false, it had to truncate further given name, hence
+     * we have to go over the whole check again. */
+    while (id_name_final_build(name, base_name, base_name_len, number)) {
+      if (!BKE_main_namemap_has_name(bmain, id_type, name)) {
+        BKE_main_namemap_number_hint_set(bmain, id_type, base_name, number + 1);
+        return true;
+      }
+      number++;
+    }
+    is_name_changed = true;
+  }
+  return is_name_changed;
+}
+
 #undef MIN_NUMBER
 #undef MAX_NUMBER
 
@@ -1675,7 +1721,7 @@ static bool check_for_dupid(ListBase *lb, ID *id, char *name, ID **r_id_sorting_
  *
  * \return true if a new name had to be created.
  */
-bool BKE_id_new_name_validate(ListBase *lb, ID *id, const char *tname)
+bool BKE_id_new_name_validate(Main *bmain, ListBase *lb, ID *id, const char *tname)
 {
   bool result;
   char name[MAX_ID_NAME - 2];
@@ -1704,8 +1750,17 @@ bool BKE_id_new_name_validate(ListBase *lb, ID *id, const char *tname)
   }
 
   ID *id_sorting_hint = NULL;
-  result = check_for_dupid(lb, id, name, &id_sorting_hint);
-  strcpy(id->name + 2, name);
+  if (bmain->name_map != NULL) {
+    /* The current name of the ID does not conflict with the new one. */
+    BKE_main_namemap_remove_id(bmain, id);
+    result = check_for_dupid_namemap(bmain, GS(id->name), name);
+    strcpy(id->name + 2, name);
+    BKE_main_namemap_add_id(bmain, id);
+  }
+  else {
+    result = check_for_dupid(lb, id, name, &id_sorting_hint);
+    strcpy(id->name + 2, name);
+  }
 
   /* This was in 2.43 and previous releases
    * however all data in blender should be sorted, not just duplicate names
@@ -2164,7 +2219,7 @@ void BLI_libblock_ensure_unique_name(Main *bmain, const char *name)
   idtest = BLI_findstring(lb, name + 2, offsetof(ID, name) + 2);
   if (idtest != NULL) {
     /* BKE_id_new_name_validate also takes care of sorting. */
-    BKE_id_new_name_validate(lb, idtest, NULL);
+    BKE_id_new_name_validate(bmain, lb, idtest, NULL);
     bmain->is_memfile_undo_written = false;
   }
 }
@@ -2175,7 +2230,7 @@ void BLI_libblock_ensure_unique_name(Main *bmain, const char *name)
 void BKE_libblock_rename(Main *bmain, ID *id, const char *name)
 {
   ListBase *lb = which_libbase(bmain, GS(id->name));
-  if (BKE_id_new_name_validate(lb, id, name)) {
+  if (BKE_id_new_name_validate(bmain, lb, id, name)) {
     bmain->is_memfile_undo_written = false;
   }
 }
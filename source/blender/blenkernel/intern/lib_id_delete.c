@@ -40,6 +40,7 @@
 #include "BKE_lib_remap.h"
 #include "BKE_library.h"
 #include "BKE_main.h"
+#include "BKE_main_namemap.h"
 
 #include "lib_intern.h"
 
@@ -180,6 +181,7 @@ void BKE_id_free_ex(Main *bmain, void *idv, int flag, const bool use_flag_from_i
 
   if ((flag & LIB_ID_FREE_NO_MAIN) == 0) {
     ListBase *lb = which_libbase(bmain, type);
+    BKE_main_namemap_remove_id(bmain, id);
     BLI_remlink(lb, id);
   }
 
@@ -279,6 +281,7 @@ static size_t id_delete(Main *bmain, const bool do_tagged_deletion)
           id_next = id->next;
           /* Note: in case we delete a library, we also delete all its datablocks! */
           if ((id->tag & tag) || (id->lib != NULL && (id->lib->id.tag & tag))) {
+            BKE_main_namemap_remove_id(bmain, id);
             BLI_remlink(lb, id);
             BLI_addtail(&tagged_deleted_ids, id);
             /* Do not tag as no_main now, we want to unlink it first (lower-level ID management
@@ -293,15 +296,31 @@ static size_t id_delete(Main *bmain, const bool do_tagged_deletion)
         dummy_link.next = tagged_deleted_ids.first;
         last_remapped_id = (ID *)(&dummy_link);
       }
+      /* Will tag 'never NULL' users of these IDs too.
+       * Note that we cannot use BKE_libblock_unlink() here,
+       * since it would ignore indirect (and proxy!)
+       * links, this can lead to nasty crashing here in second, actual deleting loop.
+       * Also, this will also flag users of deleted data that cannot be unlinked
+       * (object using deleted obdata, etc.), so that they also get deleted.
+       * All newly removed IDs are unlinked at once, which only checks the whole Main once. */
+      int remap_ids_len = 0;
+      for (id = last_remapped_id->next; id; id = id->next) {
+        remap_ids_len++;
+      }
+      ID **remap_ids = MEM_malloc_arrayN(remap_ids_len, sizeof(*remap_ids), __func__);
+      remap_ids_len = 0;
+      for (id = last_remapped_id->next; id; id = id->next) {
+        remap_ids[remap_ids_len++] = id;
+      }
+      BKE_libblock_remap_multiple_locked(bmain,
+                                         remap_ids,
+                                         NULL,
+                                         remap_ids_len,
+                                         ID_REMAP_FLAG_NEVER_NULL_USAGE |
+                                             ID_REMAP_FORCE_NEVER_NULL_USAGE);
+      MEM_freeN(remap_ids);
+
       for (id = last_remapped_id->next; id; id = id->next) {
-        /* Will tag 'never NULL' users of this ID too.
-         * Note that we cannot use BKE_libblock_unlink() here,
-         * since it would ignore indirect (and proxy!)
-         * links, this can lead to nasty crashing here in second, actual deleting loop.
-         * Also, this will also flag users of deleted data that cannot be unlinked
-         * (object using deleted obdata, etc.), so that they also get deleted. */
-        BKE_libblock_remap_locked(
-            bmain, id, NULL, ID_REMAP_FLAG_NEVER_NULL_USAGE | ID_REMAP_FORCE_NEVER_NULL_USAGE);
         /* Since we removed ID from Main,
          * we also need to unlink its own other IDs usages ourself. */
         BKE_libblock_relink_ex(bmain, id, NULL, NULL, 0);
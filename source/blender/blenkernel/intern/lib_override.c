@@ -316,43 +316,61 @@ bool BKE_lib_override_library_create_from_tag(Main *bmain)
   /* Only remap new local ID's pointers, we don't want to force our new overrides onto our whole
    * existing linked IDs usages. */
   if (success) {
+    /* All linked IDs and their shape keys are remapped to their overrides at once, so that every
+     * local ID only has its ID pointers checked once. */
+    const int todo_ids_len = BLI_listbase_count(&todo_ids);
+    ID **reference_ids = MEM_malloc_arrayN(todo_ids_len * 2, sizeof(ID *), __func__);
+    ID **local_ids = MEM_malloc_arrayN(todo_ids_len * 2, sizeof(ID *), __func__);
+    int remap_len = 0;
     for (todo_id_iter = todo_ids.first; todo_id_iter != NULL; todo_id_iter = todo_id_iter->next) {
-      ID *other_id;
       reference_id = todo_id_iter->data;
       ID *local_id = reference_id->newid;
 
       if (local_id == NULL) {
         continue;
       }
+      reference_ids[remap_len] = reference_id;
+      local_ids[remap_len++] = local_id;
 
-      Key *reference_key, *local_key = NULL;
+      Key *reference_key;
       if ((reference_key = BKE_key_from_id(reference_id)) != NULL) {
-        local_key = BKE_key_from_id(reference_id->newid);
+        Key *local_key = BKE_key_from_id(reference_id->newid);
         BLI_assert(local_key != NULL);
+        reference_ids[remap_len] = &reference_key->id;
+        local_ids[remap_len++] = &local_key->id;
       }
+    }
 
-      /* Still checking the whole Main, that way we can tag other local IDs as needing to be
-       * remapped to use newly created overriding IDs, if needed. */
-      FOREACH_MAIN_ID_BEGIN (bmain, other_id) {
-        if ((other_id->tag & LIB_TAG_DOIT) != 0 && other_id->lib == NULL) {
-          /* Note that using ID_REMAP_SKIP_INDIRECT_USAGE below is superfluous, as we only remap
-           * local IDs usages anyway. */
-          BKE_libblock_relink_ex(bmain,
-                                 other_id,
-                                 reference_id,
-                                 local_id,
-                                 ID_REMAP_SKIP_INDIRECT_USAGE | ID_REMAP_SKIP_OVERRIDE_LIBRARY);
-          if (reference_key != NULL) {
-            BKE_libblock_relink_ex(bmain,
-                                   other_id,
-                                   &reference_key->id,
-                                   &local_key->id,
-                                   ID_REMAP_SKIP_INDIRECT_USAGE | ID_REMAP_SKIP_OVERRIDE_LIBRARY);
-          }
+    /* Still checking the whole Main, that way we can tag other local IDs as needing to be
+     * remapped to use newly created overriding IDs, if needed. */
+    ID **other_ids = NULL;
+    int other_ids_len = 0, other_ids_len_alloc = 0;
+    ID *other_id;
+    FOREACH_MAIN_ID_BEGIN (bmain, other_id) {
+      if ((other_id->tag & LIB_TAG_DOIT) != 0 && other_id->lib == NULL) {
+        if (other_ids_len == other_ids_len_alloc) {
+          other_ids_len_alloc = other_ids_len_alloc ? other_ids_len_alloc * 2 : 64;
+          other_ids = MEM_reallocN(other_ids, sizeof(*other_ids) * (size_t)other_ids_len_alloc);
         }
+        other_ids[other_ids_len++] = other_id;
       }
-      FOREACH_MAIN_ID_END;
     }
+    FOREACH_MAIN_ID_END;
+
+    /* Note that using ID_REMAP_SKIP_INDIRECT_USAGE below is superfluous, as we only remap
+     * local IDs usages anyway. */
+    if (other_ids != NULL) {
+      BKE_libblock_relink_multiple(bmain,
+                                   other_ids,
+                                   other_ids_len,
+                                   reference_ids,
+                                   local_ids,
+                                   remap_len,
+                                   ID_REMAP_SKIP_INDIRECT_USAGE | ID_REMAP_SKIP_OVERRIDE_LIBRARY);
+      MEM_freeN(other_ids);
+    }
+    MEM_freeN(reference_ids);
+    MEM_freeN(local_ids);
   }
   else {
     /* We need to cleanup potentially already created data. */
@@ -810,6 +828,12 @@ bool BKE_lib_override_library_resync(Main *bmain, Scene *scene, ViewLayer *view_
     return success;
   }
 
+  /* Old overrides and their replacements, remapped all at once after the loop below. */
+  const uint linkedref_len = BLI_ghash_len(linkedref_to_old_override);
+  ID **remap_old_ids = MEM_malloc_arrayN(MAX2(linkedref_len, 1), sizeof(ID *), __func__);
+  ID **remap_new_ids = MEM_malloc_arrayN(MAX2(linkedref_len, 1), sizeof(ID *), __func__);
+  int remap_len = 0;
+
   ListBase *lb;
   FOREACH_MAIN_LISTBASE_BEGIN (bmain, lb) {
     FOREACH_MAIN_LISTBASE_ID_BEGIN (lb, id) {
@@ -830,9 +854,9 @@ bool BKE_lib_override_library_resync(Main *bmain, Scene *scene, ViewLayer *view_
            * IDs, which are always *after* all local ones, and we only affect local IDs. */
           BLI_listbase_swaplinks(lb, id_override_old, id_override_new);
 
-          /* Remap the whole local IDs to use the new override. */
-          BKE_libblock_remap(
-              bmain, id_override_old, id_override_new, ID_REMAP_SKIP_INDIRECT_USAGE);
+          /* Remap the whole local IDs to use the new override, see below. */
+          remap_old_ids[remap_len] = id_override_old;
+          remap_new_ids[remap_len++] = id_override_new;
 
           /* Copy over overrides rules from old override ID to new one. */
           BLI_duplicatelist(&id_override_new->override_library->properties,
@@ -851,6 +875,14 @@ bool BKE_lib_override_library_resync(Main *bmain, Scene *scene, ViewLayer *view_
   }
   FOREACH_MAIN_LISTBASE_END;
 
+  /* Checking the whole Main database only once, instead of once per resynced override. */
+  BKE_main_lock(bmain);
+  BKE_libblock_remap_multiple_locked(
+      bmain, remap_old_ids, remap_new_ids, remap_len, ID_REMAP_SKIP_INDIRECT_USAGE);
+  BKE_main_unlock(bmain);
+  MEM_freeN(remap_old_ids);
+  MEM_freeN(remap_new_ids);
+
   /* We need to apply override rules in a separate loop, after all ID pointers have been properly
    * remapped, and all new local override IDs have gotten their proper original names, otherwise
    * override operations based on those ID names would fail. */
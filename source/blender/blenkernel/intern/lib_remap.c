@@ -22,6 +22,9 @@
 
 #include "CLG_log.h"
 
+#include "MEM_guardedalloc.h"
+
+#include "BLI_ghash.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_collection_types.h"
@@ -30,6 +33,7 @@
 #include "BKE_armature.h"
 #include "BKE_collection.h"
 #include "BKE_curve.h"
+#include "BKE_idtype.h"
 #include "BKE_layer.h"
 #include "BKE_lib_id.h"
 #include "BKE_lib_query.h"
@@ -346,6 +350,41 @@ static void libblock_remap_data_postprocess_nodetree_update(Main *bmain, ID *new
   ntreeUpdateAllUsers(bmain, new_id);
 }
 
+/**
+ * Final handling of the user counts and linking status of the old and new ID, once all the ID
+ * pointers have been remapped.
+ */
+static void libblock_remap_data_finalize(IDRemap *id_remap_data)
+{
+  ID *old_id = id_remap_data->old_id;
+  ID *new_id = id_remap_data->new_id;
+
+  /* XXX We may not want to always 'transfer' fake-user from old to new id...
+   *     Think for now it's desired behavior though,
+   *     we can always add an option (flag) to control this later if needed. */
+  if (old_id && (old_id->flag & LIB_FAKEUSER)) {
+    id_fake_user_clear(old_id);
+    id_fake_user_set(new_id);
+  }
+
+  id_us_clear_real(old_id);
+
+  if (new_id && (new_id->tag & LIB_TAG_INDIRECT) &&
+      (id_remap_data->status & ID_REMAP_IS_LINKED_DIRECT)) {
+    new_id->tag &= ~LIB_TAG_INDIRECT;
+    new_id->flag &= ~LIB_INDIRECT_WEAK_LINK;
+    new_id->tag |= LIB_TAG_EXTERN;
+  }
+
+#ifdef DEBUG_PRINT
+  printf("%s: %d occurrences skipped (%d direct and %d indirect ones)\n",
+         __func__,
+         id_remap_data->skipped_direct + id_remap_data->skipped_indirect,
+         id_remap_data->skipped_direct,
+         id_remap_data->skipped_indirect);
+#endif
+}
+
 /**
  * Execute the 'data' part of the remapping (that is, all ID pointers from other ID data-blocks).
  *
@@ -422,48 +461,17 @@ static void libblock_remap_data(
     FOREACH_MAIN_ID_END;
   }
 
-  /* XXX We may not want to always 'transfer' fake-user from old to new id...
-   *     Think for now it's desired behavior though,
-   *     we can always add an option (flag) to control this later if needed. */
-  if (old_id && (old_id->flag & LIB_FAKEUSER)) {
-    id_fake_user_clear(old_id);
-    id_fake_user_set(new_id);
-  }
-
-  id_us_clear_real(old_id);
-
-  if (new_id && (new_id->tag & LIB_TAG_INDIRECT) &&
-      (r_id_remap_data->status & ID_REMAP_IS_LINKED_DIRECT)) {
-    new_id->tag &= ~LIB_TAG_INDIRECT;
-    new_id->flag &= ~LIB_INDIRECT_WEAK_LINK;
-    new_id->tag |= LIB_TAG_EXTERN;
-  }
-
-#ifdef DEBUG_PRINT
-  printf("%s: %d occurrences skipped (%d direct and %d indirect ones)\n",
-         __func__,
-         r_id_remap_data->skipped_direct + r_id_remap_data->skipped_indirect,
-         r_id_remap_data->skipped_direct,
-         r_id_remap_data->skipped_indirect);
-#endif
+  libblock_remap_data_finalize(r_id_remap_data);
 }
 
 /**
- * Replace all references in given Main to \a old_id by \a new_id
- * (if \a new_id is NULL, it unlinks \a old_id).
+ * Notify editors about the remapping of \a old_id and check its remaining usages,
+ * after all the ID pointers from Main have been remapped.
  */
-void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const short remap_flags)
+static void libblock_remap_old_id_finalize(IDRemap *id_remap_data)
 {
-  IDRemap id_remap_data;
-  ID *old_id = old_idv;
-  ID *new_id = new_idv;
-  int skipped_direct, skipped_refcounted;
-
-  BLI_assert(old_id != NULL);
-  BLI_assert((new_id == NULL) || GS(old_id->name) == GS(new_id->name));
-  BLI_assert(old_id != new_id);
-
-  libblock_remap_data(bmain, NULL, old_id, new_id, remap_flags, &id_remap_data);
+  ID *old_id = id_remap_data->old_id;
+  ID *new_id = id_remap_data->new_id;
 
   if (free_notifier_reference_cb) {
     free_notifier_reference_cb(old_id);
@@ -476,14 +484,14 @@ void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const
     remap_editor_id_reference_cb(old_id, new_id);
   }
 
-  skipped_direct = id_remap_data.skipped_direct;
-  skipped_refcounted = id_remap_data.skipped_refcounted;
+  const int skipped_direct = id_remap_data->skipped_direct;
+  const int skipped_refcounted = id_remap_data->skipped_refcounted;
 
   /* If old_id was used by some ugly 'user_one' stuff (like Image or Clip editors...), and user
    * count has actually been incremented for that, we have to decrease once more its user count...
    * unless we had to skip some 'user_one' cases. */
   if ((old_id->tag & LIB_TAG_EXTRAUSER_SET) &&
-      !(id_remap_data.status & ID_REMAP_IS_USER_ONE_SKIPPED)) {
+      !(id_remap_data->status & ID_REMAP_IS_USER_ONE_SKIPPED)) {
     id_us_clear_real(old_id);
   }
 
@@ -506,6 +514,25 @@ void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const
       old_id->tag |= LIB_TAG_INDIRECT;
     }
   }
+}
+
+/**
+ * Replace all references in given Main to \a old_id by \a new_id
+ * (if \a new_id is NULL, it unlinks \a old_id).
+ */
+void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const short remap_flags)
+{
+  IDRemap id_remap_data;
+  ID *old_id = old_idv;
+  ID *new_id = new_idv;
+
+  BLI_assert(old_id != NULL);
+  BLI_assert((new_id == NULL) || GS(old_id->name) == GS(new_id->name));
+  BLI_assert(old_id != new_id);
+
+  libblock_remap_data(bmain, NULL, old_id, new_id, remap_flags, &id_remap_data);
+
+  libblock_remap_old_id_finalize(&id_remap_data);
 
   /* Some after-process updates.
    * This is a bit ugly, but cannot see a way to avoid it.
@@ -555,6 +582,211 @@ void BKE_libblock_remap(Main *bmain, void *old_idv, void *new_idv, const short r
   BKE_main_unlock(bmain);
 }
 
+typedef struct IDRemapMultiple {
+  IDRemap *remaps;
+  int remaps_len;
+  /** Maps old IDs to their #IDRemap data. */
+  GHash *remap_by_old_id;
+  /** Types of the old IDs, to skip IDs which cannot use any of them. */
+  short old_id_types[INDEX_ID_MAX];
+  int old_id_types_len;
+  int foreach_id_flags;
+} IDRemapMultiple;
+
+static int foreach_libblock_remap_multiple_callback(LibraryIDLinkCallbackData *cb_data)
+{
+  ID **id_p = cb_data->id_pointer;
+  if (*id_p == NULL || (cb_data->cb_flag & IDWALK_CB_EMBEDDED)) {
+    return IDWALK_RET_NOP;
+  }
+
+  IDRemapMultiple *id_remap_multiple = cb_data->user_data;
+  IDRemap *id_remap_data = BLI_ghash_lookup(id_remap_multiple->remap_by_old_id, *id_p);
+  if (id_remap_data == NULL) {
+    return IDWALK_RET_NOP;
+  }
+
+  /* Process the pointer exactly like a single remap of that ID would. */
+  LibraryIDLinkCallbackData remap_cb_data = *cb_data;
+  remap_cb_data.user_data = id_remap_data;
+  id_remap_data->id_owner = cb_data->id_owner;
+  return foreach_libblock_remap_callback(&remap_cb_data);
+}
+
+static void libblock_remap_multiple_init(IDRemapMultiple *id_remap_multiple,
+                                         Main *bmain,
+                                         ID **old_ids,
+                                         ID **new_ids,
+                                         const int ids_len,
+                                         const short remap_flags)
+{
+  id_remap_multiple->remaps = MEM_calloc_arrayN(ids_len, sizeof(IDRemap), __func__);
+  id_remap_multiple->remaps_len = ids_len;
+  id_remap_multiple->remap_by_old_id = BLI_ghash_ptr_new_ex(__func__, (uint)ids_len);
+  id_remap_multiple->old_id_types_len = 0;
+  id_remap_multiple->foreach_id_flags = (remap_flags & ID_REMAP_NO_INDIRECT_PROXY_DATA_USAGE) ?
+                                            IDWALK_NO_INDIRECT_PROXY_DATA_USAGE :
+                                            IDWALK_NOP;
+
+  uint64_t old_id_filter = 0;
+  for (int i = 0; i < ids_len; i++) {
+    ID *old_id = old_ids[i];
+    ID *new_id = new_ids ? new_ids[i] : NULL;
+    BLI_assert(old_id != NULL);
+    BLI_assert((new_id == NULL) || GS(old_id->name) == GS(new_id->name));
+    BLI_assert(old_id != new_id);
+
+    IDRemap *id_remap_data = &id_remap_multiple->remaps[i];
+    id_remap_data->bmain = bmain;
+    id_remap_data->old_id = old_id;
+    id_remap_data->new_id = new_id;
+    id_remap_data->flag = remap_flags;
+    BLI_ghash_insert(id_remap_multiple->remap_by_old_id, old_id, id_remap_data);
+
+    const uint64_t id_filter = BKE_idtype_idcode_to_idfilter(GS(old_id->name));
+    if ((old_id_filter & id_filter) == 0) {
+      old_id_filter |= id_filter;
+      id_remap_multiple->old_id_types[id_remap_multiple->old_id_types_len++] = GS(old_id->name);
+    }
+  }
+}
+
+static void libblock_remap_multiple_free(IDRemapMultiple *id_remap_multiple)
+{
+  BLI_ghash_free(id_remap_multiple->remap_by_old_id, NULL, NULL);
+  MEM_freeN(id_remap_multiple->remaps);
+}
+
+/** Remap all the ID pointers of \a id_owner. */
+static void libblock_remap_multiple_id(IDRemapMultiple *id_remap_multiple, ID *id_owner)
+{
+  int i;
+  for (i = 0; i < id_remap_multiple->old_id_types_len; i++) {
+    if (BKE_library_id_can_use_idtype(id_owner, id_remap_multiple->old_id_types[i])) {
+      break;
+    }
+  }
+  if (i == id_remap_multiple->old_id_types_len) {
+    return;
+  }
+
+  if (GS(id_owner->name) == ID_OB) {
+    /* Same as #libblock_remap_data_preprocess, for any remapped armature. */
+    Object *ob = (Object *)id_owner;
+    if (ob->pose && ob->data &&
+        BLI_ghash_haskey(id_remap_multiple->remap_by_old_id, (ID *)ob->data)) {
+      BLI_assert(ob->type == OB_ARMATURE);
+      ob->pose->flag |= POSE_RECALC;
+      BKE_pose_clear_pointers(ob->pose);
+    }
+  }
+
+  BKE_library_foreach_ID_link(NULL,
+                              id_owner,
+                              foreach_libblock_remap_multiple_callback,
+                              id_remap_multiple,
+                              id_remap_multiple->foreach_id_flags);
+}
+
+/**
+ * Same as calling #BKE_libblock_remap_locked for every pair of \a old_ids and \a new_ids, but
+ * checks the whole \a bmain database only once, and runs the after-process updates once per
+ * type of ID instead of once per ID.
+ *
+ * \param new_ids: the data-blocks to replace the matching \a old_ids with, may be NULL to unlink
+ * all of \a old_ids.
+ */
+void BKE_libblock_remap_multiple_locked(
+    Main *bmain, ID **old_ids, ID **new_ids, const int ids_len, const short remap_flags)
+{
+  if (ids_len == 0) {
+    return;
+  }
+  if (ids_len == 1) {
+    BKE_libblock_remap_locked(bmain, old_ids[0], new_ids ? new_ids[0] : NULL, remap_flags);
+    return;
+  }
+
+  IDRemapMultiple id_remap_multiple;
+  libblock_remap_multiple_init(&id_remap_multiple, bmain, old_ids, new_ids, ids_len, remap_flags);
+  IDRemap *id_remap_datas = id_remap_multiple.remaps;
+
+  ID *id_curr;
+  FOREACH_MAIN_ID_BEGIN (bmain, id_curr) {
+    libblock_remap_multiple_id(&id_remap_multiple, id_curr);
+  }
+  FOREACH_MAIN_ID_END;
+
+  bool do_object_update = false, do_collection_update = false, do_obdata_relink = false;
+  /* Only whether the new IDs are NULL matters to those updates, see their own comments. */
+  ID *new_object = NULL, *new_collection = NULL;
+  bool has_null_object = false, has_null_collection = false;
+  for (int i = 0; i < ids_len; i++) {
+    IDRemap *id_remap_data = &id_remap_datas[i];
+    libblock_remap_data_finalize(id_remap_data);
+    libblock_remap_old_id_finalize(id_remap_data);
+
+    switch (GS(id_remap_data->old_id->name)) {
+      case ID_OB:
+        do_object_update = true;
+        has_null_object |= id_remap_data->new_id == NULL;
+        new_object = id_remap_data->new_id;
+        break;
+      case ID_GR:
+        do_collection_update = true;
+        has_null_collection |= id_remap_data->new_id == NULL;
+        new_collection = id_remap_data->new_id;
+        break;
+      case ID_ME:
+      case ID_CU:
+      case ID_MB:
+      case ID_HA:
+      case ID_PT:
+      case ID_VO:
+        do_obdata_relink |= id_remap_data->new_id != NULL;
+        break;
+      default:
+        break;
+    }
+  }
+
+  /* Same after-process updates as #BKE_libblock_remap_locked, but only once per type.
+   * Passing a NULL old ID checks the whole Main database. */
+  if (do_object_update) {
+    libblock_remap_data_postprocess_object_update(
+        bmain, NULL, has_null_object ? NULL : (Object *)new_object);
+  }
+  if (do_collection_update) {
+    libblock_remap_data_postprocess_collection_update(
+        bmain, NULL, has_null_collection ? NULL : (Collection *)new_collection);
+  }
+  if (do_obdata_relink) {
+    GSet *new_obdatas = BLI_gset_ptr_new(__func__);
+    for (int i = 0; i < ids_len; i++) {
+      if (id_remap_datas[i].new_id != NULL) {
+        BLI_gset_add(new_obdatas, id_remap_datas[i].new_id);
+      }
+    }
+    for (Object *ob = bmain->objects.first; ob; ob = ob->id.next) {
+      if (ob->data && BLI_gset_haskey(new_obdatas, ob->data)) {
+        libblock_remap_data_postprocess_obdata_relink(bmain, ob, ob->data);
+      }
+    }
+    BLI_gset_free(new_obdatas, NULL);
+  }
+
+  /* See #BKE_libblock_remap_locked for why Main has to be unlocked here. */
+  BKE_main_unlock(bmain);
+  for (int i = 0; i < ids_len; i++) {
+    libblock_remap_data_postprocess_nodetree_update(bmain, id_remap_datas[i].new_id);
+  }
+  BKE_main_lock(bmain);
+
+  DEG_relations_tag_update(bmain);
+
+  libblock_remap_multiple_free(&id_remap_multiple);
+}
+
 /**
  * Unlink given \a id from given \a bmain
  * (does not touch to indirect, i.e. library, usages of the ID).
@@ -654,6 +886,87 @@ void BKE_libblock_relink_ex(
   DEG_relations_tag_update(bmain);
 }
 
+/**
+ * Same as calling #BKE_libblock_relink_ex on every ID of \a ids for every pair of \a old_ids
+ * and \a new_ids, but only walks the ID pointers of each ID once, and runs the after-process
+ * updates once for all of them.
+ */
+void BKE_libblock_relink_multiple(Main *bmain,
+                                  ID **ids,
+                                  const int ids_len,
+                                  ID **old_ids,
+                                  ID **new_ids,
+                                  const int remap_len,
+                                  const short remap_flags)
+{
+  if (ids_len == 0 || remap_len == 0) {
+    return;
+  }
+
+  /* No need to lock here, we are only affecting given IDs, not bmain database. */
+
+  IDRemapMultiple id_remap_multiple;
+  libblock_remap_multiple_init(
+      &id_remap_multiple, bmain, old_ids, new_ids, remap_len, remap_flags);
+
+  bool do_scene_collection_update = false, do_obdata_relink = false;
+  for (int i = 0; i < ids_len; i++) {
+    libblock_remap_multiple_id(&id_remap_multiple, ids[i]);
+    do_scene_collection_update |= ELEM(GS(ids[i]->name), ID_SCE, ID_GR);
+    do_obdata_relink |= GS(ids[i]->name) == ID_OB;
+  }
+
+  bool has_object = false, has_collection = false;
+  bool has_null_object = false, has_null_collection = false;
+  ID *new_object = NULL, *new_collection = NULL;
+  for (int i = 0; i < remap_len; i++) {
+    IDRemap *id_remap_data = &id_remap_multiple.remaps[i];
+    libblock_remap_data_finalize(id_remap_data);
+
+    if (GS(id_remap_data->old_id->name) == ID_OB) {
+      has_object = true;
+      has_null_object |= id_remap_data->new_id == NULL;
+      new_object = id_remap_data->new_id;
+    }
+    else if (GS(id_remap_data->old_id->name) == ID_GR) {
+      has_collection = true;
+      has_null_collection |= id_remap_data->new_id == NULL;
+      new_collection = id_remap_data->new_id;
+    }
+  }
+
+  /* Same after-process updates as #BKE_libblock_relink_ex. */
+  if (do_scene_collection_update) {
+    if (has_object) {
+      libblock_remap_data_postprocess_object_update(
+          bmain, NULL, has_null_object ? NULL : (Object *)new_object);
+    }
+    if (has_collection) {
+      libblock_remap_data_postprocess_collection_update(
+          bmain, NULL, has_null_collection ? NULL : (Collection *)new_collection);
+    }
+  }
+  if (do_obdata_relink && new_ids != NULL) {
+    GSet *new_obdatas = BLI_gset_ptr_new(__func__);
+    for (int i = 0; i < remap_len; i++) {
+      if (new_ids[i] != NULL) {
+        BLI_gset_add(new_obdatas, new_ids[i]);
+      }
+    }
+    for (int i = 0; i < ids_len; i++) {
+      Object *ob = (Object *)ids[i];
+      if (GS(ob->id.name) == ID_OB && ob->data && BLI_gset_haskey(new_obdatas, ob->data)) {
+        libblock_remap_data_postprocess_obdata_relink(bmain, ob, ob->data);
+      }
+    }
+    BLI_gset_free(new_obdatas, NULL);
+  }
+
+  DEG_relations_tag_update(bmain);
+
+  libblock_remap_multiple_free(&id_remap_multiple);
+}
+
 static int id_relink_to_newid_looper(LibraryIDLinkCallbackData *cb_data)
 {
   const int cb_flag = cb_data->cb_flag;
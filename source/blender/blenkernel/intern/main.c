@@ -38,6 +38,7 @@
 #include "BKE_lib_id.h"
 #include "BKE_lib_query.h"
 #include "BKE_main.h"
+#include "BKE_main_namemap.h"
 
 #include "IMB_imbuf.h"
 #include "IMB_imbuf_types.h"
@@ -193,6 +194,7 @@ void BKE_main_free(Main *mainvar)
   if (mainvar->relations) {
     BKE_main_relations_free(mainvar);
   }
+  BKE_main_namemap_clear(mainvar);
 
   BLI_spin_end((SpinLock *)mainvar->lock);
   MEM_freeN(mainvar->lock);
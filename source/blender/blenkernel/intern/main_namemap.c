@@ -0,0 +1,202 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_ghash.h"
+#include "BLI_listbase.h"
+#include "BLI_string.h"
+#include "BLI_string_utils.h"
+#include "BLI_utildefines.h"
+
+#include "DNA_ID.h"
+
+#include "BKE_idtype.h"
+#include "BKE_lib_id.h"
+#include "BKE_main.h"
+#include "BKE_main_namemap.h" /* own include */
+
+/** \file
+ * \ingroup bke
+ *
+ * Utility functions for faster generation of unique ID names.
+ */
+
+/* -------------------------------------------------------------------- */
+/** \name BKE_main_namemap API
+ *
+ * \note GHash's are initialized on demand, since only a few types of IDs are typically created
+ * while the map exists.
+ * \{ */
+
+struct MainNameMap_Type {
+  /** Name of local IDs (``ID.name + 2``) to the ID using it. Keys are owned by the map. */
+  GHash *id_by_name;
+  /** Reverse mapping, values are the keys of #id_by_name. */
+  GHash *name_by_id;
+  /**
+   * Base name (the name without its number suffix) to the smallest number which may be unused
+   * for that base name, to avoid checking all the numbers from the start every time.
+   * Keys are owned by the map, values are integers stored as pointers.
+   */
+  GHash *number_hint_by_base_name;
+};
+
+struct MainNameMap {
+  struct MainNameMap_Type type_maps[INDEX_ID_MAX];
+};
+
+void BKE_main_namemap_ensure(Main *bmain)
+{
+  if (bmain->name_map == NULL) {
+    bmain->name_map = MEM_callocN(sizeof(*bmain->name_map), __func__);
+  }
+}
+
+void BKE_main_namemap_clear(Main *bmain)
+{
+  struct MainNameMap *name_map = bmain->name_map;
+  if (name_map == NULL) {
+    return;
+  }
+  for (int i = 0; i < INDEX_ID_MAX; i++) {
+    struct MainNameMap_Type *type_map = &name_map->type_maps[i];
+    if (type_map->id_by_name != NULL) {
+      BLI_ghash_free(type_map->name_by_id, NULL, NULL);
+      BLI_ghash_free(type_map->id_by_name, MEM_freeN, NULL);
+      BLI_ghash_free(type_map->number_hint_by_base_name, MEM_freeN, NULL);
+    }
+  }
+  MEM_freeN(name_map);
+  bmain->name_map = NULL;
+}
+
+static void main_namemap_type_add_id(struct MainNameMap_Type *type_map, ID *id)
+{
+  void **name_p, **id_p;
+  if (BLI_ghash_ensure_p_ex(type_map->id_by_name, id->name + 2, &name_p, &id_p)) {
+    /* Name is already used by another ID, only keep the first one like name lookups do. */
+    return;
+  }
+  char *name = BLI_strdup(id->name + 2);
+  *name_p = name;
+  *id_p = id;
+  BLI_ghash_insert(type_map->name_by_id, id, name);
+}
+
+/** Return the map of given ID type, building it on first access. */
+static struct MainNameMap_Type *main_namemap_type_get(Main *bmain, const short id_type)
+{
+  struct MainNameMap *name_map = bmain->name_map;
+  if (name_map == NULL) {
+    return NULL;
+  }
+  struct MainNameMap_Type *type_map =
+      &name_map->type_maps[BKE_idtype_idcode_to_index(id_type)];
+
+  /* Lazy init. */
+  if (type_map->id_by_name == NULL) {
+    ListBase *lb = which_libbase(bmain, id_type);
+    const uint lb_len = (uint)BLI_listbase_count(lb);
+    type_map->id_by_name = BLI_ghash_str_new_ex(__func__, lb_len);
+    type_map->name_by_id = BLI_ghash_ptr_new_ex(__func__, lb_len);
+    type_map->number_hint_by_base_name = BLI_ghash_str_new(__func__);
+
+    LISTBASE_FOREACH (ID *, id, lb) {
+      if (!ID_IS_LINKED(id)) {
+        main_namemap_type_add_id(type_map, id);
+      }
+    }
+  }
+  return type_map;
+}
+
+/** Whether a local ID of given type uses given name. */
+bool BKE_main_namemap_has_name(Main *bmain, const short id_type, const char *name)
+{
+  struct MainNameMap_Type *type_map = main_namemap_type_get(bmain, id_type);
+  BLI_assert(type_map != NULL);
+  return BLI_ghash_haskey(type_map->id_by_name, name);
+}
+
+/** Register the current name of given local ID, which is assumed to be in Main. */
+void BKE_main_namemap_add_id(Main *bmain, ID *id)
+{
+  BLI_assert(!ID_IS_LINKED(id));
+  struct MainNameMap_Type *type_map = main_namemap_type_get(bmain, GS(id->name));
+  if (type_map == NULL) {
+    return;
+  }
+  /* Remove the previous name of this ID first, the ID may have been renamed directly. */
+  BKE_main_namemap_remove_id(bmain, id);
+  main_namemap_type_add_id(type_map, id);
+}
+
+/** Unregister the name of given ID, to be called when it is renamed or removed from Main. */
+void BKE_main_namemap_remove_id(Main *bmain, ID *id)
+{
+  if (bmain->name_map == NULL) {
+    return;
+  }
+  struct MainNameMap_Type *type_map =
+      &bmain->name_map->type_maps[BKE_idtype_idcode_to_index(GS(id->name))];
+  if (type_map->id_by_name == NULL) {
+    return;
+  }
+  char *name = BLI_ghash_popkey(type_map->name_by_id, id, NULL);
+  if (name == NULL) {
+    return;
+  }
+
+  /* Numbers below the hint have to be checked again, now that this one may be unused. */
+  char base_name[MAX_ID_NAME - 2];
+  int number;
+  BLI_split_name_num(base_name, &number, name, '.');
+  void **number_hint_p = BLI_ghash_lookup_p(type_map->number_hint_by_base_name, base_name);
+  if (number_hint_p != NULL && number < POINTER_AS_INT(*number_hint_p)) {
+    *number_hint_p = POINTER_FROM_INT(number);
+  }
+
+  BLI_ghash_remove(type_map->id_by_name, name, MEM_freeN, NULL);
+}
+
+/** Smallest number suffix which may be unused for names with given base name. */
+int BKE_main_namemap_number_hint_get(Main *bmain, const short id_type, const char *base_name)
+{
+  struct MainNameMap_Type *type_map = main_namemap_type_get(bmain, id_type);
+  BLI_assert(type_map != NULL);
+  return POINTER_AS_INT(BLI_ghash_lookup(type_map->number_hint_by_base_name, base_name));
+}
+
+void BKE_main_namemap_number_hint_set(Main *bmain,
+                                      const short id_type,
+                                      const char *base_name,
+                                      const int number)
+{
+  struct MainNameMap_Type *type_map = main_namemap_type_get(bmain, id_type);
+  BLI_assert(type_map != NULL);
+  void **key_p, **number_hint_p;
+  if (!BLI_ghash_ensure_p_ex(
+          type_map->number_hint_by_base_name, base_name, &key_p, &number_hint_p)) {
+    *key_p = BLI_strdup(base_name);
+  }
+  *number_hint_p = POINTER_FROM_INT(number);
+}
+
+/** \} */
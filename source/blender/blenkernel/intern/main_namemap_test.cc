@@ -0,0 +1,107 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 by Blender Foundation.
+ */
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_string.h"
+
+#include "DNA_ID.h"
+
+#include "BKE_idtype.h"
+#include "BKE_lib_id.h"
+#include "BKE_main.h"
+#include "BKE_main_namemap.h"
+
+#include "CLG_log.h"
+
+namespace blender::bke::tests {
+
+class MainNameMapTest : public testing::Test {
+ public:
+  Main *bmain;
+
+  static void SetUpTestSuite()
+  {
+    CLG_init();
+    BKE_idtype_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    CLG_exit();
+  }
+
+  void SetUp() override
+  {
+    bmain = BKE_main_new();
+  }
+
+  void TearDown() override
+  {
+    BKE_main_free(bmain);
+  }
+};
+
+TEST_F(MainNameMapTest, unique_names)
+{
+  BKE_main_namemap_ensure(bmain);
+
+  ID *id_a = static_cast<ID *>(BKE_id_new(bmain, ID_OB, "Cube"));
+  ID *id_b = static_cast<ID *>(BKE_id_new(bmain, ID_OB, "Cube"));
+  ID *id_c = static_cast<ID *>(BKE_id_new(bmain, ID_OB, "Cube"));
+  EXPECT_STREQ(id_a->name + 2, "Cube");
+  EXPECT_STREQ(id_b->name + 2, "Cube.001");
+  EXPECT_STREQ(id_c->name + 2, "Cube.002");
+
+  /* The name of a deleted ID is used again. */
+  BKE_id_free(bmain, id_b);
+  ID *id_d = static_cast<ID *>(BKE_id_new(bmain, ID_OB, "Cube"));
+  EXPECT_STREQ(id_d->name + 2, "Cube.001");
+
+  /* Renaming to an used name, the previous name of the renamed ID is free again. */
+  BKE_libblock_rename(bmain, id_c, "Cube");
+  EXPECT_STREQ(id_c->name + 2, "Cube.002");
+  BKE_libblock_rename(bmain, id_c, "Sphere");
+  EXPECT_STREQ(id_c->name + 2, "Sphere");
+  ID *id_e = static_cast<ID *>(BKE_id_new(bmain, ID_OB, "Cube.001"));
+  EXPECT_STREQ(id_e->name + 2, "Cube.002");
+
+  EXPECT_EQ(BKE_libblock_find_name(bmain, ID_OB, "Cube.001"), id_d);
+  EXPECT_EQ(BKE_libblock_find_name(bmain, ID_OB, "Sphere"), id_c);
+  EXPECT_EQ(BKE_libblock_find_name(bmain, ID_OB, "Cube.003"), nullptr);
+
+  BKE_main_namemap_clear(bmain);
+}
+
+TEST_F(MainNameMapTest, same_names_as_without_map)
+{
+  /* Names existing before the map is created are taken into account. */
+  BKE_id_new(bmain, ID_OB, "Cube");
+  BKE_id_new(bmain, ID_OB, "Cube");
+
+  BKE_main_namemap_ensure(bmain);
+  ID *id = static_cast<ID *>(BKE_id_new(bmain, ID_OB, "Cube"));
+  EXPECT_STREQ(id->name + 2, "Cube.002");
+  BKE_main_namemap_clear(bmain);
+
+  id = static_cast<ID *>(BKE_id_new(bmain, ID_OB, "Cube"));
+  EXPECT_STREQ(id->name + 2, "Cube.003");
+}
+
+}  // namespace blender::bke::tests
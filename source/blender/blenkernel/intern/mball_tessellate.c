@@ -38,6 +38,7 @@
 #include "BLI_math.h"
 #include "BLI_memarena.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_global.h"
@@ -407,23 +408,25 @@ static float densfunc(const MetaElem *ball, float x, float y, float z)
 /**
  * Computes density at given position form all meta-balls which contain this point in their box.
  * Traverses BVH using a queue.
+ *
+ * \param bvh_queue: Storage for the traversal, with room for #PROCESS.bvh_queue_size nodes.
  */
-static float metaball(PROCESS *process, float x, float y, float z)
+static float metaball_ex(PROCESS *process, MetaballBVHNode **bvh_queue, float x, float y, float z)
 {
   float dens = 0.0f;
   unsigned int front = 0, back = 0;
   MetaballBVHNode *node;
 
-  process->bvh_queue[front++] = &process->metaball_bvh;
+  bvh_queue[front++] = &process->metaball_bvh;
 
   while (front != back) {
-    node = process->bvh_queue[back++];
+    node = bvh_queue[back++];
 
     for (int i = 0; i < 2; i++) {
       if ((node->bb[i].min[0] <= x) && (node->bb[i].max[0] >= x) && (node->bb[i].min[1] <= y) &&
           (node->bb[i].max[1] >= y) && (node->bb[i].min[2] <= z) && (node->bb[i].max[2] >= z)) {
         if (node->child[i]) {
-          process->bvh_queue[front++] = node->child[i];
+          bvh_queue[front++] = node->child[i];
         }
         else {
           dens += densfunc(node->bb[i].ml, x, y, z);
@@ -435,6 +438,11 @@ static float metaball(PROCESS *process, float x, float y, float z)
   return process->thresh - dens;
 }
 
+static float metaball(PROCESS *process, float x, float y, float z)
+{
+  return metaball_ex(process, process->bvh_queue, x, y, z);
+}
+
 /**
  * Adds face to indices, expands memory if needed.
  */
@@ -963,14 +971,58 @@ static void addtovertices(PROCESS *process, const float v[3], const float no[3])
  *
  * \note Doesn't do normalization!
  */
-static void vnormal(PROCESS *process, const float point[3], float r_no[3])
+static void vnormal(PROCESS *process,
+                    MetaballBVHNode **bvh_queue,
+                    const float point[3],
+                    float r_no[3])
 {
   const float delta = process->delta;
-  const float f = metaball(process, point[0], point[1], point[2]);
+  const float f = metaball_ex(process, bvh_queue, point[0], point[1], point[2]);
 
-  r_no[0] = metaball(process, point[0] + delta, point[1], point[2]) - f;
-  r_no[1] = metaball(process, point[0], point[1] + delta, point[2]) - f;
-  r_no[2] = metaball(process, point[0], point[1], point[2] + delta) - f;
+  r_no[0] = metaball_ex(process, bvh_queue, point[0] + delta, point[1], point[2]) - f;
+  r_no[1] = metaball_ex(process, bvh_queue, point[0], point[1] + delta, point[2]) - f;
+  r_no[2] = metaball_ex(process, bvh_queue, point[0], point[1], point[2] + delta) - f;
+}
+
+typedef struct VertexNormalTLS {
+  /** Traversal queue of the thread, the one of #PROCESS is only used by the main thread. */
+  MetaballBVHNode **bvh_queue;
+} VertexNormalTLS;
+
+static void vertex_normal_cb(void *__restrict userdata,
+                             const int i,
+                             const TaskParallelTLS *__restrict tls)
+{
+  PROCESS *process = userdata;
+  VertexNormalTLS *tls_data = tls->userdata_chunk;
+  if (tls_data->bvh_queue == NULL) {
+    tls_data->bvh_queue = MEM_malloc_arrayN(
+        process->bvh_queue_size, sizeof(MetaballBVHNode *), __func__);
+  }
+  vnormal(process, tls_data->bvh_queue, process->co[i], process->no[i]);
+}
+
+static void vertex_normal_free(const void *__restrict UNUSED(userdata), void *__restrict chunk)
+{
+  VertexNormalTLS *tls_data = chunk;
+  MEM_SAFE_FREE(tls_data->bvh_queue);
+}
+
+/**
+ * Computes the normals of all vertices from the density field. This is done once all vertices
+ * are known instead of when adding them, so the field evaluations can run in parallel.
+ */
+static void vertex_normals_calc(PROCESS *process)
+{
+  VertexNormalTLS tls_data = {NULL};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  settings.userdata_chunk = &tls_data;
+  settings.userdata_chunk_size = sizeof(tls_data);
+  settings.func_free = vertex_normal_free;
+  BLI_task_parallel_range(0, (int)process->curvertex, process, vertex_normal_cb, &settings);
 }
 #endif /* USE_ACCUM_NORMAL */
 
@@ -990,11 +1042,8 @@ static int vertid(PROCESS *process, const CORNER *c1, const CORNER *c2)
 
   converge(process, c1, c2, v); /* position */
 
-#ifdef USE_ACCUM_NORMAL
+  /* Normals are accumulated from the faces or computed once all vertices are known. */
   zero_v3(no);
-#else
-  vnormal(process, v, no);
-#endif
 
   addtovertices(process, v, no); /* save vertex */
   vid = (int)process->curvertex - 1;
@@ -1166,6 +1215,10 @@ static void polygonize(PROCESS *process)
 
     docube(process, &c);
   }
+
+#ifndef USE_ACCUM_NORMAL
+  vertex_normals_calc(process);
+#endif
 }
 
 /**
@@ -1387,7 +1440,6 @@ void BKE_mball_polygonize(Depsgraph *depsgraph, Scene *scene, Object *ob, ListBa
 {
   MetaBall *mb;
   DispList *dl;
-  unsigned int a;
   PROCESS process = {0};
   bool is_render = DEG_get_mode(depsgraph) == DAG_EVAL_RENDER;
 
@@ -1453,9 +1505,7 @@ void BKE_mball_polygonize(Depsgraph *depsgraph, Scene *scene, Object *ob, ListBa
 
         dl->index = (int *)process.indices;
 
-        for (a = 0; a < process.curvertex; a++) {
-          normalize_v3(process.no[a]);
-        }
+        normalize_v3_array(process.no, (int)process.curvertex);
 
         dl->verts = (float *)process.co;
         dl->nors = (float *)process.no;
@@ -1497,10 +1497,7 @@ void BKE_mesh_transform(Mesh *me, const float mat[4][4], bool do_keys)
   if (do_keys && me->key) {
     KeyBlock *kb;
     for (kb = me->key->block.first; kb; kb = kb->next) {
-      float *fp = kb->data;
-      for (i = kb->totelem; i--; fp += 3) {
-        mul_m4_v3(mat, fp);
-      }
+      mul_m4_v3_array(mat, (float(*)[3])kb->data, kb->totelem);
     }
   }
 
@@ -1760,6 +1757,7 @@ void BKE_mesh_vert_coords_apply(Mesh *mesh, const float (*vert_coords)[3])
     copy_v3_v3(mv->co, vert_coords[i]);
   }
   mesh->runtime.cd_dirty_vert |= CD_MASK_NORMAL;
+  mesh->runtime.cd_dirty_poly |= CD_MASK_NORMAL;
 }
 
 void BKE_mesh_vert_coords_apply_with_mat4(Mesh *mesh,
@@ -1773,6 +1771,7 @@ void BKE_mesh_vert_coords_apply_with_mat4(Mesh *mesh,
     mul_v3_m4v3(mv->co, mat, vert_coords[i]);
   }
   mesh->runtime.cd_dirty_vert |= CD_MASK_NORMAL;
+  mesh->runtime.cd_dirty_poly |= CD_MASK_NORMAL;
 }
 
 void BKE_mesh_vert_normals_apply(Mesh *mesh, const short (*vert_normals)[3])
@@ -1819,9 +1818,8 @@ void BKE_mesh_calc_normals_split_ex(Mesh *mesh, MLoopNorSpaceArray *r_lnors_spac
   clnors = CustomData_get_layer(&mesh->ldata, CD_CUSTOMLOOPNORMAL);
 
   if (CustomData_has_layer(&mesh->pdata, CD_NORMAL)) {
-    /* This assume that layer is always up to date, not sure this is the case
-     * (esp. in Edit mode?)... */
-    polynors = CustomData_get_layer(&mesh->pdata, CD_NORMAL);
+    /* Only recomputed when the positions changed since the layer was last computed. */
+    polynors = BKE_mesh_poly_normals_ensure(mesh);
     free_polynors = false;
   }
   else {
@@ -387,6 +387,38 @@ void BKE_mesh_ensure_normals(Mesh *mesh)
   BLI_assert((mesh->runtime.cd_dirty_vert & CD_MASK_NORMAL) == 0);
 }
 
+/**
+ * Get the #CD_NORMAL poly layer, adding it or recomputing it when the positions changed since it
+ * was last computed. Vertex normals are updated as well when they are dirty, so following
+ * requests for normals on the same mesh don't compute anything.
+ */
+float (*BKE_mesh_poly_normals_ensure(Mesh *mesh))[3]
+{
+  float(*poly_nors)[3] = CustomData_get_layer(&mesh->pdata, CD_NORMAL);
+  if (poly_nors != NULL && (mesh->runtime.cd_dirty_poly & CD_MASK_NORMAL) == 0) {
+    return poly_nors;
+  }
+
+  if (poly_nors == NULL) {
+    poly_nors = CustomData_add_layer(&mesh->pdata, CD_NORMAL, CD_CALLOC, NULL, mesh->totpoly);
+  }
+
+  const bool do_vert_normals = (mesh->runtime.cd_dirty_vert & CD_MASK_NORMAL) != 0;
+  BKE_mesh_calc_normals_poly(mesh->mvert,
+                             NULL,
+                             mesh->totvert,
+                             mesh->mloop,
+                             mesh->mpoly,
+                             mesh->totloop,
+                             mesh->totpoly,
+                             poly_nors,
+                             !do_vert_normals);
+
+  mesh->runtime.cd_dirty_vert &= ~CD_MASK_NORMAL;
+  mesh->runtime.cd_dirty_poly &= ~CD_MASK_NORMAL;
+  return poly_nors;
+}
+
 /**
  * Called after calculating all modifiers.
  */
@@ -444,6 +476,8 @@ void BKE_mesh_calc_normals(Mesh *mesh)
 #ifdef DEBUG_TIME
   TIMEIT_START_AVERAGED(BKE_mesh_calc_normals);
 #endif
+  /* Poly normals are computed anyway, refresh the layer when there is one. */
+  float(*poly_nors)[3] = CustomData_get_layer(&mesh->pdata, CD_NORMAL);
   BKE_mesh_calc_normals_poly(mesh->mvert,
                              NULL,
                              mesh->totvert,
@@ -451,12 +485,15 @@ void BKE_mesh_calc_normals(Mesh *mesh)
                              mesh->mpoly,
                              mesh->totloop,
                              mesh->totpoly,
-                             NULL,
+                             poly_nors,
                              false);
 #ifdef DEBUG_TIME
   TIMEIT_END_AVERAGED(BKE_mesh_calc_normals);
 #endif
   mesh->runtime.cd_dirty_vert &= ~CD_MASK_NORMAL;
+  if (poly_nors) {
+    mesh->runtime.cd_dirty_poly &= ~CD_MASK_NORMAL;
+  }
 }
 
 void BKE_mesh_calc_normals_looptri(MVert *mverts,
@@ -29,12 +29,15 @@
 #include "BLI_bitmap.h"
 #include "BLI_buffer.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_customdata.h"
 #include "BKE_mesh_mapping.h"
 #include "BLI_memarena.h"
 
+#include "atomic_ops.h"
+
 #include "BLI_strict_flags.h"
 
 /* -------------------------------------------------------------------- */
@@ -194,6 +197,60 @@ void BKE_mesh_uv_vert_map_free(UvVertMap *vmap)
   }
 }
 
+typedef struct VertPolyMapData {
+  MeshElemMap *map;
+  int *offsets;
+  const MPoly *mpoly;
+  const MLoop *mloop;
+  bool do_loops;
+} VertPolyMapData;
+
+static void mesh_vert_poly_map_count_cb(void *__restrict userdata,
+                                        const int i,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  VertPolyMapData *data = userdata;
+  const MPoly *p = &data->mpoly[i];
+
+  for (int j = 0; j < p->totloop; j++) {
+    atomic_add_and_fetch_int32(&data->offsets[data->mloop[p->loopstart + j].v], 1);
+  }
+}
+
+static void mesh_vert_poly_map_assign_cb(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  VertPolyMapData *data = userdata;
+  const MPoly *p = &data->mpoly[i];
+
+  for (int j = 0; j < p->totloop; j++) {
+    const unsigned int v = data->mloop[p->loopstart + j].v;
+    const int index = atomic_fetch_and_add_int32(&data->map[v].count, 1);
+
+    data->map[v].indices[index] = data->do_loops ? p->loopstart + j : i;
+  }
+}
+
+static void mesh_vert_poly_map_sort_cb(void *__restrict userdata,
+                                       const int i,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  VertPolyMapData *data = userdata;
+  MeshElemMap *elem = &data->map[i];
+
+  /* Threads add the users of a vertex in any order, restore the order of a serial loop.
+   * The lists are short, so an insertion sort is fine. */
+  for (int j = 1; j < elem->count; j++) {
+    const int index = elem->indices[j];
+    int k = j;
+    for (; k > 0 && elem->indices[k - 1] > index; k--) {
+      elem->indices[k] = elem->indices[k - 1];
+    }
+    elem->indices[k] = index;
+  }
+}
+
 /**
  * Generates a map where the key is the vertex and the value is a list
  * of polys or loops that use that vertex as a corner. The lists are allocated
@@ -210,40 +267,40 @@ static void mesh_vert_poly_or_loop_map_create(MeshElemMap **r_map,
                                               int totloop,
                                               const bool do_loops)
 {
-  MeshElemMap *map = MEM_callocN(sizeof(MeshElemMap) * (size_t)totvert, __func__);
-  int *indices, *index_iter;
-  int i, j;
+  MeshElemMap *map = MEM_malloc_arrayN((size_t)totvert, sizeof(MeshElemMap), __func__);
+  int *indices = MEM_mallocN(sizeof(int) * (size_t)totloop, __func__);
+  int *offsets = MEM_calloc_arrayN((size_t)totvert, sizeof(int), __func__);
+  int i;
 
-  indices = index_iter = MEM_mallocN(sizeof(int) * (size_t)totloop, __func__);
+  VertPolyMapData data = {
+      .map = map,
+      .offsets = offsets,
+      .mpoly = mpoly,
+      .mloop = mloop,
+      .do_loops = do_loops,
+  };
 
-  /* Count number of polys for each vertex */
-  for (i = 0; i < totpoly; i++) {
-    const MPoly *p = &mpoly[i];
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (totloop > 10000);
+  settings.min_iter_per_thread = 1024;
 
-    for (j = 0; j < p->totloop; j++) {
-      map[mloop[p->loopstart + j].v].count++;
-    }
-  }
+  /* Count number of polys for each vertex */
+  BLI_task_parallel_range(0, totpoly, &data, mesh_vert_poly_map_count_cb, &settings);
 
   /* Assign indices mem */
+  BLI_task_parallel_prefix_sum_i(offsets, totvert);
   for (i = 0; i < totvert; i++) {
-    map[i].indices = index_iter;
-    index_iter += map[i].count;
-
+    map[i].indices = indices + offsets[i];
     /* Reset 'count' for use as index in last loop */
     map[i].count = 0;
   }
+  MEM_freeN(offsets);
 
   /* Find the users */
-  for (i = 0; i < totpoly; i++) {
-    const MPoly *p = &mpoly[i];
-
-    for (j = 0; j < p->totloop; j++) {
-      unsigned int v = mloop[p->loopstart + j].v;
-
-      map[v].indices[map[v].count] = do_loops ? p->loopstart + j : i;
-      map[v].count++;
-    }
+  BLI_task_parallel_range(0, totpoly, &data, mesh_vert_poly_map_assign_cb, &settings);
+  if (settings.use_threading) {
+    BLI_task_parallel_range(0, totvert, &data, mesh_vert_poly_map_sort_cb, &settings);
   }
 
   *r_map = map;
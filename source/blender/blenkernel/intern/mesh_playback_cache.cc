@@ -0,0 +1,180 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bke
+ *
+ * Deformed vertex positions are stored per object (by session UUID) and evaluation time.
+ * All entries are dropped as soon as any ID is tagged for update by the user, since from then on
+ * the evaluated result for a frame can differ. Entries are only added while the cache is within
+ * the memory cache limit from the preferences, so with a range which doesn't fit the first part
+ * of it stays cached, instead of every frame being evicted before it is played again.
+ */
+
+#include <cstring>
+#include <mutex>
+
+#include "MEM_guardedalloc.h"
+
+#include "DNA_modifier_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
+
+#include "BLI_hash.hh"
+#include "BLI_listbase.h"
+#include "BLI_map.hh"
+#include "BLI_utildefines.h"
+
+#include "BKE_mesh_playback_cache.h"
+#include "BKE_modifier.h"
+
+#include "DEG_depsgraph.h"
+#include "DEG_depsgraph_query.h"
+
+using blender::Map;
+
+namespace {
+
+struct PlaybackCacheKey {
+  uint session_uuid;
+  float ctime;
+
+  uint64_t hash() const
+  {
+    return blender::DefaultHash<uint>{}(session_uuid) * 33 ^
+           blender::DefaultHash<float>{}(ctime);
+  }
+
+  friend bool operator==(const PlaybackCacheKey &a, const PlaybackCacheKey &b)
+  {
+    return a.session_uuid == b.session_uuid && a.ctime == b.ctime;
+  }
+};
+
+struct PlaybackCacheEntry {
+  float (*vert_coords)[3];
+  int verts_len;
+};
+
+struct PlaybackCache {
+  std::mutex mutex;
+  Map<PlaybackCacheKey, PlaybackCacheEntry> entries;
+  size_t memory_in_use = 0;
+  /* User edit counter of the dependency graph at the time the entries were created. */
+  uint user_edit_count = 0;
+};
+
+PlaybackCache &playback_cache()
+{
+  static PlaybackCache cache;
+  return cache;
+}
+
+void playback_cache_clear_locked(PlaybackCache &cache)
+{
+  for (PlaybackCacheEntry &entry : cache.entries.values()) {
+    MEM_freeN(entry.vert_coords);
+  }
+  cache.entries.clear();
+  cache.memory_in_use = 0;
+}
+
+/* Drop all entries if anything was edited since they were created. */
+void playback_cache_validate_locked(PlaybackCache &cache)
+{
+  const uint user_edit_count = DEG_get_user_edit_count();
+  if (cache.user_edit_count != user_edit_count) {
+    playback_cache_clear_locked(cache);
+    cache.user_edit_count = user_edit_count;
+  }
+}
+
+PlaybackCacheKey playback_cache_key(const Depsgraph *depsgraph, const Object *ob)
+{
+  /* Evaluated objects are replaced on copy-on-write updates, the original one stays. */
+  const ID *id_orig = (ob->id.orig_id != nullptr) ? ob->id.orig_id : &ob->id;
+  return {id_orig->session_uuid, DEG_get_ctime(depsgraph)};
+}
+
+}  // namespace
+
+bool BKE_mesh_playback_cache_use(const Depsgraph *depsgraph, const Scene *scene, const Object *ob)
+{
+  if ((scene->flag & SCE_PLAYBACK_GEOMETRY_CACHE) == 0 || !DEG_is_active(depsgraph)) {
+    return false;
+  }
+  /* Edit and paint modes use the deformed positions in other ways. */
+  if (ob->mode != OB_MODE_OBJECT) {
+    return false;
+  }
+  /* Simulations and other modifiers reading the time have state besides the positions. */
+  LISTBASE_FOREACH (ModifierData *, md, &ob->modifiers) {
+    const ModifierTypeInfo *mti = BKE_modifier_get_info((ModifierType)md->type);
+    if (mti->dependsOnTime && mti->dependsOnTime(md)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+float (*BKE_mesh_playback_cache_lookup(const Depsgraph *depsgraph,
+                                       const Object *ob,
+                                       int verts_len))[3]
+{
+  PlaybackCache &cache = playback_cache();
+  std::lock_guard lock(cache.mutex);
+  playback_cache_validate_locked(cache);
+
+  const PlaybackCacheEntry *entry = cache.entries.lookup_ptr(playback_cache_key(depsgraph, ob));
+  if (entry == nullptr || entry->verts_len != verts_len) {
+    return nullptr;
+  }
+  return (float(*)[3])MEM_dupallocN(entry->vert_coords);
+}
+
+void BKE_mesh_playback_cache_store(const Depsgraph *depsgraph,
+                                   const Object *ob,
+                                   const float (*vert_coords)[3],
+                                   int verts_len)
+{
+  const size_t size = sizeof(float[3]) * (size_t)verts_len;
+
+  PlaybackCache &cache = playback_cache();
+  std::lock_guard lock(cache.mutex);
+  playback_cache_validate_locked(cache);
+
+  if (cache.memory_in_use + size > (size_t)U.memcachelimit * 1024 * 1024) {
+    return;
+  }
+
+  const PlaybackCacheKey key = playback_cache_key(depsgraph, ob);
+  if (cache.entries.contains(key)) {
+    return;
+  }
+
+  float(*vert_coords_copy)[3] = (float(*)[3])MEM_mallocN(size, __func__);
+  memcpy(vert_coords_copy, vert_coords, size);
+  cache.entries.add_new(key, {vert_coords_copy, verts_len});
+  cache.memory_in_use += size;
+}
+
+void BKE_mesh_playback_cache_clear(void)
+{
+  PlaybackCache &cache = playback_cache();
+  std::lock_guard lock(cache.mutex);
+  playback_cache_clear_locked(cache);
+}
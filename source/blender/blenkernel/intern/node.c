@@ -584,6 +584,7 @@ void ntreeBlendReadData(BlendDataReader *reader, bNodeTree *ntree)
   BLO_read_list(reader, &ntree->nodes);
   LISTBASE_FOREACH (bNode *, node, &ntree->nodes) {
     node->typeinfo = NULL;
+    memset(&node->exec_stats, 0, sizeof(node->exec_stats));
 
     BLO_read_list(reader, &node->inputs);
     BLO_read_list(reader, &node->outputs);
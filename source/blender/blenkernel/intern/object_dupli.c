@@ -818,6 +818,15 @@ static void make_duplis_instances_component(const DupliContext *ctx)
   InstancedData *instanced_data;
   const int amount = BKE_geometry_set_instances(
       ctx->object->runtime.geometry_set_eval, &instance_offset_matrices, &ids, &instanced_data);
+  if (amount == 0) {
+    return;
+  }
+
+  /* Transform all instances into world space at once, which can be done in parallel. */
+  float(*instance_matrices)[4][4] = MEM_malloc_arrayN(
+      (size_t)amount, sizeof(*instance_matrices), __func__);
+  BKE_geometry_set_instances_world_transforms(
+      ctx->object->runtime.geometry_set_eval, ctx->object->obmat, instance_matrices);
 
   for (int i = 0; i < amount; i++) {
     InstancedData *data = &instanced_data[i];
@@ -827,13 +836,10 @@ static void make_duplis_instances_component(const DupliContext *ctx)
     if (data->type == INSTANCE_DATA_TYPE_OBJECT) {
       Object *object = data->data.object;
       if (object != NULL) {
-        float matrix[4][4];
-        mul_m4_m4m4(matrix, ctx->object->obmat, instance_offset_matrices[i]);
-        make_dupli(ctx, object, matrix, id);
+        make_dupli(ctx, object, instance_matrices[i], id);
 
         float space_matrix[4][4];
-        mul_m4_m4m4(space_matrix, instance_offset_matrices[i], object->imat);
-        mul_m4_m4_pre(space_matrix, ctx->object->obmat);
+        mul_m4_m4m4(space_matrix, instance_matrices[i], object->imat);
         make_recursive_duplis(ctx, object, space_matrix, id);
       }
     }
@@ -843,8 +849,7 @@ static void make_duplis_instances_component(const DupliContext *ctx)
         float collection_matrix[4][4];
         unit_m4(collection_matrix);
         sub_v3_v3(collection_matrix[3], collection->instance_offset);
-        mul_m4_m4_pre(collection_matrix, instance_offset_matrices[i]);
-        mul_m4_m4_pre(collection_matrix, ctx->object->obmat);
+        mul_m4_m4_pre(collection_matrix, instance_matrices[i]);
 
         eEvaluationMode mode = DEG_get_mode(ctx->depsgraph);
         FOREACH_COLLECTION_VISIBLE_OBJECT_RECURSIVE_BEGIN (collection, object, mode) {
@@ -862,6 +867,8 @@ static void make_duplis_instances_component(const DupliContext *ctx)
       }
     }
   }
+
+  MEM_freeN(instance_matrices);
 }
 
 static const DupliGenerator gen_dupli_instances_component = {
@@ -38,15 +38,19 @@ typedef struct TseGroup {
   int lastused;
   int size;
   int allocated;
+  /* Storage for the common single element case, avoids a second allocation per group. */
+  TreeStoreElem *elem_single;
 } TseGroup;
 
 /* Allocate structure for TreeStoreElements;
  * Most of elements in treestore have no duplicates,
- * so there is no need to preallocate memory for more than one pointer */
+ * so there is no need to preallocate memory for more than one pointer.
+ * With many IDs the tree-hash is rebuilt with one group per element,
+ * so the single pointer is stored inline in the group. */
 static TseGroup *tse_group_create(void)
 {
   TseGroup *tse_group = MEM_mallocN(sizeof(TseGroup), "TseGroup");
-  tse_group->elems = MEM_mallocN(sizeof(TreeStoreElem *), "TseGroupElems");
+  tse_group->elems = &tse_group->elem_single;
   tse_group->size = 0;
   tse_group->allocated = 1;
   tse_group->lastused = 0;
@@ -57,8 +61,15 @@ static void tse_group_add_element(TseGroup *tse_group, TreeStoreElem *elem)
 {
   if (UNLIKELY(tse_group->size == tse_group->allocated)) {
     tse_group->allocated *= 2;
-    tse_group->elems = MEM_reallocN(tse_group->elems,
-                                    sizeof(TreeStoreElem *) * tse_group->allocated);
+    if (tse_group->elems == &tse_group->elem_single) {
+      tse_group->elems = MEM_mallocN(sizeof(TreeStoreElem *) * tse_group->allocated,
+                                     "TseGroupElems");
+      tse_group->elems[0] = tse_group->elem_single;
+    }
+    else {
+      tse_group->elems = MEM_reallocN(tse_group->elems,
+                                      sizeof(TreeStoreElem *) * tse_group->allocated);
+    }
   }
   tse_group->elems[tse_group->size] = elem;
   tse_group->size++;
@@ -73,9 +84,9 @@ static void tse_group_remove_element(TseGroup *tse_group, TreeStoreElem *elem)
   BLI_assert(tse_group->size >= 0);
   for (int i = 0; i < tse_group->size; i++) {
     if (tse_group->elems[i] == elem) {
-      memcpy(tse_group->elems[i],
-             tse_group->elems[i + 1],
-             (tse_group->size - (i + 1)) * sizeof(TreeStoreElem *));
+      memmove(&tse_group->elems[i],
+              &tse_group->elems[i + 1],
+              (tse_group->size - i) * sizeof(TreeStoreElem *));
       break;
     }
   }
@@ -89,7 +100,9 @@ static void tse_group_remove_element(TseGroup *tse_group, TreeStoreElem *elem)
 
 static void tse_group_free(TseGroup *tse_group)
 {
-  MEM_freeN(tse_group->elems);
+  if (tse_group->elems != &tse_group->elem_single) {
+    MEM_freeN(tse_group->elems);
+  }
   MEM_freeN(tse_group);
 }
 
@@ -2806,8 +2806,23 @@ static void psys_task_init_path(ParticleTask *task, ParticleSimulationData *sim)
   task->rng_path = BLI_rng_new(seed);
 }
 
+/**
+ * Emitter data of parent particles, which is the same for all of their children. Children of
+ * the same parent are next to each other, so only the last used parent is kept.
+ */
+typedef struct ChildPathParentCache {
+  /** Parent of the last simple child, with its original coordinates and hair matrix. */
+  const ParticleData *pa;
+  float orco[3];
+  float hairmat[4][4];
+  /** Parent whose original coordinates were last used for the child modifiers. */
+  const ParticleData *par_pa;
+  float par_orco[3];
+} ChildPathParentCache;
+
 /* note: this function must be thread safe, except for branching! */
 static void psys_thread_create_path(ParticleTask *task,
+                                    ChildPathParentCache *parent_cache,
                                     struct ChildParticle *cpa,
                                     ParticleCacheKey *child_keys,
                                     int i)
@@ -2972,19 +2987,25 @@ static void psys_thread_create_path(ParticleTask *task,
     }
     cpa_fuv = pa->fuv;
 
-    psys_particle_on_emitter(ctx->sim.psmd,
-                             cpa_from,
-                             cpa_num,
-                             DMCACHE_ISCHILD,
-                             cpa_fuv,
-                             pa->foffset,
-                             co,
-                             0,
-                             0,
-                             0,
-                             orco);
+    if (parent_cache->pa != pa) {
+      psys_particle_on_emitter(ctx->sim.psmd,
+                               cpa_from,
+                               cpa_num,
+                               DMCACHE_ISCHILD,
+                               cpa_fuv,
+                               pa->foffset,
+                               co,
+                               0,
+                               0,
+                               0,
+                               parent_cache->orco);
 
-    psys_mat_hair_to_global(ob, ctx->sim.psmd->mesh_final, psys->part->from, pa, hairmat);
+      psys_mat_hair_to_global(
+          ob, ctx->sim.psmd->mesh_final, psys->part->from, pa, parent_cache->hairmat);
+      parent_cache->pa = pa;
+    }
+    copy_v3_v3(orco, parent_cache->orco);
+    copy_m4_m4(hairmat, parent_cache->hairmat);
   }
 
   child_keys->segments = ctx->segments;
@@ -3113,17 +3134,21 @@ static void psys_thread_create_path(ParticleTask *task,
       ListBase modifiers;
       BLI_listbase_clear(&modifiers);
 
-      psys_particle_on_emitter(ctx->sim.psmd,
-                               part->from,
-                               pa->num,
-                               pa->num_dmcache,
-                               pa->fuv,
-                               pa->foffset,
-                               par_co,
-                               NULL,
-                               NULL,
-                               NULL,
-                               par_orco);
+      if (parent_cache->par_pa != pa) {
+        psys_particle_on_emitter(ctx->sim.psmd,
+                                 part->from,
+                                 pa->num,
+                                 pa->num_dmcache,
+                                 pa->fuv,
+                                 pa->foffset,
+                                 par_co,
+                                 NULL,
+                                 NULL,
+                                 NULL,
+                                 parent_cache->par_orco);
+        parent_cache->par_pa = pa;
+      }
+      copy_v3_v3(par_orco, parent_cache->par_orco);
 
       psys_apply_child_modifiers(
           ctx, &modifiers, cpa, &ptex, orco, hairmat, child_keys, par, par_orco);
@@ -3146,12 +3171,13 @@ static void exec_child_path_cache(TaskPool *__restrict UNUSED(pool), void *taskd
   ParticleSystem *psys = ctx->sim.psys;
   ParticleCacheKey **cache = psys->childcache;
   ChildParticle *cpa;
+  ChildPathParentCache parent_cache = {NULL};
   int i;
 
   cpa = psys->child + task->begin;
   for (i = task->begin; i < task->end; i++, cpa++) {
     BLI_assert(i < psys->totchildcache);
-    psys_thread_create_path(task, cpa, cache[i], i);
+    psys_thread_create_path(task, &parent_cache, cpa, cache[i], i);
   }
 }
 
@@ -3715,6 +3715,49 @@ static void dynamics_step_sphdata_reduce(const void *__restrict UNUSED(userdata)
   BLI_buffer_field_free(&sphdata_from->new_springs);
 }
 
+/* Random numbers for brownian motion and noisy force fields are drawn from shared generators, in
+ * the order of the particles, and particles affecting their own system read the state of the
+ * others while it is updated. Only steps without either can run in parallel and give the same
+ * result as the serial loop. */
+static bool dynamics_step_newton_use_threading(ParticleSimulationData *sim)
+{
+  if (sim->psys->part->brownfac != 0.0f) {
+    return false;
+  }
+  if (sim->psys->effectors) {
+    LISTBASE_FOREACH (EffectorCache *, eff, sim->psys->effectors) {
+      if ((eff->pd && eff->pd->f_noise > 0.0f) || eff->psys == sim->psys) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static void dynamics_step_newton_task_cb_ex(void *__restrict userdata,
+                                            const int p,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DynamicStepSolverTaskData *data = userdata;
+  ParticleSimulationData *sim = data->sim;
+  ParticleSystem *psys = sim->psys;
+  ParticleSettings *part = psys->part;
+
+  ParticleData *pa;
+
+  if ((pa = psys->particles + p)->state.time <= 0.0f) {
+    return;
+  }
+
+  /* do global forces & effectors */
+  basic_integrate(sim, p, pa->state.time, data->cfra);
+
+  /* Collision response draws random numbers, deflection and rotation are done afterwards. */
+  if (sim->colliders == NULL) {
+    basic_rotate(part, pa, pa->state.time, data->timestep);
+  }
+}
+
 static void dynamics_step_sph_ddr_task_cb_ex(void *__restrict userdata,
                                              const int p,
                                              const TaskParallelTLS *__restrict tls)
@@ -3946,18 +3989,45 @@ static void dynamics_step(ParticleSimulationData *sim, float cfra)
 
   switch (part->phystype) {
     case PART_PHYS_NEWTON: {
-      LOOP_DYNAMIC_PARTICLES
-      {
-        /* do global forces & effectors */
-        basic_integrate(sim, p, pa->state.time, cfra);
+      if (!dynamics_step_newton_use_threading(sim)) {
+        LOOP_DYNAMIC_PARTICLES
+        {
+          /* do global forces & effectors */
+          basic_integrate(sim, p, pa->state.time, cfra);
 
-        /* deflection */
-        if (sim->colliders) {
-          collision_check(sim, p, pa->state.time, cfra);
+          /* deflection */
+          if (sim->colliders) {
+            collision_check(sim, p, pa->state.time, cfra);
+          }
+
+          /* rotations */
+          basic_rotate(part, pa, pa->state.time, timestep);
         }
+        break;
+      }
 
-        /* rotations */
-        basic_rotate(part, pa, pa->state.time, timestep);
+      DynamicStepSolverTaskData task_data = {
+          .sim = sim,
+          .cfra = cfra,
+          .timestep = timestep,
+          .dtime = dtime,
+      };
+
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.use_threading = (psys->totpart > 100);
+      BLI_task_parallel_range(
+          0, psys->totpart, &task_data, dynamics_step_newton_task_cb_ex, &settings);
+
+      if (sim->colliders) {
+        LOOP_DYNAMIC_PARTICLES
+        {
+          /* deflection */
+          collision_check(sim, p, pa->state.time, cfra);
+
+          /* rotations */
+          basic_rotate(part, pa, pa->state.time, timestep);
+        }
       }
       break;
     }
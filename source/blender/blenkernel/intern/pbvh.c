@@ -134,7 +134,17 @@ static void update_node_vb(PBVH *pbvh, PBVHNode *node)
 
   BB_reset(&vb);
 
-  if (node->flag & PBVH_Leaf) {
+  if ((node->flag & PBVH_Leaf) && pbvh->type == PBVH_FACES) {
+    /* Only positions are needed, read them directly instead of going through the vertex
+     * iterator, which also fetches normals, masks and colors of every vertex. */
+    const MVert *mvert = pbvh->verts;
+    const int *vert_indices = node->vert_indices;
+    const int totvert = node->uniq_verts + node->face_verts;
+    for (int i = 0; i < totvert; i++) {
+      BB_expand(&vb, mvert[vert_indices[i]].co);
+    }
+  }
+  else if (node->flag & PBVH_Leaf) {
     PBVHVertexIter vd;
 
     BKE_pbvh_vertex_iter_begin(pbvh, node, vd, PBVH_ITER_ALL)
@@ -250,56 +260,56 @@ void pbvh_grow_nodes(PBVH *pbvh, int totnode)
   pbvh->totnode = totnode;
 }
 
-/* Add a vertex to the map, with a positive value for unique vertices and
- * a negative value for additional vertices */
-static int map_insert_vert(
-    PBVH *pbvh, GHash *map, unsigned int *face_verts, unsigned int *uniq_verts, int vertex)
-{
-  void *key, **value_p;
-
-  key = POINTER_FROM_INT(vertex);
-  if (!BLI_ghash_ensure_p(map, key, &value_p)) {
-    int value_i;
-    if (BLI_BITMAP_TEST(pbvh->vert_bitmap, vertex) == 0) {
-      BLI_BITMAP_ENABLE(pbvh->vert_bitmap, vertex);
-      value_i = *uniq_verts;
-      (*uniq_verts)++;
-    }
-    else {
-      value_i = ~(*face_verts);
-      (*face_verts)++;
-    }
-    *value_p = POINTER_FROM_INT(value_i);
-    return value_i;
-  }
-
-  return POINTER_AS_INT(*value_p);
-}
+/* -------------------------------------------------------------------- */
+/** \name Leaf Node Data
+ *
+ * Leaf nodes are first created with only their primitives. The data derived from them is filled
+ * in for all leaves at once after partitioning, so it can be done in parallel.
+ *
+ * Every vertex is owned by the first leaf in build order which uses it, these are the unique
+ * vertices of a node. That step depends on the order and is done on one thread, in between
+ * gathering the distinct vertices of each leaf and remapping its faces, which are threaded.
+ * \{ */
 
-/* Find vertices used by the faces in this node and update the draw buffers */
-static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
+typedef struct PBVHLeafBuildData {
+  PBVH *pbvh;
+  PBVHNode **leaves;
+  /* Per leaf, distinct vertices in order of first use. */
+  int **leaf_verts;
+  int *leaf_verts_len;
+  /* Per leaf, the index of each distinct vertex in #PBVHNode.vert_indices. */
+  int **leaf_vert_remap;
+} PBVHLeafBuildData;
+
+/* Find vertices used by the faces in this node, #PBVHNode.face_vert_indices is filled with
+ * indices into the node local vertex list. */
+static void build_mesh_leaf_verts_task_cb(void *__restrict userdata,
+                                          const int n,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  bool has_visible = false;
-
-  node->uniq_verts = node->face_verts = 0;
+  PBVHLeafBuildData *data = userdata;
+  PBVH *pbvh = data->pbvh;
+  PBVHNode *node = data->leaves[n];
   const int totface = node->totprim;
+  bool has_visible = (pbvh->respect_hide == false);
 
   /* reserve size is rough guess */
   GHash *map = BLI_ghash_int_new_ex("build_mesh_leaf_node gh", 2 * totface);
 
   int(*face_vert_indices)[3] = MEM_mallocN(sizeof(int[3]) * totface, "bvh node face vert indices");
-
-  node->face_vert_indices = (const int(*)[3])face_vert_indices;
-
-  if (pbvh->respect_hide == false) {
-    has_visible = true;
-  }
+  int *verts = MEM_mallocN(sizeof(int) * 3 * totface, __func__);
+  int verts_len = 0;
 
   for (int i = 0; i < totface; i++) {
     const MLoopTri *lt = &pbvh->looptri[node->prim_indices[i]];
     for (int j = 0; j < 3; j++) {
-      face_vert_indices[i][j] = map_insert_vert(
-          pbvh, map, &node->face_verts, &node->uniq_verts, pbvh->mloop[lt->tri[j]].v);
+      const int vertex = pbvh->mloop[lt->tri[j]].v;
+      void **value_p;
+      if (!BLI_ghash_ensure_p(map, POINTER_FROM_INT(vertex), &value_p)) {
+        *value_p = POINTER_FROM_INT(verts_len);
+        verts[verts_len++] = vertex;
+      }
+      face_vert_indices[i][j] = POINTER_AS_INT(*value_p);
     }
 
     if (has_visible == false) {
@@ -309,40 +319,139 @@ static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
     }
   }
 
-  int *vert_indices = MEM_callocN(sizeof(int) * (node->uniq_verts + node->face_verts),
-                                  "bvh node vert indices");
-  node->vert_indices = vert_indices;
+  BLI_ghash_free(map, NULL, NULL);
+
+  node->face_vert_indices = (const int(*)[3])face_vert_indices;
+  data->leaf_verts[n] = verts;
+  data->leaf_verts_len[n] = verts_len;
+  data->leaf_vert_remap[n] = MEM_mallocN(sizeof(int) * max_ii(verts_len, 1), __func__);
+
+  BKE_pbvh_node_mark_rebuild_draw(node);
+
+  BKE_pbvh_node_fully_hidden_set(node, !has_visible);
+}
 
-  /* Build the vertex list, unique verts first */
-  GHashIterator gh_iter;
-  GHASH_ITER (gh_iter, map) {
-    void *value = BLI_ghashIterator_getValue(&gh_iter);
-    int ndx = POINTER_AS_INT(value);
+/* Build the vertex list of a node, unique verts first. Has to run for the leaves in order. */
+static void build_mesh_leaf_vert_indices(PBVHLeafBuildData *data, const int n)
+{
+  PBVH *pbvh = data->pbvh;
+  PBVHNode *node = data->leaves[n];
+  const int *verts = data->leaf_verts[n];
+  const int verts_len = data->leaf_verts_len[n];
+  int *remap = data->leaf_vert_remap[n];
 
-    if (ndx < 0) {
-      ndx = -ndx + node->uniq_verts - 1;
+  node->uniq_verts = node->face_verts = 0;
+  for (int i = 0; i < verts_len; i++) {
+    if (BLI_BITMAP_TEST(pbvh->vert_bitmap, verts[i]) == 0) {
+      BLI_BITMAP_ENABLE(pbvh->vert_bitmap, verts[i]);
+      remap[i] = node->uniq_verts++;
+    }
+    else {
+      remap[i] = -1;
+    }
+  }
+  for (int i = 0; i < verts_len; i++) {
+    if (remap[i] == -1) {
+      remap[i] = node->uniq_verts + node->face_verts++;
     }
+  }
 
-    vert_indices[ndx] = POINTER_AS_INT(BLI_ghashIterator_getKey(&gh_iter));
+  int *vert_indices = MEM_mallocN(sizeof(int) * max_ii(verts_len, 1), "bvh node vert indices");
+  for (int i = 0; i < verts_len; i++) {
+    vert_indices[remap[i]] = verts[i];
   }
+  node->vert_indices = vert_indices;
+}
 
-  for (int i = 0; i < totface; i++) {
-    const int sides = 3;
+static void build_mesh_leaf_faces_task_cb(void *__restrict userdata,
+                                          const int n,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PBVHLeafBuildData *data = userdata;
+  PBVHNode *node = data->leaves[n];
+  const int *remap = data->leaf_vert_remap[n];
+  int(*face_vert_indices)[3] = (int(*)[3])node->face_vert_indices;
 
-    for (int j = 0; j < sides; j++) {
-      if (face_vert_indices[i][j] < 0) {
-        face_vert_indices[i][j] = -face_vert_indices[i][j] + node->uniq_verts - 1;
-      }
+  for (int i = 0; i < node->totprim; i++) {
+    for (int j = 0; j < 3; j++) {
+      face_vert_indices[i][j] = remap[face_vert_indices[i][j]];
     }
   }
 
+  MEM_freeN(data->leaf_verts[n]);
+  MEM_freeN(data->leaf_vert_remap[n]);
+}
+
+static void build_grid_leaf_task_cb(void *__restrict userdata,
+                                    const int n,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PBVHLeafBuildData *data = userdata;
+  PBVH *pbvh = data->pbvh;
+  PBVHNode *node = data->leaves[n];
+
+  int totquads = BKE_pbvh_count_grid_quads(
+      pbvh->grid_hidden, node->prim_indices, node->totprim, pbvh->gridkey.grid_size);
+  BKE_pbvh_node_fully_hidden_set(node, (totquads == 0));
   BKE_pbvh_node_mark_rebuild_draw(node);
+}
 
-  BKE_pbvh_node_fully_hidden_set(node, !has_visible);
+/* Leaf nodes in the order #build_sub created them, which is depth first. */
+static int pbvh_leaves_in_build_order(PBVH *pbvh, PBVHNode ***r_leaves)
+{
+  PBVHNode **leaves = MEM_mallocN(sizeof(*leaves) * pbvh->totnode, __func__);
+  int *stack = MEM_mallocN(sizeof(*stack) * pbvh->totnode, __func__);
+  int leaves_len = 0, stack_len = 0;
 
-  BLI_ghash_free(map, NULL, NULL);
+  stack[stack_len++] = 0;
+  while (stack_len > 0) {
+    PBVHNode *node = &pbvh->nodes[stack[--stack_len]];
+    if (node->flag & PBVH_Leaf) {
+      leaves[leaves_len++] = node;
+    }
+    else {
+      stack[stack_len++] = node->children_offset + 1;
+      stack[stack_len++] = node->children_offset;
+    }
+  }
+
+  MEM_freeN(stack);
+  *r_leaves = leaves;
+  return leaves_len;
 }
 
+static void pbvh_build_leaves(PBVH *pbvh)
+{
+  PBVHLeafBuildData data = {.pbvh = pbvh};
+  const int totleaf = pbvh_leaves_in_build_order(pbvh, &data.leaves);
+
+  TaskParallelSettings settings;
+  BKE_pbvh_parallel_range_settings(&settings, true, totleaf);
+
+  if (pbvh->looptri) {
+    data.leaf_verts = MEM_mallocN(sizeof(*data.leaf_verts) * totleaf, __func__);
+    data.leaf_verts_len = MEM_mallocN(sizeof(*data.leaf_verts_len) * totleaf, __func__);
+    data.leaf_vert_remap = MEM_mallocN(sizeof(*data.leaf_vert_remap) * totleaf, __func__);
+
+    BLI_task_parallel_range(0, totleaf, &data, build_mesh_leaf_verts_task_cb, &settings);
+    for (int n = 0; n < totleaf; n++) {
+      build_mesh_leaf_vert_indices(&data, n);
+    }
+    BLI_task_parallel_range(0, totleaf, &data, build_mesh_leaf_faces_task_cb, &settings);
+
+    MEM_freeN(data.leaf_verts);
+    MEM_freeN(data.leaf_verts_len);
+    MEM_freeN(data.leaf_vert_remap);
+  }
+  else {
+    BLI_task_parallel_range(0, totleaf, &data, build_grid_leaf_task_cb, &settings);
+  }
+
+  MEM_freeN(data.leaves);
+}
+
+/** \} */
+
 static void update_vb(PBVH *pbvh, PBVHNode *node, BBC *prim_bbc, int offset, int count)
 {
   BB_reset(&node->vb);
@@ -405,14 +514,6 @@ void BKE_pbvh_sync_face_sets_to_grids(PBVH *pbvh)
   }
 }
 
-static void build_grid_leaf_node(PBVH *pbvh, PBVHNode *node)
-{
-  int totquads = BKE_pbvh_count_grid_quads(
-      pbvh->grid_hidden, node->prim_indices, node->totprim, pbvh->gridkey.grid_size);
-  BKE_pbvh_node_fully_hidden_set(node, (totquads == 0));
-  BKE_pbvh_node_mark_rebuild_draw(node);
-}
-
 static void build_leaf(PBVH *pbvh, int node_index, BBC *prim_bbc, int offset, int count)
 {
   pbvh->nodes[node_index].flag |= PBVH_Leaf;
@@ -423,12 +524,7 @@ static void build_leaf(PBVH *pbvh, int node_index, BBC *prim_bbc, int offset, in
   /* Still need vb for searches */
   update_vb(pbvh, &pbvh->nodes[node_index], prim_bbc, offset, count);
 
-  if (pbvh->looptri) {
-    build_mesh_leaf_node(pbvh, pbvh->nodes + node_index);
-  }
-  else {
-    build_grid_leaf_node(pbvh, pbvh->nodes + node_index);
-  }
+  /* The rest is filled in by #pbvh_build_leaves. */
 }
 
 /* Return zero if all primitives in the node can be drawn with the
@@ -554,6 +650,66 @@ static void pbvh_build(PBVH *pbvh, BB *cb, BBC *prim_bbc, int totprim)
 
   pbvh->totnode = 1;
   build_sub(pbvh, 0, cb, prim_bbc, 0, totprim);
+  pbvh_build_leaves(pbvh);
+}
+
+typedef struct PBVHPrimBoundsData {
+  PBVH *pbvh;
+  BBC *prim_bbc;
+  /* Grids only. */
+  CCGElem **grids;
+  CCGKey *key;
+} PBVHPrimBoundsData;
+
+/* For each primitive, store the AABB and the AABB centroid. The chunk is the bounding box of the
+ * centroids. */
+static void pbvh_prim_bounds_task_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict tls)
+{
+  PBVHPrimBoundsData *data = userdata;
+  BBC *bbc = data->prim_bbc + i;
+
+  BB_reset((BB *)bbc);
+
+  if (data->grids) {
+    const CCGElem *grid = data->grids[i];
+    const int gridsize = data->key->grid_size;
+    for (int j = 0; j < gridsize * gridsize; j++) {
+      BB_expand((BB *)bbc, CCG_elem_offset_co(data->key, (CCGElem *)grid, j));
+    }
+  }
+  else {
+    const PBVH *pbvh = data->pbvh;
+    const MLoopTri *lt = &pbvh->looptri[i];
+    for (int j = 0; j < 3; j++) {
+      BB_expand((BB *)bbc, pbvh->verts[pbvh->mloop[lt->tri[j]].v].co);
+    }
+  }
+
+  BBC_update_centroid(bbc);
+
+  BB_expand(tls->userdata_chunk, bbc->bcentroid);
+}
+
+static void pbvh_prim_bounds_reduce(const void *__restrict UNUSED(userdata),
+                                    void *__restrict chunk_join,
+                                    void *__restrict chunk)
+{
+  BB_expand_with_bb(chunk_join, chunk);
+}
+
+static void pbvh_prim_bounds_calc(PBVHPrimBoundsData *data, int totprim, BB *r_cb)
+{
+  BB_reset(r_cb);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  settings.userdata_chunk = r_cb;
+  settings.userdata_chunk_size = sizeof(*r_cb);
+  settings.func_reduce = pbvh_prim_bounds_reduce;
+  BLI_task_parallel_range(0, totprim, data, pbvh_prim_bounds_task_cb, &settings);
 }
 
 /**
@@ -593,26 +749,11 @@ void BKE_pbvh_build_mesh(PBVH *pbvh,
   pbvh->face_sets_color_seed = mesh->face_sets_color_seed;
   pbvh->face_sets_color_default = mesh->face_sets_color_default;
 
-  BB_reset(&cb);
-
   /* For each face, store the AABB and the AABB centroid */
   prim_bbc = MEM_mallocN(sizeof(BBC) * looptri_num, "prim_bbc");
 
-  for (int i = 0; i < looptri_num; i++) {
-    const MLoopTri *lt = &looptri[i];
-    const int sides = 3;
-    BBC *bbc = prim_bbc + i;
-
-    BB_reset((BB *)bbc);
-
-    for (int j = 0; j < sides; j++) {
-      BB_expand((BB *)bbc, verts[pbvh->mloop[lt->tri[j]].v].co);
-    }
-
-    BBC_update_centroid(bbc);
-
-    BB_expand(&cb, bbc->bcentroid);
-  }
+  PBVHPrimBoundsData bounds_data = {.pbvh = pbvh, .prim_bbc = prim_bbc};
+  pbvh_prim_bounds_calc(&bounds_data, looptri_num, &cb);
 
   if (looptri_num) {
     pbvh_build(pbvh, &cb, prim_bbc, looptri_num);
@@ -643,25 +784,13 @@ void BKE_pbvh_build_grids(PBVH *pbvh,
   pbvh->leaf_limit = max_ii(LEAF_LIMIT / (gridsize * gridsize), 1);
 
   BB cb;
-  BB_reset(&cb);
 
   /* For each grid, store the AABB and the AABB centroid */
   BBC *prim_bbc = MEM_mallocN(sizeof(BBC) * totgrid, "prim_bbc");
 
-  for (int i = 0; i < totgrid; i++) {
-    CCGElem *grid = grids[i];
-    BBC *bbc = prim_bbc + i;
-
-    BB_reset((BB *)bbc);
-
-    for (int j = 0; j < gridsize * gridsize; j++) {
-      BB_expand((BB *)bbc, CCG_elem_offset_co(key, grid, j));
-    }
-
-    BBC_update_centroid(bbc);
-
-    BB_expand(&cb, bbc->bcentroid);
-  }
+  PBVHPrimBoundsData bounds_data = {
+      .pbvh = pbvh, .prim_bbc = prim_bbc, .grids = grids, .key = key};
+  pbvh_prim_bounds_calc(&bounds_data, totgrid, &cb);
 
   if (totgrid) {
     pbvh_build(pbvh, &cb, prim_bbc, totgrid);
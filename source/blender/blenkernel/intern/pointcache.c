@@ -47,6 +47,7 @@
 #include "BLI_endian_switch.h"
 #include "BLI_math.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -138,7 +139,7 @@ static int ptcache_extra_datasize[] = {
 /* forward declarations */
 static int ptcache_file_compressed_read(PTCacheFile *pf, unsigned char *result, unsigned int len);
 static int ptcache_file_compressed_write(
-    PTCacheFile *pf, unsigned char *in, unsigned int in_len, unsigned char *out, int mode);
+    PTCacheFile *pf, unsigned char *in, unsigned int in_len, int mode);
 static int ptcache_file_write(PTCacheFile *pf, const void *f, unsigned int tot, unsigned int size);
 static int ptcache_file_read(PTCacheFile *pf, void *f, unsigned int tot, unsigned int size);
 
@@ -690,7 +691,6 @@ static int ptcache_dynamicpaint_write(PTCacheFile *pf, void *dp_v)
   if (surface->format != MOD_DPAINT_SURFACE_F_IMAGESEQ && surface->data) {
     int total_points = surface->data->total_points;
     unsigned int in_len;
-    unsigned char *out;
 
     /* cache type */
     ptcache_file_write(pf, &surface->type, 1, sizeof(int));
@@ -709,11 +709,8 @@ static int ptcache_dynamicpaint_write(PTCacheFile *pf, void *dp_v)
       return 0;
     }
 
-    out = (unsigned char *)MEM_callocN(LZO_OUT_LEN(in_len), "pointcache_lzo_buffer");
-
     ptcache_file_compressed_write(
-        pf, (unsigned char *)surface->data->type_data, in_len, out, cache_compress);
-    MEM_freeN(out);
+        pf, (unsigned char *)surface->data->type_data, in_len, cache_compress);
   }
   return 1;
 }
@@ -1513,89 +1510,117 @@ static void ptcache_file_close(PTCacheFile *pf)
   }
 }
 
-static int ptcache_file_compressed_read(PTCacheFile *pf, unsigned char *result, unsigned int len)
+/* A block of compressed data in the file. Reading or writing the file and (de)compressing the
+ * data are separate steps, so that the blocks of a frame can be (de)compressed in parallel. */
+typedef struct PTCacheCompressedBlock {
+  /* Uncompressed data. */
+  unsigned char *data;
+  unsigned int data_len;
+  /* 0 when the data is stored uncompressed, 1 for LZO and 2 for LZMA. */
+  unsigned char compressed;
+  unsigned char *packed;
+  size_t packed_len;
+  unsigned char props[16];
+  size_t props_len;
+} PTCacheCompressedBlock;
+
+static void ptcache_file_compressed_block_read(PTCacheFile *pf, PTCacheCompressedBlock *block)
 {
-  int r = 0;
-  unsigned char compressed = 0;
-  size_t in_len;
-#ifdef WITH_LZO
-  size_t out_len = len;
-#endif
-  unsigned char *in;
-  unsigned char *props = MEM_callocN(sizeof(char[16]), "tmp");
+  block->compressed = 0;
+  block->packed = NULL;
+  block->packed_len = 0;
+  block->props_len = 0;
 
-  ptcache_file_read(pf, &compressed, 1, sizeof(unsigned char));
-  if (compressed) {
+  ptcache_file_read(pf, &block->compressed, 1, sizeof(unsigned char));
+  if (block->compressed) {
     unsigned int size;
     ptcache_file_read(pf, &size, 1, sizeof(unsigned int));
-    in_len = (size_t)size;
-    if (in_len == 0) {
+    block->packed_len = (size_t)size;
+    if (block->packed_len == 0) {
       /* do nothing */
     }
     else {
-      in = (unsigned char *)MEM_callocN(sizeof(unsigned char) * in_len,
-                                        "pointcache_compressed_buffer");
-      ptcache_file_read(pf, in, in_len, sizeof(unsigned char));
-#ifdef WITH_LZO
-      if (compressed == 1) {
-        r = lzo1x_decompress_safe(in, (lzo_uint)in_len, result, (lzo_uint *)&out_len, NULL);
-      }
-#endif
+      block->packed = (unsigned char *)MEM_callocN(sizeof(unsigned char) * block->packed_len,
+                                                   "pointcache_compressed_buffer");
+      ptcache_file_read(pf, block->packed, block->packed_len, sizeof(unsigned char));
 #ifdef WITH_LZMA
-      if (compressed == 2) {
-        size_t sizeOfIt;
-        size_t leni = in_len, leno = len;
+      if (block->compressed == 2) {
         ptcache_file_read(pf, &size, 1, sizeof(unsigned int));
-        sizeOfIt = (size_t)size;
-        ptcache_file_read(pf, props, sizeOfIt, sizeof(unsigned char));
-        r = LzmaUncompress(result, &leno, in, &leni, props, sizeOfIt);
+        block->props_len = MIN2((size_t)size, sizeof(block->props));
+        ptcache_file_read(pf, block->props, block->props_len, sizeof(unsigned char));
       }
 #endif
-      MEM_freeN(in);
     }
   }
   else {
-    ptcache_file_read(pf, result, len, sizeof(unsigned char));
+    ptcache_file_read(pf, block->data, block->data_len, sizeof(unsigned char));
   }
+}
+
+static int ptcache_compressed_block_decompress(PTCacheCompressedBlock *block)
+{
+  int r = 0;
 
-  MEM_freeN(props);
+  if (block->packed == NULL) {
+    return r;
+  }
+
+#ifdef WITH_LZO
+  if (block->compressed == 1) {
+    size_t out_len = block->data_len;
+    r = lzo1x_decompress_safe(
+        block->packed, (lzo_uint)block->packed_len, block->data, (lzo_uint *)&out_len, NULL);
+  }
+#endif
+#ifdef WITH_LZMA
+  if (block->compressed == 2) {
+    size_t leni = block->packed_len, leno = block->data_len;
+    r = LzmaUncompress(block->data, &leno, block->packed, &leni, block->props, block->props_len);
+  }
+#endif
+
+  MEM_freeN(block->packed);
+  block->packed = NULL;
 
   return r;
 }
-static int ptcache_file_compressed_write(
-    PTCacheFile *pf, unsigned char *in, unsigned int in_len, unsigned char *out, int mode)
+
+static int ptcache_compressed_block_compress(PTCacheCompressedBlock *block, int mode)
 {
   int r = 0;
-  unsigned char compressed = 0;
-  size_t out_len = 0;
-  unsigned char *props = MEM_callocN(sizeof(char[16]), "tmp");
-  size_t sizeOfIt = 5;
+  const unsigned int in_len = block->data_len;
 
   (void)mode; /* unused when building w/o compression */
 
+  block->compressed = 0;
+  block->packed = (unsigned char *)MEM_callocN(LZO_OUT_LEN(in_len) * 4, "pointcache_lzo_buffer");
+  block->packed_len = 0;
+  block->props_len = 5;
+
 #ifdef WITH_LZO
-  out_len = LZO_OUT_LEN(in_len);
+  block->packed_len = LZO_OUT_LEN(in_len);
   if (mode == 1) {
     LZO_HEAP_ALLOC(wrkmem, LZO1X_MEM_COMPRESS);
 
-    r = lzo1x_1_compress(in, (lzo_uint)in_len, out, (lzo_uint *)&out_len, wrkmem);
-    if (!(r == LZO_E_OK) || (out_len >= in_len)) {
-      compressed = 0;
+    r = lzo1x_1_compress(
+        block->data, (lzo_uint)in_len, block->packed, (lzo_uint *)&block->packed_len, wrkmem);
+    if (!(r == LZO_E_OK) || (block->packed_len >= in_len)) {
+      block->compressed = 0;
     }
     else {
-      compressed = 1;
+      block->compressed = 1;
     }
   }
 #endif
 #ifdef WITH_LZMA
   if (mode == 2) {
 
-    r = LzmaCompress(out,
-                     &out_len,
-                     in,
+    r = LzmaCompress(block->packed,
+                     &block->packed_len,
+                     block->data,
                      in_len, /* assume sizeof(char)==1.... */
-                     props,
-                     &sizeOfIt,
+                     block->props,
+                     &block->props_len,
                      5,
                      1 << 24,
                      3,
@@ -1604,35 +1629,125 @@ static int ptcache_file_compressed_write(
                      32,
                      2);
 
-    if (!(r == SZ_OK) || (out_len >= in_len)) {
-      compressed = 0;
+    if (!(r == SZ_OK) || (block->packed_len >= in_len)) {
+      block->compressed = 0;
     }
     else {
-      compressed = 2;
+      block->compressed = 2;
     }
   }
 #endif
 
-  ptcache_file_write(pf, &compressed, 1, sizeof(unsigned char));
-  if (compressed) {
-    unsigned int size = out_len;
+  return r;
+}
+
+static void ptcache_file_compressed_block_write(PTCacheFile *pf, PTCacheCompressedBlock *block)
+{
+  ptcache_file_write(pf, &block->compressed, 1, sizeof(unsigned char));
+  if (block->compressed) {
+    unsigned int size = block->packed_len;
     ptcache_file_write(pf, &size, 1, sizeof(unsigned int));
-    ptcache_file_write(pf, out, out_len, sizeof(unsigned char));
+    ptcache_file_write(pf, block->packed, block->packed_len, sizeof(unsigned char));
   }
   else {
-    ptcache_file_write(pf, in, in_len, sizeof(unsigned char));
+    ptcache_file_write(pf, block->data, block->data_len, sizeof(unsigned char));
   }
 
-  if (compressed == 2) {
-    unsigned int size = sizeOfIt;
-    ptcache_file_write(pf, &sizeOfIt, 1, sizeof(unsigned int));
-    ptcache_file_write(pf, props, size, sizeof(unsigned char));
+  if (block->compressed == 2) {
+    unsigned int size = block->props_len;
+    ptcache_file_write(pf, &size, 1, sizeof(unsigned int));
+    ptcache_file_write(pf, block->props, size, sizeof(unsigned char));
   }
 
-  MEM_freeN(props);
+  MEM_SAFE_FREE(block->packed);
+}
 
+static int ptcache_file_compressed_read(PTCacheFile *pf, unsigned char *result, unsigned int len)
+{
+  PTCacheCompressedBlock block = {.data = result, .data_len = len};
+  ptcache_file_compressed_block_read(pf, &block);
+  return ptcache_compressed_block_decompress(&block);
+}
+static int ptcache_file_compressed_write(
+    PTCacheFile *pf, unsigned char *in, unsigned int in_len, int mode)
+{
+  PTCacheCompressedBlock block = {.data = in, .data_len = in_len};
+  const int r = ptcache_compressed_block_compress(&block, mode);
+  ptcache_file_compressed_block_write(pf, &block);
   return r;
 }
+
+typedef struct PTCacheCompressTaskData {
+  PTCacheCompressedBlock *blocks;
+  int mode;
+} PTCacheCompressTaskData;
+
+static void ptcache_decompress_block_task(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PTCacheCompressTaskData *data = userdata;
+  ptcache_compressed_block_decompress(&data->blocks[i]);
+}
+
+static void ptcache_compress_block_task(void *__restrict userdata,
+                                        const int i,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PTCacheCompressTaskData *data = userdata;
+  if (data->blocks[i].data) {
+    ptcache_compressed_block_compress(&data->blocks[i], data->mode);
+  }
+}
+
+/* Read the compressed data of all data types of a frame, then decompress them in parallel. */
+static void ptcache_file_compressed_data_read(PTCacheFile *pf, PTCacheMem *pm)
+{
+  PTCacheCompressedBlock blocks[BPHYS_TOT_DATA] = {{NULL}};
+
+  for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+    if (pf->data_types & (1 << i)) {
+      blocks[i].data = (unsigned char *)pm->data[i];
+      blocks[i].data_len = pm->totpoint * ptcache_data_size[i];
+      ptcache_file_compressed_block_read(pf, &blocks[i]);
+    }
+  }
+
+  PTCacheCompressTaskData data = {.blocks = blocks};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, BPHYS_TOT_DATA, &data, ptcache_decompress_block_task, &settings);
+}
+
+/* Compress the data of all data types of a frame in parallel, then write them. */
+static void ptcache_file_compressed_data_write(PTCacheFile *pf, PTCacheMem *pm, int mode)
+{
+  PTCacheCompressedBlock blocks[BPHYS_TOT_DATA] = {{NULL}};
+
+  for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+    if (pm->data[i]) {
+      blocks[i].data = (unsigned char *)pm->data[i];
+      blocks[i].data_len = pm->totpoint * ptcache_data_size[i];
+    }
+  }
+
+  PTCacheCompressTaskData data = {.blocks = blocks, .mode = mode};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  /* LZMA uses a large dictionary for every block, compressing blocks at the same time would
+   * multiply the memory usage. */
+  settings.use_threading = (mode != 2);
+  BLI_task_parallel_range(0, BPHYS_TOT_DATA, &data, ptcache_compress_block_task, &settings);
+
+  for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+    if (blocks[i].data) {
+      ptcache_file_compressed_block_write(pf, &blocks[i]);
+    }
+  }
+}
+
 static int ptcache_file_read(PTCacheFile *pf, void *f, unsigned int tot, unsigned int size)
 {
   return (fread(f, size, tot, pf->fp) == tot);
@@ -1641,31 +1756,87 @@ static int ptcache_file_write(PTCacheFile *pf, const void *f, unsigned int tot,
 {
   return (fwrite(f, size, tot, pf->fp) == tot);
 }
-static int ptcache_file_data_read(PTCacheFile *pf)
+/* Uncompressed point data is stored interleaved per point. It is read and written in chunks of
+ * points, instead of one value at a time. */
+#define PTCACHE_FILE_CHUNK_POINTS 4096
+
+static unsigned int ptcache_file_point_size(unsigned int data_types)
 {
-  int i;
+  unsigned int size = 0;
+  for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+    if (data_types & (1 << i)) {
+      size += ptcache_data_size[i];
+    }
+  }
+  return size;
+}
+static int ptcache_file_points_read(PTCacheFile *pf, PTCacheMem *pm)
+{
+  const unsigned int point_size = ptcache_file_point_size(pf->data_types);
+  const unsigned int chunk_points = MIN2(pm->totpoint, PTCACHE_FILE_CHUNK_POINTS);
+  unsigned char *buffer = MEM_mallocN(MAX2(point_size * chunk_points, 1), __func__);
+  void *cur[BPHYS_TOT_DATA];
+  int error = 0;
 
-  for (i = 0; i < BPHYS_TOT_DATA; i++) {
-    if ((pf->data_types & (1 << i)) &&
-        !ptcache_file_read(pf, pf->cur[i], 1, ptcache_data_size[i])) {
-      return 0;
+  BKE_ptcache_mem_pointers_init(pm, cur);
+
+  for (unsigned int start = 0; start < pm->totpoint; start += chunk_points) {
+    const unsigned int points_num = MIN2(chunk_points, pm->totpoint - start);
+    if (!ptcache_file_read(pf, buffer, points_num, point_size)) {
+      error = 1;
+      break;
+    }
+    const unsigned char *point = buffer;
+    for (unsigned int p = 0; p < points_num; p++) {
+      for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+        if (pf->data_types & (1 << i)) {
+          if (cur[i]) {
+            memcpy(cur[i], point, ptcache_data_size[i]);
+          }
+          point += ptcache_data_size[i];
+        }
+      }
+      BKE_ptcache_mem_pointers_incr(cur);
     }
   }
 
-  return 1;
+  MEM_freeN(buffer);
+
+  return !error;
 }
-static int ptcache_file_data_write(PTCacheFile *pf)
+static int ptcache_file_points_write(PTCacheFile *pf, PTCacheMem *pm)
 {
-  int i;
+  const unsigned int point_size = ptcache_file_point_size(pf->data_types);
+  const unsigned int chunk_points = MIN2(pm->totpoint, PTCACHE_FILE_CHUNK_POINTS);
+  unsigned char *buffer = MEM_callocN(MAX2(point_size * chunk_points, 1), __func__);
+  void *cur[BPHYS_TOT_DATA];
+  int error = 0;
 
-  for (i = 0; i < BPHYS_TOT_DATA; i++) {
-    if ((pf->data_types & (1 << i)) &&
-        !ptcache_file_write(pf, pf->cur[i], 1, ptcache_data_size[i])) {
-      return 0;
+  BKE_ptcache_mem_pointers_init(pm, cur);
+
+  for (unsigned int start = 0; start < pm->totpoint; start += chunk_points) {
+    const unsigned int points_num = MIN2(chunk_points, pm->totpoint - start);
+    unsigned char *point = buffer;
+    for (unsigned int p = 0; p < points_num; p++) {
+      for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+        if (pf->data_types & (1 << i)) {
+          if (cur[i]) {
+            memcpy(point, cur[i], ptcache_data_size[i]);
+          }
+          point += ptcache_data_size[i];
+        }
+      }
+      BKE_ptcache_mem_pointers_incr(cur);
+    }
+    if (!ptcache_file_write(pf, buffer, points_num, point_size)) {
+      error = 1;
+      break;
     }
   }
 
-  return 1;
+  MEM_freeN(buffer);
+
+  return !error;
 }
 static int ptcache_file_header_begin_read(PTCacheFile *pf)
 {
@@ -1833,17 +2004,6 @@ static void ptcache_data_free(PTCacheMem *pm)
     }
   }
 }
-static void ptcache_data_copy(void *from[], void *to[])
-{
-  int i;
-  for (i = 0; i < BPHYS_TOT_DATA; i++) {
-    /* note, durian file 03.4b_comp crashes if to[i] is not tested
-     * its NULL, not sure if this should be fixed elsewhere but for now its needed */
-    if (from[i] && to[i]) {
-      memcpy(to[i], from[i], ptcache_data_size[i]);
-    }
-  }
-}
 
 static void ptcache_extra_free(PTCacheMem *pm)
 {
@@ -1943,7 +2103,7 @@ static PTCacheMem *ptcache_disk_frame_to_mem(PTCacheID *pid, int cfra)
 {
   PTCacheFile *pf = ptcache_file_open(pid, PTCACHE_FILE_READ, cfra);
   PTCacheMem *pm = NULL;
-  unsigned int i, error = 0;
+  unsigned int error = 0;
 
   if (pf == NULL) {
     return NULL;
@@ -1967,26 +2127,10 @@ static PTCacheMem *ptcache_disk_frame_to_mem(PTCacheID *pid, int cfra)
     ptcache_data_alloc(pm);
 
     if (pf->flag & PTCACHE_TYPEFLAG_COMPRESS) {
-      for (i = 0; i < BPHYS_TOT_DATA; i++) {
-        unsigned int out_len = pm->totpoint * ptcache_data_size[i];
-        if (pf->data_types & (1 << i)) {
-          ptcache_file_compressed_read(pf, (unsigned char *)(pm->data[i]), out_len);
-        }
-      }
+      ptcache_file_compressed_data_read(pf, pm);
     }
-    else {
-      void *cur[BPHYS_TOT_DATA];
-      BKE_ptcache_mem_pointers_init(pm, cur);
-      ptcache_file_pointers_init(pf);
-
-      for (i = 0; i < pm->totpoint; i++) {
-        if (!ptcache_file_data_read(pf)) {
-          error = 1;
-          break;
-        }
-        ptcache_data_copy(pf->cur, cur);
-        BKE_ptcache_mem_pointers_incr(cur);
-      }
+    else if (!ptcache_file_points_read(pf, pm)) {
+      error = 1;
     }
   }
 
@@ -2033,7 +2177,7 @@ static PTCacheMem *ptcache_disk_frame_to_mem(PTCacheID *pid, int cfra)
 static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
 {
   PTCacheFile *pf = NULL;
-  unsigned int i, error = 0;
+  unsigned int error = 0;
 
   BKE_ptcache_id_clear(pid, PTCACHE_CLEAR_FRAME, pm->frame);
 
@@ -2065,30 +2209,10 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
 
   if (!error) {
     if (pid->cache->compression) {
-      for (i = 0; i < BPHYS_TOT_DATA; i++) {
-        if (pm->data[i]) {
-          unsigned int in_len = pm->totpoint * ptcache_data_size[i];
-          unsigned char *out = (unsigned char *)MEM_callocN(LZO_OUT_LEN(in_len) * 4,
-                                                            "pointcache_lzo_buffer");
-          ptcache_file_compressed_write(
-              pf, (unsigned char *)(pm->data[i]), in_len, out, pid->cache->compression);
-          MEM_freeN(out);
-        }
-      }
+      ptcache_file_compressed_data_write(pf, pm, pid->cache->compression);
     }
-    else {
-      void *cur[BPHYS_TOT_DATA];
-      BKE_ptcache_mem_pointers_init(pm, cur);
-      ptcache_file_pointers_init(pf);
-
-      for (i = 0; i < pm->totpoint; i++) {
-        ptcache_data_copy(cur, pf->cur);
-        if (!ptcache_file_data_write(pf)) {
-          error = 1;
-          break;
-        }
-        BKE_ptcache_mem_pointers_incr(cur);
-      }
+    else if (!ptcache_file_points_write(pf, pm)) {
+      error = 1;
     }
   }
 
@@ -2105,11 +2229,8 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
 
       if (pid->cache->compression) {
         unsigned int in_len = extra->totdata * ptcache_extra_datasize[extra->type];
-        unsigned char *out = (unsigned char *)MEM_callocN(LZO_OUT_LEN(in_len) * 4,
-                                                          "pointcache_lzo_buffer");
         ptcache_file_compressed_write(
-            pf, (unsigned char *)(extra->data), in_len, out, pid->cache->compression);
-        MEM_freeN(out);
+            pf, (unsigned char *)(extra->data), in_len, pid->cache->compression);
       }
       else {
         ptcache_file_write(pf, extra->data, extra->totdata, ptcache_extra_datasize[extra->type]);
@@ -35,6 +35,7 @@
 
 #include "BLI_listbase.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #ifdef WITH_BULLET
 #  include "RBI_api.h"
@@ -1659,18 +1660,24 @@ static void rigidbody_update_sim_world(Scene *scene, RigidBodyWorld *rbw)
   rigidbody_update_ob_array(rbw);
 }
 
-static void rigidbody_update_sim_ob(
-    Depsgraph *depsgraph, Scene *scene, RigidBodyWorld *rbw, Object *ob, RigidBodyOb *rbo)
+/**
+ * \param use_shared_effectors: Use the effectors of the world in \a shared_effectors, instead of
+ * creating them for this object.
+ */
+static void rigidbody_update_sim_ob(Depsgraph *depsgraph,
+                                    Scene *scene,
+                                    RigidBodyWorld *rbw,
+                                    Object *ob,
+                                    RigidBodyOb *rbo,
+                                    const bool is_selected,
+                                    const bool use_shared_effectors,
+                                    ListBase *shared_effectors)
 {
   /* only update if rigid body exists */
   if (rbo->shared->physics_object == NULL) {
     return;
   }
 
-  ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
-  Base *base = BKE_view_layer_base_find(view_layer, ob);
-  const bool is_selected = base ? (base->flag & BASE_SELECTED) != 0 : false;
-
   if (rbo->shape == RB_SHAPE_TRIMESH && rbo->flag & RBO_FLAG_USE_DEFORM) {
     Mesh *mesh = ob->runtime.mesh_deform_eval;
     if (mesh) {
@@ -1720,7 +1727,9 @@ static void rigidbody_update_sim_ob(
     ListBase *effectors;
 
     /* get effectors present in the group specified by effector_weights */
-    effectors = BKE_effectors_create(depsgraph, ob, NULL, effector_weights);
+    effectors = use_shared_effectors ?
+                    shared_effectors :
+                    BKE_effectors_create(depsgraph, ob, NULL, effector_weights);
     if (effectors) {
       float eff_force[3] = {0.0f, 0.0f, 0.0f};
       float eff_loc[3], eff_vel[3];
@@ -1755,7 +1764,9 @@ static void rigidbody_update_sim_ob(
     }
 
     /* cleanup */
-    BKE_effectors_free(effectors);
+    if (!use_shared_effectors) {
+      BKE_effectors_free(effectors);
+    }
   }
   /* NOTE: passive objects don't need to be updated since they don't move */
 
@@ -1764,6 +1775,58 @@ static void rigidbody_update_sim_ob(
    */
 }
 
+typedef struct RigidbodyUpdateSimObData {
+  Depsgraph *depsgraph;
+  Scene *scene;
+  RigidBodyWorld *rbw;
+  Object **objects;
+  bool *is_selected;
+  bool use_shared_effectors;
+  ListBase *shared_effectors;
+} RigidbodyUpdateSimObData;
+
+static void rigidbody_update_sim_ob_task(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  RigidbodyUpdateSimObData *data = userdata;
+  Object *ob = data->objects[i];
+
+  rigidbody_update_sim_ob(data->depsgraph,
+                          data->scene,
+                          data->rbw,
+                          ob,
+                          ob->rigidbody_object,
+                          data->is_selected[i],
+                          data->use_shared_effectors,
+                          data->shared_effectors);
+}
+
+/**
+ * Effectors only depend on the object they are created for when it is an effector itself, which
+ * is skipped when applying forces, so the same list can be used for all objects. Noise draws from
+ * a random generator that is seeded when the list is created, so it needs a list per object.
+ *
+ * \return false when the effectors have to be created per object.
+ */
+static bool rigidbody_shared_effectors_create(Depsgraph *depsgraph,
+                                              RigidBodyWorld *rbw,
+                                              ListBase **r_effectors)
+{
+  ListBase *effectors = BKE_effectors_create(depsgraph, NULL, NULL, rbw->effector_weights);
+  if (effectors) {
+    LISTBASE_FOREACH (EffectorCache *, eff, effectors) {
+      if (eff->pd->f_noise > 0.0f) {
+        BKE_effectors_free(effectors);
+        *r_effectors = NULL;
+        return false;
+      }
+    }
+  }
+  *r_effectors = effectors;
+  return true;
+}
+
 /**
  * Updates and validates world, bodies and shapes.
  *
@@ -1803,6 +1866,24 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
     FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
   }
 
+  /* Objects are validated here, the simulation objects are updated in parallel afterwards. */
+  ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
+  int objects_num = 0;
+  FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (rbw->group, ob) {
+    (void)ob;
+    objects_num++;
+  }
+  FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
+
+  RigidbodyUpdateSimObData update_data = {
+      .depsgraph = depsgraph,
+      .scene = scene,
+      .rbw = rbw,
+      .objects = MEM_mallocN(sizeof(Object *) * max_ii(objects_num, 1), __func__),
+      .is_selected = MEM_mallocN(sizeof(bool) * max_ii(objects_num, 1), __func__),
+  };
+  int update_num = 0;
+
   /* update objects */
   FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (rbw->group, ob) {
     if (ob->type == OB_MESH) {
@@ -1852,11 +1933,28 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
       rbo->flag &= ~(RBO_FLAG_NEEDS_VALIDATE | RBO_FLAG_NEEDS_RESHAPE);
 
       /* update simulation object... */
-      rigidbody_update_sim_ob(depsgraph, scene, rbw, ob, rbo);
+      Base *base = BKE_view_layer_base_find(view_layer, ob);
+      update_data.objects[update_num] = ob;
+      update_data.is_selected[update_num] = base ? (base->flag & BASE_SELECTED) != 0 : false;
+      update_num++;
     }
   }
   FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
 
+  update_data.use_shared_effectors = rigidbody_shared_effectors_create(
+      depsgraph, rbw, &update_data.shared_effectors);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  /* With effectors per object, noise is drawn in the order of the objects. */
+  settings.use_threading = update_data.use_shared_effectors && (update_num > 100);
+  BLI_task_parallel_range(0, update_num, &update_data, rigidbody_update_sim_ob_task, &settings);
+
+  BKE_effectors_free(update_data.shared_effectors);
+
+  MEM_freeN(update_data.objects);
+  MEM_freeN(update_data.is_selected);
+
   /* update constraints */
   if (rbw->constraints == NULL) { /* no constraints, move on */
     return;
@@ -349,89 +349,83 @@ void BKE_shrinkwrap_compute_boundary_data(struct Mesh *mesh)
  * Shrink-wrap to the nearest vertex
  *
  * it builds a #BVHTree of vertices we can attach to and then
- * for each vertex performs a nearest vertex search on the tree
+ * performs a nearest vertex search on the tree for all vertices at once
  */
-static void shrinkwrap_calc_nearest_vertex_cb_ex(void *__restrict userdata,
-                                                 const int i,
-                                                 const TaskParallelTLS *__restrict tls)
+static void shrinkwrap_calc_nearest_vertex(ShrinkwrapCalcData *calc)
 {
-  ShrinkwrapCalcCBData *data = userdata;
-
-  ShrinkwrapCalcData *calc = data->calc;
-  BVHTreeFromMesh *treeData = &data->tree->treeData;
-  BVHTreeNearest *nearest = tls->userdata_chunk;
-
-  float *co = calc->vertexCos[i];
-  float tmp_co[3];
-  float weight = BKE_defvert_array_find_weight_safe(calc->dvert, i, calc->vgroup);
-
-  if (calc->invert_vgroup) {
-    weight = 1.0f - weight;
-  }
+  BVHTreeFromMesh *treeData = &calc->tree->treeData;
 
-  if (weight == 0.0f) {
-    return;
-  }
+  int *vert_indices = MEM_malloc_arrayN((size_t)calc->numVerts, sizeof(int), __func__);
+  float *weights = MEM_malloc_arrayN((size_t)calc->numVerts, sizeof(float), __func__);
+  float(*tree_cos)[3] = MEM_malloc_arrayN((size_t)calc->numVerts, sizeof(float[3]), __func__);
+  int verts_num = 0;
 
-  /* Convert the vertex to tree coordinates */
-  if (calc->vert) {
-    copy_v3_v3(tmp_co, calc->vert[i].co);
-  }
-  else {
-    copy_v3_v3(tmp_co, co);
-  }
-  BLI_space_transform_apply(&calc->local2target, tmp_co);
+  for (int i = 0; i < calc->numVerts; i++) {
+    float weight = BKE_defvert_array_find_weight_safe(calc->dvert, i, calc->vgroup);
 
-  /* Use local proximity heuristics (to reduce the nearest search)
-   *
-   * If we already had an hit before.. we assume this vertex is going to have a close hit to that
-   * other vertex so we can initiate the "nearest.dist" with the expected value to that last hit.
-   * This will lead in pruning of the search tree. */
-  if (nearest->index != -1) {
-    nearest->dist_sq = len_squared_v3v3(tmp_co, nearest->co);
-  }
-  else {
-    nearest->dist_sq = FLT_MAX;
-  }
+    if (calc->invert_vgroup) {
+      weight = 1.0f - weight;
+    }
 
-  BLI_bvhtree_find_nearest(treeData->tree, tmp_co, nearest, treeData->nearest_callback, treeData);
+    if (weight == 0.0f) {
+      continue;
+    }
 
-  /* Found the nearest vertex */
-  if (nearest->index != -1) {
-    /* Adjusting the vertex weight,
-     * so that after interpolating it keeps a certain distance from the nearest position */
-    if (nearest->dist_sq > FLT_EPSILON) {
-      const float dist = sqrtf(nearest->dist_sq);
-      weight *= (dist - calc->keepDist) / dist;
+    /* Convert the vertex to tree coordinates */
+    if (calc->vert) {
+      copy_v3_v3(tree_cos[verts_num], calc->vert[i].co);
+    }
+    else {
+      copy_v3_v3(tree_cos[verts_num], calc->vertexCos[i]);
     }
+    BLI_space_transform_apply(&calc->local2target, tree_cos[verts_num]);
+
+    vert_indices[verts_num] = i;
+    weights[verts_num] = weight;
+    verts_num++;
+  }
+
+  BVHTreeNearest *nearest = MEM_malloc_arrayN((size_t)verts_num, sizeof(*nearest), __func__);
+  for (int i = 0; i < verts_num; i++) {
+    nearest[i].index = -1;
+    nearest[i].dist_sq = FLT_MAX;
+  }
+
+  /* The batched search uses the results of nearby vertices to reduce the nearest search. */
+  BLI_bvhtree_find_nearest_batch(treeData->tree,
+                                 (const float(*)[3])tree_cos,
+                                 verts_num,
+                                 nearest,
+                                 treeData->nearest_callback,
+                                 treeData,
+                                 0);
+
+  for (int i = 0; i < verts_num; i++) {
+    /* Found the nearest vertex */
+    if (nearest[i].index != -1) {
+      float *co = calc->vertexCos[vert_indices[i]];
+      float weight = weights[i];
+      float tmp_co[3];
+
+      /* Adjusting the vertex weight,
+       * so that after interpolating it keeps a certain distance from the nearest position */
+      if (nearest[i].dist_sq > FLT_EPSILON) {
+        const float dist = sqrtf(nearest[i].dist_sq);
+        weight *= (dist - calc->keepDist) / dist;
+      }
 
-    /* Convert the coordinates back to mesh coordinates */
-    copy_v3_v3(tmp_co, nearest->co);
-    BLI_space_transform_invert(&calc->local2target, tmp_co);
+      /* Convert the coordinates back to mesh coordinates */
+      copy_v3_v3(tmp_co, nearest[i].co);
+      BLI_space_transform_invert(&calc->local2target, tmp_co);
 
-    interp_v3_v3v3(co, co, tmp_co, weight); /* linear interpolation */
+      interp_v3_v3v3(co, co, tmp_co, weight); /* linear interpolation */
+    }
   }
-}
-
-static void shrinkwrap_calc_nearest_vertex(ShrinkwrapCalcData *calc)
-{
-  BVHTreeNearest nearest = NULL_BVHTreeNearest;
-
-  /* Setup nearest */
-  nearest.index = -1;
-  nearest.dist_sq = FLT_MAX;
 
-  ShrinkwrapCalcCBData data = {
-      .calc = calc,
-      .tree = calc->tree,
-  };
-  TaskParallelSettings settings;
-  BLI_parallel_range_settings_defaults(&settings);
-  settings.use_threading = (calc->numVerts > BKE_MESH_OMP_LIMIT);
-  settings.userdata_chunk = &nearest;
-  settings.userdata_chunk_size = sizeof(nearest);
-  BLI_task_parallel_range(
-      0, calc->numVerts, &data, shrinkwrap_calc_nearest_vertex_cb_ex, &settings);
+  MEM_freeN(vert_indices);
+  MEM_freeN(weights);
+  MEM_freeN(tree_cos);
+  MEM_freeN(nearest);
 }
 
 /*
@@ -27,6 +27,8 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_modifier_types.h"
 
+#include "BLI_listbase.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "MEM_guardedalloc.h"
@@ -47,6 +49,7 @@ void BKE_subdiv_init()
 
 void BKE_subdiv_exit()
 {
+  BKE_subdiv_cache_clear();
   openSubdiv_cleanup();
 }
 
@@ -201,6 +204,89 @@ void BKE_subdiv_free(Subdiv *subdiv)
   MEM_freeN(subdiv);
 }
 
+/* ================================= CACHE ================================== */
+
+/* Descriptors are big (they include the evaluator), keep only a few around. */
+#define SUBDIV_CACHE_MAX 4
+
+typedef struct SubdivCacheEntry {
+  struct SubdivCacheEntry *next, *prev;
+  Subdiv *subdiv;
+  /* Cheap fingerprint of the topology, only used to pick a candidate. The actual topology
+   * comparison is done by #BKE_subdiv_update_from_mesh. */
+  int num_faces, num_face_vertices;
+} SubdivCacheEntry;
+
+/* Most recently released first. */
+static ListBase subdiv_cache = {NULL, NULL};
+static ThreadMutex subdiv_cache_lock = BLI_MUTEX_INITIALIZER;
+
+Subdiv *BKE_subdiv_cache_acquire(const SubdivSettings *settings, const Mesh *mesh)
+{
+  Subdiv *subdiv = NULL;
+
+  BLI_mutex_lock(&subdiv_cache_lock);
+  LISTBASE_FOREACH (SubdivCacheEntry *, entry, &subdiv_cache) {
+    if (entry->num_faces == mesh->totpoly && entry->num_face_vertices == mesh->totloop &&
+        BKE_subdiv_settings_equal(&entry->subdiv->settings, settings)) {
+      subdiv = entry->subdiv;
+      BLI_freelinkN(&subdiv_cache, entry);
+      break;
+    }
+  }
+  BLI_mutex_unlock(&subdiv_cache_lock);
+
+  return subdiv;
+}
+
+void BKE_subdiv_cache_release(Subdiv *subdiv)
+{
+  if (subdiv == NULL) {
+    return;
+  }
+  OpenSubdiv_TopologyRefiner *topology_refiner = subdiv->topology_refiner;
+  if (topology_refiner == NULL) {
+    BKE_subdiv_free(subdiv);
+    return;
+  }
+
+  /* Displacement belongs to the user of the descriptor. */
+  BKE_subdiv_displacement_detach(subdiv);
+
+  SubdivCacheEntry *entry = MEM_callocN(sizeof(*entry), __func__);
+  entry->subdiv = subdiv;
+  entry->num_faces = topology_refiner->getNumFaces(topology_refiner);
+  for (int face_index = 0; face_index < entry->num_faces; face_index++) {
+    entry->num_face_vertices += topology_refiner->getNumFaceVertices(topology_refiner,
+                                                                     face_index);
+  }
+
+  Subdiv *subdiv_evicted = NULL;
+  BLI_mutex_lock(&subdiv_cache_lock);
+  BLI_addhead(&subdiv_cache, entry);
+  if (BLI_listbase_count_at_most(&subdiv_cache, SUBDIV_CACHE_MAX + 1) > SUBDIV_CACHE_MAX) {
+    SubdivCacheEntry *entry_last = subdiv_cache.last;
+    subdiv_evicted = entry_last->subdiv;
+    BLI_freelinkN(&subdiv_cache, entry_last);
+  }
+  BLI_mutex_unlock(&subdiv_cache_lock);
+
+  if (subdiv_evicted != NULL) {
+    BKE_subdiv_free(subdiv_evicted);
+  }
+}
+
+void BKE_subdiv_cache_clear(void)
+{
+  BLI_mutex_lock(&subdiv_cache_lock);
+  LISTBASE_FOREACH_MUTABLE (SubdivCacheEntry *, entry, &subdiv_cache) {
+    BKE_subdiv_free(entry->subdiv);
+    MEM_freeN(entry);
+  }
+  BLI_listbase_clear(&subdiv_cache);
+  BLI_mutex_unlock(&subdiv_cache_lock);
+}
+
 /* =========================== PTEX FACES AND GRIDS ========================= */
 
 int *BKE_subdiv_face_ptex_offset_get(Subdiv *subdiv)
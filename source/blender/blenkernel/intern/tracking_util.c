@@ -615,6 +615,58 @@ MovieTrackingMarker *tracking_get_keyframed_marker(MovieTrackingTrack *track,
 
 /*********************** Frame accessr *************************/
 
+static ImBuf *accessor_cached_frame_get(TrackingImageAccessor *accessor,
+                                        int clip_index,
+                                        int frame)
+{
+  ImBuf *ibuf = NULL;
+
+  BLI_spin_lock(&accessor->cache_lock);
+  for (int i = 0; i < MAX_ACCESSOR_CACHED_FRAMES; i++) {
+    TrackingImageAccessorFrame *cached_frame = &accessor->cached_frames[i];
+    if (cached_frame->ibuf != NULL && cached_frame->clip_index == clip_index &&
+        cached_frame->frame == frame) {
+      ibuf = cached_frame->ibuf;
+      IMB_refImBuf(ibuf);
+      break;
+    }
+  }
+  BLI_spin_unlock(&accessor->cache_lock);
+
+  return ibuf;
+}
+
+static void accessor_cached_frame_put(TrackingImageAccessor *accessor,
+                                      int clip_index,
+                                      int frame,
+                                      ImBuf *ibuf)
+{
+  ImBuf *ibuf_to_free = NULL;
+
+  BLI_spin_lock(&accessor->cache_lock);
+  for (int i = 0; i < MAX_ACCESSOR_CACHED_FRAMES; i++) {
+    const TrackingImageAccessorFrame *cached_frame = &accessor->cached_frames[i];
+    if (cached_frame->ibuf != NULL && cached_frame->clip_index == clip_index &&
+        cached_frame->frame == frame) {
+      /* Another thread has read the same frame in the meantime. */
+      BLI_spin_unlock(&accessor->cache_lock);
+      return;
+    }
+  }
+  /* Replace the oldest frame. */
+  const int oldest_index = accessor->cached_frames_next;
+  TrackingImageAccessorFrame *oldest_frame = &accessor->cached_frames[oldest_index];
+  accessor->cached_frames_next = (oldest_index + 1) % MAX_ACCESSOR_CACHED_FRAMES;
+  ibuf_to_free = oldest_frame->ibuf;
+  oldest_frame->ibuf = ibuf;
+  oldest_frame->clip_index = clip_index;
+  oldest_frame->frame = frame;
+  IMB_refImBuf(ibuf);
+  BLI_spin_unlock(&accessor->cache_lock);
+
+  IMB_freeImBuf(ibuf_to_free);
+}
+
 static ImBuf *accessor_get_preprocessed_ibuf(TrackingImageAccessor *accessor,
                                              int clip_index,
                                              int frame)
@@ -626,6 +678,11 @@ static ImBuf *accessor_get_preprocessed_ibuf(TrackingImageAccessor *accessor,
 
   BLI_assert(clip_index < accessor->num_clips);
 
+  ibuf = accessor_cached_frame_get(accessor, clip_index, frame);
+  if (ibuf != NULL) {
+    return ibuf;
+  }
+
   clip = accessor->clips[clip_index];
   scene_frame = BKE_movieclip_remap_clip_to_scene_frame(clip, frame);
   BKE_movieclip_user_set_frame(&user, scene_frame);
@@ -633,6 +690,10 @@ static ImBuf *accessor_get_preprocessed_ibuf(TrackingImageAccessor *accessor,
   user.render_flag = 0;
   ibuf = BKE_movieclip_get_ibuf(clip, &user);
 
+  if (ibuf != NULL) {
+    accessor_cached_frame_put(accessor, clip_index, frame, ibuf);
+  }
+
   return ibuf;
 }
 
@@ -932,6 +993,9 @@ TrackingImageAccessor *tracking_image_accessor_new(MovieClip *clips[MAX_ACCESSOR
 void tracking_image_accessor_destroy(TrackingImageAccessor *accessor)
 {
   libmv_FrameAccessorDestroy(accessor->libmv_accessor);
+  for (int i = 0; i < MAX_ACCESSOR_CACHED_FRAMES; i++) {
+    IMB_freeImBuf(accessor->cached_frames[i].ibuf);
+  }
   BLI_spin_end(&accessor->cache_lock);
   MEM_freeN(accessor->tracks);
   MEM_freeN(accessor);
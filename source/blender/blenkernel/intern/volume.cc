@@ -87,8 +87,10 @@ static CLG_LogRef LOG = {"bke.volume"};
  *
  * When the number of users drops to zero, the grid data is immediately deleted.
  *
- * TODO: also add a cache for OpenVDB files rather than individual grids,
- * so getting the list of grids is also cached.
+ * The list of grids and the metadata of a file are cached as well, for as long
+ * as any grid of that file is in the cache. Loading another volume datablock or
+ * frame that uses the same file then does not have to open it again.
+ *
  * TODO: Further, we could cache openvdb::io::File so that loading a grid
  * does not re-open it every time. But then we have to take care not to run
  * out of file descriptors or prevent other applications from writing to it.
@@ -170,6 +172,14 @@ static struct VolumeFileCache {
     }
   };
 
+  /* File Entry: grid metadata and file metadata, without any trees. */
+  struct FileEntry {
+    openvdb::GridPtrVec grids;
+    openvdb::MetaMap::Ptr metadata;
+    /* Number of grid entries in the cache for this file. */
+    int num_entries = 0;
+  };
+
   /* Cache */
   VolumeFileCache()
   {
@@ -186,6 +196,9 @@ static struct VolumeFileCache {
     EntrySet::iterator it = cache.find(template_entry);
     if (it == cache.end()) {
       it = cache.emplace(template_entry).first;
+      if (FileEntry *file_entry = files.lookup_ptr(template_entry.filepath)) {
+        file_entry->num_entries++;
+      }
     }
 
     /* Casting const away is weak, but it's convenient having key and value in one. */
@@ -236,10 +249,62 @@ static struct VolumeFileCache {
     update_for_remove_user(entry);
   }
 
+  /* Get the cached grid list and metadata of a file, returns false if it is not cached. */
+  bool lookup_file(const std::string &filepath,
+                   openvdb::GridPtrVec &r_grids,
+                   openvdb::MetaMap::Ptr &r_metadata)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    const FileEntry *file_entry = files.lookup_ptr(filepath);
+    if (file_entry == nullptr) {
+      return false;
+    }
+    /* Return copies, the grid entries get the trees set on them when loading. */
+    r_grids.clear();
+    for (const openvdb::GridBase::Ptr &grid : file_entry->grids) {
+      r_grids.push_back(grid->copyGridWithNewTree());
+    }
+    r_metadata = file_entry->metadata;
+    return true;
+  }
+
+  /* Cache the grid list and metadata of a file. Must be called before adding users of its
+   * grids, the file entry is removed again along with the last grid entry of the file. */
+  void add_file(const std::string &filepath,
+                const openvdb::GridPtrVec &grids,
+                const openvdb::MetaMap::Ptr &metadata)
+  {
+    if (grids.empty()) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (files.contains(filepath)) {
+      return;
+    }
+
+    FileEntry file_entry;
+    for (const openvdb::GridBase::Ptr &grid : grids) {
+      if (grid) {
+        file_entry.grids.push_back(grid->copyGridWithNewTree());
+      }
+    }
+    file_entry.metadata = metadata;
+    for (const Entry &entry : cache) {
+      if (entry.filepath == filepath) {
+        file_entry.num_entries++;
+      }
+    }
+    files.add_new(filepath, std::move(file_entry));
+  }
+
  protected:
   void update_for_remove_user(Entry &entry)
   {
     if (entry.num_metadata_users + entry.num_tree_users == 0) {
+      FileEntry *file_entry = files.lookup_ptr(entry.filepath);
+      if (file_entry && --file_entry->num_entries == 0) {
+        files.remove_contained(entry.filepath);
+      }
       cache.erase(entry);
     }
     else if (entry.num_tree_users == 0) {
@@ -254,6 +319,7 @@ static struct VolumeFileCache {
   /* Cache contents */
   using EntrySet = std::unordered_set<Entry, EntryHasher, EntryEqual>;
   EntrySet cache;
+  blender::Map<std::string, FileEntry> files;
   /* Mutex for multithreaded access. */
   std::mutex mutex;
 } GLOBAL_CACHE;
@@ -801,19 +867,23 @@ bool BKE_volume_load(Volume *volume, Main *bmain)
     return false;
   }
 
-  /* Open OpenVDB file. */
-  openvdb::io::File file(filepath);
+  /* Open OpenVDB file, unless its grid list is still cached. */
   openvdb::GridPtrVec vdb_grids;
 
-  try {
-    file.setCopyMaxBytes(0);
-    file.open();
-    vdb_grids = *(file.readAllGridMetadata());
-    grids.metadata = file.getMetadata();
-  }
-  catch (const openvdb::IoError &e) {
-    grids.error_msg = e.what();
-    CLOG_INFO(&LOG, 1, "Volume %s: %s", volume_name, grids.error_msg.c_str());
+  if (!GLOBAL_CACHE.lookup_file(filepath, vdb_grids, grids.metadata)) {
+    openvdb::io::File file(filepath);
+
+    try {
+      file.setCopyMaxBytes(0);
+      file.open();
+      vdb_grids = *(file.readAllGridMetadata());
+      grids.metadata = file.getMetadata();
+      GLOBAL_CACHE.add_file(filepath, vdb_grids, grids.metadata);
+    }
+    catch (const openvdb::IoError &e) {
+      grids.error_msg = e.what();
+      CLOG_INFO(&LOG, 1, "Volume %s: %s", volume_name, grids.error_msg.c_str());
+    }
   }
 
   /* Add grids read from file to own vector, filtering out any NULL pointers. */
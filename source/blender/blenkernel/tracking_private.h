@@ -130,6 +130,15 @@ float *tracking_track_get_mask_for_region(int frame_width,
 struct libmv_FrameAccessor;
 
 #define MAX_ACCESSOR_CLIP 64
+#define MAX_ACCESSOR_CACHED_FRAMES 8
+
+/* Original frame of a clip, kept referenced by the accessor. */
+typedef struct TrackingImageAccessorFrame {
+  struct ImBuf *ibuf;
+  int clip_index;
+  int frame;
+} TrackingImageAccessorFrame;
+
 typedef struct TrackingImageAccessor {
   struct MovieClip *clips[MAX_ACCESSOR_CLIP];
   int num_clips;
@@ -142,6 +151,12 @@ typedef struct TrackingImageAccessor {
 
   struct libmv_FrameAccessor *libmv_accessor;
   SpinLock cache_lock;
+
+  /* Frames which were accessed most recently, protected by `cache_lock`.
+   * All tracks request the same few frames during a tracking step, keeping them here avoids
+   * going through the global movie clip cache and its lock for every track. */
+  TrackingImageAccessorFrame cached_frames[MAX_ACCESSOR_CACHED_FRAMES];
+  int cached_frames_next;
 } TrackingImageAccessor;
 
 /* Clips are used to access images of an actual footage.
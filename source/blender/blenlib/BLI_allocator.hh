@@ -22,10 +22,15 @@
  * blender::Vector. The allocators defined in this file do not work with standard library
  * containers such as std::vector.
  *
- * Every allocator has to implement two methods:
+ * Every allocator has to implement three methods:
  *   void *allocate(size_t size, size_t alignment, const char *name);
+ *   void *reallocate(void *ptr, size_t old_size, size_t new_size, size_t alignment,
+ *                    const char *name);
  *   void deallocate(void *ptr);
  *
+ * `reallocate` moves the bytes of an allocation to a buffer with a different size. It must only
+ * be used for trivially relocatable data, because the memory is not moved by a constructor.
+ *
  * We don't use the std::allocator interface, because it does more than is really necessary for an
  * allocator and has some other quirks. It mixes the concepts of allocation and construction. It is
  * essentially forced to be a template, even though the allocator should not care about the type.
@@ -39,6 +44,7 @@
 
 #include <algorithm>
 #include <stdlib.h>
+#include <string.h>
 
 #include "MEM_guardedalloc.h"
 
@@ -55,10 +61,24 @@ class GuardedAllocator {
  public:
   void *allocate(size_t size, size_t alignment, const char *name)
   {
-    /* Should we use MEM_mallocN, when alignment is small? If yes, how small must alignment be? */
+    /* Pointers returned by MEM_mallocN are aligned to at least the size of a pointer. Unlike
+     * aligned allocations, those can be grown in place by #reallocate. */
+    if (alignment <= alignof(void *)) {
+      return MEM_mallocN(size, name);
+    }
     return MEM_mallocN_aligned(size, alignment, name);
   }
 
+  void *reallocate(void *ptr,
+                   size_t UNUSED(old_size),
+                   size_t new_size,
+                   size_t UNUSED(alignment),
+                   const char *name)
+  {
+    /* MEM_reallocN keeps the alignment of the original allocation. */
+    return MEM_reallocN_id(ptr, new_size, name);
+  }
+
   void deallocate(void *ptr)
   {
     MEM_freeN(ptr);
@@ -90,6 +110,15 @@ class RawAllocator {
     return used_ptr;
   }
 
+  void *reallocate(
+      void *ptr, size_t old_size, size_t new_size, size_t alignment, const char *name)
+  {
+    void *new_ptr = this->allocate(new_size, alignment, name);
+    memcpy(new_ptr, ptr, std::min(old_size, new_size));
+    this->deallocate(ptr);
+    return new_ptr;
+  }
+
   void deallocate(void *ptr)
   {
     MemHead *head = static_cast<MemHead *>(ptr) - 1;
@@ -0,0 +1,438 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A `blender::ConcurrentMap<Key, Value>` is a hash map that supports adding and looking up keys
+ * from multiple threads at the same time, without locking. It is meant for parallel
+ * deduplication, e.g. of vertices, ids or strings, where the alternative would be to serialize
+ * insertion into a `blender::Map` behind a mutex or to merge thread local maps afterwards.
+ *
+ * To keep insertion lock-free, the map has a fixed capacity that is given at construction. It
+ * never grows, so the maximum number of keys has to be known upfront. Keys cannot be removed.
+ *
+ * blender::ConcurrentMap is implemented using open addressing in a slot array with a power-of-two
+ * size, like blender::Map. Every slot is in one of three states: empty, busy or occupied. A thread
+ * that adds a key claims an empty slot by atomically changing its state to busy, constructs the
+ * key and value in place and then publishes the slot by setting it to occupied. Threads that
+ * probe a busy slot wait until it is occupied before they compare keys. The same probing
+ * strategies as in BLI_probing_strategies.hh are used.
+ *
+ * Some noteworthy information:
+ * - Pointers to keys and values stay valid for the lifetime of the map.
+ * - When multiple threads add the same key at the same time, exactly one of them adds it. All
+ *   of them get a reference to the same value.
+ * - The map only synchronizes access to the keys. Changing a value that is shared between
+ *   threads still requires synchronization by the caller.
+ * - Iterating over the map is not thread-safe, it should only be done when no thread is adding
+ *   keys anymore.
+ */
+
+#include <atomic>
+
+#include "BLI_array.hh"
+#include "BLI_hash.hh"
+#include "BLI_hash_tables.hh"
+#include "BLI_probing_strategies.hh"
+
+namespace blender {
+
+template<
+    /**
+     * Type of the keys stored in the map. Furthermore, the hash and is-equal functions have to
+     * support it.
+     */
+    typename Key,
+    /**
+     * Type of the value that is stored per key.
+     */
+    typename Value,
+    /**
+     * The strategy used to deal with collisions. They are defined in BLI_probing_strategies.hh.
+     */
+    typename ProbingStrategy = DefaultProbingStrategy,
+    /**
+     * The hash function used to hash the keys. There is a default for many types. See BLI_hash.hh
+     * for examples on how to define a custom hash function.
+     */
+    typename Hash = DefaultHash<Key>,
+    /**
+     * The equality operator used to compare keys. By default it will simply compare keys using the
+     * `==` operator.
+     */
+    typename IsEqual = DefaultEquality,
+    /**
+     * The allocator used by this map. Should rarely be changed, except when you don't want that
+     * MEM_* is used internally.
+     */
+    typename Allocator = GuardedAllocator>
+class ConcurrentMap {
+ private:
+  enum class SlotState : uint8_t {
+    Empty = 0,
+    Busy = 1,
+    Occupied = 2,
+  };
+
+  /**
+   * The hash is stored in the slot, so that most key comparisons of colliding keys can be
+   * avoided. The key and value are only initialized when the slot is occupied.
+   */
+  struct Slot {
+    std::atomic<SlotState> state{SlotState::Empty};
+    uint64_t hash;
+    TypedBuffer<Key> key;
+    TypedBuffer<Value> value;
+
+    Slot() = default;
+
+    ~Slot()
+    {
+      if (state.load(std::memory_order_relaxed) == SlotState::Occupied) {
+        key.ref().~Key();
+        value.ref().~Value();
+      }
+    }
+
+    /** Wait until a thread that is adding a key to this slot is done. */
+    SlotState wait_until_published() const
+    {
+      SlotState current_state = state.load(std::memory_order_acquire);
+      while (current_state == SlotState::Busy) {
+        current_state = state.load(std::memory_order_acquire);
+      }
+      return current_state;
+    }
+  };
+
+  /** The number of occupied slots. */
+  std::atomic<int64_t> occupied_slots_;
+
+  /** The number of keys that can be added, this is the total number of slots times 1/2. */
+  int64_t usable_slots_;
+
+  /**
+   * The number of slots minus one. This is a bit mask that can be used to turn any integer into a
+   * valid slot index efficiently.
+   */
+  uint64_t slot_mask_;
+
+  /** This is called to hash incoming keys. */
+  Hash hash_;
+
+  /** This is called to check equality of two keys. */
+  IsEqual is_equal_;
+
+  /**
+   * This is the array that contains the actual slots. It is allocated once in the constructor,
+   * its size is a power of two.
+   */
+  Array<Slot, 0, Allocator> slots_;
+
+  /** Iterate over a slot index sequence for a given hash. */
+#define CONCURRENT_MAP_SLOT_PROBING_BEGIN(HASH, R_SLOT) \
+  SLOT_PROBING_BEGIN (ProbingStrategy, HASH, slot_mask_, SLOT_INDEX) \
+    auto &R_SLOT = slots_[SLOT_INDEX];
+#define CONCURRENT_MAP_SLOT_PROBING_END() SLOT_PROBING_END()
+
+ public:
+  /**
+   * Create an empty map that can hold up to the given number of keys. The slot array is
+   * allocated here already and does not change afterwards.
+   */
+  explicit ConcurrentMap(const int64_t max_size, Allocator allocator = {})
+      : occupied_slots_(0),
+        usable_slots_(std::max<int64_t>(max_size, 1)),
+        slot_mask_((uint64_t)total_slot_amount_for_usable_slots(usable_slots_, 1, 2) - 1),
+        hash_(),
+        is_equal_(),
+        slots_((int64_t)slot_mask_ + 1, allocator)
+  {
+  }
+
+  ~ConcurrentMap() = default;
+
+  ConcurrentMap(const ConcurrentMap &other) = delete;
+  ConcurrentMap(ConcurrentMap &&other) = delete;
+  ConcurrentMap &operator=(const ConcurrentMap &other) = delete;
+  ConcurrentMap &operator=(ConcurrentMap &&other) = delete;
+
+  /**
+   * Add a key-value-pair to the map, unless the key exists already. Returns true when the pair
+   * has been added by this call. This can be called from multiple threads at the same time.
+   */
+  bool add(const Key &key, const Value &value)
+  {
+    return this->add_as(key, value);
+  }
+  bool add(Key &&key, const Value &value)
+  {
+    return this->add_as(std::move(key), value);
+  }
+  bool add(const Key &key, Value &&value)
+  {
+    return this->add_as(key, std::move(value));
+  }
+  bool add(Key &&key, Value &&value)
+  {
+    return this->add_as(std::move(key), std::move(value));
+  }
+  template<typename ForwardKey, typename ForwardValue>
+  bool add_as(ForwardKey &&key, ForwardValue &&value)
+  {
+    bool was_added = false;
+    this->lookup_or_add_cb__impl(
+        std::forward<ForwardKey>(key),
+        [&]() {
+          was_added = true;
+          return Value(std::forward<ForwardValue>(value));
+        },
+        hash_(key));
+    return was_added;
+  }
+
+  /**
+   * Returns a reference to the value that corresponds to the given key. If the key is not yet in
+   * the map, it will be added with the given value first. When multiple threads add the same key
+   * at the same time, all of them get a reference to the value of the thread that won.
+   */
+  Value &lookup_or_add(const Key &key, const Value &value)
+  {
+    return this->lookup_or_add_as(key, value);
+  }
+  Value &lookup_or_add(Key &&key, const Value &value)
+  {
+    return this->lookup_or_add_as(std::move(key), value);
+  }
+  Value &lookup_or_add(const Key &key, Value &&value)
+  {
+    return this->lookup_or_add_as(key, std::move(value));
+  }
+  Value &lookup_or_add(Key &&key, Value &&value)
+  {
+    return this->lookup_or_add_as(std::move(key), std::move(value));
+  }
+  template<typename ForwardKey, typename ForwardValue>
+  Value &lookup_or_add_as(ForwardKey &&key, ForwardValue &&value)
+  {
+    return this->lookup_or_add_cb__impl(
+        std::forward<ForwardKey>(key),
+        [&]() { return Value(std::forward<ForwardValue>(value)); },
+        hash_(key));
+  }
+
+  /**
+   * Returns a reference to the value that corresponds to the given key. If the key is not yet in
+   * the map, it will be added. The create_value callback is only called when the key is added by
+   * this thread, other threads never see a partially constructed value.
+   */
+  template<typename CreateValueF>
+  Value &lookup_or_add_cb(const Key &key, const CreateValueF &create_value)
+  {
+    return this->lookup_or_add_cb_as(key, create_value);
+  }
+  template<typename CreateValueF>
+  Value &lookup_or_add_cb(Key &&key, const CreateValueF &create_value)
+  {
+    return this->lookup_or_add_cb_as(std::move(key), create_value);
+  }
+  template<typename ForwardKey, typename CreateValueF>
+  Value &lookup_or_add_cb_as(ForwardKey &&key, const CreateValueF &create_value)
+  {
+    return this->lookup_or_add_cb__impl(std::forward<ForwardKey>(key), create_value, hash_(key));
+  }
+
+  /**
+   * Returns a pointer to the value that corresponds to the given key. If the key is not in the
+   * map, nullptr is returned. Keys that are currently being added by another thread are waited
+   * for.
+   */
+  const Value *lookup_ptr(const Key &key) const
+  {
+    return this->lookup_ptr_as(key);
+  }
+  Value *lookup_ptr(const Key &key)
+  {
+    return this->lookup_ptr_as(key);
+  }
+  template<typename ForwardKey> const Value *lookup_ptr_as(const ForwardKey &key) const
+  {
+    const Slot *slot = this->lookup_slot_ptr(key, hash_(key));
+    return (slot != nullptr) ? slot->value.ptr() : nullptr;
+  }
+  template<typename ForwardKey> Value *lookup_ptr_as(const ForwardKey &key)
+  {
+    return const_cast<Value *>(const_cast<const ConcurrentMap *>(this)->lookup_ptr_as(key));
+  }
+
+  /**
+   * Returns a reference to the value that corresponds to the given key. This invokes undefined
+   * behavior when the key is not in the map.
+   */
+  const Value &lookup(const Key &key) const
+  {
+    return this->lookup_as(key);
+  }
+  Value &lookup(const Key &key)
+  {
+    return this->lookup_as(key);
+  }
+  template<typename ForwardKey> const Value &lookup_as(const ForwardKey &key) const
+  {
+    const Value *ptr = this->lookup_ptr_as(key);
+    BLI_assert(ptr != nullptr);
+    return *ptr;
+  }
+  template<typename ForwardKey> Value &lookup_as(const ForwardKey &key)
+  {
+    Value *ptr = this->lookup_ptr_as(key);
+    BLI_assert(ptr != nullptr);
+    return *ptr;
+  }
+
+  /**
+   * Returns true if there is a key in the map that compares equal to the given key.
+   */
+  bool contains(const Key &key) const
+  {
+    return this->contains_as(key);
+  }
+  template<typename ForwardKey> bool contains_as(const ForwardKey &key) const
+  {
+    return this->lookup_slot_ptr(key, hash_(key)) != nullptr;
+  }
+
+  /**
+   * Calls the provided callback for every key-value-pair in the map. The callback is expected
+   * to take a `const Key &` as first and a `Value &` or `const Value &` as second parameter.
+   * This must not be called while other threads are adding keys.
+   */
+  template<typename FuncT> void foreach_item(const FuncT &func)
+  {
+    for (Slot &slot : slots_) {
+      if (slot.state.load(std::memory_order_relaxed) == SlotState::Occupied) {
+        func(*slot.key, *slot.value);
+      }
+    }
+  }
+  template<typename FuncT> void foreach_item(const FuncT &func) const
+  {
+    for (const Slot &slot : slots_) {
+      if (slot.state.load(std::memory_order_relaxed) == SlotState::Occupied) {
+        func(*slot.key, *slot.value);
+      }
+    }
+  }
+
+  /**
+   * Return the number of key-value-pairs that are stored in the map. While other threads are
+   * adding keys, this is only a snapshot.
+   */
+  int64_t size() const
+  {
+    return occupied_slots_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Returns true if there are no elements in the map.
+   */
+  bool is_empty() const
+  {
+    return this->size() == 0;
+  }
+
+  /**
+   * Returns the maximum number of keys that can be added to the map.
+   */
+  int64_t capacity() const
+  {
+    return usable_slots_;
+  }
+
+  /**
+   * Returns the number of available slots. This is mostly for debugging purposes.
+   */
+  int64_t size_in_slots() const
+  {
+    return slots_.size();
+  }
+
+  /**
+   * Returns the approximate memory requirements of the map in bytes.
+   */
+  int64_t size_in_bytes() const
+  {
+    return (int64_t)(sizeof(Slot) * (size_t)slots_.size());
+  }
+
+ private:
+  template<typename ForwardKey, typename CreateValueF>
+  Value &lookup_or_add_cb__impl(ForwardKey &&key,
+                                const CreateValueF &create_value,
+                                const uint64_t hash)
+  {
+    CONCURRENT_MAP_SLOT_PROBING_BEGIN (hash, slot) {
+      SlotState state = slot.state.load(std::memory_order_acquire);
+      if (state == SlotState::Empty) {
+        SlotState expected = SlotState::Empty;
+        if (slot.state.compare_exchange_strong(
+                expected, SlotState::Busy, std::memory_order_acquire)) {
+          const int64_t old_size = occupied_slots_.fetch_add(1, std::memory_order_relaxed);
+          UNUSED_VARS_NDEBUG(old_size);
+          BLI_assert(old_size < usable_slots_);
+          new (slot.key.ptr()) Key(std::forward<ForwardKey>(key));
+          new (slot.value.ptr()) Value(create_value());
+          slot.hash = hash;
+          slot.state.store(SlotState::Occupied, std::memory_order_release);
+          return *slot.value;
+        }
+        /* Another thread claimed the slot first, it might be adding the same key. */
+        state = expected;
+      }
+      if (state == SlotState::Busy) {
+        state = slot.wait_until_published();
+      }
+      BLI_assert(state == SlotState::Occupied);
+      if (slot.hash == hash && is_equal_(key, *slot.key)) {
+        return *slot.value;
+      }
+    }
+    CONCURRENT_MAP_SLOT_PROBING_END();
+  }
+
+  template<typename ForwardKey>
+  const Slot *lookup_slot_ptr(const ForwardKey &key, const uint64_t hash) const
+  {
+    CONCURRENT_MAP_SLOT_PROBING_BEGIN (hash, slot) {
+      const SlotState state = slot.wait_until_published();
+      if (state == SlotState::Empty) {
+        return nullptr;
+      }
+      if (slot.hash == hash && is_equal_(key, *slot.key)) {
+        return &slot;
+      }
+    }
+    CONCURRENT_MAP_SLOT_PROBING_END();
+  }
+};
+
+#undef CONCURRENT_MAP_SLOT_PROBING_BEGIN
+#undef CONCURRENT_MAP_SLOT_PROBING_END
+
+}  // namespace blender
@@ -0,0 +1,91 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A `blender::EnumerableThreadSpecific<T>` holds a separate instance of T for every thread that
+ * accesses it. The instance of the calling thread is created on first access with `local()`.
+ * After the parallel work is done, all instances can be iterated over, e.g. to merge the
+ * results. All instances are destructed together with the container.
+ *
+ * A common use case is a linear allocator per thread, for temporary allocations in a
+ * `parallel_for` loop that would otherwise all go through the global allocator:
+ *
+ *   EnumerableThreadSpecific<LinearAllocator<>> allocators;
+ *   parallel_for(IndexRange(size), 512, [&](IndexRange range) {
+ *     LinearAllocator<> &allocator = allocators.local();
+ *     ...
+ *   });
+ *
+ * Without TBB, parallel_for runs on the calling thread only, so there is just one instance.
+ */
+
+#include "BLI_task.hh"
+#include "BLI_utility_mixins.hh"
+
+namespace blender {
+
+template<typename T> class EnumerableThreadSpecific : NonCopyable, NonMovable {
+ private:
+#ifdef WITH_TBB
+  tbb::enumerable_thread_specific<T> values_;
+#else
+  T value_{};
+#endif
+
+ public:
+  EnumerableThreadSpecific() = default;
+
+  /**
+   * Get the instance of the calling thread. It is default constructed when this thread did not
+   * access the container before.
+   */
+  T &local()
+  {
+#ifdef WITH_TBB
+    return values_.local();
+#else
+    return value_;
+#endif
+  }
+
+  /**
+   * Iterate over the instances of all threads. This must not be used while other threads can
+   * still add instances by calling #local.
+   */
+  auto begin()
+  {
+#ifdef WITH_TBB
+    return values_.begin();
+#else
+    return &value_;
+#endif
+  }
+
+  auto end()
+  {
+#ifdef WITH_TBB
+    return values_.end();
+#else
+    return &value_ + 1;
+#endif
+  }
+};
+
+}  // namespace blender
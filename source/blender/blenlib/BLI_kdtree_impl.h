@@ -49,6 +49,13 @@ int BLI_kdtree_nd_(find_nearest_n)(const KDTree *tree,
                                    KDTreeNearest *r_nearest,
                                    const uint nearest_len_capacity) ATTR_NONNULL(1, 2, 3);
 
+void BLI_kdtree_nd_(find_nearest_n_multi)(const KDTree *tree,
+                                          const float (*co)[KD_DIMS],
+                                          const uint co_len,
+                                          KDTreeNearest *r_nearest,
+                                          const uint nearest_len_capacity,
+                                          int *r_nearest_len) ATTR_NONNULL(1, 2, 4);
+
 int BLI_kdtree_nd_(range_search)(const KDTree *tree,
                                  const float co[KD_DIMS],
                                  KDTreeNearest **r_nearest,
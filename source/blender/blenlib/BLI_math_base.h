@@ -215,6 +215,9 @@ MINLINE unsigned short round_db_to_ushort_clamp(double a);
 MINLINE int round_db_to_int_clamp(double a);
 MINLINE unsigned int round_db_to_uint_clamp(double a);
 
+MINLINE unsigned short float_to_half(float f);
+MINLINE float half_to_float(unsigned short h);
+
 int pow_i(int base, int exp);
 double double_round(double x, int ndigits);
 
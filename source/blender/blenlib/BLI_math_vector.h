@@ -456,6 +456,10 @@ void minmax_v2v2_v2(float min[2], float max[2], const float vec[2]);
 
 void minmax_v3v3_v3_array(float r_min[3], float r_max[3], const float (*vec_arr)[3], int nbr);
 
+/* Same as calling the single vector functions for every vector in the arrays, but faster. */
+void normalize_v3_array(float (*r)[3], const int len);
+void cross_v3_v3v3_array(float (*r)[3], const float (*a)[3], const float (*b)[3], const int len);
+
 void dist_ensure_v3_v3fl(float v1[3], const float v2[3], const float dist);
 void dist_ensure_v2_v2fl(float v1[2], const float v2[2], const float dist);
 
@@ -418,6 +418,21 @@ class NoInitialization {
 class NoExceptConstructor {
 };
 
+/**
+ * Trivially relocatable types can be moved to a different memory location with a plain memory
+ * copy, without calling their move constructor and destructor. Containers use this to grow their
+ * buffers with `reallocate`, which might avoid the copy entirely and does not need the old and
+ * new buffer at the same time.
+ *
+ * All trivially copyable types are trivially relocatable. Other types can opt in by specializing
+ * this struct, when they do not store pointers into themselves.
+ */
+template<typename T> struct is_trivially_relocatable : std::is_trivially_copyable<T> {
+};
+
+template<typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
 /**
  * Helper variable that checks if a pointer type can be converted into another pointer type without
  * issues. Possible issues are casting away const and casting a pointer to a child class.
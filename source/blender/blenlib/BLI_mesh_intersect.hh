@@ -357,6 +357,13 @@ IMesh trimesh_nary_intersect(const IMesh &tm_in,
                              bool use_self,
                              IMeshArena *arena);
 
+/**
+ * Return +1, 0, -1 as d is below, on, or above the oriented plane containing a, b, c in CCW
+ * order, like #orient3d for exact coordinates. The double coordinates are tried first, the
+ * exact ones are only used when the sign cannot be determined from them.
+ */
+int orient3d(const Vert *a, const Vert *b, const Vert *c, const Vert *d);
+
 /** This has the side effect of populating verts in the #IMesh. */
 void write_obj_mesh(IMesh &m, const std::string &objname);
 
@@ -41,14 +41,29 @@ typedef struct BLI_mmap_file BLI_mmap_file;
  * Note that this seeks to the end of the file to determine its length. */
 BLI_mmap_file *BLI_mmap_open(int fd) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
 
+/* Opens the file at the given path and prepares it for memory-mapped IO. The file itself is
+ * closed again, the mapping stays valid until #BLI_mmap_free.
+ * May return NULL if the file can't be opened or mapped. */
+BLI_mmap_file *BLI_mmap_open_path(const char *filepath) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL(1);
+
 /* Reads length bytes from file at the given offset into dest.
  * Returns whether the operation was successful (may fail when reading beyond the file
  * end or when IO errors occur). */
 bool BLI_mmap_read(BLI_mmap_file *file, void *dest, size_t offset, size_t length)
     ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
 
+/* Returns the start of the mapped file. When reading through this pointer directly instead of
+ * using #BLI_mmap_read, check #BLI_mmap_any_io_error when done, since the memory of a file that
+ * failed to read is replaced with zeroes. */
 void *BLI_mmap_get_pointer(BLI_mmap_file *file) ATTR_WARN_UNUSED_RESULT;
 
+/* Returns the length of the mapped file in bytes. */
+size_t BLI_mmap_get_length(const BLI_mmap_file *file) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+
+/* Returns whether an IO error occurred while reading the mapped memory. */
+bool BLI_mmap_any_io_error(const BLI_mmap_file *file) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+
 void BLI_mmap_free(BLI_mmap_file *file) ATTR_NONNULL(1);
 
 #ifdef __cplusplus
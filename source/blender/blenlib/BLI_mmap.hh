@@ -0,0 +1,170 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A `blender::MappedArray<T>` gives read-only access to an array of trivial values that is stored
+ * in a file, without reading the file into memory first. The file is mapped with
+ * #BLI_mmap_open_path, so only the pages that are actually accessed are loaded, and they are
+ * shared with the OS page cache instead of being copied. This is useful for large caches of which
+ * only a small part is needed at a time.
+ *
+ * The values are used as they are stored in the file, so the caller is responsible for handling
+ * the endianness. When the file cannot be read (e.g. it is on a network drive that became
+ * unavailable), the mapped memory is replaced with zeroes, #has_io_error should be checked after
+ * the values have been read.
+ */
+
+#include <algorithm>
+
+#include "BLI_mmap.h"
+#include "BLI_span.hh"
+#include "BLI_utility_mixins.hh"
+
+namespace blender {
+
+template<typename T> class MappedArray : NonCopyable {
+ private:
+  static_assert(std::is_trivial_v<T>, "only trivial types can be read from a file");
+
+  BLI_mmap_file *file_ = nullptr;
+  const T *data_ = nullptr;
+  int64_t size_ = 0;
+
+ public:
+  MappedArray() = default;
+
+  /**
+   * Map the values in the given file, starting at the byte offset. When size is negative, the
+   * array extends to the end of the file. When the file could not be opened or is too small, the
+   * array is invalid, see #is_valid.
+   */
+  MappedArray(const char *filepath, const int64_t offset = 0, const int64_t size = -1)
+  {
+    BLI_assert(offset >= 0);
+    /* The mapping starts at a page boundary, so the alignment only depends on the offset. */
+    if (offset % alignof(T) != 0) {
+      return;
+    }
+
+    BLI_mmap_file *file = BLI_mmap_open_path(filepath);
+    if (file == nullptr) {
+      return;
+    }
+
+    const int64_t length = static_cast<int64_t>(BLI_mmap_get_length(file));
+    const int64_t available_bytes = std::max<int64_t>(length - offset, 0);
+    const int64_t available_size = available_bytes / static_cast<int64_t>(sizeof(T));
+    if (size > available_size) {
+      BLI_mmap_free(file);
+      return;
+    }
+
+    file_ = file;
+    data_ = reinterpret_cast<const T *>(static_cast<const char *>(BLI_mmap_get_pointer(file)) +
+                                        offset);
+    size_ = (size < 0) ? available_size : size;
+  }
+
+  MappedArray(MappedArray &&other) noexcept
+      : file_(other.file_), data_(other.data_), size_(other.size_)
+  {
+    other.file_ = nullptr;
+    other.data_ = nullptr;
+    other.size_ = 0;
+  }
+
+  ~MappedArray()
+  {
+    if (file_ != nullptr) {
+      BLI_mmap_free(file_);
+    }
+  }
+
+  MappedArray &operator=(MappedArray &&other)
+  {
+    if (this == &other) {
+      return *this;
+    }
+    this->~MappedArray();
+    new (this) MappedArray(std::move(other));
+    return *this;
+  }
+
+  /**
+   * Returns false when the file could not be mapped. An invalid array is empty.
+   */
+  bool is_valid() const
+  {
+    return file_ != nullptr;
+  }
+
+  /**
+   * Returns true when reading the mapped memory failed. The values that could not be read are
+   * zero in that case.
+   */
+  bool has_io_error() const
+  {
+    return file_ != nullptr && BLI_mmap_any_io_error(file_);
+  }
+
+  operator Span<T>() const
+  {
+    return Span<T>(data_, size_);
+  }
+
+  Span<T> as_span() const
+  {
+    return *this;
+  }
+
+  const T &operator[](const int64_t index) const
+  {
+    BLI_assert(index >= 0);
+    BLI_assert(index < size_);
+    return data_[index];
+  }
+
+  const T *data() const
+  {
+    return data_;
+  }
+
+  int64_t size() const
+  {
+    return size_;
+  }
+
+  bool is_empty() const
+  {
+    return size_ == 0;
+  }
+
+  const T *begin() const
+  {
+    return data_;
+  }
+
+  const T *end() const
+  {
+    return data_ + size_;
+  }
+};
+
+}  // namespace blender
@@ -236,6 +236,10 @@ BLI_INLINE void BLI_parallel_range_settings_defaults(TaskParallelSettings *setti
   settings->min_iter_per_thread = 0;
 }
 
+/* Replace every value with the sum of the values before it and return the sum of all values,
+ * using multiple threads for large arrays. Commonly used to turn sizes into offsets. */
+int BLI_task_parallel_prefix_sum_i(int *data, const int len);
+
 /* Don't use this, store any thread specific data in tls->userdata_chunk instead.
  * Only here for code to be removed. */
 int BLI_task_parallel_thread_id(const TaskParallelTLS *tls);
@@ -299,6 +303,18 @@ int BLI_task_parallel_thread_id(const TaskParallelTLS *tls);
  *    TaskNode *node_3 = BLI_task_graph_node_create(task_graph, node_exec, task_data, NULL);
  *    TaskNode *node_4 = BLI_task_graph_node_create(task_graph, node_exec, task_data, NULL);
  *
+ * ** Profiling **
+ *
+ * When profiling is enabled the start and end time and the thread of every node that runs are
+ * recorded. They can be written as a trace in the Chrome trace event format, which can be viewed
+ * in `chrome://tracing` or Perfetto. Timestamps are absolute, so traces written by different
+ * graphs can be merged into a single view.
+ *
+ *    BLI_task_graph_use_profiling(task_graph, true);
+ *    BLI_task_graph_node_set_name(root, "Root");
+ *    ...
+ *    BLI_task_graph_work_and_wait(task_graph);
+ *    BLI_task_graph_trace_write(task_graph, "/tmp/task_graph.json");
  */
 struct TaskGraph;
 struct TaskNode;
@@ -315,6 +331,10 @@ struct TaskNode *BLI_task_graph_node_create(struct TaskGraph *task_graph,
                                             TaskGraphNodeFreeFunction free_func);
 bool BLI_task_graph_node_push_work(struct TaskNode *task_node);
 void BLI_task_graph_edge_create(struct TaskNode *from_node, struct TaskNode *to_node);
+/* Name shown for the node in traces, the string is not copied. */
+void BLI_task_graph_node_set_name(struct TaskNode *task_node, const char *name);
+void BLI_task_graph_use_profiling(struct TaskGraph *task_graph, bool use_profiling);
+bool BLI_task_graph_trace_write(const struct TaskGraph *task_graph, const char *filepath);
 
 #ifdef __cplusplus
 }
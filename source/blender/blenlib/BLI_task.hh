@@ -41,7 +41,11 @@
 #  endif
 #endif
 
+#include <algorithm>
+
+#include "BLI_array.hh"
 #include "BLI_index_range.hh"
+#include "BLI_span.hh"
 #include "BLI_utildefines.h"
 
 namespace blender {
@@ -75,4 +79,122 @@ void parallel_for(IndexRange range, int64_t grain_size, const Function &function
 #endif
 }
 
+/**
+ * Replace every value with the sum of all values before it, and return the sum of all values.
+ * This is an exclusive prefix sum, as it is used to turn a list of sizes into offsets.
+ */
+template<typename T> T parallel_prefix_sum(MutableSpan<T> data, const int64_t grain_size = 4096)
+{
+#ifdef WITH_TBB
+  if (data.size() > grain_size) {
+    return tbb::parallel_scan(
+        tbb::blocked_range<int64_t>(0, data.size(), grain_size),
+        T(0),
+        [&](const tbb::blocked_range<int64_t> &range, T sum, const bool is_final_scan) {
+          if (is_final_scan) {
+            for (const int64_t i : IndexRange(range.begin(), range.size())) {
+              const T value = data[i];
+              data[i] = sum;
+              sum += value;
+            }
+          }
+          else {
+            for (const int64_t i : IndexRange(range.begin(), range.size())) {
+              sum += data[i];
+            }
+          }
+          return sum;
+        },
+        [](const T &a, const T &b) { return a + b; });
+  }
+#else
+  UNUSED_VARS(grain_size);
+#endif
+  T sum = T(0);
+  for (T &value : data) {
+    const T size = value;
+    value = sum;
+    sum += size;
+  }
+  return sum;
+}
+
+/**
+ * Sort the range with multiple threads. Like std::sort, the sort is not stable.
+ */
+template<typename RandomAccessIterator, typename Compare>
+void parallel_sort(RandomAccessIterator begin, RandomAccessIterator end, const Compare &comp)
+{
+#ifdef WITH_TBB
+  tbb::parallel_sort(begin, end, comp);
+#else
+  std::sort(begin, end, comp);
+#endif
+}
+
+template<typename RandomAccessIterator>
+void parallel_sort(RandomAccessIterator begin, RandomAccessIterator end)
+{
+#ifdef WITH_TBB
+  tbb::parallel_sort(begin, end);
+#else
+  std::sort(begin, end);
+#endif
+}
+
+/**
+ * Reorder the values so that all values for which the predicate is true come before the values
+ * for which it is false, and return the number of values for which it is true. The partition is
+ * stable, the relative order of the values in both parts does not change.
+ */
+template<typename T, typename Predicate>
+int64_t parallel_partition(MutableSpan<T> data,
+                           const Predicate &predicate,
+                           const int64_t grain_size = 4096)
+{
+#ifdef WITH_TBB
+  if (data.size() > grain_size) {
+    const int64_t chunks_num = (data.size() + grain_size - 1) / grain_size;
+    auto chunk_range = [&](const int64_t chunk) {
+      const int64_t start = chunk * grain_size;
+      return IndexRange(start, std::min(grain_size, data.size() - start));
+    };
+
+    /* Count the values that pass the predicate in every chunk, to find the destination of the
+     * values of every chunk. */
+    Array<int64_t> true_offsets(chunks_num);
+    parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+      for (const int64_t chunk : chunks) {
+        int64_t count = 0;
+        for (const int64_t i : chunk_range(chunk)) {
+          count += predicate(data[i]) ? 1 : 0;
+        }
+        true_offsets[chunk] = count;
+      }
+    });
+    const int64_t true_size = parallel_prefix_sum<int64_t>(true_offsets);
+
+    Array<T> buffer(data.size(), NoInitialization());
+    parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+      for (const int64_t chunk : chunks) {
+        const IndexRange range = chunk_range(chunk);
+        int64_t true_index = true_offsets[chunk];
+        int64_t false_index = true_size + range.start() - true_offsets[chunk];
+        for (const int64_t i : range) {
+          const int64_t dst_index = predicate(data[i]) ? true_index++ : false_index++;
+          new (&buffer[dst_index]) T(std::move(data[i]));
+        }
+      }
+    });
+    parallel_for(data.index_range(), grain_size, [&](const IndexRange range) {
+      initialized_move_n(&buffer[range.start()], range.size(), &data[range.start()]);
+    });
+    return true_size;
+  }
+#else
+  UNUSED_VARS(grain_size);
+#endif
+  return std::stable_partition(data.begin(), data.end(), predicate) - data.begin();
+}
+
 }  // namespace blender
@@ -921,6 +921,22 @@ class Vector {
     const int64_t new_capacity = std::max(min_capacity, min_new_capacity);
     const int64_t size = this->size();
 
+    if constexpr (is_trivially_relocatable_v<T>) {
+      /* The allocator might be able to grow the buffer in place, in which case the old and new
+       * buffer don't have to exist at the same time. */
+      if (!this->is_inline()) {
+        begin_ = static_cast<T *>(
+            allocator_.reallocate(begin_,
+                                  static_cast<size_t>(this->capacity()) * sizeof(T),
+                                  static_cast<size_t>(new_capacity) * sizeof(T),
+                                  alignof(T),
+                                  AT));
+        end_ = begin_ + size;
+        capacity_end_ = begin_ + new_capacity;
+        return;
+      }
+    }
+
     T *new_array = static_cast<T *>(
         allocator_.allocate(static_cast<size_t>(new_capacity) * sizeof(T), alignof(T), AT));
     try {
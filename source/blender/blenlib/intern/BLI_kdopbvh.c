@@ -70,6 +70,17 @@
 #  define KDOPBVH_THREAD_LEAF_THRESHOLD 1024
 #endif
 
+/* Branches with at least this many leafs are refitted and split using multiple threads, so that
+ * the top levels of the tree don't have to be built on a single thread. */
+#ifdef DEBUG
+#  define KDOPBVH_THREAD_SPLIT_THRESHOLD 1024
+#else
+#  define KDOPBVH_THREAD_SPLIT_THRESHOLD 65536
+#endif
+
+/* Number of buckets the leafs are sorted into when splitting a branch using multiple threads. */
+#define KDOPBVH_SPLIT_BUCKETS 1024
+
 /* -------------------------------------------------------------------- */
 /** \name Struct Definitions
  * \{ */
@@ -384,33 +395,79 @@ static void create_kdop_hull(
   }
 }
 
+/* Grow the bounding volume to contain the given one. */
+static void kdop_hull_join(const BVHTree *tree,
+                           float *__restrict bv,
+                           const float *__restrict other)
+{
+  float newmin, newmax;
+  axis_t axis_iter;
+
+  /* for all Axes. */
+  for (axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
+    newmin = other[(2 * axis_iter)];
+    if ((newmin < bv[(2 * axis_iter)])) {
+      bv[(2 * axis_iter)] = newmin;
+    }
+
+    newmax = other[(2 * axis_iter) + 1];
+    if ((newmax > bv[(2 * axis_iter) + 1])) {
+      bv[(2 * axis_iter) + 1] = newmax;
+    }
+  }
+}
+
+typedef struct BVHRefitData {
+  const BVHTree *tree;
+} BVHRefitData;
+
+static void refit_kdop_hull_task_cb(void *__restrict userdata,
+                                    const int j,
+                                    const TaskParallelTLS *__restrict tls)
+{
+  const BVHRefitData *data = userdata;
+  kdop_hull_join(data->tree, tls->userdata_chunk, data->tree->nodes[j]->bv);
+}
+
+static void refit_kdop_hull_reduce(const void *__restrict userdata,
+                                   void *__restrict chunk_join,
+                                   void *__restrict chunk)
+{
+  const BVHRefitData *data = userdata;
+  kdop_hull_join(data->tree, chunk_join, chunk);
+}
+
 /**
  * \note depends on the fact that the BVH's for each face is already built
  */
 static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int end)
 {
-  float newmin, newmax;
   float *__restrict bv = node->bv;
   int j;
-  axis_t axis_iter;
 
   node_minmax_init(tree, node);
 
-  for (j = start; j < end; j++) {
-    float *__restrict node_bv = tree->nodes[j]->bv;
+  if (end - start >= KDOPBVH_THREAD_SPLIT_THRESHOLD) {
+    /* Large branches are at the top levels of the tree, where there are only few branches that
+     * can be refitted at the same time. */
+    BVHRefitData data = {.tree = tree};
+    float chunk_bv[26];
+    memcpy(chunk_bv, bv, sizeof(float) * 2 * tree->stop_axis);
 
-    /* for all Axes. */
-    for (axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
-      newmin = node_bv[(2 * axis_iter)];
-      if ((newmin < bv[(2 * axis_iter)])) {
-        bv[(2 * axis_iter)] = newmin;
-      }
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.userdata_chunk = chunk_bv;
+    settings.userdata_chunk_size = sizeof(chunk_bv);
+    settings.func_reduce = refit_kdop_hull_reduce;
+    settings.min_iter_per_thread = 4096;
+    BLI_task_parallel_range(start, end, &data, refit_kdop_hull_task_cb, &settings);
 
-      newmax = node_bv[(2 * axis_iter) + 1];
-      if ((newmax > bv[(2 * axis_iter) + 1])) {
-        bv[(2 * axis_iter) + 1] = newmax;
-      }
-    }
+    kdop_hull_join(tree, bv, chunk_bv);
+    return;
+  }
+
+  for (j = start; j < end; j++) {
+    kdop_hull_join(tree, bv, tree->nodes[j]->bv);
   }
 }
 
@@ -688,6 +745,138 @@ static void split_leafs(BVHNode **leafs_array,
   }
 }
 
+typedef struct BVHSplitData {
+  BVHNode **leafs_array;
+  /** Leafs ordered by bucket, before they are copied back to #leafs_array. */
+  BVHNode **sorted_array;
+  int begin, end;
+  int blocks_num;
+  int split_axis;
+  float key_min, key_scale;
+  /** Number of leafs per block and bucket, turned into the index to write the next leaf to. */
+  int *bucket_offsets;
+} BVHSplitData;
+
+static int split_block_begin(const BVHSplitData *data, const int block)
+{
+  return data->begin + (int)((int64_t)(data->end - data->begin) * block / data->blocks_num);
+}
+
+static int split_bucket_index(const BVHSplitData *data, const BVHNode *node)
+{
+  const int bucket = (int)((node->bv[data->split_axis] - data->key_min) * data->key_scale);
+  return CLAMPIS(bucket, 0, KDOPBVH_SPLIT_BUCKETS - 1);
+}
+
+static void split_leafs_count_task_cb(void *__restrict userdata,
+                                      const int block,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BVHSplitData *data = userdata;
+  int *counts = &data->bucket_offsets[block * KDOPBVH_SPLIT_BUCKETS];
+  const int block_end = split_block_begin(data, block + 1);
+  for (int i = split_block_begin(data, block); i < block_end; i++) {
+    counts[split_bucket_index(data, data->leafs_array[i])]++;
+  }
+}
+
+static void split_leafs_scatter_task_cb(void *__restrict userdata,
+                                        const int block,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BVHSplitData *data = userdata;
+  int *offsets = &data->bucket_offsets[block * KDOPBVH_SPLIT_BUCKETS];
+  const int block_end = split_block_begin(data, block + 1);
+  for (int i = split_block_begin(data, block); i < block_end; i++) {
+    BVHNode *node = data->leafs_array[i];
+    data->sorted_array[offsets[split_bucket_index(data, node)]++] = node;
+  }
+}
+
+static void split_leafs_copy_task_cb(void *__restrict userdata,
+                                     const int block,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BVHSplitData *data = userdata;
+  const int block_begin = split_block_begin(data, block);
+  const int block_end = split_block_begin(data, block + 1);
+  memcpy(&data->leafs_array[block_begin],
+         &data->sorted_array[block_begin - data->begin],
+         sizeof(BVHNode *) * (size_t)(block_end - block_begin));
+}
+
+/**
+ * Same as #split_leafs, but for large branches. The leafs are first sorted into buckets along
+ * the split axis using multiple threads, after which only the buckets that contain the partition
+ * boundaries have to be partitioned further.
+ */
+static void split_leafs_threaded(BVHNode **leafs_array,
+                                 const int nth[],
+                                 const int partitions,
+                                 const int split_axis,
+                                 const float key_min,
+                                 const float key_max)
+{
+  const int begin = nth[0];
+  const int end = nth[partitions];
+  const int blocks_num = min_ii(256, (end - begin) / 4096 + 1);
+
+  BVHSplitData data = {
+      .leafs_array = leafs_array,
+      .begin = begin,
+      .end = end,
+      .blocks_num = blocks_num,
+      .split_axis = split_axis,
+      .key_min = key_min,
+      .key_scale = (float)KDOPBVH_SPLIT_BUCKETS / (key_max - key_min),
+  };
+  data.sorted_array = MEM_malloc_arrayN((size_t)(end - begin), sizeof(BVHNode *), __func__);
+  data.bucket_offsets = MEM_calloc_arrayN(
+      (size_t)(blocks_num * KDOPBVH_SPLIT_BUCKETS), sizeof(int), __func__);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0, blocks_num, &data, split_leafs_count_task_cb, &settings);
+
+  /* Turn the counts into offsets, ordered by bucket first so that the leafs of every bucket are
+   * stored contiguously. */
+  int bucket_begin[KDOPBVH_SPLIT_BUCKETS + 1];
+  int offset = 0;
+  for (int bucket = 0; bucket < KDOPBVH_SPLIT_BUCKETS; bucket++) {
+    bucket_begin[bucket] = begin + offset;
+    for (int block = 0; block < blocks_num; block++) {
+      int *count = &data.bucket_offsets[block * KDOPBVH_SPLIT_BUCKETS + bucket];
+      const int bucket_size = *count;
+      *count = offset;
+      offset += bucket_size;
+    }
+  }
+  bucket_begin[KDOPBVH_SPLIT_BUCKETS] = end;
+
+  BLI_task_parallel_range(0, blocks_num, &data, split_leafs_scatter_task_cb, &settings);
+  BLI_task_parallel_range(0, blocks_num, &data, split_leafs_copy_task_cb, &settings);
+
+  MEM_freeN(data.sorted_array);
+  MEM_freeN(data.bucket_offsets);
+
+  /* The buckets are ordered along the split axis already, so only the bucket containing a
+   * partition boundary has to be partitioned. */
+  int bucket = 0;
+  for (int i = 1; i < partitions; i++) {
+    if (nth[i] >= end) {
+      break;
+    }
+    while (bucket_begin[bucket + 1] <= nth[i]) {
+      bucket++;
+    }
+    partition_nth_element(leafs_array,
+                          max_ii(bucket_begin[bucket], nth[i - 1]),
+                          bucket_begin[bucket + 1],
+                          nth[i],
+                          split_axis);
+  }
+}
+
 typedef struct BVHDivNodesData {
   const BVHTree *tree;
   BVHNode *branches_array;
@@ -739,7 +928,18 @@ static void non_recursive_bvh_div_nodes_task_cb(void *__restrict userdata,
     nth_positions[k] = implicit_leafs_index(data->data, data->depth + 1, child_level_index);
   }
 
-  split_leafs(data->leafs_array, nth_positions, data->tree_type, split_axis);
+  /* The leafs are sorted by the maximum of their bounds along the split axis. */
+  const int key_axis = split_axis;
+  const float key_min = parent->bv[key_axis - 1];
+  const float key_max = parent->bv[key_axis];
+  if (parent_leafs_end - parent_leafs_begin >= KDOPBVH_THREAD_SPLIT_THRESHOLD &&
+      key_min < key_max) {
+    split_leafs_threaded(
+        data->leafs_array, nth_positions, data->tree_type, split_axis, key_min, key_max);
+  }
+  else {
+    split_leafs(data->leafs_array, nth_positions, data->tree_type, split_axis);
+  }
 
   /* Setup children and totnode counters
    * Not really needed but currently most of BVH code
@@ -2077,6 +2277,224 @@ void BLI_bvhtree_ray_cast_all(BVHTree *tree,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name BLI_bvhtree_find_nearest_batch / BLI_bvhtree_ray_cast_batch
+ *
+ * Many queries at once, processed in spatially sorted order so that queries handled one after
+ * another by the same thread traverse the same parts of the tree.
+ * \{ */
+
+/* Number of queries that are processed one after another by the same thread. */
+#define BVH_BATCH_CHUNK_SIZE 256
+
+/**
+ * Order the coordinates along a Morton curve through a grid over their bounds. The grid has about
+ * as many cells as there are coordinates, so that a counting sort can be used.
+ */
+static int *bvhtree_batch_query_order(const float (*co)[3], const int co_num)
+{
+  float min[3], max[3];
+  INIT_MINMAX(min, max);
+  minmax_v3v3_v3_array(min, max, co, co_num);
+
+  int bits = 1;
+  while (bits < 6 && (1 << (3 * (bits + 1))) <= co_num) {
+    bits++;
+  }
+  const int cells_per_axis = 1 << bits;
+  const int cells_num = 1 << (3 * bits);
+
+  float scale[3];
+  for (int axis = 0; axis < 3; axis++) {
+    const float size = max[axis] - min[axis];
+    scale[axis] = (size > 0.0f) ? (float)cells_per_axis / size : 0.0f;
+  }
+
+  int *keys = MEM_malloc_arrayN((size_t)co_num, sizeof(int), __func__);
+  int *cell_offsets = MEM_calloc_arrayN((size_t)cells_num + 1, sizeof(int), __func__);
+  for (int i = 0; i < co_num; i++) {
+    int cell[3];
+    for (int axis = 0; axis < 3; axis++) {
+      cell[axis] = clamp_i((int)((co[i][axis] - min[axis]) * scale[axis]), 0, cells_per_axis - 1);
+    }
+    int key = 0;
+    for (int bit = 0; bit < bits; bit++) {
+      for (int axis = 0; axis < 3; axis++) {
+        key |= ((cell[axis] >> bit) & 1) << (3 * bit + axis);
+      }
+    }
+    keys[i] = key;
+    cell_offsets[key + 1]++;
+  }
+
+  for (int cell = 0; cell < cells_num; cell++) {
+    cell_offsets[cell + 1] += cell_offsets[cell];
+  }
+  int *order = MEM_malloc_arrayN((size_t)co_num, sizeof(int), __func__);
+  for (int i = 0; i < co_num; i++) {
+    order[cell_offsets[keys[i]]++] = i;
+  }
+
+  MEM_freeN(keys);
+  MEM_freeN(cell_offsets);
+  return order;
+}
+
+typedef struct BVHNearestBatchData {
+  BVHTree *tree;
+  const float (*co)[3];
+  const int *order;
+  int co_num;
+  BVHTreeNearest *nearest;
+  BVHTree_NearestPointCallback callback;
+  void *userdata;
+  int flag;
+} BVHNearestBatchData;
+
+static void bvhtree_find_nearest_batch_task_cb(void *__restrict userdata,
+                                               const int chunk,
+                                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHNearestBatchData *data = userdata;
+  const int start = chunk * BVH_BATCH_CHUNK_SIZE;
+  const int end = min_ii(start + BVH_BATCH_CHUNK_SIZE, data->co_num);
+
+  const BVHTreeNearest *previous = NULL;
+  for (int i = start; i < end; i++) {
+    const int index = data->order[i];
+    BVHTreeNearest *nearest = &data->nearest[index];
+
+    /* The previous query is close by, so the distance to the point it found limits the search to
+     * a small part of the tree. */
+    if (previous != NULL && previous->index != -1) {
+      const float dist_sq = len_squared_v3v3(data->co[index], previous->co);
+      if (dist_sq < nearest->dist_sq) {
+        *nearest = *previous;
+        nearest->dist_sq = dist_sq;
+      }
+    }
+
+    BLI_bvhtree_find_nearest_ex(
+        data->tree, data->co[index], nearest, data->callback, data->userdata, data->flag);
+    previous = nearest;
+  }
+}
+
+/**
+ * Find the nearest node for each of the coordinates, using multiple threads.
+ * Each #BVHTreeNearest has to be initialized like for #BLI_bvhtree_find_nearest_ex.
+ *
+ * \note The point found for one query is used to limit the search of the following ones, so the
+ * callback has to compute the nearest point of the elements, independent of previous results.
+ */
+void BLI_bvhtree_find_nearest_batch(BVHTree *tree,
+                                    const float (*co)[3],
+                                    const int co_num,
+                                    BVHTreeNearest *r_nearest,
+                                    BVHTree_NearestPointCallback callback,
+                                    void *userdata,
+                                    int flag)
+{
+  if (co_num == 0) {
+    return;
+  }
+
+  BVHNearestBatchData data = {
+      .tree = tree,
+      .co = co,
+      .order = bvhtree_batch_query_order(co, co_num),
+      .co_num = co_num,
+      .nearest = r_nearest,
+      .callback = callback,
+      .userdata = userdata,
+      .flag = flag,
+  };
+
+  const int chunks_num = (co_num + BVH_BATCH_CHUNK_SIZE - 1) / BVH_BATCH_CHUNK_SIZE;
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (co_num > KDOPBVH_THREAD_LEAF_THRESHOLD);
+  BLI_task_parallel_range(0, chunks_num, &data, bvhtree_find_nearest_batch_task_cb, &settings);
+
+  MEM_freeN((void *)data.order);
+}
+
+typedef struct BVHRayCastBatchData {
+  BVHTree *tree;
+  const float (*co)[3];
+  const float (*dir)[3];
+  const int *order;
+  int rays_num;
+  float radius;
+  BVHTreeRayHit *hits;
+  BVHTree_RayCastCallback callback;
+  void *userdata;
+  int flag;
+} BVHRayCastBatchData;
+
+static void bvhtree_ray_cast_batch_task_cb(void *__restrict userdata,
+                                           const int chunk,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHRayCastBatchData *data = userdata;
+  const int start = chunk * BVH_BATCH_CHUNK_SIZE;
+  const int end = min_ii(start + BVH_BATCH_CHUNK_SIZE, data->rays_num);
+
+  for (int i = start; i < end; i++) {
+    const int index = data->order[i];
+    BLI_bvhtree_ray_cast_ex(data->tree,
+                            data->co[index],
+                            data->dir[index],
+                            data->radius,
+                            &data->hits[index],
+                            data->callback,
+                            data->userdata,
+                            data->flag);
+  }
+}
+
+/**
+ * Cast many rays using multiple threads. Each #BVHTreeRayHit has to be initialized like for
+ * #BLI_bvhtree_ray_cast_ex.
+ */
+void BLI_bvhtree_ray_cast_batch(BVHTree *tree,
+                                const float (*co)[3],
+                                const float (*dir)[3],
+                                const int rays_num,
+                                float radius,
+                                BVHTreeRayHit *r_hits,
+                                BVHTree_RayCastCallback callback,
+                                void *userdata,
+                                int flag)
+{
+  if (rays_num == 0) {
+    return;
+  }
+
+  BVHRayCastBatchData data = {
+      .tree = tree,
+      .co = co,
+      .dir = dir,
+      .order = bvhtree_batch_query_order(co, rays_num),
+      .rays_num = rays_num,
+      .radius = radius,
+      .hits = r_hits,
+      .callback = callback,
+      .userdata = userdata,
+      .flag = flag,
+  };
+
+  const int chunks_num = (rays_num + BVH_BATCH_CHUNK_SIZE - 1) / BVH_BATCH_CHUNK_SIZE;
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (rays_num > KDOPBVH_THREAD_LEAF_THRESHOLD);
+  BLI_task_parallel_range(0, chunks_num, &data, bvhtree_ray_cast_batch_task_cb, &settings);
+
+  MEM_freeN((void *)data.order);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name BLI_bvhtree_range_query
  *
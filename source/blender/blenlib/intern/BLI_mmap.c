@@ -24,8 +24,10 @@
 #include "BLI_mmap.h"
 #include "BLI_fileops.h"
 #include "BLI_listbase.h"
+#include "BLI_threads.h"
 #include "MEM_guardedalloc.h"
 
+#include <fcntl.h>
 #include <string.h>
 
 #ifndef WIN32
@@ -73,6 +75,9 @@ struct error_handler_data {
   void (*next_handler)(int, siginfo_t *, void *);
 } error_handler = {0};
 
+/* Protects the list of mapped files, files can be opened and freed from multiple threads. */
+static ThreadMutex error_handler_mutex = BLI_MUTEX_INITIALIZER;
+
 static void sigbus_handler(int sig, siginfo_t *siginfo, void *ptr)
 {
   /* We only handle SIGBUS here for now. */
@@ -111,6 +116,7 @@ static void sigbus_handler(int sig, siginfo_t *siginfo, void *ptr)
 /* Ensures that the error handler is set up and ready. */
 static bool sigbus_handler_setup(void)
 {
+  BLI_mutex_lock(&error_handler_mutex);
   if (!error_handler.configured) {
     struct sigaction newact = {0}, oldact = {0};
 
@@ -118,6 +124,7 @@ static bool sigbus_handler_setup(void)
     newact.sa_flags = SA_SIGINFO;
 
     if (sigaction(SIGBUS, &newact, &oldact)) {
+      BLI_mutex_unlock(&error_handler_mutex);
       return false;
     }
 
@@ -126,6 +133,7 @@ static bool sigbus_handler_setup(void)
     error_handler.next_handler = oldact.sa_sigaction;
     error_handler.configured = 1;
   }
+  BLI_mutex_unlock(&error_handler_mutex);
 
   return true;
 }
@@ -133,14 +141,18 @@ static bool sigbus_handler_setup(void)
 /* Adds a file to the list that the error handler checks. */
 static void sigbus_handler_add(BLI_mmap_file *file)
 {
+  BLI_mutex_lock(&error_handler_mutex);
   BLI_addtail(&error_handler.open_mmaps, BLI_genericNodeN(file));
+  BLI_mutex_unlock(&error_handler_mutex);
 }
 
 /* Removes a file from the list that the error handler checks. */
 static void sigbus_handler_remove(BLI_mmap_file *file)
 {
+  BLI_mutex_lock(&error_handler_mutex);
   LinkData *link = BLI_findptr(&error_handler.open_mmaps, file, offsetof(LinkData, data));
   BLI_freelinkN(&error_handler.open_mmaps, link);
+  BLI_mutex_unlock(&error_handler_mutex);
 }
 #endif
 
@@ -191,6 +203,19 @@ BLI_mmap_file *BLI_mmap_open(int fd)
   return file;
 }
 
+BLI_mmap_file *BLI_mmap_open_path(const char *filepath)
+{
+  const int fd = BLI_open(filepath, O_BINARY | O_RDONLY, 0);
+  if (fd == -1) {
+    return NULL;
+  }
+
+  /* The mapping keeps its own reference to the file, so it can be closed right away. */
+  BLI_mmap_file *file = BLI_mmap_open(fd);
+  close(fd);
+  return file;
+}
+
 bool BLI_mmap_read(BLI_mmap_file *file, void *dest, size_t offset, size_t length)
 {
   /* If a previous read has already failed or we try to read past the end,
@@ -223,6 +248,16 @@ void *BLI_mmap_get_pointer(BLI_mmap_file *file)
   return file->memory;
 }
 
+size_t BLI_mmap_get_length(const BLI_mmap_file *file)
+{
+  return file->length;
+}
+
+bool BLI_mmap_any_io_error(const BLI_mmap_file *file)
+{
+  return file->io_error;
+}
+
 void BLI_mmap_free(BLI_mmap_file *file)
 {
 #ifndef WIN32
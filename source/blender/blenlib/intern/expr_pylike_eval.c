@@ -29,14 +29,16 @@
  *  - Literals:
  *      floating point and decimal integer.
  *  - Constants:
- *      pi, True, False
+ *      pi, e, tau, inf, True, False
  *  - Operators:
- *      +, -, *, /, ==, !=, <, <=, >, >=, and, or, not, ternary if
+ *      +, -, *, /, %, **, ==, !=, <, <=, >, >=, and, or, not, ternary if
  *  - Functions:
  *      min, max, radians, degrees,
  *      abs, fabs, floor, ceil, trunc, int,
  *      sin, cos, tan, asin, acos, atan, atan2,
- *      exp, log, sqrt, pow, fmod
+ *      sinh, cosh, tanh, asinh, acosh, atanh,
+ *      exp, log, log2, log10, sqrt, pow, fmod, hypot, copysign,
+ *      lerp, clamp, smoothstep
  *
  * The implementation has no global state and can be used multi-threaded.
  */
@@ -315,6 +317,16 @@ static double op_div(double a, double b)
   return a / b;
 }
 
+/* Python modulo, the result has the sign of the divisor. */
+static double op_mod(double a, double b)
+{
+  double result = fmod(a, b);
+  if (result != 0.0 && ((result < 0.0) != (b < 0.0))) {
+    result += b;
+  }
+  return result;
+}
+
 static double op_add(double a, double b)
 {
   return a + b;
@@ -405,7 +417,14 @@ typedef struct BuiltinConstDef {
 } BuiltinConstDef;
 
 static BuiltinConstDef builtin_consts[] = {
-    {"pi", M_PI}, {"True", 1.0}, {"False", 0.0}, {NULL, 0.0}};
+    {"pi", M_PI},
+    {"e", M_E},
+    {"tau", 2.0 * M_PI},
+    {"inf", INFINITY},
+    {"True", 1.0},
+    {"False", 0.0},
+    {NULL, 0.0},
+};
 
 typedef struct BuiltinOpDef {
   const char *name;
@@ -437,12 +456,22 @@ static BuiltinOpDef builtin_ops[] = {
     {"acos", OPCODE_FUNC1, acos},
     {"atan", OPCODE_FUNC1, atan},
     {"atan2", OPCODE_FUNC2, atan2},
+    {"sinh", OPCODE_FUNC1, sinh},
+    {"cosh", OPCODE_FUNC1, cosh},
+    {"tanh", OPCODE_FUNC1, tanh},
+    {"asinh", OPCODE_FUNC1, asinh},
+    {"acosh", OPCODE_FUNC1, acosh},
+    {"atanh", OPCODE_FUNC1, atanh},
     {"exp", OPCODE_FUNC1, exp},
     {"log", OPCODE_FUNC1, log},
     {"log", OPCODE_FUNC2, op_log2},
+    {"log2", OPCODE_FUNC1, log2},
+    {"log10", OPCODE_FUNC1, log10},
     {"sqrt", OPCODE_FUNC1, sqrt},
     {"pow", OPCODE_FUNC2, pow},
     {"fmod", OPCODE_FUNC2, fmod},
+    {"hypot", OPCODE_FUNC2, hypot},
+    {"copysign", OPCODE_FUNC2, copysign},
     {"lerp", OPCODE_FUNC3, op_lerp},
     {"clamp", OPCODE_FUNC1, op_clamp},
     {"clamp", OPCODE_FUNC3, op_clamp3},
@@ -477,6 +506,7 @@ static BuiltinOpDef builtin_ops[] = {
 #define TOKEN_NOT MAKE_CHAR2('N', 'O')
 #define TOKEN_IF MAKE_CHAR2('I', 'F')
 #define TOKEN_ELSE MAKE_CHAR2('E', 'L')
+#define TOKEN_POW MAKE_CHAR2('*', '*')
 
 static const char *token_eq_characters = "!=><";
 static const char *token_characters = "~`!@#$%^&*+-=/\\?:;<>(){}[]|.,\"'";
@@ -713,6 +743,13 @@ static bool parse_next_token(ExprParseState *state)
     return (end == out);
   }
 
+  /* ** token */
+  if (state->cur[0] == '*' && state->cur[1] == '*') {
+    state->token = TOKEN_POW;
+    state->cur += 2;
+    return true;
+  }
+
   /* ?= tokens */
   if (state->cur[1] == '=' && strchr(token_eq_characters, state->cur[0])) {
     state->token = MAKE_CHAR2(state->cur[0], state->cur[1]);
@@ -792,19 +829,11 @@ static int parse_function_args(ExprParseState *state)
   }
 }
 
-static bool parse_unary(ExprParseState *state)
+static bool parse_primary(ExprParseState *state)
 {
   int i;
 
   switch (state->token) {
-    case '+':
-      return parse_next_token(state) && parse_unary(state);
-
-    case '-':
-      CHECK_ERROR(parse_next_token(state) && parse_unary(state));
-      parse_add_func(state, OPCODE_FUNC1, 1, op_negate);
-      return true;
-
     case '(':
       return parse_next_token(state) && parse_expr(state) && state->token == ')' &&
              parse_next_token(state);
@@ -875,6 +904,37 @@ static bool parse_unary(ExprParseState *state)
   }
 }
 
+static bool parse_unary(ExprParseState *state);
+
+/* Power binds tighter than unary minus on its left, but not on its right: -x**-y = -(x**(-y)) */
+static bool parse_power(ExprParseState *state)
+{
+  CHECK_ERROR(parse_primary(state));
+
+  if (state->token == TOKEN_POW) {
+    CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+    parse_add_func(state, OPCODE_FUNC2, 2, pow);
+  }
+
+  return true;
+}
+
+static bool parse_unary(ExprParseState *state)
+{
+  switch (state->token) {
+    case '+':
+      return parse_next_token(state) && parse_unary(state);
+
+    case '-':
+      CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+      parse_add_func(state, OPCODE_FUNC1, 1, op_negate);
+      return true;
+
+    default:
+      return parse_power(state);
+  }
+}
+
 static bool parse_mul(ExprParseState *state)
 {
   CHECK_ERROR(parse_unary(state));
@@ -891,6 +951,11 @@ static bool parse_mul(ExprParseState *state)
         parse_add_func(state, OPCODE_FUNC2, 2, op_div);
         break;
 
+      case '%':
+        CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+        parse_add_func(state, OPCODE_FUNC2, 2, op_mod);
+        break;
+
       default:
         return true;
     }
@@ -22,6 +22,7 @@
 
 #include "BLI_kdtree_impl.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_strict_flags.h"
 #include "BLI_utildefines.h"
 
@@ -56,6 +57,14 @@ struct KDTree {
 #define KD_NEAR_ALLOC_INC 100 /* alloc increment for collecting nearest */
 #define KD_FOUND_ALLOC_INC 50 /* alloc increment for collecting nearest */
 
+/* Subtrees with more nodes are balanced in a separate task. */
+#define KD_BALANCE_PARALLEL_THRESHOLD 10000
+
+/* Trees with more nodes search for duplicate candidates in parallel. */
+#define KD_DUPLICATES_PARALLEL_THRESHOLD 10000
+/* Average number of candidates per node above which they are not stored, to limit memory usage. */
+#define KD_DUPLICATES_CANDIDATES_MAX_AVERAGE 16
+
 #define KD_NODE_UNSET ((uint)-1)
 
 /**
@@ -145,18 +154,24 @@ void BLI_kdtree_nd_(insert)(KDTree *tree, int index, const float co[KD_DIMS])
 #endif
 }
 
-static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+/**
+ * The index of the root node of a balanced subtree, this only depends on its size.
+ */
+static uint kdtree_balance_root(const uint nodes_len, const uint ofs)
 {
-  KDTreeNode *node;
-  float co;
-  uint left, right, median, i, j;
-
-  if (nodes_len <= 0) {
+  if (nodes_len == 0) {
     return KD_NODE_UNSET;
   }
-  else if (nodes_len == 1) {
-    return 0 + ofs;
-  }
+  return nodes_len / 2 + ofs;
+}
+
+/**
+ * Sort the nodes around the median along the given axis (quick-select). Returns the median.
+ */
+static uint kdtree_balance_partition(KDTreeNode *nodes, uint nodes_len, uint axis)
+{
+  float co;
+  uint left, right, median, i, j;
 
   /* quicksort style sorting around median */
   left = 0;
@@ -190,6 +205,23 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
     }
   }
 
+  return median;
+}
+
+static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+{
+  KDTreeNode *node;
+  uint median;
+
+  if (nodes_len <= 0) {
+    return KD_NODE_UNSET;
+  }
+  else if (nodes_len == 1) {
+    return 0 + ofs;
+  }
+
+  median = kdtree_balance_partition(nodes, nodes_len, axis);
+
   /* set node and sort subnodes */
   node = &nodes[median];
   node->d = axis;
@@ -201,6 +233,51 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
   return median + ofs;
 }
 
+typedef struct KDTreeBalanceTask {
+  KDTreeNode *nodes;
+  uint nodes_len;
+  uint axis;
+  uint ofs;
+} KDTreeBalanceTask;
+
+/**
+ * Same as #kdtree_balance, but large subtrees are balanced in separate tasks. A subtree only
+ * depends on its own nodes and the index of its root is known up-front (see
+ * #kdtree_balance_root), so the resulting tree is the same as when balancing on a single thread.
+ */
+static void kdtree_balance_task(TaskPool *__restrict pool, void *taskdata)
+{
+  const KDTreeBalanceTask *task = taskdata;
+  KDTreeNode *nodes = task->nodes;
+  uint nodes_len = task->nodes_len;
+  uint axis = task->axis;
+
+  while (nodes_len > KD_BALANCE_PARALLEL_THRESHOLD) {
+    const uint median = kdtree_balance_partition(nodes, nodes_len, axis);
+    const uint right_len = nodes_len - (median + 1);
+
+    KDTreeNode *node = &nodes[median];
+    node->d = axis;
+    axis = (axis + 1) % KD_DIMS;
+    node->left = kdtree_balance_root(median, task->ofs);
+    node->right = kdtree_balance_root(right_len, (median + 1) + task->ofs);
+
+    /* Balance the right side in a new task and continue with the left side. */
+    KDTreeBalanceTask *task_right = MEM_mallocN(sizeof(*task_right), __func__);
+    task_right->nodes = nodes + median + 1;
+    task_right->nodes_len = right_len;
+    task_right->axis = axis;
+    task_right->ofs = (median + 1) + task->ofs;
+    BLI_task_pool_push(pool, kdtree_balance_task, task_right, true, NULL);
+
+    nodes_len = median;
+  }
+
+  const uint root = kdtree_balance(nodes, nodes_len, axis, task->ofs);
+  BLI_assert(root == kdtree_balance_root(nodes_len, task->ofs));
+  UNUSED_VARS_NDEBUG(root);
+}
+
 void BLI_kdtree_nd_(balance)(KDTree *tree)
 {
   if (tree->root != KD_NODE_ROOT_IS_INIT) {
@@ -210,7 +287,17 @@ void BLI_kdtree_nd_(balance)(KDTree *tree)
     }
   }
 
-  tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  if (tree->nodes_len > KD_BALANCE_PARALLEL_THRESHOLD) {
+    KDTreeBalanceTask task = {tree->nodes, tree->nodes_len, 0, 0};
+    TaskPool *task_pool = BLI_task_pool_create(NULL, TASK_PRIORITY_HIGH);
+    kdtree_balance_task(task_pool, &task);
+    BLI_task_pool_work_and_wait(task_pool);
+    BLI_task_pool_free(task_pool);
+    tree->root = kdtree_balance_root(tree->nodes_len, 0);
+  }
+  else {
+    tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  }
 
 #ifdef DEBUG
   tree->is_balanced = true;
@@ -600,6 +687,126 @@ int BLI_kdtree_nd_(find_nearest_n)(const KDTree *tree,
       tree, co, r_nearest, nearest_len_capacity, NULL, NULL);
 }
 
+typedef struct KDTreeQueryOrder {
+  uint64_t code;
+  uint index;
+} KDTreeQueryOrder;
+
+static int kdtree_query_order_cmp(const void *a, const void *b)
+{
+  const KDTreeQueryOrder *qa = a;
+  const KDTreeQueryOrder *qb = b;
+
+  if (qa->code < qb->code) {
+    return -1;
+  }
+  if (qa->code > qb->code) {
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * Order the query points along a Z-order curve, so that consecutive queries traverse mostly the
+ * same nodes of the tree.
+ */
+static KDTreeQueryOrder *kdtree_query_order(const float (*co)[KD_DIMS], const uint co_len)
+{
+  float min[KD_DIMS], scale[KD_DIMS];
+  for (uint j = 0; j < KD_DIMS; j++) {
+    float max = min[j] = co[0][j];
+    for (uint i = 1; i < co_len; i++) {
+      min[j] = min_ff(min[j], co[i][j]);
+      max = max_ff(max, co[i][j]);
+    }
+    /* Quantize every axis to 16 bits, so the code of four dimensions fits in 64 bits. */
+    scale[j] = (max > min[j]) ? 65535.0f / (max - min[j]) : 0.0f;
+  }
+
+  KDTreeQueryOrder *order = MEM_mallocN(sizeof(*order) * co_len, __func__);
+  for (uint i = 0; i < co_len; i++) {
+    uint quantized[KD_DIMS];
+    for (uint j = 0; j < KD_DIMS; j++) {
+      quantized[j] = (uint)((co[i][j] - min[j]) * scale[j]);
+    }
+
+    uint64_t code = 0;
+    for (uint bit = 16; bit--;) {
+      for (uint j = 0; j < KD_DIMS; j++) {
+        code = (code << 1) | ((quantized[j] >> bit) & 1);
+      }
+    }
+    order[i].code = code;
+    order[i].index = i;
+  }
+
+  qsort(order, co_len, sizeof(*order), kdtree_query_order_cmp);
+  return order;
+}
+
+typedef struct KDTreeFindNearestNMultiData {
+  const KDTree *tree;
+  const float (*co)[KD_DIMS];
+  const KDTreeQueryOrder *order;
+  KDTreeNearest *r_nearest;
+  uint nearest_len_capacity;
+  int *r_nearest_len;
+} KDTreeFindNearestNMultiData;
+
+static void kdtree_find_nearest_n_multi_cb(void *__restrict userdata,
+                                           const int iter,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDTreeFindNearestNMultiData *data = userdata;
+  const uint index = data->order[iter].index;
+
+  const int nearest_len = BLI_kdtree_nd_(find_nearest_n)(
+      data->tree,
+      data->co[index],
+      &data->r_nearest[(size_t)index * data->nearest_len_capacity],
+      data->nearest_len_capacity);
+  if (data->r_nearest_len) {
+    data->r_nearest_len[index] = nearest_len;
+  }
+}
+
+/**
+ * Same as calling #BLI_kdtree_3d_find_nearest_n for every point in \a co, but the queries are
+ * sorted spatially and run in parallel.
+ *
+ * \param r_nearest: The results of the point at index `i` are stored at
+ * `r_nearest[i * nearest_len_capacity]`, sorted by distance.
+ * \param r_nearest_len: Optionally receives the number of results of every point.
+ */
+void BLI_kdtree_nd_(find_nearest_n_multi)(const KDTree *tree,
+                                          const float (*co)[KD_DIMS],
+                                          const uint co_len,
+                                          KDTreeNearest *r_nearest,
+                                          const uint nearest_len_capacity,
+                                          int *r_nearest_len)
+{
+  if (co_len == 0) {
+    return;
+  }
+
+  KDTreeFindNearestNMultiData data = {
+      .tree = tree,
+      .co = co,
+      .order = kdtree_query_order(co, co_len),
+      .r_nearest = r_nearest,
+      .nearest_len_capacity = nearest_len_capacity,
+      .r_nearest_len = r_nearest_len,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (co_len > 256);
+  settings.min_iter_per_thread = 64;
+  BLI_task_parallel_range(0, (int)co_len, &data, kdtree_find_nearest_n_multi_cb, &settings);
+
+  MEM_freeN((void *)data.order);
+}
+
 static int nearest_cmp_dist(const void *a, const void *b)
 {
   const KDTreeNearest *kda = a;
@@ -866,6 +1073,129 @@ static void deduplicate_recursive(const struct DeDuplicateParams *p, uint i)
   }
 }
 
+/**
+ * Collect the indices of all nodes which #deduplicate_recursive would consider a duplicate of
+ * \a search, regardless of whether they are merged already. Only counts them when
+ * \a r_candidates is NULL.
+ */
+static void deduplicate_candidates_recursive(const struct DeDuplicateParams *p,
+                                             uint i,
+                                             int *r_candidates,
+                                             uint *r_candidates_len)
+{
+  const KDTreeNode *node = &p->nodes[i];
+  if (p->search_co[node->d] + p->range <= node->co[node->d]) {
+    if (node->left != KD_NODE_UNSET) {
+      deduplicate_candidates_recursive(p, node->left, r_candidates, r_candidates_len);
+    }
+  }
+  else if (p->search_co[node->d] - p->range >= node->co[node->d]) {
+    if (node->right != KD_NODE_UNSET) {
+      deduplicate_candidates_recursive(p, node->right, r_candidates, r_candidates_len);
+    }
+  }
+  else {
+    if (p->search != node->index) {
+      if (len_squared_vnvn(node->co, p->search_co) <= p->range_sq) {
+        if (r_candidates) {
+          r_candidates[*r_candidates_len] = node->index;
+        }
+        *r_candidates_len += 1;
+      }
+    }
+    if (node->left != KD_NODE_UNSET) {
+      deduplicate_candidates_recursive(p, node->left, r_candidates, r_candidates_len);
+    }
+    if (node->right != KD_NODE_UNSET) {
+      deduplicate_candidates_recursive(p, node->right, r_candidates, r_candidates_len);
+    }
+  }
+}
+
+struct DeDuplicateCandidatesData {
+  const KDTree *tree;
+  float range;
+  /** Start of the candidates of every node in #candidates, with one extra item for the end. */
+  uint *candidates_offset;
+  /** Candidates of all nodes, NULL while counting them. */
+  int *candidates;
+};
+
+static void deduplicate_candidates_cb(void *__restrict userdata,
+                                      const int node_index,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  struct DeDuplicateCandidatesData *data = userdata;
+  const KDTreeNode *node = &data->tree->nodes[node_index];
+  struct DeDuplicateParams p = {
+      .nodes = data->tree->nodes,
+      .range = data->range,
+      .range_sq = square_f(data->range),
+      .search = node->index,
+  };
+  copy_vn_vn(p.search_co, node->co);
+
+  uint candidates_len = 0;
+  if (data->candidates == NULL) {
+    deduplicate_candidates_recursive(&p, data->tree->root, NULL, &candidates_len);
+    data->candidates_offset[node_index] = candidates_len;
+  }
+  else {
+    deduplicate_candidates_recursive(&p,
+                                     data->tree->root,
+                                     &data->candidates[data->candidates_offset[node_index]],
+                                     &candidates_len);
+    BLI_assert(data->candidates_offset[node_index] + candidates_len ==
+               data->candidates_offset[node_index + 1]);
+  }
+}
+
+/**
+ * Find the duplicate candidates of all nodes in parallel. The merging itself depends on the
+ * order in which the nodes are handled, so it's done afterwards, but without any tree lookups.
+ *
+ * \return False when there are too many candidates to store them.
+ */
+static bool deduplicate_candidates_find(const KDTree *tree,
+                                        const float range,
+                                        uint **r_candidates_offset,
+                                        int **r_candidates)
+{
+  struct DeDuplicateCandidatesData data = {
+      .tree = tree,
+      .range = range,
+      .candidates_offset = MEM_malloc_arrayN(
+          tree->nodes_len + 1, sizeof(*data.candidates_offset), __func__),
+      .candidates = NULL,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+
+  /* Count, turn the counts into offsets, then fill. */
+  BLI_task_parallel_range(0, (int)tree->nodes_len, &data, deduplicate_candidates_cb, &settings);
+
+  size_t candidates_len = 0;
+  for (uint i = 0; i < tree->nodes_len; i++) {
+    const uint len = data.candidates_offset[i];
+    data.candidates_offset[i] = (uint)candidates_len;
+    candidates_len += len;
+  }
+  if (candidates_len > (size_t)tree->nodes_len * KD_DUPLICATES_CANDIDATES_MAX_AVERAGE) {
+    MEM_freeN(data.candidates_offset);
+    return false;
+  }
+  data.candidates_offset[tree->nodes_len] = (uint)candidates_len;
+  data.candidates = MEM_malloc_arrayN(candidates_len, sizeof(*data.candidates), __func__);
+
+  BLI_task_parallel_range(0, (int)tree->nodes_len, &data, deduplicate_candidates_cb, &settings);
+
+  *r_candidates_offset = data.candidates_offset;
+  *r_candidates = data.candidates;
+  return true;
+}
+
 /**
  * Find duplicate points in \a range.
  * Favors speed over quality since it doesn't find the best target vertex for merging.
@@ -898,40 +1228,41 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
       .duplicates_found = &found,
   };
 
-  if (use_index_order) {
-    uint *order = kdtree_order(tree);
-    for (uint i = 0; i < tree->nodes_len; i++) {
-      const uint node_index = order[i];
-      const int index = (int)i;
-      if (ELEM(duplicates[index], -1, index)) {
-        p.search = index;
-        copy_vn_vn(p.search_co, tree->nodes[node_index].co);
-        int found_prev = found;
-        deduplicate_recursive(&p, tree->root);
-        if (found != found_prev) {
-          /* Prevent chains of doubles. */
-          duplicates[index] = index;
+  uint *candidates_offset = NULL;
+  int *candidates = NULL;
+  if (tree->nodes_len > KD_DUPLICATES_PARALLEL_THRESHOLD) {
+    deduplicate_candidates_find(tree, range, &candidates_offset, &candidates);
+  }
+
+  uint *order = use_index_order ? kdtree_order(tree) : NULL;
+  for (uint i = 0; i < tree->nodes_len; i++) {
+    const uint node_index = order ? order[i] : i;
+    const int index = p.nodes[node_index].index;
+    if (ELEM(duplicates[index], -1, index)) {
+      int found_prev = found;
+      if (candidates) {
+        for (uint j = candidates_offset[node_index]; j < candidates_offset[node_index + 1]; j++) {
+          if (duplicates[candidates[j]] == -1) {
+            duplicates[candidates[j]] = index;
+            found += 1;
+          }
         }
       }
-    }
-    MEM_freeN(order);
-  }
-  else {
-    for (uint i = 0; i < tree->nodes_len; i++) {
-      const uint node_index = i;
-      const int index = p.nodes[node_index].index;
-      if (ELEM(duplicates[index], -1, index)) {
+      else {
         p.search = index;
         copy_vn_vn(p.search_co, tree->nodes[node_index].co);
-        int found_prev = found;
         deduplicate_recursive(&p, tree->root);
-        if (found != found_prev) {
-          /* Prevent chains of doubles. */
-          duplicates[index] = index;
-        }
+      }
+      if (found != found_prev) {
+        /* Prevent chains of doubles. */
+        duplicates[index] = index;
       }
     }
   }
+
+  MEM_SAFE_FREE(order);
+  MEM_SAFE_FREE(candidates_offset);
+  MEM_SAFE_FREE(candidates);
   return found;
 }
 
@@ -340,6 +340,69 @@ MINLINE signed char round_db_to_char_clamp(double a){
 #undef _round_clamp_fl_impl
 #undef _round_clamp_db_impl
 
+/**
+ * Convert to IEEE 754 half precision, rounding to nearest even.
+ * Values too large for half precision become infinity, NaN stays NaN.
+ */
+MINLINE unsigned short float_to_half(float f)
+{
+  union {
+    float f;
+    unsigned int u;
+  } in, denorm_magic;
+  const unsigned int f32_infinity = 255u << 23;
+  const unsigned int f16_max = (127u + 16u) << 23;
+  unsigned short result;
+
+  denorm_magic.u = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+  in.f = f;
+  const unsigned int sign = in.u & 0x80000000u;
+  in.u ^= sign;
+
+  if (in.u >= f16_max) {
+    result = (in.u > f32_infinity) ? 0x7e00 : 0x7c00;
+  }
+  else if (in.u < (113u << 23)) {
+    /* Denormal or zero, the float addition does the rounding. */
+    in.f += denorm_magic.f;
+    result = (unsigned short)(in.u - denorm_magic.u);
+  }
+  else {
+    const unsigned int mantissa_odd = (in.u >> 13) & 1u;
+    /* Rebias the exponent and round. */
+    in.u += ((unsigned int)(15 - 127) << 23) + 0xfffu;
+    in.u += mantissa_odd;
+    result = (unsigned short)(in.u >> 13);
+  }
+  return result | (unsigned short)(sign >> 16);
+}
+
+MINLINE float half_to_float(unsigned short h)
+{
+  union {
+    float f;
+    unsigned int u;
+  } out, magic;
+  const unsigned int shifted_exponent = 0x7c00u << 13;
+
+  magic.u = 113u << 23;
+  out.u = (h & 0x7fffu) << 13;
+  const unsigned int exponent = shifted_exponent & out.u;
+  out.u += (127u - 15u) << 23;
+
+  if (exponent == shifted_exponent) {
+    /* Infinity or NaN. */
+    out.u += (128u - 16u) << 23;
+  }
+  else if (exponent == 0) {
+    /* Zero or denormal, renormalize. */
+    out.u += 1u << 23;
+    out.f -= magic.f;
+  }
+  out.u |= (unsigned int)(h & 0x8000u) << 16;
+  return out.f;
+}
+
 /* integer division that rounds 0.5 up, particularly useful for color blending
  * with integers, to avoid gradual darkening when rounding down */
 MINLINE int divide_round_i(int a, int b)
@@ -749,6 +749,41 @@ void mul_v3_m4v3(float r[3], const float mat[4][4], const float vec[3])
   r[2] = x * mat[0][2] + y * mat[1][2] + mat[2][2] * vec[2] + mat[3][2];
 }
 
+/**
+ * Transform an array of positions, this gives the same result as calling #mul_v3_m4v3 for every
+ * position but is faster. \a r and \a v may be the same array.
+ */
+void mul_v3_m4v3_array(float (*r)[3], const float M[4][4], const float (*v)[3], const int len)
+{
+#ifdef __SSE2__
+  const __m128 M0 = _mm_loadu_ps(M[0]);
+  const __m128 M1 = _mm_loadu_ps(M[1]);
+  const __m128 M2 = _mm_loadu_ps(M[2]);
+  const __m128 M3 = _mm_loadu_ps(M[3]);
+
+  for (int i = 0; i < len; i++) {
+    /* Keep the order of operations of #mul_v3_m4v3. */
+    const __m128 x = _mm_mul_ps(M0, _mm_set1_ps(v[i][0]));
+    const __m128 y = _mm_mul_ps(M1, _mm_set1_ps(v[i][1]));
+    const __m128 z = _mm_mul_ps(M2, _mm_set1_ps(v[i][2]));
+    const __m128 co = _mm_add_ps(_mm_add_ps(_mm_add_ps(x, y), z), M3);
+
+    /* Only store three components, the fourth would overwrite the next position. */
+    _mm_storel_pi((__m64 *)r[i], co);
+    _mm_store_ss(&r[i][2], _mm_movehl_ps(co, co));
+  }
+#else
+  for (int i = 0; i < len; i++) {
+    mul_v3_m4v3(r[i], M, v[i]);
+  }
+#endif
+}
+
+void mul_m4_v3_array(const float M[4][4], float (*r)[3], const int len)
+{
+  mul_v3_m4v3_array(r, M, (const float(*)[3])r, len);
+}
+
 void mul_v3_m4v3_db(double r[3], const double mat[4][4], const double vec[3])
 {
   const double x = vec[0];
@@ -1043,6 +1043,92 @@ void minmax_v3v3_v3_array(float r_min[3], float r_max[3], const float (*vec_arr)
   }
 }
 
+#ifdef __SSE2__
+/* Load four consecutive 3D vectors into one register per component. */
+BLI_INLINE void load_v3_array_x4(const float (*v)[3], __m128 *r_x, __m128 *r_y, __m128 *r_z)
+{
+  /* a = [x0 y0 z0 x1], b = [y1 z1 x2 y2], c = [z2 x3 y3 z3]. */
+  const __m128 a = _mm_loadu_ps(v[0]);
+  const __m128 b = _mm_loadu_ps(v[1] + 1);
+  const __m128 c = _mm_loadu_ps(v[2] + 2);
+
+  *r_x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 1, 0, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+  *r_y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 0, 1)),
+                        _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 2, 0, 3)),
+                        _MM_SHUFFLE(2, 0, 2, 0));
+  *r_z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+                        _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)),
+                        _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+/* Inverse of #load_v3_array_x4. */
+BLI_INLINE void store_v3_array_x4(float (*r)[3], const __m128 x, const __m128 y, const __m128 z)
+{
+  const __m128 xy_lo = _mm_unpacklo_ps(x, y);
+  const __m128 xy_hi = _mm_unpackhi_ps(x, y);
+
+  _mm_storeu_ps(r[0],
+                _mm_shuffle_ps(xy_lo, _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)),
+                               _MM_SHUFFLE(2, 0, 1, 0)));
+  _mm_storeu_ps(r[1] + 1,
+                _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)),
+                               xy_hi,
+                               _MM_SHUFFLE(1, 0, 2, 0)));
+  _mm_storeu_ps(r[2] + 2,
+                _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+                               _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)),
+                               _MM_SHUFFLE(2, 0, 2, 0)));
+}
+#endif
+
+void normalize_v3_array(float (*r)[3], const int len)
+{
+  int i = 0;
+
+#ifdef __SSE2__
+  const __m128 threshold = _mm_set1_ps(1.0e-35f);
+  const __m128 one = _mm_set1_ps(1.0f);
+  for (; i + 4 <= len; i += 4) {
+    __m128 x, y, z;
+    load_v3_array_x4(&r[i], &x, &y, &z);
+
+    /* Same operations as #normalize_v3, so that the result is the same. */
+    const __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+    const __m128 mask = _mm_cmpgt_ps(d, threshold);
+    const __m128 f = _mm_and_ps(_mm_div_ps(one, _mm_sqrt_ps(d)), mask);
+
+    store_v3_array_x4(&r[i], _mm_mul_ps(x, f), _mm_mul_ps(y, f), _mm_mul_ps(z, f));
+  }
+#endif
+
+  for (; i < len; i++) {
+    normalize_v3(r[i]);
+  }
+}
+
+void cross_v3_v3v3_array(float (*r)[3], const float (*a)[3], const float (*b)[3], const int len)
+{
+  BLI_assert(r != a && r != b);
+  int i = 0;
+
+#ifdef __SSE2__
+  for (; i + 4 <= len; i += 4) {
+    __m128 ax, ay, az, bx, by, bz;
+    load_v3_array_x4(&a[i], &ax, &ay, &az);
+    load_v3_array_x4(&b[i], &bx, &by, &bz);
+
+    store_v3_array_x4(&r[i],
+                      _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by)),
+                      _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz)),
+                      _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx)));
+  }
+#endif
+
+  for (; i < len; i++) {
+    cross_v3_v3v3(r[i], a[i], b[i]);
+  }
+}
+
 /** ensure \a v1 is \a dist from \a v2 */
 void dist_ensure_v3_v3fl(float v1[3], const float v2[3], const float dist)
 {
@@ -873,9 +873,6 @@ static int sort_tris_class(const Face &tri, const Face &tri0, const Edge e)
   if (dbg_level > 0) {
     std::cout << "classify  e = " << e << "\n";
   }
-  mpq3 a0 = tri0[0]->co_exact;
-  mpq3 a1 = tri0[1]->co_exact;
-  mpq3 a2 = tri0[2]->co_exact;
   bool rev;
   bool rev0;
   const Vert *flapv0 = find_flap_vert(tri0, e, &rev0);
@@ -887,9 +884,8 @@ static int sort_tris_class(const Face &tri, const Face &tri0, const Edge e)
     std::cout << " rev = " << rev << " flapv = " << flapv << "\n";
   }
   BLI_assert(flapv != nullptr && flapv0 != nullptr);
-  const mpq3 flap = flapv->co_exact;
-  /* orient will be positive if flap is below oriented plane of a0,a1,a2. */
-  int orient = orient3d(a0, a1, a2, flap);
+  /* orient will be positive if flap is below oriented plane of tri0. */
+  int orient = orient3d(tri0[0], tri0[1], tri0[2], flapv);
   int ans;
   if (orient > 0) {
     ans = rev0 ? 4 : 3;
@@ -31,9 +31,11 @@
 #  include "BLI_assert.h"
 #  include "BLI_delaunay_2d.h"
 #  include "BLI_double3.hh"
+#  include "BLI_enumerable_thread_specific.hh"
 #  include "BLI_float3.hh"
 #  include "BLI_hash.hh"
 #  include "BLI_kdopbvh.h"
+#  include "BLI_linear_allocator.hh"
 #  include "BLI_map.hh"
 #  include "BLI_math_boolean.hh"
 #  include "BLI_math_mpq.hh"
@@ -336,12 +338,18 @@ class IMeshArena::IMeshArenaImpl : NonCopyable, NonMovable {
   Set<VSetKey> vset_;
 
   /**
-   * Ownership of the Vert memory is here, so destroying this reclaims that memory.
-   *
-   * TODO: replace these with pooled allocation, and just destroy the pools at the end.
+   * Verts and Faces are allocated from the linear allocator of the thread that creates them, so
+   * that parallel intersection code does not contend on the global allocator. The memory is
+   * freed together when the arena is destroyed.
    */
-  Vector<std::unique_ptr<Vert>> allocated_verts_;
-  Vector<std::unique_ptr<Face>> allocated_faces_;
+  EnumerableThreadSpecific<LinearAllocator<>> allocators_;
+
+  /**
+   * Ownership of the Vert and Face instances is here, so destroying this destructs them. This
+   * has to be declared after the allocators, so that it is destroyed first.
+   */
+  Vector<destruct_ptr<Vert>> allocated_verts_;
+  Vector<destruct_ptr<Face>> allocated_faces_;
 
   /* Use these to allocate ids when Verts and Faces are allocated. */
   int next_vert_id_ = 0;
@@ -407,7 +415,8 @@ class IMeshArena::IMeshArenaImpl : NonCopyable, NonMovable {
 
   Face *add_face(Span<const Vert *> verts, int orig, Span<int> edge_origs, Span<bool> is_intersect)
   {
-    Face *f = new Face(verts, next_face_id_++, orig, edge_origs, is_intersect);
+    Face *f = allocators_.local().construct<Face>(
+        verts, next_face_id_++, orig, edge_origs, is_intersect);
     if (intersect_use_threading) {
 #  ifdef USE_SPINLOCK
       BLI_spin_lock(&lock_);
@@ -415,7 +424,7 @@ class IMeshArena::IMeshArenaImpl : NonCopyable, NonMovable {
       BLI_mutex_lock(mutex_);
 #  endif
     }
-    allocated_faces_.append(std::unique_ptr<Face>(f));
+    allocated_faces_.append(destruct_ptr<Face>(f));
     if (intersect_use_threading) {
 #  ifdef USE_SPINLOCK
       BLI_spin_unlock(&lock_);
@@ -498,9 +507,9 @@ class IMeshArena::IMeshArenaImpl : NonCopyable, NonMovable {
     }
     const VSetKey *lookup = vset_.lookup_key_ptr(vskey);
     if (!lookup) {
-      vskey.vert = new Vert(mco, dco, next_vert_id_++, orig);
+      vskey.vert = allocators_.local().construct<Vert>(mco, dco, next_vert_id_++, orig);
       vset_.add_new(vskey);
-      allocated_verts_.append(std::unique_ptr<Vert>(vskey.vert));
+      allocated_verts_.append(destruct_ptr<Vert>(vskey.vert));
       ans = vskey.vert;
     }
     else {
@@ -1231,6 +1240,49 @@ static int filter_plane_side(const double3 &p,
   return 0;
 }
 
+/**
+ * Index of `dot(d - a, cross(b - a, c - a))`, assuming the input coordinates have index 1.
+ * Differences have index 2, the cross product coordinates index 6 and the dot product 11.
+ */
+constexpr int index_orient3d = 11;
+
+/**
+ * Return the approximate sign of `dot(d - a, cross(b - a, c - a))`, or 0 if the sign cannot be
+ * determined with double arithmetic. This is the negated #orient3d of the points.
+ */
+static int filter_orient3d(const double3 &a, const double3 &b, const double3 &c, const double3 &d)
+{
+  const double3 ba = b - a;
+  const double3 ca = c - a;
+  const double det = double3::dot(d - a, double3::cross_high_precision(ba, ca));
+  if (det == 0.0) {
+    return 0;
+  }
+  const double3 abs_a = double3::abs(a);
+  const double3 abs_ba = double3::abs(b) + abs_a;
+  const double3 abs_ca = double3::abs(c) + abs_a;
+  const double3 abs_da = double3::abs(d) + abs_a;
+  double3 abs_cross;
+  abs_cross[0] = abs_ba[1] * abs_ca[2] + abs_ba[2] * abs_ca[1];
+  abs_cross[1] = abs_ba[2] * abs_ca[0] + abs_ba[0] * abs_ca[2];
+  abs_cross[2] = abs_ba[0] * abs_ca[1] + abs_ba[1] * abs_ca[0];
+  const double supremum = double3::dot(abs_da, abs_cross);
+  const double err_bound = supremum * index_orient3d * DBL_EPSILON;
+  if (fabs(det) > err_bound) {
+    return det > 0 ? 1 : -1;
+  }
+  return 0;
+}
+
+int orient3d(const Vert *a, const Vert *b, const Vert *c, const Vert *d)
+{
+  const int filter = filter_orient3d(a->co, b->co, c->co, d->co);
+  if (filter != 0) {
+    return -filter;
+  }
+  return orient3d(a->co_exact, b->co_exact, c->co_exact, d->co_exact);
+}
+
 /*
  * interesect_tri_tri and helper functions.
  * This code uses the algorithm of Guigue and Devillers, as described
@@ -1255,14 +1307,19 @@ static inline mpq3 tti_interp(const mpq3 &a, const mpq3 &b, const mpq3 &c, const
 }
 
 /**
- * Return +1, 0, -1 as a + ad is above, on, or below the oriented plane containing a, b, c in CCW
- * order. This is the same as -oriented(a, b, c, a + ad), but uses fewer arithmetic operations.
- * TODO: change arguments to `const Vert *` and use floating filters.
+ * Return +1, 0, -1 as d is above, on, or below the oriented plane containing a, b, c in CCW
+ * order. This is the same as -orient3d(a, b, c, d). Most cases are decided with double
+ * arithmetic, using a floating point filter.
  */
-static inline int tti_above(const mpq3 &a, const mpq3 &b, const mpq3 &c, const mpq3 &ad)
+static inline int tti_above(const Vert *a, const Vert *b, const Vert *c, const Vert *d)
 {
-  mpq3 n = mpq3::cross(b - a, c - a);
-  return sgn(mpq3::dot(ad, n));
+  const int filter = filter_orient3d(a->co, b->co, c->co, d->co);
+  if (filter != 0) {
+    return filter;
+  }
+  const mpq3 &a_exact = a->co_exact;
+  mpq3 n = mpq3::cross(b->co_exact - a_exact, c->co_exact - a_exact);
+  return sgn(mpq3::dot(d->co_exact - a_exact, n));
 }
 
 /**
@@ -1278,12 +1335,12 @@ static inline int tti_above(const mpq3 &a, const mpq3 &b, const mpq3 &c, const m
  *   of the plane and at least one of q1 and r1 are off the plane.
  * Similarly for p2, q2, r2 with respect to the first triangle's plane.
  */
-static ITT_value itt_canon2(const mpq3 &p1,
-                            const mpq3 &q1,
-                            const mpq3 &r1,
-                            const mpq3 &p2,
-                            const mpq3 &q2,
-                            const mpq3 &r2,
+static ITT_value itt_canon2(const Vert *p1,
+                            const Vert *q1,
+                            const Vert *r1,
+                            const Vert *p2,
+                            const Vert *q2,
+                            const Vert *r2,
                             const mpq3 &n1,
                             const mpq3 &n2)
 {
@@ -1293,33 +1350,25 @@ static ITT_value itt_canon2(const mpq3 &p1,
     std::cout << "p1=" << p1 << " q1=" << q1 << " r1=" << r1 << "\n";
     std::cout << "p2=" << p2 << " q2=" << q2 << " r2=" << r2 << "\n";
     std::cout << "n1=" << n1 << " n2=" << n2 << "\n";
-    std::cout << "approximate values:\n";
-    std::cout << "p1=(" << p1[0].get_d() << "," << p1[1].get_d() << "," << p1[2].get_d() << ")\n";
-    std::cout << "q1=(" << q1[0].get_d() << "," << q1[1].get_d() << "," << q1[2].get_d() << ")\n";
-    std::cout << "r1=(" << r1[0].get_d() << "," << r1[1].get_d() << "," << r1[2].get_d() << ")\n";
-    std::cout << "p2=(" << p2[0].get_d() << "," << p2[1].get_d() << "," << p2[2].get_d() << ")\n";
-    std::cout << "q2=(" << q2[0].get_d() << "," << q2[1].get_d() << "," << q2[2].get_d() << ")\n";
-    std::cout << "r2=(" << r2[0].get_d() << "," << r2[1].get_d() << "," << r2[2].get_d() << ")\n";
     std::cout << "n1=(" << n1[0].get_d() << "," << n1[1].get_d() << "," << n1[2].get_d() << ")\n";
     std::cout << "n2=(" << n2[0].get_d() << "," << n2[1].get_d() << "," << n2[2].get_d() << ")\n";
   }
-  mpq3 p1p2 = p2 - p1;
   mpq3 intersect_1;
   mpq3 intersect_2;
   bool no_overlap = false;
   /* Top test in classification tree. */
-  if (tti_above(p1, q1, r2, p1p2) > 0) {
+  if (tti_above(p1, q1, r2, p2) > 0) {
     /* Middle right test in classification tree. */
-    if (tti_above(p1, r1, r2, p1p2) <= 0) {
+    if (tti_above(p1, r1, r2, p2) <= 0) {
       /* Bottom right test in classification tree. */
-      if (tti_above(p1, r1, q2, p1p2) > 0) {
+      if (tti_above(p1, r1, q2, p2) > 0) {
         /* Overlap is [k [i l] j]. */
         if (dbg_level > 0) {
           std::cout << "overlap [k [i l] j]\n";
         }
         /* i is intersect with p1r1. l is intersect with p2r2. */
-        intersect_1 = tti_interp(p1, r1, p2, n2);
-        intersect_2 = tti_interp(p2, r2, p1, n1);
+        intersect_1 = tti_interp(p1->co_exact, r1->co_exact, p2->co_exact, n2);
+        intersect_2 = tti_interp(p2->co_exact, r2->co_exact, p1->co_exact, n1);
       }
       else {
         /* Overlap is [i [k l] j]. */
@@ -1327,8 +1376,8 @@ static ITT_value itt_canon2(const mpq3 &p1,
           std::cout << "overlap [i [k l] j]\n";
         }
         /* k is intersect with p2q2. l is intersect is p2r2. */
-        intersect_1 = tti_interp(p2, q2, p1, n1);
-        intersect_2 = tti_interp(p2, r2, p1, n1);
+        intersect_1 = tti_interp(p2->co_exact, q2->co_exact, p1->co_exact, n1);
+        intersect_2 = tti_interp(p2->co_exact, r2->co_exact, p1->co_exact, n1);
       }
     }
     else {
@@ -1341,7 +1390,7 @@ static ITT_value itt_canon2(const mpq3 &p1,
   }
   else {
     /* Middle left test in classification tree. */
-    if (tti_above(p1, q1, q2, p1p2) < 0) {
+    if (tti_above(p1, q1, q2, p2) < 0) {
       /* No overlap: [i j] [k l]. */
       if (dbg_level > 0) {
         std::cout << "no overlap: [i j] [k l]\n";
@@ -1350,14 +1399,14 @@ static ITT_value itt_canon2(const mpq3 &p1,
     }
     else {
       /* Bottom left test in classification tree. */
-      if (tti_above(p1, r1, q2, p1p2) >= 0) {
+      if (tti_above(p1, r1, q2, p2) >= 0) {
         /* Overlap is [k [i j] l]. */
         if (dbg_level > 0) {
           std::cout << "overlap [k [i j] l]\n";
         }
         /* i is intersect with p1r1. j is intersect with p1q1. */
-        intersect_1 = tti_interp(p1, r1, p2, n2);
-        intersect_2 = tti_interp(p1, q1, p2, n2);
+        intersect_1 = tti_interp(p1->co_exact, r1->co_exact, p2->co_exact, n2);
+        intersect_2 = tti_interp(p1->co_exact, q1->co_exact, p2->co_exact, n2);
       }
       else {
         /* Overlap is [i [k j] l]. */
@@ -1365,8 +1414,8 @@ static ITT_value itt_canon2(const mpq3 &p1,
           std::cout << "overlap [i [k j] l]\n";
         }
         /* k is intersect with p2q2. j is intersect with p1q1. */
-        intersect_1 = tti_interp(p2, q2, p1, n1);
-        intersect_2 = tti_interp(p1, q1, p2, n2);
+        intersect_1 = tti_interp(p2->co_exact, q2->co_exact, p1->co_exact, n1);
+        intersect_2 = tti_interp(p1->co_exact, q1->co_exact, p2->co_exact, n2);
       }
     }
   }
@@ -1387,12 +1436,12 @@ static ITT_value itt_canon2(const mpq3 &p1,
 
 /* Helper function for intersect_tri_tri. Args have been canonicalized for triangle 1. */
 
-static ITT_value itt_canon1(const mpq3 &p1,
-                            const mpq3 &q1,
-                            const mpq3 &r1,
-                            const mpq3 &p2,
-                            const mpq3 &q2,
-                            const mpq3 &r2,
+static ITT_value itt_canon1(const Vert *p1,
+                            const Vert *q1,
+                            const Vert *r1,
+                            const Vert *p2,
+                            const Vert *q2,
+                            const Vert *r2,
                             const mpq3 &n1,
                             const mpq3 &n2,
                             int sp2,
@@ -1581,49 +1630,49 @@ static ITT_value intersect_tri_tri(const IMesh &tm, int t1, int t2)
   ITT_value ans;
   if (sp1 > 0) {
     if (sq1 > 0) {
-      ans = itt_canon1(r1, p1, q1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+      ans = itt_canon1(vr1, vp1, vq1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
     }
     else if (sr1 > 0) {
-      ans = itt_canon1(q1, r1, p1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+      ans = itt_canon1(vq1, vr1, vp1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
     }
     else {
-      ans = itt_canon1(p1, q1, r1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+      ans = itt_canon1(vp1, vq1, vr1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
     }
   }
   else if (sp1 < 0) {
     if (sq1 < 0) {
-      ans = itt_canon1(r1, p1, q1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+      ans = itt_canon1(vr1, vp1, vq1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
     }
     else if (sr1 < 0) {
-      ans = itt_canon1(q1, r1, p1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+      ans = itt_canon1(vq1, vr1, vp1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
     }
     else {
-      ans = itt_canon1(p1, q1, r1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+      ans = itt_canon1(vp1, vq1, vr1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
     }
   }
   else {
     if (sq1 < 0) {
       if (sr1 >= 0) {
-        ans = itt_canon1(q1, r1, p1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+        ans = itt_canon1(vq1, vr1, vp1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
       }
       else {
-        ans = itt_canon1(p1, q1, r1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+        ans = itt_canon1(vp1, vq1, vr1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
       }
     }
     else if (sq1 > 0) {
       if (sr1 > 0) {
-        ans = itt_canon1(p1, q1, r1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+        ans = itt_canon1(vp1, vq1, vr1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
       }
       else {
-        ans = itt_canon1(q1, r1, p1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+        ans = itt_canon1(vq1, vr1, vp1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
       }
     }
     else {
       if (sr1 > 0) {
-        ans = itt_canon1(r1, p1, q1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+        ans = itt_canon1(vr1, vp1, vq1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
       }
       else if (sr1 < 0) {
-        ans = itt_canon1(r1, p1, q1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+        ans = itt_canon1(vr1, vp1, vq1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
       }
       else {
         if (dbg_level > 0) {
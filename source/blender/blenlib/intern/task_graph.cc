@@ -22,8 +22,11 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_fileops.h"
 #include "BLI_task.h"
 
+#include "PIL_time.h"
+
 #include <memory>
 #include <vector>
 
@@ -40,6 +43,8 @@ struct TaskGraph {
   tbb::flow::graph tbb_graph;
 #endif
   std::vector<std::unique_ptr<TaskNode>> nodes;
+  /* Record when and on which thread nodes run, see #BLI_task_graph_trace_write. */
+  bool use_profiling = false;
 
 #ifdef WITH_CXX_GUARDEDALLOC
   MEM_CXX_CLASS_ALLOC_FUNCS("task_graph:TaskGraph")
@@ -62,6 +67,13 @@ struct TaskNode {
    * is shared between nodes, only a single task node should free the data. */
   TaskGraphNodeFreeFunction free_func;
 
+  /* Profiling data of the last run, only recorded when profiling is enabled on the graph. */
+  const TaskGraph *task_graph;
+  const char *name = "TaskNode";
+  double start_time = 0.0;
+  double end_time = 0.0;
+  int thread_id = -1;
+
   TaskNode(TaskGraph *task_graph,
            TaskGraphNodeRunFunction run_func,
            void *task_data,
@@ -74,11 +86,9 @@ struct TaskNode {
 #endif
         run_func(run_func),
         task_data(task_data),
-        free_func(free_func)
+        free_func(free_func),
+        task_graph(task_graph)
   {
-#ifndef WITH_TBB
-    UNUSED_VARS(task_graph);
-#endif
   }
 
   TaskNode(const TaskNode &other) = delete;
@@ -94,14 +104,30 @@ struct TaskNode {
 #ifdef WITH_TBB
   tbb::flow::continue_msg run(const tbb::flow::continue_msg UNUSED(input))
   {
-    tbb::this_task_arena::isolate([this] { run_func(task_data); });
+    tbb::this_task_arena::isolate([this] { run_profiled(); });
     return tbb::flow::continue_msg();
   }
 #endif
 
-  void run_serial()
+  void run_profiled()
   {
+    if (!task_graph->use_profiling) {
+      run_func(task_data);
+      return;
+    }
+    start_time = PIL_check_seconds_timer();
     run_func(task_data);
+    end_time = PIL_check_seconds_timer();
+#ifdef WITH_TBB
+    thread_id = tbb::this_task_arena::current_thread_index();
+#else
+    thread_id = 0;
+#endif
+  }
+
+  void run_serial()
+  {
+    run_profiled();
     for (TaskNode *successor : successors) {
       successor->run_serial();
     }
@@ -164,3 +190,45 @@ void BLI_task_graph_edge_create(struct TaskNode *from_node, struct TaskNode *to_
 
   from_node->successors.push_back(to_node);
 }
+
+void BLI_task_graph_node_set_name(struct TaskNode *task_node, const char *name)
+{
+  task_node->name = name;
+}
+
+void BLI_task_graph_use_profiling(struct TaskGraph *task_graph, bool use_profiling)
+{
+  task_graph->use_profiling = use_profiling;
+}
+
+/**
+ * Write the nodes which ran since profiling was enabled as complete events in the Chrome trace
+ * event format. Times are in microseconds.
+ */
+bool BLI_task_graph_trace_write(const struct TaskGraph *task_graph, const char *filepath)
+{
+  FILE *fp = BLI_fopen(filepath, "w");
+  if (fp == nullptr) {
+    return false;
+  }
+
+  fprintf(fp, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+  bool is_first = true;
+  for (const std::unique_ptr<TaskNode> &task_node : task_graph->nodes) {
+    if (task_node->thread_id == -1) {
+      continue;
+    }
+    fprintf(fp,
+            "%s{\"name\": \"%s\", \"cat\": \"task_graph\", \"ph\": \"X\", \"ts\": %.3f, "
+            "\"dur\": %.3f, \"pid\": 0, \"tid\": %d}",
+            is_first ? "" : ",\n",
+            task_node->name,
+            task_node->start_time * 1e6,
+            (task_node->end_time - task_node->start_time) * 1e6,
+            task_node->thread_id);
+    is_first = false;
+  }
+  fprintf(fp, "\n]}\n");
+  fclose(fp);
+  return true;
+}
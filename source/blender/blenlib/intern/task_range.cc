@@ -27,6 +27,7 @@
 #include "DNA_listBase.h"
 
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 
 #include "atomic_ops.h"
@@ -144,6 +145,11 @@ void BLI_task_parallel_range(const int start,
   }
 }
 
+int BLI_task_parallel_prefix_sum_i(int *data, const int len)
+{
+  return blender::parallel_prefix_sum(blender::MutableSpan<int>(data, len));
+}
+
 int BLI_task_parallel_thread_id(const TaskParallelTLS *UNUSED(tls))
 {
 #ifdef WITH_TBB
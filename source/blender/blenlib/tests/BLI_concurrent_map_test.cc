@@ -0,0 +1,109 @@
+/* Apache License, Version 2.0 */
+
+#include "BLI_concurrent_map.hh"
+#include "BLI_strict_flags.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+#include "testing/testing.h"
+#include <string>
+
+namespace blender::tests {
+
+TEST(concurrent_map, Constructor)
+{
+  ConcurrentMap<int, float> map(10);
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_TRUE(map.is_empty());
+  EXPECT_EQ(map.capacity(), 10);
+  EXPECT_GE(map.size_in_slots(), 20);
+}
+
+TEST(concurrent_map, AddAndLookup)
+{
+  ConcurrentMap<int, float> map(10);
+  EXPECT_TRUE(map.add(2, 5.0f));
+  EXPECT_TRUE(map.add(6, 2.0f));
+  EXPECT_FALSE(map.add(2, 3.0f));
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(map.lookup(2), 5.0f);
+  EXPECT_EQ(map.lookup(6), 2.0f);
+  EXPECT_EQ(map.lookup_ptr(4), nullptr);
+  EXPECT_TRUE(map.contains(6));
+  EXPECT_FALSE(map.contains(3));
+}
+
+TEST(concurrent_map, LookupOrAdd)
+{
+  ConcurrentMap<int, int> map(10);
+  int &value = map.lookup_or_add(3, 10);
+  EXPECT_EQ(value, 10);
+  value++;
+  EXPECT_EQ(map.lookup_or_add(3, 20), 11);
+  EXPECT_EQ(map.lookup_or_add_cb(4, []() { return 30; }), 30);
+  EXPECT_EQ(map.size(), 2);
+}
+
+TEST(concurrent_map, StringKeys)
+{
+  ConcurrentMap<std::string, int> map(10);
+  map.add("hello", 1);
+  map.add("world", 2);
+  EXPECT_EQ(map.lookup("hello"), 1);
+  EXPECT_EQ(map.lookup_as(StringRef("world")), 2);
+  EXPECT_FALSE(map.contains_as(StringRef("test")));
+}
+
+TEST(concurrent_map, ForeachItem)
+{
+  ConcurrentMap<int, int> map(100);
+  for (int i = 0; i < 100; i++) {
+    map.add(i, i * 2);
+  }
+  int64_t key_sum = 0;
+  int64_t value_sum = 0;
+  map.foreach_item([&](const int key, const int value) {
+    key_sum += key;
+    value_sum += value;
+  });
+  EXPECT_EQ(key_sum, 4950);
+  EXPECT_EQ(value_sum, 9900);
+}
+
+TEST(concurrent_map, ParallelDeduplicate)
+{
+  const int amount = 100000;
+  const int unique_amount = 1000;
+  ConcurrentMap<int, int> map(unique_amount);
+  Vector<int> indices(amount);
+  parallel_for(IndexRange(amount), 256, [&](IndexRange range) {
+    for (const int i : range) {
+      indices[i] = map.lookup_or_add(i % unique_amount, i);
+    }
+  });
+  EXPECT_EQ(map.size(), unique_amount);
+  for (const int i : IndexRange(amount)) {
+    /* All threads have to agree on the value that was added first for a key. */
+    EXPECT_EQ(indices[i], map.lookup(i % unique_amount));
+    EXPECT_EQ(indices[i] % unique_amount, i % unique_amount);
+  }
+}
+
+TEST(concurrent_map, ParallelStringKeys)
+{
+  const int amount = 10000;
+  const int unique_amount = 100;
+  ConcurrentMap<std::string, std::string> map(unique_amount);
+  parallel_for(IndexRange(amount), 64, [&](IndexRange range) {
+    for (const int i : range) {
+      const std::string key = std::to_string(i % unique_amount);
+      map.lookup_or_add_cb(key, [&]() { return "value " + key; });
+    }
+  });
+  EXPECT_EQ(map.size(), unique_amount);
+  for (const int i : IndexRange(unique_amount)) {
+    const std::string key = std::to_string(i);
+    EXPECT_EQ(map.lookup(key), "value " + key);
+  }
+}
+
+}  // namespace blender::tests
@@ -0,0 +1,48 @@
+/* Apache License, Version 2.0 */
+
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_linear_allocator.hh"
+#include "BLI_strict_flags.h"
+#include "testing/testing.h"
+
+namespace blender::tests {
+
+TEST(enumerable_thread_specific, Local)
+{
+  EnumerableThreadSpecific<int> values;
+  values.local() = 5;
+  EXPECT_EQ(values.local(), 5);
+}
+
+TEST(enumerable_thread_specific, ParallelSum)
+{
+  EnumerableThreadSpecific<int64_t> sums;
+  parallel_for(IndexRange(10000), 100, [&](IndexRange range) {
+    int64_t &sum = sums.local();
+    for (const int64_t i : range) {
+      sum += i;
+    }
+  });
+  int64_t total = 0;
+  for (const int64_t sum : sums) {
+    total += sum;
+  }
+  EXPECT_EQ(total, 49995000);
+}
+
+TEST(enumerable_thread_specific, LinearAllocatorPerThread)
+{
+  EnumerableThreadSpecific<LinearAllocator<>> allocators;
+  Array<int *> pointers(10000);
+  parallel_for(pointers.index_range(), 100, [&](IndexRange range) {
+    LinearAllocator<> &allocator = allocators.local();
+    for (const int64_t i : range) {
+      pointers[i] = allocator.construct<int>(static_cast<int>(i));
+    }
+  });
+  for (const int64_t i : pointers.index_range()) {
+    EXPECT_EQ(*pointers[i], i);
+  }
+}
+
+}  // namespace blender::tests
@@ -111,6 +111,8 @@ TEST_PARSE_FAIL(Truncated7, "1 and")
 TEST_PARSE_FAIL(Truncated8, "1 or")
 TEST_PARSE_FAIL(Truncated9, "sqrt(1")
 TEST_PARSE_FAIL(Truncated10, "fmod(1,")
+TEST_PARSE_FAIL(Truncated11, "2 **")
+TEST_PARSE_FAIL(Truncated12, "2 %")
 
 /* Constant expression with working constant folding */
 #define TEST_CONST(name, str, value) \
@@ -143,6 +145,8 @@ TEST_CONST(TenE, "1.e+1", 10.0)
 TEST_CONST(Half, ".5", 0.5)
 
 TEST_CONST(Pi, "pi", M_PI)
+TEST_CONST(E, "e", M_E)
+TEST_CONST(Tau, "tau", M_PI * 2.0)
 TEST_CONST(True, "True", TRUE_VAL)
 TEST_CONST(False, "False", FALSE_VAL)
 
@@ -156,6 +160,13 @@ TEST_CONST(Pow, "pow(4, 0.5)", 2.0)
 TEST_EVAL(Pow, "pow(4, x)", 0.5, 2.0)
 
 TEST_CONST(Log2_1, "log(4, 2)", 2.0)
+TEST_CONST(Log2_2, "log2(8)", 3.0)
+TEST_CONST(Log10, "log10(100)", 2.0)
+
+TEST_CONST(Hypot, "hypot(3, 4)", 5.0)
+TEST_EVAL(Hypot, "hypot(x, 4)", 3.0, 5.0)
+
+TEST_CONST(CopySign, "copysign(2, -1)", -2.0)
 
 TEST_CONST(Round1, "round(-0.5)", -1.0)
 TEST_CONST(Round2, "round(-0.4)", 0.0)
@@ -205,6 +216,18 @@ TEST_EVAL(BinaryMul, "x*3", 2, 6.0)
 TEST_CONST(BinaryDiv, "3/2", 1.5)
 TEST_EVAL(BinaryDiv, "3/x", 2, 1.5)
 
+TEST_CONST(BinaryMod1, "7 % 3", 1.0)
+TEST_CONST(BinaryMod2, "-7 % 3", 2.0)
+TEST_CONST(BinaryMod3, "7 % -3", -2.0)
+TEST_EVAL(BinaryMod, "x % 3", -1, 2.0)
+
+TEST_CONST(BinaryPow1, "2**3", 8.0)
+TEST_CONST(BinaryPow2, "-2**2", -4.0)
+TEST_CONST(BinaryPow3, "2**-1", 0.5)
+TEST_CONST(BinaryPow4, "2**3**2", 512.0)
+TEST_CONST(BinaryPow5, "2 * 3**2", 18.0)
+TEST_EVAL(BinaryPow, "x**2", 3, 9.0)
+
 TEST_CONST(Arith1, "1 + -2 * 3", -5.0)
 TEST_CONST(Arith2, "(1 + -2) * 3", -3.0)
 TEST_CONST(Arith3, "-1 + 2 * 3", 5.0)
@@ -338,6 +361,9 @@ TEST_ERROR(PowDomain1, "pow(-1, 0.5)", 0.0, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(PowDomain2, "pow(-1, x)", 0.5, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(PowDomain3, "pow(-1, x)", 2.0, EXPR_PYLIKE_SUCCESS)
 
+TEST_ERROR(ModZero1, "1 % x", 0.0, EXPR_PYLIKE_MATH_ERROR)
+TEST_ERROR(ModZero2, "1 % x", 2.0, EXPR_PYLIKE_SUCCESS)
+
 TEST_ERROR(Mixed1, "sqrt(x) + 1 / max(0, x)", -1.0, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(Mixed2, "sqrt(x) + 1 / max(0, x)", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
 TEST_ERROR(Mixed3, "sqrt(x) + 1 / max(0, x)", 1.0, EXPR_PYLIKE_SUCCESS)
@@ -0,0 +1,162 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <cfloat>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_kdtree.h"
+#include "BLI_math_vector.h"
+#include "BLI_rand.h"
+
+/* -------------------------------------------------------------------- */
+/* Helper Functions */
+
+static KDTree_3d *kdtree_random_points(float (*points)[3], int points_len, struct RNG *rng)
+{
+  KDTree_3d *tree = BLI_kdtree_3d_new(points_len);
+  for (int i = 0; i < points_len; i++) {
+    BLI_rng_get_float_unit_v3(rng, points[i]);
+    mul_v3_fl(points[i], BLI_rng_get_float(rng));
+    BLI_kdtree_3d_insert(tree, i, points[i]);
+  }
+  BLI_kdtree_3d_balance(tree);
+  return tree;
+}
+
+static int find_nearest_brute_force(const float (*points)[3], int points_len, const float co[3])
+{
+  int nearest = -1;
+  float nearest_dist_sq = FLT_MAX;
+  for (int i = 0; i < points_len; i++) {
+    const float dist_sq = len_squared_v3v3(points[i], co);
+    if (dist_sq < nearest_dist_sq) {
+      nearest_dist_sq = dist_sq;
+      nearest = i;
+    }
+  }
+  return nearest;
+}
+
+/* -------------------------------------------------------------------- */
+/* Tests */
+
+static void find_nearest_test(int points_len)
+{
+  struct RNG *rng = BLI_rng_new(points_len);
+  float(*points)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * points_len, __func__);
+  KDTree_3d *tree = kdtree_random_points(points, points_len, rng);
+
+  for (int i = 0; i < 100; i++) {
+    float co[3];
+    BLI_rng_get_float_unit_v3(rng, co);
+    EXPECT_EQ(BLI_kdtree_3d_find_nearest(tree, co, nullptr),
+              find_nearest_brute_force(points, points_len, co));
+  }
+
+  BLI_kdtree_3d_free(tree);
+  MEM_freeN(points);
+  BLI_rng_free(rng);
+}
+
+TEST(kdtree, FindNearest_1)
+{
+  find_nearest_test(1);
+}
+TEST(kdtree, FindNearest_1000)
+{
+  find_nearest_test(1000);
+}
+/* Large enough to be balanced in multiple tasks. */
+TEST(kdtree, FindNearest_100000)
+{
+  find_nearest_test(100000);
+}
+
+TEST(kdtree, FindNearestNMulti)
+{
+  const int points_len = 20000;
+  const int queries_len = 1000;
+  const int nearest_len_capacity = 4;
+
+  struct RNG *rng = BLI_rng_new(0);
+  float(*points)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * points_len, __func__);
+  KDTree_3d *tree = kdtree_random_points(points, points_len, rng);
+
+  float(*queries)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * queries_len, __func__);
+  for (int i = 0; i < queries_len; i++) {
+    BLI_rng_get_float_unit_v3(rng, queries[i]);
+  }
+
+  KDTreeNearest_3d *nearest = (KDTreeNearest_3d *)MEM_mallocN(
+      sizeof(KDTreeNearest_3d) * queries_len * nearest_len_capacity, __func__);
+  int *nearest_len = (int *)MEM_mallocN(sizeof(int) * queries_len, __func__);
+  BLI_kdtree_3d_find_nearest_n_multi(
+      tree, queries, queries_len, nearest, nearest_len_capacity, nearest_len);
+
+  for (int i = 0; i < queries_len; i++) {
+    KDTreeNearest_3d expect[nearest_len_capacity];
+    const int expect_len = BLI_kdtree_3d_find_nearest_n(
+        tree, queries[i], expect, nearest_len_capacity);
+    EXPECT_EQ(nearest_len[i], expect_len);
+    for (int j = 0; j < expect_len; j++) {
+      EXPECT_EQ(nearest[i * nearest_len_capacity + j].index, expect[j].index);
+      EXPECT_EQ(nearest[i * nearest_len_capacity + j].dist, expect[j].dist);
+    }
+  }
+
+  MEM_freeN(nearest);
+  MEM_freeN(nearest_len);
+  MEM_freeN(queries);
+  BLI_kdtree_3d_free(tree);
+  MEM_freeN(points);
+  BLI_rng_free(rng);
+}
+
+/* Large enough to search for duplicates in parallel. */
+TEST(kdtree, CalcDuplicatesFast)
+{
+  const int points_len = 12000;
+  const float range = 0.02f;
+
+  struct RNG *rng = BLI_rng_new(0);
+  float(*points)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * points_len, __func__);
+  KDTree_3d *tree = kdtree_random_points(points, points_len, rng);
+
+  int *duplicates = (int *)MEM_mallocN(sizeof(int) * points_len, __func__);
+  copy_vn_i(duplicates, points_len, -1);
+  const int found = BLI_kdtree_3d_calc_duplicates_fast(tree, range, true, duplicates);
+
+  int *expect = (int *)MEM_mallocN(sizeof(int) * points_len, __func__);
+  copy_vn_i(expect, points_len, -1);
+  int expect_found = 0;
+  for (int i = 0; i < points_len; i++) {
+    if (!ELEM(expect[i], -1, i)) {
+      continue;
+    }
+    const int expect_found_prev = expect_found;
+    for (int j = 0; j < points_len; j++) {
+      if (j != i && expect[j] == -1 &&
+          len_squared_v3v3(points[i], points[j]) <= range * range) {
+        expect[j] = i;
+        expect_found++;
+      }
+    }
+    if (expect_found != expect_found_prev) {
+      expect[i] = i;
+    }
+  }
+
+  EXPECT_GT(found, 0);
+  EXPECT_EQ(found, expect_found);
+  for (int i = 0; i < points_len; i++) {
+    EXPECT_EQ(duplicates[i], expect[i]);
+  }
+
+  MEM_freeN(expect);
+  MEM_freeN(duplicates);
+  BLI_kdtree_3d_free(tree);
+  MEM_freeN(points);
+  BLI_rng_free(rng);
+}
@@ -131,3 +131,39 @@ TEST(math_base, FloorPowerOf10)
   EXPECT_NEAR(floor_power_of_10(100.1f), 100.0f, 1e-4f);
   EXPECT_NEAR(floor_power_of_10(99.9f), 10.0f, 1e-4f);
 }
+
+TEST(math_base, HalfToFloat)
+{
+  EXPECT_EQ(half_to_float(0x0000), 0.0f);
+  EXPECT_EQ(half_to_float(0x3c00), 1.0f);
+  EXPECT_EQ(half_to_float(0xc000), -2.0f);
+  EXPECT_EQ(half_to_float(0x7bff), 65504.0f);
+  EXPECT_EQ(half_to_float(0x0001), powf(2.0f, -24.0f));
+  EXPECT_EQ(half_to_float(0x7c00), INFINITY);
+  EXPECT_TRUE(isnan(half_to_float(0x7e00)));
+}
+
+TEST(math_base, FloatToHalf)
+{
+  EXPECT_EQ(float_to_half(0.0f), 0x0000);
+  EXPECT_EQ(float_to_half(-0.0f), 0x8000);
+  EXPECT_EQ(float_to_half(1.0f), 0x3c00);
+  EXPECT_EQ(float_to_half(-2.0f), 0xc000);
+  EXPECT_EQ(float_to_half(65504.0f), 0x7bff);
+  EXPECT_EQ(float_to_half(1e6f), 0x7c00);
+  EXPECT_EQ(float_to_half(INFINITY), 0x7c00);
+  EXPECT_EQ(float_to_half(NAN) & 0x7e00, 0x7e00);
+  EXPECT_EQ(float_to_half(powf(2.0f, -24.0f)), 0x0001);
+  /* Ties round to even. */
+  EXPECT_EQ(float_to_half(1.0f + powf(2.0f, -11.0f)), 0x3c00);
+  EXPECT_EQ(float_to_half(1.0f + 3.0f * powf(2.0f, -11.0f)), 0x3c02);
+}
+
+TEST(math_base, HalfRoundTrip)
+{
+  for (int i = 0; i < 0x7c00; i++) {
+    const unsigned short h = (unsigned short)i;
+    EXPECT_EQ(float_to_half(half_to_float(h)), h);
+    EXPECT_EQ(float_to_half(-half_to_float(h)), h | 0x8000);
+  }
+}
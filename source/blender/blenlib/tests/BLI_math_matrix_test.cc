@@ -3,6 +3,8 @@
 #include "testing/testing.h"
 
 #include "BLI_math_matrix.h"
+#include "BLI_math_rotation.h"
+#include "BLI_math_vector.h"
 
 TEST(math_matrix, interp_m4_m4m4_regular)
 {
@@ -97,3 +99,41 @@ TEST(math_matrix, interp_m3_m3m3_singularity)
   EXPECT_NEAR(0.0f, determinant_m3_array(result), 1e-5);
   EXPECT_M3_NEAR(result, expect, 1e-5);
 }
+
+TEST(math_matrix, mul_v3_m4v3_array)
+{
+  float matrix[4][4];
+  const float rotation[3] = {0.3f, 1.2f, -0.7f};
+  eul_to_mat4(matrix, rotation);
+  mul_v3_fl(matrix[0], 1.5f);
+  copy_v3_fl3(matrix[3], 0.1f, -2.0f, 3.5f);
+
+  const float positions[5][3] = {
+      {0.0f, 0.0f, 0.0f},
+      {1.0f, 2.0f, 3.0f},
+      {-4.0f, 0.5f, 0.25f},
+      {100.0f, -30.0f, 7.0f},
+      {0.1f, 0.2f, -0.3f},
+  };
+
+  float result[5][3];
+  mul_v3_m4v3_array(result, matrix, positions, 5);
+  for (int i = 0; i < 5; i++) {
+    float expect[3];
+    mul_v3_m4v3(expect, matrix, positions[i]);
+    EXPECT_EQ(result[i][0], expect[0]);
+    EXPECT_EQ(result[i][1], expect[1]);
+    EXPECT_EQ(result[i][2], expect[2]);
+  }
+
+  /* Transforming in place gives the same result. */
+  memcpy(result, positions, sizeof(positions));
+  mul_m4_v3_array(matrix, result, 5);
+  for (int i = 0; i < 5; i++) {
+    float expect[3];
+    mul_v3_m4v3(expect, matrix, positions[i]);
+    EXPECT_EQ(result[i][0], expect[0]);
+    EXPECT_EQ(result[i][1], expect[1]);
+    EXPECT_EQ(result[i][2], expect[2]);
+  }
+}
@@ -45,3 +45,57 @@ TEST(math_vector, ClampVecWithVecs)
   EXPECT_FLOAT_EQ(1.0f, c[0]);
   EXPECT_FLOAT_EQ(3.0f, c[1]);
 }
+
+TEST(math_vector, NormalizeArray)
+{
+  /* Use a length that is not a multiple of four, to also test the remainder. */
+  float vectors[7][3] = {
+      {1.0f, 2.0f, 3.0f},
+      {0.0f, 0.0f, 0.0f},
+      {-4.0f, 0.5f, 0.0f},
+      {0.0f, 0.0f, 1e-20f},
+      {10.0f, -3.0f, 7.0f},
+      {0.1f, 0.2f, -0.3f},
+      {-1.0f, -1.0f, -1.0f},
+  };
+  float expect[7][3];
+  memcpy(expect, vectors, sizeof(vectors));
+  for (int i = 0; i < 7; i++) {
+    normalize_v3(expect[i]);
+  }
+
+  normalize_v3_array(vectors, 7);
+  for (int i = 0; i < 7; i++) {
+    EXPECT_EQ(vectors[i][0], expect[i][0]);
+    EXPECT_EQ(vectors[i][1], expect[i][1]);
+    EXPECT_EQ(vectors[i][2], expect[i][2]);
+  }
+}
+
+TEST(math_vector, CrossArray)
+{
+  const float a[5][3] = {
+      {1.0f, 0.0f, 0.0f},
+      {0.0f, 1.0f, 0.0f},
+      {1.0f, 2.0f, 3.0f},
+      {-2.0f, 0.5f, 4.0f},
+      {3.0f, -1.0f, 2.0f},
+  };
+  const float b[5][3] = {
+      {0.0f, 1.0f, 0.0f},
+      {0.0f, 0.0f, 1.0f},
+      {4.0f, 5.0f, 6.0f},
+      {1.0f, 1.0f, 1.0f},
+      {-0.5f, 2.0f, 0.25f},
+  };
+
+  float result[5][3];
+  cross_v3_v3v3_array(result, a, b, 5);
+  for (int i = 0; i < 5; i++) {
+    float expect[3];
+    cross_v3_v3v3(expect, a[i], b[i]);
+    EXPECT_EQ(result[i][0], expect[0]);
+    EXPECT_EQ(result[i][1], expect[1]);
+    EXPECT_EQ(result[i][2], expect[2]);
+  }
+}
@@ -169,4 +169,9 @@ static_assert(is_span_convertible_pointer_v<int *, const void *>);
 static_assert(!is_span_convertible_pointer_v<TestBaseClass *, TestChildClass *>);
 static_assert(!is_span_convertible_pointer_v<TestChildClass *, TestBaseClass *>);
 
+static_assert(is_trivially_relocatable_v<int>);
+static_assert(is_trivially_relocatable_v<float3>);
+static_assert(is_trivially_relocatable_v<int *>);
+static_assert(!is_trivially_relocatable_v<std::string>);
+
 }  // namespace blender::tests
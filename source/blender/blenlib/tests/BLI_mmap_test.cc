@@ -0,0 +1,107 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_fileops.h"
+#include "BLI_mmap.hh"
+#include "BLI_vector.hh"
+
+namespace blender::tests {
+
+static std::string write_test_file(const char *name, Span<int> values)
+{
+  const std::string filepath = ::testing::TempDir() + name;
+  FILE *file = BLI_fopen(filepath.c_str(), "wb");
+  EXPECT_NE(file, nullptr);
+  fwrite(values.data(), sizeof(int), static_cast<size_t>(values.size()), file);
+  fclose(file);
+  return filepath;
+}
+
+TEST(mapped_array, DefaultConstructor)
+{
+  MappedArray<int> array;
+  EXPECT_FALSE(array.is_valid());
+  EXPECT_TRUE(array.is_empty());
+  EXPECT_EQ(array.size(), 0);
+  EXPECT_FALSE(array.has_io_error());
+}
+
+TEST(mapped_array, MissingFile)
+{
+  const std::string filepath = ::testing::TempDir() + "blender_mapped_array_missing.bin";
+  MappedArray<int> array(filepath.c_str());
+  EXPECT_FALSE(array.is_valid());
+  EXPECT_TRUE(array.is_empty());
+}
+
+TEST(mapped_array, WholeFile)
+{
+  Vector<int> values;
+  for (int i = 0; i < 10000; i++) {
+    values.append(i * 3);
+  }
+  const std::string filepath = write_test_file("blender_mapped_array_whole.bin", values);
+
+  MappedArray<int> array(filepath.c_str());
+  EXPECT_TRUE(array.is_valid());
+  EXPECT_EQ(array.size(), 10000);
+  EXPECT_EQ(array[0], 0);
+  EXPECT_EQ(array[9999], 29997);
+  for (const int i : values.index_range()) {
+    EXPECT_EQ(array[i], values[i]);
+  }
+  EXPECT_FALSE(array.has_io_error());
+
+  BLI_delete(filepath.c_str(), false, false);
+}
+
+TEST(mapped_array, OffsetAndSize)
+{
+  const std::string filepath = write_test_file("blender_mapped_array_offset.bin",
+                                               {1, 2, 3, 4, 5, 6, 7});
+
+  MappedArray<int> array(filepath.c_str(), sizeof(int) * 2, 3);
+  EXPECT_TRUE(array.is_valid());
+  EXPECT_EQ(array.size(), 3);
+  EXPECT_EQ(array[0], 3);
+  EXPECT_EQ(array[1], 4);
+  EXPECT_EQ(array[2], 5);
+
+  /* The remainder of the file. */
+  MappedArray<int> remainder(filepath.c_str(), sizeof(int) * 5);
+  EXPECT_EQ(remainder.size(), 2);
+  EXPECT_EQ(remainder[0], 6);
+  EXPECT_EQ(remainder[1], 7);
+
+  /* Larger than the file. */
+  MappedArray<int> too_large(filepath.c_str(), sizeof(int) * 2, 6);
+  EXPECT_FALSE(too_large.is_valid());
+
+  /* Not aligned. */
+  MappedArray<int> unaligned(filepath.c_str(), 1, 2);
+  EXPECT_FALSE(unaligned.is_valid());
+
+  BLI_delete(filepath.c_str(), false, false);
+}
+
+TEST(mapped_array, MoveConstructor)
+{
+  const std::string filepath = write_test_file("blender_mapped_array_move.bin", {4, 5, 6});
+
+  MappedArray<int> array(filepath.c_str());
+  MappedArray<int> new_array(std::move(array));
+  EXPECT_FALSE(array.is_valid()); /* NOLINT: bugprone-use-after-move */
+  EXPECT_TRUE(new_array.is_valid());
+  EXPECT_EQ(new_array.size(), 3);
+  EXPECT_EQ(new_array[2], 6);
+
+  MappedArray<int> assigned;
+  assigned = std::move(new_array);
+  EXPECT_EQ(assigned.size(), 3);
+  EXPECT_EQ(assigned[0], 4);
+
+  BLI_delete(filepath.c_str(), false, false);
+}
+
+}  // namespace blender::tests
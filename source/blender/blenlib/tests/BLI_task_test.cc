@@ -12,6 +12,7 @@
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 
 #define NUM_ITEMS 10000
 
@@ -181,3 +182,70 @@ TEST(task, ListBaseIter)
   MEM_freeN(items_buffer);
   BLI_threadapi_exit();
 }
+
+/* *** C++ parallel algorithms. *** */
+
+TEST(task, ParallelPrefixSum)
+{
+  blender::Array<int> values(NUM_ITEMS * 10);
+  for (const int i : values.index_range()) {
+    values[i] = i % 3;
+  }
+  const int total = blender::parallel_prefix_sum<int>(values, 64);
+
+  int sum = 0;
+  for (const int i : values.index_range()) {
+    EXPECT_EQ(values[i], sum);
+    sum += i % 3;
+  }
+  EXPECT_EQ(total, sum);
+}
+
+TEST(task, ParallelPrefixSumC)
+{
+  int values[5] = {3, 0, 2, 5, 1};
+  EXPECT_EQ(BLI_task_parallel_prefix_sum_i(values, 5), 11);
+  EXPECT_EQ(values[0], 0);
+  EXPECT_EQ(values[1], 3);
+  EXPECT_EQ(values[2], 3);
+  EXPECT_EQ(values[3], 5);
+  EXPECT_EQ(values[4], 10);
+}
+
+TEST(task, ParallelSort)
+{
+  blender::Array<int> values(NUM_ITEMS * 10);
+  for (const int i : values.index_range()) {
+    values[i] = (i * 7919) % values.size();
+  }
+  blender::parallel_sort(values.begin(), values.end());
+  for (const int i : values.index_range()) {
+    EXPECT_EQ(values[i], i);
+  }
+  blender::parallel_sort(values.begin(), values.end(), [](int a, int b) { return a > b; });
+  EXPECT_EQ(values[0], values.size() - 1);
+  EXPECT_EQ(values[values.size() - 1], 0);
+}
+
+TEST(task, ParallelPartition)
+{
+  blender::Array<int> values(NUM_ITEMS * 10);
+  for (const int i : values.index_range()) {
+    values[i] = i;
+  }
+  const int64_t true_size = blender::parallel_partition<int>(
+      values, [](const int value) { return value % 3 == 0; }, 64);
+  EXPECT_EQ(true_size, (values.size() + 2) / 3);
+  for (const int i : values.index_range()) {
+    if (i < true_size) {
+      EXPECT_EQ(values[i], i * 3);
+    }
+    else {
+      EXPECT_NE(values[i] % 3, 0);
+      if (i > true_size) {
+        /* The partition is stable. */
+        EXPECT_LT(values[i - 1], values[i]);
+      }
+    }
+  }
+}
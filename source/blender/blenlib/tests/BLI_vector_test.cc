@@ -1,6 +1,7 @@
 /* Apache License, Version 2.0 */
 
 #include "BLI_exception_safety_test_utils.hh"
+#include "BLI_float3.hh"
 #include "BLI_strict_flags.h"
 #include "BLI_vector.hh"
 #include "testing/testing.h"
@@ -825,4 +826,31 @@ TEST(vector, RemoveChunkExceptions)
   EXPECT_EQ(vec.size(), 7);
 }
 
+
+TEST(vector, GrowTriviallyRelocatable)
+{
+  Vector<float3, 2> vec;
+  for (int i = 0; i < 1000; i++) {
+    vec.append(float3(float(i), 0.0f, float(-i)));
+  }
+  EXPECT_EQ(vec.size(), 1000);
+  EXPECT_GE(vec.capacity(), 1000);
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_EQ(vec[i], float3(float(i), 0.0f, float(-i)));
+  }
+}
+
+TEST(vector, GrowTriviallyRelocatableRawAllocator)
+{
+  RawVector<int, 0> vec;
+  for (int i = 0; i < 1000; i++) {
+    vec.append(i);
+  }
+  vec.reserve(5000);
+  EXPECT_GE(vec.capacity(), 5000);
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_EQ(vec[i], i);
+  }
+}
+
 }  // namespace blender::tests
@@ -0,0 +1,92 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <cmath>
+
+#include "BLI_array.hh"
+#include "BLI_delaunay_2d.h"
+#include "BLI_double2.hh"
+#include "BLI_rand.hh"
+#include "BLI_vector.hh"
+
+#include "BLI_performance_test_utils.hh"
+
+namespace blender::meshintersect::tests {
+
+using blender::tests::benchmark;
+
+static CDT_input<double> random_points_input(const int amount)
+{
+  RandomNumberGenerator rng(0);
+  CDT_input<double> in;
+  in.vert = Array<double2>(amount);
+  for (double2 &co : in.vert) {
+    co = double2(rng.get_double(), rng.get_double());
+  }
+  in.epsilon = 1e-8;
+  return in;
+}
+
+/** Random points with constraint edges between consecutive pairs of them, many of which cross. */
+static CDT_input<double> random_edges_input(const int amount)
+{
+  CDT_input<double> in = random_points_input(amount);
+  in.edge = Array<std::pair<int, int>>(amount / 2);
+  for (int i = 0; i < amount / 2; i++) {
+    in.edge[i] = {i * 2, i * 2 + 1};
+  }
+  return in;
+}
+
+/** A single face with the shape of a star, which has to be triangulated on the inside. */
+static CDT_input<double> star_face_input(const int amount)
+{
+  CDT_input<double> in;
+  in.vert = Array<double2>(amount);
+  in.face = Array<Vector<int>>(1);
+  for (int i = 0; i < amount; i++) {
+    const double angle = 2.0 * M_PI * (double)i / (double)amount;
+    const double radius = (i % 2) ? 0.5 : 1.0;
+    in.vert[i] = double2(cos(angle) * radius, sin(angle) * radius);
+    in.face[0].append(i);
+  }
+  in.epsilon = 1e-8;
+  return in;
+}
+
+static void benchmark_cdt(const std::string &name,
+                          const CDT_input<double> &in,
+                          const CDT_output_type output_type)
+{
+  benchmark(name, in.vert.size(), [&]() {
+    const CDT_result<double> out = delaunay_2d_calc(in, output_type);
+    return out.face.size();
+  });
+}
+
+TEST(delaunay_2d_performance, RandomPoints)
+{
+  for (const int amount : {1000, 10000, 100000}) {
+    benchmark_cdt(
+        "random points " + std::to_string(amount), random_points_input(amount), CDT_FULL);
+  }
+}
+
+TEST(delaunay_2d_performance, RandomEdges)
+{
+  for (const int amount : {100, 1000, 5000}) {
+    benchmark_cdt("random edges " + std::to_string(amount),
+                  random_edges_input(amount),
+                  CDT_CONSTRAINTS);
+  }
+}
+
+TEST(delaunay_2d_performance, StarFace)
+{
+  for (const int amount : {1000, 10000, 100000}) {
+    benchmark_cdt("star face " + std::to_string(amount), star_face_input(amount), CDT_INSIDE);
+  }
+}
+
+}  // namespace blender::meshintersect::tests
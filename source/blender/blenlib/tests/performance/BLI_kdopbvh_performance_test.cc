@@ -0,0 +1,177 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <cfloat>
+#include <cmath>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_array.hh"
+#include "BLI_float3.hh"
+#include "BLI_kdopbvh.h"
+#include "BLI_math_geom.h"
+#include "BLI_math_vector.h"
+#include "BLI_rand.hh"
+
+#include "BLI_performance_test_utils.hh"
+
+namespace blender::tests {
+
+struct Triangles {
+  Array<float3> positions;
+
+  int size() const
+  {
+    return (int)positions.size() / 3;
+  }
+
+  const float *vertex(const int tri, const int corner) const
+  {
+    return positions[tri * 3 + corner];
+  }
+};
+
+/** Small triangles scattered in a unit cube, roughly like the faces of a dense mesh. */
+static Triangles random_triangles(const int amount)
+{
+  RandomNumberGenerator rng(0);
+  Triangles tris;
+  tris.positions.reinitialize(amount * 3);
+  const float size = 2.0f / cbrtf((float)amount);
+  for (int i = 0; i < amount; i++) {
+    const float3 center(rng.get_float(), rng.get_float(), rng.get_float());
+    for (int corner = 0; corner < 3; corner++) {
+      const float3 offset(rng.get_float(), rng.get_float(), rng.get_float());
+      tris.positions[i * 3 + corner] = center + (offset - float3(0.5f)) * size;
+    }
+  }
+  return tris;
+}
+
+static Array<float3> random_points(const int amount, const uint32_t seed)
+{
+  RandomNumberGenerator rng(seed);
+  Array<float3> points(amount);
+  for (float3 &point : points) {
+    point = float3(rng.get_float(), rng.get_float(), rng.get_float()) * 1.2f - float3(0.1f);
+  }
+  return points;
+}
+
+static BVHTree *build_tree(const Triangles &tris, const char tree_type, const char axis)
+{
+  BVHTree *tree = BLI_bvhtree_new(tris.size(), 0.0f, tree_type, axis);
+  for (int i = 0; i < tris.size(); i++) {
+    BLI_bvhtree_insert(tree, i, tris.vertex(i, 0), 3);
+  }
+  BLI_bvhtree_balance(tree);
+  return tree;
+}
+
+static void nearest_tri_cb(void *userdata, int index, const float co[3], BVHTreeNearest *nearest)
+{
+  const Triangles &tris = *(const Triangles *)userdata;
+  float closest[3];
+  closest_on_tri_to_point_v3(
+      closest, co, tris.vertex(index, 0), tris.vertex(index, 1), tris.vertex(index, 2));
+  const float dist_sq = len_squared_v3v3(co, closest);
+  if (dist_sq < nearest->dist_sq) {
+    nearest->index = index;
+    nearest->dist_sq = dist_sq;
+    copy_v3_v3(nearest->co, closest);
+  }
+}
+
+static void raycast_tri_cb(void *userdata, int index, const BVHTreeRay *ray, BVHTreeRayHit *hit)
+{
+  const Triangles &tris = *(const Triangles *)userdata;
+  float dist;
+  if (isect_ray_tri_v3(ray->origin,
+                       ray->direction,
+                       tris.vertex(index, 0),
+                       tris.vertex(index, 1),
+                       tris.vertex(index, 2),
+                       &dist,
+                       nullptr) &&
+      dist < hit->dist) {
+    hit->index = index;
+    hit->dist = dist;
+    madd_v3_v3v3fl(hit->co, ray->origin, ray->direction, dist);
+  }
+}
+
+static void benchmark_tree(const int tris_num, const char tree_type, const char axis)
+{
+  const std::string prefix = "tree_type " + std::to_string(tree_type) + " axis " +
+                             std::to_string(axis) + " tris " + std::to_string(tris_num);
+  const Triangles tris = random_triangles(tris_num);
+
+  benchmark(prefix + " build", tris_num, [&]() {
+    BVHTree *tree = build_tree(tris, tree_type, axis);
+    const int len = BLI_bvhtree_get_len(tree);
+    BLI_bvhtree_free(tree);
+    return len;
+  });
+
+  BVHTree *tree = build_tree(tris, tree_type, axis);
+  const int queries_num = 100000;
+  const Array<float3> points = random_points(queries_num, 1);
+  const Array<float3> targets = random_points(queries_num, 2);
+
+  benchmark(prefix + " find nearest", queries_num, [&]() {
+    int64_t found = 0;
+    for (const float3 &point : points) {
+      BVHTreeNearest nearest;
+      nearest.index = -1;
+      nearest.dist_sq = FLT_MAX;
+      BLI_bvhtree_find_nearest(tree, point, &nearest, nearest_tri_cb, (void *)&tris);
+      found += nearest.index;
+    }
+    return found;
+  });
+
+  benchmark(prefix + " ray cast", queries_num, [&]() {
+    int64_t found = 0;
+    for (int i = 0; i < queries_num; i++) {
+      float3 dir = targets[i] - points[i];
+      normalize_v3(dir);
+      BVHTreeRayHit hit;
+      hit.index = -1;
+      hit.dist = BVH_RAYCAST_DIST_MAX;
+      BLI_bvhtree_ray_cast(tree, points[i], dir, 0.0f, &hit, raycast_tri_cb, (void *)&tris);
+      found += hit.index;
+    }
+    return found;
+  });
+
+  benchmark(prefix + " self overlap", tris_num, [&]() {
+    uint overlap_num = 0;
+    BVHTreeOverlap *overlap = BLI_bvhtree_overlap(tree, tree, &overlap_num, nullptr, nullptr);
+    MEM_SAFE_FREE(overlap);
+    return overlap_num;
+  });
+
+  BLI_bvhtree_free(tree);
+}
+
+TEST(kdopbvh_performance, TreeTypes)
+{
+  for (const char tree_type : {2, 4, 8}) {
+    benchmark_tree(1000000, tree_type, 6);
+  }
+}
+
+TEST(kdopbvh_performance, Axis)
+{
+  for (const char axis : {6, 8, 14, 26}) {
+    benchmark_tree(1000000, 4, axis);
+  }
+}
+
+TEST(kdopbvh_performance, Small)
+{
+  benchmark_tree(1000, 2, 6);
+}
+
+}  // namespace blender::tests
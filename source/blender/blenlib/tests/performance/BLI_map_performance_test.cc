@@ -0,0 +1,155 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_map.hh"
+#include "BLI_probing_strategies.hh"
+#include "BLI_rand.hh"
+#include "BLI_vector.hh"
+
+#include "BLI_performance_test_utils.hh"
+
+namespace blender::tests {
+
+/**
+ * Keys with different distributions, to see how well the probing strategies deal with hash
+ * collisions. The default hash of integers is the identity, so strided keys only use some of the
+ * lower bits.
+ */
+static Vector<int> keys_sequential(const int amount)
+{
+  Vector<int> keys;
+  for (int i = 0; i < amount; i++) {
+    keys.append(i);
+  }
+  return keys;
+}
+
+static Vector<int> keys_random(const int amount)
+{
+  RandomNumberGenerator rng(0);
+  Vector<int> keys;
+  for (int i = 0; i < amount; i++) {
+    keys.append(rng.get_int32());
+  }
+  return keys;
+}
+
+static Vector<int> keys_strided(const int amount)
+{
+  Vector<int> keys;
+  for (int i = 0; i < amount; i++) {
+    keys.append(i * (3 << 10));
+  }
+  return keys;
+}
+
+/** Keys that are not in the map, to measure failed lookups. */
+static Vector<int> keys_missing(Span<int> keys)
+{
+  Vector<int> missing;
+  for (const int key : keys) {
+    missing.append(key ^ (1 << 30));
+  }
+  return missing;
+}
+
+template<typename MapT> static MapT map_from_keys(Span<int> keys)
+{
+  MapT map;
+  for (const int key : keys) {
+    map.add(key, key);
+  }
+  return map;
+}
+
+template<typename MapT>
+static void benchmark_map(const std::string &name, Span<int> keys, Span<int> missing)
+{
+  benchmark(name + " add", keys.size(), [&]() {
+    MapT map;
+    for (const int key : keys) {
+      map.add(key, key);
+    }
+    return map.size();
+  });
+  benchmark(name + " add reserved", keys.size(), [&]() {
+    MapT map;
+    map.reserve(keys.size());
+    for (const int key : keys) {
+      map.add(key, key);
+    }
+    return map.size();
+  });
+
+  const MapT map = map_from_keys<MapT>(keys);
+  benchmark(name + " lookup hit", keys.size(), [&]() {
+    int64_t sum = 0;
+    for (const int key : keys) {
+      sum += map.lookup(key);
+    }
+    return sum;
+  });
+  benchmark(name + " lookup miss", missing.size(), [&]() {
+    int64_t count = 0;
+    for (const int key : missing) {
+      count += map.contains(key);
+    }
+    return count;
+  });
+
+  benchmark_with_setup(
+      name + " remove",
+      keys.size(),
+      [&]() { return map_from_keys<MapT>(keys); },
+      [&](MapT &filled_map) {
+        int64_t count = 0;
+        for (const int key : keys) {
+          count += filled_map.remove(key);
+        }
+        return count;
+      });
+}
+
+template<typename ProbingStrategy>
+static void benchmark_probing_strategy(const char *strategy_name, const int amount)
+{
+  using MapT = Map<int, int, 0, ProbingStrategy>;
+
+  const Vector<int> sequential = keys_sequential(amount);
+  const Vector<int> random = keys_random(amount);
+  const Vector<int> strided = keys_strided(amount);
+
+  const std::string prefix = std::string(strategy_name) + " " + std::to_string(amount);
+  benchmark_map<MapT>(prefix + " sequential", sequential, keys_missing(sequential));
+  benchmark_map<MapT>(prefix + " random", random, keys_missing(random));
+  benchmark_map<MapT>(prefix + " strided", strided, keys_missing(strided));
+}
+
+static void benchmark_probing_strategies(const int amount)
+{
+  benchmark_probing_strategy<LinearProbingStrategy>("Linear", amount);
+  benchmark_probing_strategy<QuadraticProbingStrategy>("Quadratic", amount);
+  benchmark_probing_strategy<PythonProbingStrategy<>>("Python", amount);
+  benchmark_probing_strategy<PythonProbingStrategy<1, true>>("PythonPreShuffle", amount);
+  benchmark_probing_strategy<ShuffleProbingStrategy<>>("Shuffle", amount);
+}
+
+TEST(map_performance, ProbingStrategies1000)
+{
+  benchmark_probing_strategies(1000);
+}
+
+TEST(map_performance, ProbingStrategies1000000)
+{
+  benchmark_probing_strategies(1000000);
+}
+
+TEST(map_performance, StdUnorderedMap1000000)
+{
+  const Vector<int> random = keys_random(1000000);
+  benchmark_map<StdUnorderedMapWrapper<int, int>>(
+      "std::unordered_map 1000000 random", random, keys_missing(random));
+}
+
+}  // namespace blender::tests
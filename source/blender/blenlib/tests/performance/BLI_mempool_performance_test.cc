@@ -0,0 +1,126 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <cstring>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_array.hh"
+#include "BLI_mempool.h"
+#include "BLI_rand.hh"
+
+#include "BLI_performance_test_utils.hh"
+
+namespace blender::tests {
+
+/** Size of the elements, roughly the size of BMesh elements. */
+constexpr uint element_size = 64;
+
+static BLI_mempool *mempool_filled(const int amount, const uint flag, Array<void *> &r_elems)
+{
+  BLI_mempool *pool = BLI_mempool_create(element_size, 0, 512, flag);
+  r_elems.reinitialize(amount);
+  for (int i = 0; i < amount; i++) {
+    r_elems[i] = BLI_mempool_alloc(pool);
+  }
+  return pool;
+}
+
+static void benchmark_mempool(const int amount)
+{
+  const std::string prefix = std::to_string(amount);
+
+  benchmark(prefix + " mempool alloc", amount, [&]() {
+    BLI_mempool *pool = BLI_mempool_create(element_size, 0, 512, BLI_MEMPOOL_NOP);
+    for (int i = 0; i < amount; i++) {
+      memset(BLI_mempool_alloc(pool), 0, element_size);
+    }
+    const int len = BLI_mempool_len(pool);
+    BLI_mempool_destroy(pool);
+    return len;
+  });
+  benchmark(prefix + " MEM_mallocN", amount, [&]() {
+    Array<void *> elems(amount);
+    for (int i = 0; i < amount; i++) {
+      elems[i] = MEM_mallocN(element_size, __func__);
+      memset(elems[i], 0, element_size);
+    }
+    for (void *elem : elems) {
+      MEM_freeN(elem);
+    }
+    return elems.size();
+  });
+
+  /* Free in random order, which scatters the free list over all chunks. */
+  Array<int> free_order(amount);
+  for (int i = 0; i < amount; i++) {
+    free_order[i] = i;
+  }
+  RandomNumberGenerator rng(0);
+  rng.shuffle<int>(free_order);
+
+  /* Destroying the pool is not part of the measured time. */
+  struct PoolState {
+    BLI_mempool *pool = nullptr;
+    Array<void *> elems;
+
+    PoolState() = default;
+    PoolState(PoolState &&other) : pool(other.pool), elems(std::move(other.elems))
+    {
+      other.pool = nullptr;
+    }
+    ~PoolState()
+    {
+      if (pool) {
+        BLI_mempool_destroy(pool);
+      }
+    }
+  };
+  auto setup_pool = [&]() {
+    PoolState state;
+    state.pool = mempool_filled(amount, BLI_MEMPOOL_ALLOW_ITER, state.elems);
+    return state;
+  };
+
+  benchmark_with_setup(prefix + " mempool free random", amount, setup_pool, [&](PoolState &state) {
+    for (const int i : free_order) {
+      BLI_mempool_free(state.pool, state.elems[i]);
+    }
+    return amount;
+  });
+
+  /* Allocate again after freeing half of the elements, reusing the holes. */
+  benchmark_with_setup(
+      prefix + " mempool realloc after free", amount / 2, setup_pool, [&](PoolState &state) {
+        for (int i = 0; i < amount / 2; i++) {
+          BLI_mempool_free(state.pool, state.elems[free_order[i]]);
+        }
+        for (int i = 0; i < amount / 2; i++) {
+          state.elems[free_order[i]] = BLI_mempool_alloc(state.pool);
+        }
+        return BLI_mempool_len(state.pool);
+      });
+
+  benchmark_with_setup(prefix + " mempool iterate", amount, setup_pool, [&](PoolState &state) {
+    int64_t count = 0;
+    BLI_mempool_iter iter;
+    BLI_mempool_iternew(state.pool, &iter);
+    while (BLI_mempool_iterstep(&iter)) {
+      count++;
+    }
+    return count;
+  });
+}
+
+TEST(mempool_performance, Small)
+{
+  benchmark_mempool(10000);
+}
+
+TEST(mempool_performance, Large)
+{
+  benchmark_mempool(10000000);
+}
+
+}  // namespace blender::tests
@@ -0,0 +1,73 @@
+/* Apache License, Version 2.0 */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Small helpers for micro-benchmarks, which run a measured function a few times and print the
+ * fastest and median time per processed item. Keeping the best of several runs makes the numbers
+ * stable enough to compare them between revisions on the same machine.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+#include "BLI_string_ref.hh"
+#include "BLI_timeit.hh"
+#include "BLI_vector.hh"
+
+namespace blender::tests {
+
+/** Number of times every benchmark is run. */
+constexpr int benchmark_repetitions = 5;
+
+/**
+ * The measured functions return a value derived from their results, it is written here so that
+ * the compiler can not optimize the work away.
+ */
+inline volatile int64_t benchmark_sink = 0;
+
+/**
+ * Call `setup_fn` and then `run_fn` with its result, #benchmark_repetitions times. Only the time
+ * of `run_fn` is measured. `items_num` is the number of items processed by every call and is
+ * used to compute the time per item.
+ */
+template<typename SetupFn, typename RunFn>
+void benchmark_with_setup(StringRef name,
+                          const int64_t items_num,
+                          const SetupFn &setup_fn,
+                          const RunFn &run_fn)
+{
+  using namespace blender::timeit;
+
+  Vector<Nanoseconds> durations;
+  for (int i = 0; i < benchmark_repetitions; i++) {
+    auto state = setup_fn();
+    const TimePoint start = Clock::now();
+    benchmark_sink = benchmark_sink + (int64_t)run_fn(state);
+    durations.append(Clock::now() - start);
+  }
+  std::sort(durations.begin(), durations.end());
+
+  const double items_div = (double)std::max<int64_t>(items_num, 1);
+  const double min_ns = (double)durations[0].count();
+  const double median_ns = (double)durations[durations.size() / 2].count();
+  printf("%-56s %12.2f ns/item (median %12.2f) %10.3f ms %10lld items\n",
+         std::string(name).c_str(),
+         min_ns / items_div,
+         median_ns / items_div,
+         min_ns / 1e6,
+         (long long)items_num);
+}
+
+/** Same as #benchmark_with_setup, for functions that need no setup. */
+template<typename RunFn>
+void benchmark(StringRef name, const int64_t items_num, const RunFn &run_fn)
+{
+  benchmark_with_setup(
+      name, items_num, []() { return 0; }, [&](int /*state*/) { return run_fn(); });
+}
+
+}  // namespace blender::tests
@@ -115,6 +115,62 @@ void BLO_blendfiledata_free(BlendFileData *bfd);
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name BLO Read Statistics
+ *
+ * Where the time goes when loading a file, collected for every file read from disk or memory
+ * (not for undo steps). Printed with `--debug`, available from Python as `bpy.app.load_stats`.
+ * \{ */
+
+typedef struct BlendReadStatsIDType {
+  short idcode;
+  int ids_len;
+  /** Structs read with a different DNA than the current one. */
+  int structs_reconstructed;
+  /** Bytes of file data read into this type's data-blocks. */
+  uint64_t bytes;
+  /** Reading and direct linking, in seconds. */
+  double time;
+} BlendReadStatsIDType;
+
+typedef struct BlendReadStatsLibrary {
+  char filepath[1024]; /* 1024 = FILE_MAX */
+  int ids_len;
+  uint64_t bytes;
+  /** Opening the file and reading its linked data-blocks, in seconds. */
+  double time;
+} BlendReadStatsLibrary;
+
+typedef struct BlendReadStats {
+  char filepath[1024]; /* 1024 = FILE_MAX */
+
+  /** All times in seconds. */
+  double time_total;
+  /** Parallel DNA reconstruction pass, ahead of reading data-blocks. */
+  double time_reconstruct;
+  double time_versioning;
+  double time_lib_link;
+  /** All linked libraries, including their reading and versioning. */
+  double time_libraries;
+
+  int ids_len;
+  int structs_reconstructed;
+  uint64_t bytes;
+
+  /** Only types that have data-blocks in the file, in #BKE_idtype_idcode_to_index order. */
+  BlendReadStatsIDType *id_types;
+  int id_types_len;
+
+  BlendReadStatsLibrary *libraries;
+  int libraries_len;
+} BlendReadStats;
+
+const BlendReadStats *BLO_read_stats_last(void);
+void BLO_read_stats_last_free(void);
+void BLO_read_stats_print(const BlendReadStats *stats);
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name BLO Blend File Handle API
  * \{ */
@@ -69,8 +69,11 @@
 #include "BLI_memarena.h"
 #include "BLI_mempool.h"
 #include "BLI_mmap.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
+#include "PIL_time.h"
+
 #include "BLT_translation.h"
 
 #include "BKE_anim_data.h"
@@ -186,6 +189,9 @@
 /* Define this to have verbose debug prints. */
 //#define USE_DEBUG_PRINT
 
+/* Define this to print #OldNewMap lookup statistics when freeing a #FileData. */
+//#define USE_OLDNEWMAP_STATS
+
 #ifdef USE_DEBUG_PRINT
 #  define DEBUG_PRINTF(...) printf(__VA_ARGS__)
 #else
@@ -208,6 +214,8 @@ typedef struct BHeadN {
   bool has_data;
 #endif
   bool is_memchunk_identical;
+  /** Struct data reconstructed ahead of time by #read_struct_reconstruct_all (owned). */
+  void *data_reconstructed;
   struct BHead bhead;
 } BHeadN;
 
@@ -268,6 +276,14 @@ typedef struct OldNewMap {
   int32_t *map;
 
   int capacity_exp;
+
+#ifdef USE_OLDNEWMAP_STATS
+  int64_t stats_lookups;
+  int64_t stats_misses;
+  /** Number of slots visited by lookups. */
+  int64_t stats_probes;
+  int64_t stats_resizes;
+#endif
 } OldNewMap;
 
 #define ENTRIES_CAPACITY(onm) (1ll << (onm)->capacity_exp)
@@ -315,7 +331,13 @@ static void oldnewmap_insert_or_replace(OldNewMap *onm, OldNew entry)
 
 static OldNew *oldnewmap_lookup_entry(const OldNewMap *onm, const void *addr)
 {
+#ifdef USE_OLDNEWMAP_STATS
+  ((OldNewMap *)onm)->stats_lookups++;
+#endif
   ITER_SLOTS (onm, addr, slot, index) {
+#ifdef USE_OLDNEWMAP_STATS
+    ((OldNewMap *)onm)->stats_probes++;
+#endif
     if (index >= 0) {
       OldNew *entry = &onm->entries[index];
       if (entry->oldp == addr) {
@@ -323,6 +345,9 @@ static OldNew *oldnewmap_lookup_entry(const OldNewMap *onm, const void *addr)
       }
     }
     else {
+#ifdef USE_OLDNEWMAP_STATS
+      ((OldNewMap *)onm)->stats_misses++;
+#endif
       return NULL;
     }
   }
@@ -333,15 +358,41 @@ static void oldnewmap_clear_map(OldNewMap *onm)
   memset(onm->map, 0xFF, MAP_CAPACITY(onm) * sizeof(*onm->map));
 }
 
-static void oldnewmap_increase_size(OldNewMap *onm)
+static void oldnewmap_resize(OldNewMap *onm, int capacity_exp)
 {
-  onm->capacity_exp++;
+  BLI_assert((1ll << capacity_exp) >= onm->nentries);
+  onm->capacity_exp = capacity_exp;
   onm->entries = MEM_reallocN(onm->entries, sizeof(*onm->entries) * ENTRIES_CAPACITY(onm));
-  onm->map = MEM_reallocN(onm->map, sizeof(*onm->map) * MAP_CAPACITY(onm));
+  /* The map is rebuilt, no need to copy its contents. */
+  MEM_freeN(onm->map);
+  onm->map = MEM_malloc_arrayN(MAP_CAPACITY(onm), sizeof(*onm->map), "OldNewMap.map");
   oldnewmap_clear_map(onm);
   for (int i = 0; i < onm->nentries; i++) {
     oldnewmap_insert_index_in_map(onm, onm->entries[i].oldp, i);
   }
+#ifdef USE_OLDNEWMAP_STATS
+  onm->stats_resizes++;
+#endif
+}
+
+static void oldnewmap_increase_size(OldNewMap *onm)
+{
+  oldnewmap_resize(onm, onm->capacity_exp + 1);
+}
+
+/**
+ * Make room for \a nentries entries at once, avoids growing (and rehashing)
+ * the map multiple times when the number of entries is known in advance.
+ */
+static void oldnewmap_reserve(OldNewMap *onm, int nentries)
+{
+  int capacity_exp = onm->capacity_exp;
+  while ((1ll << capacity_exp) < nentries) {
+    capacity_exp++;
+  }
+  if (capacity_exp != onm->capacity_exp) {
+    oldnewmap_resize(onm, capacity_exp);
+  }
 }
 
 /* Public OldNewMap API */
@@ -421,11 +472,30 @@ static void oldnewmap_clear(OldNewMap *onm)
     }
   }
 
-  onm->capacity_exp = DEFAULT_SIZE_EXP;
-  oldnewmap_clear_map(onm);
   onm->nentries = 0;
+  if (onm->capacity_exp != DEFAULT_SIZE_EXP) {
+    /* Shrink back, the map is cleared for every ID and most have little data. */
+    oldnewmap_resize(onm, DEFAULT_SIZE_EXP);
+  }
+  else {
+    oldnewmap_clear_map(onm);
+  }
 }
 
+#ifdef USE_OLDNEWMAP_STATS
+static void oldnewmap_stats_print(const OldNewMap *onm, const char *name)
+{
+  printf("%s: %lld lookups (%.1f%% hits, %.2f slots per lookup), %lld resizes\n",
+         name,
+         (long long)onm->stats_lookups,
+         onm->stats_lookups ?
+             100.0 * (double)(onm->stats_lookups - onm->stats_misses) / onm->stats_lookups :
+             0.0,
+         onm->stats_lookups ? (double)onm->stats_probes / onm->stats_lookups : 0.0,
+         (long long)onm->stats_resizes);
+}
+#endif
+
 static void oldnewmap_free(OldNewMap *onm)
 {
   MEM_freeN(onm->entries);
@@ -820,6 +890,7 @@ static BHeadN *get_bhead(FileData *fd)
           new_bhead->file_offset = fd->file_offset;
           new_bhead->has_data = false;
           new_bhead->is_memchunk_identical = false;
+          new_bhead->data_reconstructed = NULL;
           new_bhead->bhead = bhead;
           off64_t seek_new = fd->seek(fd, bhead.len, SEEK_CUR);
           if (seek_new == -1) {
@@ -843,6 +914,7 @@ static BHeadN *get_bhead(FileData *fd)
           new_bhead->has_data = true;
 #endif
           new_bhead->is_memchunk_identical = false;
+          new_bhead->data_reconstructed = NULL;
           new_bhead->bhead = bhead;
 
           readsize = fd->read(
@@ -955,12 +1027,40 @@ static BHead *blo_bhead_read_full(FileData *fd, BHead *thisblock)
   new_bhead_data->file_offset = new_bhead->file_offset;
   new_bhead_data->has_data = true;
   new_bhead_data->is_memchunk_identical = false;
+  new_bhead_data->data_reconstructed = NULL;
   if (!blo_bhead_read_data(fd, thisblock, new_bhead_data + 1)) {
     MEM_freeN(new_bhead_data);
     return NULL;
   }
   return &new_bhead_data->bhead;
 }
+
+/**
+ * Data of a block which wasn't read yet, pointing directly into the memory mapped file.
+ * Only for read-only access, returns NULL when the file isn't memory mapped.
+ *
+ * \note Check #blo_bhead_data_mapped_is_valid once done reading.
+ */
+static const void *blo_bhead_data_mapped(FileData *fd, BHead *thisblock)
+{
+  BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
+  BLI_assert(new_bhead->has_data == false && new_bhead->file_offset != 0);
+  if ((fd->mmap_file == NULL) ||
+      ((size_t)new_bhead->file_offset + (size_t)thisblock->len > fd->buffersize)) {
+    return NULL;
+  }
+  return POINTER_OFFSET(BLI_mmap_get_pointer(fd->mmap_file), new_bhead->file_offset);
+}
+
+/** Failed reads of mapped memory give zeroes instead of an error, so check afterwards. */
+static bool blo_bhead_data_mapped_is_valid(FileData *fd)
+{
+  if (UNLIKELY(BLI_mmap_any_io_error(fd->mmap_file))) {
+    fd->flags &= ~FD_FLAGS_FILE_OK;
+    return false;
+  }
+  return true;
+}
 #endif /* USE_BHEAD_READ_ON_DEMAND */
 
 /* Warning! Caller's responsibility to ensure given bhead **is** an ID one! */
@@ -1164,6 +1264,202 @@ static ssize_t fd_read_gzip_from_file(FileData *filedata,
   return readsize;
 }
 
+/* GZip file reading with a seek table, see #BlendFrameFooter. */
+
+typedef struct BlendFrameReader {
+  /** File offset of every frame, followed by the offset of the seek table. */
+  uint64_t *frame_offsets;
+  uint frames_len;
+  uint frame_size;
+
+  /** Decompressed data of #BlendFrameReader.frame_index (-1 when not loaded yet). */
+  uchar *buf;
+  size_t buf_len;
+  int frame_index;
+
+  uchar *buf_compressed;
+  size_t buf_compressed_len;
+  z_stream strm;
+} BlendFrameReader;
+
+static void blend_frame_reader_free(BlendFrameReader *reader)
+{
+  inflateEnd(&reader->strm);
+  MEM_SAFE_FREE(reader->frame_offsets);
+  MEM_SAFE_FREE(reader->buf);
+  MEM_SAFE_FREE(reader->buf_compressed);
+  MEM_freeN(reader);
+}
+
+static bool blend_frame_read_exact(int file, off64_t offset, void *buf, size_t len)
+{
+  return (BLI_lseek(file, offset, SEEK_SET) == offset) && (read(file, buf, len) == (ssize_t)len);
+}
+
+/**
+ * Read the seek table of a compressed file.
+ * \return NULL for files without one (written by older versions), these are read sequentially.
+ */
+static BlendFrameReader *blend_frame_reader_open(int file)
+{
+  BlendFrameFooter footer;
+  const off64_t file_len = BLI_lseek(file, 0, SEEK_END);
+  /* The footer is followed by the gzip trailer (CRC32 and size). */
+  const off64_t footer_offset = file_len - 8 - (off64_t)sizeof(footer);
+
+  if ((footer_offset <= 0) || !blend_frame_read_exact(file, footer_offset, &footer, sizeof(footer)) ||
+      (memcmp(footer.magic, BLEND_FRAME_MAGIC, sizeof(footer.magic)) != 0)) {
+    return NULL;
+  }
+  if (ENDIAN_ORDER == B_ENDIAN) {
+    BLI_endian_switch_uint64(&footer.table_offset);
+    BLI_endian_switch_uint32(&footer.frames_len);
+    BLI_endian_switch_uint32(&footer.frame_size);
+  }
+
+  /* The table is written without compression, so its member is larger than the table itself. */
+  const size_t table_len = sizeof(uint32_t) * (size_t)footer.frames_len;
+  if ((footer.frames_len == 0) || (footer.frame_size == 0) ||
+      (footer.table_offset >= (uint64_t)footer_offset) ||
+      (table_len + sizeof(footer) > (uint64_t)file_len - footer.table_offset)) {
+    return NULL;
+  }
+
+  const size_t member_len = (size_t)(file_len - (off64_t)footer.table_offset);
+  uchar *member = MEM_mallocN(member_len, __func__);
+  uint32_t *frame_sizes = MEM_mallocN(table_len + sizeof(footer), __func__);
+  bool ok = blend_frame_read_exact(file, (off64_t)footer.table_offset, member, member_len);
+
+  if (ok) {
+    z_stream strm = {NULL};
+    ok = (inflateInit2(&strm, MAX_WBITS + 16) == Z_OK);
+    if (ok) {
+      strm.next_in = member;
+      strm.avail_in = (uint)member_len;
+      strm.next_out = (Bytef *)frame_sizes;
+      strm.avail_out = (uint)(table_len + sizeof(footer));
+      ok = (inflate(&strm, Z_FINISH) == Z_STREAM_END) && (strm.avail_out == 0);
+      inflateEnd(&strm);
+    }
+  }
+  MEM_freeN(member);
+
+  BlendFrameReader *reader = NULL;
+  if (ok) {
+    if (ENDIAN_ORDER == B_ENDIAN) {
+      BLI_endian_switch_uint32_array(frame_sizes, (int)footer.frames_len);
+    }
+
+    reader = MEM_callocN(sizeof(*reader), __func__);
+    reader->frames_len = footer.frames_len;
+    reader->frame_size = footer.frame_size;
+    reader->frame_index = -1;
+    reader->frame_offsets = MEM_malloc_arrayN(
+        footer.frames_len + 1, sizeof(*reader->frame_offsets), __func__);
+    reader->frame_offsets[0] = 0;
+    for (uint i = 0; i < footer.frames_len; i++) {
+      reader->frame_offsets[i + 1] = reader->frame_offsets[i] + frame_sizes[i];
+    }
+    reader->buf = MEM_mallocN(footer.frame_size, __func__);
+
+    if ((reader->frame_offsets[footer.frames_len] != footer.table_offset) ||
+        (inflateInit2(&reader->strm, MAX_WBITS + 16) != Z_OK)) {
+      blend_frame_reader_free(reader);
+      reader = NULL;
+    }
+  }
+  MEM_freeN(frame_sizes);
+
+  return reader;
+}
+
+static bool blend_frame_reader_load(FileData *filedata, BlendFrameReader *reader, uint frame)
+{
+  if ((int)frame == reader->frame_index) {
+    return true;
+  }
+  if (frame >= reader->frames_len) {
+    return false;
+  }
+
+  const size_t compressed_len = (size_t)(reader->frame_offsets[frame + 1] -
+                                         reader->frame_offsets[frame]);
+  if (compressed_len > reader->buf_compressed_len) {
+    MEM_SAFE_FREE(reader->buf_compressed);
+    reader->buf_compressed = MEM_mallocN(compressed_len, __func__);
+    reader->buf_compressed_len = compressed_len;
+  }
+  if (!blend_frame_read_exact(filedata->filedes,
+                              (off64_t)reader->frame_offsets[frame],
+                              reader->buf_compressed,
+                              compressed_len)) {
+    return false;
+  }
+
+  z_stream *strm = &reader->strm;
+  inflateReset(strm);
+  strm->next_in = reader->buf_compressed;
+  strm->avail_in = (uint)compressed_len;
+  strm->next_out = reader->buf;
+  strm->avail_out = reader->frame_size;
+  reader->frame_index = -1;
+  if (inflate(strm, Z_FINISH) != Z_STREAM_END) {
+    return false;
+  }
+
+  reader->buf_len = reader->frame_size - strm->avail_out;
+  reader->frame_index = (int)frame;
+  return true;
+}
+
+static ssize_t fd_read_gzip_frames(FileData *filedata,
+                                   void *buffer,
+                                   size_t size,
+                                   bool *UNUSED(r_is_memchunck_identical))
+{
+  BlendFrameReader *reader = filedata->frame_reader;
+  size_t totread = 0;
+
+  while (totread < size) {
+    const uint frame = (uint)((uint64_t)filedata->file_offset / reader->frame_size);
+    const size_t frame_offset = (size_t)((uint64_t)filedata->file_offset % reader->frame_size);
+
+    /* Reading past the last frame is the end of the file. */
+    if (!blend_frame_reader_load(filedata, reader, frame) || (frame_offset >= reader->buf_len)) {
+      break;
+    }
+
+    const size_t readsize = MIN2(size - totread, reader->buf_len - frame_offset);
+    memcpy(POINTER_OFFSET(buffer, totread), reader->buf + frame_offset, readsize);
+    totread += readsize;
+    filedata->file_offset += (off64_t)readsize;
+  }
+
+  return (ssize_t)totread;
+}
+
+static off64_t fd_seek_gzip_frames(FileData *filedata, off64_t offset, int whence)
+{
+  off64_t new_pos;
+  if (whence == SEEK_CUR) {
+    new_pos = filedata->file_offset + offset;
+  }
+  else if (whence == SEEK_SET) {
+    new_pos = offset;
+  }
+  else {
+    /* The uncompressed size isn't stored, #SEEK_END isn't needed for reading. */
+    return -1;
+  }
+
+  if (new_pos < 0) {
+    return -1;
+  }
+
+  filedata->file_offset = new_pos;
+  return filedata->file_offset;
+}
+
 /* Memory reading. */
 
 static ssize_t fd_read_from_memory(FileData *filedata,
@@ -1356,6 +1652,7 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
   FileDataSeekFn *seek_fn = NULL; /* Optional. */
   size_t buffersize = 0;
   BLI_mmap_file *mmap_file = NULL;
+  BlendFrameReader *frame_reader = NULL;
 
   gzFile gzfile = (gzFile)Z_NULL;
 
@@ -1392,6 +1689,18 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
   if ((read_fn == NULL) &&
       /* Check header magic. */
       (header[0] == 0x1f && header[1] == 0x8b)) {
+    /* Files with a seek table support random access, only the frames needed are decompressed. */
+    frame_reader = blend_frame_reader_open(file);
+  }
+
+  if (frame_reader != NULL) {
+    read_fn = fd_read_gzip_frames;
+    seek_fn = fd_seek_gzip_frames;
+  }
+  else if ((read_fn == NULL) &&
+           /* Check header magic. */
+           (header[0] == 0x1f && header[1] == 0x8b)) {
+    errno = 0;
     gzfile = BLI_gzopen(filepath, "rb");
     if (gzfile == (gzFile)Z_NULL) {
       BKE_reportf(reports,
@@ -1421,6 +1730,7 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
   fd->read = read_fn;
   fd->seek = seek_fn;
   fd->mmap_file = mmap_file;
+  fd->frame_reader = frame_reader;
   fd->buffersize = buffersize;
 
   return fd;
@@ -1579,6 +1889,10 @@ void blo_filedata_free(FileData *fd)
       gzclose(fd->gzfiledes);
     }
 
+    if (fd->frame_reader != NULL) {
+      blend_frame_reader_free(fd->frame_reader);
+    }
+
     if (fd->strm.next_in) {
       if (inflateEnd(&fd->strm) != Z_OK) {
         printf("close gzip stream error\n");
@@ -1596,6 +1910,10 @@ void blo_filedata_free(FileData *fd)
     }
 
     /* Free all BHeadN data blocks */
+    LISTBASE_FOREACH (BHeadN *, new_bhead, &fd->bhead_list) {
+      /* Reconstructed ahead of time but never read. */
+      MEM_SAFE_FREE(new_bhead->data_reconstructed);
+    }
 #ifndef NDEBUG
     BLI_freelistN(&fd->bhead_list);
 #else
@@ -1618,6 +1936,15 @@ void blo_filedata_free(FileData *fd)
       DNA_reconstruct_info_free(fd->reconstruct_info);
     }
 
+#ifdef USE_OLDNEWMAP_STATS
+    if (fd->datamap) {
+      oldnewmap_stats_print(fd->datamap, "datamap");
+    }
+    if (fd->libmap) {
+      oldnewmap_stats_print(fd->libmap, "libmap");
+    }
+#endif
+
     if (fd->datamap) {
       oldnewmap_free(fd->datamap);
     }
@@ -2130,6 +2457,145 @@ void blo_cache_storage_end(FileData *fd)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Read Statistics
+ *
+ * Collected in #FileData.stats while reading a file, see #BlendReadStats.
+ * \{ */
+
+typedef struct ReadStats {
+  BlendReadStats stats;
+  /** Indexed by #BKE_idtype_idcode_to_index, compacted into `stats` when done. */
+  BlendReadStatsIDType id_types[INDEX_ID_MAX];
+  /** Libraries matching `stats.libraries`. */
+  Library **libraries;
+  /** Start time of the whole read. */
+  double time_start;
+} ReadStats;
+
+/** Statistics of the last file read on the main thread. */
+static BlendReadStats *read_stats_last = NULL;
+
+static ReadStats *read_stats_new(const char *filepath)
+{
+  ReadStats *rs = MEM_callocN(sizeof(*rs), __func__);
+  BLI_strncpy(rs->stats.filepath, filepath, sizeof(rs->stats.filepath));
+  rs->time_start = PIL_check_seconds_timer();
+  return rs;
+}
+
+static void read_stats_free(BlendReadStats *stats)
+{
+  MEM_SAFE_FREE(stats->id_types);
+  MEM_SAFE_FREE(stats->libraries);
+  MEM_freeN(stats);
+}
+
+static BlendReadStatsLibrary *read_stats_library_ensure(ReadStats *rs, Library *lib)
+{
+  BlendReadStats *stats = &rs->stats;
+  for (int i = 0; i < stats->libraries_len; i++) {
+    if (rs->libraries[i] == lib) {
+      return &stats->libraries[i];
+    }
+  }
+
+  const int index = stats->libraries_len++;
+  stats->libraries = MEM_reallocN(stats->libraries,
+                                  sizeof(*stats->libraries) * (size_t)stats->libraries_len);
+  rs->libraries = MEM_reallocN(rs->libraries,
+                               sizeof(*rs->libraries) * (size_t)stats->libraries_len);
+  rs->libraries[index] = lib;
+
+  BlendReadStatsLibrary *stats_lib = &stats->libraries[index];
+  memset(stats_lib, 0, sizeof(*stats_lib));
+  BLI_strncpy(stats_lib->filepath, lib->filepath_abs, sizeof(stats_lib->filepath));
+  return stats_lib;
+}
+
+/**
+ * Hand over the statistics of a finished read to #BLO_read_stats_last,
+ * printing them in debug mode.
+ */
+static void read_stats_finish(ReadStats *rs)
+{
+  BlendReadStats *stats = MEM_mallocN(sizeof(*stats), __func__);
+  *stats = rs->stats;
+  stats->time_total = PIL_check_seconds_timer() - rs->time_start;
+
+  stats->id_types = MEM_calloc_arrayN(INDEX_ID_MAX, sizeof(*stats->id_types), __func__);
+  for (int i = 0; i < INDEX_ID_MAX; i++) {
+    if (rs->id_types[i].ids_len != 0) {
+      stats->id_types[stats->id_types_len++] = rs->id_types[i];
+    }
+  }
+  MEM_SAFE_FREE(rs->libraries);
+  MEM_freeN(rs);
+
+  if (G.debug & G_DEBUG) {
+    BLO_read_stats_print(stats);
+  }
+
+  if (BLI_thread_is_main()) {
+    BLO_read_stats_last_free();
+    read_stats_last = stats;
+  }
+  else {
+    read_stats_free(stats);
+  }
+}
+
+/**
+ * \return The statistics of the last file read on the main thread, NULL if there is none.
+ */
+const BlendReadStats *BLO_read_stats_last(void)
+{
+  return read_stats_last;
+}
+
+void BLO_read_stats_last_free(void)
+{
+  if (read_stats_last != NULL) {
+    read_stats_free(read_stats_last);
+    read_stats_last = NULL;
+  }
+}
+
+void BLO_read_stats_print(const BlendReadStats *stats)
+{
+  printf("read file stats %s\n", stats->filepath);
+  printf("  Total: %.3fs\n", stats->time_total);
+  printf("  Reconstruct (parallel): %.3fs\n", stats->time_reconstruct);
+  printf("  Versioning: %.3fs\n", stats->time_versioning);
+  printf("  Lib link: %.3fs\n", stats->time_lib_link);
+  printf("  Libraries: %.3fs\n", stats->time_libraries);
+  printf("  Data-blocks: %d, %.2f MiB, %d structs reconstructed\n",
+         stats->ids_len,
+         (double)stats->bytes / (1024.0 * 1024.0),
+         stats->structs_reconstructed);
+
+  for (int i = 0; i < stats->id_types_len; i++) {
+    const BlendReadStatsIDType *stats_type = &stats->id_types[i];
+    printf("    %-16s %6d, %9.2f MiB, %8d reconstructed, %.3fs\n",
+           BKE_idtype_idcode_to_name(stats_type->idcode),
+           stats_type->ids_len,
+           (double)stats_type->bytes / (1024.0 * 1024.0),
+           stats_type->structs_reconstructed,
+           stats_type->time);
+  }
+
+  for (int i = 0; i < stats->libraries_len; i++) {
+    const BlendReadStatsLibrary *stats_lib = &stats->libraries[i];
+    printf("    Library %s: %d data-blocks, %.2f MiB, %.3fs\n",
+           stats_lib->filepath,
+           stats_lib->ids_len,
+           (double)stats_lib->bytes / (1024.0 * 1024.0),
+           stats_lib->time);
+  }
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name DNA Struct Loading
  * \{ */
@@ -2154,6 +2620,18 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
 {
   void *temp = NULL;
 
+  if (fd->stats != NULL) {
+    fd->stats->stats.bytes += (uint64_t)bh->len;
+  }
+
+  if (BHEADN_FROM_BHEAD(bh)->data_reconstructed) {
+    SWAP(void *, temp, BHEADN_FROM_BHEAD(bh)->data_reconstructed);
+    if (fd->stats != NULL) {
+      fd->stats->stats.structs_reconstructed++;
+    }
+    return temp;
+  }
+
   if (bh->len) {
 #ifdef USE_BHEAD_READ_ON_DEMAND
     BHead *bh_orig = bh;
@@ -2176,15 +2654,32 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
     if (fd->compflags[bh->SDNAnr] != SDNA_CMP_REMOVED) {
       if (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
 #ifdef USE_BHEAD_READ_ON_DEMAND
+        const void *data_mapped = NULL;
         if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
-          bh = blo_bhead_read_full(fd, bh);
-          if (UNLIKELY(bh == NULL)) {
-            fd->flags &= ~FD_FLAGS_FILE_OK;
-            return NULL;
+          /* Reconstruct straight from the mapped file when possible, saving a temporary copy. */
+          data_mapped = blo_bhead_data_mapped(fd, bh);
+          if (data_mapped == NULL) {
+            bh = blo_bhead_read_full(fd, bh);
+            if (UNLIKELY(bh == NULL)) {
+              fd->flags &= ~FD_FLAGS_FILE_OK;
+              return NULL;
+            }
           }
         }
+        if (data_mapped != NULL) {
+          temp = DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, data_mapped);
+          if (UNLIKELY(!blo_bhead_data_mapped_is_valid(fd))) {
+            MEM_SAFE_FREE(temp);
+          }
+        }
+        else
 #endif
-        temp = DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1));
+        {
+          temp = DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1));
+        }
+        if (fd->stats != NULL) {
+          fd->stats->stats.structs_reconstructed++;
+        }
       }
       else {
         /* SDNA_CMP_EQUAL */
@@ -2227,6 +2722,158 @@ static const void *peek_struct_undo(FileData *fd, BHead *bhead)
   return (bhead->len) ? (const void *)(bhead + 1) : NULL;
 }
 
+/* Upper bound of block data read into memory at once by #read_struct_reconstruct_all,
+ * for files where data is otherwise read on demand. */
+#define RECONSTRUCT_BATCH_SIZE (64 * 1024 * 1024)
+
+static bool read_struct_needs_reconstruct(const FileData *fd, const BHead *bh)
+{
+  return (bh->code == DATA) && (bh->len != 0) &&
+         (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL);
+}
+
+typedef struct ReconstructTaskData {
+  FileData *fd;
+  /** Blocks from the #FileData.bhead_list. */
+  BHead **bheads;
+  /**
+   * The same blocks with their data in memory (may be temporary copies),
+   * NULL when the data is read from the memory mapped file directly.
+   */
+  BHead **bheads_data;
+} ReconstructTaskData;
+
+static void read_struct_reconstruct_fn(void *__restrict userdata,
+                                       const int index,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ReconstructTaskData *data = userdata;
+  FileData *fd = data->fd;
+  BHead *bh = data->bheads[index];
+  BHead *bh_data = data->bheads_data[index];
+  const void *old_blocks = NULL;
+
+  if (bh_data != NULL) {
+    if (bh_data->SDNAnr && (fd->flags & FD_FLAGS_SWITCH_ENDIAN)) {
+      switch_endian_structs(fd->filesdna, bh_data);
+    }
+    old_blocks = bh_data + 1;
+  }
+#ifdef USE_BHEAD_READ_ON_DEMAND
+  else {
+    old_blocks = blo_bhead_data_mapped(fd, bh);
+  }
+#endif
+  BHEADN_FROM_BHEAD(bh)->data_reconstructed = DNA_struct_reconstruct(
+      fd->reconstruct_info, bh->SDNAnr, bh->nr, old_blocks);
+}
+
+static void read_struct_reconstruct_batch(ReconstructTaskData *data, const int len)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 16;
+  BLI_task_parallel_range(0, len, data, read_struct_reconstruct_fn, &settings);
+
+#ifdef USE_BHEAD_READ_ON_DEMAND
+  for (int i = 0; i < len; i++) {
+    if (!ELEM(data->bheads_data[i], NULL, data->bheads[i])) {
+      MEM_freeN(BHEADN_FROM_BHEAD(data->bheads_data[i]));
+    }
+  }
+#endif
+}
+
+/**
+ * Reconstruct all data blocks written with a different DNA than the current one on multiple
+ * threads, before the (sequential) reading of ID's picks up the results in #read_struct.
+ *
+ * This is the CPU heavy part of loading files saved by other Blender versions,
+ * everything else (direct linking, pointer remapping) depends on shared state
+ * and stays sequential.
+ */
+static void read_struct_reconstruct_all(FileData *fd)
+{
+  int bheads_len = 0;
+  for (BHead *bh = blo_bhead_first(fd); bh; bh = blo_bhead_next(fd, bh)) {
+    if (bh->code == ENDB) {
+      break;
+    }
+    if (read_struct_needs_reconstruct(fd, bh)) {
+      bheads_len++;
+    }
+  }
+
+  if (bheads_len == 0) {
+    return;
+  }
+
+  ReconstructTaskData data = {
+      .fd = fd,
+      .bheads = MEM_malloc_arrayN(bheads_len, sizeof(*data.bheads), __func__),
+      .bheads_data = MEM_malloc_arrayN(bheads_len, sizeof(*data.bheads_data), __func__),
+  };
+  int batch_len = 0;
+  size_t batch_size = 0;
+
+  for (BHead *bh = blo_bhead_first(fd); bh; bh = blo_bhead_next(fd, bh)) {
+    if (bh->code == ENDB) {
+      break;
+    }
+    if (!read_struct_needs_reconstruct(fd, bh)) {
+      continue;
+    }
+
+    BHead *bh_data = bh;
+#ifdef USE_BHEAD_READ_ON_DEMAND
+    if ((BHEADN_FROM_BHEAD(bh)->has_data == false) &&
+        (fd->flags & FD_FLAGS_SWITCH_ENDIAN) == 0 && blo_bhead_data_mapped(fd, bh)) {
+      /* Memory mapped files are read in place from all threads. */
+      bh_data = NULL;
+    }
+    else if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
+      /* File access is sequential, only the reconstruction itself is threaded. */
+      bh_data = blo_bhead_read_full(fd, bh);
+      if (UNLIKELY(bh_data == NULL)) {
+        /* Leave the remaining blocks to #read_struct which reports the error. */
+        break;
+      }
+      batch_size += (size_t)bh->len;
+    }
+#endif
+    data.bheads[batch_len] = bh;
+    data.bheads_data[batch_len] = bh_data;
+    batch_len++;
+
+    if (batch_size >= RECONSTRUCT_BATCH_SIZE) {
+      read_struct_reconstruct_batch(&data, batch_len);
+      batch_len = 0;
+      batch_size = 0;
+    }
+  }
+
+  if (batch_len != 0) {
+    read_struct_reconstruct_batch(&data, batch_len);
+  }
+
+#ifdef USE_BHEAD_READ_ON_DEMAND
+  if (fd->mmap_file != NULL && !blo_bhead_data_mapped_is_valid(fd)) {
+    /* Some of the results may be zeroed memory, let #read_struct report the errors. */
+    for (BHead *bh = blo_bhead_first(fd); bh; bh = blo_bhead_next(fd, bh)) {
+      if (bh->code == ENDB) {
+        break;
+      }
+      MEM_SAFE_FREE(BHEADN_FROM_BHEAD(bh)->data_reconstructed);
+    }
+  }
+#endif
+
+  MEM_freeN(data.bheads);
+  MEM_freeN(data.bheads_data);
+}
+
+#undef RECONSTRUCT_BATCH_SIZE
+
 static void link_glob_list(FileData *fd, ListBase *lb) /* for glob data */
 {
   Link *ln, *prev;
@@ -3318,6 +3965,13 @@ static BHead *read_data_into_datamap(FileData *fd, BHead *bhead, const char *all
 {
   bhead = blo_bhead_next(fd, bhead);
 
+  /* Size the map for all data-blocks at once, instead of growing it while reading. */
+  int data_len = 0;
+  for (BHead *bh = bhead; bh && bh->code == DATA; bh = blo_bhead_next(fd, bh)) {
+    data_len++;
+  }
+  oldnewmap_reserve(fd->datamap, fd->datamap->nentries + data_len);
+
   while (bhead && bhead->code == DATA) {
     /* The code below is useful for debugging leaks in data read from the blend file.
      * Without this the messages only tell us what ID-type the memory came from,
@@ -3609,6 +4263,21 @@ static BHead *read_libblock(FileData *fd,
     }
   }
 
+  /* Statistics of the ID type, placeholders aren't accounted for. */
+  BlendReadStatsIDType *stats_type = NULL;
+  double stats_time_start = 0.0;
+  uint64_t stats_bytes_start = 0;
+  int stats_reconstructed_start = 0;
+  if ((fd->stats != NULL) && (bhead->code != ID_LINK_PLACEHOLDER)) {
+    const int index = BKE_idtype_idcode_to_index(bhead->code);
+    if (index >= 0) {
+      stats_type = &fd->stats->id_types[index];
+      stats_time_start = PIL_check_seconds_timer();
+      stats_bytes_start = fd->stats->stats.bytes;
+      stats_reconstructed_start = fd->stats->stats.structs_reconstructed;
+    }
+  }
+
   /* Read libblock struct. */
   ID *id = read_struct(fd, bhead, "lib block");
   if (id == NULL) {
@@ -3688,6 +4357,16 @@ static BHead *read_libblock(FileData *fd,
     read_libblock_undo_restore_at_old_address(fd, main, id, id_old);
   }
 
+  if (stats_type != NULL) {
+    BlendReadStats *stats = &fd->stats->stats;
+    stats_type->idcode = idcode;
+    stats_type->ids_len++;
+    stats_type->bytes += stats->bytes - stats_bytes_start;
+    stats_type->structs_reconstructed += stats->structs_reconstructed - stats_reconstructed_start;
+    stats_type->time += PIL_check_seconds_timer() - stats_time_start;
+    stats->ids_len++;
+  }
+
   return bhead;
 }
 
@@ -3801,6 +4480,8 @@ static void do_versions(FileData *fd, Library *lib, Main *main)
 {
   /* WATCH IT!!!: pointers from libdata have not been converted */
 
+  const double time_start = PIL_check_seconds_timer();
+
   /* Don't allow versioning to create new data-blocks. */
   main->is_locked_for_linking = true;
 
@@ -3837,6 +4518,10 @@ static void do_versions(FileData *fd, Library *lib, Main *main)
   /* don't forget to set version number in BKE_blender_version.h! */
 
   main->is_locked_for_linking = false;
+
+  if (fd->stats != NULL) {
+    fd->stats->stats.time_versioning += PIL_check_seconds_timer() - time_start;
+  }
 }
 
 static void do_versions_after_linking(Main *main, ReportList *reports)
@@ -3865,6 +4550,7 @@ static void do_versions_after_linking(Main *main, ReportList *reports)
 
 static void lib_link_all(FileData *fd, Main *bmain)
 {
+  const double time_start = PIL_check_seconds_timer();
   const bool do_partial_undo = (fd->skip_flags & BLO_READ_SKIP_UNDO_OLD_MAIN) == 0;
 
   BlendLibReader reader = {fd, bmain};
@@ -3935,6 +4621,10 @@ static void lib_link_all(FileData *fd, Main *bmain)
   }
   FOREACH_MAIN_ID_END;
 #endif
+
+  if (fd->stats != NULL) {
+    fd->stats->stats.time_lib_link += PIL_check_seconds_timer() - time_start;
+  }
 }
 
 /** \} */
@@ -4067,6 +4757,10 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     BLI_strncpy(bfd->main->name, filepath, sizeof(bfd->main->name));
   }
 
+  if ((fd->memfile == NULL) && (fd->skip_flags & BLO_READ_SKIP_DATA) == 0) {
+    fd->stats = read_stats_new(filepath);
+  }
+
   if (G.background) {
     /* We only read & store .blend thumbnail in background mode
      * (because we cannot re-generate it, no OpenGL available).
@@ -4089,6 +4783,13 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     }
   }
 
+  /* Undo steps share the current DNA, so there is nothing to reconstruct there. */
+  if (fd->memfile == NULL && (fd->skip_flags & BLO_READ_SKIP_DATA) == 0) {
+    const double time_start = PIL_check_seconds_timer();
+    read_struct_reconstruct_all(fd);
+    fd->stats->stats.time_reconstruct = PIL_check_seconds_timer() - time_start;
+  }
+
   while (bhead) {
     switch (bhead->code) {
       case DATA:
@@ -4152,7 +4853,11 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
   }
 
   if ((fd->skip_flags & BLO_READ_SKIP_DATA) == 0) {
+    const double time_libraries_start = PIL_check_seconds_timer();
     read_libraries(fd, &mainlist);
+    if (fd->stats != NULL) {
+      fd->stats->stats.time_libraries = PIL_check_seconds_timer() - time_libraries_start;
+    }
 
     blo_join_main(&mainlist);
 
@@ -4170,12 +4875,14 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
       BKE_main_id_refcount_recompute(bfd->main, false);
 
       /* Yep, second splitting... but this is a very cheap operation, so no big deal. */
+      const double time_versioning_start = PIL_check_seconds_timer();
       blo_split_main(&mainlist, bfd->main);
       LISTBASE_FOREACH (Main *, mainvar, &mainlist) {
         BLI_assert(mainvar->versionfile != 0);
         do_versions_after_linking(mainvar, fd->reports);
       }
       blo_join_main(&mainlist);
+      fd->stats->stats.time_versioning += PIL_check_seconds_timer() - time_versioning_start;
 
       /* And we have to compute those user-reference-counts again, as `do_versions_after_linking()`
        * does not always properly handle user counts, and/or that function does not take into
@@ -4207,6 +4914,11 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
 
   fd->mainlist = NULL; /* Safety, this is local variable, shall not be used afterward. */
 
+  if (fd->stats != NULL) {
+    read_stats_finish(fd->stats);
+    fd->stats = NULL;
+  }
+
   return bfd;
 }
 
@@ -5342,7 +6054,8 @@ static void read_library_clear_weak_links(FileData *basefd, ListBase *mainlist,
 static FileData *read_library_file_data(FileData *basefd,
                                         ListBase *mainlist,
                                         Main *mainl,
-                                        Main *mainptr)
+                                        Main *mainptr,
+                                        FileData *fd_opened)
 {
   FileData *fd = mainptr->curlib->filedata;
 
@@ -5373,7 +6086,9 @@ static FileData *read_library_file_data(FileData *basefd,
                      mainptr->curlib->filepath_abs,
                      mainptr->curlib->filepath,
                      library_parent_filepath(mainptr->curlib));
-    fd = blo_filedata_from_file(mainptr->curlib->filepath_abs, basefd->reports);
+    fd = (fd_opened != NULL) ? fd_opened :
+                               blo_filedata_from_file(mainptr->curlib->filepath_abs,
+                                                      basefd->reports);
   }
 
   if (fd) {
@@ -5397,7 +6112,9 @@ static FileData *read_library_file_data(FileData *basefd,
     /* subversion */
     read_file_version(fd, mainptr);
 #ifdef USE_GHASH_BHEAD
-    read_file_bhead_idname_map_create(fd);
+    if (fd->bhead_idname_hash == NULL) {
+      read_file_bhead_idname_map_create(fd);
+    }
 #endif
   }
   else {
@@ -5416,6 +6133,86 @@ static FileData *read_library_file_data(FileData *basefd,
   return fd;
 }
 
+typedef struct LibraryOpenTaskData {
+  Main **mains;
+  FileData **fds;
+} LibraryOpenTaskData;
+
+static void read_libraries_open_fn(void *__restrict userdata,
+                                   const int index,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LibraryOpenTaskData *data = userdata;
+  Library *lib = data->mains[index]->curlib;
+
+  /* No reports from threads, failures are reported when opening again from the main thread. */
+  FileData *fd = blo_filedata_from_file(lib->filepath_abs, NULL);
+#ifdef USE_GHASH_BHEAD
+  if (fd != NULL) {
+    /* Reads all block headers, which is most of the waiting on slow (network) storage. */
+    read_file_bhead_idname_map_create(fd);
+  }
+#endif
+  data->fds[index] = fd;
+}
+
+/**
+ * Open the files of all libraries in \a mainlist which have linked data-blocks to read but no
+ * #FileData yet, on multiple threads. Only the file access and header reading is done here,
+ * the (shared) Main database isn't touched.
+ *
+ * \return An array of #FileData matching the \a r_mains_len mains after \a mainl,
+ * NULL entries are opened as usual by #read_library_file_data.
+ */
+static FileData **read_libraries_open_all(Main *mainl, int *r_mains_len)
+{
+  int mains_len = 0;
+  for (Main *mainptr = mainl->next; mainptr; mainptr = mainptr->next) {
+    mains_len++;
+  }
+  *r_mains_len = mains_len;
+  if (mains_len == 0) {
+    return NULL;
+  }
+
+  FileData **fds = MEM_calloc_arrayN(mains_len, sizeof(*fds), __func__);
+  Main **mains = MEM_malloc_arrayN(mains_len, sizeof(*mains), __func__);
+  int *mains_index = MEM_malloc_arrayN(mains_len, sizeof(*mains_index), __func__);
+  int open_len = 0;
+
+  int i = 0;
+  for (Main *mainptr = mainl->next; mainptr; mainptr = mainptr->next, i++) {
+    Library *lib = mainptr->curlib;
+    if ((lib->filedata == NULL) && (lib->packedfile == NULL) && BLI_exists(lib->filepath_abs) &&
+        has_linked_ids_to_read(mainptr)) {
+      mains[open_len] = mainptr;
+      mains_index[open_len] = i;
+      open_len++;
+    }
+  }
+
+  if (open_len > 1) {
+    FileData **fds_opened = MEM_calloc_arrayN(open_len, sizeof(*fds_opened), __func__);
+    LibraryOpenTaskData data = {
+        .mains = mains,
+        .fds = fds_opened,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1;
+    BLI_task_parallel_range(0, open_len, &data, read_libraries_open_fn, &settings);
+
+    for (i = 0; i < open_len; i++) {
+      fds[mains_index[i]] = fds_opened[i];
+    }
+    MEM_freeN(fds_opened);
+  }
+
+  MEM_freeN(mains);
+  MEM_freeN(mains_index);
+  return fds;
+}
+
 static void read_libraries(FileData *basefd, ListBase *mainlist)
 {
   Main *mainl = mainlist->first;
@@ -5434,9 +6231,20 @@ static void read_libraries(FileData *basefd, ListBase *mainlist)
   while (do_it) {
     do_it = false;
 
+    /* Libraries are independent files, wait for their I/O in parallel. */
+    int fds_opened_len;
+    FileData **fds_opened = read_libraries_open_all(mainl, &fds_opened_len);
+
     /* Loop over mains of all library blend files encountered so far. Note
      * this list gets longer as more indirectly library blends are found. */
-    for (Main *mainptr = mainl->next; mainptr; mainptr = mainptr->next) {
+    int i = 0;
+    for (Main *mainptr = mainl->next; mainptr; mainptr = mainptr->next, i++) {
+      /* Opened ahead of time, only for the mains which existed before this loop. */
+      FileData *fd_opened = NULL;
+      if (i < fds_opened_len) {
+        SWAP(FileData *, fd_opened, fds_opened[i]);
+      }
+
       /* Does this library have any more linked data-blocks we need to read? */
       if (has_linked_ids_to_read(mainptr)) {
 #if 0
@@ -5444,11 +6252,15 @@ static void read_libraries(FileData *basefd, ListBase *mainlist)
           mainptr->curlib->id.name,
           mainptr->curlib->filepath);
 #endif
+        const double stats_time_start = PIL_check_seconds_timer();
+        const uint64_t stats_bytes_start = basefd->stats ? basefd->stats->stats.bytes : 0;
+        const int stats_ids_start = basefd->stats ? basefd->stats->stats.ids_len : 0;
 
         /* Open file if it has not been done yet. */
-        FileData *fd = read_library_file_data(basefd, mainlist, mainl, mainptr);
+        FileData *fd = read_library_file_data(basefd, mainlist, mainl, mainptr, fd_opened);
 
         if (fd) {
+          fd->stats = basefd->stats;
           do_it = true;
         }
 
@@ -5459,8 +6271,22 @@ static void read_libraries(FileData *basefd, ListBase *mainlist)
         /* Test if linked data-locks need to read further linked data-locks
          * and create link placeholders for them. */
         BLO_expand_main(fd, mainptr);
+
+        if (basefd->stats != NULL) {
+          BlendReadStats *stats = &basefd->stats->stats;
+          BlendReadStatsLibrary *stats_lib = read_stats_library_ensure(basefd->stats,
+                                                                       mainptr->curlib);
+          stats_lib->ids_len += stats->ids_len - stats_ids_start;
+          stats_lib->bytes += stats->bytes - stats_bytes_start;
+          stats_lib->time += PIL_check_seconds_timer() - stats_time_start;
+        }
+      }
+      else if (fd_opened != NULL) {
+        blo_filedata_free(fd_opened);
       }
     }
+
+    MEM_SAFE_FREE(fds_opened);
   }
 
   Main *main_newid = BKE_main_new();
@@ -42,6 +42,7 @@ struct OldNewMap;
 struct ReportList;
 struct UserDef;
 struct BLI_mmap_file;
+struct BlendFrameReader;
 
 typedef struct IDNameLib_Map IDNameLib_Map;
 
@@ -70,6 +71,28 @@ typedef ssize_t(FileDataReadFn)(struct FileData *filedata,
                                 bool *r_is_memchunk_identical);
 typedef off64_t(FileDataSeekFn)(struct FileData *filedata, off64_t offset, int whence);
 
+/**
+ * Compressed files are written as a sequence of independent gzip members ("frames"),
+ * each holding #BLEND_FRAME_SIZE bytes of the uncompressed file (the last one may be smaller).
+ * They are followed by one more gzip member holding the compressed size of every frame
+ * (little endian `uint32_t`) and ending with this footer, stored without compression so it
+ * can be found right before the 8 byte gzip trailer at the end of the file.
+ *
+ * Since concatenated gzip members are a valid gzip stream, such files can still be read
+ * sequentially. The seek table allows random access without decompressing the whole file.
+ */
+typedef struct BlendFrameFooter {
+  /** File offset of the gzip member holding the seek table. */
+  uint64_t table_offset;
+  uint32_t frames_len;
+  /** Uncompressed size of each frame. */
+  uint32_t frame_size;
+  char magic[8];
+} BlendFrameFooter;
+
+#define BLEND_FRAME_MAGIC "BLFRAME1"
+#define BLEND_FRAME_SIZE (1 << 20)
+
 typedef struct FileData {
   /** Linked list of BHeadN's. */
   ListBase bhead_list;
@@ -97,6 +120,8 @@ typedef struct FileData {
   gzFile gzfiledes;
   /** Gzip stream for memory decompression. */
   z_stream strm;
+  /** Random access reading of compressed files with a seek table, see #BlendFrameFooter. */
+  struct BlendFrameReader *frame_reader;
 
   /** Now only in use for library appending. */
   char relabase[FILE_MAX];
@@ -137,6 +162,9 @@ typedef struct FileData {
   ListBase *old_mainlist;
   struct IDNameLib_Map *old_idmap;
 
+  /** Load statistics, NULL for undo. Shared with the #FileData of linked libraries. */
+  struct ReadStats *stats;
+
   struct ReportList *reports;
 } FileData;
 
@@ -192,6 +192,41 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   }
 }
 
+/**
+ * Add the chunks written for an ID by the reference (previous) undo step again,
+ * sharing their memory, instead of writing and comparing the ID.
+ *
+ * \return false when the reference step has no data for this ID, it must be written then.
+ */
+bool BLO_memfile_chunk_reuse_id(MemFileWriteData *mem_data, uint id_session_uuid)
+{
+  if (mem_data->id_session_uuid_mapping == NULL) {
+    return false;
+  }
+  MemFileChunk *compchunk = BLI_ghash_lookup(mem_data->id_session_uuid_mapping,
+                                             POINTER_FROM_UINT(id_session_uuid));
+  if (compchunk == NULL) {
+    return false;
+  }
+
+  MemFile *memfile = mem_data->written_memfile;
+  for (; compchunk != NULL && compchunk->id_session_uuid == id_session_uuid;
+       compchunk = compchunk->next) {
+    MemFileChunk *curchunk = MEM_mallocN(sizeof(MemFileChunk), "MemFileChunk");
+    curchunk->size = compchunk->size;
+    curchunk->buf = compchunk->buf;
+    curchunk->is_identical = true;
+    curchunk->is_identical_future = true;
+    curchunk->id_session_uuid = id_session_uuid;
+    BLI_addtail(&memfile->chunks, curchunk);
+
+    compchunk->is_identical_future = true;
+  }
+
+  mem_data->reference_current_chunk = compchunk;
+  return true;
+}
+
 struct Main *BLO_memfile_main_get(struct MemFile *memfile,
                                   struct Main *bmain,
                                   struct Scene **r_scene)
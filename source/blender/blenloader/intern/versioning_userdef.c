@@ -848,6 +848,9 @@ void blo_do_versions_userdef(UserDef *userdef)
     if (userdef->gizmo_size_navigate_v3d == 0) {
       userdef->gizmo_size_navigate_v3d = 80;
     }
+    if (userdef->compositor_cache_limit == 0) {
+      userdef->compositor_cache_limit = 1024;
+    }
   }
 
   LISTBASE_FOREACH (bTheme *, btheme, &userdef->themes) {
@@ -100,7 +100,10 @@
 
 #include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
+#include "BLI_endian_switch.h"
 #include "BLI_mempool.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 #include "MEM_guardedalloc.h" /* MEM_freeN */
 
 #include "BKE_blender_version.h"
@@ -162,7 +165,7 @@ struct WriteWrap {
   /* internal */
   union {
     int file_handle;
-    gzFile gz_handle;
+    struct WriteWrapFrames *frames;
   } _user_data;
 };
 
@@ -192,31 +195,276 @@ static size_t ww_write_none(WriteWrap *ww, const char *buf, size_t buf_len)
 }
 #undef FILE_HANDLE
 
-/* zlib */
-#define FILE_HANDLE(ww) (ww)->_user_data.gz_handle
+/* zlib, written as independent frames followed by a seek table, see #BlendFrameFooter.
+ * Frames are compressed on worker threads in batches, while the next batch is being filled. */
+
+/* Compression level and gzip wrapper, matching previous `gzopen(filepath, "wb1")` output. */
+#define FRAME_DEFLATE_INIT(strm) \
+  deflateInit2(strm, 1, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY)
+
+/** Upper bound of frames per batch, there are two batches of (compressed) frames in memory. */
+#define FRAME_BATCH_LEN_MAX 16
+
+typedef struct WriteWrapFrame {
+  /** Uncompressed data. */
+  uchar *buf;
+  size_t buf_used_len;
+  /** Output of #deflate, allocated for the worst case. */
+  uchar *buf_compressed;
+  size_t compressed_len;
+  bool is_ok;
+} WriteWrapFrame;
+
+typedef struct WriteWrapFrames {
+  int file_handle;
+
+  /** Two batches of #WriteWrapFrames.batch_len frames. */
+  WriteWrapFrame *frames;
+  int batch_len;
+  /** Batch being filled (0 or 1), the other one may be compressing in #WriteWrapFrames.pool. */
+  int batch_fill;
+  /** Number of full frames in the batch being filled. */
+  int batch_fill_len;
+  /** Number of frames of the other batch that are compressing, zero when idle. */
+  int batch_compress_len;
+  size_t buf_compressed_len;
+  TaskPool *pool;
+
+  /** Compressed size of every frame written so far. */
+  uint32_t *frame_sizes;
+  uint frames_len;
+  uint frames_len_alloc;
+  uint64_t file_offset;
+  /** Set when compressing or writing failed. */
+  bool error;
+} WriteWrapFrames;
+
+#define FRAMES(ww) (ww)->_user_data.frames
+
+static bool ww_frames_write_raw(WriteWrapFrames *frames, const void *data, size_t data_len)
+{
+  if (write(frames->file_handle, data, data_len) != (ssize_t)data_len) {
+    return false;
+  }
+  frames->file_offset += data_len;
+  return true;
+}
+
+static void ww_frame_compress_fn(TaskPool *__restrict pool, void *taskdata)
+{
+  WriteWrapFrames *frames = BLI_task_pool_user_data(pool);
+  WriteWrapFrame *frame = taskdata;
+  z_stream strm = {NULL};
+
+  frame->is_ok = false;
+  if (FRAME_DEFLATE_INIT(&strm) != Z_OK) {
+    return;
+  }
+  strm.next_in = frame->buf;
+  strm.avail_in = (uint)frame->buf_used_len;
+  strm.next_out = frame->buf_compressed;
+  strm.avail_out = (uint)frames->buf_compressed_len;
+  if (deflate(&strm, Z_FINISH) == Z_STREAM_END) {
+    frame->compressed_len = frames->buf_compressed_len - strm.avail_out;
+    frame->is_ok = true;
+  }
+  deflateEnd(&strm);
+}
+
+/** Wait for the batch being compressed and write it to the file, in order. */
+static void ww_frames_batch_finish(WriteWrapFrames *frames)
+{
+  if (frames->batch_compress_len == 0) {
+    return;
+  }
+  BLI_task_pool_work_and_wait(frames->pool);
+
+  WriteWrapFrame *batch = &frames->frames[(1 - frames->batch_fill) * frames->batch_len];
+  for (int i = 0; i < frames->batch_compress_len; i++) {
+    WriteWrapFrame *frame = &batch[i];
+    frame->buf_used_len = 0;
+    if (frames->error || !frame->is_ok ||
+        !ww_frames_write_raw(frames, frame->buf_compressed, frame->compressed_len)) {
+      frames->error = true;
+      continue;
+    }
+
+    if (frames->frames_len == frames->frames_len_alloc) {
+      frames->frames_len_alloc = max_uu(64, frames->frames_len_alloc * 2);
+      frames->frame_sizes = MEM_reallocN(
+          frames->frame_sizes, sizeof(*frames->frame_sizes) * frames->frames_len_alloc);
+    }
+    frames->frame_sizes[frames->frames_len++] = (uint32_t)frame->compressed_len;
+  }
+  frames->batch_compress_len = 0;
+}
+
+/**
+ * Start compressing the full frames of the batch being filled (plus a partially filled
+ * last frame when \a use_partial_frame is set), and continue filling the other batch.
+ */
+static void ww_frames_batch_submit(WriteWrapFrames *frames, const bool use_partial_frame)
+{
+  /* The other batch is reused, its frames have to be written first. */
+  ww_frames_batch_finish(frames);
+
+  WriteWrapFrame *batch = &frames->frames[frames->batch_fill * frames->batch_len];
+  int batch_len = frames->batch_fill_len;
+  if (use_partial_frame && batch_len < frames->batch_len && batch[batch_len].buf_used_len != 0) {
+    batch_len++;
+  }
+
+  for (int i = 0; i < batch_len; i++) {
+    BLI_task_pool_push(frames->pool, ww_frame_compress_fn, &batch[i], false, NULL);
+  }
+
+  frames->batch_compress_len = batch_len;
+  frames->batch_fill = 1 - frames->batch_fill;
+  frames->batch_fill_len = 0;
+}
+
+/**
+ * Write the seek table as the last gzip member. It's written by hand using "stored"
+ * (uncompressed) deflate blocks, so the footer ends up right before the gzip trailer.
+ */
+static bool ww_frames_write_table(WriteWrapFrames *frames)
+{
+  BlendFrameFooter footer = {
+      .table_offset = frames->file_offset,
+      .frames_len = frames->frames_len,
+      .frame_size = BLEND_FRAME_SIZE,
+  };
+  memcpy(footer.magic, BLEND_FRAME_MAGIC, sizeof(footer.magic));
+
+  const size_t table_size = sizeof(*frames->frame_sizes) * frames->frames_len;
+  const size_t data_len = table_size + sizeof(footer);
+  uchar *data = MEM_mallocN(data_len, __func__);
+  memcpy(data, frames->frame_sizes, table_size);
+  memcpy(data + table_size, &footer, sizeof(footer));
+  if (ENDIAN_ORDER == B_ENDIAN) {
+    BlendFrameFooter *footer_data = (BlendFrameFooter *)(data + table_size);
+    BLI_endian_switch_uint32_array((uint32_t *)data, (int)frames->frames_len);
+    BLI_endian_switch_uint64(&footer_data->table_offset);
+    BLI_endian_switch_uint32(&footer_data->frames_len);
+    BLI_endian_switch_uint32(&footer_data->frame_size);
+  }
+
+  /* Minimal gzip header: deflate, no flags, no time-stamp, unknown OS. */
+  const uchar header[10] = {0x1f, 0x8b, Z_DEFLATED, 0, 0, 0, 0, 0, 0, 0xff};
+  bool ok = ww_frames_write_raw(frames, header, sizeof(header));
+
+  for (size_t offset = 0; ok && offset < data_len;) {
+    const size_t block_len = MIN2(data_len - offset, 0xffff);
+    const bool is_final = (offset + block_len == data_len);
+    const uchar block_header[5] = {
+        is_final ? 1 : 0,
+        (uchar)(block_len & 0xff),
+        (uchar)(block_len >> 8),
+        (uchar)(~block_len & 0xff),
+        (uchar)((~block_len >> 8) & 0xff),
+    };
+    ok = ww_frames_write_raw(frames, block_header, sizeof(block_header)) &&
+         ww_frames_write_raw(frames, data + offset, block_len);
+    offset += block_len;
+  }
+
+  if (ok) {
+    const uint32_t crc = (uint32_t)crc32(crc32(0, NULL, 0), data, (uint)data_len);
+    const uchar trailer[8] = {
+        (uchar)(crc),
+        (uchar)(crc >> 8),
+        (uchar)(crc >> 16),
+        (uchar)(crc >> 24),
+        (uchar)(data_len),
+        (uchar)(data_len >> 8),
+        (uchar)(data_len >> 16),
+        (uchar)(data_len >> 24),
+    };
+    ok = ww_frames_write_raw(frames, trailer, sizeof(trailer));
+  }
+
+  MEM_freeN(data);
+  return ok;
+}
 
 static bool ww_open_zlib(WriteWrap *ww, const char *filepath)
 {
-  gzFile file;
+  int file = BLI_open(filepath, O_BINARY + O_WRONLY + O_CREAT + O_TRUNC, 0666);
 
-  file = BLI_gzopen(filepath, "wb1");
+  if (file == -1) {
+    return false;
+  }
 
-  if (file != Z_NULL) {
-    FILE_HANDLE(ww) = file;
-    return true;
+  /* Only used to get the worst case compressed size of a frame. */
+  z_stream strm = {NULL};
+  if (FRAME_DEFLATE_INIT(&strm) != Z_OK) {
+    close(file);
+    return false;
   }
 
-  return false;
+  WriteWrapFrames *frames = MEM_callocN(sizeof(*frames), __func__);
+  frames->file_handle = file;
+  frames->buf_compressed_len = deflateBound(&strm, BLEND_FRAME_SIZE);
+  deflateEnd(&strm);
+
+  frames->batch_len = clamp_i(BLI_system_thread_count(), 1, FRAME_BATCH_LEN_MAX);
+  frames->frames = MEM_calloc_arrayN(frames->batch_len * 2, sizeof(*frames->frames), __func__);
+  for (int i = 0; i < frames->batch_len * 2; i++) {
+    frames->frames[i].buf = MEM_mallocN(BLEND_FRAME_SIZE, __func__);
+    frames->frames[i].buf_compressed = MEM_mallocN(frames->buf_compressed_len, __func__);
+  }
+  frames->pool = BLI_task_pool_create(frames, TASK_PRIORITY_HIGH);
+
+  FRAMES(ww) = frames;
+  return true;
 }
 static bool ww_close_zlib(WriteWrap *ww)
 {
-  return (gzclose(FILE_HANDLE(ww)) == Z_OK);
+  WriteWrapFrames *frames = FRAMES(ww);
+
+  ww_frames_batch_submit(frames, true);
+  ww_frames_batch_finish(frames);
+
+  bool ok = !frames->error && ww_frames_write_table(frames);
+  ok &= (close(frames->file_handle) != -1);
+
+  BLI_task_pool_free(frames->pool);
+  for (int i = 0; i < frames->batch_len * 2; i++) {
+    MEM_freeN(frames->frames[i].buf);
+    MEM_freeN(frames->frames[i].buf_compressed);
+  }
+  MEM_freeN(frames->frames);
+  MEM_SAFE_FREE(frames->frame_sizes);
+  MEM_freeN(frames);
+  FRAMES(ww) = NULL;
+  return ok;
 }
 static size_t ww_write_zlib(WriteWrap *ww, const char *buf, size_t buf_len)
 {
-  return gzwrite(FILE_HANDLE(ww), buf, buf_len);
+  WriteWrapFrames *frames = FRAMES(ww);
+  size_t written = 0;
+
+  while (written < buf_len) {
+    WriteWrapFrame *frame =
+        &frames->frames[frames->batch_fill * frames->batch_len + frames->batch_fill_len];
+    const size_t len = MIN2(buf_len - written, BLEND_FRAME_SIZE - frame->buf_used_len);
+    memcpy(frame->buf + frame->buf_used_len, buf + written, len);
+    frame->buf_used_len += len;
+    written += len;
+
+    if (frame->buf_used_len == BLEND_FRAME_SIZE) {
+      frames->batch_fill_len++;
+      if (frames->batch_fill_len == frames->batch_len) {
+        ww_frames_batch_submit(frames, false);
+      }
+    }
+  }
+
+  return frames->error ? 0 : written;
 }
-#undef FILE_HANDLE
+#undef FRAMES
+#undef FRAME_DEFLATE_INIT
+#undef FRAME_BATCH_LEN_MAX
 
 /* --- end compression types --- */
 
@@ -909,6 +1157,37 @@ static void write_thumb(WriteData *wd, const BlendThumbnail *thumb)
 /** \name File Writing (Private)
  * \{ */
 
+/**
+ * Whether \a id wasn't tagged for any update since the last undo push,
+ * so the data written for it by the previous undo step can be used as is.
+ *
+ * \note This relies on all changes being tagged in the dependency graph,
+ * which is why it's an experimental option.
+ */
+static bool write_id_is_unchanged_for_undo(ID *id)
+{
+  /* Interface data-blocks change all the time without any tagging, they are cheap to write. */
+  if (ELEM(GS(id->name), ID_WM, ID_SCR, ID_WS)) {
+    return false;
+  }
+  if (id->recalc_after_undo_push != 0) {
+    return false;
+  }
+
+  bNodeTree *nodetree = ntreeFromID(id);
+  if (nodetree != NULL && nodetree->id.recalc_after_undo_push != 0) {
+    return false;
+  }
+  if (GS(id->name) == ID_SCE) {
+    Scene *scene = (Scene *)id;
+    if (scene->master_collection != NULL &&
+        scene->master_collection->id.recalc_after_undo_push != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
 /* if MemFile * there's filesave to memory */
 static bool write_file_handle(Main *mainvar,
                               WriteWrap *ww,
@@ -948,6 +1227,10 @@ static bool write_file_handle(Main *mainvar,
                                                  NULL :
                                                  BKE_lib_override_library_operations_store_init();
 
+  /* Only possible when there is a previous undo step to take the data from. */
+  const bool use_undo_skip_unchanged = wd->use_memfile && (wd->mem.reference_memfile != NULL) &&
+                                       USER_EXPERIMENTAL_TEST(&U, use_undo_skip_unchanged);
+
 #define ID_BUFFER_STATIC_SIZE 8192
   /* This outer loop allows to save first data-blocks from real mainvar,
    * then the temp ones from override process,
@@ -984,6 +1267,8 @@ static bool write_file_handle(Main *mainvar,
           BKE_lib_override_library_operations_store_start(bmain, override_storage, id);
         }
 
+        const bool reuse_unchanged = use_undo_skip_unchanged && write_id_is_unchanged_for_undo(id);
+
         if (wd->use_memfile) {
           /* Record the changes that happened up to this undo push in
            * recalc_up_to_undo_push, and clear recalc_after_undo_push again
@@ -1006,6 +1291,10 @@ static bool write_file_handle(Main *mainvar,
           }
         }
 
+        if (reuse_unchanged && BLO_memfile_chunk_reuse_id(&wd->mem, id->session_uuid)) {
+          continue;
+        }
+
         mywrite_id_begin(wd, id);
 
         memcpy(id_buffer, id, idtype_struct_size);
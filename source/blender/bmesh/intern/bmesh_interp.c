@@ -819,6 +819,9 @@ static void update_data_blocks(BMesh *bm, CustomData *olddata, CustomData *data)
   BLI_mempool *oldpool = olddata->pool;
   void *block;
 
+  /* Match the layers once, instead of for every element. */
+  CustomDataBMeshCopyMap *copy_map = CustomData_bmesh_copy_map_new(olddata, data, 0);
+
   if (data == &bm->vdata) {
     BMVert *eve;
 
@@ -826,8 +829,8 @@ static void update_data_blocks(BMesh *bm, CustomData *olddata, CustomData *data)
 
     BM_ITER_MESH (eve, &iter, bm, BM_VERTS_OF_MESH) {
       block = NULL;
-      CustomData_bmesh_set_default(data, &block);
-      CustomData_bmesh_copy_data(olddata, data, eve->head.data, &block);
+      CustomData_bmesh_alloc_block(data, &block);
+      CustomData_bmesh_copy_block_with_map(copy_map, eve->head.data, block);
       CustomData_bmesh_free_block(olddata, &eve->head.data);
       eve->head.data = block;
     }
@@ -839,8 +842,8 @@ static void update_data_blocks(BMesh *bm, CustomData *olddata, CustomData *data)
 
     BM_ITER_MESH (eed, &iter, bm, BM_EDGES_OF_MESH) {
       block = NULL;
-      CustomData_bmesh_set_default(data, &block);
-      CustomData_bmesh_copy_data(olddata, data, eed->head.data, &block);
+      CustomData_bmesh_alloc_block(data, &block);
+      CustomData_bmesh_copy_block_with_map(copy_map, eed->head.data, block);
       CustomData_bmesh_free_block(olddata, &eed->head.data);
       eed->head.data = block;
     }
@@ -854,8 +857,8 @@ static void update_data_blocks(BMesh *bm, CustomData *olddata, CustomData *data)
     BM_ITER_MESH (efa, &iter, bm, BM_FACES_OF_MESH) {
       BM_ITER_ELEM (l, &liter, efa, BM_LOOPS_OF_FACE) {
         block = NULL;
-        CustomData_bmesh_set_default(data, &block);
-        CustomData_bmesh_copy_data(olddata, data, l->head.data, &block);
+        CustomData_bmesh_alloc_block(data, &block);
+        CustomData_bmesh_copy_block_with_map(copy_map, l->head.data, block);
         CustomData_bmesh_free_block(olddata, &l->head.data);
         l->head.data = block;
       }
@@ -868,8 +871,8 @@ static void update_data_blocks(BMesh *bm, CustomData *olddata, CustomData *data)
 
     BM_ITER_MESH (efa, &iter, bm, BM_FACES_OF_MESH) {
       block = NULL;
-      CustomData_bmesh_set_default(data, &block);
-      CustomData_bmesh_copy_data(olddata, data, efa->head.data, &block);
+      CustomData_bmesh_alloc_block(data, &block);
+      CustomData_bmesh_copy_block_with_map(copy_map, efa->head.data, block);
       CustomData_bmesh_free_block(olddata, &efa->head.data);
       efa->head.data = block;
     }
@@ -879,6 +882,8 @@ static void update_data_blocks(BMesh *bm, CustomData *olddata, CustomData *data)
     BLI_assert(0);
   }
 
+  CustomData_bmesh_copy_map_free(copy_map);
+
   if (oldpool) {
     /* this should never happen but can when dissolve fails - T28960. */
     BLI_assert(data->pool != oldpool);
@@ -81,6 +81,7 @@
 #include "BLI_alloca.h"
 #include "BLI_listbase.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.h"
 
 #include "BKE_customdata.h"
 #include "BKE_mesh.h"
@@ -176,6 +177,129 @@ static BMFace *bm_face_create_from_mpoly(
   return BM_face_create(bm, verts, edges, mp->totloop, NULL, BM_CREATE_SKIP_CD);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Mesh to BMesh Element Data Copy
+ *
+ * Creating the elements and linking their topology allocates from the BMesh memory pools, which
+ * has to happen on one thread. Filling in the custom-data blocks (allocated along with the
+ * elements) and calculating face normals only touches the element itself, so that is done
+ * afterwards, in parallel.
+ * \{ */
+
+typedef struct BMFromMeshData {
+  BMesh *bm;
+  const Mesh *me;
+  const struct BMeshFromMeshParams *params;
+  BMVert **vtable;
+  BMEdge **etable;
+  /* NULL for faces which were skipped because of bad topology. */
+  BMFace **ftable;
+  int cd_vert_bweight_offset;
+  int cd_edge_bweight_offset;
+  int cd_edge_crease_offset;
+  int cd_shape_key_offset;
+  int cd_shape_keyindex_offset;
+  const float (**shape_key_table)[3];
+  int tot_shape_keys;
+} BMFromMeshData;
+
+static void bm_from_me_verts_task(void *__restrict userdata,
+                                  const int i,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BMFromMeshData *data = userdata;
+  BMesh *bm = data->bm;
+  const Mesh *me = data->me;
+  BMVert *v = data->vtable[i];
+
+  /* Copy Custom Data */
+  CustomData_to_bmesh_block(&me->vdata, &bm->vdata, i, &v->head.data, true);
+
+  if (data->cd_vert_bweight_offset != -1) {
+    BM_ELEM_CD_SET_FLOAT(v, data->cd_vert_bweight_offset, (float)me->mvert[i].bweight / 255.0f);
+  }
+
+  /* Set shape key original index. */
+  if (data->cd_shape_keyindex_offset != -1) {
+    BM_ELEM_CD_SET_INT(v, data->cd_shape_keyindex_offset, i);
+  }
+
+  /* Set shape-key data. */
+  if (data->tot_shape_keys) {
+    float(*co_dst)[3] = BM_ELEM_CD_GET_VOID_P(v, data->cd_shape_key_offset);
+    for (int j = 0; j < data->tot_shape_keys; j++, co_dst++) {
+      copy_v3_v3(*co_dst, data->shape_key_table[j][i]);
+    }
+  }
+}
+
+static void bm_from_me_edges_task(void *__restrict userdata,
+                                  const int i,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BMFromMeshData *data = userdata;
+  BMesh *bm = data->bm;
+  const Mesh *me = data->me;
+  BMEdge *e = data->etable[i];
+  const MEdge *medge = &me->medge[i];
+
+  /* Copy Custom Data */
+  CustomData_to_bmesh_block(&me->edata, &bm->edata, i, &e->head.data, true);
+
+  if (data->cd_edge_bweight_offset != -1) {
+    BM_ELEM_CD_SET_FLOAT(e, data->cd_edge_bweight_offset, (float)medge->bweight / 255.0f);
+  }
+  if (data->cd_edge_crease_offset != -1) {
+    BM_ELEM_CD_SET_FLOAT(e, data->cd_edge_crease_offset, (float)medge->crease / 255.0f);
+  }
+}
+
+static void bm_from_me_faces_task(void *__restrict userdata,
+                                  const int i,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BMFromMeshData *data = userdata;
+  BMesh *bm = data->bm;
+  const Mesh *me = data->me;
+  BMFace *f = data->ftable[i];
+  if (f == NULL) {
+    return;
+  }
+
+  BMLoop *l_iter, *l_first;
+  int j = me->mpoly[i].loopstart;
+  l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+  do {
+    /* Save index of corresponding #MLoop. */
+    CustomData_to_bmesh_block(&me->ldata, &bm->ldata, j++, &l_iter->head.data, true);
+  } while ((l_iter = l_iter->next) != l_first);
+
+  /* Copy Custom Data */
+  CustomData_to_bmesh_block(&me->pdata, &bm->pdata, i, &f->head.data, true);
+
+  if (data->params->calc_face_normal) {
+    BM_face_normal_update(f);
+  }
+}
+
+static void bm_from_me_elems_data_copy(BMFromMeshData *data)
+{
+  const Mesh *me = data->me;
+  TaskParallelSettings settings;
+
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = me->totvert >= BM_OMP_LIMIT;
+  BLI_task_parallel_range(0, me->totvert, data, bm_from_me_verts_task, &settings);
+
+  settings.use_threading = me->totedge >= BM_OMP_LIMIT;
+  BLI_task_parallel_range(0, me->totedge, data, bm_from_me_edges_task, &settings);
+
+  settings.use_threading = me->totpoly >= BM_OMP_LIMIT;
+  BLI_task_parallel_range(0, me->totpoly, data, bm_from_me_faces_task, &settings);
+}
+
+/** \} */
+
 /**
  * \brief Mesh -> BMesh
  * \param bm: The mesh to write into, while this is typically a newly created BMesh,
@@ -346,25 +470,8 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshPar
 
     normal_short_to_float_v3(v->no, mvert->no);
 
-    /* Copy Custom Data */
-    CustomData_to_bmesh_block(&me->vdata, &bm->vdata, i, &v->head.data, true);
-
-    if (cd_vert_bweight_offset != -1) {
-      BM_ELEM_CD_SET_FLOAT(v, cd_vert_bweight_offset, (float)mvert->bweight / 255.0f);
-    }
-
-    /* Set shape key original index. */
-    if (cd_shape_keyindex_offset != -1) {
-      BM_ELEM_CD_SET_INT(v, cd_shape_keyindex_offset, i);
-    }
-
-    /* Set shape-key data. */
-    if (tot_shape_keys) {
-      float(*co_dst)[3] = BM_ELEM_CD_GET_VOID_P(v, cd_shape_key_offset);
-      for (int j = 0; j < tot_shape_keys; j++, co_dst++) {
-        copy_v3_v3(*co_dst, shape_key_table[j][i]);
-      }
-    }
+    /* Custom-data is copied in parallel below, only allocate from the pool here. */
+    CustomData_bmesh_alloc_block(&bm->vdata, &v->head.data);
   }
   if (is_new) {
     bm->elem_index_dirty &= ~BM_VERT; /* Added in order, clear dirty flag. */
@@ -386,24 +493,13 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshPar
       BM_edge_select_set(bm, e, true);
     }
 
-    /* Copy Custom Data */
-    CustomData_to_bmesh_block(&me->edata, &bm->edata, i, &e->head.data, true);
-
-    if (cd_edge_bweight_offset != -1) {
-      BM_ELEM_CD_SET_FLOAT(e, cd_edge_bweight_offset, (float)medge->bweight / 255.0f);
-    }
-    if (cd_edge_crease_offset != -1) {
-      BM_ELEM_CD_SET_FLOAT(e, cd_edge_crease_offset, (float)medge->crease / 255.0f);
-    }
+    CustomData_bmesh_alloc_block(&bm->edata, &e->head.data);
   }
   if (is_new) {
     bm->elem_index_dirty &= ~BM_EDGE; /* Added in order, clear dirty flag. */
   }
 
-  /* Only needed for selection. */
-  if (me->mselect && me->totselect != 0) {
-    ftable = MEM_mallocN(sizeof(BMFace **) * me->totpoly, __func__);
-  }
+  ftable = MEM_mallocN(sizeof(BMFace **) * me->totpoly, __func__);
 
   mloop = me->mloop;
   mp = me->mpoly;
@@ -411,10 +507,7 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshPar
     BMLoop *l_iter;
     BMLoop *l_first;
 
-    f = bm_face_create_from_mpoly(mp, mloop + mp->loopstart, bm, vtable, etable);
-    if (ftable != NULL) {
-      ftable[i] = f;
-    }
+    f = ftable[i] = bm_face_create_from_mpoly(mp, mloop + mp->loopstart, bm, vtable, etable);
 
     if (UNLIKELY(f == NULL)) {
       printf(
@@ -442,27 +535,39 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshPar
       bm->act_face = f;
     }
 
-    int j = mp->loopstart;
     l_iter = l_first = BM_FACE_FIRST_LOOP(f);
     do {
       /* Don't use 'j' since we may have skipped some faces, hence some loops. */
       BM_elem_index_set(l_iter, totloops++); /* set_ok */
 
-      /* Save index of corresponding #MLoop. */
-      CustomData_to_bmesh_block(&me->ldata, &bm->ldata, j++, &l_iter->head.data, true);
+      CustomData_bmesh_alloc_block(&bm->ldata, &l_iter->head.data);
     } while ((l_iter = l_iter->next) != l_first);
 
-    /* Copy Custom Data */
-    CustomData_to_bmesh_block(&me->pdata, &bm->pdata, i, &f->head.data, true);
-
-    if (params->calc_face_normal) {
-      BM_face_normal_update(f);
-    }
+    CustomData_bmesh_alloc_block(&bm->pdata, &f->head.data);
   }
   if (is_new) {
     bm->elem_index_dirty &= ~(BM_FACE | BM_LOOP); /* Added in order, clear dirty flag. */
   }
 
+  {
+    BMFromMeshData data = {
+        .bm = bm,
+        .me = me,
+        .params = params,
+        .vtable = vtable,
+        .etable = etable,
+        .ftable = ftable,
+        .cd_vert_bweight_offset = cd_vert_bweight_offset,
+        .cd_edge_bweight_offset = cd_edge_bweight_offset,
+        .cd_edge_crease_offset = cd_edge_crease_offset,
+        .cd_shape_key_offset = cd_shape_key_offset,
+        .cd_shape_keyindex_offset = cd_shape_keyindex_offset,
+        .shape_key_table = shape_key_table,
+        .tot_shape_keys = tot_shape_keys,
+    };
+    bm_from_me_elems_data_copy(&data);
+  }
+
   /* -------------------------------------------------------------------- */
   /* MSelect clears the array elements (avoid adding multiple times).
    *
@@ -499,9 +604,7 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshPar
 
   MEM_freeN(vtable);
   MEM_freeN(etable);
-  if (ftable) {
-    MEM_freeN(ftable);
-  }
+  MEM_freeN(ftable);
 }
 
 /**
@@ -586,12 +689,159 @@ BLI_INLINE void bmesh_quick_edgedraw_flag(MEdge *med, BMEdge *e)
  *
  * \param bmain: May be NULL in case \a calc_object_remap parameter option is not set.
  */
+/* -------------------------------------------------------------------- */
+/** \name BMesh to Mesh Element Copy
+ *
+ * Vertices, edges and faces are copied in parallel, using the element tables. Every element only
+ * writes its own index, and the mesh element and custom-data at that index. Edges read the
+ * vertex indices and faces read both, so the element types are still copied one after another.
+ * \{ */
+
+typedef struct BMToMeshData {
+  BMesh *bm;
+  Mesh *me;
+  int cd_vert_bweight_offset;
+  int cd_edge_bweight_offset;
+  int cd_edge_crease_offset;
+  /* Index of the first loop of every face. */
+  int *face_loopstart;
+} BMToMeshData;
+
+static void bm_to_me_verts_task(void *__restrict userdata,
+                                const int i,
+                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BMToMeshData *data = userdata;
+  BMesh *bm = data->bm;
+  Mesh *me = data->me;
+  BMVert *v = bm->vtable[i];
+  MVert *mvert = &me->mvert[i];
+
+  copy_v3_v3(mvert->co, v->co);
+  normal_float_to_short_v3(mvert->no, v->no);
+
+  mvert->flag = BM_vert_flag_to_mflag(v);
+
+  BM_elem_index_set(v, i); /* set_inline */
+
+  /* Copy over custom-data. */
+  CustomData_from_bmesh_block(&bm->vdata, &me->vdata, v->head.data, i);
+
+  if (data->cd_vert_bweight_offset != -1) {
+    mvert->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(v, data->cd_vert_bweight_offset);
+  }
+
+  BM_CHECK_ELEMENT(v);
+}
+
+static void bm_to_me_edges_task(void *__restrict userdata,
+                                const int i,
+                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BMToMeshData *data = userdata;
+  BMesh *bm = data->bm;
+  Mesh *me = data->me;
+  BMEdge *e = bm->etable[i];
+  MEdge *med = &me->medge[i];
+
+  med->v1 = BM_elem_index_get(e->v1);
+  med->v2 = BM_elem_index_get(e->v2);
+
+  med->flag = BM_edge_flag_to_mflag(e);
+
+  BM_elem_index_set(e, i); /* set_inline */
+
+  /* Copy over custom-data. */
+  CustomData_from_bmesh_block(&bm->edata, &me->edata, e->head.data, i);
+
+  bmesh_quick_edgedraw_flag(med, e);
+
+  if (data->cd_edge_crease_offset != -1) {
+    med->crease = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, data->cd_edge_crease_offset);
+  }
+  if (data->cd_edge_bweight_offset != -1) {
+    med->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, data->cd_edge_bweight_offset);
+  }
+
+  BM_CHECK_ELEMENT(e);
+}
+
+static void bm_to_me_faces_task(void *__restrict userdata,
+                                const int i,
+                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BMToMeshData *data = userdata;
+  BMesh *bm = data->bm;
+  Mesh *me = data->me;
+  BMFace *f = bm->ftable[i];
+  MPoly *mpoly = &me->mpoly[i];
+  int j = data->face_loopstart[i];
+  BMLoop *l_iter, *l_first;
+
+  mpoly->loopstart = j;
+  mpoly->totloop = f->len;
+  mpoly->mat_nr = f->mat_nr;
+  mpoly->flag = BM_face_flag_to_mflag(f);
+
+  BM_elem_index_set(f, i); /* set_inline */
+
+  l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+  do {
+    MLoop *mloop = &me->mloop[j];
+    mloop->e = BM_elem_index_get(l_iter->e);
+    mloop->v = BM_elem_index_get(l_iter->v);
+
+    /* Copy over custom-data. */
+    CustomData_from_bmesh_block(&bm->ldata, &me->ldata, l_iter->head.data, j);
+
+    j++;
+    BM_CHECK_ELEMENT(l_iter);
+    BM_CHECK_ELEMENT(l_iter->e);
+    BM_CHECK_ELEMENT(l_iter->v);
+  } while ((l_iter = l_iter->next) != l_first);
+
+  /* Copy over custom-data. */
+  CustomData_from_bmesh_block(&bm->pdata, &me->pdata, f->head.data, i);
+
+  BM_CHECK_ELEMENT(f);
+}
+
+static void bm_to_me_elems_copy(BMToMeshData *data)
+{
+  BMesh *bm = data->bm;
+  TaskParallelSettings settings;
+
+  BM_mesh_elem_table_ensure(bm, BM_VERT | BM_EDGE | BM_FACE);
+
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = bm->totvert >= BM_OMP_LIMIT;
+  BLI_task_parallel_range(0, bm->totvert, data, bm_to_me_verts_task, &settings);
+  bm->elem_index_dirty &= ~BM_VERT;
+
+  settings.use_threading = bm->totedge >= BM_OMP_LIMIT;
+  BLI_task_parallel_range(0, bm->totedge, data, bm_to_me_edges_task, &settings);
+  bm->elem_index_dirty &= ~BM_EDGE;
+
+  data->face_loopstart = MEM_mallocN(sizeof(int) * (size_t)bm->totface, __func__);
+  int loopstart = 0;
+  for (int i = 0; i < bm->totface; i++) {
+    data->face_loopstart[i] = loopstart;
+    loopstart += bm->ftable[i]->len;
+  }
+
+  settings.use_threading = bm->totface >= BM_OMP_LIMIT;
+  BLI_task_parallel_range(0, bm->totface, data, bm_to_me_faces_task, &settings);
+  bm->elem_index_dirty &= ~BM_FACE;
+
+  MEM_freeN(data->face_loopstart);
+  data->face_loopstart = NULL;
+}
+
+/** \} */
+
 void BM_mesh_bm_to_me(Main *bmain, BMesh *bm, Mesh *me, const struct BMeshToMeshParams *params)
 {
-  MEdge *med;
-  BMVert *v, *eve;
-  BMEdge *e;
-  BMFace *f;
+  BMVert *eve;
   BMIter iter;
   int i, j;
 
@@ -658,91 +908,17 @@ void BM_mesh_bm_to_me(Main *bmain, BMesh *bm, Mesh *me, const struct BMeshToMesh
   /* This is called again, 'dotess' arg is used there. */
   BKE_mesh_update_customdata_pointers(me, 0);
 
-  i = 0;
-  BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
-    copy_v3_v3(mvert->co, v->co);
-    normal_float_to_short_v3(mvert->no, v->no);
-
-    mvert->flag = BM_vert_flag_to_mflag(v);
-
-    BM_elem_index_set(v, i); /* set_inline */
-
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->vdata, &me->vdata, v->head.data, i);
-
-    if (cd_vert_bweight_offset != -1) {
-      mvert->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(v, cd_vert_bweight_offset);
-    }
-
-    i++;
-    mvert++;
-
-    BM_CHECK_ELEMENT(v);
-  }
-  bm->elem_index_dirty &= ~BM_VERT;
-
-  med = medge;
-  i = 0;
-  BM_ITER_MESH (e, &iter, bm, BM_EDGES_OF_MESH) {
-    med->v1 = BM_elem_index_get(e->v1);
-    med->v2 = BM_elem_index_get(e->v2);
-
-    med->flag = BM_edge_flag_to_mflag(e);
-
-    BM_elem_index_set(e, i); /* set_inline */
-
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->edata, &me->edata, e->head.data, i);
-
-    bmesh_quick_edgedraw_flag(med, e);
-
-    if (cd_edge_crease_offset != -1) {
-      med->crease = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, cd_edge_crease_offset);
-    }
-    if (cd_edge_bweight_offset != -1) {
-      med->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, cd_edge_bweight_offset);
-    }
-
-    i++;
-    med++;
-    BM_CHECK_ELEMENT(e);
-  }
-  bm->elem_index_dirty &= ~BM_EDGE;
-
-  i = 0;
-  j = 0;
-  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
-    BMLoop *l_iter, *l_first;
-    mpoly->loopstart = j;
-    mpoly->totloop = f->len;
-    mpoly->mat_nr = f->mat_nr;
-    mpoly->flag = BM_face_flag_to_mflag(f);
-
-    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
-    do {
-      mloop->e = BM_elem_index_get(l_iter->e);
-      mloop->v = BM_elem_index_get(l_iter->v);
-
-      /* Copy over custom-data. */
-      CustomData_from_bmesh_block(&bm->ldata, &me->ldata, l_iter->head.data, j);
-
-      j++;
-      mloop++;
-      BM_CHECK_ELEMENT(l_iter);
-      BM_CHECK_ELEMENT(l_iter->e);
-      BM_CHECK_ELEMENT(l_iter->v);
-    } while ((l_iter = l_iter->next) != l_first);
-
-    if (f == bm->act_face) {
-      me->act_face = i;
-    }
-
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->pdata, &me->pdata, f->head.data, i);
-
-    i++;
-    mpoly++;
-    BM_CHECK_ELEMENT(f);
+  BMToMeshData data = {
+      .bm = bm,
+      .me = me,
+      .cd_vert_bweight_offset = cd_vert_bweight_offset,
+      .cd_edge_bweight_offset = cd_edge_bweight_offset,
+      .cd_edge_crease_offset = cd_edge_crease_offset,
+  };
+  bm_to_me_elems_copy(&data);
+
+  if (bm->act_face) {
+    me->act_face = BM_elem_index_get(bm->act_face);
   }
 
   /* Patch hook indices and vertex parents. */
@@ -32,6 +32,7 @@
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
 #include "BLI_quadric.h"
+#include "BLI_task.h"
 #include "BLI_utildefines_stack.h"
 
 #include "BKE_customdata.h"
@@ -76,6 +77,21 @@ typedef enum CD_UseFlag {
 /* BMesh Helper Functions
  * ********************** */
 
+static void bm_decim_build_face_quadric_cb(void *userdata, MempoolIterData *mp_f)
+{
+  Quadric *fquadrics = userdata;
+  BMFace *f = (BMFace *)mp_f;
+
+  float center[3];
+  double plane_db[4];
+
+  BM_face_calc_center_median(f, center);
+  copy_v3db_v3fl(plane_db, f->no);
+  plane_db[3] = -dot_v3db_v3fl(plane_db, center);
+
+  BLI_quadric_from_plane(&fquadrics[BM_elem_index_get(f)], plane_db);
+}
+
 /**
  * \param vquadrics: must be calloc'd
  */
@@ -84,27 +100,29 @@ static void bm_decim_build_quadrics(BMesh *bm, Quadric *vquadrics)
   BMIter iter;
   BMFace *f;
   BMEdge *e;
+  uint i;
 
-  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
+  /* Face quadrics are calculated in parallel, but added to the vertices in a single thread,
+   * so the sums don't depend on the order the faces are handled in. */
+  Quadric *fquadrics = MEM_mallocN(sizeof(Quadric) * bm->totface, __func__);
+  BM_iter_parallel(bm,
+                   BM_FACES_OF_MESH,
+                   bm_decim_build_face_quadric_cb,
+                   fquadrics,
+                   bm->totface >= BM_OMP_LIMIT);
+
+  BM_ITER_MESH_INDEX (f, &iter, bm, BM_FACES_OF_MESH, i) {
     BMLoop *l_first;
     BMLoop *l_iter;
 
-    float center[3];
-    double plane_db[4];
-    Quadric q;
-
-    BM_face_calc_center_median(f, center);
-    copy_v3db_v3fl(plane_db, f->no);
-    plane_db[3] = -dot_v3db_v3fl(plane_db, center);
-
-    BLI_quadric_from_plane(&q, plane_db);
-
     l_iter = l_first = BM_FACE_FIRST_LOOP(f);
     do {
-      BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(l_iter->v)], &q);
+      BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(l_iter->v)], &fquadrics[i]);
     } while ((l_iter = l_iter->next) != l_first);
   }
 
+  MEM_freeN(fquadrics);
+
   /* boundary edges */
   BM_ITER_MESH (e, &iter, bm, BM_EDGES_OF_MESH) {
     if (UNLIKELY(BM_edge_is_boundary(e))) {
@@ -236,18 +254,20 @@ static float bm_decim_build_edge_cost_single__topology(BMEdge *e)
 
 #endif /* USE_TOPOLOGY_FALLBACK */
 
-static void bm_decim_build_edge_cost_single(BMEdge *e,
-                                            const Quadric *vquadrics,
-                                            const float *vweights,
-                                            const float vweight_factor,
-                                            Heap *eheap,
-                                            HeapNode **eheap_table)
+/**
+ * \return false when the edge must not be collapsed.
+ */
+static bool bm_decim_calc_edge_cost_single(BMEdge *e,
+                                           const Quadric *vquadrics,
+                                           const float *vweights,
+                                           const float vweight_factor,
+                                           float *r_cost)
 {
   float cost;
 
   if (UNLIKELY(vweights && ((vweights[BM_elem_index_get(e->v1)] == 0.0f) ||
                             (vweights[BM_elem_index_get(e->v2)] == 0.0f)))) {
-    goto clear;
+    return false;
   }
 
   /* check we can collapse, some edges we better not touch */
@@ -257,7 +277,7 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
     else {
       /* only collapse tri's */
-      goto clear;
+      return false;
     }
   }
   else if (BM_edge_is_manifold(e)) {
@@ -266,11 +286,11 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
     else {
       /* only collapse tri's */
-      goto clear;
+      return false;
     }
   }
   else {
-    goto clear;
+    return false;
   }
   /* end sanity check */
 
@@ -322,10 +342,23 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
   }
 
-  BLI_heap_insert_or_update(eheap, &eheap_table[BM_elem_index_get(e)], cost, e);
-  return;
+  *r_cost = cost;
+  return true;
+}
+
+static void bm_decim_build_edge_cost_single(BMEdge *e,
+                                            const Quadric *vquadrics,
+                                            const float *vweights,
+                                            const float vweight_factor,
+                                            Heap *eheap,
+                                            HeapNode **eheap_table)
+{
+  float cost;
+  if (bm_decim_calc_edge_cost_single(e, vquadrics, vweights, vweight_factor, &cost)) {
+    BLI_heap_insert_or_update(eheap, &eheap_table[BM_elem_index_get(e)], cost, e);
+    return;
+  }
 
-clear:
   if (eheap_table[BM_elem_index_get(e)]) {
     BLI_heap_remove(eheap, eheap_table[BM_elem_index_get(e)]);
   }
@@ -340,6 +373,27 @@ static void bm_decim_invalid_edge_cost_single(BMEdge *e, Heap *eheap, HeapNode *
   eheap_table[BM_elem_index_get(e)] = BLI_heap_insert(eheap, COST_INVALID, e);
 }
 
+typedef struct DecimBuildEdgeCostData {
+  const Quadric *vquadrics;
+  const float *vweights;
+  float vweight_factor;
+  /** Edge index aligned costs, #COST_INVALID for edges which must not be collapsed. */
+  float *ecosts;
+} DecimBuildEdgeCostData;
+
+static void bm_decim_build_edge_cost_cb(void *userdata, MempoolIterData *mp_e)
+{
+  DecimBuildEdgeCostData *data = userdata;
+  BMEdge *e = (BMEdge *)mp_e;
+  float cost;
+
+  if (!bm_decim_calc_edge_cost_single(
+          e, data->vquadrics, data->vweights, data->vweight_factor, &cost)) {
+    cost = COST_INVALID;
+  }
+  data->ecosts[BM_elem_index_get(e)] = cost;
+}
+
 static void bm_decim_build_edge_cost(BMesh *bm,
                                      const Quadric *vquadrics,
                                      const float *vweights,
@@ -351,11 +405,24 @@ static void bm_decim_build_edge_cost(BMesh *bm,
   BMEdge *e;
   uint i;
 
+  /* The costs are calculated in parallel, the heap is filled in a single thread, in the same
+   * order as when calculating each cost while filling it. */
+  DecimBuildEdgeCostData data = {
+      .vquadrics = vquadrics,
+      .vweights = vweights,
+      .vweight_factor = vweight_factor,
+      .ecosts = MEM_mallocN(sizeof(float) * bm->totedge, __func__),
+  };
+  BM_iter_parallel(
+      bm, BM_EDGES_OF_MESH, bm_decim_build_edge_cost_cb, &data, bm->totedge >= BM_OMP_LIMIT);
+
   BM_ITER_MESH_INDEX (e, &iter, bm, BM_EDGES_OF_MESH, i) {
-    /* keep sanity check happy */
-    eheap_table[i] = NULL;
-    bm_decim_build_edge_cost_single(e, vquadrics, vweights, vweight_factor, eheap, eheap_table);
+    eheap_table[i] = (data.ecosts[i] != COST_INVALID) ?
+                         BLI_heap_insert(eheap, data.ecosts[i], e) :
+                         NULL;
   }
+
+  MEM_freeN(data.ecosts);
 }
 
 #ifdef USE_SYMMETRY
@@ -347,6 +347,35 @@ void COM_execute(RenderData *rd,
                  const ColorManagedDisplaySettings *displaySettings,
                  const char *viewName);
 
+/**
+ * \brief Composite several frames of an animation in parallel.
+ * Every frame is executed by its own ExecutionSystem, with a copy of rd set to the frame.
+ * The Composite output of a frame is written to its result instead of the result of the scene
+ * render, File Output nodes write their files as usual. Previews, viewers and the GPU devices
+ * aren't used. The number of frames executed at the same time is limited by the number of
+ * threads and by the memory the buffers of a frame use.
+ *
+ * \param frames: the frame numbers to composite.
+ * \param results: a render result for every frame, with the view viewName.
+ * \note the tree must not depend on the current frame of the scene, see COM_can_execute_frames.
+ */
+void COM_execute_frames(RenderData *rd,
+                        Scene *scene,
+                        bNodeTree *editingtree,
+                        const int *frames,
+                        struct RenderResult **results,
+                        int num_frames,
+                        const ColorManagedViewSettings *viewSettings,
+                        const ColorManagedDisplaySettings *displaySettings,
+                        const char *viewName);
+
+/**
+ * \brief Can the frames of editingtree be composited in parallel with COM_execute_frames?
+ * False when nodes have animated settings, or use data that is only set for the current frame
+ * (render layers, movie clips and masks).
+ */
+bool COM_can_execute_frames(bNodeTree *editingtree);
+
 /**
  * \brief Deinitialize the compositor caches and allocated memory.
  * Use COM_clearCaches to only free the caches.
@@ -58,6 +58,24 @@ typedef enum CompositorPriority {
   COM_PRIORITY_LOW = 0,
 } CompositorPriority;
 
+/**
+ * \brief Possible execution models of the compositor
+ * \see ExecutionSystem.execute
+ * \ingroup Execution
+ */
+typedef enum ExecutionModel {
+  /**
+   * \brief Operations are executed chunk by chunk, pulling the areas of interest from the
+   * groups they depend on. Uses less memory and shows first results earlier.
+   */
+  COM_EXECUTION_MODEL_TILED = 0,
+  /**
+   * \brief Every ExecutionGroup is executed once over its whole area, in dependency order.
+   * Rows of the output are distributed over the available threads.
+   */
+  COM_EXECUTION_MODEL_FULL_FRAME = 1,
+} ExecutionModel;
+
 // configurable items
 
 // chunk size determination
@@ -68,10 +86,18 @@ typedef enum CompositorPriority {
 // workscheduler threading models
 /**
  * COM_TM_QUEUE is a multi-threaded model, which uses the BLI_thread_queue pattern.
- * This is the default option.
+ * Every CPUDevice has a thread popping work from a single shared queue.
  */
 #define COM_TM_QUEUE 1
 
+/**
+ * COM_TM_TASK is a multi-threaded model, which pushes the CPU work to a BLI_task pool.
+ * Work is distributed by the work-stealing scheduler of the task system, avoiding the lock of a
+ * shared queue. OpenCL devices still use the BLI_thread_queue pattern.
+ * This is the default option.
+ */
+#define COM_TM_TASK 2
+
 /**
  * COM_TM_NOTHREAD is a single threading model, everything is executed in the caller thread.
  * easy for debugging
@@ -79,9 +105,9 @@ typedef enum CompositorPriority {
 #define COM_TM_NOTHREAD 0
 
 /**
- * COM_CURRENT_THREADING_MODEL can be one of the above, COM_TM_QUEUE is currently default.
+ * COM_CURRENT_THREADING_MODEL can be one of the above, COM_TM_TASK is currently default.
  */
-#define COM_CURRENT_THREADING_MODEL COM_TM_QUEUE
+#define COM_CURRENT_THREADING_MODEL COM_TM_TASK
 // chunk order
 /**
  * \brief The order of chunks to be scheduled
@@ -102,6 +128,12 @@ typedef enum OrderOfChunks {
 
 #define COM_RULE_OF_THIRDS_DIVIDER 100.0f
 
+/**
+ * \brief Number of row bands a full frame ExecutionGroup is split into per thread.
+ * Using more than one band per thread balances work between fast and slow rows.
+ */
+#define COM_FULL_FRAME_BANDS_PER_THREAD 4
+
 #define COM_NUM_CHANNELS_VALUE 1
 #define COM_NUM_CHANNELS_VECTOR 3
 #define COM_NUM_CHANNELS_COLOR 4
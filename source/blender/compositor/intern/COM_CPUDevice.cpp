@@ -18,6 +18,8 @@
 
 #include "COM_CPUDevice.h"
 
+#include "PIL_time.h"
+
 CPUDevice::CPUDevice(int thread_id) : m_thread_id(thread_id)
 {
 }
@@ -30,7 +32,9 @@ void CPUDevice::execute(WorkPackage *work)
 
   executionGroup->determineChunkRect(&rect, chunkNumber);
 
+  const double start_time = PIL_check_seconds_timer();
   executionGroup->getOutputOperation()->executeRegion(&rect, chunkNumber);
+  executionGroup->set_chunk_execution_time(chunkNumber, PIL_check_seconds_timer() - start_time);
 
   executionGroup->finalizeChunkExecution(chunkNumber, nullptr);
 }
@@ -24,8 +24,10 @@ CompositorContext::CompositorContext()
 {
   this->m_scene = nullptr;
   this->m_rd = nullptr;
+  this->m_renderResult = nullptr;
   this->m_quality = COM_QUALITY_HIGH;
   this->m_hasActiveOpenCLDevices = false;
+  this->m_hasActiveGPUDevice = false;
   this->m_fastCalculation = false;
   this->m_viewSettings = nullptr;
   this->m_displaySettings = nullptr;
@@ -26,6 +26,8 @@
 #include <string>
 #include <vector>
 
+struct RenderResult;
+
 /**
  * \brief Overall context of the compositor
  */
@@ -54,6 +56,12 @@ class CompositorContext {
    */
   RenderData *m_rd;
 
+  /**
+   * \brief Result the CompositorOperation writes to, instead of the result of the scene render.
+   * Set when frames are composited in parallel, see COM_execute_frames.
+   */
+  RenderResult *m_renderResult;
+
   /**
    * \brief reference to the bNodeTree
    * This field is initialized in ExecutionSystem and must only be read from that point on.
@@ -72,6 +80,11 @@ class CompositorContext {
    */
   bool m_hasActiveOpenCLDevices;
 
+  /**
+   * \brief is the GPUDevice used to calculate this tree
+   */
+  bool m_hasActiveGPUDevice;
+
   /**
    * \brief Skip slow nodes
    */
@@ -140,6 +153,23 @@ class CompositorContext {
     return this->m_rd;
   }
 
+  /**
+   * \brief set the result of the frame being composited
+   */
+  void setRenderResult(RenderResult *renderResult)
+  {
+    this->m_renderResult = renderResult;
+  }
+
+  /**
+   * \brief get the result of the frame being composited
+   * \return nullptr when compositing into the result of the scene render.
+   */
+  RenderResult *getRenderResult() const
+  {
+    return this->m_renderResult;
+  }
+
   void setScene(Scene *scene)
   {
     m_scene = scene;
@@ -234,6 +264,20 @@ class CompositorContext {
     this->m_hasActiveOpenCLDevices = hasAvtiveOpenCLDevices;
   }
 
+  /**
+   * \brief is the GPUDevice used to calculate this tree
+   * \see ExecutionGroup.set_gpu
+   */
+  bool getHasActiveGPUDevice() const
+  {
+    return this->m_hasActiveGPUDevice;
+  }
+
+  void setHasActiveGPUDevice(bool hasActiveGPUDevice)
+  {
+    this->m_hasActiveGPUDevice = hasActiveGPUDevice;
+  }
+
   /**
    * \brief get the active rendering view
    */
@@ -255,6 +299,17 @@ class CompositorContext {
     return this->getbNodeTree()->chunksize;
   }
 
+  /**
+   * \brief get the execution model the tree is evaluated with
+   */
+  ExecutionModel getExecutionModel() const
+  {
+    if (this->getbNodeTree()->execution_mode == NTREE_EXECUTION_MODE_FULL_FRAME) {
+      return COM_EXECUTION_MODEL_FULL_FRAME;
+    }
+    return COM_EXECUTION_MODEL_TILED;
+  }
+
   void setFastCalculation(bool fastCalculation)
   {
     this->m_fastCalculation = fastCalculation;
@@ -268,6 +323,14 @@ class CompositorContext {
     return (this->getbNodeTree()->flag & NTREE_COM_GROUPNODE_BUFFER) != 0;
   }
 
+  /**
+   * \brief are intermediate buffers stored as half floats
+   */
+  bool isHalfFloatEnabled() const
+  {
+    return (this->getbNodeTree()->flag & NTREE_COM_HALF_FLOAT) != 0;
+  }
+
   /**
    * \brief Get the render percentage as a factor.
    * The compositor uses a factor i.o. a percentage.
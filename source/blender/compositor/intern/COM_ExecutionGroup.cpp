@@ -55,10 +55,12 @@ ExecutionGroup::ExecutionGroup()
   this->m_numberOfChunks = 0;
   this->m_initialized = false;
   this->m_openCL = false;
+  this->m_gpu = false;
   this->m_singleThreaded = false;
   this->m_chunksFinished = 0;
   BLI_rcti_init(&this->m_viewerBorder, 0, 0, 0, 0);
   this->m_executionStartTime = 0;
+  this->m_executionModel = COM_EXECUTION_MODEL_TILED;
 }
 
 CompositorPriority ExecutionGroup::getRenderPriotrity()
@@ -135,6 +137,7 @@ void ExecutionGroup::initExecution()
       this->m_chunkExecutionStates[index] = COM_ES_NOT_SCHEDULED;
     }
   }
+  this->m_chunkExecutionTimes.assign(this->m_numberOfChunks, -1.0);
 
   unsigned int maxNumber = 0;
 
@@ -159,6 +162,7 @@ void ExecutionGroup::deinitExecution()
   this->m_numberOfChunks = 0;
   this->m_numberOfXChunks = 0;
   this->m_numberOfYChunks = 0;
+  this->m_chunkExecutionTimes.clear();
   this->m_cachedReadOperations.clear();
   this->m_bTree = nullptr;
 }
@@ -173,11 +177,18 @@ void ExecutionGroup::determineResolution(unsigned int resolution[2])
 
 void ExecutionGroup::determineNumberOfChunks()
 {
-  if (this->m_singleThreaded) {
+  if (this->m_singleThreaded || this->m_gpu) {
     this->m_numberOfXChunks = 1;
     this->m_numberOfYChunks = 1;
     this->m_numberOfChunks = 1;
   }
+  else if (this->m_executionModel == COM_EXECUTION_MODEL_FULL_FRAME) {
+    const int border_height = BLI_rcti_size_y(&this->m_viewerBorder);
+    const int max_bands = BLI_system_thread_count() * COM_FULL_FRAME_BANDS_PER_THREAD;
+    this->m_numberOfXChunks = 1;
+    this->m_numberOfYChunks = max_ii(min_ii(border_height, max_bands), 0);
+    this->m_numberOfChunks = this->m_numberOfYChunks;
+  }
   else {
     const float chunkSizef = this->m_chunkSize;
     const int border_width = BLI_rcti_size_x(&this->m_viewerBorder);
@@ -371,6 +382,36 @@ void ExecutionGroup::execute(ExecutionSystem *graph)
   MEM_freeN(chunkOrder);
 }
 
+void ExecutionGroup::execute_full_frame(ExecutionSystem *graph)
+{
+  const CompositorContext &context = graph->getContext();
+  const bNodeTree *bTree = context.getbNodeTree();
+  if (this->m_width == 0 || this->m_height == 0) {
+    return;
+  } /** \note Break out... no pixels to calculate. */
+  if (bTree->test_break && bTree->test_break(bTree->tbh)) {
+    return;
+  } /** \note Early break out for blur and preview nodes. */
+  if (this->m_numberOfChunks == 0) {
+    return;
+  } /** \note Early break out. */
+
+  this->m_executionStartTime = PIL_check_seconds_timer();
+  this->m_chunksFinished = 0;
+  /* Only report progress of the groups the user is waiting for. */
+  this->m_bTree = this->m_isOutput ? bTree : nullptr;
+
+  DebugInfo::execution_group_started(this);
+
+  /* All depending groups are fully executed, so every band can be scheduled right away. */
+  for (unsigned int chunkNumber = 0; chunkNumber < this->m_numberOfChunks; chunkNumber++) {
+    scheduleChunk(chunkNumber);
+  }
+  WorkScheduler::finish();
+
+  DebugInfo::execution_group_finished(this);
+}
+
 MemoryBuffer **ExecutionGroup::getInputBuffersOpenCL(int chunkNumber)
 {
   rcti rect;
@@ -445,10 +486,24 @@ inline void ExecutionGroup::determineChunkRect(rcti *rect,
   const int border_width = BLI_rcti_size_x(&this->m_viewerBorder);
   const int border_height = BLI_rcti_size_y(&this->m_viewerBorder);
 
-  if (this->m_singleThreaded) {
+  if (this->m_singleThreaded || this->m_gpu) {
     BLI_rcti_init(
         rect, this->m_viewerBorder.xmin, border_width, this->m_viewerBorder.ymin, border_height);
   }
+  else if (this->m_executionModel == COM_EXECUTION_MODEL_FULL_FRAME) {
+    /* Distribute the rows evenly over the bands. */
+    const unsigned int width = min((unsigned int)this->m_viewerBorder.xmax, this->m_width);
+    const unsigned int height = min((unsigned int)this->m_viewerBorder.ymax, this->m_height);
+    const unsigned int miny = this->m_viewerBorder.ymin +
+                              (yChunk * border_height) / this->m_numberOfYChunks;
+    const unsigned int maxy = this->m_viewerBorder.ymin +
+                              ((yChunk + 1) * border_height) / this->m_numberOfYChunks;
+    BLI_rcti_init(rect,
+                  min((unsigned int)this->m_viewerBorder.xmin, this->m_width),
+                  width,
+                  min(miny, this->m_height),
+                  min(maxy, height));
+  }
   else {
     const unsigned int minx = xChunk * this->m_chunkSize + this->m_viewerBorder.xmin;
     const unsigned int miny = yChunk * this->m_chunkSize + this->m_viewerBorder.ymin;
@@ -483,7 +538,7 @@ MemoryBuffer *ExecutionGroup::allocateOutputBuffer(int /*chunkNumber*/, rcti *re
 
 bool ExecutionGroup::scheduleAreaWhenPossible(ExecutionSystem *graph, rcti *area)
 {
-  if (this->m_singleThreaded) {
+  if (this->m_singleThreaded || this->m_gpu) {
     return scheduleChunkWhenPossible(graph, 0, 0);
   }
   // find all chunks inside the rect
@@ -601,6 +656,45 @@ bool ExecutionGroup::isOpenCL()
   return this->m_openCL;
 }
 
+bool ExecutionGroup::can_execute_on_gpu() const
+{
+  if (this->m_singleThreaded || !this->getOutputOperation()->isWriteBufferOperation()) {
+    return false;
+  }
+  /* Groups only copying a buffer have nothing to calculate. */
+  bool has_shaders = false;
+  for (NodeOperation *operation : this->m_operations) {
+    if (operation->isReadBufferOperation() || operation->isWriteBufferOperation()) {
+      continue;
+    }
+    if (!operation->hasGPUShader()) {
+      return false;
+    }
+    has_shaders = true;
+  }
+  return has_shaders;
+}
+
+void ExecutionGroup::set_executed()
+{
+  for (unsigned int index = 0; index < this->m_numberOfChunks; index++) {
+    this->m_chunkExecutionStates[index] = COM_ES_EXECUTED;
+  }
+}
+
+bool ExecutionGroup::is_executed() const
+{
+  if (this->m_width == 0 || this->m_height == 0 || this->m_numberOfChunks == 0) {
+    return false;
+  }
+  for (unsigned int index = 0; index < this->m_numberOfChunks; index++) {
+    if (this->m_chunkExecutionStates[index] != COM_ES_EXECUTED) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void ExecutionGroup::setViewerBorder(float xmin, float xmax, float ymin, float ymax)
 {
   NodeOperation *operation = this->getOutputOperation();
@@ -645,3 +739,32 @@ void ExecutionGroup::setRenderBorder(float xmin, float xmax, float ymin, float y
     }
   }
 }
+
+void ExecutionGroup::set_chunk_execution_time(unsigned int chunkNumber, double time)
+{
+  this->m_chunkExecutionTimes[chunkNumber] = time;
+}
+
+double ExecutionGroup::get_execution_time() const
+{
+  double time = 0.0;
+  for (double chunk_time : this->m_chunkExecutionTimes) {
+    if (chunk_time >= 0.0) {
+      time += chunk_time;
+    }
+  }
+  return time;
+}
+
+uint64_t ExecutionGroup::get_executed_pixels() const
+{
+  uint64_t pixels = 0;
+  for (unsigned int index = 0; index < this->m_chunkExecutionTimes.size(); index++) {
+    if (this->m_chunkExecutionTimes[index] >= 0.0) {
+      rcti rect;
+      determineChunkRect(&rect, index);
+      pixels += (uint64_t)BLI_rcti_size_x(&rect) * BLI_rcti_size_y(&rect);
+    }
+  }
+  return pixels;
+}
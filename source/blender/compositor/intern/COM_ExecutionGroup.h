@@ -122,6 +122,11 @@ class ExecutionGroup {
    */
   bool m_openCL;
 
+  /**
+   * \brief is this ExecutionGroup calculated by the GPUDevice
+   */
+  bool m_gpu;
+
   /**
    * \brief Is this Execution group SingleThreaded
    */
@@ -158,6 +163,12 @@ class ExecutionGroup {
    */
   ChunkExecutionState *m_chunkExecutionStates;
 
+  /**
+   * \brief time in seconds it took to calculate each chunk, negative when it wasn't calculated
+   * \see get_execution_time
+   */
+  vector<double> m_chunkExecutionTimes;
+
   /**
    * \brief indicator when this ExecutionGroup has valid Operations in its vector for Execution
    * \note When building the ExecutionGroup Operations are added via recursion.
@@ -181,6 +192,12 @@ class ExecutionGroup {
    */
   double m_executionStartTime;
 
+  /**
+   * \brief execution model used to split this group into chunks.
+   * In COM_EXECUTION_MODEL_FULL_FRAME chunks are full width bands of rows.
+   */
+  ExecutionModel m_executionModel;
+
   // methods
   /**
    * \brief check whether parameter operation can be added to the execution group
@@ -399,6 +416,15 @@ class ExecutionGroup {
    */
   void execute(ExecutionSystem *graph);
 
+  /**
+   * \brief execute all chunks of this ExecutionGroup at once
+   * \note all ExecutionGroup's this group depends on must already be executed, there is no
+   * scheduling of depending areas. Used by COM_EXECUTION_MODEL_FULL_FRAME.
+   * \note this method will return when all chunks have been calculated, or the execution has
+   * breaked (by user)
+   */
+  void execute_full_frame(ExecutionSystem *graph);
+
   /**
    * \brief this method determines the MemoryProxy's where this execution group depends on.
    * \note After this method determineDependingAreaOfInterest can be called to determine
@@ -420,11 +446,72 @@ class ExecutionGroup {
    */
   bool isOpenCL();
 
+  /**
+   * \brief can every operation of this ExecutionGroup be calculated by the GPUDevice
+   * \see NodeOperation.getGPUShaderSource
+   */
+  bool can_execute_on_gpu() const;
+
+  /**
+   * \brief calculate this ExecutionGroup on the GPUDevice, as a single chunk
+   * \note must be set before initExecution.
+   */
+  void set_gpu(bool gpu)
+  {
+    this->m_gpu = gpu;
+  }
+
+  bool is_gpu() const
+  {
+    return this->m_gpu;
+  }
+
+  /**
+   * \brief mark all chunks as executed, so they won't be scheduled anymore
+   * \note used when the result of the group is restored from the ResultCache.
+   */
+  void set_executed();
+
+  /**
+   * \brief have all chunks of this ExecutionGroup been executed
+   */
+  bool is_executed() const;
+
+  const Operations &get_operations() const
+  {
+    return this->m_operations;
+  }
+
+  /**
+   * \brief store the time it took a device to calculate a chunk
+   * \note each chunk is only calculated by a single thread, so no locking is needed.
+   */
+  void set_chunk_execution_time(unsigned int chunkNumber, double time);
+
+  /**
+   * \brief time spent calculating the chunks of this ExecutionGroup, summed over all threads
+   */
+  double get_execution_time() const;
+
+  /**
+   * \brief number of pixels in the chunks calculated by this ExecutionGroup
+   * Chunks restored from the ResultCache are not counted.
+   */
+  uint64_t get_executed_pixels() const;
+
   void setChunksize(int chunksize)
   {
     this->m_chunkSize = chunksize;
   }
 
+  /**
+   * \brief set the execution model, must be called before initExecution
+   */
+  void setExecutionModel(ExecutionModel model)
+  {
+    this->m_executionModel = model;
+  }
+
   /**
    * \brief get the Render priority of this ExecutionGroup
    * \see ExecutionSystem.execute
@@ -18,11 +18,17 @@
 
 #include "COM_ExecutionSystem.h"
 
+#include <algorithm>
+#include <set>
+
+#include "BLI_listbase.h"
 #include "BLI_utildefines.h"
 #include "PIL_time.h"
 
 #include "BKE_node.h"
 
+#include "DNA_userdef_types.h"
+
 #include "BLT_translation.h"
 
 #include "COM_Converter.h"
@@ -31,7 +37,9 @@
 #include "COM_NodeOperation.h"
 #include "COM_NodeOperationBuilder.h"
 #include "COM_ReadBufferOperation.h"
+#include "COM_ResultCache.h"
 #include "COM_WorkScheduler.h"
+#include "COM_WriteBufferOperation.h"
 
 #ifdef WITH_CXX_GUARDEDALLOC
 #  include "MEM_guardedalloc.h"
@@ -44,12 +52,15 @@ ExecutionSystem::ExecutionSystem(RenderData *rd,
                                  bool fastcalculation,
                                  const ColorManagedViewSettings *viewSettings,
                                  const ColorManagedDisplaySettings *displaySettings,
-                                 const char *viewName)
+                                 const char *viewName,
+                                 RenderResult *renderResult)
 {
   this->m_context.setViewName(viewName);
   this->m_context.setScene(scene);
   this->m_context.setbNodeTree(editingtree);
-  this->m_context.setPreviewHash(editingtree->previews);
+  /* Frames composited in parallel would write the previews of the same tree. */
+  this->m_context.setPreviewHash(renderResult ? nullptr : editingtree->previews);
+  this->m_context.setRenderResult(renderResult);
   this->m_context.setFastCalculation(fastcalculation);
   /* initialize the CompositorContext */
   if (rendering) {
@@ -59,8 +70,14 @@ ExecutionSystem::ExecutionSystem(RenderData *rd,
     this->m_context.setQuality((CompositorQuality)editingtree->edit_quality);
   }
   this->m_context.setRendering(rendering);
+  /* The GPUDevice replaces OpenCL, they use the same queue in the WorkScheduler. That queue is
+   * shared between systems, so frames composited in parallel only use the CPU. */
+  this->m_context.setHasActiveGPUDevice(WorkScheduler::has_gpu_device() &&
+                                        (editingtree->flag & NTREE_COM_GPU) && !renderResult);
   this->m_context.setHasActiveOpenCLDevices(WorkScheduler::hasGPUDevices() &&
-                                            (editingtree->flag & NTREE_COM_OPENCL));
+                                            (editingtree->flag & NTREE_COM_OPENCL) &&
+                                            !this->m_context.getHasActiveGPUDevice() &&
+                                            !renderResult);
 
   this->m_context.setRenderData(rd);
   this->m_context.setViewSettings(viewSettings);
@@ -127,6 +144,18 @@ void ExecutionSystem::set_operations(const Operations &operations, const Groups
   m_groups = groups;
 }
 
+size_t ExecutionSystem::get_estimated_memory() const
+{
+  size_t memory = 0;
+  for (NodeOperation *operation : this->m_operations) {
+    if (operation->isWriteBufferOperation()) {
+      memory += sizeof(float) * COM_NUM_CHANNELS_COLOR * operation->getWidth() *
+                operation->getHeight();
+    }
+  }
+  return memory;
+}
+
 void ExecutionSystem::execute()
 {
   const bNodeTree *editingtree = this->m_context.getbNodeTree();
@@ -147,6 +176,16 @@ void ExecutionSystem::execute()
   }
   unsigned int index;
 
+  /* Only used while editing, reusing results is what makes interactive tweaking fast. */
+  const bool use_result_cache = !this->m_context.isRendering() && U.compositor_cache_limit > 0;
+
+  if (this->m_context.getHasActiveGPUDevice()) {
+    determine_gpu_groups(use_result_cache);
+  }
+  if (this->m_context.isHalfFloatEnabled()) {
+    determine_half_float_proxies();
+  }
+
   // First allocale all write buffer
   for (index = 0; index < this->m_operations.size(); index++) {
     NodeOperation *operation = this->m_operations[index];
@@ -171,23 +210,45 @@ void ExecutionSystem::execute()
       operation->initExecution();
     }
   }
+  const ExecutionModel execution_model = this->m_context.getExecutionModel();
   for (index = 0; index < this->m_groups.size(); index++) {
     ExecutionGroup *executionGroup = this->m_groups[index];
     executionGroup->setChunksize(this->m_context.getChunksize());
+    executionGroup->setExecutionModel(execution_model);
     executionGroup->initExecution();
   }
 
+  if (use_result_cache) {
+    restore_cached_results();
+  }
+
   WorkScheduler::start(this->m_context);
 
-  executeGroups(COM_PRIORITY_HIGH);
-  if (!this->getContext().isFastCalculation()) {
-    executeGroups(COM_PRIORITY_MEDIUM);
-    executeGroups(COM_PRIORITY_LOW);
+  if (execution_model == COM_EXECUTION_MODEL_FULL_FRAME) {
+    execute_groups_full_frame(COM_PRIORITY_HIGH);
+    if (!this->getContext().isFastCalculation()) {
+      execute_groups_full_frame(COM_PRIORITY_MEDIUM);
+      execute_groups_full_frame(COM_PRIORITY_LOW);
+    }
+  }
+  else {
+    executeGroups(COM_PRIORITY_HIGH);
+    if (!this->getContext().isFastCalculation()) {
+      executeGroups(COM_PRIORITY_MEDIUM);
+      executeGroups(COM_PRIORITY_LOW);
+    }
   }
 
   WorkScheduler::finish();
   WorkScheduler::stop();
 
+  if (use_result_cache) {
+    store_cached_results();
+  }
+  if (this->m_context.getRenderResult() == nullptr) {
+    update_node_stats();
+  }
+
   editingtree->stats_draw(editingtree->sdh, TIP_("Compositing | De-initializing execution"));
   for (index = 0; index < this->m_operations.size(); index++) {
     NodeOperation *operation = this->m_operations[index];
@@ -211,6 +272,197 @@ void ExecutionSystem::executeGroups(CompositorPriority priority)
   }
 }
 
+void ExecutionSystem::execute_groups_full_frame(CompositorPriority priority)
+{
+  vector<ExecutionGroup *> outputGroups;
+  this->findOutputExecutionGroup(&outputGroups, priority);
+
+  /* Groups executed by an earlier priority are already done and are skipped by the group
+   * itself, as all of its chunks are marked as executed. */
+  vector<ExecutionGroup *> executionOrder;
+  for (ExecutionGroup *group : outputGroups) {
+    this->add_group_with_dependencies(group, &executionOrder);
+  }
+
+  const bNodeTree *editingtree = this->m_context.getbNodeTree();
+  for (ExecutionGroup *group : executionOrder) {
+    if (editingtree->test_break && editingtree->test_break(editingtree->tbh)) {
+      break;
+    }
+    group->execute_full_frame(this);
+  }
+}
+
+void ExecutionSystem::add_group_with_dependencies(ExecutionGroup *group,
+                                                  vector<ExecutionGroup *> *result) const
+{
+  if (std::find(result->begin(), result->end(), group) != result->end()) {
+    return;
+  }
+  if (group->is_executed()) {
+    /* Restored from the ResultCache, its dependencies aren't needed. */
+    return;
+  }
+
+  vector<MemoryProxy *> memoryProxies;
+  group->determineDependingMemoryProxies(&memoryProxies);
+  for (MemoryProxy *memoryProxy : memoryProxies) {
+    ExecutionGroup *dependency = memoryProxy->getExecutor();
+    if (dependency != nullptr) {
+      this->add_group_with_dependencies(dependency, result);
+    }
+  }
+  result->push_back(group);
+}
+
+void ExecutionSystem::determine_gpu_groups(bool use_result_cache)
+{
+  for (ExecutionGroup *group : this->m_groups) {
+    group->set_gpu(group->can_execute_on_gpu());
+  }
+  if (use_result_cache) {
+    return;
+  }
+
+  /* Buffers that are only used on the GPU don't have to be read back. */
+  std::set<MemoryProxy *> cpu_proxies;
+  for (ExecutionGroup *group : this->m_groups) {
+    for (NodeOperation *operation : group->get_operations()) {
+      if (operation->isReadBufferOperation() && !group->is_gpu()) {
+        cpu_proxies.insert(((ReadBufferOperation *)operation)->getMemoryProxy());
+      }
+    }
+  }
+  for (NodeOperation *operation : this->m_operations) {
+    if (!operation->isWriteBufferOperation()) {
+      continue;
+    }
+    MemoryProxy *memoryProxy = ((WriteBufferOperation *)operation)->getMemoryProxy();
+    ExecutionGroup *group = memoryProxy->getExecutor();
+    memoryProxy->set_gpu_only(group && group->is_gpu() &&
+                              cpu_proxies.find(memoryProxy) == cpu_proxies.end());
+  }
+}
+
+void ExecutionSystem::determine_half_float_proxies()
+{
+  /* OpenCL kernels, the GPUDevice and complex operations access the float data of buffers. */
+  if (this->m_context.getHasActiveOpenCLDevices()) {
+    return;
+  }
+
+  std::set<MemoryProxy *> float_proxies;
+  for (ExecutionGroup *group : this->m_groups) {
+    if (!group->is_gpu()) {
+      continue;
+    }
+    for (NodeOperation *operation : group->get_operations()) {
+      if (operation->isReadBufferOperation()) {
+        float_proxies.insert(((ReadBufferOperation *)operation)->getMemoryProxy());
+      }
+      else if (operation->isWriteBufferOperation()) {
+        float_proxies.insert(((WriteBufferOperation *)operation)->getMemoryProxy());
+      }
+    }
+  }
+  for (NodeOperation *operation : this->m_operations) {
+    if (!operation->isComplex()) {
+      continue;
+    }
+    for (unsigned int index = 0; index < operation->getNumberOfInputSockets(); index++) {
+      NodeOperationOutput *link = operation->getInputSocket(index)->getLink();
+      if (link && link->getOperation().isReadBufferOperation()) {
+        ReadBufferOperation *readOperation = (ReadBufferOperation *)&link->getOperation();
+        float_proxies.insert(readOperation->getMemoryProxy());
+      }
+    }
+  }
+
+  for (NodeOperation *operation : this->m_operations) {
+    if (operation->isWriteBufferOperation()) {
+      MemoryProxy *memoryProxy = ((WriteBufferOperation *)operation)->getMemoryProxy();
+      memoryProxy->set_use_half_float(float_proxies.find(memoryProxy) == float_proxies.end());
+    }
+  }
+}
+
+void ExecutionSystem::restore_cached_results()
+{
+  ResultCache::set_limit((size_t)U.compositor_cache_limit * 1024 * 1024);
+
+  ResultCache::Hashes hashes;
+  for (NodeOperation *operation : this->m_operations) {
+    if (!operation->isWriteBufferOperation()) {
+      continue;
+    }
+    WriteBufferOperation *writeOperation = (WriteBufferOperation *)operation;
+    uint32_t key;
+    if (!ResultCache::operation_hash(writeOperation, hashes, &key)) {
+      continue;
+    }
+    MemoryProxy *memoryProxy = writeOperation->getMemoryProxy();
+    ExecutionGroup *group = memoryProxy->getExecutor();
+    if (group && ResultCache::restore(key, memoryProxy->getBuffer())) {
+      group->set_executed();
+    }
+    else {
+      this->m_cacheKeys[writeOperation] = key;
+    }
+  }
+}
+
+void ExecutionSystem::store_cached_results()
+{
+  for (const auto &item : this->m_cacheKeys) {
+    MemoryProxy *memoryProxy = item.first->getMemoryProxy();
+    ExecutionGroup *group = memoryProxy->getExecutor();
+    /* Skip results of groups that weren't needed or were cancelled. */
+    if (group && group->is_executed()) {
+      ResultCache::store(item.second, memoryProxy->getBuffer());
+    }
+  }
+  this->m_cacheKeys.clear();
+}
+
+void ExecutionSystem::update_node_stats()
+{
+  bNodeTree *ntree = (bNodeTree *)this->m_context.getbNodeTree();
+  LISTBASE_FOREACH (bNode *, node, &ntree->nodes) {
+    memset(&node->exec_stats, 0, sizeof(node->exec_stats));
+  }
+
+  for (ExecutionGroup *group : this->m_groups) {
+    const uint64_t pixels = group->get_executed_pixels();
+    if (pixels == 0) {
+      continue;
+    }
+    vector<bNode *> nodes;
+    for (NodeOperation *operation : group->get_operations()) {
+      bNode *node = operation->get_stats_node();
+      if (node && std::find(nodes.begin(), nodes.end(), node) == nodes.end()) {
+        nodes.push_back(node);
+      }
+    }
+    const double time = group->get_execution_time() / nodes.size();
+    for (bNode *node : nodes) {
+      node->exec_stats.time += time;
+      node->exec_stats.pixels += pixels;
+    }
+  }
+
+  for (NodeOperation *operation : this->m_operations) {
+    if (!operation->isWriteBufferOperation()) {
+      continue;
+    }
+    WriteBufferOperation *writeOperation = (WriteBufferOperation *)operation;
+    bNode *node = writeOperation->getInput()->get_stats_node();
+    MemoryBuffer *buffer = writeOperation->getMemoryProxy()->getBuffer();
+    if (node && buffer) {
+      node->exec_stats.memory += buffer->get_data_size();
+    }
+  }
+}
+
 void ExecutionSystem::findOutputExecutionGroup(vector<ExecutionGroup *> *result,
                                                CompositorPriority priority) const
 {
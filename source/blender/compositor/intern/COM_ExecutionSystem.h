@@ -27,6 +27,10 @@ class ExecutionGroup;
 #include "DNA_color_types.h"
 #include "DNA_node_types.h"
 
+#include <map>
+
+class WriteBufferOperation;
+
 /**
  * \page execution Execution model
  * In order to get to an efficient model for execution, several steps are being done. these steps
@@ -133,6 +137,12 @@ class ExecutionSystem {
    */
   Groups m_groups;
 
+  /**
+   * \brief ResultCache keys of the WriteBufferOperation's that can be cached.
+   * Only contains the operations that weren't restored from the cache.
+   */
+  std::map<WriteBufferOperation *, uint32_t> m_cacheKeys;
+
  private:  // methods
   /**
    * find all execution group with output nodes
@@ -152,6 +162,9 @@ class ExecutionSystem {
    *
    * \param editingtree: [bNodeTree *]
    * \param rendering: [true false]
+   * \param renderResult: result to composite a frame into, nullptr for the result of the scene
+   * render. Systems with a result can be executed in parallel, they only use the CPU and don't
+   * update previews, viewers and node statistics.
    */
   ExecutionSystem(RenderData *rd,
                   Scene *scene,
@@ -160,7 +173,8 @@ class ExecutionSystem {
                   bool fastcalculation,
                   const ColorManagedViewSettings *viewSettings,
                   const ColorManagedDisplaySettings *displaySettings,
-                  const char *viewName);
+                  const char *viewName,
+                  RenderResult *renderResult);
 
   /**
    * Destructor
@@ -173,6 +187,7 @@ class ExecutionSystem {
    * \brief execute this system
    * - initialize the NodeOperation's and ExecutionGroup's
    * - schedule the output ExecutionGroup's based on their priority
+   *   (tiled, or full frame in dependency order, see ExecutionModel)
    * - deinitialize the ExecutionGroup's and NodeOperation's
    */
   void execute();
@@ -185,9 +200,59 @@ class ExecutionSystem {
     return this->m_context;
   }
 
+  /**
+   * \brief estimate the memory in bytes used by the buffers of an execution
+   * Buffers are counted with four channels, so this is an upper bound.
+   */
+  size_t get_estimated_memory() const;
+
  private:
   void executeGroups(CompositorPriority priority);
 
+  /**
+   * \brief execute the output groups of a priority with COM_EXECUTION_MODEL_FULL_FRAME
+   * Depending groups are executed first, every group is executed only once.
+   */
+  void execute_groups_full_frame(CompositorPriority priority);
+
+  /**
+   * \brief add group and all groups it depends on to result, dependencies first.
+   * Groups that are already in result are skipped.
+   */
+  void add_group_with_dependencies(ExecutionGroup *group, vector<ExecutionGroup *> *result) const;
+
+  /**
+   * \brief calculate the groups that support it on the GPUDevice
+   * \param use_result_cache: the results of GPU groups have to be read back to be cached.
+   * \see ExecutionGroup.set_gpu
+   */
+  void determine_gpu_groups(bool use_result_cache);
+
+  /**
+   * \brief store the buffers as half floats when all operations reading them support it
+   * \see MemoryProxy.set_use_half_float
+   */
+  void determine_half_float_proxies();
+
+  /**
+   * \brief calculate the ResultCache keys of the WriteBufferOperation's
+   * and restore the buffers that are cached, their ExecutionGroup's won't be executed.
+   */
+  void restore_cached_results();
+
+  /**
+   * \brief store the executed buffers with a valid ResultCache key
+   */
+  void store_cached_results();
+
+  /**
+   * \brief write the execution statistics of the operations to the nodes they were created for
+   * The time of an ExecutionGroup is divided over the nodes of its operations, as they are
+   * calculated together. Memory is the size of the buffers written by the operations of a node.
+   * \see bNodeExecStats
+   */
+  void update_node_stats();
+
   /* allow the DebugInfo class to look at internals */
   friend class DebugInfo;
 
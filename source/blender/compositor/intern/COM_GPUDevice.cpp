@@ -0,0 +1,368 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#include "COM_GPUDevice.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "BLI_math_base.h"
+#include "BLI_math_vector.h"
+#include "BLI_string.h"
+#include "BLI_utildefines.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "PIL_time.h"
+
+#include "DNA_node_types.h"
+
+#include "DRW_engine.h"
+
+#include "GPU_batch.h"
+#include "GPU_context.h"
+#include "GPU_framebuffer.h"
+#include "GPU_shader.h"
+#include "GPU_state.h"
+#include "GPU_texture.h"
+#include "GPU_vertex_buffer.h"
+
+#include "COM_ExecutionGroup.h"
+#include "COM_MemoryBuffer.h"
+#include "COM_NodeOperation.h"
+#include "COM_ReadBufferOperation.h"
+#include "COM_WriteBufferOperation.h"
+
+/** Width of the textures created by GPUDevice.bind_float_array. */
+#define FLOAT_ARRAY_WIDTH 1024
+
+static const char *gpu_vertex_shader =
+    "in vec2 pos;\n"
+    "void main()\n"
+    "{\n"
+    "  gl_Position = vec4(pos, 0.0, 1.0);\n"
+    "}\n";
+
+static const char *gpu_fragment_library =
+    "out vec4 fragColor;\n"
+    "\n"
+    "vec4 read_input(sampler2D tex)\n"
+    "{\n"
+    "  ivec2 size = textureSize(tex, 0);\n"
+    "  if (size == ivec2(1)) {\n"
+    "    return texelFetch(tex, ivec2(0), 0);\n"
+    "  }\n"
+    "  ivec2 texel = ivec2(gl_FragCoord.xy);\n"
+    "  if (any(greaterThanEqual(texel, size))) {\n"
+    "    return vec4(0.0);\n"
+    "  }\n"
+    "  return texelFetch(tex, texel, 0);\n"
+    "}\n"
+    "\n"
+    "float read_float_array(sampler2D tab, int index)\n"
+    "{\n"
+    "  const int width = " STRINGIFY(FLOAT_ARRAY_WIDTH) ";\n"
+    "  return texelFetch(tab, ivec2(index % width, index / width), 0).r;\n"
+    "}\n";
+
+static eGPUTextureFormat texture_format(int num_channels)
+{
+  return num_channels == 1 ? GPU_R32F : GPU_RGBA32F;
+}
+
+GPUDevice::GPUDevice()
+{
+  this->m_batch = nullptr;
+}
+
+bool GPUDevice::initialize()
+{
+  DRW_opengl_context_enable();
+  if (GPU_context_active_get() == nullptr) {
+    DRW_opengl_context_disable();
+    return false;
+  }
+
+  /* Use a triangle instead of a quad, like DRW_cache_fullscreen_quad_get. */
+  const float pos[3][2] = {{-1.0f, -1.0f}, {3.0f, -1.0f}, {-1.0f, 3.0f}};
+  static GPUVertFormat format = {0};
+  static uint pos_id;
+  if (format.attr_len == 0) {
+    pos_id = GPU_vertformat_attr_add(&format, "pos", GPU_COMP_F32, 2, GPU_FETCH_FLOAT);
+  }
+  GPUVertBuf *vbo = GPU_vertbuf_create_with_format(&format);
+  GPU_vertbuf_data_alloc(vbo, 3);
+  for (int i = 0; i < 3; i++) {
+    GPU_vertbuf_attr_set(vbo, pos_id, i, pos[i]);
+  }
+  this->m_batch = GPU_batch_create_ex(GPU_PRIM_TRIS, vbo, nullptr, GPU_BATCH_OWNS_VBO);
+
+  DRW_opengl_context_disable();
+  return true;
+}
+
+void GPUDevice::deinitialize()
+{
+  DRW_opengl_context_enable();
+  for (auto &item : this->m_shaders) {
+    if (item.second) {
+      GPU_shader_free(item.second);
+    }
+  }
+  this->m_shaders.clear();
+  for (auto &item : this->m_buffer_textures) {
+    GPU_texture_free(item.second);
+  }
+  this->m_buffer_textures.clear();
+  GPU_BATCH_DISCARD_SAFE(this->m_batch);
+  DRW_opengl_context_disable();
+}
+
+void GPUDevice::free_buffer_textures()
+{
+  if (this->m_buffer_textures.empty()) {
+    return;
+  }
+  DRW_opengl_context_enable();
+  for (auto &item : this->m_buffer_textures) {
+    GPU_texture_free(item.second);
+  }
+  this->m_buffer_textures.clear();
+  DRW_opengl_context_disable();
+}
+
+void GPUDevice::execute(WorkPackage *work)
+{
+  const unsigned int chunkNumber = work->getChunkNumber();
+  ExecutionGroup *executionGroup = work->getExecutionGroup();
+  WriteBufferOperation *writeOperation = (WriteBufferOperation *)
+                                             executionGroup->getOutputOperation();
+  MemoryProxy *memoryProxy = writeOperation->getMemoryProxy();
+  const double start_time = PIL_check_seconds_timer();
+
+  DRW_opengl_context_enable();
+  GPU_blend(GPU_BLEND_NONE);
+  GPU_depth_test(GPU_DEPTH_NONE);
+
+  GPUTexture *texture = evaluate(writeOperation->getInput());
+  free_operation_textures(texture);
+  if (texture) {
+    this->m_buffer_textures[memoryProxy] = texture;
+    if (!memoryProxy->is_gpu_only()) {
+      read_back(memoryProxy, texture);
+    }
+  }
+  else {
+    /* A shader failed to compile, calculate the group on the CPU instead.
+     * The buffers it reads have to be available on the CPU for that. */
+    for (NodeOperation *operation : executionGroup->get_operations()) {
+      if (!operation->isReadBufferOperation()) {
+        continue;
+      }
+      MemoryProxy *inputProxy = ((ReadBufferOperation *)operation)->getMemoryProxy();
+      auto found = this->m_buffer_textures.find(inputProxy);
+      if (inputProxy->is_gpu_only() && found != this->m_buffer_textures.end()) {
+        read_back(inputProxy, found->second);
+        inputProxy->set_gpu_only(false);
+      }
+    }
+  }
+
+  DRW_opengl_context_disable();
+
+  if (texture == nullptr) {
+    rcti rect;
+    executionGroup->determineChunkRect(&rect, chunkNumber);
+    writeOperation->executeRegion(&rect, chunkNumber);
+  }
+  else {
+    memoryProxy->getBuffer()->setCreatedState();
+  }
+  executionGroup->set_chunk_execution_time(chunkNumber, PIL_check_seconds_timer() - start_time);
+
+  executionGroup->finalizeChunkExecution(chunkNumber, nullptr);
+}
+
+GPUTexture *GPUDevice::evaluate(NodeOperation *operation)
+{
+  if (operation->isReadBufferOperation()) {
+    return get_buffer_texture(((ReadBufferOperation *)operation)->getMemoryProxy());
+  }
+  auto found = this->m_operation_textures.find(operation);
+  if (found != this->m_operation_textures.end()) {
+    return found->second;
+  }
+
+  const unsigned int num_inputs = operation->getNumberOfInputSockets();
+  std::vector<GPUTexture *> inputs(num_inputs, nullptr);
+  for (unsigned int index = 0; index < num_inputs; index++) {
+    NodeOperationOutput *link = operation->getInputSocket(index)->getLink();
+    if (link) {
+      inputs[index] = evaluate(&link->getOperation());
+      if (inputs[index] == nullptr) {
+        return nullptr;
+      }
+    }
+  }
+
+  GPUShader *shader = get_shader(operation);
+  if (shader == nullptr) {
+    return nullptr;
+  }
+
+  /* Operations without a resolution, like set operations, are a single pixel. */
+  const int width = max_ii(operation->getWidth(), 1);
+  const int height = max_ii(operation->getHeight(), 1);
+  const int num_channels = operation->getOutputSocket()->getDataType() == COM_DT_VALUE ? 1 : 4;
+  GPUTexture *texture = GPU_texture_create_2d(
+      "compositor operation", width, height, 1, texture_format(num_channels), nullptr);
+  this->m_operation_textures[operation] = texture;
+
+  GPUFrameBuffer *framebuffer = nullptr;
+  GPU_framebuffer_ensure_config(&framebuffer,
+                                {GPU_ATTACHMENT_NONE, GPU_ATTACHMENT_TEXTURE(texture)});
+  GPU_framebuffer_bind(framebuffer);
+
+  GPU_batch_set_shader(this->m_batch, shader);
+  for (unsigned int index = 0; index < num_inputs; index++) {
+    char name[16];
+    BLI_snprintf(name, sizeof(name), "input%u", index);
+    const int binding = GPU_shader_get_texture_binding(shader, name);
+    if (binding != -1 && inputs[index]) {
+      GPU_texture_bind(inputs[index], binding);
+    }
+  }
+  operation->setGPUUniforms(this, shader);
+  GPU_batch_draw(this->m_batch);
+
+  GPU_texture_unbind_all();
+  for (GPUTexture *temp_texture : this->m_temp_textures) {
+    GPU_texture_free(temp_texture);
+  }
+  this->m_temp_textures.clear();
+  GPU_framebuffer_restore();
+  GPU_framebuffer_free(framebuffer);
+
+  return texture;
+}
+
+GPUTexture *GPUDevice::get_buffer_texture(MemoryProxy *memoryProxy)
+{
+  auto found = this->m_buffer_textures.find(memoryProxy);
+  if (found != this->m_buffer_textures.end()) {
+    return found->second;
+  }
+
+  MemoryBuffer *buffer = memoryProxy->getBuffer();
+  const int num_channels = buffer->get_num_channels();
+  const size_t num_pixels = (size_t)buffer->getWidth() * buffer->getHeight();
+  const float *data = buffer->getBuffer();
+
+  /* Vectors are padded to rgba, the same as for operations. */
+  std::vector<float> padded;
+  if (num_channels == COM_NUM_CHANNELS_VECTOR) {
+    padded.resize(num_pixels * 4);
+    for (size_t i = 0; i < num_pixels; i++) {
+      copy_v3_v3(&padded[i * 4], &data[i * 3]);
+      padded[i * 4 + 3] = 1.0f;
+    }
+    data = padded.data();
+  }
+
+  GPUTexture *texture = GPU_texture_create_2d("compositor buffer",
+                                              buffer->getWidth(),
+                                              buffer->getHeight(),
+                                              1,
+                                              texture_format(num_channels),
+                                              data);
+  this->m_buffer_textures[memoryProxy] = texture;
+  return texture;
+}
+
+GPUShader *GPUDevice::get_shader(NodeOperation *operation)
+{
+  const char *source = operation->getGPUShaderSource();
+  auto found = this->m_shaders.find(source);
+  if (found != this->m_shaders.end()) {
+    return found->second;
+  }
+
+  GPUShader *shader = GPU_shader_create(gpu_vertex_shader,
+                                        source,
+                                        nullptr,
+                                        gpu_fragment_library,
+                                        nullptr,
+                                        "compositor operation");
+  if (shader == nullptr) {
+    printf("Compositor: failed to compile the GPU shader of %s\n",
+           operation->get_stats_node() ? operation->get_stats_node()->name : "an operation");
+  }
+  this->m_shaders[source] = shader;
+  return shader;
+}
+
+void GPUDevice::read_back(MemoryProxy *memoryProxy, GPUTexture *texture)
+{
+  MemoryBuffer *buffer = memoryProxy->getBuffer();
+  const int num_channels = buffer->get_num_channels();
+  const int texture_channels = num_channels == 1 ? 1 : 4;
+  const int texture_width = GPU_texture_width(texture);
+  const int width = min_ii(buffer->getWidth(), texture_width);
+  const int height = min_ii(buffer->getHeight(), GPU_texture_height(texture));
+
+  float *data = (float *)GPU_texture_read(texture, GPU_DATA_FLOAT, 0);
+  float *result = buffer->getBuffer();
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      memcpy(&result[((size_t)y * buffer->getWidth() + x) * num_channels],
+             &data[((size_t)y * texture_width + x) * texture_channels],
+             sizeof(float) * num_channels);
+    }
+  }
+  MEM_freeN(data);
+}
+
+void GPUDevice::free_operation_textures(GPUTexture *keep)
+{
+  for (auto &item : this->m_operation_textures) {
+    if (item.second != keep) {
+      GPU_texture_free(item.second);
+    }
+  }
+  this->m_operation_textures.clear();
+}
+
+void GPUDevice::bind_float_array(GPUShader *shader,
+                                 const char *name,
+                                 const float *data,
+                                 int length)
+{
+  const int binding = GPU_shader_get_texture_binding(shader, name);
+  if (binding == -1) {
+    return;
+  }
+  const int width = min_ii(max_ii(length, 1), FLOAT_ARRAY_WIDTH);
+  const int height = max_ii((length + FLOAT_ARRAY_WIDTH - 1) / FLOAT_ARRAY_WIDTH, 1);
+  std::vector<float> padded((size_t)width * height, 0.0f);
+  memcpy(padded.data(), data, sizeof(float) * length);
+
+  GPUTexture *texture = GPU_texture_create_2d(
+      "compositor float array", width, height, 1, GPU_R32F, padded.data());
+  GPU_texture_bind(texture, binding);
+  this->m_temp_textures.push_back(texture);
+}
@@ -0,0 +1,137 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include "COM_Device.h"
+
+struct GPUBatch;
+struct GPUShader;
+struct GPUTexture;
+class MemoryProxy;
+class NodeOperation;
+
+/**
+ * \brief device calculating ExecutionGroup's with the GPU module.
+ *
+ * A group is calculated as a single chunk: every operation draws a full screen triangle into a
+ * texture of its resolution, using the fragment shader of NodeOperation.getGPUShaderSource.
+ * Operations of a group are chained on the GPU. The results of WriteBufferOperation's stay
+ * resident as textures until the WorkScheduler is stopped, so groups reading them on this device
+ * don't upload them again. They are only read back into their MemoryBuffer when the CPU needs
+ * them, see MemoryProxy.set_gpu_only.
+ *
+ * The fragment shaders can use:
+ * - `out vec4 fragColor`: the result of the pixel.
+ * - `uniform sampler2D input0`, `input1`...: the inputs of the operation. Values are stored in
+ *   the red channel, vectors in rgb and colors in rgba.
+ * - `vec4 read_input(sampler2D tex)`: read an input at the pixel being calculated. Pixels outside
+ *   of the input are black transparent, like MemoryBuffer.read. An input of a single pixel is a
+ *   constant.
+ * - `float read_float_array(sampler2D tab, int index)`: read an array set with bind_float_array.
+ *
+ * \note GPU calls are done with the draw manager context, see DRW_opengl_context_enable.
+ * \ingroup Execution
+ */
+class GPUDevice : public Device {
+ private:
+  /**
+   * \brief full screen triangle
+   */
+  GPUBatch *m_batch;
+
+  /**
+   * \brief compiled shaders keyed by the static source string, nullptr when compiling failed
+   */
+  std::map<const char *, GPUShader *> m_shaders;
+
+  /**
+   * \brief textures of MemoryProxy's that are resident on the GPU
+   */
+  std::map<MemoryProxy *, GPUTexture *> m_buffer_textures;
+
+  /**
+   * \brief textures of the operations of the ExecutionGroup being executed
+   */
+  std::map<NodeOperation *, GPUTexture *> m_operation_textures;
+
+  /**
+   * \brief textures created by bind_float_array, freed after drawing the operation
+   */
+  std::vector<GPUTexture *> m_temp_textures;
+
+ public:
+  GPUDevice();
+
+  /**
+   * \brief initialize the device
+   * \return false when no GPU context is available, for example when running in background.
+   */
+  bool initialize();
+  void deinitialize();
+
+  /**
+   * \brief execute a WorkPackage
+   * \note the whole ExecutionGroup is calculated, see ExecutionGroup.set_gpu
+   * \param work: the WorkPackage to execute
+   */
+  void execute(WorkPackage *work);
+
+  /**
+   * \brief free the textures of the buffers kept on the GPU
+   * \note called at the end of an execution, before the MemoryProxy's are freed.
+   */
+  void free_buffer_textures();
+
+  /**
+   * \brief bind an array of floats as a sampler of the bound shader, see read_float_array
+   * \note used in NodeOperation.setGPUUniforms for arrays too large for uniforms.
+   */
+  void bind_float_array(GPUShader *shader, const char *name, const float *data, int length);
+
+ private:
+  /**
+   * \brief draw an operation and all operations it depends on within the group
+   * \return the texture with the result, nullptr when a shader failed to compile.
+   */
+  GPUTexture *evaluate(NodeOperation *operation);
+
+  /**
+   * \brief get the texture of a buffer, uploading it when it isn't on the GPU yet
+   */
+  GPUTexture *get_buffer_texture(MemoryProxy *memoryProxy);
+
+  GPUShader *get_shader(NodeOperation *operation);
+
+  /**
+   * \brief copy the texture of a buffer into its MemoryBuffer
+   */
+  void read_back(MemoryProxy *memoryProxy, GPUTexture *texture);
+
+  /**
+   * \brief free the textures of the operations of the group, except keep
+   */
+  void free_operation_textures(GPUTexture *keep);
+
+#ifdef WITH_CXX_GUARDEDALLOC
+  MEM_CXX_CLASS_ALLOC_FUNCS("COM:GPUDevice")
+#endif
+};
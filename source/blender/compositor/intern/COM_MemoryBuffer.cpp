@@ -58,8 +58,18 @@ MemoryBuffer::MemoryBuffer(MemoryProxy *memoryProxy, unsigned int chunkNumber, r
   this->m_memoryProxy = memoryProxy;
   this->m_chunkNumber = chunkNumber;
   this->m_num_channels = determine_num_channels(memoryProxy->getDataType());
-  this->m_buffer = (float *)MEM_mallocN_aligned(
-      sizeof(float) * determineBufferSize() * this->m_num_channels, 16, "COM_MemoryBuffer");
+  if (memoryProxy->use_half_float()) {
+    this->m_buffer = nullptr;
+    this->m_half_buffer = (unsigned short *)MEM_mallocN_aligned(
+        sizeof(unsigned short) * determineBufferSize() * this->m_num_channels,
+        16,
+        "COM_MemoryBuffer");
+  }
+  else {
+    this->m_buffer = (float *)MEM_mallocN_aligned(
+        sizeof(float) * determineBufferSize() * this->m_num_channels, 16, "COM_MemoryBuffer");
+    this->m_half_buffer = nullptr;
+  }
   this->m_state = COM_MB_ALLOCATED;
   this->m_datatype = memoryProxy->getDataType();
 }
@@ -75,6 +85,7 @@ MemoryBuffer::MemoryBuffer(MemoryProxy *memoryProxy, rcti *rect)
   this->m_buffer = (float *)MEM_mallocN_aligned(
       sizeof(float) * determineBufferSize() * this->m_num_channels, 16, "COM_MemoryBuffer");
   this->m_state = COM_MB_TEMPORARILY;
+  this->m_half_buffer = nullptr;
   this->m_datatype = memoryProxy->getDataType();
 }
 MemoryBuffer::MemoryBuffer(DataType dataType, rcti *rect)
@@ -89,27 +100,46 @@ MemoryBuffer::MemoryBuffer(DataType dataType, rcti *rect)
   this->m_buffer = (float *)MEM_mallocN_aligned(
       sizeof(float) * determineBufferSize() * this->m_num_channels, 16, "COM_MemoryBuffer");
   this->m_state = COM_MB_TEMPORARILY;
+  this->m_half_buffer = nullptr;
   this->m_datatype = dataType;
 }
 MemoryBuffer *MemoryBuffer::duplicate()
 {
   MemoryBuffer *result = new MemoryBuffer(this->m_memoryProxy, &this->m_rect);
-  memcpy(result->m_buffer,
-         this->m_buffer,
-         this->determineBufferSize() * this->m_num_channels * sizeof(float));
+  if (this->is_half_float()) {
+    result->copyContentFrom(this);
+  }
+  else {
+    memcpy(result->m_buffer,
+           this->m_buffer,
+           this->determineBufferSize() * this->m_num_channels * sizeof(float));
+  }
   return result;
 }
 void MemoryBuffer::clear()
 {
-  memset(this->m_buffer, 0, this->determineBufferSize() * this->m_num_channels * sizeof(float));
+  memset(this->get_data(), 0, this->get_data_size());
 }
 
 float MemoryBuffer::getMaximumValue()
 {
-  float result = this->m_buffer[0];
   const unsigned int size = this->determineBufferSize();
   unsigned int i;
 
+  if (this->is_half_float()) {
+    float result = half_to_float(this->m_half_buffer[0]);
+    const unsigned short *hp_src = this->m_half_buffer;
+    for (i = 0; i < size; i++, hp_src += this->m_num_channels) {
+      float value = half_to_float(*hp_src);
+      if (value > result) {
+        result = value;
+      }
+    }
+    return result;
+  }
+
+  float result = this->m_buffer[0];
+
   const float *fp_src = this->m_buffer;
 
   for (i = 0; i < size; i++, fp_src += this->m_num_channels) {
@@ -147,6 +177,10 @@ MemoryBuffer::~MemoryBuffer()
     MEM_freeN(this->m_buffer);
     this->m_buffer = nullptr;
   }
+  if (this->m_half_buffer) {
+    MEM_freeN(this->m_half_buffer);
+    this->m_half_buffer = nullptr;
+  }
 }
 
 void MemoryBuffer::copyContentFrom(MemoryBuffer *otherBuffer)
@@ -169,9 +203,25 @@ void MemoryBuffer::copyContentFrom(MemoryBuffer *otherBuffer)
                   this->m_num_channels;
     offset = ((otherY - this->m_rect.ymin) * this->m_width + minX - this->m_rect.xmin) *
              this->m_num_channels;
-    memcpy(&this->m_buffer[offset],
-           &otherBuffer->m_buffer[otherOffset],
-           (maxX - minX) * this->m_num_channels * sizeof(float));
+    const unsigned int length = (maxX - minX) * this->m_num_channels;
+    if (this->m_half_buffer && otherBuffer->m_half_buffer) {
+      memcpy(&this->m_half_buffer[offset],
+             &otherBuffer->m_half_buffer[otherOffset],
+             length * sizeof(unsigned short));
+    }
+    else if (this->m_half_buffer) {
+      for (unsigned int i = 0; i < length; i++) {
+        this->m_half_buffer[offset + i] = float_to_half(otherBuffer->m_buffer[otherOffset + i]);
+      }
+    }
+    else if (otherBuffer->m_half_buffer) {
+      for (unsigned int i = 0; i < length; i++) {
+        this->m_buffer[offset + i] = half_to_float(otherBuffer->m_half_buffer[otherOffset + i]);
+      }
+    }
+    else {
+      memcpy(&this->m_buffer[offset], &otherBuffer->m_buffer[otherOffset], length * sizeof(float));
+    }
   }
 }
 
@@ -181,7 +231,14 @@ void MemoryBuffer::writePixel(int x, int y, const float color[4])
       y < this->m_rect.ymax) {
     const int offset = (this->m_width * (y - this->m_rect.ymin) + x - this->m_rect.xmin) *
                        this->m_num_channels;
-    memcpy(&this->m_buffer[offset], color, sizeof(float) * this->m_num_channels);
+    if (this->m_half_buffer) {
+      for (unsigned int i = 0; i < this->m_num_channels; i++) {
+        this->m_half_buffer[offset + i] = float_to_half(color[i]);
+      }
+    }
+    else {
+      memcpy(&this->m_buffer[offset], color, sizeof(float) * this->m_num_channels);
+    }
   }
 }
 
@@ -191,6 +248,13 @@ void MemoryBuffer::addPixel(int x, int y, const float color[4])
       y < this->m_rect.ymax) {
     const int offset = (this->m_width * (y - this->m_rect.ymin) + x - this->m_rect.xmin) *
                        this->m_num_channels;
+    if (this->m_half_buffer) {
+      unsigned short *dst = &this->m_half_buffer[offset];
+      for (unsigned int i = 0; i < this->m_num_channels; i++) {
+        dst[i] = float_to_half(half_to_float(dst[i]) + color[i]);
+      }
+      return;
+    }
     float *dst = &this->m_buffer[offset];
     const float *src = color;
     for (int i = 0; i < this->m_num_channels; i++, dst++, src++) {
@@ -199,6 +263,92 @@ void MemoryBuffer::addPixel(int x, int y, const float color[4])
   }
 }
 
+void MemoryBuffer::write_row(int x, int y, const float *row, int length)
+{
+  BLI_assert(x >= this->m_rect.xmin && x + length <= this->m_rect.xmax &&
+             y >= this->m_rect.ymin && y < this->m_rect.ymax);
+  const size_t offset = ((size_t)this->m_width * (y - this->m_rect.ymin) + x -
+                         this->m_rect.xmin) *
+                        this->m_num_channels;
+  const size_t size = (size_t)length * this->m_num_channels;
+  if (this->m_half_buffer) {
+    unsigned short *dst = &this->m_half_buffer[offset];
+    for (size_t i = 0; i < size; i++) {
+      dst[i] = float_to_half(row[i]);
+    }
+  }
+  else {
+    memcpy(&this->m_buffer[offset], row, sizeof(float) * size);
+  }
+}
+
+/* Same as BLI_bilinear_interpolation_wrap_fl, reading half floats. */
+void MemoryBuffer::read_bilinear_half(float *result, float u, float v, bool wrap_x, bool wrap_y)
+{
+  const int width = this->m_width;
+  const int height = this->m_height;
+  const int num_channels = this->m_num_channels;
+  int x1 = (int)floorf(u);
+  int x2 = (int)ceilf(u);
+  int y1 = (int)floorf(v);
+  int y2 = (int)ceilf(v);
+
+  /* pixel value must be already wrapped, however values at boundaries may flip */
+  if (wrap_x) {
+    if (x1 < 0) {
+      x1 = width - 1;
+    }
+    if (x2 >= width) {
+      x2 = 0;
+    }
+  }
+  else if (x2 < 0 || x1 >= width) {
+    copy_vn_fl(result, num_channels, 0.0f);
+    return;
+  }
+
+  if (wrap_y) {
+    if (y1 < 0) {
+      y1 = height - 1;
+    }
+    if (y2 >= height) {
+      y2 = 0;
+    }
+  }
+  else if (y2 < 0 || y1 >= height) {
+    copy_vn_fl(result, num_channels, 0.0f);
+    return;
+  }
+
+  /* sample including outside of edges of image */
+  const unsigned short *row1 = (x1 < 0 || y1 < 0) ?
+                                   nullptr :
+                                   &this->m_half_buffer[(width * y1 + x1) * num_channels];
+  const unsigned short *row2 = (x1 < 0 || y2 > height - 1) ?
+                                   nullptr :
+                                   &this->m_half_buffer[(width * y2 + x1) * num_channels];
+  const unsigned short *row3 = (x2 > width - 1 || y1 < 0) ?
+                                   nullptr :
+                                   &this->m_half_buffer[(width * y1 + x2) * num_channels];
+  const unsigned short *row4 = (x2 > width - 1 || y2 > height - 1) ?
+                                   nullptr :
+                                   &this->m_half_buffer[(width * y2 + x2) * num_channels];
+
+  const float a = u - floorf(u);
+  const float b = v - floorf(v);
+  const float a_b = a * b;
+  const float ma_b = (1.0f - a) * b;
+  const float a_mb = a * (1.0f - b);
+  const float ma_mb = (1.0f - a) * (1.0f - b);
+
+  for (int i = 0; i < num_channels; i++) {
+    result[i] = (row1 ? ma_mb * half_to_float(row1[i]) : 0.0f) +
+                (row3 ? a_mb * half_to_float(row3[i]) : 0.0f) +
+                (row2 ? ma_b * half_to_float(row2[i]) : 0.0f) +
+                (row4 ? a_b * half_to_float(row4[i]) : 0.0f);
+  }
+}
+
 static void read_ewa_pixel_sampled(void *userdata, int x, int y, float result[4])
 {
   MemoryBuffer *buffer = (MemoryBuffer *)userdata;
@@ -85,6 +85,12 @@ class MemoryBuffer {
    */
   float *m_buffer;
 
+  /**
+   * \brief the data when the buffer is stored as half floats, m_buffer is nullptr then
+   * \see MemoryProxy.use_half_float
+   */
+  unsigned short *m_half_buffer;
+
   /**
    * \brief the number of channels of a single value in the buffer.
    * For value buffers this is 1, vector 3 and color 4
@@ -131,12 +137,40 @@ class MemoryBuffer {
   /**
    * \brief get the data of this MemoryBuffer
    * \note buffer should already be available in memory
+   * \note not available for half float buffers, use read/write_row instead.
    */
   float *getBuffer()
   {
+    BLI_assert(!is_half_float());
     return this->m_buffer;
   }
 
+  /**
+   * \brief is the data of this MemoryBuffer stored as half floats
+   */
+  bool is_half_float() const
+  {
+    return this->m_half_buffer != nullptr;
+  }
+
+  /**
+   * \brief get the size of the data of this MemoryBuffer in bytes
+   */
+  size_t get_data_size() const
+  {
+    return (is_half_float() ? sizeof(unsigned short) : sizeof(float)) * this->m_num_channels *
+           this->m_width * this->m_height;
+  }
+
+  /**
+   * \brief get the raw data of this MemoryBuffer, float or half float
+   * \see get_data_size
+   */
+  void *get_data()
+  {
+    return is_half_float() ? (void *)this->m_half_buffer : (void *)this->m_buffer;
+  }
+
   /**
    * \brief after execution the state will be set to available by calling this method
    */
@@ -245,8 +279,7 @@ class MemoryBuffer {
       int v = y;
       this->wrap_pixel(u, v, extend_x, extend_y);
       const int offset = (this->m_width * y + x) * this->m_num_channels;
-      float *buffer = &this->m_buffer[offset];
-      memcpy(result, buffer, sizeof(float) * this->m_num_channels);
+      read_offset(result, offset);
     }
   }
 
@@ -271,12 +304,17 @@ class MemoryBuffer {
     BLI_assert((int)(MEM_allocN_len(this->m_buffer) / sizeof(*this->m_buffer)) ==
                (int)(this->determineBufferSize() * COM_NUMBER_OF_CHANNELS));
 #endif
-    float *buffer = &this->m_buffer[offset];
-    memcpy(result, buffer, sizeof(float) * this->m_num_channels);
+    read_offset(result, offset);
   }
 
   void writePixel(int x, int y, const float color[4]);
   void addPixel(int x, int y, const float color[4]);
+
+  /**
+   * \brief write length pixels starting at x, y from a row of floats
+   * \note the row must be inside the rect of this MemoryBuffer
+   */
+  void write_row(int x, int y, const float *row, int length);
   inline void readBilinear(float *result,
                            float x,
                            float y,
@@ -291,6 +329,10 @@ class MemoryBuffer {
       copy_vn_fl(result, this->m_num_channels, 0.0f);
       return;
     }
+    if (is_half_float()) {
+      read_bilinear_half(result, u, v, extend_x == COM_MB_REPEAT, extend_y == COM_MB_REPEAT);
+      return;
+    }
     BLI_bilinear_interpolation_wrap_fl(this->m_buffer,
                                        result,
                                        this->m_width,
@@ -352,6 +394,21 @@ class MemoryBuffer {
  private:
   unsigned int determineBufferSize();
 
+  inline void read_offset(float *result, int offset)
+  {
+    if (this->m_half_buffer) {
+      const unsigned short *buffer = &this->m_half_buffer[offset];
+      for (unsigned int i = 0; i < this->m_num_channels; i++) {
+        result[i] = half_to_float(buffer[i]);
+      }
+    }
+    else {
+      memcpy(result, &this->m_buffer[offset], sizeof(float) * this->m_num_channels);
+    }
+  }
+
+  void read_bilinear_half(float *result, float u, float v, bool wrap_x, bool wrap_y);
+
 #ifdef WITH_CXX_GUARDEDALLOC
   MEM_CXX_CLASS_ALLOC_FUNCS("COM:MemoryBuffer")
 #endif
@@ -23,6 +23,8 @@ MemoryProxy::MemoryProxy(DataType datatype)
   this->m_writeBufferOperation = nullptr;
   this->m_executor = nullptr;
   this->m_datatype = datatype;
+  this->m_use_half_float = false;
+  this->m_gpu_only = false;
 }
 
 void MemoryProxy::allocate(unsigned int width, unsigned int height)
@@ -64,6 +64,16 @@ class MemoryProxy {
    */
   DataType m_datatype;
 
+  /**
+   * \brief store the buffer as half floats
+   */
+  bool m_use_half_float;
+
+  /**
+   * \brief the buffer is only used by ExecutionGroup's calculated by the GPUDevice
+   */
+  bool m_gpu_only;
+
  public:
   MemoryProxy(DataType type);
 
@@ -125,6 +135,36 @@ class MemoryProxy {
     return this->m_datatype;
   }
 
+  /**
+   * \brief store the buffer as half floats, halving its memory usage
+   * \note must be set before allocate. the buffer can then only be accessed via
+   * MemoryBuffer.read and friends, not via MemoryBuffer.getBuffer.
+   */
+  void set_use_half_float(bool use_half_float)
+  {
+    this->m_use_half_float = use_half_float;
+  }
+
+  bool use_half_float() const
+  {
+    return this->m_use_half_float;
+  }
+
+  /**
+   * \brief keep the data written by the GPUDevice on the GPU only
+   * The MemoryBuffer isn't filled then, this is only valid when all groups reading the buffer are
+   * calculated by the GPUDevice and the result isn't cached.
+   */
+  void set_gpu_only(bool gpu_only)
+  {
+    this->m_gpu_only = gpu_only;
+  }
+
+  bool is_gpu_only() const
+  {
+    return this->m_gpu_only;
+  }
+
 #ifdef WITH_CXX_GUARDEDALLOC
   MEM_CXX_CLASS_ALLOC_FUNCS("COM:MemoryProxy")
 #endif
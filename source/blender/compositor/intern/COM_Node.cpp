@@ -40,7 +40,8 @@ Node::Node(bNode *editorNode, bool create_sockets)
     : m_editorNodeTree(nullptr),
       m_editorNode(editorNode),
       m_inActiveGroup(false),
-      m_instanceKey(NODE_INSTANCE_KEY_NONE)
+      m_instanceKey(NODE_INSTANCE_KEY_NONE),
+      m_statsNode(nullptr)
 {
   if (create_sockets) {
     bNodeSocket *input = (bNodeSocket *)editorNode->inputs.first;
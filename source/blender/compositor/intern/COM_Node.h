@@ -72,6 +72,12 @@ class Node {
    */
   bNodeInstanceKey m_instanceKey;
 
+  /**
+   * \brief node of the base tree the execution statistics of this node are added to
+   * This is the node itself, or the group node for nodes inside of groups.
+   */
+  bNode *m_statsNode;
+
  protected:
   /**
    * \brief get access to the vector of input sockets
@@ -228,6 +234,15 @@ class Node {
     return m_instanceKey;
   }
 
+  void set_stats_node(bNode *node)
+  {
+    m_statsNode = node;
+  }
+  bNode *get_stats_node() const
+  {
+    return m_statsNode;
+  }
+
  protected:
   /**
    * \brief add an NodeInput to the collection of inputsockets
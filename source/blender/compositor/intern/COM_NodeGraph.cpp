@@ -37,7 +37,7 @@
  **** NodeGraph ****
  *******************/
 
-NodeGraph::NodeGraph()
+NodeGraph::NodeGraph() : m_stats_node(nullptr)
 {
 }
 
@@ -82,6 +82,7 @@ void NodeGraph::add_node(Node *node,
   node->setbNodeTree(b_ntree);
   node->setInstanceKey(key);
   node->setIsInActiveGroup(is_active_group);
+  node->set_stats_node(m_stats_node);
 
   m_nodes.push_back(node);
 
@@ -109,6 +110,10 @@ void NodeGraph::add_bNodeTree(const CompositorContext &context,
   /* add all nodes of the tree to the node list */
   for (bNode *node = (bNode *)tree->nodes.first; node; node = node->next) {
     bNodeInstanceKey key = BKE_node_instance_key(parent_key, tree, node);
+    if (tree == basetree) {
+      /* Nodes in groups keep the group node of the base tree. */
+      m_stats_node = node;
+    }
     add_bNode(context, tree, node, key, is_active_group);
   }
 
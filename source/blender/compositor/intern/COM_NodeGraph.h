@@ -66,6 +66,8 @@ class NodeGraph {
  private:
   Nodes m_nodes;
   Links m_links;
+  /** Node of the base tree that is being added, see Node.get_stats_node. */
+  bNode *m_stats_node;
 
  public:
   NodeGraph();
@@ -37,6 +37,7 @@ NodeOperation::NodeOperation()
   this->m_isResolutionSet = false;
   this->m_openCL = false;
   this->m_btree = nullptr;
+  this->m_statsNode = nullptr;
 }
 
 NodeOperation::~NodeOperation()
@@ -22,6 +22,7 @@
 #include <sstream>
 #include <string>
 
+#include "BLI_hash_mm2a.h"
 #include "BLI_math_color.h"
 #include "BLI_math_vector.h"
 #include "BLI_threads.h"
@@ -37,6 +38,9 @@ using std::list;
 using std::max;
 using std::min;
 
+struct GPUShader;
+
+class GPUDevice;
 class OpenCLDevice;
 class ReadBufferOperation;
 class WriteBufferOperation;
@@ -68,6 +72,16 @@ typedef enum InputResizeMode {
   COM_SC_STRETCH = NS_CR_STRETCH,
 } InputResizeMode;
 
+/**
+ * \brief input of a row kernel, see NodeOperation.executeRow
+ */
+typedef struct RowInput {
+  /** First element of the row. */
+  const float *data;
+  /** Number of floats between two pixels, zero when the input is constant for the row. */
+  int stride;
+} RowInput;
+
 /**
  * \brief NodeOperation contains calculation logic
  *
@@ -123,6 +137,12 @@ class NodeOperation : public SocketReader {
    */
   bool m_isResolutionSet;
 
+  /**
+   * \brief node the execution statistics of this operation are added to, can be nullptr
+   * \see Node.get_stats_node
+   */
+  bNode *m_statsNode;
+
  public:
   virtual ~NodeOperation();
 
@@ -187,6 +207,16 @@ class NodeOperation : public SocketReader {
   {
     this->m_btree = tree;
   }
+
+  void set_stats_node(bNode *node)
+  {
+    this->m_statsNode = node;
+  }
+  bNode *get_stats_node() const
+  {
+    return this->m_statsNode;
+  }
+
   virtual void initExecution();
 
   /**
@@ -365,6 +395,63 @@ class NodeOperation : public SocketReader {
     return true;
   }
 
+  /**
+   * \brief add the settings the output of this operation depends on to a hash
+   * The type, resolution and inputs of the operation are hashed by the caller.
+   * \note called after initExecution, so settings derived during initialization can be used.
+   * \return false when the output can't be reused between executions, for example because
+   * it depends on data the operation doesn't know about. This is the default.
+   * \see ResultCache
+   */
+  virtual bool hash_params(BLI_HashMurmur2A * /*mm2*/) const
+  {
+    return false;
+  }
+
+  /**
+   * \brief does this operation implement executeRow
+   * Only pixel-local operations, that read each input once at the pixel they calculate, can.
+   * \see RowKernelEvaluator
+   */
+  virtual bool hasRowKernel() const
+  {
+    return false;
+  }
+
+  /**
+   * \brief calculate a row of pixels at once
+   * \param output: num channels of the output socket per pixel, tightly packed.
+   * \param inputs: one RowInput per input socket.
+   * \param length: number of pixels in the row.
+   * \note called after initExecution, from multiple threads at once.
+   */
+  virtual void executeRow(float * /*output*/, const RowInput * /*inputs*/, int /*length*/)
+  {
+  }
+
+  /**
+   * \brief GLSL fragment shader calculating this operation on the GPUDevice
+   * \return a static string, nullptr when the operation can't be calculated on the GPU.
+   * \see GPUDevice for the interface available to the shader.
+   */
+  virtual const char *getGPUShaderSource() const
+  {
+    return nullptr;
+  }
+
+  bool hasGPUShader() const
+  {
+    return getGPUShaderSource() != nullptr;
+  }
+
+  /**
+   * \brief set the uniforms of the shader of getGPUShaderSource, except the inputs
+   * \note called after initExecution, with the shader bound.
+   */
+  virtual void setGPUUniforms(GPUDevice * /*device*/, GPUShader * /*shader*/)
+  {
+  }
+
   inline bool isBraked() const
   {
     return this->m_btree->test_break(this->m_btree->tbh);
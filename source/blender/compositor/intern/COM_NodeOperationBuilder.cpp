@@ -125,6 +125,9 @@ void NodeOperationBuilder::convertToOperations(ExecutionSystem *system)
 
 void NodeOperationBuilder::addOperation(NodeOperation *operation)
 {
+  if (m_current_node) {
+    operation->set_stats_node(m_current_node->get_stats_node());
+  }
   m_operations.push_back(operation);
 }
 
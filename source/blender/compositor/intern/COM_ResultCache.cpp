@@ -0,0 +1,188 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#include "COM_ResultCache.h"
+
+#include <cstring>
+#include <typeinfo>
+
+#include "BLI_hash_mm2a.h"
+#include "BLI_rect.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "COM_MemoryBuffer.h"
+#include "COM_NodeOperation.h"
+#include "COM_ReadBufferOperation.h"
+#include "COM_WriteBufferOperation.h"
+
+struct CachedResult {
+  void *buffer;
+  int width;
+  int height;
+  unsigned int num_channels;
+  bool is_half_float;
+  size_t size;
+  /** Value of the use counter when this result was stored or restored last. */
+  uint64_t last_used;
+};
+
+static std::map<uint32_t, CachedResult> g_results;
+static size_t g_used_memory = 0;
+static size_t g_limit = 0;
+static uint64_t g_use_counter = 0;
+
+static void result_free(std::map<uint32_t, CachedResult>::iterator iter)
+{
+  g_used_memory -= iter->second.size;
+  MEM_freeN(iter->second.buffer);
+  g_results.erase(iter);
+}
+
+static void results_free_until(size_t limit)
+{
+  while (g_used_memory > limit && !g_results.empty()) {
+    auto oldest = g_results.begin();
+    for (auto iter = g_results.begin(); iter != g_results.end(); ++iter) {
+      if (iter->second.last_used < oldest->second.last_used) {
+        oldest = iter;
+      }
+    }
+    result_free(oldest);
+  }
+}
+
+bool ResultCache::operation_hash(NodeOperation *operation, Hashes &hashes, uint32_t *r_hash)
+{
+  Hashes::const_iterator found = hashes.find(operation);
+  if (found != hashes.end()) {
+    *r_hash = found->second.hash;
+    return found->second.valid;
+  }
+
+  /* Mark as invalid while evaluating, so loops in the graph can't recurse infinitely. */
+  hashes[operation] = {false, 0};
+
+  BLI_HashMurmur2A mm2;
+  BLI_hash_mm2a_init(&mm2, 0);
+
+  const char *type_name = typeid(*operation).name();
+  BLI_hash_mm2a_add(&mm2, (const unsigned char *)type_name, strlen(type_name));
+  BLI_hash_mm2a_add_int(&mm2, operation->getWidth());
+  BLI_hash_mm2a_add_int(&mm2, operation->getHeight());
+
+  if (!operation->hash_params(&mm2)) {
+    return false;
+  }
+
+  if (operation->isReadBufferOperation()) {
+    /* Follow the buffer to the operations writing it. */
+    ReadBufferOperation *readOperation = (ReadBufferOperation *)operation;
+    uint32_t write_hash;
+    if (!operation_hash(
+            readOperation->getMemoryProxy()->getWriteBufferOperation(), hashes, &write_hash)) {
+      return false;
+    }
+    BLI_hash_mm2a_add_int(&mm2, (int)write_hash);
+  }
+
+  for (unsigned int index = 0; index < operation->getNumberOfInputSockets(); index++) {
+    NodeOperationOutput *link = operation->getInputSocket(index)->getLink();
+    if (link == nullptr) {
+      BLI_hash_mm2a_add_int(&mm2, 0);
+      continue;
+    }
+    NodeOperation &input_operation = link->getOperation();
+    uint32_t input_hash;
+    if (!operation_hash(&input_operation, hashes, &input_hash)) {
+      return false;
+    }
+    BLI_hash_mm2a_add_int(&mm2, (int)input_hash);
+
+    for (unsigned int output = 0; output < input_operation.getNumberOfOutputSockets(); output++) {
+      if (input_operation.getOutputSocket(output) == link) {
+        BLI_hash_mm2a_add_int(&mm2, output);
+        break;
+      }
+    }
+  }
+
+  *r_hash = BLI_hash_mm2a_end(&mm2);
+  hashes[operation] = {true, *r_hash};
+  return true;
+}
+
+bool ResultCache::restore(uint32_t key, MemoryBuffer *buffer)
+{
+  std::map<uint32_t, CachedResult>::iterator found = g_results.find(key);
+  if (found == g_results.end()) {
+    return false;
+  }
+  CachedResult &result = found->second;
+  if (result.width != buffer->getWidth() || result.height != buffer->getHeight() ||
+      result.num_channels != buffer->get_num_channels() ||
+      result.is_half_float != buffer->is_half_float()) {
+    return false;
+  }
+
+  memcpy(buffer->get_data(), result.buffer, result.size);
+  result.last_used = ++g_use_counter;
+  return true;
+}
+
+void ResultCache::store(uint32_t key, MemoryBuffer *buffer)
+{
+  const size_t size = buffer->get_data_size();
+  if (size == 0 || size > g_limit) {
+    return;
+  }
+
+  std::map<uint32_t, CachedResult>::iterator found = g_results.find(key);
+  if (found != g_results.end()) {
+    result_free(found);
+  }
+  results_free_until(g_limit - size);
+
+  CachedResult result;
+  result.buffer = MEM_mallocN(size, __func__);
+  memcpy(result.buffer, buffer->get_data(), size);
+  result.width = buffer->getWidth();
+  result.height = buffer->getHeight();
+  result.num_channels = buffer->get_num_channels();
+  result.is_half_float = buffer->is_half_float();
+  result.size = size;
+  result.last_used = ++g_use_counter;
+  g_results[key] = result;
+  g_used_memory += size;
+}
+
+void ResultCache::set_limit(size_t limit)
+{
+  g_limit = limit;
+  results_free_until(limit);
+}
+
+size_t ResultCache::get_limit()
+{
+  return g_limit;
+}
+
+void ResultCache::clear()
+{
+  results_free_until(0);
+}
@@ -0,0 +1,81 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+class MemoryBuffer;
+class NodeOperation;
+
+/**
+ * \brief Keeps the results of WriteBufferOperation's between executions of the compositor.
+ *
+ * A result is keyed by a hash of the operation that writes it: the type and settings of every
+ * operation it depends on, up to the input operations (see NodeOperation.hash_params).
+ * When none of them changed, the ExecutionGroup calculating the result is skipped and the cached
+ * buffer is copied into its MemoryProxy instead.
+ *
+ * Least recently used results are freed when the memory limit is exceeded.
+ * \note Access is not thread safe, it is only used from ExecutionSystem.execute, which runs
+ * under the compositor mutex.
+ * \ingroup Execution
+ */
+class ResultCache {
+ public:
+  struct OperationHash {
+    /** False when the result of the operation can't be cached. */
+    bool valid;
+    uint32_t hash;
+  };
+  typedef std::map<NodeOperation *, OperationHash> Hashes;
+
+  /**
+   * \brief calculate the hash of the result of an operation
+   * \note must be called after NodeOperation.initExecution
+   * \param hashes: already calculated hashes, they are reused and new hashes are added.
+   * \return false when the result of the operation can't be cached.
+   */
+  static bool operation_hash(NodeOperation *operation, Hashes &hashes, uint32_t *r_hash);
+
+  /**
+   * \brief copy a cached result into buffer
+   * \return false when there is no result cached for the key that fits in buffer.
+   */
+  static bool restore(uint32_t key, MemoryBuffer *buffer);
+
+  /**
+   * \brief store a copy of buffer as the result for key
+   * Results that are larger than the memory limit are not stored.
+   */
+  static void store(uint32_t key, MemoryBuffer *buffer);
+
+  /**
+   * \brief set the maximum amount of memory in bytes used by cached results
+   * \note a limit of zero disables caching.
+   */
+  static void set_limit(size_t limit);
+  static size_t get_limit();
+
+  /**
+   * \brief free all cached results
+   */
+  static void clear();
+};
@@ -0,0 +1,152 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#include "COM_RowKernelEvaluator.h"
+
+#include "BLI_math_vector.h"
+
+#include "COM_MemoryBuffer.h"
+#include "COM_ReadBufferOperation.h"
+
+static int num_channels_of(DataType datatype)
+{
+  switch (datatype) {
+    case COM_DT_VALUE:
+      return COM_NUM_CHANNELS_VALUE;
+    case COM_DT_VECTOR:
+      return COM_NUM_CHANNELS_VECTOR;
+    case COM_DT_COLOR:
+    default:
+      return COM_NUM_CHANNELS_COLOR;
+  }
+}
+
+RowKernelEvaluator::RowKernelEvaluator(NodeOperation *operation, int max_length)
+{
+  this->m_width = operation->getWidth();
+  this->m_height = operation->getHeight();
+  this->m_max_length = max_length;
+  this->m_valid = operation->hasRowKernel() && add_step(operation) != -1;
+}
+
+int RowKernelEvaluator::add_step(NodeOperation *operation)
+{
+  std::map<NodeOperation *, int>::const_iterator found = this->m_operation_steps.find(operation);
+  if (found != this->m_operation_steps.end()) {
+    return found->second;
+  }
+  if (operation->getWidth() != this->m_width || operation->getHeight() != this->m_height ||
+      operation->getNumberOfOutputSockets() != 1) {
+    return -1;
+  }
+
+  Step step;
+  step.operation = operation;
+  step.num_channels = num_channels_of(operation->getOutputSocket()->getDataType());
+
+  for (unsigned int index = 0; index < operation->getNumberOfInputSockets(); index++) {
+    NodeOperationInput *socket = operation->getInputSocket(index);
+    NodeOperationOutput *link = socket->getLink();
+    if (link == nullptr) {
+      return -1;
+    }
+    NodeOperation &input_operation = link->getOperation();
+
+    StepInput input;
+    input.buffer = nullptr;
+    input.step = -1;
+    input.num_channels = num_channels_of(socket->getDataType());
+    zero_v4(input.constant);
+
+    if (input_operation.isReadBufferOperation()) {
+      ReadBufferOperation *readOperation = (ReadBufferOperation *)&input_operation;
+      MemoryBuffer *buffer = readOperation->getMemoryProxy()->getBuffer();
+      if (readOperation->isSingleValue()) {
+        input.source = ROW_INPUT_CONSTANT;
+        readOperation->readSampled(input.constant, 0, 0, COM_PS_NEAREST);
+      }
+      else if (buffer && !buffer->is_half_float() &&
+               (int)buffer->get_num_channels() == input.num_channels &&
+               buffer->getRect()->xmin == 0 && buffer->getRect()->ymin == 0 &&
+               buffer->getWidth() == this->m_width && buffer->getHeight() == this->m_height) {
+        input.source = ROW_INPUT_BUFFER;
+        input.buffer = buffer;
+      }
+      else {
+        return -1;
+      }
+    }
+    else if (input_operation.isSetOperation()) {
+      input.source = ROW_INPUT_CONSTANT;
+      input_operation.readSampled(input.constant, 0, 0, COM_PS_NEAREST);
+    }
+    else if (input_operation.hasRowKernel()) {
+      input.source = ROW_INPUT_STEP;
+      input.step = add_step(&input_operation);
+      if (input.step == -1 || this->m_steps[input.step].num_channels != input.num_channels) {
+        return -1;
+      }
+    }
+    else {
+      return -1;
+    }
+    step.inputs.push_back(input);
+  }
+
+  step.row_inputs.resize(step.inputs.size());
+  this->m_steps.push_back(step);
+  const int step_index = this->m_steps.size() - 1;
+  this->m_operation_steps[operation] = step_index;
+  return step_index;
+}
+
+void RowKernelEvaluator::execute_row(float *output, int x, int y, int length)
+{
+  BLI_assert(this->m_valid && length <= this->m_max_length);
+  const int last_step = this->m_steps.size() - 1;
+
+  for (int step_index = 0; step_index <= last_step; step_index++) {
+    Step &step = this->m_steps[step_index];
+    for (size_t index = 0; index < step.inputs.size(); index++) {
+      const StepInput &input = step.inputs[index];
+      RowInput &row_input = step.row_inputs[index];
+      switch (input.source) {
+        case ROW_INPUT_BUFFER:
+          row_input.data = input.buffer->getBuffer() +
+                           ((size_t)y * this->m_width + x) * input.num_channels;
+          row_input.stride = input.num_channels;
+          break;
+        case ROW_INPUT_CONSTANT:
+          row_input.data = input.constant;
+          row_input.stride = 0;
+          break;
+        case ROW_INPUT_STEP:
+          row_input.data = this->m_steps[input.step].row.data();
+          row_input.stride = input.num_channels;
+          break;
+      }
+    }
+
+    float *step_output = output;
+    if (step_index != last_step) {
+      step.row.resize((size_t)this->m_max_length * step.num_channels);
+      step_output = step.row.data();
+    }
+    step.operation->executeRow(step_output, step.row_inputs.data(), length);
+  }
+}
@@ -0,0 +1,107 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include "COM_NodeOperation.h"
+
+class MemoryBuffer;
+
+/**
+ * \brief calculates the output of a chain of pixel-local operations a row at a time
+ *
+ * Used by WriteBufferOperation.executeRegion when the operation it writes has a row kernel and
+ * every operation it depends on is either an operation with a row kernel, a set operation or a
+ * ReadBufferOperation of the same resolution. Instead of a virtual readSampled call per input per
+ * pixel, every operation is executed once per row on tightly packed memory.
+ * \ingroup Execution
+ */
+class RowKernelEvaluator {
+ private:
+  typedef enum InputSource {
+    /** Input is read directly from the buffer of a ReadBufferOperation. */
+    ROW_INPUT_BUFFER,
+    /** Input is the same for every pixel. */
+    ROW_INPUT_CONSTANT,
+    /** Input is the output row of another step. */
+    ROW_INPUT_STEP,
+  } InputSource;
+
+  struct StepInput {
+    InputSource source;
+    MemoryBuffer *buffer;
+    int step;
+    int num_channels;
+    float constant[4];
+  };
+
+  struct Step {
+    NodeOperation *operation;
+    std::vector<StepInput> inputs;
+    std::vector<RowInput> row_inputs;
+    /** Output row, not used by the last step which writes to the output directly. */
+    std::vector<float> row;
+    int num_channels;
+  };
+
+  /** Steps in order of execution, the last step is the operation being evaluated. */
+  std::vector<Step> m_steps;
+  std::map<NodeOperation *, int> m_operation_steps;
+  int m_width;
+  int m_height;
+  int m_max_length;
+  bool m_valid;
+
+  int add_step(NodeOperation *operation);
+
+ public:
+  /**
+   * \param operation: the operation to evaluate.
+   * \param max_length: the maximum length of the rows passed to execute_row.
+   */
+  RowKernelEvaluator(NodeOperation *operation, int max_length);
+
+  /**
+   * \brief can the operation and all its inputs be evaluated as rows
+   */
+  bool is_valid() const
+  {
+    return this->m_valid;
+  }
+
+  /**
+   * \brief number of channels of each output pixel
+   */
+  int get_num_channels() const
+  {
+    return this->m_steps.back().num_channels;
+  }
+
+  /**
+   * \brief calculate length pixels starting at x, y
+   * \param output: receives the pixels, tightly packed.
+   */
+  void execute_row(float *output, int x, int y, int length);
+
+#ifdef WITH_CXX_GUARDEDALLOC
+  MEM_CXX_CLASS_ALLOC_FUNCS("COM:RowKernelEvaluator")
+#endif
+};
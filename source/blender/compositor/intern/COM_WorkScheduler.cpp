@@ -20,6 +20,7 @@
 #include <list>
 
 #include "COM_CPUDevice.h"
+#include "COM_GPUDevice.h"
 #include "COM_OpenCLDevice.h"
 #include "COM_OpenCLKernels.cl.h"
 #include "COM_WorkScheduler.h"
@@ -29,6 +30,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "PIL_time.h"
 
@@ -39,6 +41,8 @@
 #    warning COM_CURRENT_THREADING_MODEL COM_TM_NOTHREAD is activated. Use only for debugging.
 #  endif
 #elif COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+/* do nothing */
+#elif COM_CURRENT_THREADING_MODEL == COM_TM_TASK
 /* do nothing - default */
 #else
 #  error COM_CURRENT_THREADING_MODEL No threading model selected
@@ -51,18 +55,35 @@ static ThreadLocal(CPUDevice *) g_thread_device;
 #if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
 /** \brief list of all thread for every CPUDevice in cpudevices a thread exists. */
 static ListBase g_cputhreads;
-static bool g_cpuInitialized = false;
 /** \brief all scheduled work for the cpu */
 static ThreadQueue *g_cpuqueue;
+#elif COM_CURRENT_THREADING_MODEL == COM_TM_TASK
+/**
+ * \brief all scheduled work for the cpu.
+ * The pool is backed by the work-stealing scheduler of the BLI_task system: packages pushed by a
+ * worker thread are executed by that thread first, idle threads steal from busy ones.
+ *
+ * Every thread executing an ExecutionSystem has its own pool, so frames composited in parallel
+ * (see COM_execute_frames) only wait for their own packages, while sharing the worker threads.
+ */
+static thread_local TaskPool *g_cpu_taskpool = nullptr;
+#endif
+
+#if COM_CURRENT_THREADING_MODEL != COM_TM_NOTHREAD
+static bool g_cpuInitialized = false;
 static ThreadQueue *g_gpuqueue;
+/** \brief list of all thread for every GPUDevice in cpudevices a thread exists. */
+static ListBase g_gputhreads;
+/** \brief device calculating groups with the GPU module, nullptr when not available. */
+static GPUDevice *g_gpu_device = nullptr;
+static bool g_gpu_device_active = false;
+static bool g_gpu_device_initialized = false;
 #  ifdef COM_OPENCL_ENABLED
 static cl_context g_context;
 static cl_program g_program;
 /** \brief list of all OpenCLDevices. for every OpenCL GPU device an instance of OpenCLDevice is
  * created. */
 static vector<OpenCLDevice *> g_gpudevices;
-/** \brief list of all thread for every GPUDevice in cpudevices a thread exists. */
-static ListBase g_gputhreads;
 /** \brief all scheduled work for the GPU. */
 static bool g_openclActive = false;
 static bool g_openclInitialized = false;
@@ -82,7 +103,22 @@ void *WorkScheduler::thread_execute_cpu(void *data)
 
   return nullptr;
 }
+#elif COM_CURRENT_THREADING_MODEL == COM_TM_TASK
+void WorkScheduler::thread_execute_task(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  WorkPackage *work = (WorkPackage *)taskdata;
+  CPUDevice device(BLI_task_parallel_thread_id(nullptr));
+  device.execute(work);
+}
+
+static void work_package_free(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  WorkPackage *work = (WorkPackage *)taskdata;
+  delete work;
+}
+#endif
 
+#if COM_CURRENT_THREADING_MODEL != COM_TM_NOTHREAD
 void *WorkScheduler::thread_execute_gpu(void *data)
 {
   Device *device = (Device *)data;
@@ -104,30 +140,48 @@ void WorkScheduler::schedule(ExecutionGroup *group, int chunkNumber)
   CPUDevice device(0);
   device.execute(package);
   delete package;
-#elif COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#else
+  if (group->is_gpu() && g_gpu_device_active) {
+    BLI_thread_queue_push(g_gpuqueue, package);
+    return;
+  }
 #  ifdef COM_OPENCL_ENABLED
   if (group->isOpenCL() && g_openclActive) {
     BLI_thread_queue_push(g_gpuqueue, package);
+    return;
   }
-  else {
-    BLI_thread_queue_push(g_cpuqueue, package);
-  }
-#  else
+#  endif
+#  if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
   BLI_thread_queue_push(g_cpuqueue, package);
+#  elif COM_CURRENT_THREADING_MODEL == COM_TM_TASK
+  BLI_task_pool_push(g_cpu_taskpool, thread_execute_task, package, true, work_package_free);
 #  endif
 #endif
 }
 
 void WorkScheduler::start(CompositorContext &context)
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL != COM_TM_NOTHREAD
   unsigned int index;
+#  if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
   g_cpuqueue = BLI_thread_queue_init();
   BLI_threadpool_init(&g_cputhreads, thread_execute_cpu, g_cpudevices.size());
   for (index = 0; index < g_cpudevices.size(); index++) {
     Device *device = g_cpudevices[index];
     BLI_threadpool_insert(&g_cputhreads, device);
   }
+#  elif COM_CURRENT_THREADING_MODEL == COM_TM_TASK
+  g_cpu_taskpool = BLI_task_pool_create(nullptr, TASK_PRIORITY_HIGH);
+#  endif
+  if (context.getHasActiveGPUDevice()) {
+    g_gpuqueue = BLI_thread_queue_init();
+    BLI_threadpool_init(&g_gputhreads, thread_execute_gpu, 1);
+    BLI_threadpool_insert(&g_gputhreads, g_gpu_device);
+    g_gpu_device_active = true;
+  }
+  else {
+    g_gpu_device_active = false;
+  }
 #  ifdef COM_OPENCL_ENABLED
   if (context.getHasActiveOpenCLDevices()) {
     g_gpuqueue = BLI_thread_queue_init();
@@ -146,27 +200,43 @@ void WorkScheduler::start(CompositorContext &context)
 }
 void WorkScheduler::finish()
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL != COM_TM_NOTHREAD
+  if (g_gpu_device_active) {
+    BLI_thread_queue_wait_finish(g_gpuqueue);
+  }
 #  ifdef COM_OPENCL_ENABLED
   if (g_openclActive) {
     BLI_thread_queue_wait_finish(g_gpuqueue);
-    BLI_thread_queue_wait_finish(g_cpuqueue);
-  }
-  else {
-    BLI_thread_queue_wait_finish(g_cpuqueue);
   }
-#  else
-  BLI_thread_queue_wait_finish(cpuqueue);
+#  endif
+#  if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+  BLI_thread_queue_wait_finish(g_cpuqueue);
+#  elif COM_CURRENT_THREADING_MODEL == COM_TM_TASK
+  /* The calling thread joins the workers until all packages are executed. */
+  BLI_task_pool_work_and_wait(g_cpu_taskpool);
 #  endif
 #endif
 }
 void WorkScheduler::stop()
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL != COM_TM_NOTHREAD
+#  if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
   BLI_thread_queue_nowait(g_cpuqueue);
   BLI_threadpool_end(&g_cputhreads);
   BLI_thread_queue_free(g_cpuqueue);
   g_cpuqueue = nullptr;
+#  elif COM_CURRENT_THREADING_MODEL == COM_TM_TASK
+  BLI_task_pool_free(g_cpu_taskpool);
+  g_cpu_taskpool = nullptr;
+#  endif
+  if (g_gpu_device_active) {
+    BLI_thread_queue_nowait(g_gpuqueue);
+    BLI_threadpool_end(&g_gputhreads);
+    BLI_thread_queue_free(g_gpuqueue);
+    g_gpuqueue = nullptr;
+    g_gpu_device->free_buffer_textures();
+    g_gpu_device_active = false;
+  }
 #  ifdef COM_OPENCL_ENABLED
   if (g_openclActive) {
     BLI_thread_queue_nowait(g_gpuqueue);
@@ -178,9 +248,18 @@ void WorkScheduler::stop()
 #endif
 }
 
+bool WorkScheduler::has_gpu_device()
+{
+#if COM_CURRENT_THREADING_MODEL != COM_TM_NOTHREAD
+  return g_gpu_device != nullptr;
+#else
+  return false;
+#endif
+}
+
 bool WorkScheduler::hasGPUDevices()
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL != COM_TM_NOTHREAD
 #  ifdef COM_OPENCL_ENABLED
   return !g_gpudevices.empty();
 #  else
@@ -191,7 +270,7 @@ bool WorkScheduler::hasGPUDevices()
 #endif
 }
 
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL != COM_TM_NOTHREAD
 static void CL_CALLBACK clContextError(const char *errinfo,
                                        const void * /*private_info*/,
                                        size_t /*cb*/,
@@ -201,9 +280,9 @@ static void CL_CALLBACK clContextError(const char *errinfo,
 }
 #endif
 
-void WorkScheduler::initialize(bool use_opencl, int num_cpu_threads)
+void WorkScheduler::initialize(bool use_opencl, bool use_gpu, int num_cpu_threads)
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL != COM_TM_NOTHREAD
   /* deinitialize if number of threads doesn't match */
   if (g_cpudevices.size() != num_cpu_threads) {
     Device *device;
@@ -231,6 +310,18 @@ void WorkScheduler::initialize(bool use_opencl, int num_cpu_threads)
     g_cpuInitialized = true;
   }
 
+  /* initialize the GPU device, only tried once as there is no context in background mode */
+  if (use_gpu && !g_gpu_device_initialized) {
+    GPUDevice *device = new GPUDevice();
+    if (device->initialize()) {
+      g_gpu_device = device;
+    }
+    else {
+      delete device;
+    }
+    g_gpu_device_initialized = true;
+  }
+
 #  ifdef COM_OPENCL_ENABLED
   /* deinitialize OpenCL GPU's */
   if (use_opencl && !g_openclInitialized) {
@@ -325,7 +416,7 @@ void WorkScheduler::initialize(bool use_opencl, int num_cpu_threads)
 
 void WorkScheduler::deinitialize()
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL != COM_TM_NOTHREAD
   /* deinitialize CPU threads */
   if (g_cpuInitialized) {
     Device *device;
@@ -339,6 +430,13 @@ void WorkScheduler::deinitialize()
     g_cpuInitialized = false;
   }
 
+  if (g_gpu_device) {
+    g_gpu_device->deinitialize();
+    delete g_gpu_device;
+    g_gpu_device = nullptr;
+  }
+  g_gpu_device_initialized = false;
+
 #  ifdef COM_OPENCL_ENABLED
   /* deinitialize OpenCL GPU's */
   if (g_openclInitialized) {
@@ -366,6 +464,10 @@ void WorkScheduler::deinitialize()
 
 int WorkScheduler::current_thread_id()
 {
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
+  return BLI_task_parallel_thread_id(nullptr);
+#else
   CPUDevice *device = (CPUDevice *)BLI_thread_local_get(g_thread_device);
   return device->thread_id();
+#endif
 }
@@ -20,6 +20,7 @@
 
 #include "COM_ExecutionGroup.h"
 
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "COM_Device.h"
@@ -42,6 +43,17 @@ class WorkScheduler {
    * inside this loop new work is queried and being executed
    */
   static void *thread_execute_cpu(void *data);
+#endif
+
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
+  /**
+   * \brief task callback for cpudevices
+   * executes a single WorkPackage pushed to the task pool
+   */
+  static void thread_execute_task(TaskPool *__restrict pool, void *taskdata);
+#endif
+
+#if COM_CURRENT_THREADING_MODEL != COM_TM_NOTHREAD
 
   /**
    * \brief main thread loop for gpudevices
@@ -53,6 +65,7 @@ class WorkScheduler {
   /**
    * \brief schedule a chunk of a group to be calculated.
    * An execution group schedules a chunk in the WorkScheduler
+   * when ExecutionGroup.is_gpu is set the work will be handled by the GPUDevice,
    * when ExecutionGroup.isOpenCL is set the work will be handled by a OpenCLDevice
    * otherwise the work is scheduled for an CPUDevice
    * \see ExecutionGroup.execute
@@ -71,9 +84,11 @@ class WorkScheduler {
    * device a OpenCLDevice is created. these devices are stored in a separate list (cpudevices &
    * gpudevices)
    *
-   * This function can be called multiple times to lazily initialize OpenCL.
+   * When use_gpu is set a GPUDevice is created as well, when a GPU context is available.
+   *
+   * This function can be called multiple times to lazily initialize OpenCL and the GPUDevice.
    */
-  static void initialize(bool use_opencl, int num_cpu_threads);
+  static void initialize(bool use_opencl, bool use_gpu, int num_cpu_threads);
 
   /**
    * \brief deinitialize the WorkScheduler
@@ -85,6 +100,8 @@ class WorkScheduler {
    * \brief Start the execution
    * this methods will start the WorkScheduler. Inside this method all threads are initialized.
    * for every device a thread is created.
+   * \note With COM_TM_TASK the CPU work of start, schedule, finish and stop belongs to the calling
+   * thread, so ExecutionSystem's that only use the CPU can be executed from several threads.
    * \see initialize Initialization and query of the number of devices
    */
   static void start(CompositorContext &context);
@@ -109,6 +126,12 @@ class WorkScheduler {
    */
   static bool hasGPUDevices();
 
+  /**
+   * \brief Is the GPUDevice initialized?
+   * \see CompositorContext.getHasActiveGPUDevice
+   */
+  static bool has_gpu_device();
+
   static int current_thread_id();
 
 #ifdef WITH_CXX_GUARDEDALLOC
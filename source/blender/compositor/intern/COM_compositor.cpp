@@ -16,15 +16,21 @@
  * Copyright 2011, Blender Foundation.
  */
 
+#include "BLI_listbase.h"
+#include "BLI_system.h"
 #include "BLI_threads.h"
 
 #include "BLT_translation.h"
 
+#include "BKE_anim_data.h"
 #include "BKE_node.h"
 #include "BKE_scene.h"
 
+#include "DNA_anim_types.h"
+
 #include "COM_ExecutionSystem.h"
 #include "COM_MovieDistortionOperation.h"
+#include "COM_ResultCache.h"
 #include "COM_WorkScheduler.h"
 #include "COM_compositor.h"
 #include "clew.h"
@@ -32,13 +38,7 @@
 static ThreadMutex s_compositorMutex;
 static bool is_compositorMutex_init = false;
 
-void COM_execute(RenderData *rd,
-                 Scene *scene,
-                 bNodeTree *editingtree,
-                 int rendering,
-                 const ColorManagedViewSettings *viewSettings,
-                 const ColorManagedDisplaySettings *displaySettings,
-                 const char *viewName)
+static void compositor_mutex_lock()
 {
   /* initialize mutex, TODO this mutex init is actually not thread safe and
    * should be done somewhere as part of blender startup, all the other
@@ -49,6 +49,17 @@ void COM_execute(RenderData *rd,
   }
 
   BLI_mutex_lock(&s_compositorMutex);
+}
+
+void COM_execute(RenderData *rd,
+                 Scene *scene,
+                 bNodeTree *editingtree,
+                 int rendering,
+                 const ColorManagedViewSettings *viewSettings,
+                 const ColorManagedDisplaySettings *displaySettings,
+                 const char *viewName)
+{
+  compositor_mutex_lock();
 
   if (editingtree->test_break(editingtree->tbh)) {
     // during editing multiple calls to this method can be triggered.
@@ -78,7 +89,8 @@ void COM_execute(RenderData *rd,
 
   /* initialize workscheduler, will check if already done. TODO deinitialize somewhere */
   bool use_opencl = (editingtree->flag & NTREE_COM_OPENCL) != 0;
-  WorkScheduler::initialize(use_opencl, BKE_render_num_threads(rd));
+  bool use_gpu = (editingtree->flag & NTREE_COM_GPU) != 0;
+  WorkScheduler::initialize(use_opencl, use_gpu, BKE_render_num_threads(rd));
 
   /* set progress bar to 0% and status to init compositing */
   editingtree->progress(editingtree->prh, 0.0);
@@ -87,8 +99,15 @@ void COM_execute(RenderData *rd,
   bool twopass = (editingtree->flag & NTREE_TWO_PASS) && !rendering;
   /* initialize execution system */
   if (twopass) {
-    ExecutionSystem *system = new ExecutionSystem(
-        rd, scene, editingtree, rendering, twopass, viewSettings, displaySettings, viewName);
+    ExecutionSystem *system = new ExecutionSystem(rd,
+                                                  scene,
+                                                  editingtree,
+                                                  rendering,
+                                                  twopass,
+                                                  viewSettings,
+                                                  displaySettings,
+                                                  viewName,
+                                                  nullptr);
     system->execute();
     delete system;
 
@@ -100,19 +119,157 @@ void COM_execute(RenderData *rd,
     }
   }
 
-  ExecutionSystem *system = new ExecutionSystem(
-      rd, scene, editingtree, rendering, false, viewSettings, displaySettings, viewName);
+  ExecutionSystem *system = new ExecutionSystem(rd,
+                                                scene,
+                                                editingtree,
+                                                rendering,
+                                                false,
+                                                viewSettings,
+                                                displaySettings,
+                                                viewName,
+                                                nullptr);
   system->execute();
   delete system;
 
   BLI_mutex_unlock(&s_compositorMutex);
 }
 
+static bool id_is_animated(ID *id)
+{
+  AnimData *adt = BKE_animdata_from_id(id);
+  return adt && (adt->action || !BLI_listbase_is_empty(&adt->drivers));
+}
+
+bool COM_can_execute_frames(bNodeTree *editingtree)
+{
+  /* Animated settings are only evaluated for the current frame of the scene. */
+  if (id_is_animated(&editingtree->id)) {
+    return false;
+  }
+  LISTBASE_FOREACH (bNode *, node, &editingtree->nodes) {
+    if (node->flag & NODE_MUTED) {
+      continue;
+    }
+    /* Render results of other scenes are rendered for the current frame. */
+    if (node->type == CMP_NODE_R_LAYERS) {
+      return false;
+    }
+    if (node->id == nullptr) {
+      continue;
+    }
+    switch (GS(node->id->name)) {
+      case ID_MC:
+      case ID_MSK:
+        /* The operations of movie clips and masks set the frame of the user of the node. */
+        return false;
+      case ID_NT:
+        if (!COM_can_execute_frames((bNodeTree *)node->id)) {
+          return false;
+        }
+        break;
+      default:
+        if (id_is_animated(node->id)) {
+          return false;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+static void *execute_frames_thread(void *data)
+{
+  ThreadQueue *queue = (ThreadQueue *)data;
+  ExecutionSystem *system;
+  while ((system = (ExecutionSystem *)BLI_thread_queue_pop(queue))) {
+    system->execute();
+  }
+  return nullptr;
+}
+
+void COM_execute_frames(RenderData *rd,
+                        Scene *scene,
+                        bNodeTree *editingtree,
+                        const int *frames,
+                        RenderResult **results,
+                        int num_frames,
+                        const ColorManagedViewSettings *viewSettings,
+                        const ColorManagedDisplaySettings *displaySettings,
+                        const char *viewName)
+{
+  compositor_mutex_lock();
+
+  if (editingtree->test_break(editingtree->tbh)) {
+    BLI_mutex_unlock(&s_compositorMutex);
+    return;
+  }
+
+  bool use_opencl = (editingtree->flag & NTREE_COM_OPENCL) != 0;
+  bool use_gpu = (editingtree->flag & NTREE_COM_GPU) != 0;
+  WorkScheduler::initialize(use_opencl, use_gpu, BKE_render_num_threads(rd));
+
+  editingtree->progress(editingtree->prh, 0.0);
+  editingtree->stats_draw(editingtree->sdh, IFACE_("Compositing"));
+
+  /* The systems are created in this thread, converting the nodes sets the frame of their image
+   * users. Every frame has its own copy of the render data with its frame number. */
+  vector<RenderData> frame_rds(num_frames, *rd);
+  vector<ExecutionSystem *> systems;
+  size_t frame_memory = 0;
+  for (int index = 0; index < num_frames; index++) {
+    frame_rds[index].cfra = frames[index];
+    ExecutionSystem *system = new ExecutionSystem(&frame_rds[index],
+                                                  scene,
+                                                  editingtree,
+                                                  true,
+                                                  false,
+                                                  viewSettings,
+                                                  displaySettings,
+                                                  viewName,
+                                                  results[index]);
+    frame_memory = max_zz(frame_memory, system->get_estimated_memory());
+    systems.push_back(system);
+  }
+
+  /* Limit the frames executed at the same time, so their buffers use at most half of the
+   * memory of the system. */
+  int num_threads = min_ii(num_frames, BKE_render_num_threads(rd));
+  const size_t memory_limit = BLI_system_memory_max_in_megabytes() * 1024 * 1024 / 2;
+  if (frame_memory > 0) {
+    num_threads = min_ii(num_threads, max_ii(1, (int)(memory_limit / frame_memory)));
+  }
+#if COM_CURRENT_THREADING_MODEL != COM_TM_TASK
+  /* Only the task pool of the WorkScheduler can be used from several threads. */
+  num_threads = 1;
+#endif
+
+  ThreadQueue *queue = BLI_thread_queue_init();
+  for (ExecutionSystem *system : systems) {
+    BLI_thread_queue_push(queue, system);
+  }
+  BLI_thread_queue_nowait(queue);
+
+  ListBase threads;
+  BLI_threadpool_init(&threads, execute_frames_thread, num_threads);
+  for (int index = 0; index < num_threads; index++) {
+    BLI_threadpool_insert(&threads, queue);
+  }
+  BLI_threadpool_end(&threads);
+  BLI_thread_queue_free(queue);
+
+  for (ExecutionSystem *system : systems) {
+    delete system;
+  }
+
+  BLI_mutex_unlock(&s_compositorMutex);
+}
+
 void COM_deinitialize()
 {
   if (is_compositorMutex_init) {
     BLI_mutex_lock(&s_compositorMutex);
     WorkScheduler::deinitialize();
+    ResultCache::clear();
     is_compositorMutex_init = false;
     BLI_mutex_unlock(&s_compositorMutex);
     BLI_mutex_end(&s_compositorMutex);
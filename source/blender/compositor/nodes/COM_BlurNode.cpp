@@ -29,6 +29,13 @@
 #include "COM_SetValueOperation.h"
 #include "DNA_node_types.h"
 
+/**
+ * Blur radius in pixels from which the gaussian filter is calculated with the recursive filter of
+ * FastGaussianBlurOperation. Its cost doesn't depend on the radius, while the cost of the
+ * separable kernel grows linearly with it.
+ */
+#define BLUR_RECURSIVE_GAUSS_MIN_RADIUS 64
+
 BlurNode::BlurNode(bNode *editorNode) : Node(editorNode)
 {
   /* pass */
@@ -48,10 +55,21 @@ void BlurNode::convertToOperations(NodeConverter &converter,
   CompositorQuality quality = context.getQuality();
   NodeOperation *input_operation = nullptr, *output_operation = nullptr;
 
-  if (data->filtertype == R_FILTER_FAST_GAUSS) {
+  /* Relative sizes depend on the resolution of the input, which isn't known yet. */
+  const bool use_recursive_gauss = data->filtertype == R_FILTER_GAUSS && !data->bokeh &&
+                                   !data->relative && !connectedSizeSocket &&
+                                   !(editorNode->custom1 & CMP_NODEFLAG_BLUR_VARIABLE_SIZE) &&
+                                   max_ii(data->sizex, data->sizey) * size >=
+                                       BLUR_RECURSIVE_GAUSS_MIN_RADIUS;
+
+  if (data->filtertype == R_FILTER_FAST_GAUSS || use_recursive_gauss) {
     FastGaussianBlurOperation *operationfgb = new FastGaussianBlurOperation();
     operationfgb->setData(data);
     operationfgb->setExtendBounds(extend_bounds);
+    if (use_recursive_gauss) {
+      operationfgb->setSize(size);
+      operationfgb->set_sigma_factor(FAST_GAUSS_SIGMA_FACTOR_GAUSS);
+    }
     converter.addOperation(operationfgb);
 
     converter.mapInputSocket(getInputSocket(1), operationfgb->getInputSocket(1));
@@ -17,6 +17,7 @@
  */
 
 #include "COM_ImageNode.h"
+#include "BKE_image.h"
 #include "BKE_node.h"
 #include "BLI_utildefines.h"
 #include "COM_ConvertOperation.h"
@@ -93,6 +94,18 @@ void ImageNode::convertToOperations(NodeConverter &converter,
 
         is_multilayer_ok = true;
 
+        /* Passes are loaded without pixels, read the used ones together so the file is only
+         * decoded once. The first output is also used for the preview. */
+        std::vector<const char *> pass_names;
+        for (index = 0; index < numberOfOutputs; index++) {
+          bNodeSocket *bnodeSocket = this->getOutputSocket(index)->getbNodeSocket();
+          if (index == 0 || (bnodeSocket->flag & SOCK_IN_USE)) {
+            pass_names.push_back(((NodeImageLayer *)bnodeSocket->storage)->pass_name);
+          }
+        }
+        BKE_image_multilayer_ensure_passes(
+            image, imageuser, rl->name, pass_names.data(), (int)pass_names.size());
+
         for (index = 0; index < numberOfOutputs; index++) {
           NodeOperation *operation = nullptr;
           socket = this->getOutputSocket(index);
@@ -34,8 +34,9 @@ void SplitViewerNode::convertToOperations(NodeConverter &converter,
                                           const CompositorContext &context) const
 {
   bNode *editorNode = this->getbNode();
+  /* Frames composited in parallel don't update the viewer image. */
   bool do_output = (editorNode->flag & NODE_DO_OUTPUT_RECALC || context.isRendering()) &&
-                   (editorNode->flag & NODE_DO_OUTPUT);
+                   (editorNode->flag & NODE_DO_OUTPUT) && !context.getRenderResult();
 
   NodeInput *image1Socket = this->getInputSocket(0);
   NodeInput *image2Socket = this->getInputSocket(1);
@@ -34,8 +34,9 @@ void ViewerNode::convertToOperations(NodeConverter &converter,
                                      const CompositorContext &context) const
 {
   bNode *editorNode = this->getbNode();
+  /* Frames composited in parallel don't update the viewer image. */
   bool do_output = (editorNode->flag & NODE_DO_OUTPUT_RECALC || context.isRendering()) &&
-                   (editorNode->flag & NODE_DO_OUTPUT);
+                   (editorNode->flag & NODE_DO_OUTPUT) && !context.getRenderResult();
   bool ignore_alpha = (editorNode->custom2 & CMP_NODE_OUTPUT_IGNORE_ALPHA) != 0;
 
   NodeInput *imageSocket = this->getInputSocket(0);
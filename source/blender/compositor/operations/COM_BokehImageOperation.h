@@ -137,6 +137,12 @@ class BokehImageOperation : public NodeOperation {
     this->m_data = data;
   }
 
+  bool hash_params(BLI_HashMurmur2A *mm2) const
+  {
+    BLI_hash_mm2a_add(mm2, (const unsigned char *)this->m_data, sizeof(NodeBokehImage));
+    return true;
+  }
+
   /**
    * \brief deleteDataOnFinish
    *
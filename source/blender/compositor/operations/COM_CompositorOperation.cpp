@@ -50,6 +50,7 @@ CompositorOperation::CompositorOperation()
   this->m_scene = nullptr;
   this->m_sceneName[0] = '\0';
   this->m_viewName = nullptr;
+  this->m_renderResult = nullptr;
 }
 
 void CompositorOperation::initExecution()
@@ -78,7 +79,20 @@ void CompositorOperation::deinitExecution()
     return;
   }
 
-  if (!isBraked()) {
+  if (!isBraked() && this->m_renderResult) {
+    /* The result of a frame is owned by the caller, nothing else accesses it yet. */
+    RenderView *rv = RE_RenderViewGetByName(this->m_renderResult, this->m_viewName);
+    if (rv->rectf != nullptr) {
+      MEM_freeN(rv->rectf);
+    }
+    rv->rectf = this->m_outputBuffer;
+    if (rv->rectz != nullptr) {
+      MEM_freeN(rv->rectz);
+    }
+    rv->rectz = this->m_depthBuffer;
+    this->m_renderResult->have_combined = true;
+  }
+  else if (!isBraked()) {
     Render *re = RE_GetSceneRender(this->m_scene);
     RenderResult *rr = RE_AcquireResultWrite(re);
 
@@ -225,7 +239,11 @@ void CompositorOperation::determineResolution(unsigned int resolution[2],
   // check actual render resolution with cropping it may differ with cropped border.rendering
   // FIX for: [31777] Border Crop gives black (easy)
   Render *re = RE_GetSceneRender(this->m_scene);
-  if (re) {
+  if (this->m_renderResult) {
+    width = this->m_renderResult->rectx;
+    height = this->m_renderResult->recty;
+  }
+  else if (re) {
     RenderResult *rr = RE_AcquireResultRead(re);
     if (rr) {
       width = rr->rectx;
@@ -22,6 +22,7 @@
 #include "BLI_string.h"
 #include "COM_NodeOperation.h"
 
+struct RenderResult;
 struct Scene;
 
 /**
@@ -80,6 +81,11 @@ class CompositorOperation : public NodeOperation {
    */
   const char *m_viewName;
 
+  /**
+   * \brief result to write to, nullptr for the result of the scene render
+   */
+  RenderResult *m_renderResult;
+
  public:
   CompositorOperation();
   bool isActiveCompositorOutput() const
@@ -103,6 +109,10 @@ class CompositorOperation : public NodeOperation {
   {
     this->m_rd = rd;
   }
+  void setRenderResult(RenderResult *renderResult)
+  {
+    this->m_renderResult = renderResult;
+  }
   bool isOutputOperation(bool /*rendering*/) const
   {
     return this->isActiveCompositorOutput();
@@ -80,4 +80,18 @@ class ConvertDepthToRadiusOperation : public NodeOperation {
   {
     this->m_blurPostOperation = operation;
   }
+
+  bool hash_params(BLI_HashMurmur2A *mm2) const
+  {
+    /* Camera settings are read in initExecution. */
+    const float params[7] = {this->m_fStop,
+                             this->m_aspect,
+                             this->m_maxRadius,
+                             this->m_inverseFocalDistance,
+                             this->m_aperture,
+                             this->m_cam_lens,
+                             this->m_dof_sp};
+    BLI_hash_mm2a_add(mm2, (const unsigned char *)params, sizeof(params));
+    return true;
+  }
 };
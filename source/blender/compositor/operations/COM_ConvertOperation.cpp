@@ -20,6 +20,8 @@
 
 #include "IMB_colormanagement.h"
 
+#include "GPU_shader.h"
+
 ConvertBaseOperation::ConvertBaseOperation()
 {
   this->m_inputOperation = nullptr;
@@ -54,6 +56,25 @@ void ConvertValueToColorOperation::executePixelSampled(float output[4],
   output[3] = 1.0f;
 }
 
+void ConvertValueToColorOperation::executeRow(float *output, const RowInput *inputs, int length)
+{
+  const float *input = inputs[0].data;
+  const int stride = inputs[0].stride;
+  for (int i = 0; i < length; i++, output += 4) {
+    output[0] = output[1] = output[2] = input[i * stride];
+    output[3] = 1.0f;
+  }
+}
+
+const char *ConvertValueToColorOperation::getGPUShaderSource() const
+{
+  return "uniform sampler2D input0;\n"
+         "void main()\n"
+         "{\n"
+         "  fragColor = vec4(vec3(read_input(input0).r), 1.0);\n"
+         "}\n";
+}
+
 /* ******** Color to Value ******** */
 
 ConvertColorToValueOperation::ConvertColorToValueOperation() : ConvertBaseOperation()
@@ -72,6 +93,25 @@ void ConvertColorToValueOperation::executePixelSampled(float output[4],
   output[0] = (inputColor[0] + inputColor[1] + inputColor[2]) / 3.0f;
 }
 
+void ConvertColorToValueOperation::executeRow(float *output, const RowInput *inputs, int length)
+{
+  const float *input = inputs[0].data;
+  const int stride = inputs[0].stride;
+  for (int i = 0; i < length; i++) {
+    const float *color = &input[i * stride];
+    output[i] = (color[0] + color[1] + color[2]) / 3.0f;
+  }
+}
+
+const char *ConvertColorToValueOperation::getGPUShaderSource() const
+{
+  return "uniform sampler2D input0;\n"
+         "void main()\n"
+         "{\n"
+         "  fragColor = vec4(dot(read_input(input0).rgb, vec3(1.0 / 3.0)), 0.0, 0.0, 1.0);\n"
+         "}\n";
+}
+
 /* ******** Color to BW ******** */
 
 ConvertColorToBWOperation::ConvertColorToBWOperation() : ConvertBaseOperation()
@@ -90,6 +130,38 @@ void ConvertColorToBWOperation::executePixelSampled(float output[4],
   output[0] = IMB_colormanagement_get_luminance(inputColor);
 }
 
+void ConvertColorToBWOperation::executeRow(float *output, const RowInput *inputs, int length)
+{
+  const float *input = inputs[0].data;
+  const int stride = inputs[0].stride;
+  for (int i = 0; i < length; i++) {
+    output[i] = IMB_colormanagement_get_luminance(&input[i * stride]);
+  }
+}
+
+const char *ConvertColorToBWOperation::getGPUShaderSource() const
+{
+  return "uniform sampler2D input0;\n"
+         "uniform vec3 luminance_coefficients;\n"
+         "void main()\n"
+         "{\n"
+         "  float value = dot(read_input(input0).rgb, luminance_coefficients);\n"
+         "  fragColor = vec4(value, 0.0, 0.0, 1.0);\n"
+         "}\n";
+}
+
+void ConvertColorToBWOperation::setGPUUniforms(GPUDevice * /*device*/, GPUShader *shader)
+{
+  /* The luminance of the primaries are the coefficients of the scene linear color space. */
+  const float red[3] = {1.0f, 0.0f, 0.0f};
+  const float green[3] = {0.0f, 1.0f, 0.0f};
+  const float blue[3] = {0.0f, 0.0f, 1.0f};
+  const float coefficients[3] = {IMB_colormanagement_get_luminance(red),
+                                 IMB_colormanagement_get_luminance(green),
+                                 IMB_colormanagement_get_luminance(blue)};
+  GPU_shader_uniform_3fv(shader, "luminance_coefficients", coefficients);
+}
+
 /* ******** Color to Vector ******** */
 
 ConvertColorToVectorOperation::ConvertColorToVectorOperation() : ConvertBaseOperation()
@@ -108,6 +180,24 @@ void ConvertColorToVectorOperation::executePixelSampled(float output[4],
   copy_v3_v3(output, color);
 }
 
+void ConvertColorToVectorOperation::executeRow(float *output, const RowInput *inputs, int length)
+{
+  const float *input = inputs[0].data;
+  const int stride = inputs[0].stride;
+  for (int i = 0; i < length; i++, output += 3) {
+    copy_v3_v3(output, &input[i * stride]);
+  }
+}
+
+const char *ConvertColorToVectorOperation::getGPUShaderSource() const
+{
+  return "uniform sampler2D input0;\n"
+         "void main()\n"
+         "{\n"
+         "  fragColor = vec4(read_input(input0).rgb, 1.0);\n"
+         "}\n";
+}
+
 /* ******** Value to Vector ******** */
 
 ConvertValueToVectorOperation::ConvertValueToVectorOperation() : ConvertBaseOperation()
@@ -126,6 +216,24 @@ void ConvertValueToVectorOperation::executePixelSampled(float output[4],
   output[0] = output[1] = output[2] = value;
 }
 
+void ConvertValueToVectorOperation::executeRow(float *output, const RowInput *inputs, int length)
+{
+  const float *input = inputs[0].data;
+  const int stride = inputs[0].stride;
+  for (int i = 0; i < length; i++, output += 3) {
+    output[0] = output[1] = output[2] = input[i * stride];
+  }
+}
+
+const char *ConvertValueToVectorOperation::getGPUShaderSource() const
+{
+  return "uniform sampler2D input0;\n"
+         "void main()\n"
+         "{\n"
+         "  fragColor = vec4(vec3(read_input(input0).r), 1.0);\n"
+         "}\n";
+}
+
 /* ******** Vector to Color ******** */
 
 ConvertVectorToColorOperation::ConvertVectorToColorOperation() : ConvertBaseOperation()
@@ -143,6 +251,25 @@ void ConvertVectorToColorOperation::executePixelSampled(float output[4],
   output[3] = 1.0f;
 }
 
+void ConvertVectorToColorOperation::executeRow(float *output, const RowInput *inputs, int length)
+{
+  const float *input = inputs[0].data;
+  const int stride = inputs[0].stride;
+  for (int i = 0; i < length; i++, output += 4) {
+    copy_v3_v3(output, &input[i * stride]);
+    output[3] = 1.0f;
+  }
+}
+
+const char *ConvertVectorToColorOperation::getGPUShaderSource() const
+{
+  return "uniform sampler2D input0;\n"
+         "void main()\n"
+         "{\n"
+         "  fragColor = vec4(read_input(input0).rgb, 1.0);\n"
+         "}\n";
+}
+
 /* ******** Vector to Value ******** */
 
 ConvertVectorToValueOperation::ConvertVectorToValueOperation() : ConvertBaseOperation()
@@ -161,6 +288,25 @@ void ConvertVectorToValueOperation::executePixelSampled(float output[4],
   output[0] = (input[0] + input[1] + input[2]) / 3.0f;
 }
 
+void ConvertVectorToValueOperation::executeRow(float *output, const RowInput *inputs, int length)
+{
+  const float *input = inputs[0].data;
+  const int stride = inputs[0].stride;
+  for (int i = 0; i < length; i++) {
+    const float *vector = &input[i * stride];
+    output[i] = (vector[0] + vector[1] + vector[2]) / 3.0f;
+  }
+}
+
+const char *ConvertVectorToValueOperation::getGPUShaderSource() const
+{
+  return "uniform sampler2D input0;\n"
+         "void main()\n"
+         "{\n"
+         "  fragColor = vec4(dot(read_input(input0).rgb, vec3(1.0 / 3.0)), 0.0, 0.0, 1.0);\n"
+         "}\n";
+}
+
 /* ******** RGB to YCC ******** */
 
 ConvertRGBToYCCOperation::ConvertRGBToYCCOperation() : ConvertBaseOperation()
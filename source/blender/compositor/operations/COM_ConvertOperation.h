@@ -36,6 +36,12 @@ class ConvertValueToColorOperation : public ConvertBaseOperation {
   ConvertValueToColorOperation();
 
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  bool hasRowKernel() const
+  {
+    return true;
+  }
+  void executeRow(float *output, const RowInput *inputs, int length);
+  const char *getGPUShaderSource() const;
 };
 
 class ConvertColorToValueOperation : public ConvertBaseOperation {
@@ -43,6 +49,12 @@ class ConvertColorToValueOperation : public ConvertBaseOperation {
   ConvertColorToValueOperation();
 
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  bool hasRowKernel() const
+  {
+    return true;
+  }
+  void executeRow(float *output, const RowInput *inputs, int length);
+  const char *getGPUShaderSource() const;
 };
 
 class ConvertColorToBWOperation : public ConvertBaseOperation {
@@ -50,6 +62,13 @@ class ConvertColorToBWOperation : public ConvertBaseOperation {
   ConvertColorToBWOperation();
 
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  bool hasRowKernel() const
+  {
+    return true;
+  }
+  void executeRow(float *output, const RowInput *inputs, int length);
+  const char *getGPUShaderSource() const;
+  void setGPUUniforms(GPUDevice *device, GPUShader *shader);
 };
 
 class ConvertColorToVectorOperation : public ConvertBaseOperation {
@@ -57,6 +76,12 @@ class ConvertColorToVectorOperation : public ConvertBaseOperation {
   ConvertColorToVectorOperation();
 
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  bool hasRowKernel() const
+  {
+    return true;
+  }
+  void executeRow(float *output, const RowInput *inputs, int length);
+  const char *getGPUShaderSource() const;
 };
 
 class ConvertValueToVectorOperation : public ConvertBaseOperation {
@@ -64,6 +89,12 @@ class ConvertValueToVectorOperation : public ConvertBaseOperation {
   ConvertValueToVectorOperation();
 
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  bool hasRowKernel() const
+  {
+    return true;
+  }
+  void executeRow(float *output, const RowInput *inputs, int length);
+  const char *getGPUShaderSource() const;
 };
 
 class ConvertVectorToColorOperation : public ConvertBaseOperation {
@@ -71,6 +102,12 @@ class ConvertVectorToColorOperation : public ConvertBaseOperation {
   ConvertVectorToColorOperation();
 
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  bool hasRowKernel() const
+  {
+    return true;
+  }
+  void executeRow(float *output, const RowInput *inputs, int length);
+  const char *getGPUShaderSource() const;
 };
 
 class ConvertVectorToValueOperation : public ConvertBaseOperation {
@@ -78,6 +115,12 @@ class ConvertVectorToValueOperation : public ConvertBaseOperation {
   ConvertVectorToValueOperation();
 
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  bool hasRowKernel() const
+  {
+    return true;
+  }
+  void executeRow(float *output, const RowInput *inputs, int length);
+  const char *getGPUShaderSource() const;
 };
 
 class ConvertRGBToYCCOperation : public ConvertBaseOperation {
@@ -51,6 +51,12 @@ class DenoiseOperation : public SingleThreadedOperation {
   {
     this->m_settings = settings;
   }
+
+  bool hash_params(BLI_HashMurmur2A *mm2) const
+  {
+    BLI_hash_mm2a_add_int(mm2, this->m_settings ? this->m_settings->hdr : 0);
+    return true;
+  }
   bool determineDependingAreaOfInterest(rcti *input,
                                         ReadBufferOperation *readOperation,
                                         rcti *output);
@@ -26,6 +26,7 @@ class FastGaussianBlurOperation : public BlurBaseOperation {
   float m_sx;
   float m_sy;
   MemoryBuffer *m_iirgaus;
+  float m_sigma_factor;
 
  public:
   FastGaussianBlurOperation();
@@ -38,8 +39,21 @@ class FastGaussianBlurOperation : public BlurBaseOperation {
   void *initializeTileData(rcti *rect);
   void deinitExecution();
   void initExecution();
+
+  /**
+   * \brief set the standard deviation of the filter relative to the blur size
+   * The fast gaussian filter type uses half the size, FAST_GAUSS_SIGMA_FACTOR_GAUSS matches the
+   * kernel of the gaussian filter type (see RE_filter_value).
+   */
+  void set_sigma_factor(float factor)
+  {
+    this->m_sigma_factor = factor;
+  }
 };
 
+/** Sigma factor approximating the R_FILTER_GAUSS kernel, which is cut off at 3 sigma. */
+#define FAST_GAUSS_SIGMA_FACTOR_GAUSS (1.0f / 3.0f)
+
 enum {
   FAST_GAUSS_OVERLAY_MIN = -1,
   FAST_GAUSS_OVERLAY_NONE = 0,
@@ -78,4 +92,11 @@ class FastGaussianBlurValueOperation : public NodeOperation {
   {
     this->m_overlay = overlay;
   }
+
+  bool hash_params(BLI_HashMurmur2A *mm2) const
+  {
+    BLI_hash_mm2a_add(mm2, (const unsigned char *)&this->m_sigma, sizeof(float));
+    BLI_hash_mm2a_add_int(mm2, this->m_overlay);
+    return true;
+  }
 };
@@ -30,6 +30,11 @@ class GammaCorrectOperation : public NodeOperation {
  public:
   GammaCorrectOperation();
 
+  bool hash_params(BLI_HashMurmur2A * /*mm2*/) const
+  {
+    return true;
+  }
+
   /**
    * The inner loop of this operation.
    */
@@ -56,6 +61,11 @@ class GammaUncorrectOperation : public NodeOperation {
  public:
   GammaUncorrectOperation();
 
+  bool hash_params(BLI_HashMurmur2A * /*mm2*/) const
+  {
+    return true;
+  }
+
   /**
    * The inner loop of this operation.
    */
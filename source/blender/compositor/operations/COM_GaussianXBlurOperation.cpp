@@ -18,7 +18,9 @@
 
 #include "COM_GaussianXBlurOperation.h"
 #include "BLI_math.h"
+#include "COM_GPUDevice.h"
 #include "COM_OpenCLDevice.h"
+#include "GPU_shader.h"
 #include "MEM_guardedalloc.h"
 
 #include "RE_pipeline.h"
@@ -154,6 +156,41 @@ void GaussianXBlurOperation::executeOpenCL(OpenCLDevice *device,
   clReleaseMemObject(gausstab);
 }
 
+const char *GaussianXBlurOperation::getGPUShaderSource() const
+{
+  /* The filter size depends on the size input, which is only known here when it's constant. */
+  if (!this->m_sizeavailable) {
+    return nullptr;
+  }
+  return "uniform sampler2D input0;\n"
+         "uniform sampler2D gausstab;\n"
+         "uniform int filter_size;\n"
+         "uniform int step;\n"
+         "void main()\n"
+         "{\n"
+         "  ivec2 pixel = ivec2(gl_FragCoord.xy);\n"
+         "  int size = textureSize(input0, 0).x;\n"
+         "  int nmin = max(pixel.x - filter_size, 0);\n"
+         "  int nmax = min(pixel.x + filter_size + 1, size);\n"
+         "  vec4 color_accum = vec4(0.0);\n"
+         "  float multiplier_accum = 0.0;\n"
+         "  for (int n = nmin, index = (nmin - pixel.x) + filter_size; n < nmax;\n"
+         "       n += step, index += step) {\n"
+         "    float multiplier = read_float_array(gausstab, index);\n"
+         "    color_accum += texelFetch(input0, ivec2(n, pixel.y), 0) * multiplier;\n"
+         "    multiplier_accum += multiplier;\n"
+         "  }\n"
+         "  fragColor = color_accum / multiplier_accum;\n"
+         "}\n";
+}
+
+void GaussianXBlurOperation::setGPUUniforms(GPUDevice *device, GPUShader *shader)
+{
+  device->bind_float_array(shader, "gausstab", this->m_gausstab, this->m_filtersize * 2 + 1);
+  GPU_shader_uniform_1i(shader, "filter_size", this->m_filtersize);
+  GPU_shader_uniform_1i(shader, "step", getStep());
+}
+
 void GaussianXBlurOperation::deinitExecution()
 {
   BlurBaseOperation::deinitExecution();
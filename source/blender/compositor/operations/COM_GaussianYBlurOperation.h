@@ -45,6 +45,9 @@ class GaussianYBlurOperation : public BlurBaseOperation {
                      list<cl_mem> *clMemToCleanUp,
                      list<cl_kernel> *clKernelsToCleanUp);
 
+  const char *getGPUShaderSource() const;
+  void setGPUUniforms(GPUDevice *device, GPUShader *shader);
+
   /**
    * \brief initialize the execution
    */
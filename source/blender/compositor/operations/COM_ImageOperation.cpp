@@ -37,7 +37,7 @@ BaseImageOperation::BaseImageOperation()
   this->m_buffer = nullptr;
   this->m_imageFloatBuffer = nullptr;
   this->m_imageByteBuffer = nullptr;
-  this->m_imageUser = nullptr;
+  memset(&this->m_imageUser, 0, sizeof(ImageUser));
   this->m_imagewidth = 0;
   this->m_imageheight = 0;
   this->m_framenumber = 0;
@@ -62,7 +62,7 @@ ImageDepthOperation::ImageDepthOperation() : BaseImageOperation()
 ImBuf *BaseImageOperation::getImBuf()
 {
   ImBuf *ibuf;
-  ImageUser iuser = *this->m_imageUser;
+  ImageUser iuser = this->m_imageUser;
 
   if (this->m_image == nullptr) {
     return nullptr;
@@ -22,6 +22,7 @@
 #include "BLI_listbase.h"
 #include "BLI_utildefines.h"
 #include "COM_NodeOperation.h"
+#include "DNA_image_types.h"
 #include "MEM_guardedalloc.h"
 
 #include "RE_pipeline.h"
@@ -34,7 +35,11 @@ class BaseImageOperation : public NodeOperation {
  protected:
   ImBuf *m_buffer;
   Image *m_image;
-  ImageUser *m_imageUser;
+  /**
+   * Copy of the ImageUser of the node, with the frame of this execution. Operations of frames
+   * that are calculated in parallel each use their own copy.
+   */
+  ImageUser m_imageUser;
   float *m_imageFloatBuffer;
   unsigned int *m_imageByteBuffer;
   float *m_depthBuffer;
@@ -60,9 +65,9 @@ class BaseImageOperation : public NodeOperation {
   {
     this->m_image = image;
   }
-  void setImageUser(ImageUser *imageuser)
+  void setImageUser(const ImageUser *imageuser)
   {
-    this->m_imageUser = imageuser;
+    this->m_imageUser = *imageuser;
   }
   void setRenderData(const RenderData *rd)
   {
@@ -20,6 +20,8 @@
 
 #include "BLI_math.h"
 
+#include "GPU_shader.h"
+
 MathBaseOperation::MathBaseOperation()
 {
   this->addInputSocket(COM_DT_VALUE);
@@ -64,6 +66,25 @@ void MathBaseOperation::determineResolution(unsigned int resolution[2],
   NodeOperation::determineResolution(resolution, preferredResolution);
 }
 
+/**
+ * Fragment shader of an operation on the first two inputs, expression calculates the result from
+ * the values a and b. See GPUDevice for the interface.
+ */
+#define MATH_BINARY_GPU_SHADER(expression) \
+  "uniform sampler2D input0;\n" \
+  "uniform sampler2D input1;\n" \
+  "uniform bool use_clamp;\n" \
+  "void main()\n" \
+  "{\n" \
+  "  float a = read_input(input0).r;\n" \
+  "  float b = read_input(input1).r;\n" \
+  "  float value = " expression ";\n" \
+  "  if (use_clamp) {\n" \
+  "    value = clamp(value, 0.0, 1.0);\n" \
+  "  }\n" \
+  "  fragColor = vec4(value, 0.0, 0.0, 1.0);\n" \
+  "}\n"
+
 void MathBaseOperation::clampIfNeeded(float *color)
 {
   if (this->m_useClamp) {
@@ -71,6 +92,20 @@ void MathBaseOperation::clampIfNeeded(float *color)
   }
 }
 
+void MathBaseOperation::clampRowIfNeeded(float *output, int length)
+{
+  if (this->m_useClamp) {
+    for (int i = 0; i < length; i++) {
+      CLAMP(output[i], 0.0f, 1.0f);
+    }
+  }
+}
+
+void MathBaseOperation::setGPUUniforms(GPUDevice * /*device*/, GPUShader *shader)
+{
+  GPU_shader_uniform_1i(shader, "use_clamp", this->m_useClamp);
+}
+
 void MathAddOperation::executePixelSampled(float output[4], float x, float y, PixelSampler sampler)
 {
   float inputValue1[4];
@@ -84,6 +119,18 @@ void MathAddOperation::executePixelSampled(float output[4], float x, float y, Pi
   clampIfNeeded(output);
 }
 
+void MathAddOperation::executeRow(float *output, const RowInput *inputs, int length)
+{
+  executeRowBinary(output, inputs, length, [](float a, float b) {
+    return a + b;
+  });
+}
+
+const char *MathAddOperation::getGPUShaderSource() const
+{
+  return MATH_BINARY_GPU_SHADER("a + b");
+}
+
 void MathSubtractOperation::executePixelSampled(float output[4],
                                                 float x,
                                                 float y,
@@ -100,6 +147,18 @@ void MathSubtractOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MathSubtractOperation::executeRow(float *output, const RowInput *inputs, int length)
+{
+  executeRowBinary(output, inputs, length, [](float a, float b) {
+    return a - b;
+  });
+}
+
+const char *MathSubtractOperation::getGPUShaderSource() const
+{
+  return MATH_BINARY_GPU_SHADER("a - b");
+}
+
 void MathMultiplyOperation::executePixelSampled(float output[4],
                                                 float x,
                                                 float y,
@@ -116,6 +175,18 @@ void MathMultiplyOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MathMultiplyOperation::executeRow(float *output, const RowInput *inputs, int length)
+{
+  executeRowBinary(output, inputs, length, [](float a, float b) {
+    return a * b;
+  });
+}
+
+const char *MathMultiplyOperation::getGPUShaderSource() const
+{
+  return MATH_BINARY_GPU_SHADER("a * b");
+}
+
 void MathDivideOperation::executePixelSampled(float output[4],
                                               float x,
                                               float y,
@@ -137,6 +208,19 @@ void MathDivideOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MathDivideOperation::executeRow(float *output, const RowInput *inputs, int length)
+{
+  executeRowBinary(output, inputs, length, [](float a, float b) {
+    /* We don't want to divide by zero. */
+    return (b == 0.0f) ? 0.0f : a / b;
+  });
+}
+
+const char *MathDivideOperation::getGPUShaderSource() const
+{
+  return MATH_BINARY_GPU_SHADER("(b == 0.0) ? 0.0 : a / b");
+}
+
 void MathSineOperation::executePixelSampled(float output[4],
                                             float x,
                                             float y,
@@ -356,6 +440,18 @@ void MathMinimumOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MathMinimumOperation::executeRow(float *output, const RowInput *inputs, int length)
+{
+  executeRowBinary(output, inputs, length, [](float a, float b) {
+    return min(a, b);
+  });
+}
+
+const char *MathMinimumOperation::getGPUShaderSource() const
+{
+  return MATH_BINARY_GPU_SHADER("min(a, b)");
+}
+
 void MathMaximumOperation::executePixelSampled(float output[4],
                                                float x,
                                                float y,
@@ -372,6 +468,18 @@ void MathMaximumOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MathMaximumOperation::executeRow(float *output, const RowInput *inputs, int length)
+{
+  executeRowBinary(output, inputs, length, [](float a, float b) {
+    return max(a, b);
+  });
+}
+
+const char *MathMaximumOperation::getGPUShaderSource() const
+{
+  return MATH_BINARY_GPU_SHADER("max(a, b)");
+}
+
 void MathRoundOperation::executePixelSampled(float output[4],
                                              float x,
                                              float y,
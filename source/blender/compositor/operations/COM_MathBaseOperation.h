@@ -42,6 +42,31 @@ class MathBaseOperation : public NodeOperation {
   MathBaseOperation();
 
   void clampIfNeeded(float color[4]);
+  void clampRowIfNeeded(float *output, int length);
+
+  /**
+   * Row kernel of an operation on the first two inputs, func is applied to every pixel.
+   */
+  template<typename Func>
+  void executeRowBinary(float *output, const RowInput *inputs, int length, Func func)
+  {
+    const float *a = inputs[0].data;
+    const float *b = inputs[1].data;
+    const int stride_a = inputs[0].stride;
+    const int stride_b = inputs[1].stride;
+    if (stride_a == 1 && stride_b == 1) {
+      /* Common case of two buffers, written so it can be vectorized. */
+      for (int i = 0; i < length; i++) {
+        output[i] = func(a[i], b[i]);
+      }
+    }
+    else {
+      for (int i = 0; i < length; i++) {
+        output[i] = func(a[i * stride_a], b[i * stride_b]);
+      }
+    }
+    clampRowIfNeeded(output, length);
+  }
 
  public:
   /**
@@ -68,6 +93,14 @@ class MathBaseOperation : public NodeOperation {
   {
     this->m_useClamp = value;
   }
+
+  void setGPUUniforms(GPUDevice *device, GPUShader *shader);
+
+  bool hash_params(BLI_HashMurmur2A *mm2) const
+  {
+    BLI_hash_mm2a_add_int(mm2, this->m_useClamp);
+    return true;
+  }
 };
 
 class MathAddOperation : public MathBaseOperation {
@@ -76,6 +109,12 @@ class MathAddOperation : public MathBaseOperation {
   {
   }
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  bool hasRowKernel() const
+  {
+    return true;
+  }
+  void executeRow(float *output, const RowInput *inputs, int length);
+  const char *getGPUShaderSource() const;
 };
 class MathSubtractOperation : public MathBaseOperation {
  public:
@@ -83,6 +122,12 @@ class MathSubtractOperation : public MathBaseOperation {
   {
   }
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  bool hasRowKernel() const
+  {
+    return true;
+  }
+  void executeRow(float *output, const RowInput *inputs, int length);
+  const char *getGPUShaderSource() const;
 };
 class MathMultiplyOperation : public MathBaseOperation {
  public:
@@ -90,6 +135,12 @@ class MathMultiplyOperation : public MathBaseOperation {
   {
   }
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  bool hasRowKernel() const
+  {
+    return true;
+  }
+  void executeRow(float *output, const RowInput *inputs, int length);
+  const char *getGPUShaderSource() const;
 };
 class MathDivideOperation : public MathBaseOperation {
  public:
@@ -97,6 +148,12 @@ class MathDivideOperation : public MathBaseOperation {
   {
   }
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  bool hasRowKernel() const
+  {
+    return true;
+  }
+  void executeRow(float *output, const RowInput *inputs, int length);
+  const char *getGPUShaderSource() const;
 };
 class MathSineOperation : public MathBaseOperation {
  public:
@@ -183,6 +240,12 @@ class MathMinimumOperation : public MathBaseOperation {
   {
   }
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  bool hasRowKernel() const
+  {
+    return true;
+  }
+  void executeRow(float *output, const RowInput *inputs, int length);
+  const char *getGPUShaderSource() const;
 };
 class MathMaximumOperation : public MathBaseOperation {
  public:
@@ -190,6 +253,12 @@ class MathMaximumOperation : public MathBaseOperation {
   {
   }
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  bool hasRowKernel() const
+  {
+    return true;
+  }
+  void executeRow(float *output, const RowInput *inputs, int length);
+  const char *getGPUShaderSource() const;
 };
 class MathRoundOperation : public MathBaseOperation {
  public:
@@ -20,6 +20,8 @@
 
 #include "BLI_math.h"
 
+#include "GPU_shader.h"
+
 /* ******** Mix Base Operation ******** */
 
 MixBaseOperation::MixBaseOperation()
@@ -95,6 +97,12 @@ void MixBaseOperation::deinitExecution()
   this->m_inputColor2Operation = nullptr;
 }
 
+void MixBaseOperation::setGPUUniforms(GPUDevice * /*device*/, GPUShader *shader)
+{
+  GPU_shader_uniform_1i(shader, "use_alpha_multiply", this->m_valueAlphaMultiply);
+  GPU_shader_uniform_1i(shader, "use_clamp", this->m_useClamp);
+}
+
 /* ******** Mix Add Operation ******** */
 
 MixAddOperation::MixAddOperation()
@@ -102,6 +110,31 @@ MixAddOperation::MixAddOperation()
   /* pass */
 }
 
+/**
+ * Fragment shader shared by the mix operations, rgb calculates the color channels from both colors
+ * and the (alpha multiplied) value. Alpha is taken from the first color. See GPUDevice for the
+ * interface.
+ */
+#define MIX_GPU_SHADER(rgb) \
+  "uniform sampler2D input0;\n" \
+  "uniform sampler2D input1;\n" \
+  "uniform sampler2D input2;\n" \
+  "uniform bool use_alpha_multiply;\n" \
+  "uniform bool use_clamp;\n" \
+  "void main()\n" \
+  "{\n" \
+  "  float value = read_input(input0).r;\n" \
+  "  vec4 color1 = read_input(input1);\n" \
+  "  vec4 color2 = read_input(input2);\n" \
+  "  if (use_alpha_multiply) {\n" \
+  "    value *= color2.a;\n" \
+  "  }\n" \
+  "  fragColor = vec4(" rgb ", color1.a);\n" \
+  "  if (use_clamp) {\n" \
+  "    fragColor = clamp(fragColor, 0.0, 1.0);\n" \
+  "  }\n" \
+  "}\n"
+
 void MixAddOperation::executePixelSampled(float output[4], float x, float y, PixelSampler sampler)
 {
   float inputColor1[4];
@@ -124,6 +157,30 @@ void MixAddOperation::executePixelSampled(float output[4], float x, float y, Pix
   clampIfNeeded(output);
 }
 
+void MixAddOperation::executeRow(float *output, const RowInput *inputs, int length)
+{
+  executeRowMix(
+      output,
+      inputs,
+      length,
+      [](float *out, const float *color1, const float *color2, float value) {
+#ifdef __SSE2__
+        const __m128 fac = _mm_set1_ps(value);
+        _mm_storeu_ps(out,
+                      _mm_add_ps(_mm_loadu_ps(color1), _mm_mul_ps(fac, _mm_loadu_ps(color2))));
+#else
+        out[0] = color1[0] + value * color2[0];
+        out[1] = color1[1] + value * color2[1];
+        out[2] = color1[2] + value * color2[2];
+#endif
+      });
+}
+
+const char *MixAddOperation::getGPUShaderSource() const
+{
+  return MIX_GPU_SHADER("color1.rgb + value * color2.rgb");
+}
+
 /* ******** Mix Blend Operation ******** */
 
 MixBlendOperation::MixBlendOperation()
@@ -158,6 +215,33 @@ void MixBlendOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MixBlendOperation::executeRow(float *output, const RowInput *inputs, int length)
+{
+  executeRowMix(
+      output,
+      inputs,
+      length,
+      [](float *out, const float *color1, const float *color2, float value) {
+#ifdef __SSE2__
+        const __m128 fac = _mm_set1_ps(value);
+        const __m128 facm = _mm_set1_ps(1.0f - value);
+        _mm_storeu_ps(out,
+                      _mm_add_ps(_mm_mul_ps(facm, _mm_loadu_ps(color1)),
+                                 _mm_mul_ps(fac, _mm_loadu_ps(color2))));
+#else
+        const float valuem = 1.0f - value;
+        out[0] = valuem * color1[0] + value * color2[0];
+        out[1] = valuem * color1[1] + value * color2[1];
+        out[2] = valuem * color1[2] + value * color2[2];
+#endif
+      });
+}
+
+const char *MixBlendOperation::getGPUShaderSource() const
+{
+  return MIX_GPU_SHADER("mix(color1.rgb, color2.rgb, value)");
+}
+
 /* ******** Mix Burn Operation ******** */
 
 MixColorBurnOperation::MixColorBurnOperation()
@@ -705,6 +789,33 @@ void MixMultiplyOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MixMultiplyOperation::executeRow(float *output, const RowInput *inputs, int length)
+{
+  executeRowMix(
+      output,
+      inputs,
+      length,
+      [](float *out, const float *color1, const float *color2, float value) {
+#ifdef __SSE2__
+        const __m128 fac = _mm_set1_ps(value);
+        const __m128 facm = _mm_set1_ps(1.0f - value);
+        _mm_storeu_ps(out,
+                      _mm_mul_ps(_mm_loadu_ps(color1),
+                                 _mm_add_ps(facm, _mm_mul_ps(fac, _mm_loadu_ps(color2)))));
+#else
+        const float valuem = 1.0f - value;
+        out[0] = color1[0] * (valuem + value * color2[0]);
+        out[1] = color1[1] * (valuem + value * color2[1]);
+        out[2] = color1[2] * (valuem + value * color2[2]);
+#endif
+      });
+}
+
+const char *MixMultiplyOperation::getGPUShaderSource() const
+{
+  return MIX_GPU_SHADER("color1.rgb * ((1.0 - value) + value * color2.rgb)");
+}
+
 /* ******** Mix Ovelray Operation ******** */
 
 MixOverlayOperation::MixOverlayOperation()
@@ -909,6 +1020,30 @@ void MixSubtractOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MixSubtractOperation::executeRow(float *output, const RowInput *inputs, int length)
+{
+  executeRowMix(
+      output,
+      inputs,
+      length,
+      [](float *out, const float *color1, const float *color2, float value) {
+#ifdef __SSE2__
+        const __m128 fac = _mm_set1_ps(value);
+        _mm_storeu_ps(out,
+                      _mm_sub_ps(_mm_loadu_ps(color1), _mm_mul_ps(fac, _mm_loadu_ps(color2))));
+#else
+        out[0] = color1[0] - value * color2[0];
+        out[1] = color1[1] - value * color2[1];
+        out[2] = color1[2] - value * color2[2];
+#endif
+      });
+}
+
+const char *MixSubtractOperation::getGPUShaderSource() const
+{
+  return MIX_GPU_SHADER("color1.rgb - value * color2.rgb");
+}
+
 /* ******** Mix Value Operation ******** */
 
 MixValueOperation::MixValueOperation()
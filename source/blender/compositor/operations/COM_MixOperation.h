@@ -20,6 +20,10 @@
 
 #include "COM_NodeOperation.h"
 
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
 /**
  * All this programs converts an input color to an output value.
  * it assumes we are in sRGB color space.
@@ -43,6 +47,30 @@ class MixBaseOperation : public NodeOperation {
     }
   }
 
+  /**
+   * Row kernel shared by the mix operations, func calculates the color channels of a pixel
+   * from both colors and the (alpha multiplied) value. Alpha is taken from the first color.
+   */
+  template<typename Func>
+  void executeRowMix(float *output, const RowInput *inputs, int length, Func func)
+  {
+    const RowInput &value_input = inputs[0];
+    const RowInput &color1_input = inputs[1];
+    const RowInput &color2_input = inputs[2];
+    for (int i = 0; i < length; i++) {
+      const float *color1 = &color1_input.data[i * color1_input.stride];
+      const float *color2 = &color2_input.data[i * color2_input.stride];
+      float value = value_input.data[i * value_input.stride];
+      if (this->m_valueAlphaMultiply) {
+        value *= color2[3];
+      }
+      float *out = &output[i * 4];
+      func(out, color1, color2, value);
+      out[3] = color1[3];
+      clampIfNeeded(out);
+    }
+  }
+
  public:
   /**
    * Default constructor
@@ -78,18 +106,32 @@ class MixBaseOperation : public NodeOperation {
   {
     this->m_useClamp = value;
   }
+
+  void setGPUUniforms(GPUDevice *device, GPUShader *shader);
 };
 
 class MixAddOperation : public MixBaseOperation {
  public:
   MixAddOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  bool hasRowKernel() const
+  {
+    return true;
+  }
+  void executeRow(float *output, const RowInput *inputs, int length);
+  const char *getGPUShaderSource() const;
 };
 
 class MixBlendOperation : public MixBaseOperation {
  public:
   MixBlendOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  bool hasRowKernel() const
+  {
+    return true;
+  }
+  void executeRow(float *output, const RowInput *inputs, int length);
+  const char *getGPUShaderSource() const;
 };
 
 class MixColorBurnOperation : public MixBaseOperation {
@@ -156,6 +198,12 @@ class MixMultiplyOperation : public MixBaseOperation {
  public:
   MixMultiplyOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  bool hasRowKernel() const
+  {
+    return true;
+  }
+  void executeRow(float *output, const RowInput *inputs, int length);
+  const char *getGPUShaderSource() const;
 };
 
 class MixOverlayOperation : public MixBaseOperation {
@@ -186,6 +234,12 @@ class MixSubtractOperation : public MixBaseOperation {
  public:
   MixSubtractOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  bool hasRowKernel() const
+  {
+    return true;
+  }
+  void executeRow(float *output, const RowInput *inputs, int length);
+  const char *getGPUShaderSource() const;
 };
 
 class MixValueOperation : public MixBaseOperation {
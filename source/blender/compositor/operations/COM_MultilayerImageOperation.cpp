@@ -30,18 +30,18 @@ MultilayerBaseOperation::MultilayerBaseOperation(int passindex, int view)
 ImBuf *MultilayerBaseOperation::getImBuf()
 {
   /* temporarily changes the view to get the right ImBuf */
-  int view = this->m_imageUser->view;
+  int view = this->m_imageUser.view;
 
-  this->m_imageUser->view = this->m_view;
-  this->m_imageUser->pass = this->m_passId;
+  this->m_imageUser.view = this->m_view;
+  this->m_imageUser.pass = this->m_passId;
 
-  if (BKE_image_multilayer_index(this->m_image->rr, this->m_imageUser)) {
+  if (BKE_image_multilayer_index(this->m_image->rr, &this->m_imageUser)) {
     ImBuf *ibuf = BaseImageOperation::getImBuf();
-    this->m_imageUser->view = view;
+    this->m_imageUser.view = view;
     return ibuf;
   }
 
-  this->m_imageUser->view = view;
+  this->m_imageUser.view = view;
   return nullptr;
 }
 
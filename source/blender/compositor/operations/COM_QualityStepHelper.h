@@ -53,4 +53,8 @@ class QualityStepHelper {
   {
     this->m_quality = quality;
   }
+  CompositorQuality getQuality() const
+  {
+    return this->m_quality;
+  }
 };
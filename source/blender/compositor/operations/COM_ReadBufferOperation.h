@@ -54,6 +54,11 @@ class ReadBufferOperation : public NodeOperation {
   {
     return true;
   }
+  bool hash_params(BLI_HashMurmur2A * /*mm2*/) const
+  {
+    /* The result of the write buffer operation is hashed by the ResultCache. */
+    return true;
+  }
   void setOffset(unsigned int offset)
   {
     this->m_offset = offset;
@@ -62,6 +67,10 @@ class ReadBufferOperation : public NodeOperation {
   {
     return this->m_offset;
   }
+  bool isSingleValue() const
+  {
+    return this->m_single_value;
+  }
   bool determineDependingAreaOfInterest(rcti *input,
                                         ReadBufferOperation *readOperation,
                                         rcti *output);
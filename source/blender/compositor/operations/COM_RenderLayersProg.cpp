@@ -182,6 +182,19 @@ void RenderLayersProg::executePixelSampled(float output[4], float x, float y, Pi
   }
 }
 
+bool RenderLayersProg::hash_params(BLI_HashMurmur2A *mm2) const
+{
+  BLI_hash_mm2a_add_int(mm2, this->m_elementsize);
+  if (this->m_inputBuffer == nullptr) {
+    BLI_hash_mm2a_add_int(mm2, 0);
+    return true;
+  }
+  const size_t size = sizeof(float) * this->m_elementsize * this->getWidth() * this->getHeight();
+  const uint32_t pass_hash = BLI_hash_mm2((const unsigned char *)this->m_inputBuffer, size, 0);
+  BLI_hash_mm2a_add_int(mm2, (int)pass_hash);
+  return true;
+}
+
 void RenderLayersProg::deinitExecution()
 {
   this->m_inputBuffer = nullptr;
@@ -124,6 +124,11 @@ class RenderLayersProg : public NodeOperation {
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler) override;
 
   std::unique_ptr<MetaData> getMetaData() const override;
+
+  /**
+   * The render result can change without any setting changing, so the pass itself is hashed.
+   */
+  bool hash_params(BLI_HashMurmur2A *mm2) const override;
 };
 
 class RenderLayersAOOperation : public RenderLayersProg {
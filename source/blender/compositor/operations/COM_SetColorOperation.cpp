@@ -18,6 +18,8 @@
 
 #include "COM_SetColorOperation.h"
 
+#include "GPU_shader.h"
+
 SetColorOperation::SetColorOperation()
 {
   this->addOutputSocket(COM_DT_COLOR);
@@ -37,3 +39,17 @@ void SetColorOperation::determineResolution(unsigned int resolution[2],
   resolution[0] = preferredResolution[0];
   resolution[1] = preferredResolution[1];
 }
+
+const char *SetColorOperation::getGPUShaderSource() const
+{
+  return "uniform vec4 value;\n"
+         "void main()\n"
+         "{\n"
+         "  fragColor = value;\n"
+         "}\n";
+}
+
+void SetColorOperation::setGPUUniforms(GPUDevice * /*device*/, GPUShader *shader)
+{
+  GPU_shader_uniform_4fv(shader, "value", this->m_color);
+}
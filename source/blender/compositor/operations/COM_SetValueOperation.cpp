@@ -18,6 +18,8 @@
 
 #include "COM_SetValueOperation.h"
 
+#include "GPU_shader.h"
+
 SetValueOperation::SetValueOperation()
 {
   this->addOutputSocket(COM_DT_VALUE);
@@ -37,3 +39,18 @@ void SetValueOperation::determineResolution(unsigned int resolution[2],
   resolution[0] = preferredResolution[0];
   resolution[1] = preferredResolution[1];
 }
+
+const char *SetValueOperation::getGPUShaderSource() const
+{
+  return "uniform vec4 value;\n"
+         "void main()\n"
+         "{\n"
+         "  fragColor = value;\n"
+         "}\n";
+}
+
+void SetValueOperation::setGPUUniforms(GPUDevice * /*device*/, GPUShader *shader)
+{
+  const float value[4] = {this->m_value, 0.0f, 0.0f, 1.0f};
+  GPU_shader_uniform_4fv(shader, "value", value);
+}
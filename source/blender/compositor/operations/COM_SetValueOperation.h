@@ -49,8 +49,17 @@ class SetValueOperation : public NodeOperation {
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
   void determineResolution(unsigned int resolution[2], unsigned int preferredResolution[2]);
 
+  const char *getGPUShaderSource() const;
+  void setGPUUniforms(GPUDevice *device, GPUShader *shader);
+
   bool isSetOperation() const
   {
     return true;
   }
+
+  bool hash_params(BLI_HashMurmur2A *mm2) const
+  {
+    BLI_hash_mm2a_add(mm2, (const unsigned char *)&this->m_value, sizeof(this->m_value));
+    return true;
+  }
 };
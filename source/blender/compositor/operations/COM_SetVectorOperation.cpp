@@ -17,6 +17,8 @@
  */
 
 #include "COM_SetVectorOperation.h"
+
+#include "GPU_shader.h"
 #include "COM_defines.h"
 
 SetVectorOperation::SetVectorOperation()
@@ -40,3 +42,18 @@ void SetVectorOperation::determineResolution(unsigned int resolution[2],
   resolution[0] = preferredResolution[0];
   resolution[1] = preferredResolution[1];
 }
+
+const char *SetVectorOperation::getGPUShaderSource() const
+{
+  return "uniform vec4 value;\n"
+         "void main()\n"
+         "{\n"
+         "  fragColor = value;\n"
+         "}\n";
+}
+
+void SetVectorOperation::setGPUUniforms(GPUDevice * /*device*/, GPUShader *shader)
+{
+  const float value[4] = {this->m_x, this->m_y, this->m_z, 1.0f};
+  GPU_shader_uniform_4fv(shader, "value", value);
+}
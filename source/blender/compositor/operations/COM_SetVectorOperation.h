@@ -76,11 +76,21 @@ class SetVectorOperation : public NodeOperation {
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
 
   void determineResolution(unsigned int resolution[2], unsigned int preferredResolution[2]);
+
+  const char *getGPUShaderSource() const;
+  void setGPUUniforms(GPUDevice *device, GPUShader *shader);
   bool isSetOperation() const
   {
     return true;
   }
 
+  bool hash_params(BLI_HashMurmur2A *mm2) const
+  {
+    const float vector[4] = {this->m_x, this->m_y, this->m_z, this->m_w};
+    BLI_hash_mm2a_add(mm2, (const unsigned char *)vector, sizeof(vector));
+    return true;
+  }
+
   void setVector(const float vector[3])
   {
     setX(vector[0]);
@@ -76,6 +76,15 @@ class VariableSizeBokehBlurOperation : public NodeOperation, public QualityStepH
     this->m_do_size_scale = scale_size;
   }
 
+  bool hash_params(BLI_HashMurmur2A *mm2) const
+  {
+    BLI_hash_mm2a_add_int(mm2, this->m_maxBlur);
+    BLI_hash_mm2a_add(mm2, (const unsigned char *)&this->m_threshold, sizeof(float));
+    BLI_hash_mm2a_add_int(mm2, this->m_do_size_scale);
+    BLI_hash_mm2a_add_int(mm2, this->getQuality());
+    return true;
+  }
+
   void executeOpenCL(OpenCLDevice *device,
                      MemoryBuffer *outputMemoryBuffer,
                      cl_mem clOutputBuffer,
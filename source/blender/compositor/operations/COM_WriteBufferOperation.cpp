@@ -18,6 +18,7 @@
 
 #include "COM_WriteBufferOperation.h"
 #include "COM_OpenCLDevice.h"
+#include "COM_RowKernelEvaluator.h"
 #include "COM_defines.h"
 #include <cstdio>
 
@@ -59,53 +60,100 @@ void WriteBufferOperation::deinitExecution()
 void WriteBufferOperation::executeRegion(rcti *rect, unsigned int /*tileNumber*/)
 {
   MemoryBuffer *memoryBuffer = this->m_memoryProxy->getBuffer();
-  float *buffer = memoryBuffer->getBuffer();
-  const int num_channels = memoryBuffer->get_num_channels();
   if (this->m_input->isComplex()) {
     void *data = this->m_input->initializeTileData(rect);
-    int x1 = rect->xmin;
-    int y1 = rect->ymin;
-    int x2 = rect->xmax;
-    int y2 = rect->ymax;
-    int x;
-    int y;
-    bool breaked = false;
-    for (y = y1; y < y2 && (!breaked); y++) {
-      int offset4 = (y * memoryBuffer->getWidth() + x1) * num_channels;
-      for (x = x1; x < x2; x++) {
-        this->m_input->read(&(buffer[offset4]), x, y, data);
-        offset4 += num_channels;
-      }
-      if (isBraked()) {
-        breaked = true;
-      }
-    }
+    executeRegionPixels(rect, data);
     if (data) {
       this->m_input->deinitializeTileData(rect, data);
       data = nullptr;
     }
   }
+  else if (this->m_input->hasRowKernel()) {
+    if (!executeRegionRows(rect)) {
+      executeRegionPixels(rect, nullptr);
+    }
+  }
   else {
-    int x1 = rect->xmin;
-    int y1 = rect->ymin;
-    int x2 = rect->xmax;
-    int y2 = rect->ymax;
-
-    int x;
-    int y;
-    bool breaked = false;
-    for (y = y1; y < y2 && (!breaked); y++) {
-      int offset4 = (y * memoryBuffer->getWidth() + x1) * num_channels;
-      for (x = x1; x < x2; x++) {
-        this->m_input->readSampled(&(buffer[offset4]), x, y, COM_PS_NEAREST);
-        offset4 += num_channels;
+    executeRegionPixels(rect, nullptr);
+  }
+  memoryBuffer->setCreatedState();
+}
+
+float *WriteBufferOperation::get_row_buffer(int x, int y, float *temp_row)
+{
+  MemoryBuffer *memoryBuffer = this->m_memoryProxy->getBuffer();
+  if (memoryBuffer->is_half_float()) {
+    return temp_row;
+  }
+  const size_t offset = ((size_t)y * memoryBuffer->getWidth() + x) *
+                        memoryBuffer->get_num_channels();
+  return &memoryBuffer->getBuffer()[offset];
+}
+
+bool WriteBufferOperation::executeRegionRows(rcti *rect)
+{
+  MemoryBuffer *memoryBuffer = this->m_memoryProxy->getBuffer();
+  const int length = BLI_rcti_size_x(rect);
+  const int num_channels = memoryBuffer->get_num_channels();
+  RowKernelEvaluator evaluator(this->m_input, length);
+  if (!evaluator.is_valid() || evaluator.get_num_channels() != num_channels) {
+    return false;
+  }
+
+  vector<float> temp_row;
+  if (memoryBuffer->is_half_float()) {
+    temp_row.resize((size_t)length * num_channels);
+  }
+  for (int y = rect->ymin; y < rect->ymax; y++) {
+    float *row = get_row_buffer(rect->xmin, y, temp_row.data());
+    evaluator.execute_row(row, rect->xmin, y, length);
+    if (memoryBuffer->is_half_float()) {
+      memoryBuffer->write_row(rect->xmin, y, row, length);
+    }
+    if (isBraked()) {
+      break;
+    }
+  }
+  return true;
+}
+
+void WriteBufferOperation::executeRegionPixels(rcti *rect, void *data)
+{
+  MemoryBuffer *memoryBuffer = this->m_memoryProxy->getBuffer();
+  const int num_channels = memoryBuffer->get_num_channels();
+  const bool is_complex = this->m_input->isComplex();
+  int x1 = rect->xmin;
+  int y1 = rect->ymin;
+  int x2 = rect->xmax;
+  int y2 = rect->ymax;
+
+  vector<float> temp_row;
+  if (memoryBuffer->is_half_float()) {
+    temp_row.resize((size_t)(x2 - x1) * num_channels);
+  }
+
+  int x;
+  int y;
+  bool breaked = false;
+  for (y = y1; y < y2 && (!breaked); y++) {
+    float *row = get_row_buffer(x1, y, temp_row.data());
+    float *pixel = row;
+    for (x = x1; x < x2; x++) {
+      if (is_complex) {
+        this->m_input->read(pixel, x, y, data);
       }
-      if (isBraked()) {
-        breaked = true;
+      else {
+        this->m_input->readSampled(pixel, x, y, COM_PS_NEAREST);
       }
+      pixel += num_channels;
+    }
+    if (memoryBuffer->is_half_float()) {
+      memoryBuffer->write_row(x1, y, row, x2 - x1);
+    }
+    if (isBraked()) {
+      breaked = true;
     }
   }
-  memoryBuffer->setCreatedState();
 }
 
 void WriteBufferOperation::executeOpenCLRegion(OpenCLDevice *device,
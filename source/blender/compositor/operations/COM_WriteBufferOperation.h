@@ -46,6 +46,10 @@ class WriteBufferOperation : public NodeOperation {
   {
     return m_single_value;
   }
+  bool hash_params(BLI_HashMurmur2A * /*mm2*/) const
+  {
+    return true;
+  }
 
   void executeRegion(rcti *rect, unsigned int tileNumber);
   void initExecution();
@@ -61,4 +65,21 @@ class WriteBufferOperation : public NodeOperation {
   {
     return m_input;
   }
+
+ private:
+  /**
+   * \brief calculate the region with the row kernels of the input operations
+   * \return false when the inputs can't be evaluated as rows, nothing is calculated then.
+   * \see RowKernelEvaluator
+   */
+  bool executeRegionRows(rcti *rect);
+  /**
+   * \param data: tile data of a complex input, see NodeOperation.initializeTileData
+   */
+  void executeRegionPixels(rcti *rect, void *data);
+  /**
+   * \brief get where to calculate a row starting at x, y: directly in the memory buffer, or in
+   * temp_row when the buffer is stored as half floats and has to be converted afterwards.
+   */
+  float *get_row_buffer(int x, int y, float *temp_row);
 };
@@ -141,6 +141,10 @@ void DEG_id_type_tag(struct Main *bmain, short id_type);
 
 void DEG_ids_clear_recalc(struct Main *bmain, Depsgraph *depsgraph);
 
+/* Counter which changes every time an ID is tagged for update by a user edit, in any graph.
+ * Allows caches of evaluated data to detect that the data they were created from changed. */
+unsigned int DEG_get_user_edit_count(void);
+
 /* Check if something was changed in the database and inform
  * editors about this.
  */
@@ -161,6 +165,22 @@ void DEG_evaluate_on_framechange(Depsgraph *graph, float ctime);
 /* Data changed recalculation entry point. */
 void DEG_evaluate_on_refresh(Depsgraph *graph);
 
+/* Called for every frame evaluated by #DEG_evaluate_frames_parallel, from a worker thread.
+ * The graph is evaluated to the given frame for the duration of the call. */
+typedef void (*DEG_FrameEvaluatedFn)(Depsgraph *graph, int frame, void *user_data);
+
+/* Evaluate all frames in the inclusive range, distributing them over the given graphs which
+ * evaluate concurrently. The graphs are expected to be built from the same data, and to be
+ * inactive. Frames are evaluated in no particular order, so this is only usable when the state of
+ * a frame does not depend on previous frames (no simulations), and frame change handlers are not
+ * called. */
+void DEG_evaluate_frames_parallel(Depsgraph **graphs,
+                                  int graphs_len,
+                                  int frame_start,
+                                  int frame_end,
+                                  DEG_FrameEvaluatedFn callback,
+                                  void *user_data);
+
 /* Editors Integration  -------------------------- */
 
 /* Mechanism to allow editors to be informed of depsgraph updates,
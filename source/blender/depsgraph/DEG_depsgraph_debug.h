@@ -62,6 +62,10 @@ void DEG_debug_stats_gnuplot(const struct Depsgraph *graph,
                              const char *label,
                              const char *output_filename);
 
+/* Timeline of the last evaluation in the Chrome trace event format. Only contains data when the
+ * graph was evaluated with `--debug-depsgraph-time`. */
+void DEG_debug_timeline_json(const struct Depsgraph *graph, FILE *fp);
+
 /* ************************************************ */
 
 /* Compare two dependency graphs. */
@@ -32,6 +32,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_action_types.h"
@@ -2795,10 +2796,36 @@ void DepsgraphRelationBuilder::build_scene_speakers(Scene * /*scene*/, ViewLayer
   }
 }
 
+namespace {
+
+struct CopyOnWriteRelationsData {
+  DepsgraphRelationBuilder *builder;
+  Depsgraph *graph;
+};
+
+void build_copy_on_write_relations_func(void *__restrict data_v,
+                                        const int i,
+                                        const TaskParallelTLS *__restrict /*tls*/)
+{
+  CopyOnWriteRelationsData *data = (CopyOnWriteRelationsData *)data_v;
+  data->builder->build_copy_on_write_relations(data->graph->id_nodes[i]);
+}
+
+}  // namespace
+
 void DepsgraphRelationBuilder::build_copy_on_write_relations()
 {
+  /* Relations within an ID only touch the nodes of that ID, so IDs are handled in parallel.
+   * Relations between IDs are added afterwards, since they modify nodes of other IDs. */
+  CopyOnWriteRelationsData data = {this, graph_};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 256;
+  BLI_task_parallel_range(
+      0, graph_->id_nodes.size(), &data, build_copy_on_write_relations_func, &settings);
+
   for (IDNode *id_node : graph_->id_nodes) {
-    build_copy_on_write_relations(id_node);
+    build_copy_on_write_data_relations(id_node);
   }
 }
 
@@ -2926,6 +2953,15 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
      * evaluation step needs geometry, it will have transitive dependency
      * to Mesh copy-on-write already. */
   }
+}
+
+void DepsgraphRelationBuilder::build_copy_on_write_data_relations(IDNode *id_node)
+{
+  ID *id_orig = id_node->id_orig;
+  if (!deg_copy_on_write_is_needed(GS(id_orig->name))) {
+    return;
+  }
+  OperationKey copy_on_write_key(id_orig, NodeType::COPY_ON_WRITE, OperationCode::COPY_ON_WRITE);
   /* TODO(sergey): This solves crash for now, but causes too many
    * updates potentially. */
   if (GS(id_orig->name) == ID_OB) {
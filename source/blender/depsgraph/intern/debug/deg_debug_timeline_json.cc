@@ -0,0 +1,104 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Export of the last evaluation as a timeline in the Chrome trace event format, which can be
+ * viewed in `chrome://tracing` or Perfetto. Every evaluated operation is a slice on the row of
+ * the thread which evaluated it.
+ */
+
+#include "DEG_depsgraph_debug.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include "intern/depsgraph.h"
+#include "intern/node/deg_node_component.h"
+#include "intern/node/deg_node_id.h"
+#include "intern/node/deg_node_operation.h"
+
+#define NL "\n"
+
+namespace deg = blender::deg;
+
+namespace blender::deg {
+namespace {
+
+string jsonify_string(const string &str)
+{
+  string result;
+  for (const char ch : str) {
+    if (ELEM(ch, '"', '\\')) {
+      result += '\\';
+      result += ch;
+    }
+    else if ((unsigned char)ch < 0x20) {
+      result += ' ';
+    }
+    else {
+      result += ch;
+    }
+  }
+  return result;
+}
+
+void deg_debug_timeline_json(const Depsgraph *graph, FILE *fp)
+{
+  /* Timestamps are written relative to the first operation of the evaluation. */
+  double evaluation_start_time = DBL_MAX;
+  for (const OperationNode *op_node : graph->operations) {
+    if (op_node->stats.thread_id != -1) {
+      evaluation_start_time = std::min(evaluation_start_time, op_node->stats.start_time);
+    }
+  }
+
+  fprintf(fp, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [" NL);
+  bool is_first = true;
+  for (const OperationNode *op_node : graph->operations) {
+    if (op_node->stats.thread_id == -1) {
+      continue;
+    }
+    const ComponentNode *comp_node = op_node->owner;
+    /* Times are in microseconds. */
+    fprintf(fp,
+            "%s{\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, "
+            "\"pid\": 0, \"tid\": %d}",
+            is_first ? "" : "," NL,
+            jsonify_string(op_node->full_identifier()).c_str(),
+            jsonify_string(comp_node->identifier()).c_str(),
+            (op_node->stats.start_time - evaluation_start_time) * 1e6,
+            (op_node->stats.end_time - op_node->stats.start_time) * 1e6,
+            op_node->stats.thread_id);
+    is_first = false;
+  }
+  fprintf(fp, NL "]}" NL);
+}
+
+}  // namespace
+}  // namespace blender::deg
+
+void DEG_debug_timeline_json(const Depsgraph *depsgraph, FILE *fp)
+{
+  if (depsgraph == nullptr) {
+    return;
+  }
+  deg::deg_debug_timeline_json((const deg::Depsgraph *)depsgraph, fp);
+}
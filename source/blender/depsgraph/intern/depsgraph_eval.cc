@@ -26,6 +26,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_listbase.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_scene.h"
@@ -45,6 +46,8 @@
 
 #include "intern/depsgraph.h"
 
+#include "atomic_ops.h"
+
 namespace deg = blender::deg;
 
 static void deg_flush_updates_and_refresh(deg::Depsgraph *deg_graph)
@@ -81,3 +84,45 @@ void DEG_evaluate_on_framechange(Depsgraph *graph, float ctime)
   deg_graph->ctime = ctime;
   deg_flush_updates_and_refresh(deg_graph);
 }
+
+struct FrameEvaluationData {
+  int frame_next;
+  int frame_end;
+  DEG_FrameEvaluatedFn callback;
+  void *user_data;
+};
+
+static void deg_evaluate_frames_task(TaskPool *__restrict pool, void *taskdata)
+{
+  FrameEvaluationData *data = static_cast<FrameEvaluationData *>(BLI_task_pool_user_data(pool));
+  Depsgraph *graph = static_cast<Depsgraph *>(taskdata);
+
+  /* Take frames in order, so graphs mostly advance by small time steps. */
+  for (int frame = atomic_fetch_and_add_int32(&data->frame_next, 1); frame <= data->frame_end;
+       frame = atomic_fetch_and_add_int32(&data->frame_next, 1)) {
+    DEG_evaluate_on_framechange(graph, (float)frame);
+    data->callback(graph, frame, data->user_data);
+  }
+}
+
+void DEG_evaluate_frames_parallel(Depsgraph **graphs,
+                                  int graphs_len,
+                                  int frame_start,
+                                  int frame_end,
+                                  DEG_FrameEvaluatedFn callback,
+                                  void *user_data)
+{
+  FrameEvaluationData data;
+  data.frame_next = frame_start;
+  data.frame_end = frame_end;
+  data.callback = callback;
+  data.user_data = user_data;
+
+  TaskPool *task_pool = BLI_task_pool_create(&data, TASK_PRIORITY_HIGH);
+  for (int i = 0; i < graphs_len; i++) {
+    BLI_assert(!DEG_is_active(graphs[i]));
+    BLI_task_pool_push(task_pool, deg_evaluate_frames_task, graphs[i], false, nullptr);
+  }
+  BLI_task_pool_work_and_wait(task_pool);
+  BLI_task_pool_free(task_pool);
+}
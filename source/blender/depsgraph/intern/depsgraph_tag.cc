@@ -68,6 +68,8 @@
 #include "intern/node/deg_node_operation.h"
 #include "intern/node/deg_node_time.h"
 
+#include "atomic_ops.h"
+
 namespace deg = blender::deg;
 
 /* *********************** */
@@ -75,6 +77,9 @@ namespace deg = blender::deg;
 
 namespace blender::deg {
 
+/* See #DEG_get_user_edit_count. */
+static uint32_t user_edit_count = 0;
+
 namespace {
 
 void depsgraph_geometry_tag_to_component(const ID *id, NodeType *component_type)
@@ -676,6 +681,7 @@ void graph_id_tag_update(
   if (update_source == DEG_UPDATE_SOURCE_USER_EDIT && flag != ID_RECALC_SHADING) {
     graph_id_tag_update_single_flag(
         bmain, graph, id, id_node, ID_RECALC_POINT_CACHE, update_source);
+    atomic_add_and_fetch_uint32(&user_edit_count, 1);
   }
 }
 
@@ -863,3 +869,8 @@ void DEG_ids_clear_recalc(Main *UNUSED(bmain), Depsgraph *depsgraph)
   }
   memset(deg_graph->id_type_updated, 0, sizeof(deg_graph->id_type_updated));
 }
+
+unsigned int DEG_get_user_edit_count(void)
+{
+  return deg::user_edit_count;
+}
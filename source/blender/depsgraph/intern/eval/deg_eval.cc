@@ -32,6 +32,9 @@
 #include "BLI_task.h"
 #include "BLI_utildefines.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include "BKE_global.h"
 
 #include "DNA_node_types.h"
@@ -73,6 +76,25 @@ void schedule_node_to_pool(OperationNode *node, const int UNUSED(thread_id), Tas
   BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
 }
 
+using ReadyOperations = Vector<OperationNode *, 16>;
+
+void schedule_node_to_vector(OperationNode *node,
+                             const int UNUSED(thread_id),
+                             ReadyOperations *ready_operations)
+{
+  ready_operations->append(node);
+}
+
+/* Operations on the most expensive chains first, so they don't start late. */
+void sort_by_critical_path(ReadyOperations &operations)
+{
+  std::sort(operations.begin(),
+            operations.end(),
+            [](const OperationNode *a, const OperationNode *b) {
+              return a->critical_path_time > b->critical_path_time;
+            });
+}
+
 /* Denotes which part of dependency graph is being evaluated. */
 enum class EvaluationStage {
   /* Stage 1: Only  Copy-on-Write operations are to be evaluated, prior to anything else.
@@ -97,21 +119,36 @@ struct DepsgraphEvalState {
   bool need_single_thread_pass;
 };
 
+/* Small sequential number of the calling thread, used for the evaluation timeline. */
+int evaluation_thread_id()
+{
+  static std::atomic<int> num_threads(0);
+  static thread_local int thread_id = num_threads++;
+  return thread_id;
+}
+
 void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_node)
 {
   ::Depsgraph *depsgraph = reinterpret_cast<::Depsgraph *>(state->graph);
 
   /* Sanity checks. */
   BLI_assert(!operation_node->is_noop() && "NOOP nodes should not actually be scheduled");
-  /* Perform operation. */
+  /* Perform operation. Always timed, the time is used as cost estimate for scheduling. */
+  const double start_time = PIL_check_seconds_timer();
+  operation_node->evaluate(depsgraph);
+  const double time = PIL_check_seconds_timer() - start_time;
+
   if (state->do_stats) {
-    const double start_time = PIL_check_seconds_timer();
-    operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += PIL_check_seconds_timer() - start_time;
-  }
-  else {
-    operation_node->evaluate(depsgraph);
+    operation_node->stats.current_time += time;
+    operation_node->stats.start_time = start_time;
+    operation_node->stats.end_time = start_time + time;
+    operation_node->stats.thread_id = evaluation_thread_id();
   }
+  /* Smooth out the estimate, single evaluations can be noisy. */
+  operation_node->eval_time_estimate = (operation_node->eval_time_estimate == 0.0f) ?
+                                           (float)time :
+                                           0.5f * (operation_node->eval_time_estimate +
+                                                   (float)time);
 }
 
 void deg_task_run_func(TaskPool *pool, void *taskdata)
@@ -119,12 +156,27 @@ void deg_task_run_func(TaskPool *pool, void *taskdata)
   void *userdata_v = BLI_task_pool_user_data(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
   OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
-  evaluate_node(state, operation_node);
+  ReadyOperations ready_operations;
+
+  while (operation_node != nullptr) {
+    /* Evaluate node. */
+    evaluate_node(state, operation_node);
+
+    /* Schedule children. The most expensive one is evaluated next by this thread, so the
+     * critical path continues without going through the task scheduler. */
+    ready_operations.clear();
+    schedule_children(state, operation_node, schedule_node_to_vector, &ready_operations);
+    if (ready_operations.is_empty()) {
+      break;
+    }
 
-  /* Schedule children. */
-  schedule_children(state, operation_node, schedule_node_to_pool, pool);
+    sort_by_critical_path(ready_operations);
+    operation_node = ready_operations[0];
+    for (int64_t i = 1; i < ready_operations.size(); i++) {
+      schedule_node_to_pool(ready_operations[i], 0, pool);
+    }
+  }
 }
 
 bool check_operation_node_visible(OperationNode *op_node)
@@ -177,10 +229,63 @@ void calculate_pending_parents(Depsgraph *graph)
   }
 }
 
+bool operation_needs_evaluation(OperationNode *node)
+{
+  return check_operation_node_visible(node) && (node->flag & DEPSOP_FLAG_NEEDS_UPDATE);
+}
+
+/* Critical path time of an operation is its own cost estimate plus the largest critical path
+ * time of its children, only counting operations which are to be evaluated.
+ * Depth-first traversal with an explicit stack, dependency chains can be very long. */
+void calculate_critical_path(Depsgraph *graph)
+{
+  const float unvisited = -1.0f, in_progress = -2.0f;
+
+  for (OperationNode *node : graph->operations) {
+    node->critical_path_time = operation_needs_evaluation(node) ? unvisited : 0.0f;
+  }
+
+  Vector<std::pair<OperationNode *, int64_t>> stack;
+  for (OperationNode *root : graph->operations) {
+    if (root->critical_path_time != unvisited) {
+      continue;
+    }
+    root->critical_path_time = in_progress;
+    stack.append({root, 0});
+
+    while (!stack.is_empty()) {
+      OperationNode *node = stack.last().first;
+      const int64_t link_index = stack.last().second;
+
+      if (link_index < node->outlinks.size()) {
+        stack.last().second++;
+        Relation *rel = node->outlinks[link_index];
+        OperationNode *child = (OperationNode *)rel->to;
+        if ((rel->flag & RELATION_FLAG_CYCLIC) == 0 && child->critical_path_time == unvisited) {
+          child->critical_path_time = in_progress;
+          stack.append({child, 0});
+        }
+        continue;
+      }
+
+      /* All children are done. Nodes still in progress are from unflagged cycles, ignore. */
+      float children_time = 0.0f;
+      for (Relation *rel : node->outlinks) {
+        if ((rel->flag & RELATION_FLAG_CYCLIC) == 0) {
+          children_time = std::max(children_time, ((OperationNode *)rel->to)->critical_path_time);
+        }
+      }
+      node->critical_path_time = node->eval_time_estimate + children_time;
+      stack.remove_last();
+    }
+  }
+}
+
 void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
 {
   const bool do_stats = state->do_stats;
   calculate_pending_parents(graph);
+  calculate_critical_path(graph);
   /* Clear tags and other things which needs to be clear. */
   for (OperationNode *node : graph->operations) {
     if (do_stats) {
@@ -285,6 +390,16 @@ void schedule_graph(DepsgraphEvalState *state,
   }
 }
 
+void schedule_graph_to_pool(DepsgraphEvalState *state, TaskPool *pool)
+{
+  ReadyOperations ready_operations;
+  schedule_graph(state, schedule_node_to_vector, &ready_operations);
+  sort_by_critical_path(ready_operations);
+  for (OperationNode *node : ready_operations) {
+    schedule_node_to_pool(node, 0, pool);
+  }
+}
+
 template<typename ScheduleFunction, typename... ScheduleFunctionArgs>
 void schedule_children(DepsgraphEvalState *state,
                        OperationNode *node,
@@ -386,14 +501,14 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   /* First, process all Copy-On-Write nodes. */
   state.stage = EvaluationStage::COPY_ON_WRITE;
   TaskPool *task_pool = deg_evaluate_task_pool_create(&state);
-  schedule_graph(&state, schedule_node_to_pool, task_pool);
+  schedule_graph_to_pool(&state, task_pool);
   BLI_task_pool_work_and_wait(task_pool);
   BLI_task_pool_free(task_pool);
 
   /* After that, process all other nodes. */
   state.stage = EvaluationStage::THREADED_EVALUATION;
   task_pool = deg_evaluate_task_pool_create(&state);
-  schedule_graph(&state, schedule_node_to_pool, task_pool);
+  schedule_graph_to_pool(&state, task_pool);
   BLI_task_pool_work_and_wait(task_pool);
   BLI_task_pool_free(task_pool);
 
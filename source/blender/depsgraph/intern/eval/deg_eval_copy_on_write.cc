@@ -315,6 +315,25 @@ bool id_copy_inplace_no_main(const ID *id, ID *newid)
   return result;
 }
 
+/* Copy of a mesh which references geometry arrays of the original mesh instead of duplicating
+ * them. Evaluation already treats referenced layers as read-only and duplicates them before
+ * modifying (see #CustomData_duplicate_referenced_layer), and every change of the original
+ * geometry tags the copy-on-write component, which replaces the references.
+ *
+ * Only used for viewport depsgraphs: render and bake jobs evaluate in a thread while the original
+ * data can be edited, they need their own copy of the arrays. */
+bool mesh_copy_inplace_no_main(const Depsgraph *depsgraph, const Mesh *mesh, Mesh *new_mesh)
+{
+  if (depsgraph->mode != DAG_EVAL_VIEWPORT || mesh->edit_mesh != nullptr) {
+    return false;
+  }
+  return (BKE_id_copy_ex(nullptr,
+                         &mesh->id,
+                         (ID **)&new_mesh,
+                         LIB_ID_COPY_LOCALIZE | LIB_ID_CREATE_NO_ALLOCATE |
+                             LIB_ID_COPY_CD_REFERENCE) != nullptr);
+}
+
 /* Similar to BKE_scene_copy() but does not require main and assumes pointer
  * is already allocated. */
 bool scene_copy_inplace_no_main(const Scene *scene, Scene *new_scene)
@@ -863,8 +882,6 @@ ID *deg_expand_copy_on_write_datablock(const Depsgraph *depsgraph,
   }
   // BLI_assert(check_datablock_expanded(id_cow) == false);
   /* Copy data from original ID to a copied version. */
-  /* TODO(sergey): Avoid doing full ID copy somehow, make Mesh to reference
-   * original geometry arrays for until those are modified. */
   /* TODO(sergey): We do some trickery with temp bmain and extra ID pointer
    * just to be able to use existing API. Ideally we need to replace this with
    * in-place copy from existing datablock to a prepared memory.
@@ -888,8 +905,8 @@ ID *deg_expand_copy_on_write_datablock(const Depsgraph *depsgraph,
       break;
     }
     case ID_ME: {
-      /* TODO(sergey): Ideally we want to handle meshes in a special
-       * manner here to avoid initial copy of all the geometry arrays. */
+      /* Avoid initial copy of all the geometry arrays. */
+      done = mesh_copy_inplace_no_main(depsgraph, (Mesh *)id_orig, (Mesh *)id_cow);
       break;
     }
     default:
@@ -277,12 +277,15 @@ Node::Stats::Stats()
 
 void Node::Stats::reset()
 {
-  current_time = 0.0;
+  reset_current();
 }
 
 void Node::Stats::reset_current()
 {
   current_time = 0.0;
+  start_time = 0.0;
+  end_time = 0.0;
+  thread_id = -1;
 }
 
 /*******************************************************************************
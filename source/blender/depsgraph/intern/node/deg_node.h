@@ -163,6 +163,11 @@ struct Node {
     void reset_current();
     /* Time spend on this node during current graph evaluation. */
     double current_time;
+    /* When and on which thread the node was evaluated last, for the evaluation timeline.
+     * Only filled in for operations. */
+    double start_time;
+    double end_time;
+    int thread_id;
   };
   /* Relationships between nodes
    * The reason why all depsgraph nodes are descended from this type (apart
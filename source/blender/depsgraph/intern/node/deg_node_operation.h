@@ -266,6 +266,12 @@ struct OperationNode : public Node {
   uint32_t num_links_pending;
   bool scheduled;
 
+  /* Evaluation time of previous updates in seconds, used as cost estimate for scheduling. */
+  float eval_time_estimate;
+  /* Estimated time of the most expensive chain of operations starting at this one, calculated
+   * before every evaluation. Operations on the longest chains are evaluated first. */
+  float critical_path_time;
+
   /* Identifier for the operation being performed. */
   OperationCode opcode;
   int name_tag;
@@ -176,6 +176,17 @@ void DRW_deferred_shader_remove(struct GPUMaterial *mat);
 struct DrawDataList *DRW_drawdatalist_from_id(struct ID *id);
 void DRW_drawdata_free(struct ID *id);
 
+/* GPU time of the draw engines and passes, averaged over the last redraws.
+ * Only recorded while the GPU timings overlay is enabled. */
+typedef struct DRWGPUTiming {
+  char name[32];
+  /* Nesting level, engines are at level 0. */
+  int level;
+  float time_ms;
+} DRWGPUTiming;
+
+int DRW_stats_gpu_timings_get(const DRWGPUTiming **r_timings);
+
 #ifdef __cplusplus
 }
 #endif
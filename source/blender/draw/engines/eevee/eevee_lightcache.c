@@ -75,6 +75,11 @@
   (IRRADIANCE_MAX_POOL_SIZE / IRRADIANCE_SAMPLE_SIZE_X) * \
       (IRRADIANCE_MAX_POOL_SIZE / IRRADIANCE_SAMPLE_SIZE_Y)
 
+/* Max number of probe samples rendered with the same scene cache. Creating the cache for every
+ * sample dominates the bake time of heavy scenes, but the draw manager stays locked during a
+ * batch, so keep it small enough for the interface to remain responsive. */
+#define LIGHTBAKE_BATCH_LEN 16
+
 /* TODO should be replace by a more elegant alternative. */
 extern void DRW_opengl_context_enable(void);
 extern void DRW_opengl_context_disable(void);
@@ -117,6 +122,8 @@ typedef struct EEVEE_LightBake {
   float lod_max;
   /** Number of probes to render + world probe. */
   int cube_len, grid_len;
+  /** Number of consecutive samples (grid samples or cube probes) rendered in one batch. */
+  int batch_len;
 
   /* Irradiance grid */
   /** Current probe being rendered (UBO data). */
@@ -1104,33 +1111,25 @@ static void grid_loc_to_world_loc(EEVEE_LightGrid *egrid, const int local_cell[3
   madd_v3_v3fl(r_pos, egrid->increment_z, local_cell[2]);
 }
 
-static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
+static void eevee_lightbake_render_grid_sample(EEVEE_Data *vedata,
+                                               EEVEE_ViewLayerData *sldata,
+                                               EEVEE_LightBake *lbake,
+                                               LightCache *lcache,
+                                               int grid_sample)
 {
-  EEVEE_Data *vedata = (EEVEE_Data *)ved;
-  EEVEE_ViewLayerData *sldata = EEVEE_view_layer_data_ensure();
   EEVEE_CommonUniformBuffer *common_data = &sldata->common_data;
-  EEVEE_LightBake *lbake = (EEVEE_LightBake *)user_data;
   EEVEE_LightGrid *egrid = lbake->grid;
   LightProbe *prb = *lbake->probe;
-  Scene *scene_eval = DEG_get_evaluated_scene(lbake->depsgraph);
-  LightCache *lcache = scene_eval->eevee.light_cache_data;
   int grid_loc[3], sample_id, sample_offset, stride;
   float pos[3];
-  const bool is_last_bounce_sample = ((egrid->offset + lbake->grid_sample) ==
+  const bool is_last_bounce_sample = ((egrid->offset + grid_sample) ==
                                       (lbake->total_irr_samples - 1));
 
-  /* No bias for rendering the probe. */
-  egrid->level_bias = 1.0f;
-
   /* Use the previous bounce for rendering this bounce. */
   SWAP(GPUTexture *, lbake->grid_prev, lcache->grid_tx.tex);
 
-  /* TODO do this once for the whole bake when we have independent DRWManagers.
-   * Warning: Some of the things above require this. */
-  eevee_lightbake_cache_create(vedata, lbake);
-
   /* Compute sample position */
-  compute_cell_id(egrid, prb, lbake->grid_sample, &sample_id, grid_loc, &stride);
+  compute_cell_id(egrid, prb, grid_sample, &sample_id, grid_loc, &stride);
   sample_offset = egrid->offset + sample_id;
 
   grid_loc_to_world_loc(egrid, grid_loc, pos);
@@ -1184,27 +1183,57 @@ static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
 
   /* If it is the last sample grid sample (and last bounce). */
   if ((lbake->bounce_curr == lbake->bounce_len - 1) && (lbake->grid_curr == lbake->grid_len - 1) &&
-      (lbake->grid_sample == lbake->grid_sample_len - 1)) {
+      (grid_sample == lbake->grid_sample_len - 1)) {
     lcache->flag &= ~LIGHTCACHE_UPDATE_GRID;
   }
 }
 
-static void eevee_lightbake_render_probe_sample(void *ved, void *user_data)
+/* Render `lbake->batch_len` samples of the current grid, starting at `lbake->grid_sample`. */
+static void eevee_lightbake_render_grid_samples(void *ved, void *user_data)
 {
   EEVEE_Data *vedata = (EEVEE_Data *)ved;
   EEVEE_ViewLayerData *sldata = EEVEE_view_layer_data_ensure();
-  EEVEE_CommonUniformBuffer *common_data = &sldata->common_data;
   EEVEE_LightBake *lbake = (EEVEE_LightBake *)user_data;
+  EEVEE_LightGrid *egrid = lbake->grid;
   Scene *scene_eval = DEG_get_evaluated_scene(lbake->depsgraph);
   LightCache *lcache = scene_eval->eevee.light_cache_data;
-  EEVEE_LightProbe *eprobe = lbake->cube;
-  LightProbe *prb = *lbake->probe;
-  float clamp = scene_eval->eevee.gi_glossy_clamp;
-  float filter_quality = scene_eval->eevee.gi_filter_quality;
 
-  /* TODO do this once for the whole bake when we have independent DRWManagers. */
+  /* No bias for rendering the probe. */
+  egrid->level_bias = 1.0f;
+
+  /* The materials sample the previous bounce. */
+  SWAP(GPUTexture *, lbake->grid_prev, lcache->grid_tx.tex);
+
+  /* TODO do this once for the whole bake when we have independent DRWManagers.
+   * Warning: Some of the things above require this. */
   eevee_lightbake_cache_create(vedata, lbake);
 
+  SWAP(GPUTexture *, lbake->grid_prev, lcache->grid_tx.tex);
+
+  /* All samples of the batch use the same probe, bounce and scene data, so the cache is valid for
+   * all of them. */
+  for (int i = 0; i < lbake->batch_len; i++) {
+    if (G.is_break == true || *lbake->stop) {
+      break;
+    }
+    eevee_lightbake_render_grid_sample(vedata, sldata, lbake, lcache, lbake->grid_sample + i);
+  }
+}
+
+static void eevee_lightbake_render_probe_sample(EEVEE_Data *vedata,
+                                                EEVEE_ViewLayerData *sldata,
+                                                EEVEE_LightBake *lbake,
+                                                LightCache *lcache,
+                                                int cube_offset)
+{
+  EEVEE_CommonUniformBuffer *common_data = &sldata->common_data;
+  Scene *scene_eval = DEG_get_evaluated_scene(lbake->depsgraph);
+  const int batch_index = cube_offset - lbake->cube_offset;
+  EEVEE_LightProbe *eprobe = lbake->cube + batch_index;
+  LightProbe *prb = lbake->probe[batch_index];
+  float clamp = scene_eval->eevee.gi_glossy_clamp;
+  float filter_quality = scene_eval->eevee.gi_filter_quality;
+
   /* Disable specular lighting when rendering probes to avoid feedback loops (looks bad). */
   common_data->spec_toggle = false;
   common_data->sss_toggle = false;
@@ -1220,7 +1249,7 @@ static void eevee_lightbake_render_probe_sample(void *ved, void *user_data)
                                 vedata,
                                 lbake->rt_color,
                                 lbake->store_fb,
-                                lbake->cube_offset,
+                                cube_offset,
                                 prb->intensity,
                                 lcache->mips_len,
                                 filter_quality,
@@ -1229,11 +1258,51 @@ static void eevee_lightbake_render_probe_sample(void *ved, void *user_data)
   lcache->cube_len += 1;
 
   /* If it's the last probe. */
-  if (lbake->cube_offset == lbake->cube_len - 1) {
+  if (cube_offset == lbake->cube_len - 1) {
     lcache->flag &= ~LIGHTCACHE_UPDATE_CUBE;
   }
 }
 
+/* Render `lbake->batch_len` cube probes, starting at `lbake->cube_offset`. */
+static void eevee_lightbake_render_probe_samples(void *ved, void *user_data)
+{
+  EEVEE_Data *vedata = (EEVEE_Data *)ved;
+  EEVEE_ViewLayerData *sldata = EEVEE_view_layer_data_ensure();
+  EEVEE_LightBake *lbake = (EEVEE_LightBake *)user_data;
+  Scene *scene_eval = DEG_get_evaluated_scene(lbake->depsgraph);
+  LightCache *lcache = scene_eval->eevee.light_cache_data;
+
+  /* TODO do this once for the whole bake when we have independent DRWManagers. */
+  eevee_lightbake_cache_create(vedata, lbake);
+
+  /* The probes of a batch share the same visibility collection, see
+   * #eevee_lightbake_probe_batch_len, which is the only probe setting used by the cache. */
+  for (int i = 0; i < lbake->batch_len; i++) {
+    if (G.is_break == true || *lbake->stop) {
+      break;
+    }
+    eevee_lightbake_render_probe_sample(vedata, sldata, lbake, lcache, lbake->cube_offset + i);
+  }
+}
+
+/* Number of consecutive cube probes, starting at `lbake->probe`, which can be rendered with the
+ * same scene cache. */
+static int eevee_lightbake_probe_batch_len(const EEVEE_LightBake *lbake)
+{
+  const LightProbe *first = lbake->probe[0];
+  const int max_len = min_ii(LIGHTBAKE_BATCH_LEN, lbake->cube_len - lbake->cube_offset);
+  int len = 1;
+  while (len < max_len) {
+    const LightProbe *prb = lbake->probe[len];
+    if ((prb->visibility_grp != first->visibility_grp) ||
+        ((prb->flag ^ first->flag) & LIGHTPROBE_FLAG_INVERT_GROUP)) {
+      break;
+    }
+    len++;
+  }
+  return len;
+}
+
 static float eevee_lightbake_grid_influence_volume(EEVEE_LightGrid *grid)
 {
   return mat4_to_scale(grid->mat);
@@ -1344,8 +1413,10 @@ void EEVEE_lightbake_update(void *custom_data)
   DEG_id_tag_update(&scene_orig->id, ID_RECALC_COPY_ON_WRITE);
 }
 
+/* Render `samples_len` samples with a single call of `render_callback`. */
 static bool lightbake_do_sample(EEVEE_LightBake *lbake,
-                                void (*render_callback)(void *ved, void *user_data))
+                                void (*render_callback)(void *ved, void *user_data),
+                                int samples_len)
 {
   if (G.is_break == true || *lbake->stop) {
     return false;
@@ -1356,7 +1427,7 @@ static bool lightbake_do_sample(EEVEE_LightBake *lbake,
   /* TODO: make DRW manager instanciable (and only lock on drawing) */
   eevee_lightbake_context_enable(lbake);
   DRW_custom_pipeline(&draw_engine_eevee_type, depsgraph, render_callback, lbake);
-  lbake->done += 1;
+  lbake->done += samples_len;
   *lbake->progress = lbake->done / (float)lbake->total;
   *lbake->do_update = 1;
   eevee_lightbake_context_disable(lbake);
@@ -1420,7 +1491,7 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
   /* Render world irradiance and reflection first */
   if (lcache->flag & LIGHTCACHE_UPDATE_WORLD) {
     lbake->probe = NULL;
-    lightbake_do_sample(lbake, eevee_lightbake_render_world_sample);
+    lightbake_do_sample(lbake, eevee_lightbake_render_world_sample, 1);
   }
 
   /* Render irradiance grids */
@@ -1435,8 +1506,10 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
         lbake->grid_sample_len = prb->grid_resolution_x * prb->grid_resolution_y *
                                  prb->grid_resolution_z;
         for (lbake->grid_sample = 0; lbake->grid_sample < lbake->grid_sample_len;
-             ++lbake->grid_sample) {
-          lightbake_do_sample(lbake, eevee_lightbake_render_grid_sample);
+             lbake->grid_sample += lbake->batch_len) {
+          lbake->batch_len = min_ii(LIGHTBAKE_BATCH_LEN,
+                                    lbake->grid_sample_len - lbake->grid_sample);
+          lightbake_do_sample(lbake, eevee_lightbake_render_grid_samples, lbake->batch_len);
         }
       }
     }
@@ -1448,8 +1521,11 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
     lbake->probe = lbake->cube_prb + 1;
     lbake->cube = lcache->cube_data + 1;
     for (lbake->cube_offset = 1; lbake->cube_offset < lbake->cube_len;
-         lbake->cube_offset++, lbake->probe++, lbake->cube++) {
-      lightbake_do_sample(lbake, eevee_lightbake_render_probe_sample);
+         lbake->cube_offset += lbake->batch_len) {
+      lbake->batch_len = eevee_lightbake_probe_batch_len(lbake);
+      lightbake_do_sample(lbake, eevee_lightbake_render_probe_samples, lbake->batch_len);
+      lbake->probe += lbake->batch_len;
+      lbake->cube += lbake->batch_len;
     }
   }
 
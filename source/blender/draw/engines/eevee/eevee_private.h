@@ -484,6 +484,12 @@ typedef struct EEVEE_ShadowCascadeRender {
   float cascade_exponent;
   float cascade_fade;
   int cascade_count;
+  /* Matrices and layer the shadow maps were last rendered with. If they did not change and no
+   * shadow caster was updated since, the shadow maps in the pool are still valid. */
+  float cached_projmat[MAX_CASCADE_NUM][4][4];
+  float cached_viewmat[4][4];
+  int cached_tex_id;
+  bool cache_valid;
 } EEVEE_ShadowCascadeRender;
 
 BLI_STATIC_ASSERT_ALIGN(EEVEE_Light, 16)
@@ -525,6 +531,8 @@ typedef struct EEVEE_LightsInfo {
   uchar shadow_cascade_light_indices[MAX_SHADOW_CASCADE];
   /* Update bitmap. */
   BLI_bitmap sh_cube_update[BLI_BITMAP_SIZE(MAX_SHADOW_CUBE)];
+  /* Outdated faces of the shadow cubes, only faces visible in a view are rendered. */
+  BLI_bitmap sh_cube_face_update[BLI_BITMAP_SIZE(MAX_SHADOW_CUBE * 6)];
   /* Lights tracking */
   struct BoundSphere shadow_bounds[MAX_LIGHT]; /* Tightly packed light bounds  */
   /* List of bbox and update bitmap. Double buffered. */
@@ -1078,7 +1086,12 @@ void EEVEE_shadows_cube_add(EEVEE_LightsInfo *linfo, EEVEE_Light *evli, struct O
 bool EEVEE_shadows_cube_setup(EEVEE_LightsInfo *linfo, const EEVEE_Light *evli, int sample_ofs);
 void EEVEE_shadows_cascade_add(EEVEE_LightsInfo *linfo, EEVEE_Light *evli, struct Object *ob);
 void EEVEE_shadows_draw(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata, struct DRWView *view);
-void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata, int cube_index);
+void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata,
+                                EEVEE_Data *vedata,
+                                const struct DRWView *view,
+                                const struct BoundBox *view_corners,
+                                int cube_index);
+void EEVEE_shadows_cascade_cache_invalidate(EEVEE_LightsInfo *linfo);
 void EEVEE_shadows_draw_cascades(EEVEE_ViewLayerData *sldata,
                                  EEVEE_Data *vedata,
                                  DRWView *view,
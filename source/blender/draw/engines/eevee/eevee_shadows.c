@@ -223,6 +223,8 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     linfo->cache_num_cascade_layer = linfo->num_cascade_layer;
   }
 
+  bool shcaster_update = false;
+
   if (!sldata->shadow_cube_pool) {
     sldata->shadow_cube_pool = DRW_texture_create_2d_array(linfo->shadow_cube_size,
                                                            linfo->shadow_cube_size,
@@ -239,6 +241,8 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
                                                               shadow_pool_format,
                                                               DRW_TEX_FILTER | DRW_TEX_COMPARE,
                                                               NULL);
+    /* Previously rendered cascades are lost. */
+    shcaster_update = true;
   }
 
   if (sldata->shadow_fb == NULL) {
@@ -261,6 +265,7 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   for (int i = 0; i < backbuffer->count; i++) {
     /* If the shadowcaster has been deleted or updated. */
     if (BLI_BITMAP_TEST(backbuffer->update, i)) {
+      shcaster_update = true;
       for (int j = 0; j < linfo->cube_len; j++) {
         if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
           if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
@@ -275,6 +280,7 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   for (int i = 0; i < frontbuffer->count; i++) {
     /* If the shadowcaster has been updated. */
     if (BLI_BITMAP_TEST(frontbuffer->update, i)) {
+      shcaster_update = true;
       for (int j = 0; j < linfo->cube_len; j++) {
         if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
           if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
@@ -285,6 +291,11 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     }
   }
 
+  /* Sun lights cover the whole scene, any shadow caster update makes their cascades outdated. */
+  if (shcaster_update) {
+    EEVEE_shadows_cascade_cache_invalidate(linfo);
+  }
+
   /* Resize shcasters buffers if too big. */
   if (frontbuffer->alloc_count - frontbuffer->count > SH_CASTER_ALLOC_CHUNK) {
     frontbuffer->alloc_count = (frontbuffer->count / SH_CASTER_ALLOC_CHUNK) *
@@ -306,6 +317,8 @@ void EEVEE_shadows_draw(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata, DRWView
   int saved_ray_type = sldata->common_data.ray_type;
 
   /* Precompute all shadow/view test before rendering and trashing the culling cache. */
+  BoundBox view_corners;
+  DRW_view_frustum_corners_get(view, &view_corners);
   BLI_bitmap *cube_visible = BLI_BITMAP_NEW_ALLOCA(MAX_SHADOW_CUBE);
   bool any_visible = linfo->cascade_len > 0;
   for (int cube = 0; cube < linfo->cube_len; cube++) {
@@ -323,8 +336,8 @@ void EEVEE_shadows_draw(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata, DRWView
   DRW_stats_group_start("Cube Shadow Maps");
   {
     for (int cube = 0; cube < linfo->cube_len; cube++) {
-      if (BLI_BITMAP_TEST(cube_visible, cube) && BLI_BITMAP_TEST(linfo->sh_cube_update, cube)) {
-        EEVEE_shadows_draw_cubemap(sldata, vedata, cube);
+      if (BLI_BITMAP_TEST(cube_visible, cube)) {
+        EEVEE_shadows_draw_cubemap(sldata, vedata, view, &view_corners, cube);
       }
     }
   }
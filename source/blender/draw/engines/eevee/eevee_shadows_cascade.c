@@ -382,6 +382,24 @@ static void eevee_shadow_cascade_setup(EEVEE_LightsInfo *linfo,
   shdw_data->far = sh_far;
 }
 
+void EEVEE_shadows_cascade_cache_invalidate(EEVEE_LightsInfo *linfo)
+{
+  for (int i = 0; i < MAX_SHADOW_CASCADE; i++) {
+    linfo->shadow_cascade_render[i].cache_valid = false;
+  }
+}
+
+/* Return true if the shadow maps in the pool were rendered with the current matrices. */
+static bool eevee_shadow_cascade_is_cached(const EEVEE_ShadowCascadeRender *csm_render,
+                                           const EEVEE_ShadowCascade *csm_data)
+{
+  return csm_render->cache_valid && (csm_render->cached_tex_id == (int)csm_data->tex_id) &&
+         (memcmp(csm_render->cached_viewmat, csm_render->viewmat, sizeof(float[4][4])) == 0) &&
+         (memcmp(csm_render->cached_projmat,
+                 csm_render->projmat,
+                 sizeof(float[4][4]) * csm_render->cascade_count) == 0);
+}
+
 static void eevee_ensure_cascade_views(EEVEE_ShadowCascadeRender *csm_render,
                                        DRWView *view[MAX_CASCADE_NUM])
 {
@@ -417,6 +435,12 @@ void EEVEE_shadows_draw_cascades(EEVEE_ViewLayerData *sldata,
 
   eevee_shadow_cascade_setup(linfo, evli, view, near, far, effects->taa_current_sample - 1);
 
+  /* Nothing changed since the last time, keep the previous shadow maps. This happens for every
+   * redraw with a static scene, as long as soft shadows do not jitter the matrices. */
+  if (eevee_shadow_cascade_is_cached(csm_render, csm_data)) {
+    return;
+  }
+
   /* Meh, Reusing the cube views. */
   BLI_assert(MAX_CASCADE_NUM <= 6);
   eevee_ensure_cascade_views(csm_render, g_data->cube_views);
@@ -434,4 +458,9 @@ void EEVEE_shadows_draw_cascades(EEVEE_ViewLayerData *sldata,
     GPU_framebuffer_clear_depth(sldata->shadow_fb, 1.0f);
     DRW_draw_pass(psl->shadow_pass);
   }
+
+  copy_m4_m4(csm_render->cached_viewmat, csm_render->viewmat);
+  memcpy(csm_render->cached_projmat, csm_render->projmat, sizeof(csm_render->projmat));
+  csm_render->cached_tex_id = (int)csm_data->tex_id;
+  csm_render->cache_valid = true;
 }
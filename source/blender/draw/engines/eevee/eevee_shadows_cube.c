@@ -178,12 +178,38 @@ static bool spot_angle_fit_single_face(const EEVEE_Light *evli)
   return cos_beta > cosf(DEG2RADF(42.0f));
 }
 
-void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata, int cube_index)
+/**
+ * Render the outdated faces of a shadow cube which can cast shadows on what is visible in `view`.
+ * Other outdated faces are kept as such and only rendered once they become visible, so moving
+ * objects or soft shadow samples do not re-render faces nobody sees.
+ */
+void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata,
+                                EEVEE_Data *vedata,
+                                const DRWView *view,
+                                const BoundBox *view_corners,
+                                int cube_index)
 {
   EEVEE_PassList *psl = vedata->psl;
   EEVEE_StorageList *stl = vedata->stl;
   EEVEE_PrivateData *g_data = stl->g_data;
   EEVEE_LightsInfo *linfo = sldata->lights;
+  BLI_bitmap *face_update = &linfo->sh_cube_face_update[0];
+
+  /* Light or shadow casters changed, all faces are outdated. */
+  if (BLI_BITMAP_TEST(&linfo->sh_cube_update[0], cube_index)) {
+    for (int j = 0; j < 6; j++) {
+      BLI_BITMAP_ENABLE(face_update, cube_index * 6 + j);
+    }
+    BLI_BITMAP_SET(&linfo->sh_cube_update[0], cube_index, false);
+  }
+
+  bool any_face_update = false;
+  for (int j = 0; j < 6; j++) {
+    any_face_update |= BLI_BITMAP_TEST_BOOL(face_update, cube_index * 6 + j);
+  }
+  if (!any_face_update) {
+    return;
+  }
 
   EEVEE_Light *evli = linfo->light_data + linfo->shadow_cube_light_indices[cube_index];
   EEVEE_Shadow *shdw_data = linfo->shadow_data + (int)evli->shadow_id;
@@ -200,18 +226,29 @@ void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
    * The only time it's more beneficial is when the CPU culling overhead
    * outweigh the instancing overhead. which is rarely the case. */
   for (int j = 0; j < 6; j++) {
+    const int face = cube_index * 6 + j;
+    if (!BLI_BITMAP_TEST(face_update, face)) {
+      continue;
+    }
     /* Optimization: Only render the needed faces. */
     /* Skip all but -Z face. */
     if (evli->light_type == LA_SPOT && j != 5 && spot_angle_fit_single_face(evli)) {
+      BLI_BITMAP_DISABLE(face_update, face);
       continue;
     }
     /* Skip +Z face. */
     if (evli->light_type != LA_LOCAL && j == 4) {
+      BLI_BITMAP_DISABLE(face_update, face);
+      continue;
+    }
+    /* Skip faces whose frustum does not intersect the view frustum. The test is conservative, it
+     * only rejects faces if one of the frustums is entirely behind a plane of the other. */
+    BoundBox face_corners;
+    DRW_view_frustum_corners_get(g_data->cube_views[j], &face_corners);
+    if (!DRW_culling_box_test(view, &face_corners) ||
+        !DRW_culling_box_test(g_data->cube_views[j], view_corners)) {
       continue;
     }
-    /* TODO(fclem): some cube sides can be invisible in the main views. Cull them. */
-    // if (frustum_intersect(g_data->cube_views[j], main_view))
-    //   continue;
 
     DRW_view_set_active(g_data->cube_views[j]);
     int layer = cube_index * 6 + j;
@@ -219,7 +256,7 @@ void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
     GPU_framebuffer_bind(sldata->shadow_fb);
     GPU_framebuffer_clear_depth(sldata->shadow_fb, 1.0f);
     DRW_draw_pass(psl->shadow_pass);
-  }
 
-  BLI_BITMAP_SET(&linfo->sh_cube_update[0], cube_index, false);
+    BLI_BITMAP_DISABLE(face_update, face);
+  }
 }
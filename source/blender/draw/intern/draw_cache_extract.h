@@ -247,6 +247,8 @@ typedef struct MeshBatchCache {
   DRW_MeshCDMask cd_used, cd_needed, cd_used_over_time;
 
   int lastmatch;
+  /** Time of the last batch request, used to free least recently used caches first. */
+  double lastused;
 
   /* Valid only if edge_detection is up to date. */
   bool is_manifold;
@@ -5729,6 +5729,7 @@ static struct TaskNode *mesh_extract_render_data_node_create(struct TaskGraph *t
       mesh_extract_render_data_node_exec,
       task_data,
       (TaskGraphNodeFreeFunction)mesh_render_data_update_task_data_free);
+  BLI_task_graph_node_set_name(task_node, "Mesh Render Data Update");
   return task_node;
 }
 
@@ -5767,6 +5768,7 @@ static struct TaskNode *extract_single_threaded_task_node_create(
       extract_single_threaded_task_node_exec,
       task_data,
       (TaskGraphNodeFreeFunction)extract_single_threaded_task_data_free);
+  BLI_task_graph_node_set_name(task_node, "Extract Single Threaded");
   return task_node;
 }
 
@@ -5808,6 +5810,7 @@ static struct TaskNode *user_data_init_task_node_create(struct TaskGraph *task_g
       user_data_init_task_data_exec,
       task_data,
       (TaskGraphNodeFreeFunction)user_data_init_task_data_free);
+  BLI_task_graph_node_set_name(task_node, "Extract User Data Init");
   return task_node;
 }
 
@@ -5830,6 +5833,7 @@ static void extract_range_task_create(struct TaskGraph *task_graph,
   taskdata->end = start + length;
   struct TaskNode *task_node = BLI_task_graph_node_create(
       task_graph, extract_run, taskdata, MEM_freeN);
+  BLI_task_graph_node_set_name(task_node, "Extract Range");
   BLI_task_graph_edge_create(task_node_user_data_init, task_node);
 }
 
@@ -5904,6 +5908,7 @@ static void extract_task_create(struct TaskGraph *task_graph,
     (*task_counter)++;
     struct TaskNode *one_task = BLI_task_graph_node_create(
         task_graph, extract_init_and_run, taskdata, extract_task_data_free);
+    BLI_task_graph_node_set_name(one_task, "Extract");
     BLI_task_graph_edge_create(task_node_mesh_render_data, one_task);
   }
   else {
@@ -82,6 +82,7 @@ void DRW_volume_batch_cache_free(struct Volume *volume);
 void DRW_batch_cache_free_old(struct Object *ob, int ctime);
 
 void DRW_mesh_batch_cache_free_old(struct Mesh *me, int ctime);
+bool DRW_mesh_batch_cache_last_used_get(struct Mesh *me, double *r_lastused);
 
 /* Generic */
 void DRW_vertbuf_create_wiredata(struct GPUVertBuf *vbo, const int vert_len);
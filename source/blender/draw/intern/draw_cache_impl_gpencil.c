@@ -47,6 +47,13 @@
 #define BEZIER_HANDLE 1 << 3
 #define COLOR_SHIFT 5
 
+/**
+ * Number of frames for which the batches are kept around. This avoids re-extracting and uploading
+ * all strokes of the object when going back to a frame which was drawn recently, like during
+ * looping playback. The least recently drawn frame is discarded first.
+ */
+#define GPENCIL_BATCH_CACHE_FRAMES_LEN 16
+
 /* ---------------------------------------------------------------------- */
 typedef struct GpencilBatchCache {
   /** Instancing Data */
@@ -72,46 +79,21 @@ typedef struct GpencilBatchCache {
   bool is_dirty;
   /** Last cache frame */
   int cache_frame;
+  /** Value of the draw counter when this frame was last used, for discarding old frames. */
+  uint64_t last_used;
 } GpencilBatchCache;
 
-static bool gpencil_batch_cache_valid(GpencilBatchCache *cache, bGPdata *gpd, int cfra)
+static bool gpencil_batch_cache_valid(GpencilBatchCache *cache, int cfra)
 {
-  bool valid = true;
-
-  if (cache == NULL) {
-    return false;
-  }
-
-  if (cfra != cache->cache_frame) {
-    valid = false;
-  }
-  else if (gpd->flag & GP_DATA_CACHE_IS_DIRTY) {
-    valid = false;
-  }
-  else if (cache->is_dirty) {
-    valid = false;
-  }
-
-  return valid;
+  return (cache->cache_frame == cfra) && !cache->is_dirty;
 }
 
-static GpencilBatchCache *gpencil_batch_cache_init(Object *ob, int cfra)
+static void gpencil_batch_cache_init(GpencilBatchCache *cache, int cfra)
 {
-  bGPdata *gpd = (bGPdata *)ob->data;
-
-  GpencilBatchCache *cache = gpd->runtime.gpencil_cache;
-
-  if (!cache) {
-    cache = gpd->runtime.gpencil_cache = MEM_callocN(sizeof(*cache), __func__);
-  }
-  else {
-    memset(cache, 0, sizeof(*cache));
-  }
+  memset(cache, 0, sizeof(*cache));
 
   cache->is_dirty = true;
   cache->cache_frame = cfra;
-
-  return cache;
 }
 
 static void gpencil_batch_cache_clear(GpencilBatchCache *cache)
@@ -138,15 +120,60 @@ static void gpencil_batch_cache_clear(GpencilBatchCache *cache)
   cache->is_dirty = true;
 }
 
+static void gpencil_stroke_offsets_update(Object *ob, int cfra);
+
 static GpencilBatchCache *gpencil_batch_cache_get(Object *ob, int cfra)
 {
   bGPdata *gpd = (bGPdata *)ob->data;
 
-  GpencilBatchCache *cache = gpd->runtime.gpencil_cache;
-  if (!gpencil_batch_cache_valid(cache, gpd, cfra)) {
+  /* One cache per frame, allocated together. */
+  GpencilBatchCache *caches = gpd->runtime.gpencil_cache;
+  if (caches == NULL) {
+    caches = gpd->runtime.gpencil_cache = MEM_calloc_arrayN(
+        GPENCIL_BATCH_CACHE_FRAMES_LEN, sizeof(*caches), __func__);
+    for (int i = 0; i < GPENCIL_BATCH_CACHE_FRAMES_LEN; i++) {
+      caches[i].is_dirty = true;
+    }
+  }
+
+  /* Any frame can be visible as onion skin, so an edit invalidates all of them. */
+  if (gpd->flag & GP_DATA_CACHE_IS_DIRTY) {
+    for (int i = 0; i < GPENCIL_BATCH_CACHE_FRAMES_LEN; i++) {
+      gpencil_batch_cache_clear(&caches[i]);
+    }
+  }
+
+  GpencilBatchCache *cache = NULL;
+  GpencilBatchCache *cache_last_used = &caches[0];
+  GpencilBatchCache *cache_oldest = &caches[0];
+  for (int i = 0; i < GPENCIL_BATCH_CACHE_FRAMES_LEN; i++) {
+    if (gpencil_batch_cache_valid(&caches[i], cfra)) {
+      cache = &caches[i];
+    }
+    if (caches[i].last_used > cache_last_used->last_used) {
+      cache_last_used = &caches[i];
+    }
+    /* Unused caches are reused first. */
+    if (cache_oldest->is_dirty) {
+      continue;
+    }
+    if (caches[i].is_dirty || caches[i].last_used < cache_oldest->last_used) {
+      cache_oldest = &caches[i];
+    }
+  }
+  const uint64_t last_used = cache_last_used->last_used + 1;
+
+  if (cache == NULL) {
+    cache = cache_oldest;
     gpencil_batch_cache_clear(cache);
-    return gpencil_batch_cache_init(ob, cfra);
+    gpencil_batch_cache_init(cache, cfra);
   }
+  else if (cache != cache_last_used) {
+    /* The strokes store their offsets inside the batches of the frame they were last drawn
+     * with, which may be a different frame when drawing them as onion skin. */
+    gpencil_stroke_offsets_update(ob, cfra);
+  }
+  cache->last_used = last_used;
 
   return cache;
 }
@@ -158,7 +185,12 @@ void DRW_gpencil_batch_cache_dirty_tag(bGPdata *gpd)
 
 void DRW_gpencil_batch_cache_free(bGPdata *gpd)
 {
-  gpencil_batch_cache_clear(gpd->runtime.gpencil_cache);
+  GpencilBatchCache *caches = gpd->runtime.gpencil_cache;
+  if (caches != NULL) {
+    for (int i = 0; i < GPENCIL_BATCH_CACHE_FRAMES_LEN; i++) {
+      gpencil_batch_cache_clear(&caches[i]);
+    }
+  }
   MEM_SAFE_FREE(gpd->runtime.gpencil_cache);
   gpd->flag |= GP_DATA_CACHE_IS_DIRTY;
 }
@@ -391,6 +423,27 @@ static void gpencil_object_verts_count_cb(bGPDlayer *UNUSED(gpl),
   iter->tri_len += gps->tot_triangles;
 }
 
+/**
+ * Set the offsets of the visible strokes for batches which are already built, the counting
+ * matches the one done in #gpencil_batches_ensure().
+ */
+static void gpencil_stroke_offsets_update(Object *ob, int cfra)
+{
+  /* IMPORTANT: Keep in sync with gpencil_batches_ensure() */
+  bool do_onion = true;
+
+  gpIterData iter = {
+      .gpd = (bGPdata *)ob->data,
+      .verts = NULL,
+      .ibo = {0},
+      .vert_len = 1,
+      .tri_len = 0,
+      .curve_len = 0,
+  };
+  BKE_gpencil_visible_stroke_iter(
+      NULL, ob, NULL, gpencil_object_verts_count_cb, &iter, do_onion, cfra);
+}
+
 static void gpencil_batches_ensure(Object *ob, GpencilBatchCache *cache, int cfra)
 {
   bGPdata *gpd = (bGPdata *)ob->data;
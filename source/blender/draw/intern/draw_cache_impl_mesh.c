@@ -41,6 +41,8 @@
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 
+#include "PIL_time.h"
+
 #include "BKE_customdata.h"
 #include "BKE_deform.h"
 #include "BKE_editmesh.h"
@@ -1135,6 +1137,21 @@ void DRW_mesh_batch_cache_free_old(Mesh *me, int ctime)
   mesh_cd_layers_type_clear(&cache->cd_used_over_time);
 }
 
+/**
+ * Get the time the batch cache of \a me was last requested for drawing.
+ * Returns false when there is no cache or it should never be evicted (edit-mode).
+ */
+bool DRW_mesh_batch_cache_last_used_get(Mesh *me, double *r_lastused)
+{
+  MeshBatchCache *cache = me->runtime.batch_cache;
+
+  if (cache == NULL || cache->is_editmode) {
+    return false;
+  }
+  *r_lastused = cache->lastused;
+  return true;
+}
+
 #ifdef DEBUG
 /* Sanity check function to test if all requested batches are available. */
 static void drw_mesh_batch_cache_check_available(struct TaskGraph *task_graph, Mesh *me)
@@ -1185,6 +1202,8 @@ void DRW_mesh_batch_cache_create_requested(struct TaskGraph *task_graph,
   MeshBatchCache *cache = mesh_batch_cache_get(me);
   bool cd_uv_update = false;
 
+  cache->lastused = PIL_check_seconds_timer();
+
   /* Early out */
   if (cache->batch_requested == 0) {
 #ifdef DEBUG
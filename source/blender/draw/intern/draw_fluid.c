@@ -26,6 +26,7 @@
 #include <string.h>
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_fluid_types.h"
@@ -175,6 +176,130 @@ static float *rescale_3d(const int dim[3],
   return nfpixels;
 }
 
+/* Fluid domains are often mostly empty. Instead of uploading the whole grid, the texture is
+ * cleared and only the bricks with non-zero values are uploaded. */
+#  define VOLUME_BRICK_SIZE 32
+
+typedef struct VolumeBrickData {
+  const int *dim;
+  int channels;
+  const float *data;
+  int bricks[3];
+  bool *brick_active;
+} VolumeBrickData;
+
+static void volume_brick_range(const VolumeBrickData *data,
+                               const int brick[3],
+                               int r_start[3],
+                               int r_size[3])
+{
+  for (int i = 0; i < 3; i++) {
+    r_start[i] = brick[i] * VOLUME_BRICK_SIZE;
+    r_size[i] = min_ii(VOLUME_BRICK_SIZE, data->dim[i] - r_start[i]);
+  }
+}
+
+static bool volume_brick_is_active(const VolumeBrickData *data, const int brick[3])
+{
+  const int *dim = data->dim;
+  int start[3], size[3];
+  volume_brick_range(data, brick, start, size);
+
+  for (int z = start[2]; z < start[2] + size[2]; z++) {
+    for (int y = start[1]; y < start[1] + size[1]; y++) {
+      const float *row = data->data + (((size_t)z * dim[1] + y) * dim[0] + start[0]) *
+                                          data->channels;
+      for (int i = 0; i < size[0] * data->channels; i++) {
+        if (row[i] != 0.0f) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+static void volume_brick_active_task(void *__restrict userdata,
+                                     const int brick_z,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  VolumeBrickData *data = userdata;
+
+  for (int brick_y = 0; brick_y < data->bricks[1]; brick_y++) {
+    for (int brick_x = 0; brick_x < data->bricks[0]; brick_x++) {
+      const int brick[3] = {brick_x, brick_y, brick_z};
+      const int index = (brick_z * data->bricks[1] + brick_y) * data->bricks[0] + brick_x;
+      data->brick_active[index] = volume_brick_is_active(data, brick);
+    }
+  }
+}
+
+/* Returns false when most of the grid is active, then uploading it at once is faster. */
+static bool volume_texture_update_sparse(GPUTexture *tex,
+                                         const int dim[3],
+                                         int channels,
+                                         const float *fpixels)
+{
+  VolumeBrickData data = {.dim = dim, .channels = channels, .data = fpixels};
+  for (int i = 0; i < 3; i++) {
+    data.bricks[i] = divide_ceil_u(dim[i], VOLUME_BRICK_SIZE);
+  }
+  const int bricks_num = data.bricks[0] * data.bricks[1] * data.bricks[2];
+  if (bricks_num <= 1) {
+    return false;
+  }
+  data.brick_active = MEM_mallocN(sizeof(*data.brick_active) * bricks_num, __func__);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0, data.bricks[2], &data, volume_brick_active_task, &settings);
+
+  int active_num = 0;
+  for (int i = 0; i < bricks_num; i++) {
+    active_num += data.brick_active[i];
+  }
+  if (active_num * 2 > bricks_num) {
+    MEM_freeN(data.brick_active);
+    return false;
+  }
+
+  const float zero[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+  GPU_texture_clear(tex, GPU_DATA_FLOAT, zero);
+
+  float *buffer = MEM_mallocN(sizeof(float) * channels * VOLUME_BRICK_SIZE * VOLUME_BRICK_SIZE *
+                                  VOLUME_BRICK_SIZE,
+                              __func__);
+  int brick[3];
+  for (brick[2] = 0; brick[2] < data.bricks[2]; brick[2]++) {
+    for (brick[1] = 0; brick[1] < data.bricks[1]; brick[1]++) {
+      for (brick[0] = 0; brick[0] < data.bricks[0]; brick[0]++) {
+        const int index = (brick[2] * data.bricks[1] + brick[1]) * data.bricks[0] + brick[0];
+        if (!data.brick_active[index]) {
+          continue;
+        }
+        int start[3], size[3];
+        volume_brick_range(&data, brick, start, size);
+
+        /* Pack the rows of the brick. */
+        const size_t row_len = (size_t)size[0] * channels;
+        float *dst = buffer;
+        for (int z = start[2]; z < start[2] + size[2]; z++) {
+          for (int y = start[1]; y < start[1] + size[1]; y++) {
+            const float *row = fpixels + (((size_t)z * dim[1] + y) * dim[0] + start[0]) * channels;
+            memcpy(dst, row, sizeof(float) * row_len);
+            dst += row_len;
+          }
+        }
+        GPU_texture_update_sub(tex, GPU_DATA_FLOAT, buffer, UNPACK3(start), UNPACK3(size));
+      }
+    }
+  }
+
+  MEM_freeN(buffer);
+  MEM_freeN(data.brick_active);
+  return true;
+}
+
 /* Will resize input to fit GL system limits. */
 static GPUTexture *create_volume_texture(const int dim[3],
                                          eGPUTextureFormat texture_format,
@@ -183,6 +308,7 @@ static GPUTexture *create_volume_texture(const int dim[3],
 {
   GPUTexture *tex = NULL;
   int final_dim[3] = {UNPACK3(dim)};
+  const int channels = (ELEM(texture_format, GPU_R8, GPU_R16F, GPU_R32F)) ? 1 : 4;
 
   if (data == NULL) {
     return NULL;
@@ -211,7 +337,10 @@ static GPUTexture *create_volume_texture(const int dim[3],
   }
   else if (equals_v3v3_int(dim, final_dim)) {
     /* No need to resize, just upload the data. */
-    GPU_texture_update_sub(tex, data_format, data, 0, 0, 0, UNPACK3(final_dim));
+    if (data_format != GPU_DATA_FLOAT ||
+        !volume_texture_update_sparse(tex, final_dim, channels, data)) {
+      GPU_texture_update_sub(tex, data_format, data, 0, 0, 0, UNPACK3(final_dim));
+    }
   }
   else if (data_format != GPU_DATA_FLOAT) {
     printf("Error: Could not allocate 3D texture and not attempting to rescale non-float data.\n");
@@ -219,7 +348,6 @@ static GPUTexture *create_volume_texture(const int dim[3],
   }
   else {
     /* We need to resize the input. */
-    int channels = (ELEM(texture_format, GPU_R8, GPU_R16F, GPU_R32F)) ? 1 : 4;
     float *rescaled_data = rescale_3d(dim, final_dim, channels, data);
     if (rescaled_data) {
       GPU_texture_update_sub(tex, GPU_DATA_FLOAT, rescaled_data, 0, 0, 0, UNPACK3(final_dim));
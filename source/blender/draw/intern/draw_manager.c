@@ -23,6 +23,7 @@
 #include <stdio.h>
 
 #include "BLI_alloca.h"
+#include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_memblock.h"
 #include "BLI_rect.h"
@@ -976,6 +977,117 @@ static void drw_drawdata_unlink_dupli(ID *id)
 /** \name Garbage Collection
  * \{ */
 
+/* Caches requested more recently than this (in seconds) are never evicted,
+ * this avoids freeing and rebuilding the batches of the visible meshes every redraw. */
+#define DRW_CACHE_LRU_MIN_AGE 2.0
+
+typedef struct DRWCacheLRUItem {
+  Mesh *mesh;
+  double lastused;
+} DRWCacheLRUItem;
+
+static int drw_cache_lru_item_cmp(const void *a_, const void *b_)
+{
+  const DRWCacheLRUItem *a = a_;
+  const DRWCacheLRUItem *b = b_;
+  if (a->lastused < b->lastused) {
+    return -1;
+  }
+  if (a->lastused > b->lastused) {
+    return 1;
+  }
+  return 0;
+}
+
+static Mesh *drw_cache_lru_mesh_get(Object *ob)
+{
+  switch (ob->type) {
+    case OB_MESH:
+      return (Mesh *)ob->data;
+    case OB_CURVE:
+    case OB_FONT:
+    case OB_SURF:
+      return BKE_object_get_evaluated_mesh(ob);
+    default:
+      return NULL;
+  }
+}
+
+/**
+ * Free the least recently used mesh batch caches until the vertex buffer memory
+ * is below the #UserDef.vbomemlimit budget.
+ * Hidden objects are included since their caches are the first candidates to go.
+ */
+static void drw_cache_limit_memory(Main *bmain)
+{
+  static double lasttime = 0.0;
+  const double ctime = PIL_check_seconds_timer();
+  const size_t limit = (size_t)U.vbomemlimit * 1024 * 1024;
+
+  if (U.vbomemlimit <= 0 || (ctime - lasttime) < 1.0 ||
+      (size_t)GPU_vertbuf_get_memory_usage() <= limit) {
+    return;
+  }
+
+  lasttime = ctime;
+
+  GSet *meshes = BLI_gset_ptr_new(__func__);
+  LISTBASE_FOREACH (Scene *, scene, &bmain->scenes) {
+    LISTBASE_FOREACH (ViewLayer *, view_layer, &scene->view_layers) {
+      Depsgraph *depsgraph = BKE_scene_get_depsgraph(scene, view_layer);
+      if (depsgraph == NULL) {
+        continue;
+      }
+      DEG_OBJECT_ITER_BEGIN (depsgraph,
+                             ob,
+                             DEG_ITER_OBJECT_FLAG_LINKED_DIRECTLY |
+                                 DEG_ITER_OBJECT_FLAG_LINKED_VIA_SET) {
+        Mesh *me = drw_cache_lru_mesh_get(ob);
+        if (me != NULL) {
+          BLI_gset_add(meshes, me);
+        }
+      }
+      DEG_OBJECT_ITER_END;
+    }
+  }
+
+  DRWCacheLRUItem *items = MEM_mallocN(sizeof(*items) * max_ii(1, BLI_gset_len(meshes)), __func__);
+  int items_len = 0;
+  GSET_FOREACH_BEGIN (Mesh *, me, meshes) {
+    double lastused;
+    if (DRW_mesh_batch_cache_last_used_get(me, &lastused) &&
+        (ctime - lastused) > DRW_CACHE_LRU_MIN_AGE) {
+      items[items_len].mesh = me;
+      items[items_len].lastused = lastused;
+      items_len++;
+    }
+  }
+  GSET_FOREACH_END();
+  BLI_gset_free(meshes, NULL);
+
+  qsort(items, items_len, sizeof(*items), drw_cache_lru_item_cmp);
+
+  const uint mem_prev = GPU_vertbuf_get_memory_usage();
+  int freed_len = 0;
+  for (; freed_len < items_len; freed_len++) {
+    if ((size_t)GPU_vertbuf_get_memory_usage() <= limit) {
+      break;
+    }
+    DRW_mesh_batch_cache_free(items[freed_len].mesh);
+  }
+  MEM_freeN(items);
+
+  if (G.debug & G_DEBUG_GPU) {
+    printf("Draw cache: freed %d mesh caches (%.2fMB), %.2fMB in use for a %dMB budget\n",
+           freed_len,
+           (double)(mem_prev - GPU_vertbuf_get_memory_usage()) / 1000000.0,
+           (double)GPU_vertbuf_get_memory_usage() / 1000000.0,
+           U.vbomemlimit);
+  }
+}
+
+#undef DRW_CACHE_LRU_MIN_AGE
+
 void DRW_cache_free_old_batches(Main *bmain)
 {
   Scene *scene;
@@ -983,6 +1095,8 @@ void DRW_cache_free_old_batches(Main *bmain)
   static int lasttime = 0;
   int ctime = (int)PIL_check_seconds_timer();
 
+  drw_cache_limit_memory(bmain);
+
   if (U.vbotimeout == 0 || (ctime - lasttime) < U.vbocollectrate || ctime == lasttime) {
     return;
   }
@@ -1462,7 +1576,7 @@ void DRW_draw_callbacks_post_scene(void)
       DRW_draw_gizmo_2d();
     }
 
-    if (G.debug_value > 20 && G.debug_value < 30) {
+    if (DRW_stats_is_enabled()) {
       GPU_depth_test(GPU_DEPTH_NONE);
       /* local coordinate visible rect inside region, to accommodate overlapping ui */
       const rcti *rect = ED_region_visible_rect(DST.draw_ctx.region);
@@ -2176,7 +2290,7 @@ void DRW_draw_render_loop_2d_ex(struct Depsgraph *depsgraph,
 
   DRW_stats_reset();
 
-  if (G.debug_value > 20 && G.debug_value < 30) {
+  if (DRW_stats_is_enabled()) {
     GPU_depth_test(GPU_DEPTH_NONE);
     /* local coordinate visible rect inside region, to accommodate overlapping ui */
     const rcti *rect = ED_region_visible_rect(DST.draw_ctx.region);
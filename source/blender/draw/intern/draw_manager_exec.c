@@ -26,6 +26,7 @@
 #include "BLI_math.h"
 #include "BLI_math_bits.h"
 #include "BLI_memblock.h"
+#include "BLI_task.h"
 
 #include "BKE_global.h"
 
@@ -485,45 +486,97 @@ void DRW_culling_frustum_planes_get(const DRWView *view, float planes[6][4])
   memcpy(planes, view->frustum_planes, sizeof(float[6][4]));
 }
 
+static void draw_culling_state_compute(const DRWView *view, DRWCullingState *cull)
+{
+  if (cull->bsphere.radius < 0.0) {
+    cull->mask = 0;
+  }
+  else {
+    bool culled = !draw_culling_sphere_test(
+        &view->frustum_bsphere, view->frustum_planes, &cull->bsphere);
+
+#ifdef DRW_DEBUG_CULLING
+    if (G.debug_value != 0) {
+      if (culled) {
+        DRW_debug_sphere(
+            cull->bsphere.center, cull->bsphere.radius, (const float[4]){1, 0, 0, 1});
+      }
+      else {
+        DRW_debug_sphere(
+            cull->bsphere.center, cull->bsphere.radius, (const float[4]){0, 1, 0, 1});
+      }
+    }
+#endif
+
+    if (view->visibility_fn) {
+      culled = !view->visibility_fn(!culled, cull->user_data);
+    }
+
+    SET_FLAG_FROM_TEST(cull->mask, culled, view->culling_mask);
+  }
+}
+
+typedef struct DRWCullingTaskData {
+  const DRWView *view;
+  int chunk_last;
+  int chunk_last_len;
+} DRWCullingTaskData;
+
+static void draw_compute_culling_chunk_cb(void *__restrict userdata,
+                                          const int chunk,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const DRWCullingTaskData *data = userdata;
+  /* Culling states are allocated along with the resource handles, so every chunk but the last
+   * one is full. */
+  const int elem_len = (chunk == data->chunk_last) ? data->chunk_last_len : DRW_RESOURCE_CHUNK_LEN;
+  if (elem_len == 0) {
+    return;
+  }
+  DRWCullingState *cull = BLI_memblock_elem_get(DST.vmempool->cullstates, chunk, 0);
+  for (int i = 0; i < elem_len; i++) {
+    draw_culling_state_compute(data->view, &cull[i]);
+  }
+}
+
 static void draw_compute_culling(DRWView *view)
 {
   view = view->parent ? view->parent : view;
 
-  /* TODO(fclem): multi-thread this. */
   /* TODO(fclem): compute all dirty views at once. */
   if (!view->is_dirty) {
     return;
   }
 
-  BLI_memblock_iter iter;
-  BLI_memblock_iternew(DST.vmempool->cullstates, &iter);
-  DRWCullingState *cull;
-  while ((cull = BLI_memblock_iterstep(&iter))) {
-    if (cull->bsphere.radius < 0.0) {
-      cull->mask = 0;
-    }
-    else {
-      bool culled = !draw_culling_sphere_test(
-          &view->frustum_bsphere, view->frustum_planes, &cull->bsphere);
-
+  bool use_threading = true;
 #ifdef DRW_DEBUG_CULLING
-      if (G.debug_value != 0) {
-        if (culled) {
-          DRW_debug_sphere(
-              cull->bsphere.center, cull->bsphere.radius, (const float[4]){1, 0, 0, 1});
-        }
-        else {
-          DRW_debug_sphere(
-              cull->bsphere.center, cull->bsphere.radius, (const float[4]){0, 1, 0, 1});
-        }
-      }
+  /* Debug shapes are not thread safe. */
+  use_threading = false;
 #endif
-
-      if (view->visibility_fn) {
-        culled = !view->visibility_fn(!culled, cull->user_data);
-      }
-
-      SET_FLAG_FROM_TEST(cull->mask, culled, view->culling_mask);
+  /* The visibility callback can share its user data between instances of the same object. */
+  if (view->visibility_fn) {
+    use_threading = false;
+  }
+
+  if (use_threading) {
+    DRWCullingTaskData data = {
+        .view = view,
+        .chunk_last = DRW_handle_chunk_get(&DST.resource_handle),
+        .chunk_last_len = DRW_handle_id_get(&DST.resource_handle),
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    /* Only worth it for scenes with many objects. */
+    settings.use_threading = (data.chunk_last > 4);
+    BLI_task_parallel_range(
+        0, data.chunk_last + 1, &data, draw_compute_culling_chunk_cb, &settings);
+  }
+  else {
+    BLI_memblock_iter iter;
+    BLI_memblock_iternew(DST.vmempool->cullstates, &iter);
+    DRWCullingState *cull;
+    while ((cull = BLI_memblock_iterstep(&iter))) {
+      draw_culling_state_compute(view, cull);
     }
   }
 
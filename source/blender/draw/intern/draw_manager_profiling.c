@@ -33,6 +33,7 @@
 #include "draw_manager.h"
 
 #include "GPU_debug.h"
+#include "GPU_query.h"
 #include "GPU_texture.h"
 
 #include "UI_resources.h"
@@ -45,7 +46,8 @@
 #define GPU_TIMER_FALLOFF 0.1
 
 typedef struct DRWTimer {
-  uint32_t query[2];
+  /* Begin and end timestamp query index, for each of the two query pools. */
+  int query[2][2];
   uint64_t time_average;
   char name[MAX_TIMER_NAME];
   int lvl;       /* Hierarchy level for nested timer. */
@@ -54,29 +56,53 @@ typedef struct DRWTimer {
 
 static struct DRWTimerPool {
   DRWTimer *timers;
+  /* Timestamps are recorded into one pool while the results of the other
+   * (previous redraw) are read back, so reading never waits for the GPU. */
+  GPUQueryPool *query_pools[2];
+  int query_pool_len[2]; /* Number of queries recorded in each pool. */
+  int query_pool_active;
   int chunk_count;     /* Number of chunk allocated. */
   int timer_count;     /* chunk_count * CHUNK_SIZE */
   int timer_increment; /* Keep track of where we are in the stack. */
   int end_increment;   /* Keep track of bad usage. */
   bool is_recording;   /* Are we in the render loop? */
   bool is_querying;    /* Keep track of bad usage. */
+  /* Copy of the timer results for the Python API. */
+  DRWGPUTiming *timings;
+  int timings_len;
 } DTP = {NULL};
 
 void DRW_stats_free(void)
 {
   if (DTP.timers != NULL) {
-    // for (int i = 0; i < DTP.timer_count; i++) {
-    // DRWTimer *timer = &DTP.timers[i];
-    // glDeleteQueries(2, timer->query);
-    // }
     MEM_freeN(DTP.timers);
     DTP.timers = NULL;
   }
+  for (int i = 0; i < 2; i++) {
+    if (DTP.query_pools[i] != NULL) {
+      GPU_query_pool_free(DTP.query_pools[i]);
+      DTP.query_pools[i] = NULL;
+    }
+    DTP.query_pool_len[i] = 0;
+  }
+  MEM_SAFE_FREE(DTP.timings);
+  DTP.timings_len = 0;
 }
 
-void DRW_stats_begin(void)
+/* True if the GPU timings should be recorded and displayed for this redraw. */
+bool DRW_stats_is_enabled(void)
 {
   if (G.debug_value > 20 && G.debug_value < 30) {
+    return true;
+  }
+  const View3D *v3d = DST.draw_ctx.v3d;
+  return (v3d != NULL) && ((v3d->flag2 & V3D_HIDE_OVERLAYS) == 0) &&
+         (v3d->overlay.flag & V3D_OVERLAY_GPU_TIMINGS);
+}
+
+void DRW_stats_begin(void)
+{
+  if (DRW_stats_is_enabled()) {
     DTP.is_recording = true;
   }
 
@@ -84,6 +110,9 @@ void DRW_stats_begin(void)
     DTP.chunk_count = 1;
     DTP.timer_count = DTP.chunk_count * CHUNK_SIZE;
     DTP.timers = MEM_callocN(sizeof(DRWTimer) * DTP.timer_count, "DRWTimer stack");
+    DTP.query_pools[0] = GPU_timestamp_pool_create();
+    DTP.query_pools[1] = GPU_timestamp_pool_create();
+    DTP.query_pool_active = 0;
   }
   else if (!DTP.is_recording && DTP.timers != NULL) {
     DRW_stats_free();
@@ -117,13 +146,9 @@ static void drw_stats_timer_start_ex(const char *name, const bool is_query)
     /* Queries cannot be nested or interleaved. */
     BLI_assert(!DTP.is_querying);
     if (timer->is_query) {
-      if (timer->query[0] == 0) {
-        // glGenQueries(1, timer->query);
-      }
-
-      // glFinish();
-      /* Issue query for the next frame */
-      // glBeginQuery(GL_TIME_ELAPSED, timer->query[0]);
+      const int pool = DTP.query_pool_active;
+      timer->query[pool][0] = GPU_timestamp_record(DTP.query_pools[pool]);
+      DTP.query_pool_len[pool]++;
       DTP.is_querying = true;
     }
   }
@@ -161,11 +186,33 @@ void DRW_stats_query_end(void)
   if (DTP.is_recording) {
     DTP.end_increment++;
     BLI_assert(DTP.is_querying);
-    // glEndQuery(GL_TIME_ELAPSED);
+    const int pool = DTP.query_pool_active;
+    /* The query timer is the last one started. */
+    DRWTimer *timer = &DTP.timers[DTP.timer_increment - 1];
+    timer->query[pool][1] = GPU_timestamp_record(DTP.query_pools[pool]);
+    DTP.query_pool_len[pool]++;
     DTP.is_querying = false;
   }
 }
 
+static void drw_stats_timings_update(void)
+{
+  if (DTP.timings_len != DTP.timer_increment) {
+    MEM_SAFE_FREE(DTP.timings);
+    DTP.timings_len = DTP.timer_increment;
+    if (DTP.timings_len > 0) {
+      DTP.timings = MEM_mallocN(sizeof(*DTP.timings) * DTP.timings_len, __func__);
+    }
+  }
+  for (int i = 0; i < DTP.timings_len; i++) {
+    const DRWTimer *timer = &DTP.timers[i];
+    DRWGPUTiming *timing = &DTP.timings[i];
+    BLI_strncpy(timing->name, timer->name, sizeof(timing->name));
+    timing->level = timer->lvl;
+    timing->time_ms = timer->time_average / 1000000.0;
+  }
+}
+
 void DRW_stats_reset(void)
 {
   BLI_assert((DTP.timer_increment - DTP.end_increment) <= 0 &&
@@ -176,25 +223,34 @@ void DRW_stats_reset(void)
   if (DTP.is_recording) {
     uint64_t lvl_time[MAX_NESTED_TIMER] = {0};
 
-    /* Swap queries for the next frame and sum up each lvl time. */
+    /* Read back the timestamps of the previous redraw, recorded in the other pool.
+     * Timers are expected to be issued in the same order on every redraw. */
+    const int pool_prev = !DTP.query_pool_active;
+    const int query_len = DTP.query_pool_len[pool_prev];
+    uint64_t *timestamps = NULL;
+    if (query_len > 0) {
+      timestamps = MEM_mallocN(sizeof(*timestamps) * query_len, __func__);
+      if (!GPU_timestamp_results_get(DTP.query_pools[pool_prev], timestamps, query_len)) {
+        /* GPU is more than one redraw behind, keep the previous averages. */
+        MEM_freeN(timestamps);
+        timestamps = NULL;
+      }
+    }
+
+    /* Sum up each lvl time. */
     for (int i = DTP.timer_increment - 1; i >= 0; i--) {
       DRWTimer *timer = &DTP.timers[i];
-      SWAP(uint32_t, timer->query[0], timer->query[1]);
 
       BLI_assert(timer->lvl < MAX_NESTED_TIMER);
 
       if (timer->is_query) {
-        uint64_t time = 0;
-        if (timer->query[0] != 0) {
-          // glGetQueryObjectui64v(timer->query[0], GL_QUERY_RESULT, &time);
-        }
-        else {
-          time = 1000000000; /* 1ms default */
+        const int *query = timer->query[pool_prev];
+        if (timestamps != NULL && query[1] < query_len && query[0] < query[1]) {
+          const uint64_t time = timestamps[query[1]] - timestamps[query[0]];
+          timer->time_average = timer->time_average * (1.0 - GPU_TIMER_FALLOFF) +
+                                time * GPU_TIMER_FALLOFF;
+          timer->time_average = MIN2(timer->time_average, 1000000000);
         }
-
-        timer->time_average = timer->time_average * (1.0 - GPU_TIMER_FALLOFF) +
-                              time * GPU_TIMER_FALLOFF;
-        timer->time_average = MIN2(timer->time_average, 1000000000);
       }
       else {
         timer->time_average = lvl_time[timer->lvl + 1];
@@ -203,11 +259,25 @@ void DRW_stats_reset(void)
 
       lvl_time[timer->lvl] += timer->time_average;
     }
+    MEM_SAFE_FREE(timestamps);
+
+    /* Swap pools for the next redraw. The previous pool was read, or is dropped. */
+    GPU_query_pool_reset(DTP.query_pools[pool_prev]);
+    DTP.query_pool_len[pool_prev] = 0;
+    DTP.query_pool_active = pool_prev;
+
+    drw_stats_timings_update();
 
     DTP.is_recording = false;
   }
 }
 
+int DRW_stats_gpu_timings_get(const DRWGPUTiming **r_timings)
+{
+  *r_timings = DTP.timings;
+  return DTP.timings_len;
+}
+
 static void draw_stat_5row(const rcti *rect, int u, int v, const char *txt, const int size)
 {
   BLF_draw_default_ascii(rect->xmin + (1 + u * 5) * U.widget_unit,
@@ -325,6 +395,12 @@ void DRW_stats_draw(const rcti *rect)
   draw_stat(rect, 1, v, stat_string, sizeof(stat_string));
   sprintf(stat_string, "%.2fMB", (double)vbo_mem / 1000000.0);
   draw_stat_5row(rect, 1, v++, stat_string, sizeof(stat_string));
+  if (U.vbomemlimit > 0) {
+    sprintf(stat_string, "Meshes Limit");
+    draw_stat(rect, 1, v, stat_string, sizeof(stat_string));
+    sprintf(stat_string, "%.2fMB", (double)U.vbomemlimit * 1024.0 * 1024.0 / 1000000.0);
+    draw_stat_5row(rect, 1, v++, stat_string, sizeof(stat_string));
+  }
   v += 1;
 
   /* GPU Timings */
@@ -336,8 +412,8 @@ void DRW_stats_draw(const rcti *rect)
     DRWTimer *timer = &DTP.timers[i];
     DRWTimer *timer_parent = (timer->lvl > 0) ? &DTP.timers[lvl_index[timer->lvl - 1]] : NULL;
 
-    /* Only display a number of lvl at a time */
-    if ((G.debug_value - 21) < timer->lvl) {
+    /* Only display a number of lvl at a time, or all of them for the overlay. */
+    if (G.debug_value > 20 && G.debug_value < 30 && (G.debug_value - 21) < timer->lvl) {
       continue;
     }
 
@@ -25,6 +25,7 @@
 struct rcti;
 
 void DRW_stats_free(void);
+bool DRW_stats_is_enabled(void);
 void DRW_stats_begin(void);
 void DRW_stats_reset(void);
 
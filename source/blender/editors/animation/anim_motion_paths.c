@@ -21,13 +21,16 @@
 #include "MEM_guardedalloc.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "BLI_dlrbTree.h"
 #include "BLI_listbase.h"
 #include "BLI_math.h"
+#include "BLI_threads.h"
 
 #include "DNA_anim_types.h"
 #include "DNA_armature_types.h"
+#include "DNA_rigidbody_types.h"
 #include "DNA_scene_types.h"
 
 #include "BKE_action.h"
@@ -74,10 +77,11 @@ static void motionpaths_calc_update_scene(struct Depsgraph *depsgraph)
   BKE_scene_graph_update_for_newframe(depsgraph);
 }
 
-Depsgraph *animviz_depsgraph_build(Main *bmain,
-                                   Scene *scene,
-                                   ViewLayer *view_layer,
-                                   ListBase *targets)
+/* Dependency graph which only contains the targets, not evaluated yet. */
+static Depsgraph *motionpaths_depsgraph_new(Main *bmain,
+                                            Scene *scene,
+                                            ViewLayer *view_layer,
+                                            ListBase *targets)
 {
   /* Allocate dependency graph. */
   Depsgraph *depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_VIEWPORT);
@@ -94,6 +98,16 @@ Depsgraph *animviz_depsgraph_build(Main *bmain,
   DEG_graph_build_from_ids(depsgraph, ids, num_ids);
   MEM_freeN(ids);
 
+  return depsgraph;
+}
+
+Depsgraph *animviz_depsgraph_build(Main *bmain,
+                                   Scene *scene,
+                                   ViewLayer *view_layer,
+                                   ListBase *targets)
+{
+  Depsgraph *depsgraph = motionpaths_depsgraph_new(bmain, scene, view_layer, targets);
+
   /* Update once so we can access pointers of evaluated animation data. */
   motionpaths_calc_update_scene(depsgraph);
   return depsgraph;
@@ -138,8 +152,13 @@ void animviz_get_object_motionpaths(Object *ob, ListBase *targets)
 
 /* ........ */
 
-/* perform baking for the targets on the current frame */
-static void motionpaths_calc_bake_targets(ListBase *targets, int cframe)
+/* perform baking for the targets on the current frame
+ * - update_eval: also update the motion paths of the evaluated objects, main thread only
+ */
+static void motionpaths_calc_bake_targets(ListBase *targets,
+                                          Depsgraph *depsgraph,
+                                          int cframe,
+                                          const bool update_eval)
 {
   MPathTarget *mpt;
 
@@ -157,7 +176,7 @@ static void motionpaths_calc_bake_targets(ListBase *targets, int cframe)
     /* get the relevant cache vert to write to */
     bMotionPathVert *mpv = mpath->points + (cframe - mpath->start_frame);
 
-    Object *ob_eval = mpt->ob_eval;
+    Object *ob_eval = (depsgraph) ? DEG_get_evaluated_object(depsgraph, mpt->ob) : mpt->ob_eval;
 
     /* Lookup evaluated pose channel, here because the depsgraph
      * evaluation can change them so they are not cached in mpt. */
@@ -194,6 +213,10 @@ static void motionpaths_calc_bake_targets(ListBase *targets, int cframe)
       mpv->flag &= ~MOTIONPATH_VERT_KEY;
     }
 
+    if (!update_eval) {
+      continue;
+    }
+
     /* Incremental update on evaluated object if possible, for fast updating
      * while dragging in transform. */
     bMotionPath *mpath_eval = NULL;
@@ -346,6 +369,83 @@ static void motionpath_calculate_update_range(MPathTarget *mpt,
   }
 }
 
+/* Frames evaluated in parallel, using several dependency graphs.
+ *
+ * Only the object and bone transforms of the targets are needed, which for animation only depend
+ * on the frame, so each graph can evaluate any frame. Every graph holds evaluated copies of the
+ * targets, so their number is kept low. */
+
+#define MOTIONPATH_PARALLEL_GRAPHS_MAX 8
+/* Creating and evaluating an extra graph is not worth it for fewer frames. */
+#define MOTIONPATH_PARALLEL_FRAMES_PER_GRAPH 16
+
+static void motionpaths_calc_frame_cb(Depsgraph *depsgraph, int frame, void *user_data)
+{
+  ListBase *targets = user_data;
+  motionpaths_calc_bake_targets(targets, depsgraph, frame, false);
+}
+
+static bool motionpaths_calc_parallel(Main *bmain,
+                                      Scene *scene,
+                                      ViewLayer *view_layer,
+                                      ListBase *targets,
+                                      int sfra,
+                                      int efra)
+{
+  /* Rigid body simulation has to step through frames in order. */
+  if (scene->rigidbody_world != NULL) {
+    return false;
+  }
+
+  const int graphs_len = min_ii(min_ii(BLI_system_thread_count(), MOTIONPATH_PARALLEL_GRAPHS_MAX),
+                                (efra - sfra + 1) / MOTIONPATH_PARALLEL_FRAMES_PER_GRAPH);
+  if (graphs_len < 2) {
+    return false;
+  }
+
+  CLOG_INFO(&LOG, 1, "Evaluating frames with %d dependency graphs", graphs_len);
+
+  Depsgraph *graphs[MOTIONPATH_PARALLEL_GRAPHS_MAX];
+  for (int i = 0; i < graphs_len; i++) {
+    graphs[i] = motionpaths_depsgraph_new(bmain, scene, view_layer, targets);
+  }
+
+  DEG_evaluate_frames_parallel(graphs, graphs_len, sfra, efra, motionpaths_calc_frame_cb, targets);
+
+  for (int i = 0; i < graphs_len; i++) {
+    DEG_graph_free(graphs[i]);
+  }
+
+  /* Update evaluated paths for the range at once, as the serial evaluation does per frame. */
+  LISTBASE_FOREACH (MPathTarget *, mpt, targets) {
+    bMotionPath *mpath = mpt->mpath;
+    bMotionPath *mpath_eval = NULL;
+    if (mpt->pchan) {
+      bPoseChannel *pchan_eval = BKE_pose_channel_find_name(mpt->ob_eval->pose, mpt->pchan->name);
+      mpath_eval = (pchan_eval) ? pchan_eval->mpath : NULL;
+    }
+    else {
+      mpath_eval = mpt->ob_eval->mpath;
+    }
+
+    if (mpath_eval && mpath_eval->length == mpath->length) {
+      const int start = max_ii(sfra, mpath->start_frame);
+      const int end = min_ii(efra, mpath->end_frame - 1);
+      if (start <= end) {
+        memcpy(mpath_eval->points + (start - mpath_eval->start_frame),
+               mpath->points + (start - mpath->start_frame),
+               sizeof(bMotionPathVert) * (end - start + 1));
+      }
+
+      GPU_VERTBUF_DISCARD_SAFE(mpath_eval->points_vbo);
+      GPU_BATCH_DISCARD_SAFE(mpath_eval->batch_line);
+      GPU_BATCH_DISCARD_SAFE(mpath_eval->batch_points);
+    }
+  }
+
+  return true;
+}
+
 static void motionpath_free_free_tree_data(ListBase *targets)
 {
   LISTBASE_FOREACH (MPathTarget *, mpt, targets) {
@@ -464,18 +564,22 @@ void animviz_calc_motionpaths(Depsgraph *depsgraph,
             sfra,
             efra,
             efra - sfra + 1);
-  for (CFRA = sfra; CFRA <= efra; CFRA++) {
-    if (range == ANIMVIZ_CALC_RANGE_CURRENT_FRAME) {
-      /* For current frame, only update tagged. */
-      BKE_scene_graph_update_tagged(depsgraph, bmain);
-    }
-    else {
-      /* Update relevant data for new frame. */
-      motionpaths_calc_update_scene(depsgraph);
-    }
+  if (range == ANIMVIZ_CALC_RANGE_CURRENT_FRAME ||
+      !motionpaths_calc_parallel(
+          bmain, scene, DEG_get_input_view_layer(depsgraph), targets, sfra, efra)) {
+    for (CFRA = sfra; CFRA <= efra; CFRA++) {
+      if (range == ANIMVIZ_CALC_RANGE_CURRENT_FRAME) {
+        /* For current frame, only update tagged. */
+        BKE_scene_graph_update_tagged(depsgraph, bmain);
+      }
+      else {
+        /* Update relevant data for new frame. */
+        motionpaths_calc_update_scene(depsgraph);
+      }
 
-    /* perform baking for targets */
-    motionpaths_calc_bake_targets(targets, CFRA);
+      /* perform baking for targets */
+      motionpaths_calc_bake_targets(targets, NULL, CFRA, true);
+    }
   }
 
   /* reset original environment */
@@ -3040,10 +3040,11 @@ static int remove_doubles_exec(bContext *C, wmOperator *op)
   ParticleSystem *psys = edit->psys;
   ParticleSystemModifierData *psmd_eval;
   KDTree_3d *tree;
-  KDTreeNearest_3d nearest[10];
+  KDTreeNearest_3d *nearest;
   POINT_P;
-  float mat[4][4], co[3], threshold = RNA_float_get(op->ptr, "threshold");
-  int n, totn, removed, totremoved;
+  float mat[4][4], (*cos)[3], threshold = RNA_float_get(op->ptr, "threshold");
+  int *point_indices, *nearest_len, points_len, n, removed, totremoved;
+  const int nearest_len_capacity = 10;
 
   if (psys->flag & PSYS_GLOBAL_HAIR) {
     return OPERATOR_CANCELLED;
@@ -3057,30 +3058,36 @@ static int remove_doubles_exec(bContext *C, wmOperator *op)
     removed = 0;
 
     tree = BLI_kdtree_3d_new(psys->totpart);
+    cos = MEM_mallocN(sizeof(*cos) * psys->totpart, __func__);
+    point_indices = MEM_mallocN(sizeof(*point_indices) * psys->totpart, __func__);
+    points_len = 0;
 
     /* insert particles into kd tree */
     LOOP_SELECTED_POINTS {
       psys_mat_hair_to_object(
           ob, psmd_eval->mesh_final, psys->part->from, psys->particles + p, mat);
-      copy_v3_v3(co, point->keys->co);
-      mul_m4_v3(mat, co);
-      BLI_kdtree_3d_insert(tree, p, co);
+      mul_v3_m4v3(cos[points_len], mat, point->keys->co);
+      BLI_kdtree_3d_insert(tree, p, cos[points_len]);
+      point_indices[points_len++] = p;
     }
 
     BLI_kdtree_3d_balance(tree);
 
-    /* tag particles to be removed */
-    LOOP_SELECTED_POINTS {
-      psys_mat_hair_to_object(
-          ob, psmd_eval->mesh_final, psys->part->from, psys->particles + p, mat);
-      copy_v3_v3(co, point->keys->co);
-      mul_m4_v3(mat, co);
+    /* find the neighbors of all particles at once */
+    nearest = MEM_mallocN(sizeof(*nearest) * nearest_len_capacity * points_len, __func__);
+    nearest_len = MEM_mallocN(sizeof(*nearest_len) * points_len, __func__);
+    BLI_kdtree_3d_find_nearest_n_multi(
+        tree, (const float(*)[3])cos, points_len, nearest, nearest_len_capacity, nearest_len);
 
-      totn = BLI_kdtree_3d_find_nearest_n(tree, co, nearest, 10);
+    /* tag particles to be removed */
+    for (int i = 0; i < points_len; i++) {
+      const KDTreeNearest_3d *point_nearest = &nearest[i * nearest_len_capacity];
+      p = point_indices[i];
+      point = &edit->points[p];
 
-      for (n = 0; n < totn; n++) {
+      for (n = 0; n < nearest_len[i]; n++) {
         /* this needs a custom threshold still */
-        if (nearest[n].index > p && nearest[n].dist < threshold) {
+        if (point_nearest[n].index > p && point_nearest[n].dist < threshold) {
           if (!(point->flag & PEP_TAG)) {
             point->flag |= PEP_TAG;
             removed++;
@@ -3089,6 +3096,10 @@ static int remove_doubles_exec(bContext *C, wmOperator *op)
       }
     }
 
+    MEM_freeN(nearest);
+    MEM_freeN(nearest_len);
+    MEM_freeN(point_indices);
+    MEM_freeN(cos);
     BLI_kdtree_3d_free(tree);
 
     /* remove tagged particles - don't do mirror here! */
@@ -887,17 +887,57 @@ static int project_paint_occlude_ptv_clip(const float pt[3],
   return -1;
 }
 
+static bool project_tri_point_occluded(const ProjPaintState *ps,
+                                       const int tri_index,
+                                       const float pixelScreenCo[4],
+                                       const bool do_clip)
+{
+  const MLoopTri *lt = &ps->mlooptri_eval[tri_index];
+  const float *vtri_ss[3] = {
+      ps->screenCoords[ps->mloop_eval[lt->tri[0]].v],
+      ps->screenCoords[ps->mloop_eval[lt->tri[1]].v],
+      ps->screenCoords[ps->mloop_eval[lt->tri[2]].v],
+  };
+  float w[3];
+  int isect_ret;
+
+  if (do_clip) {
+    const float *vtri_co[3] = {
+        ps->mvert_eval[ps->mloop_eval[lt->tri[0]].v].co,
+        ps->mvert_eval[ps->mloop_eval[lt->tri[1]].v].co,
+        ps->mvert_eval[ps->mloop_eval[lt->tri[2]].v].co,
+    };
+    isect_ret = project_paint_occlude_ptv_clip(
+        pixelScreenCo, UNPACK3(vtri_ss), UNPACK3(vtri_co), w, ps->is_ortho, ps->rv3d);
+  }
+  else {
+    isect_ret = project_paint_occlude_ptv(pixelScreenCo, UNPACK3(vtri_ss), w, ps->is_ortho);
+  }
+
+  return isect_ret >= 1;
+}
+
 /* Check if a screenspace location is occluded by any other faces
  * check, pixelScreenCo must be in screenspace, its Z-Depth only needs to be used for comparison
  * and doesn't need to be correct in relation to X and Y coords
- * (this is the case in perspective view) */
+ * (this is the case in perspective view).
+ *
+ * `r_occlude_tri_hint` is the face which occluded the previous point (or -1), it's tested first
+ * since neighboring pixels are most likely occluded by the same face. It's set to the occluding
+ * face when there is one. */
 static bool project_bucket_point_occluded(const ProjPaintState *ps,
                                           LinkNode *bucketFace,
                                           const int orig_face,
-                                          const float pixelScreenCo[4])
+                                          const float pixelScreenCo[4],
+                                          int *r_occlude_tri_hint)
 {
-  int isect_ret;
   const bool do_clip = RV3D_CLIPPING_ENABLED(ps->v3d, ps->rv3d);
+  const int tri_hint = *r_occlude_tri_hint;
+
+  if (tri_hint != -1 && tri_hint != orig_face &&
+      project_tri_point_occluded(ps, tri_hint, pixelScreenCo, do_clip)) {
+    return true;
+  }
 
   /* we could return false for 1 face buckets, as long as this function assumes
    * that the point its testing is only every originated from an existing face */
@@ -905,33 +945,10 @@ static bool project_bucket_point_occluded(const ProjPaintState *ps,
   for (; bucketFace; bucketFace = bucketFace->next) {
     const int tri_index = POINTER_AS_INT(bucketFace->link);
 
-    if (orig_face != tri_index) {
-      const MLoopTri *lt = &ps->mlooptri_eval[tri_index];
-      const float *vtri_ss[3] = {
-          ps->screenCoords[ps->mloop_eval[lt->tri[0]].v],
-          ps->screenCoords[ps->mloop_eval[lt->tri[1]].v],
-          ps->screenCoords[ps->mloop_eval[lt->tri[2]].v],
-      };
-      float w[3];
-
-      if (do_clip) {
-        const float *vtri_co[3] = {
-            ps->mvert_eval[ps->mloop_eval[lt->tri[0]].v].co,
-            ps->mvert_eval[ps->mloop_eval[lt->tri[1]].v].co,
-            ps->mvert_eval[ps->mloop_eval[lt->tri[2]].v].co,
-        };
-        isect_ret = project_paint_occlude_ptv_clip(
-            pixelScreenCo, UNPACK3(vtri_ss), UNPACK3(vtri_co), w, ps->is_ortho, ps->rv3d);
-      }
-      else {
-        isect_ret = project_paint_occlude_ptv(pixelScreenCo, UNPACK3(vtri_ss), w, ps->is_ortho);
-      }
-
-      if (isect_ret >= 1) {
-        /* TODO - we may want to cache the first hit,
-         * it is not possible to swap the face order in the list anymore */
-        return true;
-      }
+    if (!ELEM(tri_index, orig_face, tri_hint) &&
+        project_tri_point_occluded(ps, tri_index, pixelScreenCo, do_clip)) {
+      *r_occlude_tri_hint = tri_index;
+      return true;
     }
   }
   return false;
@@ -3006,6 +3023,8 @@ static void project_paint_face_init(const ProjPaintState *ps,
   float *uv1co, *uv2co, *uv3co;
   float pixelScreenCo[4];
   bool do_3d_mapping = ps->brush->mtex.brush_map_mode == MTEX_MAP_MODE_3D;
+  /* Last face found to occlude a pixel of this face. */
+  int occlude_tri_hint = -1;
 
   /* ispace bounds */
   rcti bounds_px;
@@ -3138,7 +3157,8 @@ static void project_paint_face_init(const ProjPaintState *ps,
             /* project_paint_PickFace is less complex, use for testing */
             // if (project_paint_PickFace(ps, pixelScreenCo, w, &side) == tri_index) {
             if ((ps->do_occlude == false) ||
-                !project_bucket_point_occluded(ps, bucketFaceNodes, tri_index, pixelScreenCo)) {
+                !project_bucket_point_occluded(
+                    ps, bucketFaceNodes, tri_index, pixelScreenCo, &occlude_tri_hint)) {
               mask = project_paint_uvpixel_mask(ps, tri_index, w);
 
               if (mask > 0.0f) {
@@ -3367,8 +3387,11 @@ static void project_paint_face_init(const ProjPaintState *ps,
                     }
 
                     if ((ps->do_occlude == false) ||
-                        !project_bucket_point_occluded(
-                            ps, bucketFaceNodes, tri_index, pixel_on_edge)) {
+                        !project_bucket_point_occluded(ps,
+                                                      bucketFaceNodes,
+                                                      tri_index,
+                                                      pixel_on_edge,
+                                                      &occlude_tri_hint)) {
                       /* a pity we need to get the worldspace
                        * pixel location here */
                       if (do_clip || do_3d_mapping) {
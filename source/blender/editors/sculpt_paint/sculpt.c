@@ -2444,6 +2444,38 @@ float SCULPT_brush_strength_factor(SculptSession *ss,
   StrokeCache *cache = ss->cache;
   const Scene *scene = cache->vc->scene;
   const MTex *mtex = &br->mtex;
+  /* Hardness. */
+  float final_len = len;
+  const float hardness = cache->paint_brush.hardness;
+  float p = len / cache->radius;
+  if (p < hardness) {
+    final_len = 0.0f;
+  }
+  else if (hardness == 1.0f) {
+    final_len = cache->radius;
+  }
+  else {
+    p = (p - hardness) / (1.0f - hardness);
+    final_len = p * cache->radius;
+  }
+
+  /* Falloff curve. */
+  const float falloff = BKE_brush_curve_strength(br, final_len, cache->radius);
+  const float front = frontface(br, cache->view_normal, vno, fno);
+
+  /* Paint mask. */
+  const float unmasked = 1.0f - mask;
+
+  /* Auto-masking. */
+  const float automask = SCULPT_automasking_factor_get(cache->automasking, ss, vertex_index);
+
+  /* Texture sampling is by far the most expensive part, skip it for vertices which are not
+   * affected anyway. Many are, e.g. the outer part of a brush with a sharp falloff or a masked
+   * area. */
+  if (falloff == 0.0f || front == 0.0f || unmasked == 0.0f || automask == 0.0f) {
+    return 0.0f;
+  }
+
   float avg = 1.0f;
   float rgba[4];
   float point[3];
@@ -2500,30 +2532,10 @@ float SCULPT_brush_strength_factor(SculptSession *ss,
     }
   }
 
-  /* Hardness. */
-  float final_len = len;
-  const float hardness = cache->paint_brush.hardness;
-  float p = len / cache->radius;
-  if (p < hardness) {
-    final_len = 0.0f;
-  }
-  else if (hardness == 1.0f) {
-    final_len = cache->radius;
-  }
-  else {
-    p = (p - hardness) / (1.0f - hardness);
-    final_len = p * cache->radius;
-  }
-
-  /* Falloff curve. */
-  avg *= BKE_brush_curve_strength(br, final_len, cache->radius);
-  avg *= frontface(br, cache->view_normal, vno, fno);
-
-  /* Paint mask. */
-  avg *= 1.0f - mask;
-
-  /* Auto-masking. */
-  avg *= SCULPT_automasking_factor_get(cache->automasking, ss, vertex_index);
+  avg *= falloff;
+  avg *= front;
+  avg *= unmasked;
+  avg *= automask;
 
   return avg;
 }
@@ -600,6 +600,14 @@ typedef struct SculptUndoNodeGeometry {
   int totpoly;
 } SculptUndoNodeGeometry;
 
+/* Compressed #SculptUndoNode arrays, see #sculpt_undo_node_pack. */
+typedef struct SculptUndoNodePacked {
+  void *data;
+  size_t data_size;
+  /* Sizes of #SculptUndoNode.co, orig_co, mask and col before compression. */
+  size_t array_sizes[4];
+} SculptUndoNodePacked;
+
 typedef struct SculptUndoNode {
   struct SculptUndoNode *next, *prev;
 
@@ -613,6 +621,8 @@ typedef struct SculptUndoNode {
   short (*no)[3];
   float (*col)[4];
   float *mask;
+  /* The arrays above while they are compressed, NULL otherwise. */
+  SculptUndoNodePacked *packed;
   int totvert;
 
   /* non-multires */
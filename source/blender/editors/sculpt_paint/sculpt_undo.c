@@ -70,6 +70,15 @@
 #include "bmesh.h"
 #include "sculpt_intern.h"
 
+#ifdef WITH_LZO
+#  ifdef WITH_SYSTEM_LZO
+#    include <lzo/lzo1x.h>
+#  else
+#    include "minilzo.h"
+#  endif
+#  define LZO_OUT_LEN(size) ((size) + (size) / 16 + 64 + 3)
+#endif
+
 /* Implementation of undo system for objects in sculpt mode.
  *
  * Each undo step in sculpt mode consists of list of nodes, each node contains:
@@ -635,6 +644,149 @@ static void sculpt_undo_refine_subdiv(Depsgraph *depsgraph,
   MEM_freeN(deformed_verts);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Undo Node Compression
+ *
+ * Once a step is pushed, the coordinates, masks and colors of its nodes are only read again when
+ * the step is undone or redone, so they are kept LZO compressed in between. The floats are byte
+ * shuffled first (all first bytes, then all second bytes and so on): sign, exponent and high
+ * mantissa bytes are mostly the same for nearby vertices, which compresses far better than
+ * interleaved floats. Compression is lossless, so restoring gives back the exact state.
+ *
+ * While restoring, nodes are decompressed one at a time and compressed again right after.
+ * \{ */
+
+#ifdef WITH_LZO
+#  define SCULPT_UNDO_PACKED_ARRAYS_NUM 4
+
+static void sculpt_undo_node_packed_arrays(SculptUndoNode *unode,
+                                           void **r_arrays[SCULPT_UNDO_PACKED_ARRAYS_NUM])
+{
+  r_arrays[0] = (void **)&unode->co;
+  r_arrays[1] = (void **)&unode->orig_co;
+  r_arrays[2] = (void **)&unode->mask;
+  r_arrays[3] = (void **)&unode->col;
+}
+#endif
+
+/**
+ * Compress the arrays of the node, if that makes them smaller.
+ * \param undo_size: When not NULL, adjusted for the memory saved.
+ */
+static void sculpt_undo_node_pack(SculptUndoNode *unode, size_t *undo_size)
+{
+#ifdef WITH_LZO
+  if (unode->packed || unode->bm_entry) {
+    return;
+  }
+
+  void **arrays[SCULPT_UNDO_PACKED_ARRAYS_NUM];
+  size_t array_sizes[SCULPT_UNDO_PACKED_ARRAYS_NUM];
+  size_t data_size = 0;
+  sculpt_undo_node_packed_arrays(unode, arrays);
+  for (int i = 0; i < SCULPT_UNDO_PACKED_ARRAYS_NUM; i++) {
+    array_sizes[i] = *arrays[i] ? MEM_allocN_len(*arrays[i]) : 0;
+    /* Empty arrays would not be allocated again by #sculpt_undo_node_unpack. */
+    if (*arrays[i] && array_sizes[i] == 0) {
+      return;
+    }
+    data_size += array_sizes[i];
+  }
+  if (data_size == 0) {
+    return;
+  }
+
+  const size_t floats_len = data_size / sizeof(float);
+  unsigned char *data = MEM_mallocN(data_size, __func__);
+  size_t offset = 0;
+  for (int i = 0; i < SCULPT_UNDO_PACKED_ARRAYS_NUM; i++) {
+    const unsigned char *src = *arrays[i];
+    const size_t array_floats_len = array_sizes[i] / sizeof(float);
+    for (size_t j = 0; j < array_floats_len; j++, src += sizeof(float)) {
+      for (int b = 0; b < (int)sizeof(float); b++) {
+        data[b * floats_len + offset + j] = src[b];
+      }
+    }
+    offset += array_floats_len;
+  }
+
+  lzo_uint out_len = LZO_OUT_LEN(data_size);
+  unsigned char *out = MEM_mallocN(out_len, "SculptUndoNodePacked.data");
+  void *wrkmem = MEM_mallocN(LZO1X_MEM_COMPRESS, __func__);
+  const int r = lzo1x_1_compress(data, (lzo_uint)data_size, out, &out_len, wrkmem);
+  MEM_freeN(wrkmem);
+  MEM_freeN(data);
+
+  if (r != LZO_E_OK || out_len >= data_size) {
+    MEM_freeN(out);
+    return;
+  }
+
+  SculptUndoNodePacked *packed = MEM_callocN(sizeof(*packed), "SculptUndoNodePacked");
+  packed->data = MEM_reallocN(out, out_len);
+  packed->data_size = out_len;
+  memcpy(packed->array_sizes, array_sizes, sizeof(array_sizes));
+  for (int i = 0; i < SCULPT_UNDO_PACKED_ARRAYS_NUM; i++) {
+    MEM_SAFE_FREE(*arrays[i]);
+  }
+  unode->packed = packed;
+
+  if (undo_size) {
+    *undo_size = *undo_size - data_size + out_len + sizeof(*packed);
+  }
+#else
+  UNUSED_VARS(unode, undo_size);
+#endif
+}
+
+static void sculpt_undo_node_unpack(SculptUndoNode *unode)
+{
+#ifdef WITH_LZO
+  SculptUndoNodePacked *packed = unode->packed;
+  if (packed == NULL) {
+    return;
+  }
+
+  size_t data_size = 0;
+  for (int i = 0; i < SCULPT_UNDO_PACKED_ARRAYS_NUM; i++) {
+    data_size += packed->array_sizes[i];
+  }
+
+  unsigned char *data = MEM_mallocN(data_size, __func__);
+  lzo_uint out_len = data_size;
+  lzo1x_decompress_safe(packed->data, packed->data_size, data, &out_len, NULL);
+  BLI_assert(out_len == data_size);
+
+  void **arrays[SCULPT_UNDO_PACKED_ARRAYS_NUM];
+  sculpt_undo_node_packed_arrays(unode, arrays);
+  const size_t floats_len = data_size / sizeof(float);
+  size_t offset = 0;
+  for (int i = 0; i < SCULPT_UNDO_PACKED_ARRAYS_NUM; i++) {
+    if (packed->array_sizes[i] == 0) {
+      continue;
+    }
+    unsigned char *dst = MEM_mallocN(packed->array_sizes[i], "SculptUndoNode array");
+    *arrays[i] = dst;
+    const size_t array_floats_len = packed->array_sizes[i] / sizeof(float);
+    for (size_t j = 0; j < array_floats_len; j++, dst += sizeof(float)) {
+      for (int b = 0; b < (int)sizeof(float); b++) {
+        dst[b] = data[b * floats_len + offset + j];
+      }
+    }
+    offset += array_floats_len;
+  }
+
+  MEM_freeN(data);
+  MEM_freeN(packed->data);
+  MEM_freeN(packed);
+  unode->packed = NULL;
+#else
+  UNUSED_VARS(unode);
+#endif
+}
+
+/** \} */
+
 static void sculpt_undo_restore_list(bContext *C, Depsgraph *depsgraph, ListBase *lb)
 {
   Scene *scene = CTX_data_scene(C);
@@ -731,6 +883,8 @@ static void sculpt_undo_restore_list(bContext *C, Depsgraph *depsgraph, ListBase
       use_multires_undo = true;
     }
 
+    sculpt_undo_node_unpack(unode);
+
     switch (unode->type) {
       case SCULPT_UNDO_COORDS:
         if (sculpt_undo_restore_coords(C, depsgraph, unode)) {
@@ -769,6 +923,8 @@ static void sculpt_undo_restore_list(bContext *C, Depsgraph *depsgraph, ListBase
         BLI_assert(!"Dynamic topology should've already been handled");
         break;
     }
+
+    sculpt_undo_node_pack(unode, NULL);
   }
 
   if (use_multires_undo) {
@@ -885,6 +1041,10 @@ static void sculpt_undo_free_list(ListBase *lb)
     if (unode->mask) {
       MEM_freeN(unode->mask);
     }
+    if (unode->packed) {
+      MEM_freeN(unode->packed->data);
+      MEM_freeN(unode->packed);
+    }
 
     if (unode->bm_entry) {
       BM_log_entry_drop(unode->bm_entry);
@@ -1419,6 +1579,9 @@ void SCULPT_undo_push_end_ex(const bool use_nested_undo)
       MEM_freeN(unode->no);
       unode->no = NULL;
     }
+
+    /* The rest is only needed again on undo and redo. */
+    sculpt_undo_node_pack(unode, &usculpt->undo_size);
   }
 
   /* We could remove this and enforce all callers run in an operator using 'OPTYPE_UNDO'. */
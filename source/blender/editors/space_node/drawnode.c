@@ -4008,6 +4008,14 @@ static bool node_link_bezier_handles(const View2D *v2d,
   if (v2d && max_ffff(vec[0][0], vec[1][0], vec[2][0], vec[3][0]) < v2d->cur.xmin) {
     return false; /* clipped */
   }
+  /* The curve lies within the bounds of its control points, so links entirely above or below
+   * the view can be skipped too, which matters for large trees scrolled vertically. */
+  if (v2d && min_ffff(vec[0][1], vec[1][1], vec[2][1], vec[3][1]) > v2d->cur.ymax) {
+    return false; /* clipped */
+  }
+  if (v2d && max_ffff(vec[0][1], vec[1][1], vec[2][1], vec[3][1]) < v2d->cur.ymin) {
+    return false; /* clipped */
+  }
 
   return true;
 }
@@ -1117,6 +1117,56 @@ void node_draw_sockets(const View2D *v2d,
   GPU_blend(GPU_BLEND_NONE);
 }
 
+/* Statistics of the last compositor or geometry nodes execution, drawn above the node. */
+static void node_draw_exec_stats(const SpaceNode *snode, bNodeTree *ntree, bNode *node)
+{
+  if (!(snode->flag & SNODE_SHOW_EXEC_STATS) ||
+      !ELEM(ntree->type, NTREE_COMPOSIT, NTREE_GEOMETRY)) {
+    return;
+  }
+  const bNodeExecStats *stats = &node->exec_stats;
+  char str[128];
+  if (ntree->type == NTREE_COMPOSIT) {
+    if (stats->pixels == 0) {
+      return;
+    }
+    char memory_str[15];
+    BLI_str_format_byte_unit(memory_str, (long long int)stats->memory, false);
+    BLI_snprintf(str,
+                 sizeof(str),
+                 "%.1f ms | %.2f MP | %s",
+                 stats->time * 1000.0,
+                 stats->pixels / 1e6,
+                 memory_str);
+  }
+  else {
+    if (stats->time == 0.0 && stats->elements == 0) {
+      return;
+    }
+    BLI_snprintf(str,
+                 sizeof(str),
+                 "%.2f ms | %llu elements",
+                 stats->time * 1000.0,
+                 (unsigned long long)stats->elements);
+  }
+
+  const rctf *rct = &node->totr;
+  uiDefBut(node->block,
+           UI_BTYPE_LABEL,
+           0,
+           str,
+           (int)rct->xmin,
+           (int)rct->ymax,
+           (short)BLI_rctf_size_x(rct),
+           (short)NODE_DY,
+           NULL,
+           0,
+           0,
+           0,
+           0,
+           "");
+}
+
 static void node_draw_basis(const bContext *C,
                             const View2D *v2d,
                             const SpaceNode *snode,
@@ -1360,6 +1410,8 @@ static void node_draw_basis(const bContext *C,
     }
   }
 
+  node_draw_exec_stats(snode, ntree, node);
+
   UI_block_end(C, node->block);
   UI_block_draw(C, node->block);
   node->block = NULL;
@@ -1376,6 +1428,13 @@ static void node_draw_hidden(const bContext *C,
   float centy = BLI_rctf_cent_y(rct);
   float hiddenrad = BLI_rctf_size_y(rct) / 2.0f;
 
+  /* skip if out of view */
+  if (BLI_rctf_isect(rct, &v2d->cur, NULL) == false) {
+    UI_block_end(C, node->block);
+    node->block = NULL;
+    return;
+  }
+
   float scale;
   UI_view2d_scale_get(v2d, &scale, NULL);
 
@@ -1520,6 +1579,8 @@ static void node_draw_hidden(const bContext *C,
 
   node_draw_sockets(v2d, C, ntree, node, true, false);
 
+  node_draw_exec_stats(snode, ntree, node);
+
   UI_block_end(C, node->block);
   UI_block_draw(C, node->block);
   node->block = NULL;
@@ -111,9 +111,13 @@ static void outliner_storage_cleanup(SpaceOutliner *space_outliner)
     /* each element used once, for ID blocks with more users to have each a treestore */
     BLI_mempool_iter iter;
 
+    /* Unused elements are counted in the same pass, the tree-store can be very large. */
     BLI_mempool_iternew(ts, &iter);
     while ((tselem = BLI_mempool_iterstep(&iter))) {
       tselem->used = 0;
+      if (tselem->id == NULL) {
+        unused++;
+      }
     }
 
     /* cleanup only after reading file or undo step, and always for
@@ -121,13 +125,6 @@ static void outliner_storage_cleanup(SpaceOutliner *space_outliner)
     if (space_outliner->storeflag & SO_TREESTORE_CLEANUP) {
       space_outliner->storeflag &= ~SO_TREESTORE_CLEANUP;
 
-      BLI_mempool_iternew(ts, &iter);
-      while ((tselem = BLI_mempool_iterstep(&iter))) {
-        if (tselem->id == NULL) {
-          unused++;
-        }
-      }
-
       if (unused) {
         if (BLI_mempool_len(ts) == unused) {
           BLI_mempool_destroy(ts);
@@ -25,8 +25,11 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
+#include "BLI_task.h"
 #include "BLI_timecode.h"
 
+#include "PIL_time.h"
+
 #include "DNA_scene_types.h"
 
 #include "BKE_context.h"
@@ -71,22 +74,73 @@ static void proxy_freejob(void *pjv)
   MEM_freeN(pj);
 }
 
+/* Strips are built in parallel, every build context has its own strip copy and files. */
+typedef struct ProxyBuildTask {
+  struct SeqIndexBuildContext *context;
+  short *stop;
+  short do_update;
+  float progress;
+  bool done;
+} ProxyBuildTask;
+
+static void proxy_build_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  ProxyBuildTask *task = taskdata;
+
+  SEQ_proxy_rebuild(task->context, task->stop, &task->do_update, &task->progress);
+
+  task->progress = 1.0f;
+  task->done = true;
+}
+
 /* Only this runs inside thread. */
 static void proxy_startjob(void *pjv, short *stop, short *do_update, float *progress)
 {
   ProxyJob *pj = pjv;
-  LinkData *link;
+  const int tasks_len = BLI_listbase_count(&pj->queue);
 
-  for (link = pj->queue.first; link; link = link->next) {
-    struct SeqIndexBuildContext *context = link->data;
+  if (tasks_len == 0) {
+    return;
+  }
 
-    SEQ_proxy_rebuild(context, stop, do_update, progress);
+  ProxyBuildTask *tasks = MEM_callocN(sizeof(*tasks) * tasks_len, "proxy build tasks");
+  TaskPool *task_pool = BLI_task_pool_create_background(NULL, TASK_PRIORITY_LOW);
 
-    if (*stop) {
-      pj->stop = 1;
-      fprintf(stderr, "Canceling proxy rebuild on users request...\n");
+  int i = 0;
+  LISTBASE_FOREACH (LinkData *, link, &pj->queue) {
+    tasks[i].context = link->data;
+    tasks[i].stop = stop;
+    BLI_task_pool_push(task_pool, proxy_build_task, &tasks[i], false, NULL);
+    i++;
+  }
+
+  /* Report combined progress while the tasks run. */
+  while (true) {
+    float progress_total = 0.0f;
+    bool done = true;
+
+    for (i = 0; i < tasks_len; i++) {
+      progress_total += tasks[i].progress;
+      done &= tasks[i].done;
+    }
+
+    *progress = progress_total / tasks_len;
+    *do_update = true;
+
+    if (done || *stop) {
       break;
     }
+
+    PIL_sleep_ms(100);
+  }
+
+  BLI_task_pool_work_and_wait(task_pool);
+  BLI_task_pool_free(task_pool);
+  MEM_freeN(tasks);
+
+  if (*stop) {
+    pj->stop = 1;
+    fprintf(stderr, "Canceling proxy rebuild on users request...\n");
   }
 }
 
@@ -734,6 +734,9 @@ bool checkUseAxisMatrix(TransInfo *t);
 #define TRANSFORM_SNAP_MAX_PX 100.0f
 #define TRANSFORM_DIST_INVALID -FLT_MAX
 
+/* Apply transformation to the elements of a container from multiple threads above this size. */
+#define TRANSDATA_THREAD_LIMIT 1024
+
 /* Temp macros. */
 
 #define TRANS_DATA_CONTAINER_FIRST_OK(t) (&(t)->data_container[0])
@@ -258,7 +258,8 @@ static bool bmesh_test_dist_add(BMVert *v0,
                                 float *dists,
                                 /* optionally track original index */
                                 int *index,
-                                const float mtx[3][3])
+                                /* coordinates in the space distances are measured in */
+                                const float (*cos)[3])
 {
   if ((BM_elem_flag_test(v0, BM_ELEM_SELECT) == 0) &&
       (BM_elem_flag_test(v0, BM_ELEM_HIDDEN) == 0)) {
@@ -280,20 +281,12 @@ static bool bmesh_test_dist_add(BMVert *v0,
         return false;
       }
 
-      float vm0[3], vm1[3], vm2[3];
-      mul_v3_m3v3(vm0, mtx, v0->co);
-      mul_v3_m3v3(vm1, mtx, v1->co);
-      mul_v3_m3v3(vm2, mtx, v2->co);
-
-      dist0 = geodesic_distance_propagate_across_triangle(vm0, vm1, vm2, dists[i1], dists[i2]);
+      dist0 = geodesic_distance_propagate_across_triangle(
+          cos[i0], cos[i1], cos[i2], dists[i1], dists[i2]);
     }
     else {
       /* Distance along edge. */
-      float vec[3];
-      sub_v3_v3v3(vec, v1->co, v0->co);
-      mul_m3_v3(mtx, vec);
-
-      dist0 = dists[i1] + len_v3(vec);
+      dist0 = dists[i1] + len_v3v3(cos[i1], cos[i0]);
     }
 
     if (dist0 < dists[i0]) {
@@ -326,6 +319,10 @@ void transform_convert_mesh_connectivity_distance(struct BMesh *bm,
   BLI_LINKSTACK_INIT(queue);
   BLI_LINKSTACK_INIT(queue_next);
 
+  /* Vertices are visited many times while propagating,
+   * so transform the coordinates into the measuring space once up-front. */
+  float(*cos)[3] = MEM_mallocN(sizeof(*cos) * bm->totvert, __func__);
+
   {
     /* Set indexes and initial distances for selected vertices. */
     BMIter viter;
@@ -335,6 +332,7 @@ void transform_convert_mesh_connectivity_distance(struct BMesh *bm,
     BM_ITER_MESH_INDEX (v, &viter, bm, BM_VERTS_OF_MESH, i) {
       float dist;
       BM_elem_index_set(v, i); /* set_inline */
+      mul_v3_m3v3(cos[i], mtx, v->co);
 
       if (BM_elem_flag_test(v, BM_ELEM_SELECT) == 0 || BM_elem_flag_test(v, BM_ELEM_HIDDEN)) {
         dist = FLT_MAX;
@@ -388,7 +386,7 @@ void transform_convert_mesh_connectivity_distance(struct BMesh *bm,
           SWAP(BMVert *, v1, v2);
         }
 
-        if (bmesh_test_dist_add(v2, v1, NULL, dists, index, mtx)) {
+        if (bmesh_test_dist_add(v2, v1, NULL, dists, index, cos)) {
           /* Add adjacent loose edges to the queue, or all edges if this is a loose edge.
            * Other edges are handled by propagation across edges below. */
           BMEdge *e_other;
@@ -412,7 +410,7 @@ void transform_convert_mesh_connectivity_distance(struct BMesh *bm,
             BMVert *v_other = l_other->v;
             BLI_assert(!ELEM(v_other, v1, v2));
 
-            if (bmesh_test_dist_add(v_other, v1, v2, dists, index, mtx)) {
+            if (bmesh_test_dist_add(v_other, v1, v2, dists, index, cos)) {
               /* Add adjacent edges to the queue, if they are ready to propagate across/along.
                * Always propagate along loose edges, and for other edges only propagate across
                * if both vertices have a known distances. */
@@ -447,6 +445,8 @@ void transform_convert_mesh_connectivity_distance(struct BMesh *bm,
 
   BLI_LINKSTACK_FREE(queue);
   BLI_LINKSTACK_FREE(queue_next);
+
+  MEM_freeN(cos);
 }
 
 /** \} */
@@ -29,6 +29,7 @@
 
 #include "BLI_math.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 
 #include "BKE_context.h"
 #include "BKE_report.h"
@@ -48,6 +49,118 @@
 #include "transform_mode.h"
 #include "transform_snap.h"
 
+/* -------------------------------------------------------------------- */
+/** \name Transform Element
+ * \{ */
+
+/**
+ * \note Small arrays / data-structures should be stored copied for faster memory access.
+ */
+struct TransDataArgs_Translate {
+  TransInfo *t;
+  TransDataContainer *tc;
+  const float pivot_local[3];
+  const float vec[3];
+  const bool apply_snap_align_rotation;
+};
+
+static void transdata_elem_translate(TransInfo *t,
+                                     TransDataContainer *tc,
+                                     TransData *td,
+                                     const float pivot_local[3],
+                                     const float vec[3],
+                                     const bool apply_snap_align_rotation)
+{
+  float rotate_offset[3] = {0};
+  bool use_rotate_offset = false;
+
+  /* Handle snapping rotation before doing the translation. */
+  if (apply_snap_align_rotation) {
+    float mat[3][3];
+
+    if (validSnappingNormal(t)) {
+      const float *original_normal;
+
+      /* In pose mode, we want to align normals with Y axis of bones. */
+      if (t->flag & T_POSE) {
+        original_normal = td->axismtx[1];
+      }
+      else {
+        original_normal = td->axismtx[2];
+      }
+
+      rotation_between_vecs_to_mat3(mat, original_normal, t->tsnap.snapNormal);
+    }
+    else {
+      unit_m3(mat);
+    }
+
+    ElementRotation_ex(t, tc, td, mat, pivot_local);
+
+    if (td->loc) {
+      use_rotate_offset = true;
+      sub_v3_v3v3(rotate_offset, td->loc, td->iloc);
+    }
+  }
+
+  float tvec[3];
+
+  if (t->con.applyVec) {
+    t->con.applyVec(t, tc, td, vec, tvec);
+  }
+  else {
+    copy_v3_v3(tvec, vec);
+  }
+
+  mul_m3_v3(td->smtx, tvec);
+
+  if (use_rotate_offset) {
+    add_v3_v3(tvec, rotate_offset);
+  }
+
+  if (t->options & CTX_GPENCIL_STROKES) {
+    /* Grease pencil multi-frame falloff. */
+    bGPDstroke *gps = (bGPDstroke *)td->extra;
+    if (gps != NULL) {
+      mul_v3_fl(tvec, td->factor * gps->runtime.multi_frame_falloff);
+    }
+    else {
+      mul_v3_fl(tvec, td->factor);
+    }
+  }
+  else {
+    /* Proportional editing falloff. */
+    mul_v3_fl(tvec, td->factor);
+  }
+
+  protectedTransBits(td->protectflag, tvec);
+
+  if (td->loc) {
+    add_v3_v3v3(td->loc, td->iloc, tvec);
+  }
+
+  constraintTransLim(t, td);
+}
+
+static void transdata_elem_translate_fn(void *__restrict iter_data_v,
+                                        const int iter,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  struct TransDataArgs_Translate *data = iter_data_v;
+  TransData *td = &data->tc->data[iter];
+  if (td->flag & TD_SKIP) {
+    return;
+  }
+  transdata_elem_translate(data->t,
+                           data->tc,
+                           td,
+                           data->pivot_local,
+                           data->vec,
+                           data->apply_snap_align_rotation);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Transform (Translation)
  * \{ */
@@ -261,95 +374,42 @@ static void applyTranslationValue(TransInfo *t, const float vec[3])
 {
   const bool apply_snap_align_rotation = usingSnappingNormal(
       t);  // && (t->tsnap.status & POINT_INIT);
-  float tvec[3];
 
   /* The ideal would be "apply_snap_align_rotation" only when a snap point is found
    * so, maybe inside this function is not the best place to apply this rotation.
    * but you need "handle snapping rotation before doing the translation" (really?) */
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
 
-    float pivot[3];
+    float pivot_local[3] = {0.0f};
     if (apply_snap_align_rotation) {
-      copy_v3_v3(pivot, t->tsnap.snapTarget);
+      copy_v3_v3(pivot_local, t->tsnap.snapTarget);
       /* The pivot has to be in local-space (see T49494) */
       if (tc->use_local_mat) {
-        mul_m4_v3(tc->imat, pivot);
+        mul_m4_v3(tc->imat, pivot_local);
       }
     }
 
-    TransData *td = tc->data;
-    for (int i = 0; i < tc->data_len; i++, td++) {
-      if (td->flag & TD_SKIP) {
-        continue;
-      }
-
-      float rotate_offset[3] = {0};
-      bool use_rotate_offset = false;
-
-      /* handle snapping rotation before doing the translation */
-      if (apply_snap_align_rotation) {
-        float mat[3][3];
-
-        if (validSnappingNormal(t)) {
-          const float *original_normal;
-
-          /* In pose mode, we want to align normals with Y axis of bones... */
-          if (t->flag & T_POSE) {
-            original_normal = td->axismtx[1];
-          }
-          else {
-            original_normal = td->axismtx[2];
-          }
-
-          rotation_between_vecs_to_mat3(mat, original_normal, t->tsnap.snapNormal);
-        }
-        else {
-          unit_m3(mat);
-        }
-
-        ElementRotation_ex(t, tc, td, mat, pivot);
-
-        if (td->loc) {
-          use_rotate_offset = true;
-          sub_v3_v3v3(rotate_offset, td->loc, td->iloc);
+    /* Object and bone limit constraints are not safe to evaluate from multiple threads. */
+    if (tc->data_len < TRANSDATA_THREAD_LIMIT || (t->flag & (T_OBJECT | T_POSE))) {
+      TransData *td = tc->data;
+      for (int i = 0; i < tc->data_len; i++, td++) {
+        if (td->flag & TD_SKIP) {
+          continue;
         }
+        transdata_elem_translate(t, tc, td, pivot_local, vec, apply_snap_align_rotation);
       }
-
-      if (t->con.applyVec) {
-        t->con.applyVec(t, tc, td, vec, tvec);
-      }
-      else {
-        copy_v3_v3(tvec, vec);
-      }
-
-      mul_m3_v3(td->smtx, tvec);
-
-      if (use_rotate_offset) {
-        add_v3_v3(tvec, rotate_offset);
-      }
-
-      if (t->options & CTX_GPENCIL_STROKES) {
-        /* grease pencil multiframe falloff */
-        bGPDstroke *gps = (bGPDstroke *)td->extra;
-        if (gps != NULL) {
-          mul_v3_fl(tvec, td->factor * gps->runtime.multi_frame_falloff);
-        }
-        else {
-          mul_v3_fl(tvec, td->factor);
-        }
-      }
-      else {
-        /* proportional editing falloff */
-        mul_v3_fl(tvec, td->factor);
-      }
-
-      protectedTransBits(td->protectflag, tvec);
-
-      if (td->loc) {
-        add_v3_v3v3(td->loc, td->iloc, tvec);
-      }
-
-      constraintTransLim(t, td);
+    }
+    else {
+      struct TransDataArgs_Translate data = {
+          .t = t,
+          .tc = tc,
+          .pivot_local = {UNPACK3(pivot_local)},
+          .vec = {UNPACK3(vec)},
+          .apply_snap_align_rotation = apply_snap_align_rotation,
+      };
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      BLI_task_parallel_range(0, tc->data_len, &data, transdata_elem_translate_fn, &settings);
     }
   }
 }
@@ -28,89 +28,111 @@
 
 #include "BKE_global.h"
 
+#include "BLI_task.h"
+
 namespace Freestyle {
 
+struct ProcessShapesData {
+  const FEdgeXDetector *detector;
+  const vector<WShape *> *wshapes;
+  bool changes;
+};
+
+static void process_shape_fn(void *__restrict userdata,
+                             const int index,
+                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ProcessShapesData *data = (const ProcessShapesData *)userdata;
+  WShape *wshape = (*data->wshapes)[index];
+
+  /* The detector stores per shape statistics such as the mean curvature, so every shape uses its
+   * own copy of it. */
+  FEdgeXDetector detector = *data->detector;
+  if (detector.testBreak()) {
+    return;
+  }
+  detector.processShape(dynamic_cast<WXShape *>(wshape), data->changes && index == 0);
+
+  // reset user data
+  wshape->ResetUserData();
+}
+
 void FEdgeXDetector::processShapes(WingedEdge &we)
 {
-  bool progressBarDisplay = false;
-#if 0
-  Vec3r Min, Max;
-#endif
   vector<WShape *> wshapes = we.getWShapes();
-  WXShape *wxs;
 
   if (_pProgressBar != nullptr) {
     _pProgressBar->reset();
     _pProgressBar->setLabelText("Detecting feature lines");
-    _pProgressBar->setTotalSteps(wshapes.size() * 3);
+    _pProgressBar->setTotalSteps(1);
     _pProgressBar->setProgress(0);
-    progressBarDisplay = true;
   }
 
-  for (vector<WShape *>::const_iterator it = wshapes.begin(); it != wshapes.end(); it++) {
-    if (_pRenderMonitor && _pRenderMonitor->testBreak()) {
-      break;
-    }
-    wxs = dynamic_cast<WXShape *>(*it);
-#if 0
-    wxs->bbox(Min, Max);
-    _bbox_diagonal = (Max - Min).norm();
-#endif
-    if (_changes) {
-      vector<WFace *> &wfaces = wxs->GetFaceList();
-      for (vector<WFace *>::iterator wf = wfaces.begin(), wfend = wfaces.end(); wf != wfend;
-           ++wf) {
-        WXFace *wxf = dynamic_cast<WXFace *>(*wf);
-        wxf->Clear();
-      }
-      _computeViewIndependent = true;
-    }
-    else if (!(wxs)->getComputeViewIndependentFlag()) {
-      wxs->Reset();
-      _computeViewIndependent = false;
-    }
-    else {
-      _computeViewIndependent = true;
-    }
-    preProcessShape(wxs);
-    if (progressBarDisplay) {
-      _pProgressBar->setProgress(_pProgressBar->getProgress() + 1);
-    }
-    processBorderShape(wxs);
-    if (_computeMaterialBoundaries) {
-      processMaterialBoundaryShape(wxs);
-    }
-    processCreaseShape(wxs);
-    if (_computeRidgesAndValleys) {
-      processRidgesAndValleysShape(wxs);
-    }
-    if (_computeSuggestiveContours) {
-      processSuggestiveContourShape(wxs);
-    }
-    processSilhouetteShape(wxs);
-    processEdgeMarksShape(wxs);
-    if (progressBarDisplay) {
-      _pProgressBar->setProgress(_pProgressBar->getProgress() + 1);
-    }
+  /* Shapes do not share any edges or faces, so they can be processed in parallel. */
+  ProcessShapesData data;
+  data.detector = this;
+  data.wshapes = &wshapes;
+  data.changes = _changes;
 
-    // build smooth edges:
-    buildSmoothEdges(wxs);
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, (int)wshapes.size(), &data, process_shape_fn, &settings);
 
-    // Post processing for suggestive contours
-    if (_computeSuggestiveContours) {
-      postProcessSuggestiveContourShape(wxs);
-    }
-    if (progressBarDisplay) {
-      _pProgressBar->setProgress(_pProgressBar->getProgress() + 1);
-    }
+  if (_pProgressBar != nullptr) {
+    _pProgressBar->setProgress(1);
+  }
 
-    wxs->setComputeViewIndependentFlag(false);
+  _computeViewIndependent = false;
+  _changes = false;
+}
+
+void FEdgeXDetector::processShape(WXShape *wxs, bool changes)
+{
+#if 0
+  Vec3r Min, Max;
+  wxs->bbox(Min, Max);
+  _bbox_diagonal = (Max - Min).norm();
+#endif
+  if (changes) {
+    vector<WFace *> &wfaces = wxs->GetFaceList();
+    for (vector<WFace *>::iterator wf = wfaces.begin(), wfend = wfaces.end(); wf != wfend; ++wf) {
+      WXFace *wxf = dynamic_cast<WXFace *>(*wf);
+      wxf->Clear();
+    }
+    _computeViewIndependent = true;
+  }
+  else if (!(wxs)->getComputeViewIndependentFlag()) {
+    wxs->Reset();
     _computeViewIndependent = false;
-    _changes = false;
+  }
+  else {
+    _computeViewIndependent = true;
+  }
+  preProcessShape(wxs);
+  processBorderShape(wxs);
+  if (_computeMaterialBoundaries) {
+    processMaterialBoundaryShape(wxs);
+  }
+  processCreaseShape(wxs);
+  if (_computeRidgesAndValleys) {
+    processRidgesAndValleysShape(wxs);
+  }
+  if (_computeSuggestiveContours) {
+    processSuggestiveContourShape(wxs);
+  }
+  processSilhouetteShape(wxs);
+  processEdgeMarksShape(wxs);
 
-    // reset user data
-    (*it)->ResetUserData();
+  // build smooth edges:
+  buildSmoothEdges(wxs);
+
+  // Post processing for suggestive contours
+  if (_computeSuggestiveContours) {
+    postProcessSuggestiveContourShape(wxs);
   }
+
+  wxs->setComputeViewIndependentFlag(false);
 }
 
 // GENERAL STUFF
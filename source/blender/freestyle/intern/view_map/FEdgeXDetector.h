@@ -72,6 +72,15 @@ class FEdgeXDetector {
   /*! Process shapes from a WingedEdge containing a list of WShapes */
   virtual void processShapes(WingedEdge &);
 
+  /*! Process a single shape, \a changes is true when the detection settings changed since the
+   * shape was last processed. */
+  virtual void processShape(WXShape *wxs, bool changes);
+
+  inline bool testBreak() const
+  {
+    return _pRenderMonitor && _pRenderMonitor->testBreak();
+  }
+
   // GENERAL STUFF
   virtual void preProcessShape(WXShape *iWShape);
   virtual void preProcessFace(WXFace *iFace);
@@ -28,6 +28,37 @@
 
 namespace blender::fn {
 
+namespace detail {
+
+/* Accessor for a virtual span that has the same value for every index. */
+template<typename T> struct SingleValueAccessor {
+  const T &value;
+
+  const T &operator[](const int64_t UNUSED(index)) const
+  {
+    return value;
+  }
+};
+
+/**
+ * Call the function with an accessor for the values of the virtual span, that does not have to
+ * check the category of the span for every element like #VSpan does. This allows the compiler to
+ * vectorize loops over the values. The function is instantiated separately for a single value
+ * and an array. Nothing is called when the span references separate pointers.
+ */
+template<typename T, typename Func>
+inline void devirtualize_vspan(const VSpan<T> &span, const Func &func)
+{
+  if (span.is_single_element()) {
+    func(SingleValueAccessor<T>{span.as_single_element()});
+  }
+  else if (span.is_full_array()) {
+    func(span.as_full_array().data());
+  }
+}
+
+}  // namespace detail
+
 /**
  * Generates a multi-function with the following parameters:
  * 1. single input (SI) of type In1
@@ -58,6 +89,21 @@ template<typename In1, typename Out1> class CustomMF_SI_SO : public MultiFunctio
   template<typename ElementFuncT> static FunctionT create_function(ElementFuncT element_fn)
   {
     return [=](IndexMask mask, VSpan<In1> in1, MutableSpan<Out1> out1) {
+      if (mask.is_range()) {
+        /* Use a separate loop for dense masks, that the compiler can vectorize. */
+        const IndexRange range = mask.as_range();
+        Out1 *out1_data = out1.data();
+        bool is_devirtualized = false;
+        detail::devirtualize_vspan(in1, [&](const auto &in1_data) {
+          for (int64_t i = range.start(); i < range.one_after_last(); i++) {
+            new (static_cast<void *>(out1_data + i)) Out1(element_fn(in1_data[i]));
+          }
+          is_devirtualized = true;
+        });
+        if (is_devirtualized) {
+          return;
+        }
+      }
       mask.foreach_index(
           [&](int i) { new (static_cast<void *>(&out1[i])) Out1(element_fn(in1[i])); });
     };
@@ -101,6 +147,23 @@ class CustomMF_SI_SI_SO : public MultiFunction {
   template<typename ElementFuncT> static FunctionT create_function(ElementFuncT element_fn)
   {
     return [=](IndexMask mask, VSpan<In1> in1, VSpan<In2> in2, MutableSpan<Out1> out1) {
+      if (mask.is_range()) {
+        /* Use a separate loop for dense masks, that the compiler can vectorize. */
+        const IndexRange range = mask.as_range();
+        Out1 *out1_data = out1.data();
+        bool is_devirtualized = false;
+        detail::devirtualize_vspan(in1, [&](const auto &in1_data) {
+          detail::devirtualize_vspan(in2, [&](const auto &in2_data) {
+            for (int64_t i = range.start(); i < range.one_after_last(); i++) {
+              new (static_cast<void *>(out1_data + i)) Out1(element_fn(in1_data[i], in2_data[i]));
+            }
+            is_devirtualized = true;
+          });
+        });
+        if (is_devirtualized) {
+          return;
+        }
+      }
       mask.foreach_index(
           [&](int i) { new (static_cast<void *>(&out1[i])) Out1(element_fn(in1[i], in2[i])); });
     };
@@ -152,6 +215,26 @@ class CustomMF_SI_SI_SI_SO : public MultiFunction {
                VSpan<In2> in2,
                VSpan<In3> in3,
                MutableSpan<Out1> out1) {
+      if (mask.is_range()) {
+        /* Use a separate loop for dense masks, that the compiler can vectorize. */
+        const IndexRange range = mask.as_range();
+        Out1 *out1_data = out1.data();
+        bool is_devirtualized = false;
+        detail::devirtualize_vspan(in1, [&](const auto &in1_data) {
+          detail::devirtualize_vspan(in2, [&](const auto &in2_data) {
+            detail::devirtualize_vspan(in3, [&](const auto &in3_data) {
+              for (int64_t i = range.start(); i < range.one_after_last(); i++) {
+                new (static_cast<void *>(out1_data + i))
+                    Out1(element_fn(in1_data[i], in2_data[i], in3_data[i]));
+              }
+              is_devirtualized = true;
+            });
+          });
+        });
+        if (is_devirtualized) {
+          return;
+        }
+      }
       mask.foreach_index([&](int i) {
         new (static_cast<void *>(&out1[i])) Out1(element_fn(in1[i], in2[i], in3[i]));
       });
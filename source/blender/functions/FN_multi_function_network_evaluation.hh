@@ -30,6 +30,8 @@ class MFNetworkEvaluator : public MultiFunction {
  private:
   Vector<const MFOutputSocket *> inputs_;
   Vector<const MFInputSocket *> outputs_;
+  /* True when all parameters are single values, so the mask can be split into chunks. */
+  bool can_evaluate_in_chunks_ = true;
 
  public:
   MFNetworkEvaluator(Vector<const MFOutputSocket *> inputs, Vector<const MFInputSocket *> outputs);
@@ -39,6 +41,9 @@ class MFNetworkEvaluator : public MultiFunction {
  private:
   using Storage = MFNetworkEvaluationStorage;
 
+  void call_in_chunks(IndexRange range, MFParams params, MFContext context) const;
+  void evaluate(IndexMask mask, MFParams params, MFContext context) const;
+
   void copy_inputs_to_storage(MFParams params, Storage &storage) const;
   void copy_outputs_to_storage(
       MFParams params,
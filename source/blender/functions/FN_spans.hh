@@ -173,6 +173,14 @@ class GMutableSpan {
     return POINTER_OFFSET(data_, type_->size() * index);
   }
 
+  GMutableSpan slice(const int64_t start, const int64_t size) const
+  {
+    BLI_assert(start >= 0);
+    BLI_assert(size >= 0);
+    BLI_assert(start + size <= size_);
+    return GMutableSpan(*type_, POINTER_OFFSET(data_, type_->size() * start), size);
+  }
+
   template<typename T> MutableSpan<T> typed()
   {
     BLI_assert(type_->is<T>());
@@ -400,6 +408,25 @@ class GVSpan : public VSpanBase<void> {
     return ref;
   }
 
+  GVSpan slice(const int64_t start, const int64_t size) const
+  {
+    BLI_assert(start >= 0);
+    BLI_assert(size >= 0);
+    BLI_assert(start + size <= this->virtual_size_);
+    switch (this->category_) {
+      case VSpanCategory::Single:
+        return GVSpan::FromSingle(*type_, this->data_.single.data, size);
+      case VSpanCategory::FullArray:
+        return GSpan(
+            *type_, POINTER_OFFSET(this->data_.full_array.data, type_->size() * start), size);
+      case VSpanCategory::FullPointerArray:
+        return GVSpan::FromFullPointerArray(
+            *type_, this->data_.full_pointer_array.data + start, size);
+    }
+    BLI_assert(false);
+    return GVSpan(*type_);
+  }
+
   const CPPType &type() const
   {
     return *this->type_;
@@ -28,6 +28,8 @@
  * - Avoids data copies in many cases.
  * - Every node is executed at most once.
  * - Can compute sub-functions on a single element, when the result is the same for all elements.
+ * - Large ranges are split into chunks that are evaluated in parallel. Temporary buffers of a
+ *   chunk are small enough to stay in the CPU cache.
  *
  * Possible improvements:
  * - Cache and reuse buffers.
@@ -38,6 +40,7 @@
 #include "FN_multi_function_network_evaluation.hh"
 
 #include "BLI_stack.hh"
+#include "BLI_task.hh"
 
 namespace blender::fn {
 
@@ -116,6 +119,7 @@ MFNetworkEvaluator::MFNetworkEvaluator(Vector<const MFOutputSocket *> inputs,
         break;
       case MFDataType::Vector:
         signature.vector_input(socket->name(), type.vector_base_type());
+        can_evaluate_in_chunks_ = false;
         break;
     }
   }
@@ -130,17 +134,78 @@ MFNetworkEvaluator::MFNetworkEvaluator(Vector<const MFOutputSocket *> inputs,
         break;
       case MFDataType::Vector:
         signature.vector_output(socket->name(), type.vector_base_type());
+        can_evaluate_in_chunks_ = false;
         break;
     }
   }
 }
 
+/* Number of elements that are evaluated at once by one thread. */
+static constexpr int64_t evaluation_chunk_size = 4096;
+
 void MFNetworkEvaluator::call(IndexMask mask, MFParams params, MFContext context) const
 {
   if (mask.size() == 0) {
     return;
   }
 
+  if (can_evaluate_in_chunks_ && mask.size() > evaluation_chunk_size && mask.is_range()) {
+    this->call_in_chunks(mask.as_range(), params, context);
+    return;
+  }
+  this->evaluate(mask, params, context);
+}
+
+/**
+ * Evaluate the network for parts of the range in parallel. Every chunk gets its own parameters
+ * that reference a slice of the original buffers, so that the buffers allocated by the storage
+ * for a chunk only have to be as large as the chunk.
+ */
+BLI_NOINLINE void MFNetworkEvaluator::call_in_chunks(IndexRange range,
+                                                     MFParams params,
+                                                     MFContext context) const
+{
+  const int64_t chunks_amount = (range.size() + evaluation_chunk_size - 1) /
+                                evaluation_chunk_size;
+  parallel_for(IndexRange(chunks_amount), 1, [&](IndexRange chunk_indices) {
+    for (const int64_t chunk_index : chunk_indices) {
+      const int64_t start = range.start() + chunk_index * evaluation_chunk_size;
+      const int64_t size = std::min(evaluation_chunk_size, range.one_after_last() - start);
+
+      MFParamsBuilder chunk_params{*this, size};
+      for (const int param_index : this->param_indices()) {
+        const MFParamType param_type = this->param_type(param_index);
+        switch (param_type.category()) {
+          case MFParamType::SingleInput: {
+            GVSpan values = params.readonly_single_input(param_index);
+            chunk_params.add_readonly_single_input(values.slice(start, size));
+            break;
+          }
+          case MFParamType::SingleOutput: {
+            GMutableSpan values = params.uninitialized_single_output(param_index);
+            chunk_params.add_uninitialized_single_output(values.slice(start, size));
+            break;
+          }
+          case MFParamType::VectorInput:
+          case MFParamType::VectorOutput:
+          case MFParamType::SingleMutable:
+          case MFParamType::VectorMutable: {
+            /* The network only has single inputs and outputs. */
+            BLI_assert(false);
+            break;
+          }
+        }
+      }
+
+      this->evaluate(IndexRange(size), chunk_params, context);
+    }
+  });
+}
+
+BLI_NOINLINE void MFNetworkEvaluator::evaluate(IndexMask mask,
+                                               MFParams params,
+                                               MFContext context) const
+{
   const MFNetwork &network = outputs_[0]->node().network();
   Storage storage(mask, network.socket_id_amount());
 
@@ -63,6 +63,28 @@ TEST(multi_function_network, Test1)
     EXPECT_EQ(results[3], 0);
     EXPECT_EQ(results[4], 13 * 13);
   }
+  {
+    /* Large enough to be evaluated in multiple chunks. */
+    Array<int> values(10000);
+    for (const int i : values.index_range()) {
+      values[i] = i;
+    }
+    Array<int> results(values.size(), 0);
+
+    MFParamsBuilder params(network_fn, values.size());
+    params.add_readonly_single_input(values.as_span());
+    params.add_uninitialized_single_output(results.as_mutable_span());
+
+    MFContextBuilder context;
+
+    network_fn.call(IndexRange(5, 9990), params, context);
+
+    EXPECT_EQ(results[4], 0);
+    EXPECT_EQ(results[5], 15 * 15);
+    EXPECT_EQ(results[4100], 4110 * 4110);
+    EXPECT_EQ(results[9994], 10004 * 10004);
+    EXPECT_EQ(results[9995], 0);
+  }
 }
 
 class ConcatVectorsFunction : public MultiFunction {
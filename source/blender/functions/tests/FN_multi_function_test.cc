@@ -249,6 +249,30 @@ TEST(multi_function, CustomMF_SI_SI_SO)
   EXPECT_EQ(outputs[3], 90);
 }
 
+TEST(multi_function, CustomMF_SI_SI_SO_Range)
+{
+  CustomMF_SI_SI_SO<float, float, float> fn("add", [](float a, float b) { return a + b; });
+
+  Array<float> values_a = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+  float value_b = 0.5f;
+  Array<float> outputs(values_a.size(), -1.0f);
+
+  MFParamsBuilder params(fn, values_a.size());
+  params.add_readonly_single_input(values_a.as_span());
+  params.add_readonly_single_input(&value_b);
+  params.add_uninitialized_single_output(outputs.as_mutable_span());
+
+  MFContextBuilder context;
+
+  fn.call(IndexRange(1, 3), params, context);
+
+  EXPECT_EQ(outputs[0], -1.0f);
+  EXPECT_EQ(outputs[1], 2.5f);
+  EXPECT_EQ(outputs[2], 3.5f);
+  EXPECT_EQ(outputs[3], 4.5f);
+  EXPECT_EQ(outputs[4], -1.0f);
+}
+
 TEST(multi_function, CustomMF_SI_SI_SI_SO)
 {
   CustomMF_SI_SI_SI_SO<int, std::string, bool, uint> fn{
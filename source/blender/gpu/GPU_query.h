@@ -0,0 +1,53 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup gpu
+ *
+ * GPUQueryPool is an API to record GPU timestamps without stalling the CPU.
+ * Results are typically read back one frame later.
+ */
+
+#pragma once
+
+#include "BLI_sys_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Opaque type hiding blender::gpu::QueryPool. */
+typedef struct GPUQueryPool GPUQueryPool;
+
+GPUQueryPool *GPU_timestamp_pool_create(void);
+void GPU_query_pool_free(GPUQueryPool *pool);
+/* Forget all issued queries. Query objects are kept and reused by the next queries. */
+void GPU_query_pool_reset(GPUQueryPool *pool);
+
+/* Record the GPU time at which all previous commands are finished. Return the query index. */
+int GPU_timestamp_record(GPUQueryPool *pool);
+/**
+ * Fill r_timestamps (in nanoseconds) with the result of the `len` first queries issued since
+ * the last reset. Return false without waiting if the results are not available yet.
+ */
+bool GPU_timestamp_results_get(GPUQueryPool *pool, uint64_t *r_timestamps, int len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -21,8 +21,36 @@
  * \ingroup gpu
  */
 
+#include "GPU_query.h"
+
+#include "gpu_backend.hh"
 #include "gpu_query.hh"
 
 using namespace blender::gpu;
 
-/* TODO(fclem): Make the associated C-API to use inside DRW profiler. */
+GPUQueryPool *GPU_timestamp_pool_create(void)
+{
+  QueryPool *pool = GPUBackend::get()->querypool_alloc();
+  pool->init(GPU_QUERY_TIMESTAMP);
+  return wrap(pool);
+}
+
+void GPU_query_pool_free(GPUQueryPool *pool)
+{
+  delete unwrap(pool);
+}
+
+void GPU_query_pool_reset(GPUQueryPool *pool)
+{
+  unwrap(pool)->reset();
+}
+
+int GPU_timestamp_record(GPUQueryPool *pool)
+{
+  return unwrap(pool)->timestamp();
+}
+
+bool GPU_timestamp_results_get(GPUQueryPool *pool, uint64_t *r_timestamps, int len)
+{
+  return unwrap(pool)->get_timestamp_result(blender::MutableSpan<uint64_t>(r_timestamps, len));
+}
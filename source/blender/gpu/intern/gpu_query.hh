@@ -25,10 +25,13 @@
 
 #include "BLI_span.hh"
 
+struct GPUQueryPool;
+
 namespace blender::gpu {
 
 typedef enum GPUQueryType {
   GPU_QUERY_OCCLUSION = 0,
+  GPU_QUERY_TIMESTAMP = 1,
 } GPUQueryType;
 
 class QueryPool {
@@ -48,12 +51,40 @@ class QueryPool {
   virtual void begin_query(void) = 0;
   virtual void end_query(void) = 0;
 
+  /**
+   * Forget all issued queries, so the pool can be filled again.
+   * The query objects are kept and reused.
+   */
+  virtual void reset(void) = 0;
+
+  /**
+   * Record the time at which all previous commands are finished on the GPU.
+   * Return the index of the query in the pool. Only for #GPU_QUERY_TIMESTAMP pools.
+   */
+  virtual int timestamp(void) = 0;
+
   /**
    * Must be fed with a buffer large enough to contain all the queries issued.
    * IMPORTANT: Result for each query can be either binary or represent the number of samples
    * drawn.
    */
   virtual void get_occlusion_result(MutableSpan<uint32_t> r_values) = 0;
+
+  /**
+   * Get the first `r_values.size()` timestamps in nanoseconds. Does not wait for the GPU:
+   * return false if the results are not all available yet.
+   */
+  virtual bool get_timestamp_result(MutableSpan<uint64_t> r_values) = 0;
 };
 
+/* Syntacting suggar. */
+static inline GPUQueryPool *wrap(QueryPool *pool)
+{
+  return reinterpret_cast<GPUQueryPool *>(pool);
+}
+static inline QueryPool *unwrap(GPUQueryPool *pool)
+{
+  return reinterpret_cast<QueryPool *>(pool);
+}
+
 }  // namespace blender::gpu
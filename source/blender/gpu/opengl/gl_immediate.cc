@@ -57,6 +57,17 @@ GLImmediate::GLImmediate()
   glBindBuffer(GL_ARRAY_BUFFER, buffer_strict.vbo_id);
   glBufferData(GL_ARRAY_BUFFER, buffer_strict.buffer_size, nullptr, GL_DYNAMIC_DRAW);
 
+  if (GLContext::buffer_storage_support) {
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT;
+    ring_.buffer_size = DEFAULT_INTERNAL_BUFFER_SIZE;
+    glGenBuffers(1, &ring_.vbo_id);
+    glBindBuffer(GL_ARRAY_BUFFER, ring_.vbo_id);
+    glBufferStorage(GL_ARRAY_BUFFER, ring_.buffer_size, nullptr, flags);
+    ring_.data = (uchar *)glMapBufferRange(
+        GL_ARRAY_BUFFER, 0, ring_.buffer_size, flags | GL_MAP_FLUSH_EXPLICIT_BIT);
+    debug::object_label(GL_BUFFER, ring_.vbo_id, "ImmediateVboRing");
+  }
+
   glBindBuffer(GL_ARRAY_BUFFER, 0);
   glBindVertexArray(0);
 
@@ -71,6 +82,17 @@ GLImmediate::~GLImmediate()
 
   glDeleteBuffers(1, &buffer.vbo_id);
   glDeleteBuffers(1, &buffer_strict.vbo_id);
+
+  if (ring_.vbo_id != 0) {
+    for (GLsync fence : ring_.fences) {
+      if (fence) {
+        glDeleteSync(fence);
+      }
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, ring_.vbo_id);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    glDeleteBuffers(1, &ring_.vbo_id);
+  }
 }
 
 /** \} */
@@ -79,10 +101,48 @@ GLImmediate::~GLImmediate()
 /** \name Buffer management
  * \{ */
 
+/* Return a pointer to the next free range of the ring buffer, in the persistent mapping. */
+uchar *GLImmediate::ring_begin(size_t bytes_needed)
+{
+  const size_t segment_size = ring_.buffer_size / RING_SEGMENT_LEN;
+  size_t segment_end = (ring_.segment + 1) * segment_size;
+  size_t offset = ring_.buffer_offset + padding(ring_.buffer_offset, vertex_format.stride);
+
+  if (offset + bytes_needed > segment_end) {
+    /* Leave the current segment, the GPU can read it until the fence is signaled. */
+    ring_.fences[ring_.segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    ring_.segment = (ring_.segment + 1) % RING_SEGMENT_LEN;
+
+    GLsync &fence = ring_.fences[ring_.segment];
+    if (fence) {
+      /* Only blocks if the GPU is more than #RING_SEGMENT_LEN - 1 segments behind. */
+      while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) {
+      }
+      glDeleteSync(fence);
+      fence = nullptr;
+    }
+    const size_t segment_start = ring_.segment * segment_size;
+    offset = segment_start + padding(segment_start, vertex_format.stride);
+  }
+
+  ring_.buffer_offset = offset;
+  return ring_.data + offset;
+}
+
 uchar *GLImmediate::begin()
 {
   /* How many bytes do we need for this draw call? */
   const size_t bytes_needed = vertex_buffer_size(&vertex_format, vertex_len);
+
+  /* Small draws (the vast majority of UI drawing) go to the ring buffer: no mapping, no
+   * orphaning, only a memcpy into memory the driver already knows. Leave room for the padding
+   * needed to align the first vertex. */
+  use_ring_ = (ring_.data != nullptr) &&
+              (bytes_needed + vertex_format.stride <= ring_.buffer_size / RING_SEGMENT_LEN);
+  if (use_ring_) {
+    bytes_mapped_ = bytes_needed;
+    return this->ring_begin(bytes_needed);
+  }
   /* Does the current buffer have enough room? */
   const size_t available_bytes = buffer_size() - buffer_offset();
 
@@ -146,10 +206,20 @@ void GLImmediate::end()
       buffer_bytes_used = vertex_buffer_size(&vertex_format, vertex_len);
       /* unused buffer bytes are available to the next immBegin */
     }
-    /* tell OpenGL what range was modified so it doesn't copy the whole mapped range */
-    glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, buffer_bytes_used);
   }
-  glUnmapBuffer(GL_ARRAY_BUFFER);
+
+  if (use_ring_) {
+    glBindBuffer(GL_ARRAY_BUFFER, ring_.vbo_id);
+    /* The whole buffer is mapped, so the range is relative to the buffer start. */
+    glFlushMappedBufferRange(GL_ARRAY_BUFFER, ring_.buffer_offset, buffer_bytes_used);
+  }
+  else {
+    if (!strict_vertex_len) {
+      /* tell OpenGL what range was modified so it doesn't copy the whole mapped range */
+      glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, buffer_bytes_used);
+    }
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+  }
 
   if (vertex_len > 0) {
     GLContext::get()->state_manager->apply_state();
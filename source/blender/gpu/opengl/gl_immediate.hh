@@ -35,6 +35,8 @@ namespace blender::gpu {
 
 /* size of internal buffer */
 #define DEFAULT_INTERNAL_BUFFER_SIZE (4 * 1024 * 1024)
+/* Number of segments of the persistently mapped ring buffer. */
+#define RING_SEGMENT_LEN 3
 
 class GLImmediate : public Immediate {
  private:
@@ -49,6 +51,24 @@ class GLImmediate : public Immediate {
     /** Size of the whole buffer in bytes. */
     size_t buffer_size = 0;
   } buffer, buffer_strict;
+  /**
+   * Persistently mapped ring buffer, used instead of the buffers above when
+   * GL_ARB_buffer_storage is supported and the vertices fit into one segment.
+   * The buffer is split into #RING_SEGMENT_LEN segments. A fence is inserted when the writes
+   * leave a segment, and waited on before the segment is written again, so the GPU is never
+   * reading data that is being overwritten.
+   */
+  struct {
+    GLuint vbo_id = 0;
+    /** Whole buffer, mapped once at creation. */
+    uchar *data = nullptr;
+    size_t buffer_offset = 0;
+    size_t buffer_size = 0;
+    int segment = 0;
+    GLsync fences[RING_SEGMENT_LEN] = {nullptr};
+  } ring_;
+  /** True if the current immBegin/immEnd pair writes into the ring buffer. */
+  bool use_ring_ = false;
   /** Size in bytes of the mapped region. */
   size_t bytes_mapped_ = 0;
   /** Vertex array for this immediate mode instance. */
@@ -62,13 +82,21 @@ class GLImmediate : public Immediate {
   void end(void) override;
 
  private:
+  uchar *ring_begin(size_t bytes_needed);
+
   GLuint &vbo_id(void)
   {
+    if (use_ring_) {
+      return ring_.vbo_id;
+    }
     return strict_vertex_len ? buffer_strict.vbo_id : buffer.vbo_id;
   };
 
   size_t &buffer_offset(void)
   {
+    if (use_ring_) {
+      return ring_.buffer_offset;
+    }
     return strict_vertex_len ? buffer_strict.buffer_offset : buffer.buffer_offset;
   };
 
@@ -41,22 +41,27 @@ void GLQueryPool::init(GPUQueryType type)
   query_issued_ = 0;
 }
 
-#if 0 /* TODO to avoid realloc of permanent query pool. */
-void GLQueryPool::reset(GPUQueryType type)
+void GLQueryPool::reset()
 {
-  initialized_ = false;
+  BLI_assert(initialized_);
+  query_issued_ = 0;
 }
-#endif
 
-void GLQueryPool::begin_query()
+GLuint GLQueryPool::query_next()
 {
-  /* TODO add assert about expected usage. */
   while (query_issued_ >= query_ids_.size()) {
     int64_t prev_size = query_ids_.size();
     query_ids_.resize(prev_size + QUERY_CHUNCK_LEN);
     glGenQueries(QUERY_CHUNCK_LEN, &query_ids_[prev_size]);
   }
-  glBeginQuery(gl_type_, query_ids_[query_issued_++]);
+  return query_ids_[query_issued_++];
+}
+
+void GLQueryPool::begin_query()
+{
+  /* TODO add assert about expected usage. */
+  BLI_assert(type_ != GPU_QUERY_TIMESTAMP);
+  glBeginQuery(gl_type_, this->query_next());
 }
 
 void GLQueryPool::end_query()
@@ -75,4 +80,34 @@ void GLQueryPool::get_occlusion_result(MutableSpan<uint32_t> r_values)
   }
 }
 
+int GLQueryPool::timestamp()
+{
+  BLI_assert(type_ == GPU_QUERY_TIMESTAMP);
+  const int index = query_issued_;
+  glQueryCounter(this->query_next(), GL_TIMESTAMP);
+  return index;
+}
+
+bool GLQueryPool::get_timestamp_result(MutableSpan<uint64_t> r_values)
+{
+  BLI_assert(type_ == GPU_QUERY_TIMESTAMP);
+  BLI_assert(r_values.size() <= query_issued_);
+
+  if (r_values.size() == 0) {
+    return true;
+  }
+  /* Queries complete in order, so the last one is enough to know if all are available. */
+  GLuint available = GL_FALSE;
+  glGetQueryObjectuiv(query_ids_[r_values.size() - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+  if (!available) {
+    return false;
+  }
+  for (int i = 0; i < r_values.size(); i++) {
+    GLuint64 value;
+    glGetQueryObjectui64v(query_ids_[i], GL_QUERY_RESULT, &value);
+    r_values[i] = value;
+  }
+  return true;
+}
+
 }  // namespace blender::gpu
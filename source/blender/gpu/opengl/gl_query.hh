@@ -53,7 +53,14 @@ class GLQueryPool : public QueryPool {
   void begin_query(void) override;
   void end_query(void) override;
 
+  void reset(void) override;
+  int timestamp(void) override;
+
   void get_occlusion_result(MutableSpan<uint32_t> r_values) override;
+  bool get_timestamp_result(MutableSpan<uint64_t> r_values) override;
+
+ private:
+  GLuint query_next(void);
 };
 
 static inline GLenum to_gl(GPUQueryType type)
@@ -62,6 +69,9 @@ static inline GLenum to_gl(GPUQueryType type)
     /* TODO(fclem): try with GL_ANY_SAMPLES_PASSED​. */
     return GL_SAMPLES_PASSED;
   }
+  if (type == GPU_QUERY_TIMESTAMP) {
+    return GL_TIMESTAMP;
+  }
   BLI_assert(0);
   return GL_SAMPLES_PASSED;
 }
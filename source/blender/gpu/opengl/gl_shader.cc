@@ -21,11 +21,14 @@
  * \ingroup gpu
  */
 
-#include "BKE_global.h"
-
+#include "BLI_fileops.h"
+#include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_vector.hh"
 
+#include "BKE_appdir.h"
+#include "BKE_global.h"
+
 #include "GPU_platform.h"
 
 #include "gl_backend.hh"
@@ -51,6 +54,11 @@ GLShader::GLShader(const char *name) : Shader(name)
   shader_program_ = glCreateProgram();
 
   debug::object_label(GL_PROGRAM, shader_program_, name);
+
+  if (GLContext::program_binary_support) {
+    BLI_hash_mm2a_init(&binary_key_hash_[0], 0);
+    BLI_hash_mm2a_init(&binary_key_hash_[1], 0x9e3779b9);
+  }
 }
 
 GLShader::~GLShader()
@@ -68,6 +76,119 @@ GLShader::~GLShader()
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Program binary cache
+ *
+ * Linked programs are saved to disk with `glGetProgramBinary`, keyed by a hash of the patched
+ * stage sources, the transform feedback varyings and the driver identification strings.
+ * Next time the same shader is created, the binary is loaded and no stage is compiled.
+ * Drivers may reject a binary at any time (e.g. after an update), in which case the shader is
+ * compiled normally and the cache entry is replaced.
+ * \{ */
+
+#define SHADER_BINARY_MAGIC "BLGLBIN1"
+
+struct ShaderBinaryHeader {
+  char magic[8];
+  uint64_t key;
+  GLenum format;
+  uint32_t size;
+};
+
+void GLShader::binary_key_add(const char *str)
+{
+  const size_t len = strlen(str);
+  BLI_hash_mm2a_add(&binary_key_hash_[0], (const uchar *)str, len);
+  BLI_hash_mm2a_add(&binary_key_hash_[1], (const uchar *)str, len);
+  /* Separate consecutive strings, so moving text from one source to the next changes the key. */
+  BLI_hash_mm2a_add_int(&binary_key_hash_[0], (int)len);
+  BLI_hash_mm2a_add_int(&binary_key_hash_[1], (int)len);
+}
+
+uint64_t GLShader::binary_key_get()
+{
+  for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+    const char *str = (const char *)glGetString(name);
+    binary_key_add(str ? str : "");
+  }
+  const uint64_t hash_lo = BLI_hash_mm2a_end(&binary_key_hash_[0]);
+  const uint64_t hash_hi = BLI_hash_mm2a_end(&binary_key_hash_[1]);
+  return (hash_hi << 32) | hash_lo;
+}
+
+static void gl_program_binary_filepath(char *filepath, size_t filepath_len, uint64_t key)
+{
+  char filename[64];
+  BLI_snprintf(filename, sizeof(filename), "%016llx.bin", (unsigned long long)key);
+  BLI_path_join(filepath, filepath_len, BKE_tempdir_base(), "blender_shader_cache", filename, NULL);
+}
+
+static bool gl_program_binary_load(GLuint program, uint64_t key)
+{
+  char filepath[FILE_MAX];
+  gl_program_binary_filepath(filepath, sizeof(filepath), key);
+
+  size_t file_size;
+  void *file_data = BLI_file_read_binary_as_mem(filepath, 0, &file_size);
+  if (file_data == nullptr) {
+    return false;
+  }
+
+  const ShaderBinaryHeader *header = (const ShaderBinaryHeader *)file_data;
+  bool valid = (file_size >= sizeof(ShaderBinaryHeader)) &&
+               STREQLEN(header->magic, SHADER_BINARY_MAGIC, sizeof(header->magic)) &&
+               (header->key == key) && (file_size == sizeof(*header) + header->size);
+  if (valid) {
+    glProgramBinary(program, header->format, header + 1, header->size);
+    GLint status;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    valid = (status == GL_TRUE);
+  }
+  MEM_freeN(file_data);
+
+  if (G.debug & G_DEBUG_GPU) {
+    printf("GLShader: %s program binary %s\n", valid ? "loaded" : "rejected", filepath);
+  }
+  return valid;
+}
+
+static void gl_program_binary_store(GLuint program, uint64_t key)
+{
+  GLint size = 0;
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &size);
+  if (size <= 0) {
+    return;
+  }
+
+  Vector<char> data(sizeof(ShaderBinaryHeader) + size);
+  ShaderBinaryHeader *header = (ShaderBinaryHeader *)data.data();
+  memcpy(header->magic, SHADER_BINARY_MAGIC, sizeof(header->magic));
+  header->key = key;
+  header->size = (uint32_t)size;
+  glGetProgramBinary(program, size, nullptr, &header->format, header + 1);
+
+  char filepath[FILE_MAX];
+  gl_program_binary_filepath(filepath, sizeof(filepath), key);
+  BLI_make_existing_file(filepath);
+
+  /* Write to a temporary file first, shaders can be compiled from several threads and a
+   * partially written file must never be picked up. The buffer address makes the name unique. */
+  char filepath_tmp[FILE_MAX];
+  BLI_snprintf(filepath_tmp, sizeof(filepath_tmp), "%s.%p.tmp", filepath, (void *)data.data());
+  FILE *file = BLI_fopen(filepath_tmp, "wb");
+  if (file == nullptr) {
+    return;
+  }
+  const bool written = fwrite(data.data(), data.size(), 1, file) == 1;
+  fclose(file);
+
+  if (!written || BLI_rename(filepath_tmp, filepath) != 0) {
+    BLI_delete(filepath_tmp, false, false);
+  }
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Shader stage creation
  * \{ */
@@ -157,23 +278,72 @@ GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *>
   return shader;
 }
 
+/* Compile the stage now, or keep its sources for #finalize() when the binary cache is used. */
+GLuint GLShader::stage_from_glsl(GLenum gl_stage, MutableSpan<const char *> sources)
+{
+  if (!GLContext::program_binary_support) {
+    return this->create_shader_stage(gl_stage, sources);
+  }
+
+  sources[0] = glsl_patch_get();
+
+  deferred_stages_.append({gl_stage, {}});
+  DeferredStage &stage = deferred_stages_.last();
+  binary_key_add((const char *)&gl_stage);
+  for (const char *source : sources) {
+    stage.sources.append(source);
+    binary_key_add(source);
+  }
+  return 0;
+}
+
 void GLShader::vertex_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  vert_shader_ = this->create_shader_stage(GL_VERTEX_SHADER, sources);
+  vert_shader_ = this->stage_from_glsl(GL_VERTEX_SHADER, sources);
 }
 
 void GLShader::geometry_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  geom_shader_ = this->create_shader_stage(GL_GEOMETRY_SHADER, sources);
+  geom_shader_ = this->stage_from_glsl(GL_GEOMETRY_SHADER, sources);
 }
 
 void GLShader::fragment_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  frag_shader_ = this->create_shader_stage(GL_FRAGMENT_SHADER, sources);
+  frag_shader_ = this->stage_from_glsl(GL_FRAGMENT_SHADER, sources);
 }
 
 bool GLShader::finalize()
 {
+  uint64_t binary_key = 0;
+  if (GLContext::program_binary_support) {
+    binary_key = this->binary_key_get();
+    if (gl_program_binary_load(shader_program_, binary_key)) {
+      interface = new GLShaderInterface(shader_program_);
+      return true;
+    }
+
+    for (DeferredStage &stage : deferred_stages_) {
+      Vector<const char *> sources;
+      for (const std::string &source : stage.sources) {
+        sources.append(source.c_str());
+      }
+      GLuint shader = this->create_shader_stage(stage.gl_stage, sources);
+      switch (stage.gl_stage) {
+        case GL_VERTEX_SHADER:
+          vert_shader_ = shader;
+          break;
+        case GL_GEOMETRY_SHADER:
+          geom_shader_ = shader;
+          break;
+        case GL_FRAGMENT_SHADER:
+          frag_shader_ = shader;
+          break;
+      }
+    }
+    deferred_stages_.clear_and_make_inline();
+    glProgramParameteri(shader_program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
+
   if (compilation_failed_) {
     return false;
   }
@@ -192,6 +362,10 @@ bool GLShader::finalize()
 
   interface = new GLShaderInterface(shader_program_);
 
+  if (GLContext::program_binary_support) {
+    gl_program_binary_store(shader_program_, binary_key);
+  }
+
   return true;
 }
 
@@ -229,6 +403,12 @@ void GLShader::transform_feedback_names_set(Span<const char *> name_list,
   glTransformFeedbackVaryings(
       shader_program_, name_list.size(), name_list.data(), GL_INTERLEAVED_ATTRIBS);
   transform_feedback_type_ = geom_type;
+
+  if (GLContext::program_binary_support) {
+    for (const char *name : name_list) {
+      binary_key_add(name);
+    }
+  }
 }
 
 bool GLShader::transform_feedback_enable(GPUVertBuf *buf_)
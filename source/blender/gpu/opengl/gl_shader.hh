@@ -25,8 +25,13 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_hash_mm2a.h"
+#include "BLI_vector.hh"
+
 #include "glew-mx.h"
 
+#include <string>
+
 #include "gpu_shader_private.hh"
 
 namespace blender {
@@ -48,6 +53,18 @@ class GLShader : public Shader {
 
   eGPUShaderTFBType transform_feedback_type_ = GPU_SHADER_TFB_NONE;
 
+  /**
+   * When the program binary cache is used, stage compilation is deferred to #finalize()
+   * and only done if no cached binary matches these sources.
+   */
+  struct DeferredStage {
+    GLenum gl_stage;
+    Vector<std::string> sources;
+  };
+  Vector<DeferredStage> deferred_stages_;
+  /** Two hashes with different seeds, combined into the 64 bit cache key. */
+  BLI_HashMurmur2A binary_key_hash_[2];
+
  public:
   GLShader(const char *name);
   ~GLShader();
@@ -78,6 +95,9 @@ class GLShader : public Shader {
   char *glsl_patch_get(void);
 
   GLuint create_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources);
+  GLuint stage_from_glsl(GLenum gl_stage, MutableSpan<const char *> sources);
+  void binary_key_add(const char *str);
+  uint64_t binary_key_get();
 
   MEM_CXX_CLASS_ALLOC_FUNCS("GLShader");
 };
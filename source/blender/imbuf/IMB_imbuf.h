@@ -122,6 +122,18 @@ struct ImBuf *IMB_testiffname(const char *filepath, int flags);
  */
 struct ImBuf *IMB_loadiffname(const char *filepath, int flags, char colorspace[IM_MAX_SPACE]);
 
+/**
+ * Load an image for use as thumbnail, decoding it at a reduced size when the file format supports
+ * it. `r_width` and `r_height` are set to the full size of the image.
+ *
+ * \attention Defined in readimage.c
+ */
+struct ImBuf *IMB_thumb_load_image(const char *filepath,
+                                   size_t max_thumb_size,
+                                   char colorspace[IM_MAX_SPACE],
+                                   size_t *r_width,
+                                   size_t *r_height);
+
 /**
  *
  * \attention Defined in allocimbuf.c
@@ -737,6 +749,7 @@ void IMB_processor_apply_threaded_scanlines(int total_scanlines,
 /* ffmpeg */
 void IMB_ffmpeg_init(void);
 const char *IMB_ffmpeg_last_error(void);
+void IMB_ffmpeg_hw_decoding_set(bool use_hw_decoding);
 
 /**
  *
@@ -172,6 +172,8 @@ typedef enum eImBufFlags {
   IB_thumbnail = 1 << 16,
   IB_multiview = 1 << 17,
   IB_halffloat = 1 << 18,
+  /** only create the layers and passes of multilayer EXR files, without reading their pixels */
+  IB_multilayer_deferred = 1 << 19,
 } eImBufFlags;
 
 /** \} */
@@ -130,12 +130,21 @@ struct anim {
   AVFrame *pFrameRGB;
   AVFrame *pFrameDeinterlaced;
   struct SwsContext *img_convert_ctx;
+  /** Pixel format `img_convert_ctx` converts from. */
+  int img_convert_pix_fmt;
   int videoStream;
 
+  /** Hardware decoding, frames in `hw_pix_fmt` are copied to `pFrameSW` for conversion. */
+  struct AVBufferRef *hw_device_ctx;
+  int hw_pix_fmt;
+  AVFrame *pFrameSW;
+
   struct ImBuf *last_frame;
   int64_t last_pts;
   int64_t next_pts;
   AVPacket next_packet;
+  /** Decodes the frame after #last_frame in the background. */
+  struct TaskPool *decode_ahead_pool;
 #endif
 
   char index_dir[768];
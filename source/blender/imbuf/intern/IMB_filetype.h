@@ -48,6 +48,18 @@ typedef struct ImFileType {
                         char colorspace[IM_MAX_SPACE]);
   /** Load an image from a file. */
   struct ImBuf *(*load_filepath)(const char *filepath, int flags, char colorspace[IM_MAX_SPACE]);
+  /**
+   * Optional, load a reduced size image from memory for use as thumbnail. The result is at least
+   * `max_thumb_size` in its largest dimension when the image is, `r_width` and `r_height` are set
+   * to the full size of the image.
+   */
+  struct ImBuf *(*load_thumbnail)(const unsigned char *mem,
+                                  size_t size,
+                                  int flags,
+                                  size_t max_thumb_size,
+                                  char colorspace[IM_MAX_SPACE],
+                                  size_t *r_width,
+                                  size_t *r_height);
   /** Save to a file (or memory if #IB_mem is set in `flags` and the format supports it). */
   bool (*save)(struct ImBuf *ibuf, const char *filepath, int flags);
   void (*load_tile)(struct ImBuf *ibuf,
@@ -124,6 +136,13 @@ struct ImBuf *imb_load_jpeg(const unsigned char *buffer,
                             size_t size,
                             int flags,
                             char colorspace[IM_MAX_SPACE]);
+struct ImBuf *imb_thumbnail_jpeg(const unsigned char *buffer,
+                                 size_t size,
+                                 int flags,
+                                 size_t max_thumb_size,
+                                 char colorspace[IM_MAX_SPACE],
+                                 size_t *r_width,
+                                 size_t *r_height);
 
 /* bmp */
 bool imb_is_a_bmp(const unsigned char *buf, const size_t size);
@@ -55,6 +55,8 @@
 
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "MEM_guardedalloc.h"
@@ -82,6 +84,10 @@
 #  include <libswscale/swscale.h>
 
 #  include "ffmpeg_compat.h"
+
+#  ifdef FFMPEG_HAVE_HW_DECODING
+#    include <libavutil/hwcontext.h>
+#  endif
 #endif /* WITH_FFMPEG */
 
 int ismovie(const char *UNUSED(filepath))
@@ -200,6 +206,7 @@ static void free_anim_avi(struct anim *anim)
 
 #ifdef WITH_FFMPEG
 static void free_anim_ffmpeg(struct anim *anim);
+static void ffmpeg_decode_ahead_wait(struct anim *anim);
 #endif
 
 void IMB_free_anim(struct anim *anim)
@@ -250,6 +257,7 @@ struct IDProperty *IMB_anim_load_metadata(struct anim *anim)
       AVDictionaryEntry *entry = NULL;
 
       BLI_assert(anim->pFormatCtx != NULL);
+      ffmpeg_decode_ahead_wait(anim);
       av_log(anim->pFormatCtx, AV_LOG_DEBUG, "METADATA FETCH\n");
 
       while (true) {
@@ -498,6 +506,20 @@ static ImBuf *avi_fetchibuf(struct anim *anim, int position)
 }
 #endif /* WITH_AVI */
 
+#ifdef WITH_FFMPEG
+/** Try hardware decoding for movies opened from now on, see #IMB_ffmpeg_hw_decoding_set. */
+static bool ffmpeg_use_hw_decoding = false;
+#endif
+
+void IMB_ffmpeg_hw_decoding_set(bool use_hw_decoding)
+{
+#ifdef WITH_FFMPEG
+  ffmpeg_use_hw_decoding = use_hw_decoding;
+#else
+  UNUSED_VARS(use_hw_decoding);
+#endif
+}
+
 #ifdef WITH_FFMPEG
 
 BLI_INLINE bool need_aligned_ffmpeg_buffer(struct anim *anim)
@@ -505,6 +527,133 @@ BLI_INLINE bool need_aligned_ffmpeg_buffer(struct anim *anim)
   return (anim->x & 31) != 0;
 }
 
+#  ifdef FFMPEG_HAVE_HW_DECODING
+static enum AVPixelFormat ffmpeg_hw_get_format(AVCodecContext *pCodecCtx,
+                                               const enum AVPixelFormat *pix_fmts)
+{
+  struct anim *anim = pCodecCtx->opaque;
+
+  for (const enum AVPixelFormat *p = pix_fmts; *p != AV_PIX_FMT_NONE; p++) {
+    if (*p == anim->hw_pix_fmt) {
+      return *p;
+    }
+  }
+
+  /* The device can't decode this stream (profile, resolution...), decode in software. */
+  fprintf(stderr, "%s: hardware decoding not possible, using software decoding\n", anim->name);
+  anim->hw_pix_fmt = AV_PIX_FMT_NONE;
+  return avcodec_default_get_format(pCodecCtx, pix_fmts);
+}
+
+/**
+ * Set up \a pCodecCtx for decoding on the first hardware device (in FFmpeg's order of device
+ * types: VDPAU, CUDA/NVDEC, VAAPI, DXVA2, QSV, VideoToolbox, D3D11VA...) that supports the codec.
+ * Leaves the codec context untouched when none does, so decoding falls back to software.
+ */
+static void ffmpeg_hw_decoding_init(struct anim *anim, AVCodecContext *pCodecCtx, AVCodec *pCodec)
+{
+  for (int i = 0;; i++) {
+    const AVCodecHWConfig *config = avcodec_get_hw_config(pCodec, i);
+    if (config == NULL) {
+      break;
+    }
+    if ((config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) == 0) {
+      continue;
+    }
+    if (av_hwdevice_ctx_create(&anim->hw_device_ctx, config->device_type, NULL, NULL, 0) < 0) {
+      continue;
+    }
+
+    av_log(anim->pFormatCtx,
+           AV_LOG_INFO,
+           "Using %s hardware decoding\n",
+           av_hwdevice_get_type_name(config->device_type));
+
+    anim->hw_pix_fmt = config->pix_fmt;
+    pCodecCtx->hw_device_ctx = av_buffer_ref(anim->hw_device_ctx);
+    pCodecCtx->opaque = anim;
+    pCodecCtx->get_format = ffmpeg_hw_get_format;
+    anim->pFrameSW = av_frame_alloc();
+    return;
+  }
+}
+#  endif /* FFMPEG_HAVE_HW_DECODING */
+
+static void ffmpeg_hw_decoding_free(struct anim *anim)
+{
+  av_frame_free(&anim->pFrameSW);
+  av_buffer_unref(&anim->hw_device_ctx);
+}
+
+/**
+ * Ensure the color conversion context converts from \a pix_fmt, which for hardware decoding is
+ * only known once the first frame was copied from the device.
+ */
+static bool ffmpeg_img_convert_ctx_ensure(struct anim *anim, enum AVPixelFormat pix_fmt)
+{
+#  ifdef FFMPEG_SWSCALE_COLOR_SPACE_SUPPORT
+  /* The following for color space determination */
+  int srcRange, dstRange, brightness, contrast, saturation;
+  int *table;
+  const int *inv_table;
+#  endif
+
+  if (anim->img_convert_ctx != NULL) {
+    if (anim->img_convert_pix_fmt == pix_fmt) {
+      return true;
+    }
+    sws_freeContext(anim->img_convert_ctx);
+  }
+
+  anim->img_convert_pix_fmt = pix_fmt;
+  anim->img_convert_ctx = sws_getContext(anim->x,
+                                         anim->y,
+                                         pix_fmt,
+                                         anim->x,
+                                         anim->y,
+                                         AV_PIX_FMT_RGBA,
+                                         SWS_FAST_BILINEAR | SWS_PRINT_INFO | SWS_FULL_CHR_H_INT,
+                                         NULL,
+                                         NULL,
+                                         NULL);
+
+  if (!anim->img_convert_ctx) {
+    fprintf(stderr, "Can't transform color space??? Bailing out...\n");
+    return false;
+  }
+
+#  ifdef FFMPEG_SWSCALE_COLOR_SPACE_SUPPORT
+  /* Try do detect if input has 0-255 YCbCR range (JFIF Jpeg MotionJpeg) */
+  if (!sws_getColorspaceDetails(anim->img_convert_ctx,
+                                (int **)&inv_table,
+                                &srcRange,
+                                &table,
+                                &dstRange,
+                                &brightness,
+                                &contrast,
+                                &saturation)) {
+    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
+    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
+
+    if (sws_setColorspaceDetails(anim->img_convert_ctx,
+                                 (int *)inv_table,
+                                 srcRange,
+                                 table,
+                                 dstRange,
+                                 brightness,
+                                 contrast,
+                                 saturation)) {
+      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+    }
+  }
+  else {
+    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+  }
+#  endif
+
+  return true;
+}
+
 static int startffmpeg(struct anim *anim)
 {
   int i, video_stream_index;
@@ -518,13 +667,6 @@ static int startffmpeg(struct anim *anim)
   double frs_den;
   int streamcount;
 
-#  ifdef FFMPEG_SWSCALE_COLOR_SPACE_SUPPORT
-  /* The following for color space determination */
-  int srcRange, dstRange, brightness, contrast, saturation;
-  int *table;
-  const int *inv_table;
-#  endif
-
   if (anim == NULL) {
     return (-1);
   }
@@ -573,12 +715,30 @@ static int startffmpeg(struct anim *anim)
 
   pCodecCtx->workaround_bugs = 1;
 
+  anim->hw_pix_fmt = AV_PIX_FMT_NONE;
+#  ifdef FFMPEG_HAVE_HW_DECODING
+  /* Deinterlacing works on the decoded frames in the codec's software format. */
+  if (ffmpeg_use_hw_decoding && (anim->ib_flags & IB_animdeinterlace) == 0) {
+    ffmpeg_hw_decoding_init(anim, pCodecCtx, pCodec);
+  }
+#  endif
+
+  /* Let FFmpeg decode on all threads. Frame threading keeps several frames of long-GOP streams
+   * in flight, slice threading helps intra-only codecs.
+   * Hardware decoding is left to the device. */
+  if (anim->hw_device_ctx == NULL) {
+    pCodecCtx->thread_count = BLI_system_thread_count();
+    pCodecCtx->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+  }
+
   if (avcodec_open2(pCodecCtx, pCodec, NULL) < 0) {
+    ffmpeg_hw_decoding_free(anim);
     avformat_close_input(&pFormatCtx);
     return -1;
   }
   if (pCodecCtx->pix_fmt == AV_PIX_FMT_NONE) {
     avcodec_close(anim->pCodecCtx);
+    ffmpeg_hw_decoding_free(anim);
     avformat_close_input(&pFormatCtx);
     return -1;
   }
@@ -654,6 +814,7 @@ static int startffmpeg(struct anim *anim)
     if (av_frame_get_buffer(anim->pFrameRGB, 32) < 0) {
       fprintf(stderr, "Could not allocate frame data.\n");
       avcodec_close(anim->pCodecCtx);
+      ffmpeg_hw_decoding_free(anim);
       avformat_close_input(&anim->pFormatCtx);
       av_frame_free(&anim->pFrameRGB);
       av_frame_free(&anim->pFrameDeinterlaced);
@@ -666,6 +827,7 @@ static int startffmpeg(struct anim *anim)
   if (avpicture_get_size(AV_PIX_FMT_RGBA, anim->x, anim->y) != anim->x * anim->y * 4) {
     fprintf(stderr, "ffmpeg has changed alloc scheme ... ARGHHH!\n");
     avcodec_close(anim->pCodecCtx);
+    ffmpeg_hw_decoding_free(anim);
     avformat_close_input(&anim->pFormatCtx);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
@@ -692,20 +854,9 @@ static int startffmpeg(struct anim *anim)
     anim->preseek = 0;
   }
 
-  anim->img_convert_ctx = sws_getContext(anim->x,
-                                         anim->y,
-                                         anim->pCodecCtx->pix_fmt,
-                                         anim->x,
-                                         anim->y,
-                                         AV_PIX_FMT_RGBA,
-                                         SWS_FAST_BILINEAR | SWS_PRINT_INFO | SWS_FULL_CHR_H_INT,
-                                         NULL,
-                                         NULL,
-                                         NULL);
-
-  if (!anim->img_convert_ctx) {
-    fprintf(stderr, "Can't transform color space??? Bailing out...\n");
+  if (!ffmpeg_img_convert_ctx_ensure(anim, anim->pCodecCtx->pix_fmt)) {
     avcodec_close(anim->pCodecCtx);
+    ffmpeg_hw_decoding_free(anim);
     avformat_close_input(&anim->pFormatCtx);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
@@ -714,35 +865,6 @@ static int startffmpeg(struct anim *anim)
     return -1;
   }
 
-#  ifdef FFMPEG_SWSCALE_COLOR_SPACE_SUPPORT
-  /* Try do detect if input has 0-255 YCbCR range (JFIF Jpeg MotionJpeg) */
-  if (!sws_getColorspaceDetails(anim->img_convert_ctx,
-                                (int **)&inv_table,
-                                &srcRange,
-                                &table,
-                                &dstRange,
-                                &brightness,
-                                &contrast,
-                                &saturation)) {
-    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
-    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
-
-    if (sws_setColorspaceDetails(anim->img_convert_ctx,
-                                 (int *)inv_table,
-                                 srcRange,
-                                 table,
-                                 dstRange,
-                                 brightness,
-                                 contrast,
-                                 saturation)) {
-      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-    }
-  }
-  else {
-    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-  }
-#  endif
-
   return 0;
 }
 
@@ -779,6 +901,22 @@ static void ffmpeg_postprocess(struct anim *anim)
          input->data[2],
          input->data[3]);
 
+#  ifdef FFMPEG_HAVE_HW_DECODING
+  if ((anim->hw_pix_fmt != AV_PIX_FMT_NONE) && (input->format == anim->hw_pix_fmt)) {
+    /* Copy from the device in its native (usually NV12) layout, converted like any frame. */
+    av_frame_unref(anim->pFrameSW);
+    if (av_hwframe_transfer_data(anim->pFrameSW, input, 0) < 0) {
+      fprintf(stderr, "ffmpeg_fetchibuf: could not transfer frame from the hardware device\n");
+      return;
+    }
+    input = anim->pFrameSW;
+  }
+#  endif
+
+  if (!ffmpeg_img_convert_ctx_ensure(anim, (enum AVPixelFormat)input->format)) {
+    return;
+  }
+
   if (anim->ib_flags & IB_animdeinterlace) {
     if (avpicture_deinterlace((AVPicture *)anim->pFrameDeinterlaced,
                               (const AVPicture *)anim->pFrame,
@@ -965,6 +1103,32 @@ static int ffmpeg_decode_video_frame(struct anim *anim)
   return (rval >= 0);
 }
 
+static void ffmpeg_decode_ahead_fn(TaskPool *__restrict pool, void *UNUSED(taskdata))
+{
+  struct anim *anim = BLI_task_pool_user_data(pool);
+  ffmpeg_decode_video_frame(anim);
+}
+
+/**
+ * Decode the frame following the one just fetched in the background, while the caller is busy
+ * with the fetched frame. Anything touching the decoder state must call
+ * #ffmpeg_decode_ahead_wait first.
+ */
+static void ffmpeg_decode_ahead(struct anim *anim)
+{
+  if (anim->decode_ahead_pool == NULL) {
+    anim->decode_ahead_pool = BLI_task_pool_create(anim, TASK_PRIORITY_HIGH);
+  }
+  BLI_task_pool_push(anim->decode_ahead_pool, ffmpeg_decode_ahead_fn, NULL, false, NULL);
+}
+
+static void ffmpeg_decode_ahead_wait(struct anim *anim)
+{
+  if (anim->decode_ahead_pool != NULL) {
+    BLI_task_pool_work_and_wait(anim->decode_ahead_pool);
+  }
+}
+
 static void ffmpeg_decode_video_frame_scan(struct anim *anim, int64_t pts_to_search)
 {
   /* there seem to exist *very* silly GOP lengths out in the wild... */
@@ -1060,6 +1224,8 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
     return 0;
   }
 
+  ffmpeg_decode_ahead_wait(anim);
+
   av_log(anim->pFormatCtx, AV_LOG_DEBUG, "FETCH: pos=%d\n", position);
 
   if (tc != IMB_TC_NONE) {
@@ -1231,7 +1397,7 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
 
   anim->last_pts = anim->next_pts;
 
-  ffmpeg_decode_video_frame(anim);
+  ffmpeg_decode_ahead(anim);
 
   anim->curposition = position;
 
@@ -1246,6 +1412,12 @@ static void free_anim_ffmpeg(struct anim *anim)
     return;
   }
 
+  if (anim->decode_ahead_pool) {
+    ffmpeg_decode_ahead_wait(anim);
+    BLI_task_pool_free(anim->decode_ahead_pool);
+    anim->decode_ahead_pool = NULL;
+  }
+
   if (anim->pCodecCtx) {
     avcodec_close(anim->pCodecCtx);
     avformat_close_input(&anim->pFormatCtx);
@@ -1269,6 +1441,7 @@ static void free_anim_ffmpeg(struct anim *anim)
     av_frame_free(&anim->pFrameDeinterlaced);
 
     sws_freeContext(anim->img_convert_ctx);
+    ffmpeg_hw_decoding_free(anim);
     IMB_freeImBuf(anim->last_frame);
     if (anim->next_packet.stream_index != -1) {
       av_free_packet(&anim->next_packet);
@@ -106,6 +106,8 @@ typedef struct ColormanageProcessor {
   bool is_data_result;
 } ColormanageProcessor;
 
+static void display_lut_free_all(void);
+
 static struct global_glsl_state {
   /* Actual processor used for GLSL baked LUTs. */
   /* UI colorspace here refers to the display linear color space,
@@ -655,6 +657,8 @@ static void colormanage_free_config(void)
   BLI_freelistN(&global_looks);
   global_tot_looks = 0;
 
+  display_lut_free_all();
+
   OCIO_exit();
 }
 
@@ -1481,12 +1485,257 @@ const float *IMB_colormangement_get_xyz_to_rgb()
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Baked Display LUT
+ *
+ * Display transform of byte images baked into a 3D LUT, indexed by the byte color of a pixel.
+ * Applying the full transform needs byte to float conversion, a transform to scene linear and
+ * the OCIO display processor for every pixel, while a LUT lookup is a handful of multiply-adds.
+ * Baked tables are kept for a few view settings, since they are typically used by many frames.
+ *
+ * Only used for byte buffers without curve mapping and dither. Float buffers are not baked,
+ * since scene linear values are not limited to the range a LUT covers.
+ * \{ */
+
+#define DISPLAY_LUT_SIZE 33
+#define DISPLAY_LUT_CACHE_MAX 8
+/* Baking is not worth the small loss of precision for smaller images. */
+#define DISPLAY_LUT_MIN_PIXELS (256 * 256)
+
+typedef struct DisplayLUT {
+  struct DisplayLUT *next, *prev;
+
+  char look[MAX_COLORSPACE_NAME];
+  char view_transform[MAX_COLORSPACE_NAME];
+  char display_device[MAX_COLORSPACE_NAME];
+  char byte_colorspace[MAX_COLORSPACE_NAME];
+  float exposure;
+  float gamma;
+
+  /* Number of display transforms using the table, protected by #display_lut_lock. */
+  int users;
+  /* RGB for DISPLAY_LUT_SIZE^3 colors, red changing fastest. */
+  float *table;
+} DisplayLUT;
+
+/* Most recently used first. */
+static ListBase global_display_luts = {NULL, NULL};
+static ThreadMutex display_lut_lock = BLI_MUTEX_INITIALIZER;
+
+static bool display_lut_supported(const ImBuf *ibuf,
+                                  const float *display_buffer,
+                                  const ColorManagedViewSettings *view_settings)
+{
+  return ibuf->rect_float == NULL && ibuf->rect != NULL && display_buffer == NULL &&
+         ibuf->dither == 0.0f && ELEM(ibuf->channels, 3, 4) &&
+         (ibuf->colormanage_flag & IMB_COLORMANAGE_IS_DATA) == 0 &&
+         (view_settings->flag & COLORMANAGE_VIEW_USE_CURVES) == 0 &&
+         ((size_t)ibuf->x * (size_t)ibuf->y) >= DISPLAY_LUT_MIN_PIXELS;
+}
+
+static bool display_lut_matches(const DisplayLUT *lut,
+                                const ColorManagedViewSettings *view_settings,
+                                const ColorManagedDisplaySettings *display_settings,
+                                const char *byte_colorspace)
+{
+  return STREQ(lut->look, view_settings->look) &&
+         STREQ(lut->view_transform, view_settings->view_transform) &&
+         STREQ(lut->display_device, display_settings->display_device) &&
+         STREQ(lut->byte_colorspace, byte_colorspace) &&
+         lut->exposure == view_settings->exposure && lut->gamma == view_settings->gamma;
+}
+
+static float *display_lut_bake(ColormanageProcessor *cm_processor, const char *byte_colorspace)
+{
+  const int lut_len = DISPLAY_LUT_SIZE * DISPLAY_LUT_SIZE * DISPLAY_LUT_SIZE;
+  float *table = MEM_mallocN(sizeof(float[3]) * lut_len, "display LUT");
+  float *fp = table;
+
+  for (int b = 0; b < DISPLAY_LUT_SIZE; b++) {
+    for (int g = 0; g < DISPLAY_LUT_SIZE; g++) {
+      for (int r = 0; r < DISPLAY_LUT_SIZE; r++, fp += 3) {
+        fp[0] = (float)r / (DISPLAY_LUT_SIZE - 1);
+        fp[1] = (float)g / (DISPLAY_LUT_SIZE - 1);
+        fp[2] = (float)b / (DISPLAY_LUT_SIZE - 1);
+      }
+    }
+  }
+
+  /* Same steps as #display_buffer_apply_get_linear_buffer and #do_display_buffer_apply_thread
+   * take for byte buffers. */
+  if (!cm_processor->is_data_result) {
+    IMB_colormanagement_transform(
+        table, lut_len, 1, 3, byte_colorspace, global_role_scene_linear, false);
+  }
+  IMB_colormanagement_processor_apply(cm_processor, table, lut_len, 1, 3, false);
+
+  return table;
+}
+
+/* Get a baked table for the view settings, release with #display_lut_release. */
+static DisplayLUT *display_lut_acquire(ColormanageProcessor *cm_processor,
+                                       const ColorManagedViewSettings *view_settings,
+                                       const ColorManagedDisplaySettings *display_settings,
+                                       const char *byte_colorspace)
+{
+  BLI_mutex_lock(&display_lut_lock);
+
+  LISTBASE_FOREACH (DisplayLUT *, lut, &global_display_luts) {
+    if (display_lut_matches(lut, view_settings, display_settings, byte_colorspace)) {
+      BLI_remlink(&global_display_luts, lut);
+      BLI_addhead(&global_display_luts, lut);
+      lut->users++;
+      BLI_mutex_unlock(&display_lut_lock);
+      return lut;
+    }
+  }
+
+  /* Make room, skipping tables which are in use. */
+  if (BLI_listbase_count_at_most(&global_display_luts, DISPLAY_LUT_CACHE_MAX) ==
+      DISPLAY_LUT_CACHE_MAX) {
+    LISTBASE_FOREACH_BACKWARD (DisplayLUT *, lut, &global_display_luts) {
+      if (lut->users == 0) {
+        BLI_remlink(&global_display_luts, lut);
+        MEM_freeN(lut->table);
+        MEM_freeN(lut);
+        break;
+      }
+    }
+  }
+
+  DisplayLUT *lut = MEM_callocN(sizeof(DisplayLUT), "DisplayLUT");
+  BLI_strncpy(lut->look, view_settings->look, sizeof(lut->look));
+  BLI_strncpy(lut->view_transform, view_settings->view_transform, sizeof(lut->view_transform));
+  BLI_strncpy(
+      lut->display_device, display_settings->display_device, sizeof(lut->display_device));
+  BLI_strncpy(lut->byte_colorspace, byte_colorspace, sizeof(lut->byte_colorspace));
+  lut->exposure = view_settings->exposure;
+  lut->gamma = view_settings->gamma;
+  lut->users = 1;
+  /* Bake under the lock, so other threads wait for the table instead of baking it again. */
+  lut->table = display_lut_bake(cm_processor, byte_colorspace);
+  BLI_addhead(&global_display_luts, lut);
+
+  BLI_mutex_unlock(&display_lut_lock);
+
+  return lut;
+}
+
+static void display_lut_release(DisplayLUT *lut)
+{
+  BLI_mutex_lock(&display_lut_lock);
+  lut->users--;
+  BLI_mutex_unlock(&display_lut_lock);
+}
+
+static void display_lut_free_all(void)
+{
+  BLI_mutex_lock(&display_lut_lock);
+  LISTBASE_FOREACH_MUTABLE (DisplayLUT *, lut, &global_display_luts) {
+    BLI_assert(lut->users == 0);
+    MEM_freeN(lut->table);
+    MEM_freeN(lut);
+  }
+  BLI_listbase_clear(&global_display_luts);
+  BLI_mutex_unlock(&display_lut_lock);
+}
+
+/* Tetrahedral interpolation of the table, for a byte color. */
+BLI_INLINE void display_lut_apply_pixel(const float *table,
+                                        const unsigned char rgb[3],
+                                        float r_rgb[3])
+{
+  const float scale = (float)(DISPLAY_LUT_SIZE - 1) / 255.0f;
+  int index[3];
+  float d[3];
+
+  for (int i = 0; i < 3; i++) {
+    const float f = rgb[i] * scale;
+    index[i] = min_ii((int)f, DISPLAY_LUT_SIZE - 2);
+    d[i] = f - index[i];
+  }
+
+  const int stride_g = DISPLAY_LUT_SIZE * 3;
+  const int stride_b = DISPLAY_LUT_SIZE * DISPLAY_LUT_SIZE * 3;
+  const float *c000 = table + index[2] * stride_b + index[1] * stride_g + index[0] * 3;
+  const float *c111 = c000 + stride_b + stride_g + 3;
+  const float *c_a, *c_b;
+  float w[4];
+
+  /* Pick the tetrahedron containing the color, by order of the fractions. */
+  if (d[0] > d[1]) {
+    if (d[1] > d[2]) {
+      /* r > g > b */
+      c_a = c000 + 3;
+      c_b = c000 + 3 + stride_g;
+      w[0] = 1.0f - d[0], w[1] = d[0] - d[1], w[2] = d[1] - d[2], w[3] = d[2];
+    }
+    else if (d[0] > d[2]) {
+      /* r > b > g */
+      c_a = c000 + 3;
+      c_b = c000 + 3 + stride_b;
+      w[0] = 1.0f - d[0], w[1] = d[0] - d[2], w[2] = d[2] - d[1], w[3] = d[1];
+    }
+    else {
+      /* b > r > g */
+      c_a = c000 + stride_b;
+      c_b = c000 + 3 + stride_b;
+      w[0] = 1.0f - d[2], w[1] = d[2] - d[0], w[2] = d[0] - d[1], w[3] = d[1];
+    }
+  }
+  else {
+    if (d[2] > d[1]) {
+      /* b > g > r */
+      c_a = c000 + stride_b;
+      c_b = c000 + stride_g + stride_b;
+      w[0] = 1.0f - d[2], w[1] = d[2] - d[1], w[2] = d[1] - d[0], w[3] = d[0];
+    }
+    else if (d[2] > d[0]) {
+      /* g > b > r */
+      c_a = c000 + stride_g;
+      c_b = c000 + stride_g + stride_b;
+      w[0] = 1.0f - d[1], w[1] = d[1] - d[2], w[2] = d[2] - d[0], w[3] = d[0];
+    }
+    else {
+      /* g > r > b */
+      c_a = c000 + stride_g;
+      c_b = c000 + 3 + stride_g;
+      w[0] = 1.0f - d[1], w[1] = d[1] - d[0], w[2] = d[0] - d[2], w[3] = d[2];
+    }
+  }
+
+  for (int i = 0; i < 3; i++) {
+    r_rgb[i] = w[0] * c000[i] + w[1] * c_a[i] + w[2] * c_b[i] + w[3] * c111[i];
+  }
+}
+
+static void display_lut_apply(const float *table,
+                              const unsigned char *byte_buffer,
+                              unsigned char *display_buffer_byte,
+                              int channels,
+                              size_t pixels_len)
+{
+  const unsigned char *cp = byte_buffer;
+  unsigned char *dp = display_buffer_byte;
+
+  for (size_t i = 0; i < pixels_len; i++, cp += channels, dp += DISPLAY_BUFFER_CHANNELS) {
+    float rgb[3];
+    display_lut_apply_pixel(table, cp, rgb);
+    unit_float_to_uchar_clamp_v3(dp, rgb);
+    dp[3] = (channels == 4) ? cp[3] : 255;
+  }
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Threaded Display Buffer Transform Routines
  * \{ */
 
 typedef struct DisplayBufferThread {
   ColormanageProcessor *cm_processor;
+  /* Baked display transform, see #display_lut_acquire. */
+  const float *display_lut;
 
   const float *buffer;
   unsigned char *byte_buffer;
@@ -1510,6 +1759,7 @@ typedef struct DisplayBufferThread {
 typedef struct DisplayBufferInitData {
   ImBuf *ibuf;
   ColormanageProcessor *cm_processor;
+  const float *display_lut;
   const float *buffer;
   unsigned char *byte_buffer;
 
@@ -1541,6 +1791,7 @@ static void display_buffer_init_handle(void *handle_v,
   memset(handle, 0, sizeof(DisplayBufferThread));
 
   handle->cm_processor = init_data->cm_processor;
+  handle->display_lut = init_data->display_lut;
 
   if (init_data->buffer) {
     handle->buffer = init_data->buffer + offset;
@@ -1663,7 +1914,14 @@ static void *do_display_buffer_apply_thread(void *handle_v)
   float dither = handle->dither;
   bool is_data = handle->is_data;
 
-  if (cm_processor == NULL) {
+  if (handle->display_lut) {
+    display_lut_apply(handle->display_lut,
+                      handle->byte_buffer,
+                      display_buffer_byte,
+                      channels,
+                      ((size_t)width) * height);
+  }
+  else if (cm_processor == NULL) {
     if (display_buffer_byte && display_buffer_byte != handle->byte_buffer) {
       IMB_buffer_byte_from_byte(display_buffer_byte,
                                 handle->byte_buffer,
@@ -1749,12 +2007,14 @@ static void display_buffer_apply_threaded(ImBuf *ibuf,
                                           unsigned char *byte_buffer,
                                           float *display_buffer,
                                           unsigned char *display_buffer_byte,
-                                          ColormanageProcessor *cm_processor)
+                                          ColormanageProcessor *cm_processor,
+                                          const float *display_lut)
 {
   DisplayBufferInitData init_data;
 
   init_data.ibuf = ibuf;
   init_data.cm_processor = cm_processor;
+  init_data.display_lut = display_lut;
   init_data.buffer = buffer;
   init_data.byte_buffer = byte_buffer;
   init_data.display_buffer = display_buffer;
@@ -1830,12 +2090,25 @@ static void colormanage_display_buffer_process_ex(
     cm_processor = IMB_colormanagement_display_processor_new(view_settings, display_settings);
   }
 
+  DisplayLUT *display_lut = NULL;
+  if (cm_processor && display_lut_supported(ibuf, display_buffer, view_settings)) {
+    const char *byte_colorspace = ibuf->rect_colorspace ? ibuf->rect_colorspace->name :
+                                                          global_role_default_byte;
+    display_lut = display_lut_acquire(
+        cm_processor, view_settings, display_settings, byte_colorspace);
+  }
+
   display_buffer_apply_threaded(ibuf,
                                 ibuf->rect_float,
                                 (unsigned char *)ibuf->rect,
                                 display_buffer,
                                 display_buffer_byte,
-                                cm_processor);
+                                cm_processor,
+                                display_lut ? display_lut->table : NULL);
+
+  if (display_lut) {
+    display_lut_release(display_lut);
+  }
 
   if (cm_processor) {
     IMB_colormanagement_processor_free(cm_processor);
@@ -2264,32 +2537,27 @@ void IMB_colormanagement_colorspace_to_scene_linear(float *buffer,
   }
 }
 
-void IMB_colormanagement_imbuf_to_byte_texture(unsigned char *out_buffer,
-                                               const int offset_x,
-                                               const int offset_y,
-                                               const int width,
-                                               const int height,
-                                               const struct ImBuf *ibuf,
-                                               const bool compress_as_srgb,
-                                               const bool store_premultiplied)
-{
-  /* Convert byte buffer for texture storage on the GPU. These have builtin
-   * support for converting sRGB to linear, which allows us to store textures
-   * without precision or performance loss at minimal memory usage. */
-  BLI_assert(ibuf->rect && ibuf->rect_float == NULL);
-
-  OCIO_ConstProcessorRcPtr *processor = NULL;
-  if (compress_as_srgb && ibuf->rect_colorspace &&
-      !IMB_colormanagement_space_is_srgb(ibuf->rect_colorspace)) {
-    processor = colorspace_to_scene_linear_processor(ibuf->rect_colorspace);
-  }
+typedef struct ByteTextureThreadData {
+  unsigned char *out_buffer;
+  const struct ImBuf *ibuf;
+  OCIO_ConstProcessorRcPtr *processor;
+  int offset_x, offset_y;
+  int width;
+  bool use_premultiply;
+} ByteTextureThreadData;
 
-  /* TODO(brecht): make this multi-threaded, or at least process in batches. */
+static void imbuf_to_byte_texture_thread_do(void *data_v, int start_scanline, int num_scanlines)
+{
+  const ByteTextureThreadData *data = (ByteTextureThreadData *)data_v;
+  const struct ImBuf *ibuf = data->ibuf;
+  OCIO_ConstProcessorRcPtr *processor = data->processor;
+  const int width = data->width;
+  const bool use_premultiply = data->use_premultiply;
   const unsigned char *in_buffer = (unsigned char *)ibuf->rect;
-  const bool use_premultiply = IMB_alpha_affects_rgb(ibuf) && store_premultiplied;
+  unsigned char *out_buffer = data->out_buffer;
 
-  for (int y = 0; y < height; y++) {
-    const size_t in_offset = (offset_y + y) * ibuf->x + offset_x;
+  for (int y = start_scanline; y < start_scanline + num_scanlines; y++) {
+    const size_t in_offset = (data->offset_y + y) * ibuf->x + data->offset_x;
     const size_t out_offset = y * width;
     const unsigned char *in = in_buffer + in_offset * 4;
     unsigned char *out = out_buffer + out_offset * 4;
@@ -2328,6 +2596,38 @@ void IMB_colormanagement_imbuf_to_byte_texture(unsigned char *out_buffer,
   }
 }
 
+void IMB_colormanagement_imbuf_to_byte_texture(unsigned char *out_buffer,
+                                               const int offset_x,
+                                               const int offset_y,
+                                               const int width,
+                                               const int height,
+                                               const struct ImBuf *ibuf,
+                                               const bool compress_as_srgb,
+                                               const bool store_premultiplied)
+{
+  /* Convert byte buffer for texture storage on the GPU. These have builtin
+   * support for converting sRGB to linear, which allows us to store textures
+   * without precision or performance loss at minimal memory usage. */
+  BLI_assert(ibuf->rect && ibuf->rect_float == NULL);
+
+  OCIO_ConstProcessorRcPtr *processor = NULL;
+  if (compress_as_srgb && ibuf->rect_colorspace &&
+      !IMB_colormanagement_space_is_srgb(ibuf->rect_colorspace)) {
+    processor = colorspace_to_scene_linear_processor(ibuf->rect_colorspace);
+  }
+
+  ByteTextureThreadData data = {
+      .out_buffer = out_buffer,
+      .ibuf = ibuf,
+      .processor = processor,
+      .offset_x = offset_x,
+      .offset_y = offset_y,
+      .width = width,
+      .use_premultiply = IMB_alpha_affects_rgb(ibuf) && store_premultiplied,
+  };
+  IMB_processor_apply_threaded_scanlines(height, imbuf_to_byte_texture_thread_do, &data);
+}
+
 void IMB_colormanagement_imbuf_to_float_texture(float *out_buffer,
                                                 const int offset_x,
                                                 const int offset_y,
@@ -47,6 +47,7 @@ const ImFileType IMB_FILE_TYPES[] = {
         .is_a = imb_is_a_jpeg,
         .load = imb_load_jpeg,
         .load_filepath = NULL,
+        .load_thumbnail = imb_thumbnail_jpeg,
         .save = imb_savejpeg,
         .load_tile = NULL,
         .flag = 0,
@@ -59,6 +60,7 @@ const ImFileType IMB_FILE_TYPES[] = {
         .is_a = imb_is_a_png,
         .load = imb_loadpng,
         .load_filepath = NULL,
+        .load_thumbnail = NULL,
         .save = imb_savepng,
         .load_tile = NULL,
         .flag = 0,
@@ -71,6 +73,7 @@ const ImFileType IMB_FILE_TYPES[] = {
         .is_a = imb_is_a_bmp,
         .load = imb_bmp_decode,
         .load_filepath = NULL,
+        .load_thumbnail = NULL,
         .save = imb_savebmp,
         .load_tile = NULL,
         .flag = 0,
@@ -83,6 +86,7 @@ const ImFileType IMB_FILE_TYPES[] = {
         .is_a = imb_is_a_targa,
         .load = imb_loadtarga,
         .load_filepath = NULL,
+        .load_thumbnail = NULL,
         .save = imb_savetarga,
         .load_tile = NULL,
         .flag = 0,
@@ -95,6 +99,7 @@ const ImFileType IMB_FILE_TYPES[] = {
         .is_a = imb_is_a_iris,
         .load = imb_loadiris,
         .load_filepath = NULL,
+        .load_thumbnail = NULL,
         .save = imb_saveiris,
         .load_tile = NULL,
         .flag = 0,
@@ -108,6 +113,7 @@ const ImFileType IMB_FILE_TYPES[] = {
         .is_a = imb_is_a_dpx,
         .load = imb_load_dpx,
         .load_filepath = NULL,
+        .load_thumbnail = NULL,
         .save = imb_save_dpx,
         .load_tile = NULL,
         .flag = IM_FTYPE_FLOAT,
@@ -120,6 +126,7 @@ const ImFileType IMB_FILE_TYPES[] = {
         .is_a = imb_is_a_cineon,
         .load = imb_load_cineon,
         .load_filepath = NULL,
+        .load_thumbnail = NULL,
         .save = imb_save_cineon,
         .load_tile = NULL,
         .flag = IM_FTYPE_FLOAT,
@@ -134,6 +141,7 @@ const ImFileType IMB_FILE_TYPES[] = {
         .is_a = imb_is_a_tiff,
         .load = imb_loadtiff,
         .load_filepath = NULL,
+        .load_thumbnail = NULL,
         .save = imb_savetiff,
         .load_tile = imb_loadtiletiff,
         .flag = 0,
@@ -148,6 +156,7 @@ const ImFileType IMB_FILE_TYPES[] = {
         .is_a = imb_is_a_hdr,
         .load = imb_loadhdr,
         .load_filepath = NULL,
+        .load_thumbnail = NULL,
         .save = imb_savehdr,
         .load_tile = NULL,
         .flag = IM_FTYPE_FLOAT,
@@ -162,6 +171,7 @@ const ImFileType IMB_FILE_TYPES[] = {
         .is_a = imb_is_a_openexr,
         .load = imb_load_openexr,
         .load_filepath = NULL,
+        .load_thumbnail = NULL,
         .save = imb_save_openexr,
         .load_tile = NULL,
         .flag = IM_FTYPE_FLOAT,
@@ -176,6 +186,7 @@ const ImFileType IMB_FILE_TYPES[] = {
         .is_a = imb_is_a_jp2,
         .load = imb_load_jp2,
         .load_filepath = NULL,
+        .load_thumbnail = NULL,
         .save = imb_save_jp2,
         .load_tile = NULL,
         .flag = IM_FTYPE_FLOAT,
@@ -190,6 +201,7 @@ const ImFileType IMB_FILE_TYPES[] = {
         .is_a = imb_is_a_dds,
         .load = imb_load_dds,
         .load_filepath = NULL,
+        .load_thumbnail = NULL,
         .save = NULL,
         .load_tile = NULL,
         .flag = 0,
@@ -204,6 +216,7 @@ const ImFileType IMB_FILE_TYPES[] = {
         .is_a = imb_is_a_photoshop,
         .load = NULL,
         .load_filepath = imb_load_photoshop,
+        .load_thumbnail = NULL,
         .save = NULL,
         .load_tile = NULL,
         .flag = IM_FTYPE_FLOAT,
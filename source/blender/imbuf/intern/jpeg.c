@@ -54,7 +54,11 @@ static void skip_input_data(j_decompress_ptr cinfo, long num_bytes);
 static void term_source(j_decompress_ptr cinfo);
 static void memory_source(j_decompress_ptr cinfo, const unsigned char *buffer, size_t size);
 static boolean handle_app1(j_decompress_ptr cinfo);
-static ImBuf *ibJpegImageFromCinfo(struct jpeg_decompress_struct *cinfo, int flags);
+static ImBuf *ibJpegImageFromCinfo(struct jpeg_decompress_struct *cinfo,
+                                   int flags,
+                                   int max_size,
+                                   size_t *r_width,
+                                   size_t *r_height);
 
 static const uchar jpeg_default_quality = 75;
 static uchar ibuf_quality;
@@ -261,7 +265,16 @@ static boolean handle_app1(j_decompress_ptr cinfo)
   return true;
 }
 
-static ImBuf *ibJpegImageFromCinfo(struct jpeg_decompress_struct *cinfo, int flags)
+/**
+ * \param max_size: When not zero, let the decoder downscale the image by a power of two while
+ * keeping it at least this size, which skips most of the decoding work for thumbnails.
+ * \param r_width, r_height: Optionally return the size of the image before downscaling.
+ */
+static ImBuf *ibJpegImageFromCinfo(struct jpeg_decompress_struct *cinfo,
+                                   int flags,
+                                   int max_size,
+                                   size_t *r_width,
+                                   size_t *r_height)
 {
   JSAMPARRAY row_pointer;
   JSAMPLE *buffer = NULL;
@@ -283,17 +296,34 @@ static ImBuf *ibJpegImageFromCinfo(struct jpeg_decompress_struct *cinfo, int fla
     y = cinfo->image_height;
     depth = cinfo->num_components;
 
+    if (r_width) {
+      *r_width = (size_t)x;
+    }
+    if (r_height) {
+      *r_height = (size_t)y;
+    }
+
     if (cinfo->jpeg_color_space == JCS_YCCK) {
       cinfo->out_color_space = JCS_CMYK;
     }
 
+    if (max_size > 0 && (flags & IB_test) == 0) {
+      /* The decoder supports scaling down by 1/2, 1/4 and 1/8. */
+      cinfo->scale_num = 1;
+      cinfo->scale_denom = 1;
+      while (cinfo->scale_denom < 8 && max_ii(x, y) / (int)(cinfo->scale_denom * 2) >= max_size) {
+        cinfo->scale_denom *= 2;
+      }
+    }
+
     jpeg_start_decompress(cinfo);
 
     if (flags & IB_test) {
       jpeg_abort_decompress(cinfo);
       ibuf = IMB_allocImBuf(x, y, 8 * depth, 0);
     }
-    else if ((ibuf = IMB_allocImBuf(x, y, 8 * depth, IB_rect)) == NULL) {
+    else if ((ibuf = IMB_allocImBuf(
+                  cinfo->output_width, cinfo->output_height, 8 * depth, IB_rect)) == NULL) {
       jpeg_abort_decompress(cinfo);
     }
     else {
@@ -464,7 +494,41 @@ ImBuf *imb_load_jpeg(const unsigned char *buffer,
   jpeg_create_decompress(cinfo);
   memory_source(cinfo, buffer, size);
 
-  ibuf = ibJpegImageFromCinfo(cinfo, flags);
+  ibuf = ibJpegImageFromCinfo(cinfo, flags, 0, NULL, NULL);
+
+  return ibuf;
+}
+
+ImBuf *imb_thumbnail_jpeg(const unsigned char *buffer,
+                          size_t size,
+                          int flags,
+                          size_t max_thumb_size,
+                          char colorspace[IM_MAX_SPACE],
+                          size_t *r_width,
+                          size_t *r_height)
+{
+  struct jpeg_decompress_struct _cinfo, *cinfo = &_cinfo;
+  struct my_error_mgr jerr;
+  ImBuf *ibuf;
+
+  if (!imb_is_a_jpeg(buffer, size)) {
+    return NULL;
+  }
+
+  colorspace_set_default_role(colorspace, IM_MAX_SPACE, COLOR_ROLE_DEFAULT_BYTE);
+
+  cinfo->err = jpeg_std_error(&jerr.pub);
+  jerr.pub.error_exit = jpeg_error;
+
+  if (setjmp(jerr.setjmp_buffer)) {
+    jpeg_destroy_decompress(cinfo);
+    return NULL;
+  }
+
+  jpeg_create_decompress(cinfo);
+  memory_source(cinfo, buffer, size);
+
+  ibuf = ibJpegImageFromCinfo(cinfo, flags, (int)max_thumb_size, r_width, r_height);
 
   return ibuf;
 }
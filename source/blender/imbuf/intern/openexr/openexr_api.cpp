@@ -78,6 +78,7 @@ _CRTIMP void __cdecl _invalid_parameter_noinfo(void)
 }
 #include "BLI_blenlib.h"
 #include "BLI_math_color.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_idprop.h"
@@ -1098,6 +1099,52 @@ void IMB_exr_clear_channels(void *handle)
   BLI_freelistN(&data->channels);
 }
 
+struct ExrHalfChannelsData {
+  ExrHandle *handle;
+  /** Half channels in the order of their buffers in #rect_half. */
+  std::vector<const ExrChannel *> channels;
+  half *rect_half;
+};
+
+static void exr_half_channels_convert_row(void *__restrict userdata,
+                                          const int y,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ExrHalfChannelsData *data = (const ExrHalfChannelsData *)userdata;
+  const size_t width = (size_t)data->handle->width;
+  const size_t num_pixels = width * data->handle->height;
+
+  for (size_t i = 0; i < data->channels.size(); i++) {
+    const ExrChannel *echan = data->channels[i];
+    const float *rect = echan->rect + y * width * echan->xstride;
+    half *cur = data->rect_half + i * num_pixels + y * width;
+    for (size_t x = 0; x < width; x++, cur++) {
+      *cur = float_to_half_safe(rect[x * echan->xstride]);
+    }
+  }
+}
+
+/**
+ * Convert all half float channels to their buffers in \a rect_half, in parallel over the
+ * scanlines since large multilayer images can have many passes.
+ */
+static void exr_half_channels_convert(ExrHandle *handle, half *rect_half)
+{
+  ExrHalfChannelsData data;
+  data.handle = handle;
+  data.rect_half = rect_half;
+  LISTBASE_FOREACH (const ExrChannel *, echan, &handle->channels) {
+    if (echan->use_half_float) {
+      data.channels.push_back(echan);
+    }
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 8;
+  BLI_task_parallel_range(0, handle->height, &data, exr_half_channels_convert_row, &settings);
+}
+
 void IMB_exr_write_channels(void *handle)
 {
   ExrHandle *data = (ExrHandle *)handle;
@@ -1113,16 +1160,12 @@ void IMB_exr_write_channels(void *handle)
       rect_half = (half *)MEM_mallocN(sizeof(half) * data->num_half_channels * num_pixels,
                                       __func__);
       current_rect_half = rect_half;
+      exr_half_channels_convert(data, rect_half);
     }
 
     for (echan = (ExrChannel *)data->channels.first; echan; echan = echan->next) {
       /* Writing starts from last scanline, stride negative. */
       if (echan->use_half_float) {
-        float *rect = echan->rect;
-        half *cur = current_rect_half;
-        for (size_t i = 0; i < num_pixels; i++, cur++) {
-          *cur = float_to_half_safe(rect[i * echan->xstride]);
-        }
         half *rect_to_write = current_rect_half + (data->height - 1L) * data->width;
         frameBuffer.insert(
             echan->name,
@@ -1209,6 +1252,66 @@ void IMB_exrtile_write_channels(
   }
 }
 
+/* Read the channels with a rect set of one part, the other channels are not decoded. */
+static void imb_exr_read_part(ExrHandle *data, const int part, const bool flip)
+{
+  InputPart in(*data->ifile, part);
+  Header header = in.header();
+  Box2i dw = header.dataWindow();
+
+  /* Insert all matching channel into framebuffer. */
+  FrameBuffer frameBuffer;
+  ExrChannel *echan;
+  bool has_channels = false;
+
+  for (echan = (ExrChannel *)data->channels.first; echan; echan = echan->next) {
+    if (echan->m->part_number != part || echan->rect == nullptr) {
+      continue;
+    }
+
+    exr_printf("%d %-6s %-22s \"%s\"\n",
+               echan->m->part_number,
+               echan->m->view.c_str(),
+               echan->m->name.c_str(),
+               echan->m->internal_name.c_str());
+
+    float *rect = echan->rect;
+    size_t xstride = echan->xstride * sizeof(float);
+    size_t ystride = echan->ystride * sizeof(float);
+
+    if (!flip) {
+      /* Inverse correct first pixel for data-window coordinates. */
+      rect -= echan->xstride * (dw.min.x - dw.min.y * data->width);
+      /* move to last scanline to flip to Blender convention */
+      rect += echan->xstride * (data->height - 1) * data->width;
+      ystride = -ystride;
+    }
+    else {
+      /* Inverse correct first pixel for data-window coordinates. */
+      rect -= echan->xstride * (dw.min.x + dw.min.y * data->width);
+    }
+
+    frameBuffer.insert(echan->m->internal_name, Slice(Imf::FLOAT, (char *)rect, xstride, ystride));
+    has_channels = true;
+  }
+
+  /* Parts without any channel to read are skipped, so they are not decompressed. */
+  if (!has_channels) {
+    return;
+  }
+
+  /* Read pixels. */
+  try {
+    in.setFrameBuffer(frameBuffer);
+    exr_printf("readPixels:readPixels[%d]: min.y: %d, max.y: %d\n", part, dw.min.y, dw.max.y);
+    in.readPixels(dw.min.y, dw.max.y);
+  }
+  catch (const std::exception &exc) {
+    std::cerr << "OpenEXR-readPixels: ERROR: " << exc.what() << std::endl;
+  }
+}
+
+/* Only channels with a rect set are read, see IMB_exr_set_channel. */
 void IMB_exr_read_channels(void *handle)
 {
   ExrHandle *data = (ExrHandle *)handle;
@@ -1229,62 +1332,10 @@ void IMB_exr_read_channels(void *handle)
       "name",
       "internal_name");
 
+  /* The scanline blocks of a part are decoded in parallel by the OpenEXR thread pool, see
+   * imb_initopenexr. Parts can't be read in parallel, they share the locked input stream. */
   for (int i = 0; i < numparts; i++) {
-    /* Read part header. */
-    InputPart in(*data->ifile, i);
-    Header header = in.header();
-    Box2i dw = header.dataWindow();
-
-    /* Insert all matching channel into framebuffer. */
-    FrameBuffer frameBuffer;
-    ExrChannel *echan;
-
-    for (echan = (ExrChannel *)data->channels.first; echan; echan = echan->next) {
-      if (echan->m->part_number != i) {
-        continue;
-      }
-
-      exr_printf("%d %-6s %-22s \"%s\"\n",
-                 echan->m->part_number,
-                 echan->m->view.c_str(),
-                 echan->m->name.c_str(),
-                 echan->m->internal_name.c_str());
-
-      if (echan->rect) {
-        float *rect = echan->rect;
-        size_t xstride = echan->xstride * sizeof(float);
-        size_t ystride = echan->ystride * sizeof(float);
-
-        if (!flip) {
-          /* Inverse correct first pixel for data-window coordinates. */
-          rect -= echan->xstride * (dw.min.x - dw.min.y * data->width);
-          /* move to last scanline to flip to Blender convention */
-          rect += echan->xstride * (data->height - 1) * data->width;
-          ystride = -ystride;
-        }
-        else {
-          /* Inverse correct first pixel for data-window coordinates. */
-          rect -= echan->xstride * (dw.min.x + dw.min.y * data->width);
-        }
-
-        frameBuffer.insert(echan->m->internal_name,
-                           Slice(Imf::FLOAT, (char *)rect, xstride, ystride));
-      }
-      else {
-        printf("warning, channel with no rect set %s\n", echan->m->internal_name.c_str());
-      }
-    }
-
-    /* Read pixels. */
-    try {
-      in.setFrameBuffer(frameBuffer);
-      exr_printf("readPixels:readPixels[%d]: min.y: %d, max.y: %d\n", i, dw.min.y, dw.max.y);
-      in.readPixels(dw.min.y, dw.max.y);
-    }
-    catch (const std::exception &exc) {
-      std::cerr << "OpenEXR-readPixels: ERROR: " << exc.what() << std::endl;
-      break;
-    }
+    imb_exr_read_part(data, i, flip);
   }
 }
 
@@ -1529,10 +1580,12 @@ static ExrPass *imb_exr_get_pass(ListBase *lb, char *passname)
 }
 
 /* creates channels, makes a hierarchy and assigns memory to channels */
+/* When alloc_passes is false the passes are created without a rect, so nothing is read. */
 static ExrHandle *imb_exr_begin_read_mem(IStream &file_stream,
                                          MultiPartInputFile &file,
                                          int width,
-                                         int height)
+                                         int height,
+                                         const bool alloc_passes)
 {
   ExrLayer *lay;
   ExrPass *pass;
@@ -1603,8 +1656,10 @@ static ExrHandle *imb_exr_begin_read_mem(IStream &file_stream,
   for (lay = (ExrLayer *)data->layers.first; lay; lay = lay->next) {
     for (pass = (ExrPass *)lay->passes.first; pass; pass = pass->next) {
       if (pass->totchan) {
-        pass->rect = (float *)MEM_callocN(width * height * pass->totchan * sizeof(float),
-                                          "pass rect");
+        if (alloc_passes) {
+          pass->rect = (float *)MEM_callocN(width * height * pass->totchan * sizeof(float),
+                                            "pass rect");
+        }
         if (pass->totchan == 1) {
           echan = pass->chan[0];
           echan->rect = pass->rect;
@@ -1640,7 +1695,8 @@ static ExrHandle *imb_exr_begin_read_mem(IStream &file_stream,
             }
             for (a = 0; a < pass->totchan; a++) {
               echan = pass->chan[a];
-              echan->rect = pass->rect + lookup[(unsigned int)echan->chan_id];
+              echan->rect = pass->rect ? pass->rect + lookup[(unsigned int)echan->chan_id] :
+                                         nullptr;
               echan->xstride = pass->totchan;
               echan->ystride = width * pass->totchan;
               pass->chan_id[(unsigned int)lookup[(unsigned int)echan->chan_id]] = echan->chan_id;
@@ -1649,7 +1705,7 @@ static ExrHandle *imb_exr_begin_read_mem(IStream &file_stream,
           else { /* unknown */
             for (a = 0; a < pass->totchan; a++) {
               echan = pass->chan[a];
-              echan->rect = pass->rect + a;
+              echan->rect = pass->rect ? pass->rect + a : nullptr;
               echan->xstride = pass->totchan;
               echan->ystride = width * pass->totchan;
               pass->chan_id[a] = echan->chan_id;
@@ -1971,10 +2027,13 @@ struct ImBuf *imb_load_openexr(const unsigned char *mem,
 
         /* Only enters with IB_multilayer flag set. */
         if (is_multi && ((flags & IB_thumbnail) == 0)) {
-          /* constructs channels for reading, allocates memory in channels */
-          ExrHandle *handle = imb_exr_begin_read_mem(*membuf, *file, width, height);
+          /* constructs channels for reading, allocates memory in channels unless deferred */
+          const bool deferred = (flags & IB_multilayer_deferred) != 0;
+          ExrHandle *handle = imb_exr_begin_read_mem(*membuf, *file, width, height, !deferred);
           if (handle) {
-            IMB_exr_read_channels(handle);
+            if (!deferred) {
+              IMB_exr_read_channels(handle);
+            }
             ibuf->userdata = handle; /* potential danger, the caller has to check for this! */
           }
         }
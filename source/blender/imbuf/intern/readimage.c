@@ -251,6 +251,69 @@ ImBuf *IMB_loadiffname(const char *filepath, int flags, char colorspace[IM_MAX_S
   return ibuf;
 }
 
+ImBuf *IMB_thumb_load_image(const char *filepath,
+                            size_t max_thumb_size,
+                            char colorspace[IM_MAX_SPACE],
+                            size_t *r_width,
+                            size_t *r_height)
+{
+  const int flags = IB_rect | IB_metadata;
+  ImBuf *ibuf = NULL;
+
+  BLI_assert(!BLI_path_is_rel(filepath));
+
+  const ImFileType *type = IMB_file_type_from_ftype(IMB_ispic_type(filepath));
+  if (type != NULL && type->load_thumbnail != NULL && !imb_is_filepath_format(filepath)) {
+    const int file = BLI_open(filepath, O_BINARY | O_RDONLY, 0);
+    if (file == -1) {
+      return NULL;
+    }
+
+    const size_t size = BLI_file_descriptor_size(file);
+    imb_mmap_lock();
+    BLI_mmap_file *mmap_file = BLI_mmap_open(file);
+    imb_mmap_unlock();
+
+    if (mmap_file != NULL) {
+      char effective_colorspace[IM_MAX_SPACE] = "";
+      if (colorspace) {
+        BLI_strncpy(effective_colorspace, colorspace, sizeof(effective_colorspace));
+      }
+
+      ibuf = type->load_thumbnail(BLI_mmap_get_pointer(mmap_file),
+                                  size,
+                                  flags,
+                                  max_thumb_size,
+                                  effective_colorspace,
+                                  r_width,
+                                  r_height);
+      if (ibuf) {
+        imb_handle_alpha(ibuf, flags, colorspace, effective_colorspace);
+      }
+
+      imb_mmap_lock();
+      BLI_mmap_free(mmap_file);
+      imb_mmap_unlock();
+    }
+
+    close(file);
+
+    if (ibuf) {
+      BLI_strncpy(ibuf->name, filepath, sizeof(ibuf->name));
+      return ibuf;
+    }
+  }
+
+  /* Fall back to loading the full image for formats which can't load a reduced size. */
+  ibuf = IMB_loadiffname(filepath, flags, colorspace);
+  if (ibuf) {
+    *r_width = (size_t)ibuf->x;
+    *r_height = (size_t)ibuf->y;
+  }
+
+  return ibuf;
+}
+
 ImBuf *IMB_testiffname(const char *filepath, int flags)
 {
   ImBuf *ibuf;
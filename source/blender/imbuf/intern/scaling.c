@@ -23,7 +23,9 @@
  */
 
 #include <math.h>
+#include <string.h>
 
+#include "BLI_math_base.h"
 #include "BLI_math_color.h"
 #include "BLI_math_interp.h"
 #include "BLI_utildefines.h"
@@ -1762,12 +1764,76 @@ bool IMB_scalefastImBuf(struct ImBuf *ibuf, unsigned int newx, unsigned int newy
 
 /* ******** threaded scaling ******** */
 
+/* Separable resampling with a triangle filter: bilinear interpolation when scaling up, widened
+ * to cover all source pixels of a destination pixel when scaling down so there is no aliasing.
+ * Filter taps are computed once per axis, rows are filtered horizontally into a float buffer
+ * and then vertically, both with plain loops over contiguous memory that vectorize well. */
+
+typedef struct ScaleFilter {
+  /* First source pixel and number of source pixels for every destination pixel. */
+  int *first;
+  int *len;
+  /* `taps_max` weights for every destination pixel. */
+  float *weights;
+  int taps_max;
+} ScaleFilter;
+
+static void scale_filter_init(ScaleFilter *filter, int src_len, int dst_len)
+{
+  const float scale = (float)src_len / dst_len;
+  const float support = max_ff(scale, 1.0f);
+
+  filter->taps_max = (int)ceilf(support) * 2 + 1;
+  filter->first = MEM_mallocN(sizeof(int) * dst_len, __func__);
+  filter->len = MEM_mallocN(sizeof(int) * dst_len, __func__);
+  filter->weights = MEM_callocN(sizeof(float) * dst_len * filter->taps_max, __func__);
+
+  for (int i = 0; i < dst_len; i++) {
+    /* Map pixel centers. */
+    const float center = (i + 0.5f) * scale - 0.5f;
+    const int first = max_ii((int)floorf(center - support) + 1, 0);
+    const int last = min_ii((int)ceilf(center + support) - 1, src_len - 1);
+    float *weights = filter->weights + (size_t)i * filter->taps_max;
+    float weight_sum = 0.0f;
+    int len = 0;
+
+    for (int j = first; j <= last && len < filter->taps_max; j++, len++) {
+      weights[len] = max_ff(1.0f - fabsf(j - center) / support, 0.0f);
+      weight_sum += weights[len];
+    }
+
+    if (weight_sum > 0.0f) {
+      for (int j = 0; j < len; j++) {
+        weights[j] /= weight_sum;
+      }
+    }
+    else {
+      /* Only happens for the edges when scaling up, use the nearest pixel. */
+      len = 1;
+      weights[0] = 1.0f;
+    }
+
+    filter->first[i] = (last < first) ? clamp_i((int)(center + 0.5f), 0, src_len - 1) : first;
+    filter->len[i] = len;
+  }
+}
+
+static void scale_filter_free(ScaleFilter *filter)
+{
+  MEM_freeN(filter->first);
+  MEM_freeN(filter->len);
+  MEM_freeN(filter->weights);
+}
+
 typedef struct ScaleTreadInitData {
   ImBuf *ibuf;
 
   unsigned int newx;
   unsigned int newy;
 
+  const ScaleFilter *filter_x;
+  const ScaleFilter *filter_y;
+
   unsigned char *byte_buffer;
   float *float_buffer;
 } ScaleTreadInitData;
@@ -1778,6 +1844,9 @@ typedef struct ScaleThreadData {
   unsigned int newx;
   unsigned int newy;
 
+  const ScaleFilter *filter_x;
+  const ScaleFilter *filter_y;
+
   int start_line;
   int tot_line;
 
@@ -1795,6 +1864,9 @@ static void scale_thread_init(void *data_v, int start_line, int tot_line, void *
   data->newx = init_data->newx;
   data->newy = init_data->newy;
 
+  data->filter_x = init_data->filter_x;
+  data->filter_y = init_data->filter_y;
+
   data->start_line = start_line;
   data->tot_line = tot_line;
 
@@ -1802,36 +1874,125 @@ static void scale_thread_init(void *data_v, int start_line, int tot_line, void *
   data->float_buffer = init_data->float_buffer;
 }
 
-static void *do_scale_thread(void *data_v)
+/* Filter source rows horizontally into `rows`, which are `newx * channels` floats each. */
+static void scale_rows_x(const ScaleFilter *filter_x,
+                         const unsigned char *src_byte,
+                         const float *src_float,
+                         int src_x,
+                         int channels,
+                         int row_first,
+                         int rows_len,
+                         int newx,
+                         float *rows)
 {
-  ScaleThreadData *data = (ScaleThreadData *)data_v;
-  ImBuf *ibuf = data->ibuf;
-  int i;
-  float factor_x = (float)ibuf->x / data->newx;
-  float factor_y = (float)ibuf->y / data->newy;
-
-  for (i = 0; i < data->tot_line; i++) {
-    int y = data->start_line + i;
-    int x;
-
-    for (x = 0; x < data->newx; x++) {
-      float u = (float)x * factor_x;
-      float v = (float)y * factor_y;
-      int offset = y * data->newx + x;
-
-      if (data->byte_buffer) {
-        unsigned char *pixel = data->byte_buffer + 4 * offset;
-        BLI_bilinear_interpolation_char(
-            (unsigned char *)ibuf->rect, pixel, ibuf->x, ibuf->y, 4, u, v);
+  float *out = rows;
+
+  for (int row = row_first; row < row_first + rows_len; row++) {
+    const size_t row_offset = (size_t)row * src_x * channels;
+
+    for (int x = 0; x < newx; x++, out += channels) {
+      const float *weights = filter_x->weights + (size_t)x * filter_x->taps_max;
+      const int first = filter_x->first[x];
+      const int len = filter_x->len[x];
+      float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+      if (src_byte) {
+        const unsigned char *in = src_byte + row_offset + (size_t)first * channels;
+        for (int i = 0; i < len; i++, in += channels) {
+          for (int c = 0; c < channels; c++) {
+            sum[c] += weights[i] * in[c];
+          }
+        }
+      }
+      else {
+        const float *in = src_float + row_offset + (size_t)first * channels;
+        for (int i = 0; i < len; i++, in += channels) {
+          for (int c = 0; c < channels; c++) {
+            sum[c] += weights[i] * in[c];
+          }
+        }
       }
 
-      if (data->float_buffer) {
-        float *pixel = data->float_buffer + ibuf->channels * offset;
-        BLI_bilinear_interpolation_fl(
-            ibuf->rect_float, pixel, ibuf->x, ibuf->y, ibuf->channels, u, v);
+      for (int c = 0; c < channels; c++) {
+        out[c] = sum[c];
       }
     }
   }
+}
+
+static void scale_buffer_lines(ScaleThreadData *data,
+                               const unsigned char *src_byte,
+                               const float *src_float,
+                               int channels,
+                               unsigned char *dst_byte,
+                               float *dst_float)
+{
+  const ImBuf *ibuf = data->ibuf;
+  const ScaleFilter *filter_y = data->filter_y;
+  const int newx = data->newx;
+  const size_t row_len = (size_t)newx * channels;
+
+  /* Source rows needed for the destination lines of this thread. */
+  const int line_last = data->start_line + data->tot_line - 1;
+  const int row_first = filter_y->first[data->start_line];
+  const int row_last = filter_y->first[line_last] + filter_y->len[line_last] - 1;
+  const int rows_len = row_last - row_first + 1;
+
+  float *rows = MEM_mallocN(sizeof(float) * row_len * rows_len, "scale rows");
+  float *line = MEM_mallocN(sizeof(float) * row_len, "scale line");
+
+  scale_rows_x(data->filter_x,
+               src_byte,
+               src_float,
+               ibuf->x,
+               channels,
+               row_first,
+               rows_len,
+               newx,
+               rows);
+
+  for (int y = data->start_line; y <= line_last; y++) {
+    const float *weights = filter_y->weights + (size_t)y * filter_y->taps_max;
+    const float *row = rows + (size_t)(filter_y->first[y] - row_first) * row_len;
+
+    for (size_t i = 0; i < row_len; i++) {
+      line[i] = weights[0] * row[i];
+    }
+    for (int tap = 1; tap < filter_y->len[y]; tap++) {
+      row += row_len;
+      for (size_t i = 0; i < row_len; i++) {
+        line[i] += weights[tap] * row[i];
+      }
+    }
+
+    if (dst_byte) {
+      unsigned char *out = dst_byte + (size_t)y * row_len;
+      for (size_t i = 0; i < row_len; i++) {
+        out[i] = (unsigned char)clamp_i((int)(line[i] + 0.5f), 0, 255);
+      }
+    }
+    else {
+      memcpy(dst_float + (size_t)y * row_len, line, sizeof(float) * row_len);
+    }
+  }
+
+  MEM_freeN(line);
+  MEM_freeN(rows);
+}
+
+static void *do_scale_thread(void *data_v)
+{
+  ScaleThreadData *data = (ScaleThreadData *)data_v;
+  ImBuf *ibuf = data->ibuf;
+
+  if (data->byte_buffer) {
+    scale_buffer_lines(data, (unsigned char *)ibuf->rect, NULL, 4, data->byte_buffer, NULL);
+  }
+
+  if (data->float_buffer) {
+    scale_buffer_lines(
+        data, NULL, ibuf->rect_float, ibuf->channels, NULL, data->float_buffer);
+  }
 
   return NULL;
 }
@@ -1839,6 +2000,21 @@ static void *do_scale_thread(void *data_v)
 void IMB_scaleImBuf_threaded(ImBuf *ibuf, unsigned int newx, unsigned int newy)
 {
   ScaleTreadInitData init_data = {NULL};
+  ScaleFilter filter_x, filter_y;
+
+  if (ibuf->rect == NULL && ibuf->rect_float == NULL) {
+    return;
+  }
+
+  if (newx == 0 || newy == 0 || (newx == ibuf->x && newy == ibuf->y)) {
+    return;
+  }
+
+  /* Filtered channels are accumulated in a 4 component array. */
+  BLI_assert(ibuf->rect_float == NULL || ibuf->channels <= 4);
+
+  scale_filter_init(&filter_x, ibuf->x, newx);
+  scale_filter_init(&filter_y, ibuf->y, newy);
 
   /* prepare initialization data */
   init_data.ibuf = ibuf;
@@ -1846,6 +2022,9 @@ void IMB_scaleImBuf_threaded(ImBuf *ibuf, unsigned int newx, unsigned int newy)
   init_data.newx = newx;
   init_data.newy = newy;
 
+  init_data.filter_x = &filter_x;
+  init_data.filter_y = &filter_y;
+
   if (ibuf->rect) {
     init_data.byte_buffer = MEM_mallocN(4 * newx * newy * sizeof(char),
                                         "threaded scale byte buffer");
@@ -1860,6 +2039,9 @@ void IMB_scaleImBuf_threaded(ImBuf *ibuf, unsigned int newx, unsigned int newy)
   IMB_processor_apply_threaded(
       newy, sizeof(ScaleThreadData), &init_data, scale_thread_init, do_scale_thread);
 
+  scale_filter_free(&filter_x);
+  scale_filter_free(&filter_y);
+
   /* alter image buffer */
   ibuf->x = newx;
   ibuf->y = newy;
@@ -340,6 +340,7 @@ static ImBuf *thumb_create_ex(const char *file_path,
   short tsize = 128;
   short ex, ey;
   float scaledx, scaledy;
+  size_t img_width = 0, img_height = 0;
   BLI_stat_t info;
 
   switch (size) {
@@ -384,7 +385,7 @@ static ImBuf *thumb_create_ex(const char *file_path,
         if (img == NULL) {
           switch (source) {
             case THB_SOURCE_IMAGE:
-              img = IMB_loadiffname(file_path, IB_rect | IB_metadata, NULL);
+              img = IMB_thumb_load_image(file_path, tsize, NULL, &img_width, &img_height);
               break;
             case THB_SOURCE_BLEND:
               img = IMB_thumb_load_blend(file_path, blen_group, blen_id);
@@ -401,8 +402,13 @@ static ImBuf *thumb_create_ex(const char *file_path,
           if (BLI_stat(file_path, &info) != -1) {
             BLI_snprintf(mtime, sizeof(mtime), "%ld", (long int)info.st_mtime);
           }
-          BLI_snprintf(cwidth, sizeof(cwidth), "%d", img->x);
-          BLI_snprintf(cheight, sizeof(cheight), "%d", img->y);
+          /* The image may have been loaded at a reduced size. */
+          if (img_width == 0) {
+            img_width = (size_t)img->x;
+            img_height = (size_t)img->y;
+          }
+          BLI_snprintf(cwidth, sizeof(cwidth), "%d", (int)img_width);
+          BLI_snprintf(cheight, sizeof(cheight), "%d", (int)img_height);
         }
       }
       else if (THB_SOURCE_MOVIE == source) {
@@ -132,6 +132,7 @@ static void export_startjob(void *customdata,
   }
 
   ABCHierarchyIterator iter(data->depsgraph, abc_archive.get(), data->params);
+  iter.set_collect_writer_timings(G.debug & G_DEBUG_IO);
 
   if (export_animation) {
     CLOG_INFO(&LOG, 2, "Exporting animation");
@@ -167,6 +168,9 @@ static void export_startjob(void *customdata,
     iter.iterate_and_write();
   }
 
+  if (G.debug & G_DEBUG_IO) {
+    iter.print_writer_timings();
+  }
   iter.release_writers();
 
   /* Finish up by going back to the keyframe that was current before we started. */
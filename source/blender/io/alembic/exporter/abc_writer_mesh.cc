@@ -24,6 +24,7 @@
 
 #include "BLI_assert.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 
 #include "BKE_customdata.h"
 #include "BKE_lib_id.h"
@@ -393,12 +394,13 @@ void ABCGenericMeshWriter::get_velocities(struct Mesh *mesh, std::vector<Imath::
   FluidsimSettings *fss = fmd->fss;
 
   if (fss->meshVelocities) {
-    float *mesh_vels = reinterpret_cast<float *>(fss->meshVelocities);
+    const float(*mesh_vels)[3] = reinterpret_cast<float(*)[3]>(fss->meshVelocities);
 
-    for (int i = 0; i < totverts; i++) {
-      copy_yup_from_zup(vels[i].getValue(), mesh_vels);
-      mesh_vels += 3;
-    }
+    parallel_for(IndexRange(totverts), 4096, [&](IndexRange range) {
+      for (const int i : range) {
+        copy_yup_from_zup(vels[i].getValue(), mesh_vels[i]);
+      }
+    });
   }
   else {
     std::fill(vels.begin(), vels.end(), Imath::V3f(0.0f));
@@ -454,10 +456,28 @@ static void get_vertices(struct Mesh *mesh, std::vector<Imath::V3f> &points)
   points.clear();
   points.resize(mesh->totvert);
 
-  MVert *verts = mesh->mvert;
+  const MVert *verts = mesh->mvert;
+
+  parallel_for(IndexRange(mesh->totvert), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      copy_yup_from_zup(points[i].getValue(), verts[i].co);
+    }
+  });
+}
+
+/**
+ * Offset of the first loop of every polygon in the exported face-varying arrays. These match
+ * #MPoly.loopstart for most meshes, but Blender doesn't require polygons to be stored in loop
+ * order. Knowing the offsets up front allows filling the arrays in parallel.
+ */
+static void get_poly_offsets(const struct Mesh *mesh, std::vector<int> &r_poly_offsets)
+{
+  r_poly_offsets.resize(mesh->totpoly);
 
-  for (int i = 0, e = mesh->totvert; i < e; i++) {
-    copy_yup_from_zup(points[i].getValue(), verts[i].co);
+  int offset = 0;
+  for (int i = 0, e = mesh->totpoly; i < e; i++) {
+    r_poly_offsets[i] = offset;
+    offset += mesh->mpoly[i].totloop;
   }
 }
 
@@ -468,28 +488,37 @@ static void get_topology(struct Mesh *mesh,
 {
   const int num_poly = mesh->totpoly;
   const int num_loops = mesh->totloop;
-  MLoop *mloop = mesh->mloop;
-  MPoly *mpoly = mesh->mpoly;
+  const MLoop *mloop = mesh->mloop;
+  const MPoly *mpoly = mesh->mpoly;
   r_has_flat_shaded_poly = false;
 
   poly_verts.clear();
   loop_counts.clear();
-  poly_verts.reserve(num_loops);
-  loop_counts.reserve(num_poly);
+  poly_verts.resize(num_loops);
+  loop_counts.resize(num_poly);
+
+  std::vector<int> poly_offsets;
+  get_poly_offsets(mesh, poly_offsets);
 
-  /* NOTE: data needs to be written in the reverse order. */
   for (int i = 0; i < num_poly; i++) {
-    MPoly &poly = mpoly[i];
-    loop_counts.push_back(poly.totloop);
+    const MPoly &poly = mpoly[i];
+    loop_counts[i] = poly.totloop;
 
     r_has_flat_shaded_poly |= (poly.flag & ME_SMOOTH) == 0;
+  }
 
-    MLoop *loop = mloop + poly.loopstart + (poly.totloop - 1);
-
-    for (int j = 0; j < poly.totloop; j++, loop--) {
-      poly_verts.push_back(loop->v);
+  /* NOTE: data needs to be written in the reverse order. */
+  parallel_for(IndexRange(num_poly), 1024, [&](IndexRange range) {
+    for (const int i : range) {
+      const MPoly &poly = mpoly[i];
+      const MLoop *loop = mloop + poly.loopstart + (poly.totloop - 1);
+      int32_t *poly_verts_iter = poly_verts.data() + poly_offsets[i];
+
+      for (int j = 0; j < poly.totloop; j++, loop--) {
+        poly_verts_iter[j] = loop->v;
+      }
     }
-  }
+  });
 }
 
 static void get_creases(struct Mesh *mesh,
@@ -537,15 +566,21 @@ static void get_loop_normals(struct Mesh *mesh,
 
   normals.resize(mesh->totloop);
 
+  std::vector<int> poly_offsets;
+  get_poly_offsets(mesh, poly_offsets);
+
   /* NOTE: data needs to be written in the reverse order. */
-  int abc_index = 0;
-  MPoly *mp = mesh->mpoly;
-  for (int i = 0, e = mesh->totpoly; i < e; i++, mp++) {
-    for (int j = mp->totloop - 1; j >= 0; j--, abc_index++) {
-      int blender_index = mp->loopstart + j;
-      copy_yup_from_zup(normals[abc_index].getValue(), lnors[blender_index]);
+  const MPoly *mpoly = mesh->mpoly;
+  parallel_for(IndexRange(mesh->totpoly), 1024, [&](IndexRange range) {
+    for (const int i : range) {
+      const MPoly *mp = &mpoly[i];
+      int abc_index = poly_offsets[i];
+      for (int j = mp->totloop - 1; j >= 0; j--, abc_index++) {
+        int blender_index = mp->loopstart + j;
+        copy_yup_from_zup(normals[abc_index].getValue(), lnors[blender_index]);
+      }
     }
-  }
+  });
 }
 
 ABCMeshWriter::ABCMeshWriter(const ABCWriterConstructorArgs &args) : ABCGenericMeshWriter(args)
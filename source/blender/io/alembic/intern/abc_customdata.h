@@ -67,6 +67,9 @@ struct CDStreamConfig {
   float weight;
   float time;
   bool use_vertex_interpolation;
+  /* The polygons, loops and UVs of the mesh already match the sample, only vertex data and
+   * normals have to be read. */
+  bool use_existing_topology;
   Alembic::AbcGeom::index_t index;
   Alembic::AbcGeom::index_t ceil_index;
 
@@ -89,6 +92,7 @@ struct CDStreamConfig {
         add_customdata_cb(NULL),
         weight(0.0f),
         time(0.0f),
+        use_existing_topology(false),
         index(0),
         ceil_index(0),
         modifier_error_message(NULL)
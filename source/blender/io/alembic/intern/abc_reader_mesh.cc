@@ -24,6 +24,7 @@
 #include "abc_util.h"
 
 #include <algorithm>
+#include <atomic>
 
 #include "MEM_guardedalloc.h"
 
@@ -35,7 +36,9 @@
 #include "BLI_compiler_compat.h"
 #include "BLI_listbase.h"
 #include "BLI_math_geom.h"
+#include "BLI_task.hh"
 
+#include "BKE_customdata.h"
 #include "BKE_main.h"
 #include "BKE_material.h"
 #include "BKE_mesh.h"
@@ -130,17 +133,19 @@ static void read_mverts_interp(MVert *mverts,
                                const P3fArraySamplePtr &ceil_positions,
                                const float weight)
 {
-  float tmp[3];
-  for (int i = 0; i < positions->size(); i++) {
-    MVert &mvert = mverts[i];
-    const Imath::V3f &floor_pos = (*positions)[i];
-    const Imath::V3f &ceil_pos = (*ceil_positions)[i];
+  parallel_for(IndexRange(positions->size()), 4096, [&](IndexRange range) {
+    float tmp[3];
+    for (const int i : range) {
+      MVert &mvert = mverts[i];
+      const Imath::V3f &floor_pos = (*positions)[i];
+      const Imath::V3f &ceil_pos = (*ceil_positions)[i];
 
-    interp_v3_v3v3(tmp, floor_pos.getValue(), ceil_pos.getValue(), weight);
-    copy_zup_from_yup(mvert.co, tmp);
+      interp_v3_v3v3(tmp, floor_pos.getValue(), ceil_pos.getValue(), weight);
+      copy_zup_from_yup(mvert.co, tmp);
 
-    mvert.bweight = 0;
-  }
+      mvert.bweight = 0;
+    }
+  });
 }
 
 static void read_mverts(CDStreamConfig &config, const AbcMeshData &mesh_data)
@@ -160,23 +165,25 @@ static void read_mverts(CDStreamConfig &config, const AbcMeshData &mesh_data)
 
 void read_mverts(MVert *mverts, const P3fArraySamplePtr positions, const N3fArraySamplePtr normals)
 {
-  for (int i = 0; i < positions->size(); i++) {
-    MVert &mvert = mverts[i];
-    Imath::V3f pos_in = (*positions)[i];
+  parallel_for(IndexRange(positions->size()), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      MVert &mvert = mverts[i];
+      Imath::V3f pos_in = (*positions)[i];
 
-    copy_zup_from_yup(mvert.co, pos_in.getValue());
+      copy_zup_from_yup(mvert.co, pos_in.getValue());
 
-    mvert.bweight = 0;
+      mvert.bweight = 0;
 
-    if (normals) {
-      Imath::V3f nor_in = (*normals)[i];
+      if (normals) {
+        Imath::V3f nor_in = (*normals)[i];
 
-      short no[3];
-      normal_float_to_short_v3(no, nor_in.getValue());
+        short no[3];
+        normal_float_to_short_v3(no, nor_in.getValue());
 
-      copy_zup_from_yup(mvert.no, no);
+        copy_zup_from_yup(mvert.no, no);
+      }
     }
-  }
+  });
 }
 
 static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
@@ -195,10 +202,9 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
   const bool do_uvs = (mloopuvs && uvs && uvs_indices) &&
                       (uvs_indices->size() == face_indices->size());
   unsigned int loop_index = 0;
-  unsigned int rev_loop_index = 0;
-  unsigned int uv_index = 0;
-  bool seen_invalid_geometry = false;
+  std::atomic<bool> seen_invalid_geometry = false;
 
+  /* The loop offsets depend on all previous faces, so they are computed first. */
   for (int i = 0; i < face_counts->size(); i++) {
     const int face_size = (*face_counts)[i];
 
@@ -210,36 +216,44 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
      * this is encoded in custom loop normals. See T71246. */
     poly.flag |= ME_SMOOTH;
 
-    /* NOTE: Alembic data is stored in the reverse order. */
-    rev_loop_index = loop_index + (face_size - 1);
+    loop_index += face_size;
+  }
 
-    uint last_vertex_index = 0;
-    for (int f = 0; f < face_size; f++, loop_index++, rev_loop_index--) {
-      MLoop &loop = mloops[rev_loop_index];
-      loop.v = (*face_indices)[loop_index];
+  parallel_for(IndexRange(face_counts->size()), 1024, [&](IndexRange range) {
+    for (const int i : range) {
+      const MPoly &poly = mpolys[i];
+      unsigned int face_loop_index = poly.loopstart;
+      /* NOTE: Alembic data is stored in the reverse order. */
+      unsigned int rev_loop_index = face_loop_index + (poly.totloop - 1);
 
-      if (f > 0 && loop.v == last_vertex_index) {
-        /* This face is invalid, as it has consecutive loops from the same vertex. This is caused
-         * by invalid geometry in the Alembic file, such as in T76514. */
-        seen_invalid_geometry = true;
-      }
-      last_vertex_index = loop.v;
+      uint last_vertex_index = 0;
+      for (int f = 0; f < poly.totloop; f++, face_loop_index++, rev_loop_index--) {
+        MLoop &loop = mloops[rev_loop_index];
+        loop.v = (*face_indices)[face_loop_index];
 
-      if (do_uvs) {
-        MLoopUV &loopuv = mloopuvs[rev_loop_index];
+        if (f > 0 && loop.v == last_vertex_index) {
+          /* This face is invalid, as it has consecutive loops from the same vertex. This is
+           * caused by invalid geometry in the Alembic file, such as in T76514. */
+          seen_invalid_geometry = true;
+        }
+        last_vertex_index = loop.v;
 
-        uv_index = (*uvs_indices)[loop_index];
+        if (do_uvs) {
+          MLoopUV &loopuv = mloopuvs[rev_loop_index];
 
-        /* Some Alembic files are broken (or at least export UVs in a way we don't expect). */
-        if (uv_index >= uvs_size) {
-          continue;
-        }
+          const unsigned int uv_index = (*uvs_indices)[face_loop_index];
+
+          /* Some Alembic files are broken (or at least export UVs in a way we don't expect). */
+          if (uv_index >= uvs_size) {
+            continue;
+          }
 
-        loopuv.uv[0] = (*uvs)[uv_index][0];
-        loopuv.uv[1] = (*uvs)[uv_index][1];
+          loopuv.uv[0] = (*uvs)[uv_index][0];
+          loopuv.uv[1] = (*uvs)[uv_index][1];
+        }
       }
     }
-  }
+  });
 
   BKE_mesh_calc_edges(config.mesh, false, false);
   if (seen_invalid_geometry) {
@@ -278,16 +292,21 @@ static void process_loop_normals(CDStreamConfig &config, const N3fArraySamplePtr
   float(*lnors)[3] = static_cast<float(*)[3]>(
       MEM_malloc_arrayN(loop_count, sizeof(float[3]), "ABC::FaceNormals"));
 
-  MPoly *mpoly = mesh->mpoly;
+  const MPoly *mpoly = mesh->mpoly;
   const N3fArraySample &loop_normals = *loop_normals_ptr;
-  int abc_index = 0;
-  for (int i = 0, e = mesh->totpoly; i < e; i++, mpoly++) {
-    /* As usual, ABC orders the loops in reverse. */
-    for (int j = mpoly->totloop - 1; j >= 0; j--, abc_index++) {
-      int blender_index = mpoly->loopstart + j;
-      copy_zup_from_yup(lnors[blender_index], loop_normals[abc_index].getValue());
+  /* Polygons read from Alembic are stored in loop order (see #read_mpolys), so the Alembic index
+   * of the first loop of a polygon is its loop start. */
+  parallel_for(IndexRange(mesh->totpoly), 1024, [&](IndexRange range) {
+    for (const int i : range) {
+      const MPoly &poly = mpoly[i];
+      int abc_index = poly.loopstart;
+      /* As usual, ABC orders the loops in reverse. */
+      for (int j = poly.totloop - 1; j >= 0; j--, abc_index++) {
+        int blender_index = poly.loopstart + j;
+        copy_zup_from_yup(lnors[blender_index], loop_normals[abc_index].getValue());
+      }
     }
-  }
+  });
 
   mesh->flag |= ME_AUTOSMOOTH;
   BKE_mesh_set_custom_normals(mesh, lnors);
@@ -308,9 +327,11 @@ static void process_vertex_normals(CDStreamConfig &config,
       MEM_malloc_arrayN(normals_count, sizeof(float[3]), "ABC::VertexNormals"));
 
   const N3fArraySample &vertex_normals = *vertex_normals_ptr;
-  for (int index = 0; index < normals_count; index++) {
-    copy_zup_from_yup(vnors[index], vertex_normals[index].getValue());
-  }
+  parallel_for(IndexRange(normals_count), 4096, [&](IndexRange range) {
+    for (const int index : range) {
+      copy_zup_from_yup(vnors[index], vertex_normals[index].getValue());
+    }
+  });
 
   config.mesh->flag |= ME_AUTOSMOOTH;
   BKE_mesh_set_custom_normals_from_vertices(config.mesh, vnors);
@@ -433,7 +454,7 @@ static void read_mesh_sample(const std::string &iobject_full_name,
     abc_mesh_data.ceil_positions = ceil_sample.getPositions();
   }
 
-  if ((settings->read_flag & MOD_MESHSEQ_READ_UV) != 0) {
+  if ((settings->read_flag & MOD_MESHSEQ_READ_UV) != 0 && !config.use_existing_topology) {
     read_uvs_params(config, abc_mesh_data, schema.getUVsParam(), selector);
   }
 
@@ -442,7 +463,9 @@ static void read_mesh_sample(const std::string &iobject_full_name,
   }
 
   if ((settings->read_flag & MOD_MESHSEQ_READ_POLY) != 0) {
-    read_mpolys(config, abc_mesh_data);
+    if (!config.use_existing_topology) {
+      read_mpolys(config, abc_mesh_data);
+    }
     process_normals(config, schema.getNormalsParam(), selector);
   }
 
@@ -593,6 +616,18 @@ bool AbcMeshReader::accepts_object_type(
   return true;
 }
 
+static bool mesh_topology_changed(const Mesh *existing_mesh,
+                                  const IPolyMeshSchema::Sample &sample)
+{
+  const P3fArraySamplePtr &positions = sample.getPositions();
+  const Alembic::Abc::Int32ArraySamplePtr &face_indices = sample.getFaceIndices();
+  const Alembic::Abc::Int32ArraySamplePtr &face_counts = sample.getFaceCounts();
+
+  return positions->size() != existing_mesh->totvert ||
+         face_counts->size() != existing_mesh->totpoly ||
+         face_indices->size() != existing_mesh->totloop;
+}
+
 bool AbcMeshReader::topology_changed(Mesh *existing_mesh, const ISampleSelector &sample_sel)
 {
   IPolyMeshSchema::Sample sample;
@@ -609,13 +644,30 @@ bool AbcMeshReader::topology_changed(Mesh *existing_mesh, const ISampleSelector
     return false;
   }
 
-  const P3fArraySamplePtr &positions = sample.getPositions();
-  const Alembic::Abc::Int32ArraySamplePtr &face_indices = sample.getFaceIndices();
-  const Alembic::Abc::Int32ArraySamplePtr &face_counts = sample.getFaceCounts();
+  return mesh_topology_changed(existing_mesh, sample);
+}
 
-  return positions->size() != existing_mesh->totvert ||
-         face_counts->size() != existing_mesh->totpoly ||
-         face_indices->size() != existing_mesh->totloop;
+/**
+ * Whether the polygons, loops and UVs of \a existing_mesh can be kept when reading a sample with
+ * the same element counts, instead of rebuilding them (and the edges) for every frame.
+ */
+static bool mesh_topology_is_reusable(const IPolyMeshSchema &schema, const Mesh *existing_mesh)
+{
+  if (schema.getTopologyVariance() == Alembic::AbcGeom::kHeterogenousTopology) {
+    return false;
+  }
+  if (existing_mesh->totpoly == 0 || existing_mesh->mpoly == nullptr) {
+    return false;
+  }
+
+  /* Animated UVs are rare but still have to be read, as do UVs the mesh doesn't have yet. */
+  const IV2fGeomParam &uv = schema.getUVsParam();
+  if (uv.valid() &&
+      (!uv.isConstant() || !CustomData_has_layer(&existing_mesh->ldata, CD_MLOOPUV))) {
+    return false;
+  }
+
+  return true;
 }
 
 Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
@@ -664,7 +716,8 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   ImportSettings settings;
   settings.read_flag |= read_flag;
 
-  if (topology_changed(existing_mesh, sample_sel)) {
+  /* Reuse the sample read above instead of reading it again from the archive. */
+  if (mesh_topology_changed(existing_mesh, sample)) {
     new_mesh = BKE_mesh_new_nomain_from_template(
         existing_mesh, positions->size(), 0, 0, face_indices->size(), face_counts->size());
 
@@ -691,6 +744,8 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   CDStreamConfig config = get_config(mesh_to_export, use_vertex_interpolation);
   config.time = sample_sel.getRequestedTime();
   config.modifier_error_message = err_str;
+  config.use_existing_topology = (new_mesh == nullptr) &&
+                                 mesh_topology_is_reusable(m_schema, existing_mesh);
 
   read_mesh_sample(m_iobject.getFullName(), &settings, m_schema, sample_sel, config);
 
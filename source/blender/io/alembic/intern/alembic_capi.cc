@@ -47,6 +47,7 @@
 #include "BKE_global.h"
 #include "BKE_layer.h"
 #include "BKE_lib_id.h"
+#include "BKE_main_namemap.h"
 #include "BKE_object.h"
 #include "BKE_scene.h"
 #include "BKE_screen.h"
@@ -499,6 +500,10 @@ static void import_startjob(void *user_data, short *stop, short *do_update, floa
   chrono_t min_time = std::numeric_limits<chrono_t>::max();
   chrono_t max_time = std::numeric_limits<chrono_t>::min();
 
+  /* Many objects with similar names may be created, keep track of the used names instead of
+   * searching all existing IDs for every new one. */
+  BKE_main_namemap_ensure(data->bmain);
+
   ISampleSelector sample_sel(0.0f);
   std::vector<AbcObjectReader *>::iterator iter;
   for (iter = data->readers.begin(); iter != data->readers.end(); ++iter) {
@@ -519,11 +524,14 @@ static void import_startjob(void *user_data, short *stop, short *do_update, floa
     *data->do_update = true;
 
     if (G.is_break) {
+      BKE_main_namemap_clear(data->bmain);
       data->was_cancelled = true;
       return;
     }
   }
 
+  BKE_main_namemap_clear(data->bmain);
+
   if (data->settings.set_frame_range) {
     Scene *scene = data->scene;
 
@@ -726,6 +726,38 @@ void MeshImporter::read_polys(COLLADAFW::Mesh *collada_mesh, Mesh *me)
       COLLADAFW::IndexListArray &index_list_array_uvcoord = mp->getUVCoordIndicesArray();
       COLLADAFW::IndexListArray &index_list_array_vcolor = mp->getColorIndicesArray();
 
+      /* Look up the loop layers once per primitive, instead of by name for every polygon. */
+      const unsigned int uvset_count = index_list_array_uvcoord.getCount();
+      std::vector<MLoopUV *> mloopuv_layers(uvset_count);
+      for (unsigned int uvset_index = 0; uvset_index < uvset_count; uvset_index++) {
+        COLLADAFW::IndexList &index_list = *index_list_array_uvcoord[uvset_index];
+        mloopuv_layers[uvset_index] = (MLoopUV *)CustomData_get_layer_named(
+            &me->ldata, CD_MLOOPUV, index_list.getName().c_str());
+        if (mloopuv_layers[uvset_index] == nullptr) {
+          fprintf(stderr,
+                  "Collada import: Mesh [%s] : Unknown reference to TEXCOORD [#%s].\n",
+                  me->id.name,
+                  index_list.getName().c_str());
+        }
+      }
+
+      const unsigned int vcolor_count = mp->hasColorIndices() ?
+                                            index_list_array_vcolor.getCount() :
+                                            0;
+      std::vector<MLoopCol *> mloopcol_layers(vcolor_count);
+      for (unsigned int vcolor_index = 0; vcolor_index < vcolor_count; vcolor_index++) {
+        COLLADAFW::IndexList &color_index_list = *mp->getColorIndices(vcolor_index);
+        COLLADAFW::String colname = extract_vcolname(color_index_list.getName());
+        mloopcol_layers[vcolor_index] = (MLoopCol *)CustomData_get_layer_named(
+            &me->ldata, CD_MLOOPCOL, colname.c_str());
+        if (mloopcol_layers[vcolor_index] == nullptr) {
+          fprintf(stderr,
+                  "Collada import: Mesh [%s] : Unknown reference to VCOLOR [#%s].\n",
+                  me->id.name,
+                  color_index_list.getName().c_str());
+        }
+      }
+
       int invalid_loop_holes = 0;
       for (unsigned int j = 0; j < prim_totpoly; j++) {
 
@@ -740,19 +772,10 @@ void MeshImporter::read_polys(COLLADAFW::Mesh *collada_mesh, Mesh *me)
           invalid_loop_holes += 1;
         }
 
-        for (unsigned int uvset_index = 0; uvset_index < index_list_array_uvcoord.getCount();
-             uvset_index++) {
+        for (unsigned int uvset_index = 0; uvset_index < uvset_count; uvset_index++) {
           /* get mtface by face index and uv set index */
-          COLLADAFW::IndexList &index_list = *index_list_array_uvcoord[uvset_index];
-          MLoopUV *mloopuv = (MLoopUV *)CustomData_get_layer_named(
-              &me->ldata, CD_MLOOPUV, index_list.getName().c_str());
-          if (mloopuv == nullptr) {
-            fprintf(stderr,
-                    "Collada import: Mesh [%s] : Unknown reference to TEXCOORD [#%s].\n",
-                    me->id.name,
-                    index_list.getName().c_str());
-          }
-          else {
+          MLoopUV *mloopuv = mloopuv_layers[uvset_index];
+          if (mloopuv != nullptr) {
             set_face_uv(mloopuv + loop_index,
                         uvs,
                         start_index,
@@ -767,24 +790,11 @@ void MeshImporter::read_polys(COLLADAFW::Mesh *collada_mesh, Mesh *me)
           }
         }
 
-        if (mp->hasColorIndices()) {
-          int vcolor_count = index_list_array_vcolor.getCount();
-
-          for (unsigned int vcolor_index = 0; vcolor_index < vcolor_count; vcolor_index++) {
-
+        for (unsigned int vcolor_index = 0; vcolor_index < vcolor_count; vcolor_index++) {
+          MLoopCol *mloopcol = mloopcol_layers[vcolor_index];
+          if (mloopcol != nullptr) {
             COLLADAFW::IndexList &color_index_list = *mp->getColorIndices(vcolor_index);
-            COLLADAFW::String colname = extract_vcolname(color_index_list.getName());
-            MLoopCol *mloopcol = (MLoopCol *)CustomData_get_layer_named(
-                &me->ldata, CD_MLOOPCOL, colname.c_str());
-            if (mloopcol == nullptr) {
-              fprintf(stderr,
-                      "Collada import: Mesh [%s] : Unknown reference to VCOLOR [#%s].\n",
-                      me->id.name,
-                      color_index_list.getName().c_str());
-            }
-            else {
-              set_vcol(mloopcol + loop_index, vcol, start_index, color_index_list, vcount);
-            }
+            set_vcol(mloopcol + loop_index, vcol, start_index, color_index_list, vcount);
           }
         }
 
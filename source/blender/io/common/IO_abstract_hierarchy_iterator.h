@@ -139,6 +139,13 @@ class AbstractHierarchyWriter {
   static bool check_has_deforming_physics(const HierarchyContext &context);
 };
 
+/* Time spent in the write() calls of a single writer, see
+ * AbstractHierarchyIterator::set_collect_writer_timings(). */
+struct WriterTiming {
+  int num_writes = 0;
+  double time_total = 0.0;
+};
+
 /* Determines which subset of the writers actually gets to write. */
 struct ExportSubset {
   bool transforms : 1;
@@ -219,6 +226,8 @@ class AbstractHierarchyIterator {
   /* Mapping from ID to its export path. This is used for instancing; given an
    * instanced datablock, the export path of the original can be looked up. */
   typedef std::map<ID *, std::string> ExportPathMap;
+  /* Mapping from export path to the time spent writing it. */
+  typedef std::map<std::string, WriterTiming> WriterTimingMap;
 
  protected:
   ExportGraph export_graph_;
@@ -226,6 +235,8 @@ class AbstractHierarchyIterator {
   Depsgraph *depsgraph_;
   WriterMap writers_;
   ExportSubset export_subset_;
+  bool collect_writer_timings_;
+  WriterTimingMap writer_timings_;
 
  public:
   explicit AbstractHierarchyIterator(Depsgraph *depsgraph);
@@ -248,6 +259,13 @@ class AbstractHierarchyIterator {
    * previous iteration. */
   void set_export_subset(ExportSubset export_subset_);
 
+  /* Measure the time spent in the write() call of every writer, accumulated over all iterations.
+   * Meant for profiling exporters, as the timing itself has some overhead. */
+  void set_collect_writer_timings(bool collect_writer_timings);
+  const WriterTimingMap &writer_timings() const;
+  /* Print the collected timings to stdout, slowest writers first. */
+  void print_writer_timings() const;
+
   /* Convert the given name to something that is valid for the exported file format.
    * This base implementation is a no-op; override in a concrete subclass. */
   virtual std::string make_valid_name(const std::string &name) const;
@@ -286,6 +304,8 @@ class AbstractHierarchyIterator {
   void make_writers(const HierarchyContext *parent_context);
   void make_writer_object_data(const HierarchyContext *context);
   void make_writers_particle_systems(const HierarchyContext *context);
+  /* Call writer->write(context), keeping track of its timing when requested. */
+  void write_with_timing(EnsuredWriter &writer, HierarchyContext &context);
 
   /* Return the appropriate HierarchyContext for the data of the object represented by
    * object_context. */
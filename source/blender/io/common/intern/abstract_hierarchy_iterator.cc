@@ -19,11 +19,13 @@
 #include "IO_abstract_hierarchy_iterator.h"
 #include "dupli_parent_finder.hh"
 
+#include <algorithm>
 #include <climits>
 #include <cstdio>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "BKE_anim_data.h"
 #include "BKE_duplilist.h"
@@ -35,6 +37,8 @@
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
 
+#include "PIL_time.h"
+
 #include "DNA_ID.h"
 #include "DNA_layer_types.h"
 #include "DNA_modifier_types.h"
@@ -182,7 +186,7 @@ bool AbstractHierarchyWriter::check_has_deforming_physics(const HierarchyContext
 }
 
 AbstractHierarchyIterator::AbstractHierarchyIterator(Depsgraph *depsgraph)
-    : depsgraph_(depsgraph), export_subset_({true, true})
+    : depsgraph_(depsgraph), export_subset_({true, true}), collect_writer_timings_(false)
 {
 }
 
@@ -220,6 +224,54 @@ void AbstractHierarchyIterator::set_export_subset(ExportSubset export_subset)
   export_subset_ = export_subset;
 }
 
+void AbstractHierarchyIterator::set_collect_writer_timings(bool collect_writer_timings)
+{
+  collect_writer_timings_ = collect_writer_timings;
+}
+
+const AbstractHierarchyIterator::WriterTimingMap &AbstractHierarchyIterator::writer_timings()
+    const
+{
+  return writer_timings_;
+}
+
+void AbstractHierarchyIterator::print_writer_timings() const
+{
+  std::vector<const WriterTimingMap::value_type *> timings;
+  double time_total = 0.0;
+  for (const WriterTimingMap::value_type &it : writer_timings_) {
+    timings.push_back(&it);
+    time_total += it.second.time_total;
+  }
+  std::sort(timings.begin(),
+            timings.end(),
+            [](const WriterTimingMap::value_type *a, const WriterTimingMap::value_type *b) {
+              return a->second.time_total > b->second.time_total;
+            });
+
+  printf("Writer timings (%d writers, %.3f s in total):\n", int(timings.size()), time_total);
+  for (const WriterTimingMap::value_type *it : timings) {
+    printf("  %10.3f ms in %4d writes  %s\n",
+           it->second.time_total * 1000.0,
+           it->second.num_writes,
+           it->first.c_str());
+  }
+}
+
+void AbstractHierarchyIterator::write_with_timing(EnsuredWriter &writer, HierarchyContext &context)
+{
+  if (!collect_writer_timings_) {
+    writer->write(context);
+    return;
+  }
+
+  const double time_start = PIL_check_seconds_timer();
+  writer->write(context);
+  WriterTiming &timing = writer_timings_[context.export_path];
+  timing.time_total += PIL_check_seconds_timer() - time_start;
+  timing.num_writes++;
+}
+
 std::string AbstractHierarchyIterator::make_valid_name(const std::string &name) const
 {
   return name;
@@ -609,7 +661,7 @@ void AbstractHierarchyIterator::make_writers(const HierarchyContext *parent_cont
       /* XXX This can lead to too many XForms being written. For example, a camera writer can
        * refuse to write an orthographic camera. By the time that this is known, the XForm has
        * already been written. */
-      transform_writer->write(*context);
+      write_with_timing(transform_writer, *context);
     }
 
     if (!context->weak_export) {
@@ -659,7 +711,7 @@ void AbstractHierarchyIterator::make_writer_object_data(const HierarchyContext *
   }
 
   if (data_writer.is_newly_created() || export_subset_.shapes) {
-    data_writer->write(data_context);
+    write_with_timing(data_writer, data_context);
   }
 }
 
@@ -695,7 +747,7 @@ void AbstractHierarchyIterator::make_writers_particle_systems(
 
     /* Always write upon creation, otherwise depend on which subset is active. */
     if (writer.is_newly_created() || export_subset_.shapes) {
-      writer->write(hair_context);
+      write_with_timing(writer, hair_context);
     }
   }
 }
@@ -209,6 +209,43 @@ TEST_F(AbstractHierarchyIteratorTest, ExportHierarchyTest)
   EXPECT_EQ(expected_data, iterator->data_writers);
 }
 
+TEST_F(AbstractHierarchyIteratorTest, WriterTimingsTest)
+{
+  /* Load the test blend file. */
+  if (!blendfile_load("usd/usd_hierarchy_export_test.blend")) {
+    return;
+  }
+  depsgraph_create(DAG_EVAL_RENDER);
+  iterator_create();
+
+  /* Timings are only collected when asked for. */
+  iterator->iterate_and_write();
+  EXPECT_TRUE(iterator->writer_timings().empty());
+
+  iterator->set_collect_writer_timings(true);
+  for (int i = 0; i < 2; i++) {
+    iterator->transform_writers.clear();
+    iterator->data_writers.clear();
+    iterator->iterate_and_write();
+  }
+
+  /* There should be one timing per export path, of both iterations. */
+  std::set<std::string> expected_paths;
+  for (const used_writers *writers : {&iterator->transform_writers, &iterator->data_writers}) {
+    for (const used_writers::value_type &it : *writers) {
+      expected_paths.insert(it.second.begin(), it.second.end());
+    }
+  }
+  std::set<std::string> timed_paths;
+  for (const AbstractHierarchyIterator::WriterTimingMap::value_type &it :
+       iterator->writer_timings()) {
+    timed_paths.insert(it.first);
+    EXPECT_EQ(2, it.second.num_writes) << it.first;
+    EXPECT_GE(it.second.time_total, 0.0) << it.first;
+  }
+  EXPECT_EQ(expected_paths, timed_paths);
+}
+
 TEST_F(AbstractHierarchyIteratorTest, ExportSubsetTest)
 {
   /* The scene has no hair or particle systems, and this is already covered by ExportHierarchyTest,
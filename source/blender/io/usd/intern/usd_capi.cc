@@ -128,6 +128,7 @@ static void export_startjob(void *customdata,
   }
 
   USDHierarchyIterator iter(data->depsgraph, usd_stage, data->params);
+  iter.set_collect_writer_timings(G.debug & G_DEBUG_IO);
 
   if (data->params.export_animation) {
     /* Writing the animated frames is not 100% of the work, but it's our best guess. */
@@ -155,6 +156,9 @@ static void export_startjob(void *customdata,
     iter.iterate_and_write();
   }
 
+  if (G.debug & G_DEBUG_IO) {
+    iter.print_writer_timings();
+  }
   iter.release_writers();
   usd_stage->GetRootLayer()->Save();
 
@@ -203,6 +203,19 @@ typedef enum eNodeSocketFlag {
 } eNodeSocketFlag;
 
 /* limit data in bNode to what we want to see saved? */
+/** Statistics of the last execution of a node, set by the compositor and geometry nodes at
+ * runtime. */
+typedef struct bNodeExecStats {
+  /** Time spent calculating the node in seconds, summed over all threads. */
+  double time;
+  /** Number of pixels calculated. */
+  uint64_t pixels;
+  /** Size of the buffers holding the results of the node in bytes. */
+  uint64_t memory;
+  /** Number of points and instances in the geometry outputs of a geometry node. */
+  uint64_t elements;
+} bNodeExecStats;
+
 typedef struct bNode {
   struct bNode *next, *prev, *new_node;
 
@@ -290,6 +303,8 @@ typedef struct bNode {
   char iter_flag;
   /** Runtime during drawing. */
   struct uiBlock *block;
+  /** Runtime statistics of the last execution, cleared on file read. */
+  bNodeExecStats exec_stats;
 
   /**
    * XXX: eevee only, id of screen space reflection layer,
@@ -410,6 +425,14 @@ typedef struct bNodeLink {
 #define NTREE_CHUNKSIZE_512 512
 #define NTREE_CHUNKSIZE_1024 1024
 
+/* tree->execution_mode */
+typedef enum eNodeTreeExecutionMode {
+  /** Evaluate the tree in chunks, pulling only the areas each chunk depends on. */
+  NTREE_EXECUTION_MODE_TILED = 0,
+  /** Evaluate every operation once over its whole area into full-frame buffers. */
+  NTREE_EXECUTION_MODE_FULL_FRAME = 1,
+} eNodeTreeExecutionMode;
+
 /* the basis for a Node tree, all links and nodes reside internal here */
 /* only re-usable node trees are in the library though,
  * materials and textures allocate own tree struct */
@@ -447,7 +470,6 @@ typedef struct bNodeTree {
   short is_updating;
   /** Generic temporary flag for recursion check (DFS/BFS). */
   short done;
-  char _pad2[4];
 
   /** Specific node type this tree is used for. */
   int nodetype DNA_DEPRECATED;
@@ -458,6 +480,8 @@ typedef struct bNodeTree {
   short render_quality;
   /** Tile size for compositor engine. */
   int chunksize;
+  /** Execution model of the compositor engine, see #eNodeTreeExecutionMode. */
+  int execution_mode;
 
   rctf viewer_border;
 
@@ -517,6 +541,9 @@ typedef struct bNodeTree {
 
 /* tree is localized copy, free when deleting node groups */
 /* #define NTREE_IS_LOCALIZED           (1 << 5) */
+#define NTREE_COM_HALF_FLOAT (1 << 6)      /* store intermediate buffers as half floats */
+#define NTREE_COM_GPU (1 << 7)             /* use the GPU module */
+#define NTREE_COM_PARALLEL_FRAMES (1 << 8) /* composite frames of animations in parallel */
 
 /* ntree->update */
 typedef enum eNodeTreeUpdate {
@@ -695,6 +695,8 @@ enum {
 
   SEQ_CACHE_PREFETCH_ENABLE = (1 << 10),
   SEQ_CACHE_DISK_CACHE_ENABLE = (1 << 11),
+  /* Compress images instead of freeing them, when the cache is full. */
+  SEQ_CACHE_COMPRESS = (1 << 12),
 };
 
 #ifdef __cplusplus
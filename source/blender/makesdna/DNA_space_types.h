@@ -1582,6 +1582,8 @@ typedef enum eSpaceNode_Flag {
   SNODE_PIN = (1 << 12),
   /** automatically offset following nodes in a chain on insertion */
   SNODE_SKIP_INSOFFSET = (1 << 13),
+  /** draw the execution statistics of compositor nodes */
+  SNODE_SHOW_EXEC_STATS = (1 << 14),
 } eSpaceNode_Flag;
 
 /* SpaceNode.texfrom */
@@ -644,7 +644,8 @@ typedef struct UserDef_Experimental {
   char use_switch_object_operator;
   char use_sculpt_tools_tilt;
   char use_asset_browser;
-  char _pad[7];
+  char use_undo_skip_unchanged;
+  char _pad[6];
   /** `makesdna` does not allow empty structs. */
 } UserDef_Experimental;
 
@@ -767,7 +768,9 @@ typedef struct UserDef {
   char gizmo_size;
   /** Navigate gizmo size. */
   char gizmo_size_navigate_v3d;
-  char _pad3[5];
+  char _pad3[3];
+  /** Memory budget of GPU mesh batch caches in megabytes, zero disables the limit. */
+  short vbomemlimit;
   short edit_studio_light;
   short lookdev_sphere_size;
   short vbotimeout, vbocollectrate;
@@ -777,7 +780,8 @@ typedef struct UserDef {
   int prefetchframes;
   /** Control the rotation step of the view when PAD2, PAD4, PAD6&PAD8 is use. */
   float pad_rot_angle;
-  char _pad12[4];
+  /** Memory limit of cached compositor results (in megabytes), zero disables the cache. */
+  int compositor_cache_limit;
   /** Rotating view icon size. */
   short rvisize;
   /** Rotating view icon brightness. */
@@ -904,7 +908,9 @@ typedef struct UserDef {
   int sequencer_disk_cache_compression; /* eUserpref_DiskCacheCompression */
   int sequencer_disk_cache_size_limit;
   short sequencer_disk_cache_flag;
-  char _pad5[2];
+  /** #eUserpref_MovieDecodeFlag. */
+  char movie_decode_flag;
+  char _pad5[1];
 
   float collection_instance_empty_size;
   char _pad10[3];
@@ -1366,6 +1372,11 @@ typedef enum eUserpref_DiskCacheCompression {
   USER_SEQ_DISK_CACHE_COMPRESSION_HIGH = 2,
 } eUserpref_DiskCacheCompression;
 
+/** #UserDef.movie_decode_flag */
+typedef enum eUserpref_MovieDecodeFlag {
+  USER_MOVIE_DECODE_HARDWARE = (1 << 0),
+} eUserpref_MovieDecodeFlag;
+
 /* Locale Ids. Auto will try to get local from OS. Our default is English though. */
 /** #UserDef.language */
 enum {
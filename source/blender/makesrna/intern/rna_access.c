@@ -4340,10 +4340,14 @@ bool RNA_property_collection_type_get(PointerRNA *ptr, PropertyRNA *prop, Pointe
   return ((r_ptr->type = rna_ensure_property(prop)->srna) ? 1 : 0);
 }
 
-int RNA_property_collection_raw_array(PointerRNA *ptr,
-                                      PropertyRNA *prop,
-                                      PropertyRNA *itemprop,
-                                      RawArray *array)
+/**
+ * \param set: When false the array is only read from, so it does not have to be editable.
+ */
+static int rna_property_collection_raw_array(PointerRNA *ptr,
+                                             PropertyRNA *prop,
+                                             PropertyRNA *itemprop,
+                                             const bool set,
+                                             RawArray *array)
 {
   CollectionPropertyIterator iter;
   ArrayIterator *internal;
@@ -4363,7 +4367,7 @@ int RNA_property_collection_raw_array(PointerRNA *ptr,
     internal = &iter.internal.array;
     arrayp = (iter.valid) ? iter.ptr.data : NULL;
 
-    if (internal->skip || !RNA_property_editable(&iter.ptr, itemprop)) {
+    if (internal->skip || (set && !RNA_property_editable(&iter.ptr, itemprop))) {
       /* we might skip some items, so it's not a proper array */
       RNA_property_collection_end(&iter);
       return 0;
@@ -4383,6 +4387,14 @@ int RNA_property_collection_raw_array(PointerRNA *ptr,
   return 1;
 }
 
+int RNA_property_collection_raw_array(PointerRNA *ptr,
+                                      PropertyRNA *prop,
+                                      PropertyRNA *itemprop,
+                                      RawArray *array)
+{
+  return rna_property_collection_raw_array(ptr, prop, itemprop, true, array);
+}
+
 #define RAW_GET(dtype, var, raw, a) \
   { \
     switch (raw.type) { \
@@ -4522,7 +4534,7 @@ static int rna_raw_access(ReportList *reports,
       itemprop = NULL;
     }
     /* try to access as raw array */
-    else if (RNA_property_collection_raw_array(ptr, prop, itemprop, &out)) {
+    else if (rna_property_collection_raw_array(ptr, prop, itemprop, set, &out)) {
       int arraylen = (itemlen == 0) ? 1 : itemlen;
       if (in.len != arraylen * out.len) {
         BKE_reportf(reports,
@@ -4541,6 +4553,17 @@ static int rna_raw_access(ReportList *reports,
 
         size = RNA_raw_type_sizeof(out.type) * arraylen;
 
+        /* The items only contain this property, copy all of them at once. */
+        if (out.stride == size) {
+          if (set) {
+            memcpy(outp, inp, (size_t)size * out.len);
+          }
+          else {
+            memcpy(inp, outp, (size_t)size * out.len);
+          }
+          return 1;
+        }
+
         for (a = 0; a < out.len; a++) {
           if (set) {
             memcpy(outp, inp, size);
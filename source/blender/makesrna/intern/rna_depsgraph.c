@@ -252,6 +252,16 @@ static void rna_Depsgraph_debug_stats_gnuplot(Depsgraph *depsgraph,
   fclose(f);
 }
 
+static void rna_Depsgraph_debug_timeline_json(Depsgraph *depsgraph, const char *filename)
+{
+  FILE *f = fopen(filename, "w");
+  if (f == NULL) {
+    return;
+  }
+  DEG_debug_timeline_json(depsgraph, f);
+  fclose(f);
+}
+
 static void rna_Depsgraph_debug_tag_update(Depsgraph *depsgraph)
 {
   DEG_graph_tag_relations_update(depsgraph);
@@ -666,6 +676,14 @@ static void rna_def_depsgraph(BlenderRNA *brna)
                                   "File name where gnuplot script will save the result");
   RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
 
+  func = RNA_def_function(srna, "debug_timeline_json", "rna_Depsgraph_debug_timeline_json");
+  RNA_def_function_ui_description(func,
+                                  "Write the timeline of the last evaluation as a Chrome trace, "
+                                  "requires the --debug-depsgraph-time command line option");
+  parm = RNA_def_string_file_path(
+      func, "filename", NULL, FILE_MAX, "File Name", "Output path for the trace file");
+  RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
+
   func = RNA_def_function(srna, "debug_tag_update", "rna_Depsgraph_debug_tag_update");
 
   func = RNA_def_function(srna, "debug_stats", "rna_Depsgraph_debug_stats");
@@ -120,6 +120,21 @@ static const EnumPropertyItem node_chunksize_items[] = {
     {NTREE_CHUNKSIZE_1024, "1024", 0, "1024x1024", "Chunksize of 1024x1024"},
     {0, NULL, 0, NULL, NULL},
 };
+
+static const EnumPropertyItem node_execution_mode_items[] = {
+    {NTREE_EXECUTION_MODE_TILED,
+     "TILED",
+     0,
+     "Tiled",
+     "Compositing is tiled, having as priority to display first tiles as fast as possible"},
+    {NTREE_EXECUTION_MODE_FULL_FRAME,
+     "FULL_FRAME",
+     0,
+     "Full Frame",
+     "Composites full image result as fast as possible, evaluating every operation once over "
+     "its whole area"},
+    {0, NULL, 0, NULL, NULL},
+};
 #endif
 
 const EnumPropertyItem rna_enum_mapping_type_items[] = {
@@ -2220,6 +2235,30 @@ static void rna_Node_select_set(PointerRNA *ptr, bool value)
   nodeSetSelected(node, value);
 }
 
+static float rna_Node_execution_time_get(PointerRNA *ptr)
+{
+  bNode *node = (bNode *)ptr->data;
+  return (float)node->exec_stats.time;
+}
+
+static int rna_Node_execution_pixels_get(PointerRNA *ptr)
+{
+  bNode *node = (bNode *)ptr->data;
+  return (int)MIN2(node->exec_stats.pixels, INT_MAX);
+}
+
+static float rna_Node_execution_memory_get(PointerRNA *ptr)
+{
+  bNode *node = (bNode *)ptr->data;
+  return (float)(node->exec_stats.memory / (1024.0 * 1024.0));
+}
+
+static int rna_Node_execution_elements_get(PointerRNA *ptr)
+{
+  bNode *node = (bNode *)ptr->data;
+  return (int)MIN2(node->exec_stats.elements, INT_MAX);
+}
+
 static void rna_Node_name_set(PointerRNA *ptr, const char *value)
 {
   bNodeTree *ntree = (bNodeTree *)ptr->owner_id;
@@ -10092,6 +10131,39 @@ static void rna_def_node(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Show Texture", "Draw node in viewport textured draw mode");
   RNA_def_property_update(prop, 0, "rna_Node_update");
 
+  prop = RNA_def_property(srna, "execution_time", PROP_FLOAT, PROP_NONE);
+  RNA_def_property_float_funcs(prop, "rna_Node_execution_time_get", NULL, NULL);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_ui_text(
+      prop,
+      "Execution Time",
+      "Time in seconds spent calculating this node in the last compositor or geometry nodes "
+      "execution, summed over all threads");
+
+  prop = RNA_def_property(srna, "execution_pixels", PROP_INT, PROP_UNSIGNED);
+  RNA_def_property_int_funcs(prop, "rna_Node_execution_pixels_get", NULL, NULL);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_ui_text(prop,
+                           "Execution Pixels",
+                           "Number of pixels calculated by this node in the last compositor "
+                           "execution");
+
+  prop = RNA_def_property(srna, "execution_memory", PROP_FLOAT, PROP_NONE);
+  RNA_def_property_float_funcs(prop, "rna_Node_execution_memory_get", NULL, NULL);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_ui_text(prop,
+                           "Execution Memory",
+                           "Memory in megabytes used by the buffers holding the results of this "
+                           "node in the last compositor execution");
+
+  prop = RNA_def_property(srna, "execution_elements", PROP_INT, PROP_UNSIGNED);
+  RNA_def_property_int_funcs(prop, "rna_Node_execution_elements_get", NULL, NULL);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_ui_text(prop,
+                           "Execution Elements",
+                           "Number of points and instances in the geometry outputs of this node "
+                           "in the last geometry nodes execution");
+
   /* generic property update function */
   func = RNA_def_function(srna, "socket_value_update", "rna_Node_socket_value_update");
   RNA_def_function_ui_description(func, "Update after property changes");
@@ -10613,10 +10685,36 @@ static void rna_def_composite_nodetree(BlenderRNA *brna)
                            "Max size of a tile (smaller values gives better distribution "
                            "of multiple threads, but more overhead)");
 
+  prop = RNA_def_property(srna, "execution_mode", PROP_ENUM, PROP_NONE);
+  RNA_def_property_enum_sdna(prop, NULL, "execution_mode");
+  RNA_def_property_enum_items(prop, node_execution_mode_items);
+  RNA_def_property_ui_text(prop, "Execution Mode", "Set how compositing is executed");
+
   prop = RNA_def_property(srna, "use_opencl", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "flag", NTREE_COM_OPENCL);
   RNA_def_property_ui_text(prop, "OpenCL", "Enable GPU calculations");
 
+  prop = RNA_def_property(srna, "use_gpu", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", NTREE_COM_GPU);
+  RNA_def_property_ui_text(prop,
+                           "GPU",
+                           "Calculate supported nodes on the GPU, keeping intermediate results in "
+                           "GPU memory (replaces OpenCL when both are enabled)");
+
+  prop = RNA_def_property(srna, "use_half_float", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", NTREE_COM_HALF_FLOAT);
+  RNA_def_property_ui_text(prop,
+                           "Half Float Buffers",
+                           "Store intermediate buffers with half float precision to reduce "
+                           "memory usage, at the cost of precision");
+
+  prop = RNA_def_property(srna, "use_parallel_frames", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", NTREE_COM_PARALLEL_FRAMES);
+  RNA_def_property_ui_text(prop,
+                           "Parallel Frames",
+                           "Composite several frames at the same time when rendering an animation "
+                           "that doesn't render any scene, at the cost of memory usage");
+
   prop = RNA_def_property(srna, "use_groupnode_buffer", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "flag", NTREE_COM_GROUPNODE_BUFFER);
   RNA_def_property_ui_text(prop, "Buffer Groups", "Enable buffering of group nodes");
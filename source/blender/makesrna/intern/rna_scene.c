@@ -696,6 +696,7 @@ const EnumPropertyItem rna_enum_transform_orientation_items[] = {
 #  include "BKE_layer.h"
 #  include "BKE_main.h"
 #  include "BKE_mesh.h"
+#  include "BKE_mesh_playback_cache.h"
 #  include "BKE_node.h"
 #  include "BKE_pointcache.h"
 #  include "BKE_scene.h"
@@ -1084,6 +1085,16 @@ static void rna_Scene_show_subframe_update(Main *UNUSED(bmain),
   scene->r.subframe = 0.0f;
 }
 
+static void rna_Scene_playback_geometry_cache_update(Main *UNUSED(bmain),
+                                                    Scene *UNUSED(current_scene),
+                                                    PointerRNA *ptr)
+{
+  Scene *scene = (Scene *)ptr->owner_id;
+  if ((scene->flag & SCE_PLAYBACK_GEOMETRY_CACHE) == 0) {
+    BKE_mesh_playback_cache_clear();
+  }
+}
+
 static void rna_Scene_frame_update(Main *UNUSED(bmain),
                                    Scene *UNUSED(current_scene),
                                    PointerRNA *ptr)
@@ -7720,6 +7731,16 @@ void RNA_def_scene(BlenderRNA *brna)
       prop, "Show Subframe", "Show current scene subframe and allow set it using interface tools");
   RNA_def_property_update(prop, NC_SCENE | ND_FRAME, "rna_Scene_show_subframe_update");
 
+  prop = RNA_def_property(srna, "use_playback_geometry_cache", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", SCE_PLAYBACK_GEOMETRY_CACHE);
+  RNA_def_property_ui_text(prop,
+                           "Cache Geometry",
+                           "Keep deformed mesh positions of played frames in memory, so playing "
+                           "them again doesn't evaluate rigs and deform modifiers (limited by the "
+                           "memory cache limit, cleared on any edit)");
+  RNA_def_property_update(prop, NC_SCENE, "rna_Scene_playback_geometry_cache_update");
+
   /* Timeline / Time Navigation settings */
   prop = RNA_def_property(srna, "show_keys_from_selected_only", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_negative_sdna(prop, NULL, "flag", SCE_KEYS_NO_SELONLY);
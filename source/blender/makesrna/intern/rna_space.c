@@ -518,6 +518,8 @@ static const EnumPropertyItem rna_enum_curve_display_handle_items[] = {
 #  include "DEG_depsgraph.h"
 #  include "DEG_depsgraph_build.h"
 
+#  include "DRW_engine.h"
+
 #  include "ED_anim_api.h"
 #  include "ED_buttons.h"
 #  include "ED_clip.h"
@@ -1470,6 +1472,38 @@ static PointerRNA rna_SpaceView3D_overlay_get(PointerRNA *ptr)
   return rna_pointer_inherit_refine(ptr, &RNA_View3DOverlay, ptr->data);
 }
 
+static void rna_View3DOverlay_gpu_timings_begin(CollectionPropertyIterator *iter,
+                                                PointerRNA *UNUSED(ptr))
+{
+  const DRWGPUTiming *timings;
+  const int timings_len = DRW_stats_gpu_timings_get(&timings);
+  rna_iterator_array_begin(iter, (void *)timings, sizeof(*timings), timings_len, 0, NULL);
+}
+
+static void rna_View3DGPUTiming_name_get(PointerRNA *ptr, char *value)
+{
+  const DRWGPUTiming *timing = ptr->data;
+  strcpy(value, timing->name);
+}
+
+static int rna_View3DGPUTiming_name_length(PointerRNA *ptr)
+{
+  const DRWGPUTiming *timing = ptr->data;
+  return strlen(timing->name);
+}
+
+static int rna_View3DGPUTiming_level_get(PointerRNA *ptr)
+{
+  const DRWGPUTiming *timing = ptr->data;
+  return timing->level;
+}
+
+static float rna_View3DGPUTiming_time_get(PointerRNA *ptr)
+{
+  const DRWGPUTiming *timing = ptr->data;
+  return timing->time_ms;
+}
+
 static char *rna_View3DOverlay_path(PointerRNA *UNUSED(ptr))
 {
   return BLI_strdup("overlay");
@@ -3785,6 +3819,33 @@ static void rna_def_space_view3d_shading(BlenderRNA *brna)
   RNA_def_property_update(prop, NC_SPACE | ND_SPACE_VIEW3D, NULL);
 }
 
+static void rna_def_space_view3d_gpu_timing(BlenderRNA *brna)
+{
+  StructRNA *srna;
+  PropertyRNA *prop;
+
+  srna = RNA_def_struct(brna, "View3DGPUTiming", NULL);
+  RNA_def_struct_ui_text(
+      srna, "3D View GPU Timing", "GPU time of a draw engine or pass, averaged over redraws");
+
+  prop = RNA_def_property(srna, "name", PROP_STRING, PROP_NONE);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_string_funcs(
+      prop, "rna_View3DGPUTiming_name_get", "rna_View3DGPUTiming_name_length", NULL);
+  RNA_def_property_ui_text(prop, "Name", "Name of the draw engine or pass");
+  RNA_def_struct_name_property(srna, prop);
+
+  prop = RNA_def_property(srna, "level", PROP_INT, PROP_NONE);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_int_funcs(prop, "rna_View3DGPUTiming_level_get", NULL, NULL);
+  RNA_def_property_ui_text(prop, "Level", "Nesting level, draw engines are at level 0");
+
+  prop = RNA_def_property(srna, "time", PROP_FLOAT, PROP_NONE);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_float_funcs(prop, "rna_View3DGPUTiming_time_get", NULL, NULL);
+  RNA_def_property_ui_text(prop, "Time", "GPU time in milliseconds");
+}
+
 static void rna_def_space_view3d_overlay(BlenderRNA *brna)
 {
   StructRNA *srna;
@@ -3896,6 +3957,28 @@ static void rna_def_space_view3d_overlay(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Show Statistics", "Display scene statistics overlay text");
   RNA_def_property_update(prop, NC_SPACE | ND_SPACE_VIEW3D, NULL);
 
+  prop = RNA_def_property(srna, "show_gpu_timings", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "overlay.flag", V3D_OVERLAY_GPU_TIMINGS);
+  RNA_def_property_ui_text(
+      prop, "Show GPU Timings", "Display the GPU time of each draw engine and pass");
+  RNA_def_property_update(prop, NC_SPACE | ND_SPACE_VIEW3D, NULL);
+
+  prop = RNA_def_property(srna, "gpu_timings", PROP_COLLECTION, PROP_NONE);
+  RNA_def_property_struct_type(prop, "View3DGPUTiming");
+  RNA_def_property_collection_funcs(prop,
+                                    "rna_View3DOverlay_gpu_timings_begin",
+                                    "rna_iterator_array_next",
+                                    "rna_iterator_array_end",
+                                    "rna_iterator_array_get",
+                                    NULL,
+                                    NULL,
+                                    NULL,
+                                    NULL);
+  RNA_def_property_ui_text(prop,
+                           "GPU Timings",
+                           "GPU time of the draw engines and passes of the last redraw with "
+                           "GPU timings enabled, only valid until the next redraw");
+
   prop = RNA_def_property(srna, "show_extras", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_negative_sdna(
       prop, NULL, "overlay.flag", V3D_OVERLAY_HIDE_OBJECT_XTRAS);
@@ -4680,6 +4763,7 @@ static void rna_def_space_view3d(BlenderRNA *brna)
       prop, "Overlay Settings", "Settings for display of overlays in the 3D viewport");
 
   rna_def_space_view3d_shading(brna);
+  rna_def_space_view3d_gpu_timing(brna);
   rna_def_space_view3d_overlay(brna);
 
   /* *** Animated *** */
@@ -6811,6 +6895,14 @@ static void rna_def_space_node(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Show Annotation", "Show annotations for this view");
   RNA_def_property_update(prop, NC_SPACE | ND_SPACE_NODE_VIEW, NULL);
 
+  prop = RNA_def_property(srna, "show_execution_stats", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", SNODE_SHOW_EXEC_STATS);
+  RNA_def_property_ui_text(prop,
+                           "Show Statistics",
+                           "Show the time and the amount of data computed by each node in the "
+                           "last compositor or geometry nodes execution");
+  RNA_def_property_update(prop, NC_SPACE | ND_SPACE_NODE_VIEW, NULL);
+
   prop = RNA_def_property(srna, "use_auto_render", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "flag", SNODE_AUTO_RENDER);
   RNA_def_property_ui_text(
@@ -193,6 +193,8 @@ static const EnumPropertyItem rna_enum_userdef_viewport_aa_items[] = {
 #  include "GPU_select.h"
 #  include "GPU_texture.h"
 
+#  include "IMB_imbuf.h"
+
 #  include "BLF_api.h"
 
 #  include "BLI_path_util.h"
@@ -571,6 +573,14 @@ static void rna_Userdef_memcache_update(Main *UNUSED(bmain),
   USERDEF_TAG_DIRTY;
 }
 
+static void rna_Userdef_movie_decode_update(Main *UNUSED(bmain),
+                                            Scene *UNUSED(scene),
+                                            PointerRNA *UNUSED(ptr))
+{
+  IMB_ffmpeg_hw_decoding_set((U.movie_decode_flag & USER_MOVIE_DECODE_HARDWARE) != 0);
+  USERDEF_TAG_DIRTY;
+}
+
 static void rna_Userdef_disk_cache_dir_update(Main *UNUSED(bmain),
                                               Scene *UNUSED(scene),
                                               PointerRNA *UNUSED(ptr))
@@ -5389,6 +5399,26 @@ static void rna_def_userdef_system(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Memory Cache Limit", "Memory cache limit (in megabytes)");
   RNA_def_property_update(prop, 0, "rna_Userdef_memcache_update");
 
+  prop = RNA_def_property(srna, "compositor_cache_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "compositor_cache_limit");
+  RNA_def_property_range(prop, 0, max_memory_in_megabytes_int());
+  RNA_def_property_ui_text(prop,
+                           "Compositor Cache Limit",
+                           "Memory limit for intermediate compositor results kept between "
+                           "executions, so unchanged parts of the node tree are not "
+                           "recalculated (in megabytes, 0 disables the cache)");
+
+  /* Movie decoding */
+
+  prop = RNA_def_property(srna, "use_hardware_movie_decoding", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "movie_decode_flag", USER_MOVIE_DECODE_HARDWARE);
+  RNA_def_property_ui_text(prop,
+                           "Hardware Movie Decoding",
+                           "Decode movies on the GPU or a dedicated video decoder when available, "
+                           "falling back to software decoding otherwise (applies to movies "
+                           "opened after changing it)");
+  RNA_def_property_update(prop, 0, "rna_Userdef_movie_decode_update");
+
   /* Sequencer disk cache */
 
   prop = RNA_def_property(srna, "use_sequencer_disk_cache", PROP_BOOLEAN, PROP_NONE);
@@ -5537,6 +5567,16 @@ static void rna_def_userdef_system(BlenderRNA *brna)
       "VBO Collection Rate",
       "Number of seconds between each run of the GL Vertex buffer object garbage collector");
 
+  prop = RNA_def_property(srna, "vbo_memory_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "vbomemlimit");
+  RNA_def_property_range(prop, 0, SHRT_MAX);
+  RNA_def_property_ui_range(prop, 0, 16384, 64, -1);
+  RNA_def_property_ui_text(
+      prop,
+      "VBO Memory Limit",
+      "Memory limit for mesh draw caches in megabytes, the least recently used caches are freed "
+      "by the garbage collector when it is exceeded (set to 0 to disable)");
+
   /* Select */
 
   prop = RNA_def_property(srna, "use_select_pick_depth", PROP_BOOLEAN, PROP_NONE);
@@ -6242,6 +6282,14 @@ static void rna_def_userdef_experimental(BlenderRNA *brna)
       prop,
       "Asset Browser",
       "Enable Asset Browser editor and operators to manage data-blocks as asset");
+
+  prop = RNA_def_property(srna, "use_undo_skip_unchanged", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_undo_skip_unchanged", 1);
+  RNA_def_property_ui_text(prop,
+                           "Undo Skip Unchanged",
+                           "Reuse the undo data of data-blocks that were not tagged for an update "
+                           "since the previous undo step, instead of writing them again (faster "
+                           "undo pushes, changes made without an update may not be undone)");
 }
 
 static void rna_def_userdef_addon_collection(BlenderRNA *brna, PropertyRNA *cprop)
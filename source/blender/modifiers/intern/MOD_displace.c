@@ -366,10 +366,7 @@ static void displaceModifier_do(DisplaceModifierData *dmd,
     data.pool = BKE_image_pool_new();
     BKE_texture_fetch_images_for_pool(tex_target, data.pool);
   }
-  TaskParallelSettings settings;
-  BLI_parallel_range_settings_defaults(&settings);
-  settings.use_threading = (numVerts > 512);
-  BLI_task_parallel_range(0, numVerts, &data, displaceModifier_do_task, &settings);
+  MOD_deform_verts_parallel(numVerts, &data, displaceModifier_do_task);
 
   if (data.pool != NULL) {
     BKE_image_pool_free(data.pool);
@@ -19,19 +19,15 @@
  */
 
 #include <errno.h>
-#include <stdio.h>
 #include <string.h>
 
 #include "BLI_utildefines.h"
 
-#include "BLI_fileops.h"
 #include "BLI_math.h"
+#include "BLI_mmap.h"
 #ifdef __LITTLE_ENDIAN__
 #  include "BLI_endian_switch.h"
 #endif
-#ifdef WIN32
-#  include "BLI_winstuff.h"
-#endif
 
 #include "DNA_modifier_types.h"
 
@@ -42,12 +38,12 @@ typedef struct MDDHead {
   int verts_tot;
 } MDDHead; /* frames, verts */
 
-static bool meshcache_read_mdd_head(FILE *fp,
+static bool meshcache_read_mdd_head(BLI_mmap_file *file,
                                     const int verts_tot,
                                     MDDHead *mdd_head,
                                     const char **err_str)
 {
-  if (!fread(mdd_head, sizeof(*mdd_head), 1, fp)) {
+  if (!BLI_mmap_read(file, mdd_head, 0, sizeof(*mdd_head))) {
     *err_str = "Missing header";
     return false;
   }
@@ -65,7 +61,6 @@ static bool meshcache_read_mdd_head(FILE *fp,
     *err_str = "Invalid frame total";
     return false;
   }
-  /* Intentionally don't seek back. */
 
   return true;
 }
@@ -73,7 +68,7 @@ static bool meshcache_read_mdd_head(FILE *fp,
 /**
  * Gets the index range and factor.
  */
-static bool meshcache_read_mdd_range(FILE *fp,
+static bool meshcache_read_mdd_range(BLI_mmap_file *file,
                                      const int verts_tot,
                                      const float frame,
                                      const char interp,
@@ -85,7 +80,7 @@ static bool meshcache_read_mdd_range(FILE *fp,
 
   /* first check interpolation and get the vert locations */
 
-  if (meshcache_read_mdd_head(fp, verts_tot, &mdd_head, err_str) == false) {
+  if (meshcache_read_mdd_head(file, verts_tot, &mdd_head, err_str) == false) {
     return false;
   }
 
@@ -94,7 +89,7 @@ static bool meshcache_read_mdd_range(FILE *fp,
   return true;
 }
 
-static bool meshcache_read_mdd_range_from_time(FILE *fp,
+static bool meshcache_read_mdd_range_from_time(BLI_mmap_file *file,
                                                const int verts_tot,
                                                const float time,
                                                const float UNUSED(fps),
@@ -106,27 +101,32 @@ static bool meshcache_read_mdd_range_from_time(FILE *fp,
   float f_time, f_time_prev = FLT_MAX;
   float frame;
 
-  if (meshcache_read_mdd_head(fp, verts_tot, &mdd_head, err_str) == false) {
+  if (meshcache_read_mdd_head(file, verts_tot, &mdd_head, err_str) == false) {
+    return false;
+  }
+
+  /* The frame times directly follow the header. */
+  if (sizeof(mdd_head) + sizeof(float) * (size_t)mdd_head.frame_tot >
+      BLI_mmap_get_length(file)) {
+    *err_str = "Timestamp read failed";
     return false;
   }
+  const float *file_times = (const float *)((const char *)BLI_mmap_get_pointer(file) +
+                                            sizeof(mdd_head));
 
-  size_t num_frames_read = 0;
-  size_t num_frames_expect = mdd_head.frame_tot;
-  errno = 0;
   for (i = 0; i < mdd_head.frame_tot; i++) {
-    num_frames_read += fread(&f_time, sizeof(float), 1, fp);
+    f_time = file_times[i];
 #ifdef __LITTLE_ENDIAN__
     BLI_endian_switch_float(&f_time);
 #endif
     if (f_time >= time) {
-      num_frames_expect = i + 1;
       break;
     }
     f_time_prev = f_time;
   }
 
-  if (num_frames_read != num_frames_expect) {
-    *err_str = errno ? strerror(errno) : "Timestamp read failed";
+  if (BLI_mmap_any_io_error(file)) {
+    *err_str = "Timestamp read failed";
     return false;
   }
 
@@ -151,7 +151,7 @@ static bool meshcache_read_mdd_range_from_time(FILE *fp,
   return true;
 }
 
-bool MOD_meshcache_read_mdd_index(FILE *fp,
+bool MOD_meshcache_read_mdd_index(BLI_mmap_file *file,
                                   float (*vertexCos)[3],
                                   const int verts_tot,
                                   const int index,
@@ -160,75 +160,38 @@ bool MOD_meshcache_read_mdd_index(FILE *fp,
 {
   MDDHead mdd_head;
 
-  if (meshcache_read_mdd_head(fp, verts_tot, &mdd_head, err_str) == false) {
-    return false;
-  }
-
-  if (BLI_fseek(fp, mdd_head.frame_tot * sizeof(int), SEEK_CUR) != 0) {
-    *err_str = "Header seek failed";
+  if (meshcache_read_mdd_head(file, verts_tot, &mdd_head, err_str) == false) {
     return false;
   }
 
-  if (BLI_fseek(fp, sizeof(float[3]) * index * mdd_head.verts_tot, SEEK_CUR) != 0) {
-    *err_str = "Failed to seek frame";
+  /* The coordinates are read directly from the mapped file, only the pages of this frame have to
+   * be loaded from disk. The frames follow the header and the frame times. */
+  const size_t frame_size = sizeof(float[3]) * (size_t)mdd_head.verts_tot;
+  const size_t frame_offset = sizeof(mdd_head) + sizeof(float) * (size_t)mdd_head.frame_tot +
+                              frame_size * (size_t)index;
+  if (frame_offset + frame_size > BLI_mmap_get_length(file)) {
+    *err_str = "Vertex coordinate read failed";
     return false;
   }
-
-  size_t num_verts_read = 0;
-  errno = 0;
-  if (factor >= 1.0f) {
-#if 1
-    float *vco = *vertexCos;
-    uint i;
-    for (i = mdd_head.verts_tot; i != 0; i--, vco += 3) {
-      num_verts_read += fread(vco, sizeof(float[3]), 1, fp);
-
-#  ifdef __LITTLE_ENDIAN__
-      BLI_endian_switch_float(vco + 0);
-      BLI_endian_switch_float(vco + 1);
-      BLI_endian_switch_float(vco + 2);
-#  endif /* __LITTLE_ENDIAN__ */
-    }
-#else
-    /* no blending */
-    if (!fread(vertexCos, sizeof(float[3]), mdd_head.verts_tot, f)) {
-      *err_str = errno ? strerror(errno) : "Failed to read frame";
-      return false;
-    }
-#  ifdef __LITTLE_ENDIAN__
-    BLI_endian_switch_float_array(vertexCos[0], mdd_head.verts_tot * 3);
-#  endif
-#endif
-  }
-  else {
-    const float ifactor = 1.0f - factor;
-    float *vco = *vertexCos;
-    uint i;
-    for (i = mdd_head.verts_tot; i != 0; i--, vco += 3) {
-      float tvec[3];
-      num_verts_read += fread(tvec, sizeof(float[3]), 1, fp);
+  const float(*file_cos)[3] = (const float(*)[3])((const char *)BLI_mmap_get_pointer(file) +
+                                                   frame_offset);
 
 #ifdef __LITTLE_ENDIAN__
-      BLI_endian_switch_float(tvec + 0);
-      BLI_endian_switch_float(tvec + 1);
-      BLI_endian_switch_float(tvec + 2);
+  const bool use_endian_switch = true;
+#else
+  const bool use_endian_switch = false;
 #endif
+  MOD_meshcache_read_cos(vertexCos, file_cos, mdd_head.verts_tot, factor, use_endian_switch);
 
-      vco[0] = (vco[0] * ifactor) + (tvec[0] * factor);
-      vco[1] = (vco[1] * ifactor) + (tvec[1] * factor);
-      vco[2] = (vco[2] * ifactor) + (tvec[2] * factor);
-    }
-  }
-
-  if (num_verts_read != mdd_head.verts_tot) {
-    *err_str = errno ? strerror(errno) : "Vertex coordinate read failed";
+  if (BLI_mmap_any_io_error(file)) {
+    *err_str = "Vertex coordinate read failed";
     return false;
   }
 
   return true;
 }
 
-bool MOD_meshcache_read_mdd_frame(FILE *fp,
+bool MOD_meshcache_read_mdd_frame(BLI_mmap_file *file,
                                   float (*vertexCos)[3],
                                   const int verts_tot,
                                   const char interp,
@@ -238,7 +201,7 @@ bool MOD_meshcache_read_mdd_frame(FILE *fp,
   int index_range[2];
   float factor;
 
-  if (meshcache_read_mdd_range(fp,
+  if (meshcache_read_mdd_range(file,
                                verts_tot,
                                frame,
                                interp,
@@ -250,23 +213,12 @@ bool MOD_meshcache_read_mdd_frame(FILE *fp,
 
   if (index_range[0] == index_range[1]) {
     /* read single */
-    if ((BLI_fseek(fp, 0, SEEK_SET) == 0) &&
-        MOD_meshcache_read_mdd_index(fp, vertexCos, verts_tot, index_range[0], 1.0f, err_str)) {
-      return true;
-    }
-
-    return false;
+    return MOD_meshcache_read_mdd_index(file, vertexCos, verts_tot, index_range[0], 1.0f, err_str);
   }
 
   /* read both and interpolate */
-  if ((BLI_fseek(fp, 0, SEEK_SET) == 0) &&
-      MOD_meshcache_read_mdd_index(fp, vertexCos, verts_tot, index_range[0], 1.0f, err_str) &&
-      (BLI_fseek(fp, 0, SEEK_SET) == 0) &&
-      MOD_meshcache_read_mdd_index(fp, vertexCos, verts_tot, index_range[1], factor, err_str)) {
-    return true;
-  }
-
-  return false;
+  return MOD_meshcache_read_mdd_index(file, vertexCos, verts_tot, index_range[0], 1.0f, err_str) &&
+         MOD_meshcache_read_mdd_index(file, vertexCos, verts_tot, index_range[1], factor, err_str);
 }
 
 bool MOD_meshcache_read_mdd_times(const char *filepath,
@@ -280,10 +232,10 @@ bool MOD_meshcache_read_mdd_times(const char *filepath,
 {
   float frame;
 
-  FILE *fp = BLI_fopen(filepath, "rb");
+  BLI_mmap_file *file = BLI_mmap_open_path(filepath);
   bool ok;
 
-  if (fp == NULL) {
+  if (file == NULL) {
     *err_str = errno ? strerror(errno) : "Unknown error opening file";
     return false;
   }
@@ -295,29 +247,28 @@ bool MOD_meshcache_read_mdd_times(const char *filepath,
     }
     case MOD_MESHCACHE_TIME_SECONDS: {
       /* we need to find the closest time */
-      if (meshcache_read_mdd_range_from_time(fp, verts_tot, time, fps, &frame, err_str) == false) {
-        fclose(fp);
+      if (meshcache_read_mdd_range_from_time(file, verts_tot, time, fps, &frame, err_str) ==
+          false) {
+        BLI_mmap_free(file);
         return false;
       }
-      rewind(fp);
       break;
     }
     case MOD_MESHCACHE_TIME_FACTOR:
     default: {
       MDDHead mdd_head;
-      if (meshcache_read_mdd_head(fp, verts_tot, &mdd_head, err_str) == false) {
-        fclose(fp);
+      if (meshcache_read_mdd_head(file, verts_tot, &mdd_head, err_str) == false) {
+        BLI_mmap_free(file);
         return false;
       }
 
       frame = CLAMPIS(time, 0.0f, 1.0f) * (float)mdd_head.frame_tot;
-      rewind(fp);
       break;
     }
   }
 
-  ok = MOD_meshcache_read_mdd_frame(fp, vertexCos, verts_tot, interp, frame, err_str);
+  ok = MOD_meshcache_read_mdd_frame(file, vertexCos, verts_tot, interp, frame, err_str);
 
-  fclose(fp);
+  BLI_mmap_free(file);
   return ok;
 }
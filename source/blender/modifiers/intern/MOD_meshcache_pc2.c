@@ -19,20 +19,15 @@
  */
 
 #include <errno.h>
-#include <stdio.h>
 #include <string.h>
 
 #include "BLI_utildefines.h"
 
-#include "BLI_fileops.h"
+#include "BLI_mmap.h"
 #ifdef __BIG_ENDIAN__
 #  include "BLI_endian_switch.h"
 #endif
 
-#ifdef WIN32
-#  include "BLI_winstuff.h"
-#endif
-
 #include "DNA_modifier_types.h"
 
 #include "MOD_meshcache_util.h" /* own include */
@@ -46,12 +41,12 @@ typedef struct PC2Head {
   int frame_tot;
 } PC2Head; /* frames, verts */
 
-static bool meshcache_read_pc2_head(FILE *fp,
+static bool meshcache_read_pc2_head(BLI_mmap_file *file,
                                     const int verts_tot,
                                     PC2Head *pc2_head,
                                     const char **err_str)
 {
-  if (!fread(pc2_head, sizeof(*pc2_head), 1, fp)) {
+  if (!BLI_mmap_read(file, pc2_head, 0, sizeof(*pc2_head))) {
     *err_str = "Missing header";
     return false;
   }
@@ -75,7 +70,6 @@ static bool meshcache_read_pc2_head(FILE *fp,
     *err_str = "Invalid frame total";
     return false;
   }
-  /* intentionally dont seek back */
 
   return true;
 }
@@ -85,7 +79,7 @@ static bool meshcache_read_pc2_head(FILE *fp,
  *
  * currently same as for MDD
  */
-static bool meshcache_read_pc2_range(FILE *fp,
+static bool meshcache_read_pc2_range(BLI_mmap_file *file,
                                      const int verts_tot,
                                      const float frame,
                                      const char interp,
@@ -97,7 +91,7 @@ static bool meshcache_read_pc2_range(FILE *fp,
 
   /* first check interpolation and get the vert locations */
 
-  if (meshcache_read_pc2_head(fp, verts_tot, &pc2_head, err_str) == false) {
+  if (meshcache_read_pc2_head(file, verts_tot, &pc2_head, err_str) == false) {
     return false;
   }
 
@@ -106,7 +100,7 @@ static bool meshcache_read_pc2_range(FILE *fp,
   return true;
 }
 
-static bool meshcache_read_pc2_range_from_time(FILE *fp,
+static bool meshcache_read_pc2_range_from_time(BLI_mmap_file *file,
                                                const int verts_tot,
                                                const float time,
                                                const float fps,
@@ -116,7 +110,7 @@ static bool meshcache_read_pc2_range_from_time(FILE *fp,
   PC2Head pc2_head;
   float frame;
 
-  if (meshcache_read_pc2_head(fp, verts_tot, &pc2_head, err_str) == false) {
+  if (meshcache_read_pc2_head(file, verts_tot, &pc2_head, err_str) == false) {
     return false;
   }
 
@@ -133,7 +127,7 @@ static bool meshcache_read_pc2_range_from_time(FILE *fp,
   return true;
 }
 
-bool MOD_meshcache_read_pc2_index(FILE *fp,
+bool MOD_meshcache_read_pc2_index(BLI_mmap_file *file,
                                   float (*vertexCos)[3],
                                   const int verts_tot,
                                   const int index,
@@ -142,59 +136,37 @@ bool MOD_meshcache_read_pc2_index(FILE *fp,
 {
   PC2Head pc2_head;
 
-  if (meshcache_read_pc2_head(fp, verts_tot, &pc2_head, err_str) == false) {
+  if (meshcache_read_pc2_head(file, verts_tot, &pc2_head, err_str) == false) {
     return false;
   }
 
-  if (BLI_fseek(fp, sizeof(float[3]) * index * pc2_head.verts_tot, SEEK_CUR) != 0) {
-    *err_str = "Failed to seek frame";
+  /* The coordinates are read directly from the mapped file, only the pages of this frame have to
+   * be loaded from disk. */
+  const size_t frame_size = sizeof(float[3]) * (size_t)pc2_head.verts_tot;
+  const size_t frame_offset = sizeof(pc2_head) + frame_size * (size_t)index;
+  if (frame_offset + frame_size > BLI_mmap_get_length(file)) {
+    *err_str = "Vertex coordinate read failed";
     return false;
   }
-
-  size_t num_verts_read = 0;
-  errno = 0;
-  if (factor >= 1.0f) {
-    float *vco = *vertexCos;
-    uint i;
-    for (i = pc2_head.verts_tot; i != 0; i--, vco += 3) {
-      num_verts_read += fread(vco, sizeof(float[3]), 1, fp);
-
-#ifdef __BIG_ENDIAN__
-      BLI_endian_switch_float(vco + 0);
-      BLI_endian_switch_float(vco + 1);
-      BLI_endian_switch_float(vco + 2);
-#endif /* __BIG_ENDIAN__ */
-    }
-  }
-  else {
-    const float ifactor = 1.0f - factor;
-    float *vco = *vertexCos;
-    uint i;
-    for (i = pc2_head.verts_tot; i != 0; i--, vco += 3) {
-      float tvec[3];
-      num_verts_read += fread(tvec, sizeof(float[3]), 1, fp);
+  const float(*file_cos)[3] = (const float(*)[3])((const char *)BLI_mmap_get_pointer(file) +
+                                                   frame_offset);
 
 #ifdef __BIG_ENDIAN__
-      BLI_endian_switch_float(tvec + 0);
-      BLI_endian_switch_float(tvec + 1);
-      BLI_endian_switch_float(tvec + 2);
-#endif /* __BIG_ENDIAN__ */
-
-      vco[0] = (vco[0] * ifactor) + (tvec[0] * factor);
-      vco[1] = (vco[1] * ifactor) + (tvec[1] * factor);
-      vco[2] = (vco[2] * ifactor) + (tvec[2] * factor);
-    }
-  }
+  const bool use_endian_switch = true;
+#else
+  const bool use_endian_switch = false;
+#endif
+  MOD_meshcache_read_cos(vertexCos, file_cos, pc2_head.verts_tot, factor, use_endian_switch);
 
-  if (num_verts_read != pc2_head.verts_tot) {
-    *err_str = errno ? strerror(errno) : "Vertex coordinate read failed";
+  if (BLI_mmap_any_io_error(file)) {
+    *err_str = "Vertex coordinate read failed";
     return false;
   }
 
   return true;
 }
 
-bool MOD_meshcache_read_pc2_frame(FILE *fp,
+bool MOD_meshcache_read_pc2_frame(BLI_mmap_file *file,
                                   float (*vertexCos)[3],
                                   const int verts_tot,
                                   const char interp,
@@ -204,7 +176,7 @@ bool MOD_meshcache_read_pc2_frame(FILE *fp,
   int index_range[2];
   float factor;
 
-  if (meshcache_read_pc2_range(fp,
+  if (meshcache_read_pc2_range(file,
                                verts_tot,
                                frame,
                                interp,
@@ -216,23 +188,12 @@ bool MOD_meshcache_read_pc2_frame(FILE *fp,
 
   if (index_range[0] == index_range[1]) {
     /* read single */
-    if ((BLI_fseek(fp, 0, SEEK_SET) == 0) &&
-        MOD_meshcache_read_pc2_index(fp, vertexCos, verts_tot, index_range[0], 1.0f, err_str)) {
-      return true;
-    }
-
-    return false;
+    return MOD_meshcache_read_pc2_index(file, vertexCos, verts_tot, index_range[0], 1.0f, err_str);
   }
 
   /* read both and interpolate */
-  if ((BLI_fseek(fp, 0, SEEK_SET) == 0) &&
-      MOD_meshcache_read_pc2_index(fp, vertexCos, verts_tot, index_range[0], 1.0f, err_str) &&
-      (BLI_fseek(fp, 0, SEEK_SET) == 0) &&
-      MOD_meshcache_read_pc2_index(fp, vertexCos, verts_tot, index_range[1], factor, err_str)) {
-    return true;
-  }
-
-  return false;
+  return MOD_meshcache_read_pc2_index(file, vertexCos, verts_tot, index_range[0], 1.0f, err_str) &&
+         MOD_meshcache_read_pc2_index(file, vertexCos, verts_tot, index_range[1], factor, err_str);
 }
 
 bool MOD_meshcache_read_pc2_times(const char *filepath,
@@ -246,10 +207,10 @@ bool MOD_meshcache_read_pc2_times(const char *filepath,
 {
   float frame;
 
-  FILE *fp = BLI_fopen(filepath, "rb");
+  BLI_mmap_file *file = BLI_mmap_open_path(filepath);
   bool ok;
 
-  if (fp == NULL) {
+  if (file == NULL) {
     *err_str = errno ? strerror(errno) : "Unknown error opening file";
     return false;
   }
@@ -261,29 +222,28 @@ bool MOD_meshcache_read_pc2_times(const char *filepath,
     }
     case MOD_MESHCACHE_TIME_SECONDS: {
       /* we need to find the closest time */
-      if (meshcache_read_pc2_range_from_time(fp, verts_tot, time, fps, &frame, err_str) == false) {
-        fclose(fp);
+      if (meshcache_read_pc2_range_from_time(file, verts_tot, time, fps, &frame, err_str) ==
+          false) {
+        BLI_mmap_free(file);
         return false;
       }
-      rewind(fp);
       break;
     }
     case MOD_MESHCACHE_TIME_FACTOR:
     default: {
       PC2Head pc2_head;
-      if (meshcache_read_pc2_head(fp, verts_tot, &pc2_head, err_str) == false) {
-        fclose(fp);
+      if (meshcache_read_pc2_head(file, verts_tot, &pc2_head, err_str) == false) {
+        BLI_mmap_free(file);
         return false;
       }
 
       frame = CLAMPIS(time, 0.0f, 1.0f) * (float)pc2_head.frame_tot;
-      rewind(fp);
       break;
     }
   }
 
-  ok = MOD_meshcache_read_pc2_frame(fp, vertexCos, verts_tot, interp, frame, err_str);
+  ok = MOD_meshcache_read_pc2_frame(file, vertexCos, verts_tot, interp, frame, err_str);
 
-  fclose(fp);
+  BLI_mmap_free(file);
   return ok;
 }
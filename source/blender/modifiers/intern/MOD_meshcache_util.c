@@ -20,7 +20,9 @@
 
 #include "BLI_utildefines.h"
 
+#include "BLI_endian_switch.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "DNA_modifier_types.h"
 
@@ -62,3 +64,50 @@ void MOD_meshcache_calc_range(const float frame,
     }
   }
 }
+
+typedef struct MeshCacheReadCosData {
+  float (*vertexCos)[3];
+  const float (*file_cos)[3];
+  float factor;
+  bool use_endian_switch;
+} MeshCacheReadCosData;
+
+static void meshcache_read_cos_cb(void *__restrict userdata,
+                                  const int i,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const MeshCacheReadCosData *data = userdata;
+  float co[3];
+
+  copy_v3_v3(co, data->file_cos[i]);
+  if (data->use_endian_switch) {
+    BLI_endian_switch_float_array(co, 3);
+  }
+
+  if (data->factor >= 1.0f) {
+    copy_v3_v3(data->vertexCos[i], co);
+  }
+  else {
+    interp_v3_v3v3(data->vertexCos[i], data->vertexCos[i], co, data->factor);
+  }
+}
+
+void MOD_meshcache_read_cos(float (*vertexCos)[3],
+                            const float (*file_cos)[3],
+                            const int verts_tot,
+                            const float factor,
+                            const bool use_endian_switch)
+{
+  MeshCacheReadCosData data = {
+      .vertexCos = vertexCos,
+      .file_cos = file_cos,
+      .factor = factor,
+      .use_endian_switch = use_endian_switch,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (verts_tot > 10000);
+  settings.min_iter_per_thread = 4096;
+  BLI_task_parallel_range(0, verts_tot, &data, meshcache_read_cos_cb, &settings);
+}
@@ -20,14 +20,16 @@
 
 #pragma once
 
+struct BLI_mmap_file;
+
 /* MOD_meshcache_mdd.c */
-bool MOD_meshcache_read_mdd_index(FILE *fp,
+bool MOD_meshcache_read_mdd_index(struct BLI_mmap_file *file,
                                   float (*vertexCos)[3],
                                   const int vertex_tot,
                                   const int index,
                                   const float factor,
                                   const char **err_str);
-bool MOD_meshcache_read_mdd_frame(FILE *fp,
+bool MOD_meshcache_read_mdd_frame(struct BLI_mmap_file *file,
                                   float (*vertexCos)[3],
                                   const int verts_tot,
                                   const char interp,
@@ -43,13 +45,13 @@ bool MOD_meshcache_read_mdd_times(const char *filepath,
                                   const char **err_str);
 
 /* MOD_meshcache_pc2.c */
-bool MOD_meshcache_read_pc2_index(FILE *fp,
+bool MOD_meshcache_read_pc2_index(struct BLI_mmap_file *file,
                                   float (*vertexCos)[3],
                                   const int verts_tot,
                                   const int index,
                                   const float factor,
                                   const char **err_str);
-bool MOD_meshcache_read_pc2_frame(FILE *fp,
+bool MOD_meshcache_read_pc2_frame(struct BLI_mmap_file *file,
                                   float (*vertexCos)[3],
                                   const int verts_tot,
                                   const char interp,
@@ -70,5 +72,14 @@ void MOD_meshcache_calc_range(const float frame,
                               const int frame_tot,
                               int r_index_range[2],
                               float *r_factor);
+/**
+ * Copy (or blend by \a factor) the coordinates of one frame of a mapped cache file into
+ * \a vertexCos, optionally switching their byte order. Large frames are converted in parallel.
+ */
+void MOD_meshcache_read_cos(float (*vertexCos)[3],
+                            const float (*file_cos)[3],
+                            const int verts_tot,
+                            const float factor,
+                            const bool use_endian_switch);
 
 #define FRAME_SNAP_EPS 0.0001f
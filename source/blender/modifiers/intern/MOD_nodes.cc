@@ -21,16 +21,23 @@
  * \ingroup modifiers
  */
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 
 #include "MEM_guardedalloc.h"
 
 #include "BLI_float3.hh"
+#include "BLI_hash_mm2a.h"
 #include "BLI_listbase.h"
 #include "BLI_set.hh"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_collection_types.h"
@@ -50,6 +57,7 @@
 #include "BKE_lib_query.h"
 #include "BKE_mesh.h"
 #include "BKE_modifier.h"
+#include "BKE_node.h"
 #include "BKE_pointcloud.h"
 #include "BKE_screen.h"
 #include "BKE_simulation.h"
@@ -65,12 +73,15 @@
 #include "DEG_depsgraph_build.h"
 #include "DEG_depsgraph_query.h"
 
+#include "PIL_time.h"
+
 #include "MOD_modifiertypes.h"
 #include "MOD_nodes.h"
 #include "MOD_ui_common.h"
 
 #include "NOD_derived_node_tree.hh"
 #include "NOD_geometry.h"
+#include "NOD_geometry_attribute_network.hh"
 #include "NOD_geometry_exec.hh"
 #include "NOD_node_tree_multi_function.hh"
 #include "NOD_type_callbacks.hh"
@@ -84,8 +95,11 @@ using blender::StringRef;
 using blender::Vector;
 using blender::bke::PersistentCollectionHandle;
 using blender::bke::PersistentDataHandleMap;
+using blender::bke::PersistentIDHandle;
 using blender::bke::PersistentObjectHandle;
+using blender::bke::ReadAttributePtr;
 using blender::fn::GMutablePointer;
+using blender::fn::GPointer;
 using blender::fn::GValueMap;
 using blender::nodes::GeoNodeExecParams;
 using namespace blender::nodes::derived_node_tree_types;
@@ -212,16 +226,267 @@ static bool isDisabled(const struct Scene *UNUSED(scene),
   return false;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Evaluation Cache
+ * \{ */
+
+/* Combine the hash of a value that influences the result of a node into its cache key. */
+static uint64_t cache_key_combine(const uint64_t key, const uint64_t value)
+{
+  return key ^ (value + 0x9e3779b97f4a7c15ull + (key << 6) + (key >> 2));
+}
+
+static uint64_t cache_key_from_bytes(const void *data, const size_t size)
+{
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  return (static_cast<uint64_t>(BLI_hash_mm2(bytes, size, 0)) << 32) |
+         BLI_hash_mm2(bytes, size, 1);
+}
+
+static uint64_t cache_key_from_string(const StringRef str)
+{
+  return blender::DefaultHash<StringRef>{}(str);
+}
+
+static uint64_t hash_component_attributes(const GeometryComponent &component)
+{
+  uint64_t key = 0;
+  for (const std::string &name : component.attribute_names()) {
+    ReadAttributePtr attribute = component.attribute_try_get_for_read(name);
+    if (!attribute) {
+      continue;
+    }
+    const blender::fn::GSpan span = attribute->get_span();
+    key = cache_key_combine(key, cache_key_from_string(name));
+    key = cache_key_combine(key, attribute->domain());
+    key = cache_key_combine(key, attribute->custom_data_type());
+    key = cache_key_combine(key,
+                            cache_key_from_bytes(span.data(), span.type().size() * span.size()));
+  }
+  return key;
+}
+
+/**
+ * Hash the data of a geometry, to detect whether the geometry passed to the modifier changed
+ * since the previous evaluation. Nothing is returned for component types that are not supported,
+ * the nodes using the geometry are not cached then.
+ */
+static std::optional<uint64_t> hash_geometry_set(const GeometrySet &geometry_set)
+{
+  if (geometry_set.has_instances() || geometry_set.has_volume()) {
+    return std::nullopt;
+  }
+
+  uint64_t key = 0;
+  const MeshComponent *mesh_component = geometry_set.get_component_for_read<MeshComponent>();
+  if (mesh_component != nullptr && mesh_component->has_mesh()) {
+    const Mesh *mesh = mesh_component->get_for_read();
+    key = cache_key_combine(key, cache_key_from_bytes(mesh->mvert, sizeof(MVert) * mesh->totvert));
+    key = cache_key_combine(key, cache_key_from_bytes(mesh->medge, sizeof(MEdge) * mesh->totedge));
+    key = cache_key_combine(key, cache_key_from_bytes(mesh->mpoly, sizeof(MPoly) * mesh->totpoly));
+    key = cache_key_combine(key, cache_key_from_bytes(mesh->mloop, sizeof(MLoop) * mesh->totloop));
+    key = cache_key_combine(key, hash_component_attributes(*mesh_component));
+  }
+  const PointCloudComponent *pointcloud_component =
+      geometry_set.get_component_for_read<PointCloudComponent>();
+  if (pointcloud_component != nullptr && pointcloud_component->has_pointcloud()) {
+    key = cache_key_combine(key, hash_component_attributes(*pointcloud_component));
+  }
+  return key;
+}
+
+/* Data-blocks used in node settings, like the texture of the Attribute Sample Texture node. */
+static void find_used_ids_from_node_settings(const bNodeTree &tree, Set<ID *> &ids)
+{
+  Set<const bNodeTree *> handled_groups;
+
+  LISTBASE_FOREACH (const bNode *, node, &tree.nodes) {
+    if (node->id == nullptr) {
+      continue;
+    }
+    if (node->type == NODE_GROUP) {
+      const bNodeTree *group = (bNodeTree *)node->id;
+      if (handled_groups.add(group)) {
+        find_used_ids_from_node_settings(*group, ids);
+      }
+    }
+    else {
+      ids.add(node->id);
+    }
+  }
+}
+
+/**
+ * Outputs of geometry nodes from the previous evaluation of the modifier, so that only the nodes
+ * whose inputs changed have to be executed again, e.g. when only the end of the tree depends on
+ * time. Values are identified by keys computed from the settings of the nodes and the keys of
+ * their inputs, see #GeometryNodesEvaluator. This is stored as runtime data of the modifier.
+ */
+class GeometryNodesCache {
+ private:
+  struct CachedValue {
+    const CPPType *type;
+    void *buffer;
+    bool is_used;
+  };
+
+  Map<uint64_t, CachedValue> values_;
+  std::mutex mutex_;
+
+  /* Increased whenever a data-block used by the nodes is tagged for an update. */
+  Map<const ID *, int> id_versions_;
+  int self_object_version_ = 0;
+  uint64_t ids_key_ = 0;
+
+ public:
+  ~GeometryNodesCache()
+  {
+    for (CachedValue &value : values_.values()) {
+      this->free_value(value);
+    }
+  }
+
+  /**
+   * Detect changes of the data-blocks used by the nodes, based on the depsgraph update tags of
+   * the current evaluation. The self object only matters for its transform.
+   */
+  void update_ids(const Set<ID *> &ids, const Object &self_object)
+  {
+    Map<const ID *, int> new_id_versions;
+    uint64_t ids_key = 0;
+    for (const ID *id : ids) {
+      const int version = id_versions_.lookup_default(id, 0) + ((id->recalc != 0) ? 1 : 0);
+      new_id_versions.add_new(id, version);
+      /* The order of the set is arbitrary, so combine the keys in a way that doesn't depend
+       * on it. */
+      ids_key ^= cache_key_combine(blender::DefaultHash<const ID *>{}(id), version);
+    }
+    id_versions_ = std::move(new_id_versions);
+
+    if (self_object.id.recalc & ID_RECALC_TRANSFORM) {
+      self_object_version_++;
+    }
+    ids_key_ = cache_key_combine(ids_key, self_object_version_);
+  }
+
+  /** Key combined with the keys of nodes that use data-blocks. */
+  uint64_t ids_key() const
+  {
+    return ids_key_;
+  }
+
+  /**
+   * Copy the cached value into the uninitialized buffer. Returns false when there is no value
+   * for the key.
+   */
+  bool lookup(const uint64_t key, const CPPType &type, void *r_buffer)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CachedValue *value = values_.lookup_ptr(key);
+    if (value == nullptr || *value->type != type) {
+      return false;
+    }
+    type.copy_to_uninitialized(value->buffer, r_buffer);
+    value->is_used = true;
+    return true;
+  }
+
+  void add(const uint64_t key, const GPointer value)
+  {
+    const CPPType &type = *value.type();
+    void *buffer = MEM_mallocN_aligned(type.size(), type.alignment(), __func__);
+    type.copy_to_uninitialized(value.get(), buffer);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    CachedValue *existing_value = values_.lookup_ptr(key);
+    if (existing_value != nullptr) {
+      this->free_value(*existing_value);
+    }
+    values_.add_overwrite(key, {&type, buffer, true});
+  }
+
+  /** Free the values that have not been used by the last evaluation. */
+  void remove_unused()
+  {
+    Vector<uint64_t> unused_keys;
+    for (auto item : values_.items()) {
+      if (item.value.is_used) {
+        item.value.is_used = false;
+      }
+      else {
+        unused_keys.append(item.key);
+      }
+    }
+    for (const uint64_t key : unused_keys) {
+      CachedValue value = values_.pop(key);
+      this->free_value(value);
+    }
+  }
+
+ private:
+  void free_value(CachedValue &value)
+  {
+    value.type->destruct(value.buffer);
+    MEM_freeN(value.buffer);
+  }
+};
+
+/** \} */
+
+/**
+ * Evaluates the nodes required to compute the group outputs. Every node is executed once, as a
+ * task that is scheduled as soon as all the nodes it gets inputs from have been executed, so
+ * independent branches of the tree are evaluated in parallel.
+ *
+ * Every value gets a key that identifies how it was computed, if possible. Geometry outputs are
+ * looked up in the #GeometryNodesCache with that key before executing a node.
+ */
 class GeometryNodesEvaluator {
  private:
+  /** Evaluation state of a node that has to be executed. */
+  struct NodeState {
+    const DNode *node;
+    /** Number of nodes this node gets inputs from, that have not been executed yet. */
+    std::atomic<int> missing_dependencies{0};
+    /** Nodes that get inputs from this node. */
+    Vector<NodeState *> dependents;
+    /**
+     * Values computed while executing the node are allocated here, since the allocator of the
+     * evaluator can't be used from multiple threads. Values are only destructed at the end of
+     * the evaluation, after all tasks have finished.
+     */
+    blender::LinearAllocator<> allocator;
+    /**
+     * Set when the node is part of a chain of attribute nodes that pass their geometry to each
+     * other, which is evaluated at once by the last node, see #execute_attribute_chain.
+     */
+    NodeState *chain_previous = nullptr;
+    NodeState *chain_next = nullptr;
+    /** Inputs of the node, when it is evaluated as part of a chain. */
+    std::unique_ptr<GValueMap<StringRef>> chain_inputs;
+    /** Combined key of the node settings and inputs, unset when an input has no key. */
+    std::optional<uint64_t> key;
+    /** Time spent executing the node in seconds, see #store_exec_stats. */
+    double execution_time = 0.0;
+    /** Number of points and instances in the geometry outputs of the node. */
+    uint64_t output_elements = 0;
+  };
+
   blender::LinearAllocator<> allocator_;
   Map<const DInputSocket *, GMutablePointer> value_by_input_;
+  Map<const DInputSocket *, uint64_t> key_by_input_;
+  /** Protects #value_by_input_ and #key_by_input_. */
+  std::mutex value_by_input_mutex_;
+  Map<const DNode *, std::unique_ptr<NodeState>> node_states_;
+  Set<const DOutputSocket *> unavailable_outputs_;
   Vector<const DInputSocket *> group_outputs_;
   blender::nodes::MultiFunctionByNode &mf_by_node_;
   const blender::nodes::DataTypeConversions &conversions_;
   const PersistentDataHandleMap &handle_map_;
   const Object *self_object_;
   Depsgraph *depsgraph_;
+  /** Null when the results of the evaluation should not be cached. */
+  GeometryNodesCache *cache_;
 
  public:
   GeometryNodesEvaluator(const Map<const DOutputSocket *, GMutablePointer> &group_input_data,
@@ -229,24 +494,44 @@ class GeometryNodesEvaluator {
                          blender::nodes::MultiFunctionByNode &mf_by_node,
                          const PersistentDataHandleMap &handle_map,
                          const Object *self_object,
-                         Depsgraph *depsgraph)
+                         Depsgraph *depsgraph,
+                         GeometryNodesCache *cache)
       : group_outputs_(std::move(group_outputs)),
         mf_by_node_(mf_by_node),
         conversions_(blender::nodes::get_implicit_type_conversions()),
         handle_map_(handle_map),
         self_object_(self_object),
-        depsgraph_(depsgraph)
+        depsgraph_(depsgraph),
+        cache_(cache)
   {
     for (auto item : group_input_data.items()) {
-      this->forward_to_inputs(*item.key, item.value);
+      const std::optional<uint64_t> key = this->hash_value(item.value);
+      this->forward_to_inputs(*item.key, item.value, allocator_, key);
     }
   }
 
   Vector<GMutablePointer> execute()
   {
+    /* Find the nodes that have to be executed and how they depend on each other. */
+    for (const DInputSocket *group_output : group_outputs_) {
+      this->add_required_input(*group_output, nullptr);
+    }
+    this->find_attribute_chains();
+
+    /* If an output is not available, use a default value. */
+    for (const DOutputSocket *socket : unavailable_outputs_) {
+      const CPPType &type = *blender::nodes::socket_cpp_type_get(*socket->typeinfo());
+      void *buffer = allocator_.allocate(type.size(), type.alignment());
+      type.copy_to_uninitialized(type.default_value(), buffer);
+      const std::optional<uint64_t> key = this->hash_value({type, buffer});
+      this->forward_to_inputs(*socket, {type, buffer}, allocator_, key);
+    }
+
+    this->execute_nodes();
+
     Vector<GMutablePointer> results;
     for (const DInputSocket *group_output : group_outputs_) {
-      GMutablePointer result = this->get_input_value(*group_output);
+      GMutablePointer result = this->get_input_value(*group_output, allocator_);
       results.append(result);
     }
     for (GMutablePointer value : value_by_input_.values()) {
@@ -255,74 +540,541 @@ class GeometryNodesEvaluator {
     return results;
   }
 
- private:
-  GMutablePointer get_input_value(const DInputSocket &socket_to_compute)
+  /**
+   * Store the execution time and the number of output elements of every executed node in the
+   * original node trees, so that they can be displayed in the node editor. The time of nodes in
+   * groups is added to the group nodes as well.
+   */
+  void store_exec_stats() const
   {
-    std::optional<GMutablePointer> value = value_by_input_.pop_try(&socket_to_compute);
-    if (value.has_value()) {
-      /* This input has been computed before, return it directly. */
-      return *value;
+    Map<bNode *, bNodeExecStats> stats_by_node;
+    Set<bNodeTree *> trees;
+    for (const std::unique_ptr<NodeState> &state : node_states_.values()) {
+      const DNode &node = *state->node;
+      bNode *orig_node = find_original_node(node.node_ref().btree(), *node.bnode(), trees);
+      if (orig_node != nullptr) {
+        bNodeExecStats &stats = stats_by_node.lookup_or_add_default(orig_node);
+        stats.time += state->execution_time;
+        stats.elements += state->output_elements;
+      }
+      for (const DParentNode *parent = node.parent(); parent != nullptr;
+           parent = parent->parent()) {
+        const blender::nodes::NodeRef &group_node = parent->node_ref();
+        bNode *orig_group_node = find_original_node(
+            group_node.btree(), *group_node.bnode(), trees);
+        if (orig_group_node != nullptr) {
+          stats_by_node.lookup_or_add_default(orig_group_node).time += state->execution_time;
+        }
+      }
+    }
+
+    /* Objects using the same node group can be evaluated at the same time. */
+    static std::mutex mutex;
+    std::lock_guard lock{mutex};
+    for (bNodeTree *btree : trees) {
+      LISTBASE_FOREACH (bNode *, bnode, &btree->nodes) {
+        memset(&bnode->exec_stats, 0, sizeof(bnode->exec_stats));
+      }
+    }
+    for (auto item : stats_by_node.items()) {
+      item.key->exec_stats = item.value;
     }
+  }
 
-    Span<const DOutputSocket *> from_sockets = socket_to_compute.linked_sockets();
-    Span<const DGroupInput *> from_group_inputs = socket_to_compute.linked_group_inputs();
-    const int total_inputs = from_sockets.size() + from_group_inputs.size();
-    BLI_assert(total_inputs <= 1);
+ private:
+  /** Find the node in the original tree, since the evaluated tree is a copy. */
+  static bNode *find_original_node(bNodeTree *btree, const bNode &bnode, Set<bNodeTree *> &r_trees)
+  {
+    bNodeTree *orig_btree = (bNodeTree *)DEG_get_original_id(&btree->id);
+    r_trees.add(orig_btree);
+    return nodeFindNodebyName(orig_btree, bnode.name);
+  }
 
-    if (total_inputs == 0) {
-      /* The input is not connected, use the value from the socket itself. */
-      return get_unlinked_input_value(socket_to_compute);
+  static uint64_t geometry_set_elements_amount(const GeometrySet &geometry_set)
+  {
+    uint64_t amount = 0;
+    for (const GeometryComponentType type : {GeometryComponentType::Mesh,
+                                             GeometryComponentType::PointCloud,
+                                             GeometryComponentType::Instances}) {
+      /* Avoid joining the components only to count their elements. */
+      Vector<const GeometryComponent *> components = geometry_set.components_to_join(type);
+      if (components.is_empty() && geometry_set.has(type)) {
+        components.append(geometry_set.get_component_for_read(type));
+      }
+      for (const GeometryComponent *component : components) {
+        if (type == GeometryComponentType::Instances) {
+          amount += static_cast<const InstancesComponent *>(component)->instances_amount();
+        }
+        else {
+          amount += component->attribute_domain_size(ATTR_DOMAIN_POINT);
+        }
+      }
     }
-    if (from_group_inputs.size() == 1) {
-      /* The input gets its value from the input of a group that is not further connected. */
-      return get_unlinked_input_value(socket_to_compute);
+    return amount;
+  }
+
+  /**
+   * Make sure the node computing the value of the input is executed before the dependent node,
+   * or before the group outputs are retrieved when it is null.
+   */
+  void add_required_input(const DInputSocket &socket, NodeState *dependent)
+  {
+    Span<const DOutputSocket *> from_sockets = socket.linked_sockets();
+    BLI_assert(from_sockets.size() + socket.linked_group_inputs().size() <= 1);
+
+    if (from_sockets.size() == 0) {
+      /* The value comes from the socket itself or from a group input. */
+      return;
     }
 
-    /* Compute the socket now. */
     const DOutputSocket &from_socket = *from_sockets[0];
-    this->compute_output_and_forward(from_socket);
-    return value_by_input_.pop(&socket_to_compute);
+    if (!from_socket.is_available()) {
+      unavailable_outputs_.add(&from_socket);
+      return;
+    }
+
+    NodeState &state = this->ensure_node_state(from_socket.node());
+    if (dependent != nullptr && !state.dependents.contains(dependent)) {
+      state.dependents.append(dependent);
+      dependent->missing_dependencies++;
+    }
+  }
+
+  NodeState &ensure_node_state(const DNode &node)
+  {
+    std::unique_ptr<NodeState> *existing_state = node_states_.lookup_ptr(&node);
+    if (existing_state != nullptr) {
+      return **existing_state;
+    }
+
+    NodeState *state = new NodeState();
+    state->node = &node;
+    node_states_.add_new(&node, std::unique_ptr<NodeState>(state));
+
+    for (const DInputSocket *input_socket : node.inputs()) {
+      if (input_socket->is_available()) {
+        this->add_required_input(*input_socket, state);
+      }
+    }
+    return *state;
+  }
+
+  /**
+   * Find attribute nodes that only pass their geometry to another attribute node, so that the
+   * result attributes of both can be computed in a single pass.
+   */
+  void find_attribute_chains()
+  {
+    for (const std::unique_ptr<NodeState> &state : node_states_.values()) {
+      const DOutputSocket *geometry_output = get_attribute_node_geometry_output(*state->node);
+      if (geometry_output == nullptr || geometry_output->linked_sockets().size() != 1) {
+        continue;
+      }
+      const DInputSocket &target_socket = *geometry_output->linked_sockets()[0];
+      const DNode &target_node = target_socket.node();
+      if (&target_socket != get_attribute_node_geometry_input(target_node) ||
+          get_attribute_node_geometry_output(target_node) == nullptr) {
+        continue;
+      }
+      std::unique_ptr<NodeState> *target_state = node_states_.lookup_ptr(&target_node);
+      if (target_state == nullptr) {
+        continue;
+      }
+      state->chain_next = target_state->get();
+      (*target_state)->chain_previous = state.get();
+    }
+  }
+
+  /**
+   * The geometry output of a node that can be evaluated in a #GeoNodeAttributeNetwork. That is
+   * the only output of such nodes.
+   */
+  static const DOutputSocket *get_attribute_node_geometry_output(const DNode &node)
+  {
+    if (node.bnode()->typeinfo->geometry_node_expand_attributes == nullptr) {
+      return nullptr;
+    }
+    if (node.outputs().size() != 1 || node.output(0).bsocket()->type != SOCK_GEOMETRY) {
+      return nullptr;
+    }
+    return &node.output(0);
+  }
+
+  static const DInputSocket *get_attribute_node_geometry_input(const DNode &node)
+  {
+    if (node.inputs().size() == 0 || node.input(0).bsocket()->type != SOCK_GEOMETRY) {
+      return nullptr;
+    }
+    return &node.input(0);
+  }
+
+  void execute_nodes()
+  {
+    /* Collect the nodes to start with first, since the counters of the others change as soon as
+     * the first tasks run. */
+    Vector<NodeState *> ready_states;
+    for (const std::unique_ptr<NodeState> &state : node_states_.values()) {
+      if (state->missing_dependencies == 0) {
+        ready_states.append(state.get());
+      }
+    }
+
+    TaskPool *task_pool = BLI_task_pool_create(this, TASK_PRIORITY_HIGH);
+    for (NodeState *state : ready_states) {
+      BLI_task_pool_push(task_pool, execute_node_task, state, false, nullptr);
+    }
+    BLI_task_pool_work_and_wait(task_pool);
+    BLI_task_pool_free(task_pool);
   }
 
-  void compute_output_and_forward(const DOutputSocket &socket_to_compute)
+  static void execute_node_task(TaskPool *__restrict task_pool, void *taskdata)
+  {
+    GeometryNodesEvaluator &evaluator = *(GeometryNodesEvaluator *)BLI_task_pool_user_data(
+        task_pool);
+    NodeState &state = *(NodeState *)taskdata;
+
+    evaluator.compute_node_and_forward(state);
+
+    /* Schedule the nodes that have all their inputs now. */
+    for (NodeState *dependent : state.dependents) {
+      if (dependent->missing_dependencies.fetch_sub(1) == 1) {
+        BLI_task_pool_push(task_pool, execute_node_task, dependent, false, nullptr);
+      }
+    }
+  }
+
+  GMutablePointer get_input_value(const DInputSocket &socket_to_compute,
+                                  blender::LinearAllocator<> &allocator,
+                                  std::optional<uint64_t> *r_key = nullptr)
+  {
+    {
+      std::lock_guard<std::mutex> lock(value_by_input_mutex_);
+      std::optional<GMutablePointer> value = value_by_input_.pop_try(&socket_to_compute);
+      if (value.has_value()) {
+        /* This input has been computed before, return it directly. */
+        std::optional<uint64_t> key = key_by_input_.pop_try(&socket_to_compute);
+        if (r_key != nullptr) {
+          *r_key = key;
+        }
+        return *value;
+      }
+    }
+
+    /* The input is not connected or gets its value from the input of a group that is not further
+     * connected. Linked values are always computed before they are used. */
+    BLI_assert(socket_to_compute.linked_sockets().size() == 0);
+    GMutablePointer value = get_unlinked_input_value(socket_to_compute, allocator);
+    if (r_key != nullptr) {
+      *r_key = this->hash_value(value);
+    }
+    return value;
+  }
+
+  /**
+   * Key of a value that does not depend on other nodes. Nothing is returned when the value
+   * can't be hashed reliably.
+   */
+  std::optional<uint64_t> hash_value(const GPointer value) const
+  {
+    const CPPType &type = *value.type();
+    uint64_t key = cache_key_from_string(type.name());
+    if (type.is<GeometrySet>()) {
+      std::optional<uint64_t> geometry_key = hash_geometry_set(*value.get<GeometrySet>());
+      if (!geometry_key.has_value()) {
+        return std::nullopt;
+      }
+      return cache_key_combine(key, *geometry_key);
+    }
+    /* Handles are only valid during one evaluation, use the data-block instead. */
+    if (type.is<PersistentObjectHandle>() || type.is<PersistentCollectionHandle>()) {
+      const ID *id = handle_map_.lookup(*(const PersistentIDHandle *)value.get());
+      key = cache_key_combine(key, blender::DefaultHash<const ID *>{}(id));
+      return key;
+    }
+    return cache_key_combine(key, type.hash(value.get()));
+  }
+
+  /**
+   * Key of everything that influences the outputs of the node, except for its inputs.
+   */
+  uint64_t node_settings_key(const DNode &node) const
   {
-    const DNode &node = socket_to_compute.node();
     const bNode &bnode = *node.bnode();
+    uint64_t key = cache_key_from_string(bnode.idname);
+    /* Identify the node instance, for nodes like Group Instance ID and random seeds. */
+    key = cache_key_combine(key, cache_key_from_string(bnode.name));
+    for (const DParentNode *parent = node.parent(); parent != nullptr; parent = parent->parent()) {
+      key = cache_key_combine(key, cache_key_from_string(parent->node_ref().bnode()->name));
+    }
+    key = cache_key_combine(key, bnode.custom1);
+    key = cache_key_combine(key, bnode.custom2);
+    key = cache_key_combine(key, cache_key_from_bytes(&bnode.custom3, sizeof(float)));
+    key = cache_key_combine(key, cache_key_from_bytes(&bnode.custom4, sizeof(float)));
+    if (bnode.storage != nullptr) {
+      key = cache_key_combine(key,
+                              cache_key_from_bytes(bnode.storage, MEM_allocN_len(bnode.storage)));
+    }
 
-    if (!socket_to_compute.is_available()) {
-      /* If the output is not available, use a default value. */
-      const CPPType &type = *blender::nodes::socket_cpp_type_get(*socket_to_compute.typeinfo());
-      void *buffer = allocator_.allocate(type.size(), type.alignment());
-      type.copy_to_uninitialized(type.default_value(), buffer);
-      this->forward_to_inputs(socket_to_compute, {type, buffer});
+    bool uses_ids = bnode.id != nullptr;
+    for (const DInputSocket *socket : node.inputs()) {
+      if (ELEM(socket->bsocket()->type, SOCK_OBJECT, SOCK_COLLECTION)) {
+        uses_ids = true;
+      }
+    }
+    if (uses_ids) {
+      /* The node may depend on the data of the data-blocks, not only on which are used. */
+      key = cache_key_combine(key, blender::DefaultHash<const ID *>{}(bnode.id));
+      key = cache_key_combine(key, cache_->ids_key());
+    }
+    return key;
+  }
+
+  static uint64_t output_key(const uint64_t node_key, const DOutputSocket &socket)
+  {
+    return cache_key_combine(node_key, cache_key_from_string(socket.identifier()));
+  }
+
+  bool is_cached_node(const NodeState &state) const
+  {
+    if (cache_ == nullptr || !state.key.has_value()) {
+      return false;
+    }
+    for (const DOutputSocket *socket : state.node->outputs()) {
+      if (socket->is_available() && socket->bsocket()->type == SOCK_GEOMETRY) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Forward all outputs of the node from the cache. Returns false when one of them is not
+   * cached, nothing is forwarded then.
+   */
+  bool try_forward_cached_outputs(NodeState &state)
+  {
+    const DNode &node = *state.node;
+    Vector<std::pair<const DOutputSocket *, GMutablePointer>> values;
+    bool found_all = true;
+    for (const DOutputSocket *socket : node.outputs()) {
+      if (!socket->is_available()) {
+        continue;
+      }
+      const CPPType &type = *blender::nodes::socket_cpp_type_get(*socket->typeinfo());
+      void *buffer = state.allocator.allocate(type.size(), type.alignment());
+      if (!cache_->lookup(output_key(*state.key, *socket), type, buffer)) {
+        found_all = false;
+        break;
+      }
+      values.append({socket, {type, buffer}});
+    }
+
+    if (!found_all) {
+      for (std::pair<const DOutputSocket *, GMutablePointer> &item : values) {
+        item.second.destruct();
+      }
+      return false;
+    }
+    for (std::pair<const DOutputSocket *, GMutablePointer> &item : values) {
+      if (item.second.type()->is<GeometrySet>()) {
+        state.output_elements += geometry_set_elements_amount(*item.second.get<GeometrySet>());
+      }
+      this->forward_to_inputs(
+          *item.first, item.second, state.allocator, output_key(*state.key, *item.first));
+    }
+    return true;
+  }
+
+  /** Forward an output of the node, storing it in the cache first if the node is cached. */
+  void forward_node_output(NodeState &state,
+                           const DOutputSocket &socket,
+                           GMutablePointer value)
+  {
+    if (value.type()->is<GeometrySet>()) {
+      state.output_elements += geometry_set_elements_amount(*value.get<GeometrySet>());
+    }
+    std::optional<uint64_t> key;
+    if (state.key.has_value()) {
+      key = output_key(*state.key, socket);
+      if (this->is_cached_node(state)) {
+        if (value.type()->is<GeometrySet>()) {
+          /* The geometry passed to the modifier is freed after the evaluation. */
+          value.get<GeometrySet>()->ensure_owns_direct_data();
+        }
+        cache_->add(*key, value);
+      }
+    }
+    this->forward_to_inputs(socket, value, state.allocator, key);
+  }
+
+  void compute_node_and_forward(NodeState &state)
+  {
+    if (state.chain_next != nullptr) {
+      /* Only prepare the inputs, the node is evaluated with the rest of the chain. */
+      state.chain_inputs = std::make_unique<GValueMap<StringRef>>(state.allocator);
+      this->prepare_node_inputs(state, *state.chain_inputs);
+      return;
+    }
+    if (state.chain_previous != nullptr) {
+      this->execute_attribute_chain(state);
       return;
     }
 
+    const DNode &node = *state.node;
+    const bNode &bnode = *node.bnode();
+    blender::LinearAllocator<> &allocator = state.allocator;
+
     /* Prepare inputs required to execute the node. */
-    GValueMap<StringRef> node_inputs_map{allocator_};
-    for (const DInputSocket *input_socket : node.inputs()) {
-      if (input_socket->is_available()) {
-        GMutablePointer value = this->get_input_value(*input_socket);
-        node_inputs_map.add_new_direct(input_socket->identifier(), value);
-      }
+    GValueMap<StringRef> node_inputs_map{allocator};
+    this->prepare_node_inputs(state, node_inputs_map);
+
+    if (this->is_cached_node(state) && this->try_forward_cached_outputs(state)) {
+      /* The inputs are destructed by the map. */
+      return;
     }
 
     /* Execute the node. */
-    GValueMap<StringRef> node_outputs_map{allocator_};
+    GValueMap<StringRef> node_outputs_map{allocator};
     GeoNodeExecParams params{
         bnode, node_inputs_map, node_outputs_map, handle_map_, self_object_, depsgraph_};
-    this->execute_node(node, params);
+    const double start_time = PIL_check_seconds_timer();
+    this->execute_node(node, params, allocator);
+    state.execution_time += PIL_check_seconds_timer() - start_time;
 
     /* Forward computed outputs to linked input sockets. */
     for (const DOutputSocket *output_socket : node.outputs()) {
       if (output_socket->is_available()) {
         GMutablePointer value = node_outputs_map.extract(output_socket->identifier());
-        this->forward_to_inputs(*output_socket, value);
+        this->forward_node_output(state, *output_socket, value);
+      }
+    }
+  }
+
+  /** Also computes the key of the node, from the keys of the inputs. */
+  void prepare_node_inputs(NodeState &state, GValueMap<StringRef> &r_node_inputs_map)
+  {
+    const DNode &node = *state.node;
+    std::optional<uint64_t> node_key;
+    if (cache_ != nullptr) {
+      node_key = this->node_settings_key(node);
+    }
+
+    for (const DInputSocket *input_socket : node.inputs()) {
+      if (!input_socket->is_available()) {
+        continue;
+      }
+      std::optional<uint64_t> input_key;
+      if (state.chain_previous != nullptr &&
+          input_socket == get_attribute_node_geometry_input(node)) {
+        /* The geometry is passed along the chain directly. The previous node has been prepared
+         * already, because it is a dependency. */
+        input_key = state.chain_previous->key;
+      }
+      else {
+        GMutablePointer value = this->get_input_value(*input_socket, state.allocator, &input_key);
+        r_node_inputs_map.add_new_direct(input_socket->identifier(), value);
+      }
+
+      if (node_key.has_value() && input_key.has_value()) {
+        node_key = cache_key_combine(*node_key, cache_key_from_string(input_socket->identifier()));
+        node_key = cache_key_combine(*node_key, *input_key);
+      }
+      else {
+        node_key.reset();
+      }
+    }
+    state.key = node_key;
+  }
+
+  /**
+   * Evaluate the chain of attribute nodes ending with the given node. The result attributes of
+   * all nodes are computed by one multi-function network, without writing intermediate results to
+   * the geometry and reading them back. When a node can't be expanded into the network with its
+   * current settings, the nodes are executed one after another instead.
+   */
+  void execute_attribute_chain(NodeState &last_state)
+  {
+    blender::LinearAllocator<> &allocator = last_state.allocator;
+    last_state.chain_inputs = std::make_unique<GValueMap<StringRef>>(allocator);
+    this->prepare_node_inputs(last_state, *last_state.chain_inputs);
+
+    Vector<NodeState *> chain;
+    for (NodeState *state = &last_state; state != nullptr; state = state->chain_previous) {
+      chain.append(state);
+    }
+    std::reverse(chain.begin(), chain.end());
+
+    if (this->is_cached_node(last_state) && this->try_forward_cached_outputs(last_state)) {
+      /* The inputs are destructed with the node states. */
+      return;
+    }
+
+    /* Attribute nodes work on the point domain for now. */
+    blender::nodes::GeoNodeAttributeNetwork network{ATTR_DOMAIN_POINT};
+    GValueMap<StringRef> unused_outputs_map{allocator};
+    bool use_network = true;
+    for (NodeState *state : chain) {
+      GeoNodeExecParams params{*state->node->bnode(),
+                               *state->chain_inputs,
+                               unused_outputs_map,
+                               handle_map_,
+                               self_object_,
+                               depsgraph_};
+      if (!network.try_add_node(params)) {
+        use_network = false;
+        break;
+      }
+    }
+
+    const DInputSocket &first_geometry_input = *get_attribute_node_geometry_input(
+        *chain[0]->node);
+    GeometrySet geometry_set = chain[0]->chain_inputs->extract<GeometrySet>(
+        first_geometry_input.identifier());
+
+    if (use_network) {
+      const double start_time = PIL_check_seconds_timer();
+      if (geometry_set.has<MeshComponent>()) {
+        network.compute(geometry_set.get_component_for_write<MeshComponent>());
+      }
+      if (geometry_set.has<PointCloudComponent>()) {
+        network.compute(geometry_set.get_component_for_write<PointCloudComponent>());
+      }
+      /* The nodes are computed together, so the time is distributed evenly. */
+      const double time = (PIL_check_seconds_timer() - start_time) / chain.size();
+      for (NodeState *state : chain) {
+        state->execution_time += time;
+      }
+    }
+    else {
+      for (NodeState *state : chain) {
+        const DNode &node = *state->node;
+        GValueMap<StringRef> &node_inputs_map = *state->chain_inputs;
+        node_inputs_map.add_new_by_move(get_attribute_node_geometry_input(node)->identifier(),
+                                        &geometry_set);
+
+        GValueMap<StringRef> node_outputs_map{allocator};
+        GeoNodeExecParams params{*node.bnode(),
+                                 node_inputs_map,
+                                 node_outputs_map,
+                                 handle_map_,
+                                 self_object_,
+                                 depsgraph_};
+        const double start_time = PIL_check_seconds_timer();
+        this->execute_node(node, params, allocator);
+        state->execution_time += PIL_check_seconds_timer() - start_time;
+        geometry_set = node_outputs_map.extract<GeometrySet>(node.output(0).identifier());
       }
     }
+
+    const CPPType &type = CPPType::get<GeometrySet>();
+    void *buffer = allocator.allocate(type.size(), type.alignment());
+    new (buffer) GeometrySet(std::move(geometry_set));
+    this->forward_node_output(last_state, last_state.node->output(0), {type, buffer});
   }
 
-  void execute_node(const DNode &node, GeoNodeExecParams params)
+  void execute_node(const DNode &node,
+                    GeoNodeExecParams params,
+                    blender::LinearAllocator<> &allocator)
   {
     const bNode &bnode = params.node();
 
@@ -335,7 +1087,7 @@ class GeometryNodesEvaluator {
     /* Use the multi-function implementation if it exists. */
     const MultiFunction *multi_function = mf_by_node_.lookup_default(&node, nullptr);
     if (multi_function != nullptr) {
-      this->execute_multi_function_node(node, params, *multi_function);
+      this->execute_multi_function_node(node, params, *multi_function, allocator);
       return;
     }
 
@@ -345,7 +1097,8 @@ class GeometryNodesEvaluator {
 
   void execute_multi_function_node(const DNode &node,
                                    GeoNodeExecParams params,
-                                   const MultiFunction &fn)
+                                   const MultiFunction &fn,
+                                   blender::LinearAllocator<> &allocator)
   {
     MFContextBuilder fn_context;
     MFParamsBuilder fn_params{fn, 1};
@@ -361,7 +1114,7 @@ class GeometryNodesEvaluator {
     for (const DOutputSocket *dsocket : node.outputs()) {
       if (dsocket->is_available()) {
         const CPPType &type = *blender::nodes::socket_cpp_type_get(*dsocket->typeinfo());
-        void *buffer = allocator_.allocate(type.size(), type.alignment());
+        void *buffer = allocator.allocate(type.size(), type.alignment());
         fn_params.add_uninitialized_single_output(GMutableSpan(type, buffer, 1));
         output_data.append(GMutablePointer(type, buffer));
       }
@@ -391,12 +1144,16 @@ class GeometryNodesEvaluator {
     }
   }
 
-  void forward_to_inputs(const DOutputSocket &from_socket, GMutablePointer value_to_forward)
+  void forward_to_inputs(const DOutputSocket &from_socket,
+                         GMutablePointer value_to_forward,
+                         blender::LinearAllocator<> &allocator,
+                         const std::optional<uint64_t> key)
   {
     Span<const DInputSocket *> to_sockets_all = from_socket.linked_sockets();
 
     const CPPType &from_type = *value_to_forward.type();
 
+    Vector<std::pair<const DInputSocket *, GMutablePointer>> values_to_add;
     Vector<const DInputSocket *> to_sockets_same_type;
     for (const DInputSocket *to_socket : to_sockets_all) {
       const CPPType &to_type = *blender::nodes::socket_cpp_type_get(*to_socket->typeinfo());
@@ -404,14 +1161,14 @@ class GeometryNodesEvaluator {
         to_sockets_same_type.append(to_socket);
       }
       else {
-        void *buffer = allocator_.allocate(to_type.size(), to_type.alignment());
+        void *buffer = allocator.allocate(to_type.size(), to_type.alignment());
         if (conversions_.is_convertible(from_type, to_type)) {
           conversions_.convert(from_type, to_type, value_to_forward.get(), buffer);
         }
         else {
           to_type.copy_to_uninitialized(to_type.default_value(), buffer);
         }
-        value_by_input_.add_new(to_socket, GMutablePointer{to_type, buffer});
+        values_to_add.append({to_socket, GMutablePointer{to_type, buffer}});
       }
     }
 
@@ -422,7 +1179,7 @@ class GeometryNodesEvaluator {
     else if (to_sockets_same_type.size() == 1) {
       /* This value is only used on one input socket, no need to copy it. */
       const DInputSocket *to_socket = to_sockets_same_type[0];
-      value_by_input_.add_new(to_socket, value_to_forward);
+      values_to_add.append({to_socket, value_to_forward});
     }
     else {
       /* Multiple inputs use the value, make a copy for every input except for one. */
@@ -430,16 +1187,27 @@ class GeometryNodesEvaluator {
       Span<const DInputSocket *> other_to_sockets = to_sockets_same_type.as_span().drop_front(1);
       const CPPType &type = *value_to_forward.type();
 
-      value_by_input_.add_new(first_to_socket, value_to_forward);
+      values_to_add.append({first_to_socket, value_to_forward});
       for (const DInputSocket *to_socket : other_to_sockets) {
-        void *buffer = allocator_.allocate(type.size(), type.alignment());
+        void *buffer = allocator.allocate(type.size(), type.alignment());
         type.copy_to_uninitialized(value_to_forward.get(), buffer);
-        value_by_input_.add_new(to_socket, GMutablePointer{type, buffer});
+        values_to_add.append({to_socket, GMutablePointer{type, buffer}});
+      }
+    }
+
+    /* Only lock once the values are copied, copying geometry can take a while. */
+    std::lock_guard<std::mutex> lock(value_by_input_mutex_);
+    for (const std::pair<const DInputSocket *, GMutablePointer> &item : values_to_add) {
+      value_by_input_.add_new(item.first, item.second);
+      if (key.has_value()) {
+        /* Implicit conversions only depend on the value, so the key stays valid. */
+        key_by_input_.add_new(item.first, *key);
       }
     }
   }
 
-  GMutablePointer get_unlinked_input_value(const DInputSocket &socket)
+  GMutablePointer get_unlinked_input_value(const DInputSocket &socket,
+                                           blender::LinearAllocator<> &allocator)
   {
     bNodeSocket *bsocket;
     if (socket.linked_group_inputs().size() == 0) {
@@ -449,7 +1217,7 @@ class GeometryNodesEvaluator {
       bsocket = socket.linked_group_inputs()[0]->bsocket();
     }
     const CPPType &type = *blender::nodes::socket_cpp_type_get(*socket.typeinfo());
-    void *buffer = allocator_.allocate(type.size(), type.alignment());
+    void *buffer = allocator.allocate(type.size(), type.alignment());
 
     if (bsocket->type == SOCK_OBJECT) {
       Object *object = ((bNodeSocketValueObject *)bsocket->default_value)->value;
@@ -929,12 +1697,30 @@ static GeometrySet compute_geometry(const DerivedNodeTree &tree,
   Vector<const DInputSocket *> group_outputs;
   group_outputs.append(&socket_to_compute);
 
+  if (nmd->modifier.runtime == nullptr) {
+    nmd->modifier.runtime = OBJECT_GUARDED_NEW(GeometryNodesCache);
+  }
+  GeometryNodesCache *cache = static_cast<GeometryNodesCache *>(nmd->modifier.runtime);
+
+  Set<ID *> used_ids;
+  find_used_ids_from_settings(nmd->settings, used_ids);
+  find_used_ids_from_nodes(*tree.btree(), used_ids);
+  find_used_ids_from_node_settings(*tree.btree(), used_ids);
+  cache->update_ids(used_ids, *ctx->object);
+
   GeometryNodesEvaluator evaluator{
-      group_inputs, group_outputs, mf_by_node, handle_map, ctx->object, ctx->depsgraph};
+      group_inputs, group_outputs, mf_by_node, handle_map, ctx->object, ctx->depsgraph, cache};
   Vector<GMutablePointer> results = evaluator.execute();
   BLI_assert(results.size() == 1);
   GMutablePointer result = results[0];
 
+  if (DEG_is_active(ctx->depsgraph)) {
+    evaluator.store_exec_stats();
+  }
+
+  cache->remove_unused();
+  blender::bke::free_unused_temporary_attribute_buffers();
+
   GeometrySet output_geometry = std::move(*(GeometrySet *)result.get());
   return output_geometry;
 }
@@ -1172,6 +1958,15 @@ static void copyData(const ModifierData *md, ModifierData *target, const int fla
   }
 }
 
+static void freeRuntimeData(void *runtime_data_v)
+{
+  if (runtime_data_v == nullptr) {
+    return;
+  }
+  GeometryNodesCache *cache = static_cast<GeometryNodesCache *>(runtime_data_v);
+  OBJECT_GUARDED_DELETE(cache, GeometryNodesCache);
+}
+
 static void freeData(ModifierData *md)
 {
   NodesModifierData *nmd = reinterpret_cast<NodesModifierData *>(md);
@@ -1179,6 +1974,8 @@ static void freeData(ModifierData *md)
     IDP_FreeProperty_ex(nmd->settings.properties, false);
     nmd->settings.properties = nullptr;
   }
+  freeRuntimeData(md->runtime);
+  md->runtime = nullptr;
 }
 
 static void requiredDataMask(Object *UNUSED(ob),
@@ -1222,7 +2019,7 @@ ModifierTypeInfo modifierType_Nodes = {
     /* dependsOnNormals */ nullptr,
     /* foreachIDLink */ foreachIDLink,
     /* foreachTexLink */ nullptr,
-    /* freeRuntimeData */ nullptr,
+    /* freeRuntimeData */ freeRuntimeData,
     /* panelRegister */ panelRegister,
     /* blendWrite */ blendWrite,
     /* blendRead */ blendRead,
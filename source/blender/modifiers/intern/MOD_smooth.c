@@ -40,6 +40,7 @@
 #include "BKE_editmesh.h"
 #include "BKE_lib_id.h"
 #include "BKE_mesh.h"
+#include "BKE_mesh_mapping.h"
 #include "BKE_mesh_wrapper.h"
 #include "BKE_particle.h"
 #include "BKE_screen.h"
@@ -90,6 +91,69 @@ static void requiredDataMask(Object *UNUSED(ob),
   }
 }
 
+typedef struct SmoothUserdata {
+  const SmoothModifierData *smd;
+  float (*vertexCos)[3];
+  float (*smooth_cos)[3];
+  const MeshElemMap *vert_to_verts;
+  const MDeformVert *dvert;
+  int defgrp_index;
+} SmoothUserdata;
+
+/* Average of the edge centers around each vertex, read from the positions of the previous
+ * iteration. */
+static void smooth_average_task(void *__restrict userdata,
+                                const int i,
+                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SmoothUserdata *data = (const SmoothUserdata *)userdata;
+  const MeshElemMap *map = &data->vert_to_verts[i];
+  float *vco_new = data->smooth_cos[i];
+
+  zero_v3(vco_new);
+  for (int j = 0; j < map->count; j++) {
+    float fvec[3];
+    mid_v3_v3v3(fvec, data->vertexCos[i], data->vertexCos[map->indices[j]]);
+    add_v3_v3(vco_new, fvec);
+  }
+  if (map->count > 0) {
+    mul_v3_fl(vco_new, 1.0f / (float)map->count);
+  }
+}
+
+static void smooth_apply_task(void *__restrict userdata,
+                              const int i,
+                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SmoothUserdata *data = (const SmoothUserdata *)userdata;
+  const SmoothModifierData *smd = data->smd;
+  const bool invert_vgroup = (smd->flag & MOD_SMOOTH_INVERT_VGROUP) != 0;
+  const short flag = smd->flag;
+  float *vco_orig = data->vertexCos[i];
+  const float *vco_new = data->smooth_cos[i];
+
+  float f_new = smd->fac;
+  if (data->dvert) {
+    const MDeformVert *dv = &data->dvert[i];
+    f_new *= invert_vgroup ? (1.0f - BKE_defvert_find_weight(dv, data->defgrp_index)) :
+                             BKE_defvert_find_weight(dv, data->defgrp_index);
+    if (f_new <= 0.0f) {
+      return;
+    }
+  }
+  const float f_orig = 1.0f - f_new;
+
+  if (flag & MOD_SMOOTH_X) {
+    vco_orig[0] = f_orig * vco_orig[0] + f_new * vco_new[0];
+  }
+  if (flag & MOD_SMOOTH_Y) {
+    vco_orig[1] = f_orig * vco_orig[1] + f_new * vco_new[1];
+  }
+  if (flag & MOD_SMOOTH_Z) {
+    vco_orig[2] = f_orig * vco_orig[2] + f_new * vco_new[2];
+  }
+}
+
 static void smoothModifier_do(
     SmoothModifierData *smd, Object *ob, Mesh *mesh, float (*vertexCos)[3], int numVerts)
 {
@@ -97,102 +161,39 @@ static void smoothModifier_do(
     return;
   }
 
-  float(*accumulated_vecs)[3] = MEM_calloc_arrayN(
-      (size_t)numVerts, sizeof(*accumulated_vecs), __func__);
-  if (!accumulated_vecs) {
-    return;
-  }
-
-  uint *num_accumulated_vecs = MEM_calloc_arrayN(
-      (size_t)numVerts, sizeof(*num_accumulated_vecs), __func__);
-  if (!num_accumulated_vecs) {
-    MEM_freeN(accumulated_vecs);
+  float(*smooth_cos)[3] = MEM_malloc_arrayN((size_t)numVerts, sizeof(*smooth_cos), __func__);
+  if (!smooth_cos) {
     return;
   }
 
-  const float fac_new = smd->fac;
-  const float fac_orig = 1.0f - fac_new;
-  const bool invert_vgroup = (smd->flag & MOD_SMOOTH_INVERT_VGROUP) != 0;
-
-  MEdge *medges = mesh->medge;
-  const int num_edges = mesh->totedge;
+  /* Gather from the neighbors of each vertex instead of scattering over the edges, so vertices
+   * can be handled in parallel. Neighbors are in edge order, so the result stays the same. */
+  MeshElemMap *vert_to_verts;
+  int *vert_to_verts_mem;
+  BKE_mesh_vert_edge_vert_map_create(
+      &vert_to_verts, &vert_to_verts_mem, mesh->medge, numVerts, mesh->totedge);
 
   MDeformVert *dvert;
   int defgrp_index;
   MOD_get_vgroup(ob, mesh, smd->defgrp_name, &dvert, &defgrp_index);
 
-  for (int j = 0; j < smd->repeat; j++) {
-    if (j != 0) {
-      memset(accumulated_vecs, 0, sizeof(*accumulated_vecs) * (size_t)numVerts);
-      memset(num_accumulated_vecs, 0, sizeof(*num_accumulated_vecs) * (size_t)numVerts);
-    }
-
-    for (int i = 0; i < num_edges; i++) {
-      float fvec[3];
-      const uint idx1 = medges[i].v1;
-      const uint idx2 = medges[i].v2;
-
-      mid_v3_v3v3(fvec, vertexCos[idx1], vertexCos[idx2]);
-
-      num_accumulated_vecs[idx1]++;
-      add_v3_v3(accumulated_vecs[idx1], fvec);
-
-      num_accumulated_vecs[idx2]++;
-      add_v3_v3(accumulated_vecs[idx2], fvec);
-    }
+  SmoothUserdata data = {
+      .smd = smd,
+      .vertexCos = vertexCos,
+      .smooth_cos = smooth_cos,
+      .vert_to_verts = vert_to_verts,
+      .dvert = dvert,
+      .defgrp_index = defgrp_index,
+  };
 
-    const short flag = smd->flag;
-    if (dvert) {
-      MDeformVert *dv = dvert;
-      for (int i = 0; i < numVerts; i++, dv++) {
-        float *vco_orig = vertexCos[i];
-        if (num_accumulated_vecs[i] > 0) {
-          mul_v3_fl(accumulated_vecs[i], 1.0f / (float)num_accumulated_vecs[i]);
-        }
-        float *vco_new = accumulated_vecs[i];
-
-        const float f_new = invert_vgroup ?
-                                (1.0f - BKE_defvert_find_weight(dv, defgrp_index)) * fac_new :
-                                BKE_defvert_find_weight(dv, defgrp_index) * fac_new;
-        if (f_new <= 0.0f) {
-          continue;
-        }
-        const float f_orig = 1.0f - f_new;
-
-        if (flag & MOD_SMOOTH_X) {
-          vco_orig[0] = f_orig * vco_orig[0] + f_new * vco_new[0];
-        }
-        if (flag & MOD_SMOOTH_Y) {
-          vco_orig[1] = f_orig * vco_orig[1] + f_new * vco_new[1];
-        }
-        if (flag & MOD_SMOOTH_Z) {
-          vco_orig[2] = f_orig * vco_orig[2] + f_new * vco_new[2];
-        }
-      }
-    }
-    else { /* no vertex group */
-      for (int i = 0; i < numVerts; i++) {
-        float *vco_orig = vertexCos[i];
-        if (num_accumulated_vecs[i] > 0) {
-          mul_v3_fl(accumulated_vecs[i], 1.0f / (float)num_accumulated_vecs[i]);
-        }
-        float *vco_new = accumulated_vecs[i];
-
-        if (flag & MOD_SMOOTH_X) {
-          vco_orig[0] = fac_orig * vco_orig[0] + fac_new * vco_new[0];
-        }
-        if (flag & MOD_SMOOTH_Y) {
-          vco_orig[1] = fac_orig * vco_orig[1] + fac_new * vco_new[1];
-        }
-        if (flag & MOD_SMOOTH_Z) {
-          vco_orig[2] = fac_orig * vco_orig[2] + fac_new * vco_new[2];
-        }
-      }
-    }
+  for (int j = 0; j < smd->repeat; j++) {
+    MOD_deform_verts_parallel(numVerts, &data, smooth_average_task);
+    MOD_deform_verts_parallel(numVerts, &data, smooth_apply_task);
   }
 
-  MEM_freeN(accumulated_vecs);
-  MEM_freeN(num_accumulated_vecs);
+  MEM_freeN(vert_to_verts);
+  MEM_freeN(vert_to_verts_mem);
+  MEM_freeN(smooth_cos);
 }
 
 static void deformVerts(ModifierData *md,
@@ -115,9 +115,8 @@ static void freeRuntimeData(void *runtime_data_v)
     return;
   }
   SubsurfRuntimeData *runtime_data = (SubsurfRuntimeData *)runtime_data_v;
-  if (runtime_data->subdiv != NULL) {
-    BKE_subdiv_free(runtime_data->subdiv);
-  }
+  /* The descriptor is likely to be needed again by a new evaluated copy of the object. */
+  BKE_subdiv_cache_release(runtime_data->subdiv);
   MEM_freeN(runtime_data);
 }
 
@@ -179,6 +178,9 @@ static Subdiv *subdiv_descriptor_ensure(SubsurfModifierData *smd,
                                         const Mesh *mesh)
 {
   SubsurfRuntimeData *runtime_data = (SubsurfRuntimeData *)smd->modifier.runtime;
+  if (runtime_data->subdiv == NULL) {
+    runtime_data->subdiv = BKE_subdiv_cache_acquire(subdiv_settings, mesh);
+  }
   Subdiv *subdiv = BKE_subdiv_update_from_mesh(runtime_data->subdiv, subdiv_settings, mesh);
   runtime_data->subdiv = subdiv;
   return subdiv;
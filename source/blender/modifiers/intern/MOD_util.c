@@ -267,6 +267,20 @@ void MOD_get_vgroup(
   }
 }
 
+/* Below this, the cost of starting threads outweighs the work of a simple deform modifier. */
+#define DEFORM_PARALLEL_MIN_VERTS 512
+
+/* Run func for every vertex of a deform modifier, on multiple threads for meshes which are large
+ * enough. Vertices are independent, func must only write to the data of the vertex it gets. */
+void MOD_deform_verts_parallel(const int verts_num, void *userdata, TaskParallelRangeFunc func)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (verts_num > DEFORM_PARALLEL_MIN_VERTS);
+  settings.min_iter_per_thread = DEFORM_PARALLEL_MIN_VERTS;
+  BLI_task_parallel_range(0, verts_num, userdata, func, &settings);
+}
+
 void MOD_depsgraph_update_object_bone_relation(struct DepsNodeHandle *node,
                                                Object *object,
                                                const char *bonename,
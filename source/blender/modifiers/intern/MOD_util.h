@@ -23,6 +23,8 @@
 /* so modifier types match their defines */
 #include "MOD_modifiertypes.h"
 
+#include "BLI_task.h"
+
 #include "DEG_depsgraph_build.h"
 
 struct MDeformVert;
@@ -55,6 +57,8 @@ void MOD_get_vgroup(struct Object *ob,
                     struct MDeformVert **dvert,
                     int *defgrp_index);
 
+void MOD_deform_verts_parallel(const int verts_num, void *userdata, TaskParallelRangeFunc func);
+
 void MOD_depsgraph_update_object_bone_relation(struct DepsNodeHandle *node,
                                                struct Object *object,
                                                const char *bonename,
@@ -37,6 +37,7 @@
 #include "BKE_context.h"
 #include "BKE_deform.h"
 #include "BKE_editmesh.h"
+#include "BKE_image.h"
 #include "BKE_lib_id.h"
 #include "BKE_lib_query.h"
 #include "BKE_mesh.h"
@@ -141,6 +142,127 @@ static bool dependsOnNormals(ModifierData *md)
   return (wmd->flag & MOD_WAVE_NORM) != 0;
 }
 
+typedef struct WaveUserdata {
+  const WaveModifierData *wmd;
+  struct Scene *scene;
+  struct ImagePool *pool;
+  Tex *tex_target;
+  const float (*tex_co)[3];
+  float (*vertexCos)[3];
+  const MVert *mvert;
+  const MDeformVert *dvert;
+  int defgrp_index;
+  float ctime;
+  float minfac;
+  float lifefac;
+  float falloff_inv;
+} WaveUserdata;
+
+static void waveModifier_do_task(void *__restrict userdata,
+                                 const int i,
+                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const WaveUserdata *data = (const WaveUserdata *)userdata;
+  const WaveModifierData *wmd = data->wmd;
+  const MVert *mvert = data->mvert;
+  const int wmd_axis = wmd->flag & (MOD_WAVE_X | MOD_WAVE_Y);
+  const float falloff = wmd->falloff;
+  const float lifefac = data->lifefac;
+  float falloff_fac = 1.0f; /* when falloff == 0.0f this stays at 1.0f */
+  const bool invert_group = (wmd->flag & MOD_WAVE_INVERT_VGROUP) != 0;
+
+  float *co = data->vertexCos[i];
+  float x = co[0] - wmd->startx;
+  float y = co[1] - wmd->starty;
+  float amplit = 0.0f;
+  float def_weight = 1.0f;
+
+  /* get weights */
+  if (data->dvert) {
+    const MDeformVert *dv = &data->dvert[i];
+    def_weight = invert_group ? 1.0f - BKE_defvert_find_weight(dv, data->defgrp_index) :
+                                BKE_defvert_find_weight(dv, data->defgrp_index);
+
+    /* if this vert isn't in the vgroup, don't deform it */
+    if (def_weight == 0.0f) {
+      return;
+    }
+  }
+
+  switch (wmd_axis) {
+    case MOD_WAVE_X | MOD_WAVE_Y:
+      amplit = sqrtf(x * x + y * y);
+      break;
+    case MOD_WAVE_X:
+      amplit = x;
+      break;
+    case MOD_WAVE_Y:
+      amplit = y;
+      break;
+  }
+
+  /* this way it makes nice circles */
+  amplit -= (data->ctime - wmd->timeoffs) * wmd->speed;
+
+  if (wmd->flag & MOD_WAVE_CYCL) {
+    amplit = (float)fmodf(amplit - wmd->width, 2.0f * wmd->width) + wmd->width;
+  }
+
+  if (falloff != 0.0f) {
+    float dist = 0.0f;
+
+    switch (wmd_axis) {
+      case MOD_WAVE_X | MOD_WAVE_Y:
+        dist = sqrtf(x * x + y * y);
+        break;
+      case MOD_WAVE_X:
+        dist = fabsf(x);
+        break;
+      case MOD_WAVE_Y:
+        dist = fabsf(y);
+        break;
+    }
+
+    falloff_fac = (1.0f - (dist * data->falloff_inv));
+    CLAMP(falloff_fac, 0.0f, 1.0f);
+  }
+
+  /* GAUSSIAN */
+  if ((falloff_fac != 0.0f) && (amplit > -wmd->width) && (amplit < wmd->width)) {
+    amplit = amplit * wmd->narrow;
+    amplit = (float)(1.0f / expf(amplit * amplit) - data->minfac);
+
+    /*apply texture*/
+    if (data->tex_co) {
+      TexResult texres;
+      texres.nor = NULL;
+      BKE_texture_get_value_ex(
+          data->scene, data->tex_target, data->tex_co[i], &texres, data->pool, false);
+      amplit *= texres.tin;
+    }
+
+    /*apply weight & falloff */
+    amplit *= def_weight * falloff_fac;
+
+    if (mvert) {
+      /* move along normals */
+      if (wmd->flag & MOD_WAVE_NORM_X) {
+        co[0] += (lifefac * amplit) * mvert[i].no[0] / 32767.0f;
+      }
+      if (wmd->flag & MOD_WAVE_NORM_Y) {
+        co[1] += (lifefac * amplit) * mvert[i].no[1] / 32767.0f;
+      }
+      if (wmd->flag & MOD_WAVE_NORM_Z) {
+        co[2] += (lifefac * amplit) * mvert[i].no[2] / 32767.0f;
+      }
+    }
+    else {
+      /* move along local z axis */
+      co[2] += lifefac * amplit;
+    }
+  }
+}
+
 static void waveModifier_do(WaveModifierData *md,
                             const ModifierEvalContext *ctx,
                             Object *ob,
@@ -156,10 +278,7 @@ static void waveModifier_do(WaveModifierData *md,
   float minfac = (float)(1.0 / exp(wmd->width * wmd->narrow * wmd->width * wmd->narrow));
   float lifefac = wmd->height;
   float(*tex_co)[3] = NULL;
-  const int wmd_axis = wmd->flag & (MOD_WAVE_X | MOD_WAVE_Y);
   const float falloff = wmd->falloff;
-  float falloff_fac = 1.0f; /* when falloff == 0.0f this stays at 1.0f */
-  const bool invert_group = (wmd->flag & MOD_WAVE_INVERT_VGROUP) != 0;
 
   if ((wmd->flag & MOD_WAVE_NORM) && (mesh != NULL)) {
     mvert = mesh->mvert;
@@ -206,100 +325,29 @@ static void waveModifier_do(WaveModifierData *md,
   }
 
   if (lifefac != 0.0f) {
+    WaveUserdata data = {NULL};
+    data.wmd = wmd;
+    data.scene = DEG_get_evaluated_scene(ctx->depsgraph);
+    data.tex_target = tex_target;
+    data.tex_co = (const float(*)[3])tex_co;
+    data.vertexCos = vertexCos;
+    data.mvert = mvert;
+    data.dvert = dvert;
+    data.defgrp_index = defgrp_index;
+    data.ctime = ctime;
+    data.minfac = minfac;
+    data.lifefac = lifefac;
     /* avoid divide by zero checks within the loop */
-    float falloff_inv = falloff != 0.0f ? 1.0f / falloff : 1.0f;
-    int i;
-
-    for (i = 0; i < numVerts; i++) {
-      float *co = vertexCos[i];
-      float x = co[0] - wmd->startx;
-      float y = co[1] - wmd->starty;
-      float amplit = 0.0f;
-      float def_weight = 1.0f;
-
-      /* get weights */
-      if (dvert) {
-        def_weight = invert_group ? 1.0f - BKE_defvert_find_weight(&dvert[i], defgrp_index) :
-                                    BKE_defvert_find_weight(&dvert[i], defgrp_index);
-
-        /* if this vert isn't in the vgroup, don't deform it */
-        if (def_weight == 0.0f) {
-          continue;
-        }
-      }
-
-      switch (wmd_axis) {
-        case MOD_WAVE_X | MOD_WAVE_Y:
-          amplit = sqrtf(x * x + y * y);
-          break;
-        case MOD_WAVE_X:
-          amplit = x;
-          break;
-        case MOD_WAVE_Y:
-          amplit = y;
-          break;
-      }
-
-      /* this way it makes nice circles */
-      amplit -= (ctime - wmd->timeoffs) * wmd->speed;
+    data.falloff_inv = falloff != 0.0f ? 1.0f / falloff : 1.0f;
+    if (tex_co != NULL) {
+      data.pool = BKE_image_pool_new();
+      BKE_texture_fetch_images_for_pool(tex_target, data.pool);
+    }
 
-      if (wmd->flag & MOD_WAVE_CYCL) {
-        amplit = (float)fmodf(amplit - wmd->width, 2.0f * wmd->width) + wmd->width;
-      }
+    MOD_deform_verts_parallel(numVerts, &data, waveModifier_do_task);
 
-      if (falloff != 0.0f) {
-        float dist = 0.0f;
-
-        switch (wmd_axis) {
-          case MOD_WAVE_X | MOD_WAVE_Y:
-            dist = sqrtf(x * x + y * y);
-            break;
-          case MOD_WAVE_X:
-            dist = fabsf(x);
-            break;
-          case MOD_WAVE_Y:
-            dist = fabsf(y);
-            break;
-        }
-
-        falloff_fac = (1.0f - (dist * falloff_inv));
-        CLAMP(falloff_fac, 0.0f, 1.0f);
-      }
-
-      /* GAUSSIAN */
-      if ((falloff_fac != 0.0f) && (amplit > -wmd->width) && (amplit < wmd->width)) {
-        amplit = amplit * wmd->narrow;
-        amplit = (float)(1.0f / expf(amplit * amplit) - minfac);
-
-        /*apply texture*/
-        if (tex_co) {
-          Scene *scene = DEG_get_evaluated_scene(ctx->depsgraph);
-          TexResult texres;
-          texres.nor = NULL;
-          BKE_texture_get_value(scene, tex_target, tex_co[i], &texres, false);
-          amplit *= texres.tin;
-        }
-
-        /*apply weight & falloff */
-        amplit *= def_weight * falloff_fac;
-
-        if (mvert) {
-          /* move along normals */
-          if (wmd->flag & MOD_WAVE_NORM_X) {
-            co[0] += (lifefac * amplit) * mvert[i].no[0] / 32767.0f;
-          }
-          if (wmd->flag & MOD_WAVE_NORM_Y) {
-            co[1] += (lifefac * amplit) * mvert[i].no[1] / 32767.0f;
-          }
-          if (wmd->flag & MOD_WAVE_NORM_Z) {
-            co[2] += (lifefac * amplit) * mvert[i].no[2] / 32767.0f;
-          }
-        }
-        else {
-          /* move along local z axis */
-          co[2] += lifefac * amplit;
-        }
-      }
+    if (data.pool != NULL) {
+      BKE_image_pool_free(data.pool);
     }
   }
 
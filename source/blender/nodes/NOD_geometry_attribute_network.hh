@@ -0,0 +1,163 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup nodes
+ *
+ * Attribute nodes like Attribute Math usually read their inputs from the geometry and write a
+ * result attribute back, even when the result is only used by the next node. A chain of such
+ * nodes, where every node gets its geometry from the previous one, can instead be expanded into a
+ * single multi-function network. That network is evaluated in one pass over the elements, so
+ * results used later in the chain don't have to be written to and read back from the geometry.
+ */
+
+#include "BLI_map.hh"
+#include "BLI_resource_collector.hh"
+
+#include "FN_multi_function_network.hh"
+
+#include "NOD_geometry_exec.hh"
+
+namespace blender::nodes {
+
+class GeoNodeAttributeNetworkBuilder;
+
+/**
+ * Multi-function network computing the result attributes of a chain of attribute nodes. All
+ * attributes are on the same domain.
+ */
+class GeoNodeAttributeNetwork : NonCopyable, NonMovable {
+ private:
+  struct AttributeSocket {
+    fn::MFOutputSocket *socket;
+    CustomDataType type;
+  };
+
+  AttributeDomain domain_;
+  fn::MFNetwork network_;
+  ResourceCollector resources_;
+
+  struct AttributeOutput {
+    std::string name;
+    CustomDataType type;
+    const fn::MFInputSocket *socket;
+  };
+
+  /* Attributes read from the geometry, which are the network inputs. The same attribute might be
+   * read with different types. */
+  Map<std::string, Vector<AttributeSocket>> attribute_inputs_;
+  /* Latest value of every result attribute, written to the geometry in the end. */
+  Map<std::string, AttributeSocket> attribute_results_;
+
+  Vector<AttributeOutput> attribute_outputs_;
+  bool is_finalized_ = false;
+
+  friend GeoNodeAttributeNetworkBuilder;
+
+ public:
+  GeoNodeAttributeNetwork(AttributeDomain domain);
+
+  /**
+   * Add the next node in the chain. Returns false when the node can't be evaluated as part of
+   * the network with its current settings, in which case the network should not be used.
+   */
+  bool try_add_node(const GeoNodeExecParams &params);
+
+  /**
+   * Compute the result attributes of all nodes that were added and write them to the component.
+   */
+  void compute(GeometryComponent &component);
+
+ private:
+  void finalize();
+  fn::MFOutputSocket *try_convert(fn::MFOutputSocket &socket,
+                                  CustomDataType from_type,
+                                  CustomDataType to_type);
+};
+
+/**
+ * Passed to the #bNodeType.geometry_node_expand_attributes callback of a node, to insert the
+ * multi-function nodes computing its result.
+ */
+class GeoNodeAttributeNetworkBuilder {
+ private:
+  GeoNodeAttributeNetwork &network_;
+  const GeoNodeExecParams &params_;
+  bool is_supported_ = true;
+
+ public:
+  GeoNodeAttributeNetworkBuilder(GeoNodeAttributeNetwork &network,
+                                 const GeoNodeExecParams &params)
+      : network_(network), params_(params)
+  {
+  }
+
+  const GeoNodeExecParams &params() const
+  {
+    return params_;
+  }
+
+  const bNode &node() const
+  {
+    return params_.node();
+  }
+
+  fn::MFNetwork &network()
+  {
+    return network_.network_;
+  }
+
+  /**
+   * Constructs a new function that will live at least as long as the network.
+   */
+  template<typename T, typename... Args> T &construct_fn(Args &&... args)
+  {
+    BLI_STATIC_ASSERT((std::is_base_of_v<fn::MultiFunction, T>), "");
+    void *buffer = network_.resources_.linear_allocator().allocate(sizeof(T), alignof(T));
+    T *fn = new (buffer) T(std::forward<Args>(args)...);
+    network_.resources_.add(destruct_ptr<T>(fn), fn->name().c_str());
+    return *fn;
+  }
+
+  /**
+   * Get a socket providing the value of the input with the given name, equivalent to
+   * #GeoNodeExecParams.get_input_attribute. The value either comes from a previous node in the
+   * chain, the geometry or a constant socket value.
+   */
+  fn::MFOutputSocket &get_input_attribute(StringRef name, CustomDataType type);
+
+  /**
+   * Use the value of the socket for the attribute with the given name.
+   */
+  void set_result_attribute(StringRef name, CustomDataType type, fn::MFOutputSocket &socket);
+
+  /**
+   * Tag that the node can't be evaluated in the network with its current settings.
+   */
+  void set_not_supported()
+  {
+    is_supported_ = false;
+  }
+
+  bool is_supported() const
+  {
+    return is_supported_;
+  }
+};
+
+}  // namespace blender::nodes
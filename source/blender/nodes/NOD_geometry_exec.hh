@@ -51,6 +51,8 @@ using fn::GMutablePointer;
 using fn::GPointer;
 using fn::GValueMap;
 
+class GeoNodeAttributeNetworkBuilder;
+
 class GeoNodeExecParams {
  private:
   const bNode &node_;
@@ -210,6 +212,8 @@ class GeoNodeExecParams {
 
   /* Find the active socket socket with the input name (not the identifier). */
   const bNodeSocket *find_available_socket(const StringRef name) const;
+
+  friend GeoNodeAttributeNetworkBuilder;
 };
 
 }  // namespace blender::nodes
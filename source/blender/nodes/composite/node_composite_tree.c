@@ -151,6 +151,14 @@ static void local_merge(Main *bmain, bNodeTree *localtree, bNodeTree *ntree)
   /* move over the compbufs and previews */
   BKE_node_preview_merge_tree(ntree, localtree, true);
 
+  /* Execution statistics, matched by name since the local tree is made from an evaluated copy. */
+  LISTBASE_FOREACH (bNode *, node, &localtree->nodes) {
+    bNode *orig_node = nodeFindNodebyName(ntree, node->name);
+    if (orig_node) {
+      orig_node->exec_stats = node->exec_stats;
+    }
+  }
+
   for (lnode = localtree->nodes.first; lnode; lnode = lnode->next) {
     if (ntreeNodeExists(ntree, lnode->new_node)) {
       if (ELEM(lnode->type, CMP_NODE_VIEWER, CMP_NODE_SPLITVIEWER)) {
@@ -254,6 +262,50 @@ void ntreeCompositExecTree(Scene *scene,
   UNUSED_VARS(do_preview);
 }
 
+/* Composite several frames of an animation in parallel, see COM_execute_frames. */
+void ntreeCompositExecFrames(Scene *scene,
+                             bNodeTree *ntree,
+                             RenderData *rd,
+                             const int *frames,
+                             RenderResult **results,
+                             int num_frames,
+                             const ColorManagedViewSettings *view_settings,
+                             const ColorManagedDisplaySettings *display_settings,
+                             const char *view_name)
+{
+#ifdef WITH_COMPOSITOR
+  COM_execute_frames(rd,
+                     scene,
+                     ntree,
+                     frames,
+                     results,
+                     num_frames,
+                     view_settings,
+                     display_settings,
+                     view_name);
+#else
+  UNUSED_VARS(scene,
+              ntree,
+              rd,
+              frames,
+              results,
+              num_frames,
+              view_settings,
+              display_settings,
+              view_name);
+#endif
+}
+
+bool ntreeCompositCanExecFrames(bNodeTree *ntree)
+{
+#ifdef WITH_COMPOSITOR
+  return COM_can_execute_frames(ntree);
+#else
+  UNUSED_VARS(ntree);
+  return false;
+#endif
+}
+
 /* *********************************************** */
 
 /* Update the outputs of the render layer nodes.
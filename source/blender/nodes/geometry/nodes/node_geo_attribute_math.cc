@@ -26,6 +26,9 @@
 #include "DNA_mesh_types.h"
 #include "DNA_pointcloud_types.h"
 
+#include "FN_multi_function_builder.hh"
+
+#include "NOD_geometry_attribute_network.hh"
 #include "NOD_math_functions.hh"
 
 static bNodeSocketTemplate geo_node_attribute_math_in[] = {
@@ -244,6 +247,57 @@ static void attribute_math_calc(GeometryComponent &component, const GeoNodeExecP
   attribute_result.apply_span_and_save();
 }
 
+static const fn::MultiFunction *get_math_function(const NodeMathOperation operation)
+{
+  const fn::MultiFunction *math_fn = nullptr;
+
+  try_dispatch_float_math_fl_to_fl(
+      operation, [&](auto function, const FloatMathOperationInfo &info) {
+        static fn::CustomMF_SI_SO<float, float> fn{info.title_case_name, function};
+        math_fn = &fn;
+      });
+  try_dispatch_float_math_fl_fl_to_fl(
+      operation, [&](auto function, const FloatMathOperationInfo &info) {
+        static fn::CustomMF_SI_SI_SO<float, float, float> fn{info.title_case_name, function};
+        math_fn = &fn;
+      });
+  try_dispatch_float_math_fl_fl_fl_to_fl(
+      operation, [&](auto function, const FloatMathOperationInfo &info) {
+        static fn::CustomMF_SI_SI_SI_SO<float, float, float, float> fn{info.title_case_name,
+                                                                        function};
+        math_fn = &fn;
+      });
+
+  return math_fn;
+}
+
+static void geo_node_attribute_math_expand_attributes(GeoNodeAttributeNetworkBuilder &builder)
+{
+  const NodeAttributeMath *node_storage = (const NodeAttributeMath *)builder.node().storage;
+  const NodeMathOperation operation = static_cast<NodeMathOperation>(node_storage->operation);
+
+  /* The result type of this node is always float. */
+  const CustomDataType result_type = CD_PROP_FLOAT;
+
+  const fn::MultiFunction *math_fn = get_math_function(operation);
+  if (math_fn == nullptr) {
+    builder.set_not_supported();
+    return;
+  }
+
+  fn::MFNetwork &network = builder.network();
+  fn::MFFunctionNode &math_node = network.add_function(*math_fn);
+
+  const char *input_names[] = {"A", "B", "C"};
+  for (const int i : math_node.inputs().index_range()) {
+    network.add_link(builder.get_input_attribute(input_names[i], result_type),
+                     math_node.input(i));
+  }
+
+  const std::string result_name = builder.params().get_input<std::string>("Result");
+  builder.set_result_attribute(result_name, result_type, math_node.output(0));
+}
+
 static void geo_node_attribute_math_exec(GeoNodeExecParams params)
 {
   GeometrySet geometry_set = params.extract_input<GeometrySet>("Geometry");
@@ -267,6 +321,8 @@ void register_node_type_geo_attribute_math()
   geo_node_type_base(&ntype, GEO_NODE_ATTRIBUTE_MATH, "Attribute Math", NODE_CLASS_ATTRIBUTE, 0);
   node_type_socket_templates(&ntype, geo_node_attribute_math_in, geo_node_attribute_math_out);
   ntype.geometry_node_execute = blender::nodes::geo_node_attribute_math_exec;
+  ntype.geometry_node_expand_attributes =
+      blender::nodes::geo_node_attribute_math_expand_attributes;
   node_type_update(&ntype, blender::nodes::geo_node_attribute_math_update);
   node_type_init(&ntype, geo_node_attribute_math_init);
   node_type_storage(
@@ -115,12 +115,6 @@ static Mesh *join_mesh_topology_and_builtin_attributes(Span<const MeshComponent
   return new_mesh;
 }
 
-template<typename Component>
-static Array<const GeometryComponent *> to_base_components(Span<const Component *> components)
-{
-  return components;
-}
-
 static Set<std::string> find_all_attribute_names(Span<const GeometryComponent *> components)
 {
   Set<std::string> attribute_names;
@@ -205,29 +199,42 @@ static void join_attributes(Span<const GeometryComponent *> src_components,
   }
 }
 
-static void join_components(Span<const MeshComponent *> src_components, GeometrySet &result)
+template<typename Component>
+static Vector<const Component *> to_derived_components(Span<const GeometryComponent *> components)
+{
+  Vector<const Component *> derived_components;
+  for (const GeometryComponent *component : components) {
+    derived_components.append(static_cast<const Component *>(component));
+  }
+  return derived_components;
+}
+
+static void join_mesh_components(Span<const GeometryComponent *> src_components,
+                                 GeometryComponent &r_result)
 {
-  Mesh *new_mesh = join_mesh_topology_and_builtin_attributes(src_components);
+  Mesh *new_mesh = join_mesh_topology_and_builtin_attributes(
+      to_derived_components<MeshComponent>(src_components));
 
-  MeshComponent &dst_component = result.get_component_for_write<MeshComponent>();
+  MeshComponent &dst_component = static_cast<MeshComponent &>(r_result);
   dst_component.replace(new_mesh);
 
   /* The position attribute is handled above already. */
-  join_attributes(to_base_components(src_components), dst_component, {"position"});
+  join_attributes(src_components, dst_component, {"position"});
 }
 
-static void join_components(Span<const PointCloudComponent *> src_components, GeometrySet &result)
+static void join_pointcloud_components(Span<const GeometryComponent *> src_components,
+                                       GeometryComponent &r_result)
 {
   int totpoints = 0;
-  for (const PointCloudComponent *pointcloud_component : src_components) {
+  for (const GeometryComponent *pointcloud_component : src_components) {
     totpoints += pointcloud_component->attribute_domain_size(ATTR_DOMAIN_POINT);
   }
 
-  PointCloudComponent &dst_component = result.get_component_for_write<PointCloudComponent>();
+  PointCloudComponent &dst_component = static_cast<PointCloudComponent &>(r_result);
   PointCloud *pointcloud = BKE_pointcloud_new_nomain(totpoints);
   dst_component.replace(pointcloud);
 
-  join_attributes(to_base_components(src_components), dst_component);
+  join_attributes(src_components, dst_component);
 }
 
 static void join_components(Span<const InstancesComponent *> src_components, GeometrySet &result)
@@ -272,6 +279,41 @@ static void join_component_type(Span<const GeometrySet *> src_geometry_sets, Geo
   join_components(components, result);
 }
 
+/**
+ * Joining meshes and point clouds copies all their data, so it is only done when the result is
+ * accessed. When an input is the not yet joined result of another Join Geometry node, its
+ * components are joined directly, which avoids copying the data multiple times in a chain of
+ * Join Geometry nodes.
+ */
+template<typename Component>
+static void join_component_type_deferred(Span<const GeometrySet *> src_geometry_sets,
+                                         GeometryComponentJoinFn join_fn,
+                                         GeometrySet &result)
+{
+  Vector<const GeometryComponent *> components;
+  for (const GeometrySet *geometry_set : src_geometry_sets) {
+    Vector<const GeometryComponent *> components_to_join = geometry_set->components_to_join(
+        Component::static_type);
+    if (!components_to_join.is_empty()) {
+      components.extend(components_to_join);
+      continue;
+    }
+    const Component *component = geometry_set->get_component_for_read<Component>();
+    if (component != nullptr && !component->is_empty()) {
+      components.append(component);
+    }
+  }
+
+  if (components.size() == 0) {
+    return;
+  }
+  if (components.size() == 1) {
+    result.add(*components[0]);
+    return;
+  }
+  result.add_components_to_join(Component::static_type, components, join_fn);
+}
+
 static void geo_node_join_geometry_exec(GeoNodeExecParams params)
 {
   GeometrySet geometry_set_a = params.extract_input<GeometrySet>("Geometry");
@@ -280,8 +322,10 @@ static void geo_node_join_geometry_exec(GeoNodeExecParams params)
 
   std::array<const GeometrySet *, 2> src_geometry_sets = {&geometry_set_a, &geometry_set_b};
 
-  join_component_type<MeshComponent>(src_geometry_sets, geometry_set_result);
-  join_component_type<PointCloudComponent>(src_geometry_sets, geometry_set_result);
+  join_component_type_deferred<MeshComponent>(
+      src_geometry_sets, join_mesh_components, geometry_set_result);
+  join_component_type_deferred<PointCloudComponent>(
+      src_geometry_sets, join_pointcloud_components, geometry_set_result);
   join_component_type<InstancesComponent>(src_geometry_sets, geometry_set_result);
   join_component_type<VolumeComponent>(src_geometry_sets, geometry_set_result);
 
@@ -14,12 +14,16 @@
  * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+#include <algorithm>
+
+#include "BLI_array.hh"
 #include "BLI_float3.hh"
 #include "BLI_hash.h"
-#include "BLI_kdtree.h"
+#include "BLI_map.hh"
 #include "BLI_math_vector.h"
 #include "BLI_rand.hh"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 #include "BLI_timeit.hh"
 
 #include "DNA_mesh_types.h"
@@ -78,6 +82,44 @@ static Span<MLoopTri> get_mesh_looptris(const Mesh &mesh)
   return {looptris, looptris_len};
 }
 
+/**
+ * Every triangle has its own random number generator, seeded with its index. That way the
+ * triangles can be sampled in any order and the result does not depend on the number of threads.
+ */
+static RandomNumberGenerator get_looptri_rng(const int looptri_index, const int seed)
+{
+  const int looptri_seed = BLI_hash_int(looptri_index + seed);
+  return RandomNumberGenerator(looptri_seed);
+}
+
+static int sample_looptri_point_amount(const Mesh &mesh,
+                                       const MLoopTri &looptri,
+                                       const float base_density,
+                                       const FloatReadAttribute *density_factors,
+                                       RandomNumberGenerator &looptri_rng)
+{
+  const int v0_index = mesh.mloop[looptri.tri[0]].v;
+  const int v1_index = mesh.mloop[looptri.tri[1]].v;
+  const int v2_index = mesh.mloop[looptri.tri[2]].v;
+  const float3 v0_pos = mesh.mvert[v0_index].co;
+  const float3 v1_pos = mesh.mvert[v1_index].co;
+  const float3 v2_pos = mesh.mvert[v2_index].co;
+
+  float looptri_density_factor = 1.0f;
+  if (density_factors != nullptr) {
+    const float v0_density_factor = std::max(0.0f, (*density_factors)[v0_index]);
+    const float v1_density_factor = std::max(0.0f, (*density_factors)[v1_index]);
+    const float v2_density_factor = std::max(0.0f, (*density_factors)[v2_index]);
+    looptri_density_factor = (v0_density_factor + v1_density_factor + v2_density_factor) / 3.0f;
+  }
+  const float area = area_tri_v3(v0_pos, v1_pos, v2_pos);
+
+  const float points_amount_fl = area * base_density * looptri_density_factor;
+  const float add_point_probability = fractf(points_amount_fl);
+  const bool add_point = add_point_probability > looptri_rng.get_float();
+  return (int)points_amount_fl + (int)add_point;
+}
+
 static void sample_mesh_surface(const Mesh &mesh,
                                 const float base_density,
                                 const FloatReadAttribute *density_factors,
@@ -88,51 +130,71 @@ static void sample_mesh_surface(const Mesh &mesh,
 {
   Span<MLoopTri> looptris = get_mesh_looptris(mesh);
 
-  for (const int looptri_index : looptris.index_range()) {
-    const MLoopTri &looptri = looptris[looptri_index];
-    const int v0_index = mesh.mloop[looptri.tri[0]].v;
-    const int v1_index = mesh.mloop[looptri.tri[1]].v;
-    const int v2_index = mesh.mloop[looptri.tri[2]].v;
-    const float3 v0_pos = mesh.mvert[v0_index].co;
-    const float3 v1_pos = mesh.mvert[v1_index].co;
-    const float3 v2_pos = mesh.mvert[v2_index].co;
-
-    float looptri_density_factor = 1.0f;
-    if (density_factors != nullptr) {
-      const float v0_density_factor = std::max(0.0f, (*density_factors)[v0_index]);
-      const float v1_density_factor = std::max(0.0f, (*density_factors)[v1_index]);
-      const float v2_density_factor = std::max(0.0f, (*density_factors)[v2_index]);
-      looptri_density_factor = (v0_density_factor + v1_density_factor + v2_density_factor) / 3.0f;
-    }
-    const float area = area_tri_v3(v0_pos, v1_pos, v2_pos);
-
-    const int looptri_seed = BLI_hash_int(looptri_index + seed);
-    RandomNumberGenerator looptri_rng(looptri_seed);
-
-    const float points_amount_fl = area * base_density * looptri_density_factor;
-    const float add_point_probability = fractf(points_amount_fl);
-    const bool add_point = add_point_probability > looptri_rng.get_float();
-    const int point_amount = (int)points_amount_fl + (int)add_point;
-
-    for (int i = 0; i < point_amount; i++) {
-      const float3 bary_coord = looptri_rng.get_barycentric_coordinates();
-      float3 point_pos;
-      interp_v3_v3v3v3(point_pos, v0_pos, v1_pos, v2_pos, bary_coord);
-      r_positions.append(point_pos);
-      r_bary_coords.append(bary_coord);
-      r_looptri_indices.append(looptri_index);
+  /* Count the points of every triangle first, so that the points can be written to their final
+   * position in parallel, in the same order as when the triangles are sampled one by one. */
+  Array<int> point_offsets(looptris.size() + 1);
+  parallel_for(looptris.index_range(), 1024, [&](IndexRange range) {
+    for (const int looptri_index : range) {
+      RandomNumberGenerator looptri_rng = get_looptri_rng(looptri_index, seed);
+      point_offsets[looptri_index] = sample_looptri_point_amount(
+          mesh, looptris[looptri_index], base_density, density_factors, looptri_rng);
     }
+  });
+
+  int offset = 0;
+  for (const int looptri_index : looptris.index_range()) {
+    const int point_amount = point_offsets[looptri_index];
+    point_offsets[looptri_index] = offset;
+    offset += point_amount;
   }
+  point_offsets.last() = offset;
+
+  const int old_size = r_positions.size();
+  r_positions.resize(old_size + offset);
+  r_bary_coords.resize(old_size + offset);
+  r_looptri_indices.resize(old_size + offset);
+
+  parallel_for(looptris.index_range(), 1024, [&](IndexRange range) {
+    for (const int looptri_index : range) {
+      const MLoopTri &looptri = looptris[looptri_index];
+      const float3 v0_pos = mesh.mvert[mesh.mloop[looptri.tri[0]].v].co;
+      const float3 v1_pos = mesh.mvert[mesh.mloop[looptri.tri[1]].v].co;
+      const float3 v2_pos = mesh.mvert[mesh.mloop[looptri.tri[2]].v].co;
+
+      /* Use the same random numbers as when counting the points. */
+      RandomNumberGenerator looptri_rng = get_looptri_rng(looptri_index, seed);
+      looptri_rng.get_float();
+
+      const IndexRange points{old_size + point_offsets[looptri_index],
+                              point_offsets[looptri_index + 1] - point_offsets[looptri_index]};
+      for (const int i : points) {
+        const float3 bary_coord = looptri_rng.get_barycentric_coordinates();
+        interp_v3_v3v3v3(r_positions[i], v0_pos, v1_pos, v2_pos, bary_coord);
+        r_bary_coords[i] = bary_coord;
+        r_looptri_indices[i] = looptri_index;
+      }
+    }
+  });
 }
 
-BLI_NOINLINE static KDTree_3d *build_kdtree(Span<float3> positions)
+/**
+ * Key of the cell of a uniform grid that contains the position. Coordinates out of the range of
+ * the key wrap around, which only merges cells that are far apart and is fine for the lookup of
+ * close points below, because distances are checked exactly anyway.
+ */
+static uint64_t point_grid_cell_key(const int x, const int y, const int z)
 {
-  KDTree_3d *kdtree = BLI_kdtree_3d_new(positions.size());
-  for (const int i : positions.index_range()) {
-    BLI_kdtree_3d_insert(kdtree, i, positions[i]);
+  const uint64_t mask = (1 << 21) - 1;
+  return ((uint64_t)x & mask) | (((uint64_t)y & mask) << 21) | (((uint64_t)z & mask) << 42);
+}
+
+static void point_grid_cell_coords(const float3 &position,
+                                   const float cell_size,
+                                   int r_coords[3])
+{
+  for (int axis = 0; axis < 3; axis++) {
+    r_coords[axis] = (int)floorf(position[axis] / cell_size);
   }
-  BLI_kdtree_3d_balance(kdtree);
-  return kdtree;
 }
 
 BLI_NOINLINE static void update_elimination_mask_for_close_points(
@@ -142,32 +204,67 @@ BLI_NOINLINE static void update_elimination_mask_for_close_points(
     return;
   }
 
-  KDTree_3d *kdtree = build_kdtree(positions);
+  /* Sort the points by the grid cell they are in, with cells as large as the minimum distance,
+   * so that all points closer than it are in the neighboring cells. */
+  Array<uint64_t> cell_keys(positions.size());
+  parallel_for(positions.index_range(), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      int coords[3];
+      point_grid_cell_coords(positions[i], minimum_distance, coords);
+      cell_keys[i] = point_grid_cell_key(coords[0], coords[1], coords[2]);
+    }
+  });
+
+  Array<int> sorted_indices(positions.size());
+  for (const int i : positions.index_range()) {
+    sorted_indices[i] = i;
+  }
+  std::sort(sorted_indices.begin(), sorted_indices.end(), [&](const int a, const int b) {
+    return cell_keys[a] < cell_keys[b];
+  });
+
+  Map<uint64_t, IndexRange> points_by_cell;
+  for (int start = 0; start < sorted_indices.size();) {
+    const uint64_t key = cell_keys[sorted_indices[start]];
+    int end = start + 1;
+    while (end < sorted_indices.size() && cell_keys[sorted_indices[end]] == key) {
+      end++;
+    }
+    points_by_cell.add_new(key, IndexRange(start, end - start));
+    start = end;
+  }
 
+  /* The points are visited in their original order, so that the same points are kept as when
+   * every point eliminates the points close to it one after another. */
+  const float minimum_distance_sq = minimum_distance * minimum_distance;
   for (const int i : positions.index_range()) {
     if (elimination_mask[i]) {
       continue;
     }
 
-    struct CallbackData {
-      int index;
-      MutableSpan<bool> elimination_mask;
-    } callback_data = {i, elimination_mask};
-
-    BLI_kdtree_3d_range_search_cb(
-        kdtree,
-        positions[i],
-        minimum_distance,
-        [](void *user_data, int index, const float *UNUSED(co), float UNUSED(dist_sq)) {
-          CallbackData &callback_data = *static_cast<CallbackData *>(user_data);
-          if (index != callback_data.index) {
-            callback_data.elimination_mask[index] = true;
+    const float3 position = positions[i];
+    int coords[3];
+    point_grid_cell_coords(position, minimum_distance, coords);
+
+    for (int x = coords[0] - 1; x <= coords[0] + 1; x++) {
+      for (int y = coords[1] - 1; y <= coords[1] + 1; y++) {
+        for (int z = coords[2] - 1; z <= coords[2] + 1; z++) {
+          const IndexRange *cell_points = points_by_cell.lookup_ptr(point_grid_cell_key(x, y, z));
+          if (cell_points == nullptr) {
+            continue;
           }
-          return true;
-        },
-        &callback_data);
+          for (const int sorted_index : *cell_points) {
+            const int other_index = sorted_indices[sorted_index];
+            if (other_index != i &&
+                float3::distance_squared(position, positions[other_index]) <=
+                    minimum_distance_sq) {
+              elimination_mask[other_index] = true;
+            }
+          }
+        }
+      }
+    }
   }
-  BLI_kdtree_3d_free(kdtree);
 }
 
 BLI_NOINLINE static void update_elimination_mask_based_on_density_factors(
@@ -178,30 +275,33 @@ BLI_NOINLINE static void update_elimination_mask_based_on_density_factors(
     MutableSpan<bool> elimination_mask)
 {
   Span<MLoopTri> looptris = get_mesh_looptris(mesh);
-  for (const int i : bary_coords.index_range()) {
-    if (elimination_mask[i]) {
-      continue;
-    }
+  parallel_for(bary_coords.index_range(), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      if (elimination_mask[i]) {
+        continue;
+      }
 
-    const MLoopTri &looptri = looptris[looptri_indices[i]];
-    const float3 bary_coord = bary_coords[i];
+      const MLoopTri &looptri = looptris[looptri_indices[i]];
+      const float3 bary_coord = bary_coords[i];
 
-    const int v0_index = mesh.mloop[looptri.tri[0]].v;
-    const int v1_index = mesh.mloop[looptri.tri[1]].v;
-    const int v2_index = mesh.mloop[looptri.tri[2]].v;
+      const int v0_index = mesh.mloop[looptri.tri[0]].v;
+      const int v1_index = mesh.mloop[looptri.tri[1]].v;
+      const int v2_index = mesh.mloop[looptri.tri[2]].v;
 
-    const float v0_density_factor = std::max(0.0f, density_factors[v0_index]);
-    const float v1_density_factor = std::max(0.0f, density_factors[v1_index]);
-    const float v2_density_factor = std::max(0.0f, density_factors[v2_index]);
+      const float v0_density_factor = std::max(0.0f, density_factors[v0_index]);
+      const float v1_density_factor = std::max(0.0f, density_factors[v1_index]);
+      const float v2_density_factor = std::max(0.0f, density_factors[v2_index]);
 
-    const float probablity = v0_density_factor * bary_coord.x + v1_density_factor * bary_coord.y +
-                             v2_density_factor * bary_coord.z;
+      const float probablity = v0_density_factor * bary_coord.x +
+                               v1_density_factor * bary_coord.y +
+                               v2_density_factor * bary_coord.z;
 
-    const float hash = BLI_hash_int_01(bary_coord.hash());
-    if (hash > probablity) {
-      elimination_mask[i] = true;
+      const float hash = BLI_hash_int_01(bary_coord.hash());
+      if (hash > probablity) {
+        elimination_mask[i] = true;
+      }
     }
-  }
+  });
 }
 
 BLI_NOINLINE static void eliminate_points_based_on_mask(Span<bool> elimination_mask,
@@ -23,6 +23,7 @@
 #include "DNA_pointcloud_types.h"
 
 #include "BLI_hash.h"
+#include "BLI_task.hh"
 
 #include "node_geometry_util.hh"
 
@@ -169,13 +170,28 @@ static void add_instances_from_geometry_component(InstancesComponent &instances,
       "scale", domain, {1, 1, 1});
   Int32ReadAttribute ids = src_geometry.attribute_get_for_read<int>("id", domain, -1);
 
+  Vector<int> instance_indices;
   for (const int i : IndexRange(domain_size)) {
     if (instances_data[i].has_value()) {
-      float transform[4][4];
-      loc_eul_size_to_mat4(transform, positions[i], rotations[i], scales[i]);
-      instances.add_instance(*instances_data[i], transform, ids[i]);
+      instance_indices.append(i);
     }
   }
+
+  /* Compute the transforms in parallel and add all instances at once. */
+  const int instances_amount = instance_indices.size();
+  Array<InstancedData> new_instances_data(instances_amount);
+  Array<float4x4> transforms(instances_amount);
+  Array<int> new_ids(instances_amount);
+  parallel_for(IndexRange(instances_amount), 1024, [&](IndexRange range) {
+    for (const int i : range) {
+      const int index = instance_indices[i];
+      new_instances_data[i] = *instances_data[index];
+      loc_eul_size_to_mat4(
+          transforms[i].values, positions[index], rotations[index], scales[index]);
+      new_ids[i] = ids[index];
+    }
+  });
+  instances.add_instances(new_instances_data, transforms, new_ids);
 }
 
 static void geo_node_point_instance_exec(GeoNodeExecParams params)
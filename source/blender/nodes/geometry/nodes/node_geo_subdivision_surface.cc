@@ -82,7 +82,8 @@ static void geo_node_subdivision_surface_exec(GeoNodeExecParams params)
       smooth_uvs);
 
   /* Apply subdivision to mesh. */
-  Subdiv *subdiv = BKE_subdiv_update_from_mesh(nullptr, &subdiv_settings, mesh_in);
+  Subdiv *subdiv = BKE_subdiv_update_from_mesh(
+      BKE_subdiv_cache_acquire(&subdiv_settings, mesh_in), &subdiv_settings, mesh_in);
 
   /* In case of bad topology, skip to input mesh. */
   if (subdiv == nullptr) {
@@ -96,7 +97,8 @@ static void geo_node_subdivision_surface_exec(GeoNodeExecParams params)
   geometry_set.replace_mesh(mesh_out);
 
   // BKE_subdiv_stats_print(&subdiv->stats);
-  BKE_subdiv_free(subdiv);
+  /* Keep the topology refiner around for the next evaluation, e.g. of the next frame. */
+  BKE_subdiv_cache_release(subdiv);
 
   params.set_output("Geometry", std::move(geometry_set));
 #endif
@@ -0,0 +1,227 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "BLI_color.hh"
+#include "BLI_float3.hh"
+
+#include "FN_multi_function_builder.hh"
+#include "FN_multi_function_network_evaluation.hh"
+
+#include "NOD_geometry_attribute_network.hh"
+#include "NOD_node_tree_multi_function.hh"
+
+namespace blender::nodes {
+
+static fn::MFDataType custom_data_type_to_mf_type(const CustomDataType type)
+{
+  const CPPType *cpp_type = bke::custom_data_type_to_cpp_type(type);
+  BLI_assert(cpp_type != nullptr);
+  return fn::MFDataType::ForSingle(*cpp_type);
+}
+
+GeoNodeAttributeNetwork::GeoNodeAttributeNetwork(const AttributeDomain domain) : domain_(domain)
+{
+}
+
+bool GeoNodeAttributeNetwork::try_add_node(const GeoNodeExecParams &params)
+{
+  BLI_assert(!is_finalized_);
+
+  const bNode &node = params.node();
+  if (node.typeinfo->geometry_node_expand_attributes == nullptr) {
+    return false;
+  }
+
+  GeoNodeAttributeNetworkBuilder builder{*this, params};
+  node.typeinfo->geometry_node_expand_attributes(builder);
+  return builder.is_supported();
+}
+
+fn::MFOutputSocket *GeoNodeAttributeNetwork::try_convert(fn::MFOutputSocket &socket,
+                                                         const CustomDataType from_type,
+                                                         const CustomDataType to_type)
+{
+  if (from_type == to_type) {
+    return &socket;
+  }
+
+  const fn::MultiFunction *conversion_fn = get_implicit_type_conversions().get_conversion(
+      custom_data_type_to_mf_type(from_type), custom_data_type_to_mf_type(to_type));
+  if (conversion_fn == nullptr) {
+    return nullptr;
+  }
+
+  fn::MFFunctionNode &conversion_node = network_.add_function(*conversion_fn);
+  network_.add_link(socket, conversion_node.input(0));
+  return &conversion_node.output(0);
+}
+
+void GeoNodeAttributeNetwork::finalize()
+{
+  for (auto item : attribute_results_.items()) {
+    fn::MFInputSocket &socket = network_.add_output(item.key,
+                                                    custom_data_type_to_mf_type(item.value.type));
+    network_.add_link(*item.value.socket, socket);
+    attribute_outputs_.append({item.key, item.value.type, &socket});
+  }
+  is_finalized_ = true;
+}
+
+void GeoNodeAttributeNetwork::compute(GeometryComponent &component)
+{
+  if (!is_finalized_) {
+    this->finalize();
+  }
+
+  const int domain_size = component.attribute_domain_size(domain_);
+  if (domain_size == 0) {
+    return;
+  }
+
+  /* Get the result attributes first, in case they have to overwrite existing attributes. Inputs
+   * and results never have the same name, see #GeoNodeAttributeNetworkBuilder. */
+  Vector<const fn::MFInputSocket *> output_sockets;
+  Vector<OutputAttributePtr> output_attributes;
+  for (const AttributeOutput &output : attribute_outputs_) {
+    OutputAttributePtr attribute = component.attribute_try_get_for_output(
+        output.name, domain_, output.type);
+    if (attribute) {
+      output_sockets.append(output.socket);
+      output_attributes.append(std::move(attribute));
+    }
+  }
+  if (output_sockets.is_empty()) {
+    return;
+  }
+
+  Vector<const fn::MFOutputSocket *> input_sockets;
+  Vector<ReadAttributePtr> input_attributes;
+  for (auto item : attribute_inputs_.items()) {
+    for (const AttributeSocket &input : item.value) {
+      input_sockets.append(input.socket);
+      input_attributes.append(
+          component.attribute_get_for_read(item.key, domain_, input.type, nullptr));
+    }
+  }
+
+  fn::MFNetworkEvaluator network_fn{std::move(input_sockets), std::move(output_sockets)};
+  fn::MFParamsBuilder fn_params{network_fn, domain_size};
+  for (const ReadAttributePtr &attribute : input_attributes) {
+    fn_params.add_readonly_single_input(attribute->get_span());
+  }
+  for (OutputAttributePtr &attribute : output_attributes) {
+    fn_params.add_uninitialized_single_output(attribute->get_span_for_write_only());
+  }
+
+  fn::MFContextBuilder fn_context;
+  network_fn.call(IndexRange(domain_size), fn_params, fn_context);
+
+  for (OutputAttributePtr &attribute : output_attributes) {
+    attribute.apply_span_and_save();
+  }
+}
+
+fn::MFOutputSocket &GeoNodeAttributeNetworkBuilder::get_input_attribute(
+    const StringRef name, const CustomDataType type)
+{
+  const bNodeSocket *found_socket = params_.find_available_socket(name);
+  BLI_assert(found_socket != nullptr); /* There should always be available socket for the name. */
+
+  fn::MFOutputSocket *socket = nullptr;
+  CustomDataType socket_type = type;
+  const fn::MultiFunction *constant_fn = nullptr;
+
+  if (found_socket == nullptr) {
+    const CPPType &cpp_type = *bke::custom_data_type_to_cpp_type(type);
+    constant_fn = &this->construct_fn<fn::CustomMF_GenericConstant>(cpp_type,
+                                                                     cpp_type.default_value());
+  }
+  else if (found_socket->type == SOCK_STRING) {
+    const std::string attribute_name = params_.get_input<std::string>(found_socket->identifier);
+    const GeoNodeAttributeNetwork::AttributeSocket *result =
+        network_.attribute_results_.lookup_ptr(attribute_name);
+    if (result != nullptr) {
+      /* Use the value computed by a previous node in the chain. */
+      socket = result->socket;
+      socket_type = result->type;
+    }
+    else {
+      Vector<GeoNodeAttributeNetwork::AttributeSocket> &inputs =
+          network_.attribute_inputs_.lookup_or_add_default(attribute_name);
+      for (const GeoNodeAttributeNetwork::AttributeSocket &input : inputs) {
+        if (input.type == type) {
+          socket = input.socket;
+        }
+      }
+      if (socket == nullptr) {
+        socket = &network_.network_.add_input(attribute_name, custom_data_type_to_mf_type(type));
+        inputs.append({socket, type});
+      }
+    }
+  }
+  else if (found_socket->type == SOCK_FLOAT) {
+    const float value = params_.get_input<float>(found_socket->identifier);
+    constant_fn = &this->construct_fn<fn::CustomMF_Constant<float>>(value);
+    socket_type = CD_PROP_FLOAT;
+  }
+  else if (found_socket->type == SOCK_VECTOR) {
+    const float3 value = params_.get_input<float3>(found_socket->identifier);
+    constant_fn = &this->construct_fn<fn::CustomMF_Constant<float3>>(value);
+    socket_type = CD_PROP_FLOAT3;
+  }
+  else if (found_socket->type == SOCK_RGBA) {
+    const Color4f value = params_.get_input<Color4f>(found_socket->identifier);
+    constant_fn = &this->construct_fn<fn::CustomMF_Constant<Color4f>>(value);
+    socket_type = CD_PROP_COLOR;
+  }
+  else {
+    BLI_assert(false);
+    this->set_not_supported();
+    const CPPType &cpp_type = *bke::custom_data_type_to_cpp_type(type);
+    constant_fn = &this->construct_fn<fn::CustomMF_GenericConstant>(cpp_type,
+                                                                     cpp_type.default_value());
+  }
+
+  if (constant_fn != nullptr) {
+    socket = &network_.network_.add_function(*constant_fn).output(0);
+  }
+
+  fn::MFOutputSocket *converted_socket = network_.try_convert(*socket, socket_type, type);
+  if (converted_socket == nullptr) {
+    /* Still return a socket with the expected type, the network won't be used anyway. */
+    this->set_not_supported();
+    const CPPType &cpp_type = *bke::custom_data_type_to_cpp_type(type);
+    constant_fn = &this->construct_fn<fn::CustomMF_GenericConstant>(cpp_type,
+                                                                     cpp_type.default_value());
+    return network_.network_.add_function(*constant_fn).output(0);
+  }
+  return *converted_socket;
+}
+
+void GeoNodeAttributeNetworkBuilder::set_result_attribute(const StringRef name,
+                                                          const CustomDataType type,
+                                                          fn::MFOutputSocket &socket)
+{
+  /* Writing an attribute that is read from the geometry would change the inputs while the
+   * network is evaluated. Empty names can't be created as attributes at all. */
+  if (name.is_empty() || network_.attribute_inputs_.contains_as(name)) {
+    this->set_not_supported();
+    return;
+  }
+  network_.attribute_results_.add_overwrite(name, {&socket, type});
+}
+
+}  // namespace blender::nodes
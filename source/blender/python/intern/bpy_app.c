@@ -47,9 +47,14 @@
 
 #include "BLI_utildefines.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "BKE_appdir.h"
 #include "BKE_blender_version.h"
 #include "BKE_global.h"
+#include "BKE_idtype.h"
+
+#include "BLO_readfile.h"
 
 #include "DNA_ID.h"
 
@@ -356,6 +361,97 @@ static PyObject *bpy_app_preview_render_size_get(PyObject *UNUSED(self), void *c
   return PyLong_FromLong((long)UI_icon_preview_to_render_size(POINTER_AS_INT(closure)));
 }
 
+static void bpy_app_dict_set_item_steal(PyObject *dict, const char *key, PyObject *value)
+{
+  PyDict_SetItemString(dict, key, value);
+  Py_DECREF(value);
+}
+
+PyDoc_STRVAR(bpy_app_load_stats_doc,
+             "Dictionary with timings (in seconds) and sizes of the last loaded blend file, "
+             "None when no file was loaded (read-only)");
+static PyObject *bpy_app_load_stats_get(PyObject *UNUSED(self), void *UNUSED(closure))
+{
+  const BlendReadStats *stats = BLO_read_stats_last();
+  if (stats == NULL) {
+    Py_RETURN_NONE;
+  }
+
+  PyObject *ret = PyDict_New();
+  bpy_app_dict_set_item_steal(ret, "filepath", PyC_UnicodeFromByte(stats->filepath));
+  bpy_app_dict_set_item_steal(ret, "time_total", PyFloat_FromDouble(stats->time_total));
+  bpy_app_dict_set_item_steal(
+      ret, "time_reconstruct", PyFloat_FromDouble(stats->time_reconstruct));
+  bpy_app_dict_set_item_steal(ret, "time_versioning", PyFloat_FromDouble(stats->time_versioning));
+  bpy_app_dict_set_item_steal(ret, "time_lib_link", PyFloat_FromDouble(stats->time_lib_link));
+  bpy_app_dict_set_item_steal(ret, "time_libraries", PyFloat_FromDouble(stats->time_libraries));
+  bpy_app_dict_set_item_steal(ret, "ids", PyLong_FromLong(stats->ids_len));
+  bpy_app_dict_set_item_steal(
+      ret, "structs_reconstructed", PyLong_FromLong(stats->structs_reconstructed));
+  bpy_app_dict_set_item_steal(ret, "bytes", PyLong_FromUnsignedLongLong(stats->bytes));
+
+  PyObject *id_types = PyDict_New();
+  for (int i = 0; i < stats->id_types_len; i++) {
+    const BlendReadStatsIDType *stats_type = &stats->id_types[i];
+    PyObject *item = PyDict_New();
+    bpy_app_dict_set_item_steal(item, "ids", PyLong_FromLong(stats_type->ids_len));
+    bpy_app_dict_set_item_steal(
+        item, "structs_reconstructed", PyLong_FromLong(stats_type->structs_reconstructed));
+    bpy_app_dict_set_item_steal(item, "bytes", PyLong_FromUnsignedLongLong(stats_type->bytes));
+    bpy_app_dict_set_item_steal(item, "time", PyFloat_FromDouble(stats_type->time));
+    bpy_app_dict_set_item_steal(
+        id_types, BKE_idtype_idcode_to_name_plural(stats_type->idcode), item);
+  }
+  bpy_app_dict_set_item_steal(ret, "id_types", id_types);
+
+  PyObject *libraries = PyList_New(stats->libraries_len);
+  for (int i = 0; i < stats->libraries_len; i++) {
+    const BlendReadStatsLibrary *stats_lib = &stats->libraries[i];
+    PyObject *item = PyDict_New();
+    bpy_app_dict_set_item_steal(item, "filepath", PyC_UnicodeFromByte(stats_lib->filepath));
+    bpy_app_dict_set_item_steal(item, "ids", PyLong_FromLong(stats_lib->ids_len));
+    bpy_app_dict_set_item_steal(item, "bytes", PyLong_FromUnsignedLongLong(stats_lib->bytes));
+    bpy_app_dict_set_item_steal(item, "time", PyFloat_FromDouble(stats_lib->time));
+    PyList_SET_ITEM(libraries, i, item);
+  }
+  bpy_app_dict_set_item_steal(ret, "libraries", libraries);
+
+  return ret;
+}
+
+static void bpy_app_memory_stats_name_cb(const char *name,
+                                         size_t mem_in_use,
+                                         size_t blocks_num,
+                                         void *user_data)
+{
+  PyObject *names = user_data;
+  PyObject *item = PyDict_New();
+  bpy_app_dict_set_item_steal(item, "bytes", PyLong_FromSize_t(mem_in_use));
+  bpy_app_dict_set_item_steal(item, "blocks", PyLong_FromSize_t(blocks_num));
+  bpy_app_dict_set_item_steal(names, name, item);
+}
+
+PyDoc_STRVAR(bpy_app_memory_stats_doc,
+             "Dictionary with the memory in use, peak memory and number of allocated blocks. "
+             "With --debug-memory-sampled, \"names\" holds the estimated memory per allocation "
+             "name, otherwise it is None (read-only)");
+static PyObject *bpy_app_memory_stats_get(PyObject *UNUSED(self), void *UNUSED(closure))
+{
+  PyObject *ret = PyDict_New();
+  bpy_app_dict_set_item_steal(ret, "bytes", PyLong_FromSize_t(MEM_get_memory_in_use()));
+  bpy_app_dict_set_item_steal(ret, "peak", PyLong_FromSize_t(MEM_get_peak_memory()));
+  bpy_app_dict_set_item_steal(ret, "blocks", PyLong_FromSize_t(MEM_get_memory_blocks_in_use()));
+
+  PyObject *names = PyDict_New();
+  if (!MEM_sampled_stats_foreach(bpy_app_memory_stats_name_cb, names)) {
+    Py_DECREF(names);
+    names = Py_INCREF_RET(Py_None);
+  }
+  bpy_app_dict_set_item_steal(ret, "names", names);
+
+  return ret;
+}
+
 static PyObject *bpy_app_autoexec_fail_message_get(PyObject *UNUSED(self), void *UNUSED(closure))
 {
   return PyC_UnicodeFromByte(G.autoexec_fail);
@@ -451,6 +547,8 @@ static PyGetSetDef bpy_app_getsets[] = {
      NULL},
     {"tempdir", bpy_app_tempdir_get, NULL, bpy_app_tempdir_doc, NULL},
     {"driver_namespace", bpy_app_driver_dict_get, NULL, bpy_app_driver_dict_doc, NULL},
+    {"load_stats", bpy_app_load_stats_get, NULL, bpy_app_load_stats_doc, NULL},
+    {"memory_stats", bpy_app_memory_stats_get, NULL, bpy_app_memory_stats_doc, NULL},
 
     {"render_icon_size",
      bpy_app_preview_render_size_get,
@@ -5269,8 +5269,11 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
       buffer_is_compat = foreach_compat_buffer(raw_type, attr_signed, buf.format);
 
       if (buffer_is_compat) {
+        /* The buffer is held until it's released, let other Python threads run meanwhile. */
+        BPy_BEGIN_ALLOW_THREADS;
         ok = RNA_property_collection_raw_set(
             NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
+        BPy_END_ALLOW_THREADS;
       }
 
       PyBuffer_Release(&buf);
@@ -5310,8 +5313,10 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
         Py_DECREF(item);
       }
 
+      BPy_BEGIN_ALLOW_THREADS;
       ok = RNA_property_collection_raw_set(
           NULL, &self->ptr, self->prop, attr, array, raw_type, tot);
+      BPy_END_ALLOW_THREADS;
     }
   }
   else {
@@ -5325,8 +5330,11 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
       buffer_is_compat = foreach_compat_buffer(raw_type, attr_signed, buf.format);
 
       if (buffer_is_compat) {
+        /* The buffer is held until it's released, let other Python threads run meanwhile. */
+        BPy_BEGIN_ALLOW_THREADS;
         ok = RNA_property_collection_raw_get(
             NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
+        BPy_END_ALLOW_THREADS;
       }
 
       PyBuffer_Release(&buf);
@@ -5336,8 +5344,10 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
     if (!buffer_is_compat) {
       array = PyMem_Malloc(size * tot);
 
+      BPy_BEGIN_ALLOW_THREADS;
       ok = RNA_property_collection_raw_get(
           NULL, &self->ptr, self->prop, attr, array, raw_type, tot);
+      BPy_END_ALLOW_THREADS;
 
       if (!ok) {
         /* Skip the loop. */
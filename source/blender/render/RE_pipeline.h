@@ -318,6 +318,19 @@ bool RE_WriteRenderResult(struct ReportList *reports,
                           int layer);
 struct RenderResult *RE_MultilayerConvert(
     void *exrhandle, const char *colorspace, bool predivide, int rectx, int recty);
+/**
+ * Read the pixels of passes of a result converted from a file loaded with
+ * IB_multilayer_deferred. Passes that already have pixels are kept.
+ * \param rl: only read passes of this layer, all layers when NULL.
+ * \param pass_names: only read passes with these names, all passes when NULL.
+ */
+bool RE_MultilayerReadPasses(struct RenderResult *rr,
+                             struct RenderLayer *rl,
+                             const char **pass_names,
+                             int pass_names_len,
+                             const char *filepath,
+                             const char *colorspace,
+                             bool predivide);
 
 /* display and event callbacks */
 void RE_display_init_cb(struct Render *re,
@@ -345,6 +345,10 @@ static int multiresbake_test_break(MultiresBakeRender *bkr)
 
 /* **** Threading routines **** */
 
+/* Number of triangles handed to a thread at once. Consecutive triangles are usually neighbors,
+ * so their pixels and the multires grids they sample are close in memory. */
+#define MULTIRES_BAKE_QUEUE_CHUNK_SIZE 64
+
 typedef struct MultiresBakeQueue {
   int cur_tri;
   int tot_tri;
@@ -366,22 +370,26 @@ typedef struct MultiresBakeThread {
   float height_min, height_max;
 } MultiresBakeThread;
 
-static int multires_bake_queue_next_tri(MultiresBakeQueue *queue)
+/**
+ * Get the next range of triangles to bake.
+ * \return false when all triangles have been handed out.
+ */
+static bool multires_bake_queue_next_tri_range(MultiresBakeQueue *queue,
+                                               int *r_tri_start,
+                                               int *r_tri_end)
 {
-  int face = -1;
-
-  /* TODO: it could worth making it so thread will handle neighbor faces
-   *       for better memory cache utilization
-   */
+  bool found = false;
 
   BLI_spin_lock(&queue->spin);
   if (queue->cur_tri < queue->tot_tri) {
-    face = queue->cur_tri;
-    queue->cur_tri++;
+    *r_tri_start = queue->cur_tri;
+    *r_tri_end = min_ii(queue->cur_tri + MULTIRES_BAKE_QUEUE_CHUNK_SIZE, queue->tot_tri);
+    queue->cur_tri = *r_tri_end;
+    found = true;
   }
   BLI_spin_unlock(&queue->spin);
 
-  return face;
+  return found;
 }
 
 static void *do_multires_bake_thread(void *data_v)
@@ -390,28 +398,39 @@ static void *do_multires_bake_thread(void *data_v)
   MResolvePixelData *data = &handle->data;
   MBakeRast *bake_rast = &handle->bake_rast;
   MultiresBakeRender *bkr = handle->bkr;
-  int tri_index;
+  int tri_start, tri_end;
+  bool is_break = false;
+
+  while (!is_break && multires_bake_queue_next_tri_range(handle->queue, &tri_start, &tri_end)) {
+    int baked_tri_len = 0;
 
-  while ((tri_index = multires_bake_queue_next_tri(handle->queue)) >= 0) {
-    const MLoopTri *lt = &data->mlooptri[tri_index];
-    const MPoly *mp = &data->mpoly[lt->poly];
-    const short mat_nr = mp->mat_nr;
-    const MLoopUV *mloopuv = data->mloopuv;
+    for (int tri_index = tri_start; tri_index < tri_end; tri_index++) {
+      const MLoopTri *lt = &data->mlooptri[tri_index];
+      const MPoly *mp = &data->mpoly[lt->poly];
+      const short mat_nr = mp->mat_nr;
+      const MLoopUV *mloopuv = data->mloopuv;
 
-    if (multiresbake_test_break(bkr)) {
-      break;
+      if (multiresbake_test_break(bkr)) {
+        is_break = true;
+        break;
+      }
+
+      Image *tri_image = mat_nr < bkr->ob_image.len ? bkr->ob_image.array[mat_nr] : NULL;
+      if (tri_image != handle->image) {
+        continue;
+      }
+
+      data->tri_index = tri_index;
+
+      bake_rasterize(
+          bake_rast, mloopuv[lt->tri[0]].uv, mloopuv[lt->tri[1]].uv, mloopuv[lt->tri[2]].uv);
+      baked_tri_len++;
     }
 
-    Image *tri_image = mat_nr < bkr->ob_image.len ? bkr->ob_image.array[mat_nr] : NULL;
-    if (tri_image != handle->image) {
+    if (baked_tri_len == 0) {
       continue;
     }
 
-    data->tri_index = tri_index;
-
-    bake_rasterize(
-        bake_rast, mloopuv[lt->tri[0]].uv, mloopuv[lt->tri[1]].uv, mloopuv[lt->tri[2]].uv);
-
     /* tag image buffer for refresh */
     if (data->ibuf->rect_float) {
       data->ibuf->userflags |= IB_RECT_INVALID;
@@ -421,7 +440,7 @@ static void *do_multires_bake_thread(void *data_v)
 
     /* update progress */
     BLI_spin_lock(&handle->queue->spin);
-    bkr->baked_faces++;
+    bkr->baked_faces += baked_tri_len;
 
     if (bkr->do_update) {
       *bkr->do_update = true;
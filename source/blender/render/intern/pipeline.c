@@ -293,6 +293,18 @@ RenderResult *RE_MultilayerConvert(
   return render_result_new_from_exr(exrhandle, colorspace, predivide, rectx, recty);
 }
 
+bool RE_MultilayerReadPasses(RenderResult *rr,
+                             RenderLayer *rl,
+                             const char **pass_names,
+                             int pass_names_len,
+                             const char *filepath,
+                             const char *colorspace,
+                             bool predivide)
+{
+  return render_result_exr_file_read_passes(
+      rr, rl, pass_names, pass_names_len, filepath, colorspace, predivide);
+}
+
 RenderLayer *render_get_active_layer(Render *re, RenderResult *rr)
 {
   ViewLayer *view_layer = BLI_findlink(&re->view_layers, re->active_view_layer);
@@ -1286,10 +1298,142 @@ static void render_composit_stats(void *arg, const char *str)
   re->stats_draw(re->sdh, &i);
 }
 
+/* Result of an animation frame that was composited ahead of rendering it. */
+typedef struct RenderFrameResult {
+  struct RenderFrameResult *next, *prev;
+  int frame;
+  RenderResult *result;
+} RenderFrameResult;
+
+static void render_frame_results_free(Render *re)
+{
+  LISTBASE_FOREACH_MUTABLE (RenderFrameResult *, frame_result, &re->frame_results) {
+    render_result_free(frame_result->result);
+    MEM_freeN(frame_result);
+  }
+  BLI_listbase_clear(&re->frame_results);
+}
+
+/* Take the composited result of a frame, results of earlier frames are freed.
+ * Returns NULL when the frame wasn't composited ahead. */
+static RenderResult *render_frame_result_pop(Render *re, int frame)
+{
+  LISTBASE_FOREACH_MUTABLE (RenderFrameResult *, frame_result, &re->frame_results) {
+    if (frame_result->frame > frame) {
+      break;
+    }
+    RenderResult *result = frame_result->result;
+    const bool is_frame = frame_result->frame == frame;
+    BLI_remlink(&re->frame_results, frame_result);
+    MEM_freeN(frame_result);
+    if (is_frame) {
+      return result;
+    }
+    render_result_free(result);
+  }
+  return NULL;
+}
+
+/* Animations that don't render any scene are only composited. When nothing else depends on the
+ * frame, the compositor can calculate several frames in parallel. */
+static bool render_use_parallel_frames(Render *re, Scene *scene)
+{
+  bNodeTree *ntree = re->pipeline_scene_eval->nodetree;
+  RenderEngineType *type = RE_engines_find(re->r.engine);
+
+  if (ntree == NULL || (ntree->flag & NTREE_COM_PARALLEL_FRAMES) == 0) {
+    return false;
+  }
+  if (composite_needs_render(re->pipeline_scene_eval, 1)) {
+    return false;
+  }
+  /* The engine or the sequencer create the result instead of the compositor. */
+  if (type->render && (type->flag & RE_USE_POSTPROCESS)) {
+    return false;
+  }
+  if (RE_seq_render_active(scene, &re->r)) {
+    return false;
+  }
+  /* Existing frames are skipped. */
+  if (re->r.mode & R_NO_OVERWRITE) {
+    return false;
+  }
+  /* Scene animation is only evaluated for the frame being rendered. */
+  AnimData *adt = BKE_animdata_from_id(&scene->id);
+  if (adt && (adt->action || !BLI_listbase_is_empty(&adt->drivers))) {
+    return false;
+  }
+  return ntreeCompositCanExecFrames(ntree);
+}
+
+/* Composite the frames from the current frame on in parallel, their results are used when the
+ * frames are rendered (see do_render_composite). */
+static void render_composite_frames_ahead(Render *re, int efra, int tfra)
+{
+  Scene *scene_eval = re->pipeline_scene_eval;
+  bNodeTree *ntree = scene_eval->nodetree;
+  const int max_frames = BKE_render_num_threads(&re->r);
+  int *frames = MEM_mallocN(sizeof(int) * max_frames, __func__);
+  RenderResult **results = MEM_mallocN(sizeof(RenderResult *) * max_frames, __func__);
+  int num_frames = 0;
+
+  if ((re->r.mode & R_CROP) == 0) {
+    render_result_disprect_to_full_resolution(re);
+  }
+  for (int cfra = re->r.cfra; cfra <= efra && num_frames < max_frames; cfra += tfra) {
+    frames[num_frames] = cfra;
+    results[num_frames] = render_result_new(
+        re, &re->disprect, RR_USE_MEM, RR_ALL_LAYERS, RR_ALL_VIEWS);
+    num_frames++;
+  }
+
+  ntreeCompositTagRender(scene_eval);
+
+  ntree->stats_draw = render_composit_stats;
+  ntree->test_break = re->test_break;
+  ntree->progress = re->progress;
+  ntree->sdh = re;
+  ntree->tbh = re->tbh;
+  ntree->prh = re->prh;
+
+  LISTBASE_FOREACH (RenderView *, rv, &results[0]->views) {
+    ntreeCompositExecFrames(scene_eval,
+                            ntree,
+                            &re->r,
+                            frames,
+                            results,
+                            num_frames,
+                            &re->scene->view_settings,
+                            &re->scene->display_settings,
+                            rv->name);
+  }
+
+  ntree->stats_draw = NULL;
+  ntree->test_break = NULL;
+  ntree->progress = NULL;
+  ntree->tbh = ntree->sdh = ntree->prh = NULL;
+
+  const bool is_break = re->test_break(re->tbh);
+  for (int i = 0; i < num_frames; i++) {
+    if (is_break) {
+      render_result_free(results[i]);
+      continue;
+    }
+    RenderFrameResult *frame_result = MEM_callocN(sizeof(RenderFrameResult), __func__);
+    frame_result->frame = frames[i];
+    frame_result->result = results[i];
+    BLI_addtail(&re->frame_results, frame_result);
+  }
+
+  MEM_freeN(frames);
+  MEM_freeN(results);
+}
+
 /* returns fully composited render-result on given time step (in RenderData) */
 static void do_render_composite(Render *re)
 {
   bNodeTree *ntree = re->pipeline_scene_eval->nodetree;
+  RenderResult *frame_result = NULL;
   int update_newframe = 0;
 
   if (composite_needs_render(re->pipeline_scene_eval, 1)) {
@@ -1304,6 +1448,7 @@ static void do_render_composite(Render *re)
   }
   else {
     re->i.cfra = re->r.cfra;
+    frame_result = render_frame_result_pop(re, re->r.cfra);
 
     /* ensure new result gets added, like for regular renders */
     BLI_rw_mutex_lock(&re->resultmutex, THREAD_LOCK_WRITE);
@@ -1312,7 +1457,12 @@ static void do_render_composite(Render *re)
     if ((re->r.mode & R_CROP) == 0) {
       render_result_disprect_to_full_resolution(re);
     }
-    re->result = render_result_new(re, &re->disprect, RR_USE_MEM, RR_ALL_LAYERS, RR_ALL_VIEWS);
+    if (frame_result) {
+      re->result = frame_result;
+    }
+    else {
+      re->result = render_result_new(re, &re->disprect, RR_USE_MEM, RR_ALL_LAYERS, RR_ALL_VIEWS);
+    }
 
     BLI_rw_mutex_unlock(&re->resultmutex);
 
@@ -1327,7 +1477,8 @@ static void do_render_composite(Render *re)
     BLI_rw_mutex_unlock(&re->resultmutex);
   }
 
-  if (!re->test_break(re->tbh)) {
+  /* Frames composited ahead already have the final result. */
+  if (frame_result == NULL && !re->test_break(re->tbh)) {
 
     if (ntree) {
       ntreeCompositTagRender(re->pipeline_scene_eval);
@@ -2428,6 +2579,8 @@ void RE_RenderAnim(Render *re,
 
   re->flag |= R_ANIMATION;
 
+  const bool use_parallel_frames = render_use_parallel_frames(re, scene);
+
   {
     for (nfra = sfra, scene->r.cfra = sfra; scene->r.cfra <= efra; scene->r.cfra++) {
       char name[FILE_MAX];
@@ -2541,6 +2694,10 @@ void RE_RenderAnim(Render *re,
       /* run callbacks before rendering, before the scene is updated */
       render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_PRE);
 
+      if (use_parallel_frames && BLI_listbase_is_empty(&re->frame_results)) {
+        render_composite_frames_ahead(re, efra, tfra);
+      }
+
       do_render_all_options(re);
       totrendered++;
 
@@ -2607,6 +2764,9 @@ void RE_RenderAnim(Render *re,
 
   scene->r.cfra = cfrao;
 
+  /* Frames composited ahead that weren't rendered because of a break. */
+  render_frame_results_free(re);
+
   re->flag &= ~R_ANIMATION;
 
   render_callback_exec_id(re,
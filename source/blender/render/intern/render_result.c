@@ -759,7 +759,8 @@ RenderResult *render_result_new_from_exr(
       rpass->rectx = rectx;
       rpass->recty = recty;
 
-      if (rpass->channels >= 3) {
+      /* Passes of files loaded with IB_multilayer_deferred don't have pixels yet. */
+      if (rpass->rect && rpass->channels >= 3) {
         IMB_colormanagement_transform(rpass->rect,
                                       rpass->rectx,
                                       rpass->recty,
@@ -1357,6 +1358,95 @@ int render_result_exr_file_read_path(RenderResult *rr,
   return 1;
 }
 
+static bool render_pass_name_in_array(const RenderPass *rpass,
+                                      const char **pass_names,
+                                      const int pass_names_len)
+{
+  for (int i = 0; i < pass_names_len; i++) {
+    if (STREQ(rpass->name, pass_names[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* Read the pixels of the passes of a render result converted without them. */
+bool render_result_exr_file_read_passes(RenderResult *rr,
+                                        RenderLayer *rl_single,
+                                        const char **pass_names,
+                                        const int pass_names_len,
+                                        const char *filepath,
+                                        const char *colorspace,
+                                        bool predivide)
+{
+  void *exrhandle = IMB_exr_get_handle();
+  int rectx, recty;
+
+  if (IMB_exr_begin_read(exrhandle, filepath, &rectx, &recty) == 0) {
+    printf("failed being read %s\n", filepath);
+    IMB_exr_close(exrhandle);
+    return false;
+  }
+
+  if (rectx != rr->rectx || recty != rr->recty) {
+    printf("error in reading passes: dimensions of %s changed\n", filepath);
+    IMB_exr_close(exrhandle);
+    return false;
+  }
+
+  /* Only the channels of the passes to read get a rect, the others are skipped while reading. */
+  ListBase read_passes = {NULL, NULL};
+  LISTBASE_FOREACH (RenderLayer *, rl, &rr->layers) {
+    if (rl_single && rl_single != rl) {
+      continue;
+    }
+
+    LISTBASE_FOREACH (RenderPass *, rpass, &rl->passes) {
+      if (rpass->rect != NULL) {
+        continue;
+      }
+      if (pass_names && !render_pass_name_in_array(rpass, pass_names, pass_names_len)) {
+        continue;
+      }
+
+      const int xstride = rpass->channels;
+      const size_t rectsize = ((size_t)rectx) * recty * rpass->channels;
+      char fullname[EXR_PASS_MAXNAME];
+
+      rpass->rect = MEM_callocN(sizeof(float) * rectsize, "loaded pass");
+      for (int a = 0; a < xstride; a++) {
+        set_pass_full_name(fullname, rpass->name, a, rpass->view, rpass->chan_id);
+        IMB_exr_set_channel(
+            exrhandle, rl->name, fullname, xstride, xstride * rectx, rpass->rect + a);
+      }
+      BLI_addtail(&read_passes, BLI_genericNodeN(rpass));
+    }
+  }
+
+  if (!BLI_listbase_is_empty(&read_passes)) {
+    IMB_exr_read_channels(exrhandle);
+  }
+  IMB_exr_close(exrhandle);
+
+  const char *to_colorspace = IMB_colormanagement_role_colorspace_name_get(
+      COLOR_ROLE_SCENE_LINEAR);
+  LISTBASE_FOREACH (LinkData *, link, &read_passes) {
+    RenderPass *rpass = link->data;
+    if (rpass->channels >= 3) {
+      IMB_colormanagement_transform(rpass->rect,
+                                    rpass->rectx,
+                                    rpass->recty,
+                                    rpass->channels,
+                                    colorspace,
+                                    to_colorspace,
+                                    predivide);
+    }
+  }
+  BLI_freelistN(&read_passes);
+
+  return true;
+}
+
 static void render_result_exr_file_cache_path(Scene *sce, const char *root, char *r_path)
 {
   char filename_full[FILE_MAX + MAX_ID_NAME + 100], filename[FILE_MAXFILE], dirname[FILE_MAXDIR];
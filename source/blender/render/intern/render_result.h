@@ -104,6 +104,13 @@ void render_result_exr_file_path(struct Scene *scene,
 int render_result_exr_file_read_path(struct RenderResult *rr,
                                      struct RenderLayer *rl_single,
                                      const char *filepath);
+bool render_result_exr_file_read_passes(struct RenderResult *rr,
+                                        struct RenderLayer *rl_single,
+                                        const char **pass_names,
+                                        const int pass_names_len,
+                                        const char *filepath,
+                                        const char *colorspace,
+                                        bool predivide);
 
 /* EXR cache */
 
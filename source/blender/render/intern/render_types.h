@@ -81,6 +81,9 @@ struct Render {
   RenderResult *pushedresult;
   /* a list of RenderResults, for fullsample */
   ListBase fullresult;
+  /* results of animation frames composited in parallel ahead of rendering them,
+   * a list of RenderFrameResult */
+  ListBase frame_results;
   /* read/write mutex, all internal code that writes to re->result must use a
    * write lock, all external code must use a read lock. internal code is assumed
    * to not conflict with writes, so no lock used for that */
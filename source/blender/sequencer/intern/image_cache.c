@@ -22,6 +22,7 @@
 
 #include <memory.h>
 #include <stddef.h>
+#include <stdlib.h>
 #include <time.h>
 
 #include "MEM_guardedalloc.h"
@@ -40,6 +41,7 @@
 #include "BLI_fileops_types.h"
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
+#include "BLI_math_base.h"
 #include "BLI_mempool.h"
 #include "BLI_path_util.h"
 #include "BLI_threads.h"
@@ -57,6 +59,15 @@
 #include "prefetch.h"
 #include "strip_time.h"
 
+#ifdef WITH_LZO
+#  ifdef WITH_SYSTEM_LZO
+#    include <lzo/lzo1x.h>
+#  else
+#    include "minilzo.h"
+#  endif
+#  define LZO_OUT_LEN(size) ((size) + (size) / 16 + 64 + 3)
+#endif
+
 /**
  * Sequencer Cache Design Notes
  * ============================
@@ -81,6 +92,13 @@
  *
  * User can exclude caching of some images. Such entries will have is_temp_cache set.
  *
+ * Compression: With #SEQ_CACHE_COMPRESS, a full cache first compresses images of frames furthest
+ * from the current frame, and only frees frames once nothing is left to compress.
+ * Byte images are compressed with LZO, float images are stored as half float (and LZO compressed
+ * on top of that). Only the pixels are compressed, the #ImBuf itself stays in the cache and is
+ * decompressed in place when looked up again. Compressed memory is accounted for by guarded
+ * allocator, so more frames fit within the same memory limit.
+ *
  *
  * Disk Cache Design Notes
  * =======================
@@ -96,6 +114,10 @@
  * size specified in user preferences.
  * To distinguish 2 blend files with same name, scene->ed->disk_cache_timestamp
  * is used as UID. Blend file can still be copied manually which may cause conflict.
+ * Images are written by a background thread, so rendering doesn't wait for compression and I/O.
+ * If more than DCACHE_WRITE_QUEUE_MAX images are waiting, the rendering thread writes itself.
+ * Images queued before an invalidation are not written.
+ * Reading ahead of the playhead is done by prefetching, which looks up disk cache as well.
  *
  */
 
@@ -103,6 +125,7 @@
 #define DCACHE_FNAME_FORMAT "%d-%dx%d-%d%%(%d)-%d.dcf"
 #define DCACHE_IMAGES_PER_FILE 100
 #define DCACHE_CURRENT_VERSION 1
+#define DCACHE_WRITE_QUEUE_MAX 16
 #define COLORSPACE_NAME_MAX 64 /* XXX: defined in imb intern */
 
 typedef struct DiskCacheHeaderEntry {
@@ -124,6 +147,11 @@ typedef struct SeqDiskCache {
   ListBase files;
   ThreadMutex read_write_mutex;
   size_t size_total;
+  /* Images waiting to be written, see #DiskCacheWriteItem. */
+  ThreadQueue *write_queue;
+  ListBase write_threads;
+  /* Incremented by invalidation, queued images from before are discarded. */
+  int invalidate_count;
 } SeqDiskCache;
 
 typedef struct DiskCacheFile {
@@ -153,6 +181,15 @@ typedef struct SeqCache {
 typedef struct SeqCacheItem {
   struct SeqCache *cache_owner;
   struct ImBuf *ibuf;
+  /* Pixels of `ibuf` while it is compressed, NULL otherwise. */
+  void *compressed;
+  size_t compressed_size;
+  /* Size of the pixels after conversion to half float, before LZO compression. */
+  size_t compressed_size_raw;
+  bool compressed_is_float;
+  bool compressed_is_lzo;
+  /* Compression was tried and didn't reduce size, don't try again. */
+  bool compress_skip;
 } SeqCacheItem;
 
 typedef struct SeqCacheKey {
@@ -171,6 +208,14 @@ typedef struct SeqCacheKey {
   int type;
 } SeqCacheKey;
 
+typedef struct DiskCacheWriteItem {
+  char path[FILE_MAX];
+  /* Copy, the key can be freed before the image is written. Strip may be freed as well. */
+  SeqCacheKey key;
+  ImBuf *ibuf;
+  int invalidate_count;
+} DiskCacheWriteItem;
+
 static ThreadMutex cache_create_lock = BLI_MUTEX_INITIALIZER;
 static float seq_cache_timeline_frame_to_frame_index(Sequence *seq,
                                                      float timeline_frame,
@@ -480,6 +525,8 @@ static void seq_disk_cache_invalidate(Scene *scene,
 
   BLI_mutex_lock(&disk_cache->read_write_mutex);
 
+  disk_cache->invalidate_count++;
+
   start = seq_changed->startdisp - DCACHE_IMAGES_PER_FILE;
   end = seq_changed->enddisp;
 
@@ -603,11 +650,12 @@ static int seq_disk_cache_get_header_entry(SeqCacheKey *key, DiskCacheHeader *he
   return -1;
 }
 
-static bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf *ibuf)
+/* Path is passed in, because `key->seq` is not valid when writing from a queue. */
+static bool seq_disk_cache_write_file(SeqDiskCache *disk_cache,
+                                      SeqCacheKey *key,
+                                      const char *path,
+                                      ImBuf *ibuf)
 {
-  char path[FILE_MAX];
-
-  seq_disk_cache_get_file_path(disk_cache, key, path, sizeof(path));
   BLI_make_existing_file(path);
 
   FILE *file = BLI_fopen(path, "rb+");
@@ -649,6 +697,77 @@ static bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key
   return false;
 }
 
+static void seq_disk_cache_write_item(SeqDiskCache *disk_cache, DiskCacheWriteItem *write_item)
+{
+  BLI_mutex_lock(&disk_cache->read_write_mutex);
+  if (write_item->invalidate_count == disk_cache->invalidate_count) {
+    seq_disk_cache_write_file(disk_cache, &write_item->key, write_item->path, write_item->ibuf);
+  }
+  BLI_mutex_unlock(&disk_cache->read_write_mutex);
+  seq_disk_cache_enforce_limits(disk_cache);
+
+  IMB_freeImBuf(write_item->ibuf);
+  MEM_freeN(write_item);
+}
+
+static void *seq_disk_cache_write_thread(void *disk_cache_v)
+{
+  SeqDiskCache *disk_cache = disk_cache_v;
+  DiskCacheWriteItem *write_item;
+
+  /* Returns NULL only after #seq_disk_cache_write_queue_end. */
+  while ((write_item = BLI_thread_queue_pop(disk_cache->write_queue))) {
+    seq_disk_cache_write_item(disk_cache, write_item);
+  }
+
+  return NULL;
+}
+
+static void seq_disk_cache_write_queue_init(SeqDiskCache *disk_cache)
+{
+  disk_cache->write_queue = BLI_thread_queue_init();
+  BLI_threadpool_init(&disk_cache->write_threads, seq_disk_cache_write_thread, 1);
+  BLI_threadpool_insert(&disk_cache->write_threads, disk_cache);
+}
+
+static void seq_disk_cache_write_queue_end(SeqDiskCache *disk_cache)
+{
+  BLI_thread_queue_nowait(disk_cache->write_queue);
+  BLI_threadpool_end(&disk_cache->write_threads);
+
+  /* Thread stops once the queue is empty, this is only for safety. */
+  DiskCacheWriteItem *write_item;
+  while ((write_item = BLI_thread_queue_pop_timeout(disk_cache->write_queue, 0))) {
+    IMB_freeImBuf(write_item->ibuf);
+    MEM_freeN(write_item);
+  }
+  BLI_thread_queue_free(disk_cache->write_queue);
+}
+
+/* Write image in background, unless too many images are waiting already. */
+static void seq_disk_cache_write_queue_push(SeqDiskCache *disk_cache,
+                                            SeqCacheKey *key,
+                                            ImBuf *ibuf)
+{
+  DiskCacheWriteItem *write_item = MEM_mallocN(sizeof(*write_item), __func__);
+  seq_disk_cache_get_file_path(disk_cache, key, write_item->path, sizeof(write_item->path));
+  write_item->key = *key;
+  write_item->key.seq = NULL;
+  write_item->ibuf = ibuf;
+  IMB_refImBuf(ibuf);
+
+  BLI_mutex_lock(&disk_cache->read_write_mutex);
+  write_item->invalidate_count = disk_cache->invalidate_count;
+  BLI_mutex_unlock(&disk_cache->read_write_mutex);
+
+  if (BLI_thread_queue_len(disk_cache->write_queue) >= DCACHE_WRITE_QUEUE_MAX) {
+    seq_disk_cache_write_item(disk_cache, write_item);
+    return;
+  }
+
+  BLI_thread_queue_push(disk_cache->write_queue, write_item);
+}
+
 static ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
 {
   char path[FILE_MAX];
@@ -820,10 +939,187 @@ static void seq_cache_valfree(void *val)
   if (item->ibuf) {
     IMB_freeImBuf(item->ibuf);
   }
+  MEM_SAFE_FREE(item->compressed);
 
   BLI_mempool_free(item->cache_owner->items_pool, item);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Compression
+ * \{ */
+
+static bool seq_cache_item_can_compress(SeqCacheItem *item)
+{
+  ImBuf *ibuf = item->ibuf;
+
+  if (item->compressed || item->compress_skip || ibuf == NULL) {
+    return false;
+  }
+
+  /* Image is in use outside of the cache. */
+  if (ibuf->refcounter != 0) {
+    return false;
+  }
+
+  /* Only images with a single buffer owned by the image. */
+  if (ibuf->rect_float) {
+    return ibuf->rect == NULL && (ibuf->mall & IB_rectfloat);
+  }
+  return ibuf->rect && (ibuf->mall & IB_rect);
+}
+
+static size_t seq_cache_item_pixels_len(const ImBuf *ibuf)
+{
+  return (size_t)ibuf->x * (size_t)ibuf->y;
+}
+
+static bool seq_cache_item_compress(SeqCacheItem *item)
+{
+  ImBuf *ibuf = item->ibuf;
+  const bool is_float = ibuf->rect_float != NULL;
+  void *data;
+  size_t data_size;
+
+  if (is_float) {
+    const size_t values_len = seq_cache_item_pixels_len(ibuf) * ibuf->channels;
+    unsigned short *data_half = MEM_mallocN(sizeof(*data_half) * values_len, __func__);
+    for (size_t i = 0; i < values_len; i++) {
+      data_half[i] = float_to_half(ibuf->rect_float[i]);
+    }
+    data = data_half;
+    data_size = sizeof(*data_half) * values_len;
+  }
+  else {
+    data = ibuf->rect;
+    data_size = seq_cache_item_pixels_len(ibuf) * sizeof(*ibuf->rect);
+  }
+
+  void *compressed = NULL;
+  size_t compressed_size = data_size;
+  bool is_lzo = false;
+
+#ifdef WITH_LZO
+  lzo_uint out_len = LZO_OUT_LEN(data_size);
+  unsigned char *out = MEM_mallocN(out_len, "seq_cache_lzo_buffer");
+  void *wrkmem = MEM_mallocN(LZO1X_MEM_COMPRESS, __func__);
+  const int r = lzo1x_1_compress(data, (lzo_uint)data_size, out, &out_len, wrkmem);
+  MEM_freeN(wrkmem);
+
+  if (r == LZO_E_OK && out_len < data_size) {
+    compressed = MEM_reallocN(out, out_len);
+    compressed_size = out_len;
+    is_lzo = true;
+  }
+  else {
+    MEM_freeN(out);
+  }
+#endif
+
+  if (compressed == NULL && is_float) {
+    compressed = data;
+  }
+  else if (is_float) {
+    MEM_freeN(data);
+  }
+
+  if (compressed == NULL) {
+    item->compress_skip = true;
+    return false;
+  }
+
+  item->compressed = compressed;
+  item->compressed_size = compressed_size;
+  item->compressed_size_raw = data_size;
+  item->compressed_is_float = is_float;
+  item->compressed_is_lzo = is_lzo;
+
+  if (is_float) {
+    imb_freerectfloatImBuf(ibuf);
+  }
+  else {
+    imb_freerectImBuf(ibuf);
+  }
+
+  return true;
+}
+
+static void seq_cache_item_decompress(SeqCacheItem *item)
+{
+  ImBuf *ibuf = item->ibuf;
+  void *data = item->compressed;
+
+#ifdef WITH_LZO
+  if (item->compressed_is_lzo) {
+    lzo_uint out_len = item->compressed_size_raw;
+    data = MEM_mallocN(item->compressed_size_raw, __func__);
+    lzo1x_decompress_safe(item->compressed, item->compressed_size, data, &out_len, NULL);
+    BLI_assert(out_len == item->compressed_size_raw);
+    MEM_freeN(item->compressed);
+  }
+#endif
+
+  if (item->compressed_is_float) {
+    const size_t values_len = seq_cache_item_pixels_len(ibuf) * ibuf->channels;
+    const unsigned short *data_half = data;
+    float *rect_float = MEM_mallocN(sizeof(float) * values_len, __func__);
+    for (size_t i = 0; i < values_len; i++) {
+      rect_float[i] = half_to_float(data_half[i]);
+    }
+    MEM_freeN(data);
+
+    ibuf->rect_float = rect_float;
+    ibuf->mall |= IB_rectfloat;
+  }
+  else {
+    ibuf->rect = data;
+    ibuf->mall |= IB_rect;
+  }
+
+  item->compressed = NULL;
+}
+
+/* Compress images of the frame furthest from current frame. */
+static bool seq_cache_compress_item(Scene *scene)
+{
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+
+  if ((scene->ed->cache_flag & SEQ_CACHE_COMPRESS) == 0) {
+    return false;
+  }
+
+  while (true) {
+    SeqCacheItem *item_best = NULL;
+    int frame_distance_best = -1;
+
+    GHashIterator gh_iter;
+    GHASH_ITER (gh_iter, cache->hash) {
+      SeqCacheKey *key = BLI_ghashIterator_getKey(&gh_iter);
+      SeqCacheItem *item = BLI_ghashIterator_getValue(&gh_iter);
+
+      if (key->is_temp_cache || !seq_cache_item_can_compress(item)) {
+        continue;
+      }
+
+      const int frame_distance = abs((int)key->timeline_frame - scene->r.cfra);
+      if (frame_distance > frame_distance_best) {
+        frame_distance_best = frame_distance;
+        item_best = item;
+      }
+    }
+
+    if (item_best == NULL) {
+      return false;
+    }
+
+    /* On failure the item is skipped from now on, try the next one. */
+    if (seq_cache_item_compress(item_best)) {
+      return true;
+    }
+  }
+}
+
+/** \} */
+
 static int get_stored_types_flag(Scene *scene, SeqCacheKey *key)
 {
   int flag;
@@ -847,6 +1143,12 @@ static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
   item = BLI_mempool_alloc(cache->items_pool);
   item->cache_owner = cache;
   item->ibuf = ibuf;
+  item->compressed = NULL;
+  item->compressed_size = 0;
+  item->compressed_size_raw = 0;
+  item->compressed_is_float = false;
+  item->compressed_is_lzo = false;
+  item->compress_skip = false;
 
   const int stored_types_flag = get_stored_types_flag(scene, key);
 
@@ -885,6 +1187,9 @@ static ImBuf *seq_cache_get_ex(SeqCache *cache, SeqCacheKey *key)
   SeqCacheItem *item = BLI_ghash_lookup(cache->hash, key);
 
   if (item && item->ibuf) {
+    if (item->compressed) {
+      seq_cache_item_decompress(item);
+    }
     IMB_refImBuf(item->ibuf);
 
     return item->ibuf;
@@ -1058,6 +1363,10 @@ bool seq_cache_recycle_item(Scene *scene)
   seq_cache_lock(scene);
 
   while (seq_cache_is_full()) {
+    if (seq_cache_compress_item(scene)) {
+      continue;
+    }
+
     SeqCacheKey *finalkey = seq_cache_get_item_for_removal(scene);
 
     if (finalkey) {
@@ -1115,6 +1424,7 @@ static void seq_disk_cache_create(Main *bmain, Scene *scene)
   seq_disk_cache_handle_versioning(cache->disk_cache);
   seq_disk_cache_get_files(cache->disk_cache, seq_disk_cache_base_dir());
   cache->disk_cache->timestamp = scene->ed->disk_cache_timestamp;
+  seq_disk_cache_write_queue_init(cache->disk_cache);
   BLI_mutex_unlock(&cache_create_lock);
 }
 
@@ -1210,6 +1520,7 @@ void seq_cache_destruct(Scene *scene)
   BLI_mutex_end(&cache->iterator_mutex);
 
   if (cache->disk_cache != NULL) {
+    seq_disk_cache_write_queue_end(cache->disk_cache);
     BLI_freelistN(&cache->disk_cache->files);
     BLI_mutex_end(&cache->disk_cache->read_write_mutex);
     MEM_freeN(cache->disk_cache);
@@ -1442,10 +1753,7 @@ void seq_cache_put(
         seq_disk_cache_create(context->bmain, context->scene);
       }
 
-      BLI_mutex_lock(&cache->disk_cache->read_write_mutex);
-      seq_disk_cache_write_file(cache->disk_cache, key, i);
-      BLI_mutex_unlock(&cache->disk_cache->read_write_mutex);
-      seq_disk_cache_enforce_limits(cache->disk_cache);
+      seq_disk_cache_write_queue_push(cache->disk_cache, key, i);
     }
   }
 }
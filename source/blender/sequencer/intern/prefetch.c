@@ -31,9 +31,11 @@
 #include "DNA_scene_types.h"
 #include "DNA_screen_types.h"
 #include "DNA_sequence_types.h"
+#include "DNA_userdef_types.h"
 #include "DNA_windowmanager_types.h"
 
 #include "BLI_listbase.h"
+#include "BLI_math_base.h"
 #include "BLI_threads.h"
 
 #include "IMB_imbuf.h"
@@ -61,25 +63,42 @@
 #include "prefetch.h"
 #include "render.h"
 
+/**
+ * Frames are rendered by several workers at once, each with its own evaluated copy of the scene,
+ * since a depsgraph can only be evaluated at one frame at a time.
+ */
+#define SEQ_PREFETCH_WORKERS_MAX 8
+
+typedef struct PrefetchWorker {
+  struct PrefetchJob *pfjob;
+  struct Scene *scene_eval;
+  struct Depsgraph *depsgraph;
+
+  /* context */
+  struct SeqRenderData context;
+  struct SeqRenderData context_cpy;
+
+  /** Frame being rendered. */
+  float cfra;
+} PrefetchWorker;
+
 typedef struct PrefetchJob {
   struct PrefetchJob *next, *prev;
 
   struct Main *bmain;
   struct Main *bmain_eval;
   struct Scene *scene;
-  struct Scene *scene_eval;
-  struct Depsgraph *depsgraph;
 
+  /** Protects the prefetch area and control members below, when workers are running. */
   ThreadMutex prefetch_suspend_mutex;
   ThreadCondition prefetch_suspend_cond;
 
   ListBase threads;
 
-  /* context */
-  struct SeqRenderData context;
-  struct SeqRenderData context_cpy;
-  struct ListBase *seqbasep;
-  struct ListBase *seqbasep_cpy;
+  PrefetchWorker workers[SEQ_PREFETCH_WORKERS_MAX];
+  int workers_len;
+  int workers_running;
+  int workers_waiting;
 
   /* prefetch area */
   float cfra;
@@ -172,7 +191,11 @@ SeqRenderData *seq_prefetch_get_original_context(const SeqRenderData *context)
 {
   PrefetchJob *pfjob = seq_prefetch_job_get(context->scene);
 
-  return &pfjob->context;
+  /* Each worker renders with its own task ID, see #seq_prefetch_update_context. */
+  const int worker_index = context->task_id - SEQ_TASK_PREFETCH_RENDER;
+  BLI_assert(worker_index >= 0 && worker_index < pfjob->workers_len);
+
+  return &pfjob->workers[worker_index].context;
 }
 
 static bool seq_prefetch_is_cache_full(Scene *scene)
@@ -190,9 +213,9 @@ static float seq_prefetch_cfra(PrefetchJob *pfjob)
 {
   return pfjob->cfra + pfjob->num_frames_prefetched;
 }
-static AnimationEvalContext seq_prefetch_anim_eval_context(PrefetchJob *pfjob)
+static AnimationEvalContext seq_prefetch_anim_eval_context(PrefetchWorker *worker)
 {
-  return BKE_animsys_eval_context_construct(pfjob->depsgraph, seq_prefetch_cfra(pfjob));
+  return BKE_animsys_eval_context_construct(worker->depsgraph, worker->cfra);
 }
 
 void seq_prefetch_get_time_range(Scene *scene, int *start, int *end)
@@ -203,18 +226,40 @@ void seq_prefetch_get_time_range(Scene *scene, int *start, int *end)
   *end = seq_prefetch_cfra(pfjob);
 }
 
+/**
+ * Number of frames rendered at once. Rendering a frame is threaded itself, so only a part of
+ * the cores is used for more workers. Frames in flight (a few float buffers each) are kept to a
+ * small part of the cache memory, so prefetching doesn't push out the frames it just rendered.
+ */
+static int seq_prefetch_workers_len(const SeqRenderData *context)
+{
+  int workers_len = BLI_system_thread_count() / 4;
+
+  const size_t frame_size = (size_t)context->rectx * (size_t)context->recty * 4 * sizeof(float);
+  const size_t cache_size = (size_t)U.memcachelimit * 1024 * 1024;
+  if (frame_size != 0) {
+    const size_t frames_in_flight_max = (cache_size / 8) / (frame_size * 4);
+    workers_len = (int)min_zz((size_t)workers_len, frames_in_flight_max);
+  }
+
+  return clamp_i(workers_len, 1, SEQ_PREFETCH_WORKERS_MAX);
+}
+
 static void seq_prefetch_free_depsgraph(PrefetchJob *pfjob)
 {
-  if (pfjob->depsgraph != NULL) {
-    DEG_graph_free(pfjob->depsgraph);
+  for (int i = 0; i < pfjob->workers_len; i++) {
+    PrefetchWorker *worker = &pfjob->workers[i];
+    if (worker->depsgraph != NULL) {
+      DEG_graph_free(worker->depsgraph);
+    }
+    worker->depsgraph = NULL;
+    worker->scene_eval = NULL;
   }
-  pfjob->depsgraph = NULL;
-  pfjob->scene_eval = NULL;
 }
 
-static void seq_prefetch_update_depsgraph(PrefetchJob *pfjob)
+static void seq_prefetch_update_depsgraph(PrefetchWorker *worker)
 {
-  DEG_evaluate_on_framechange(pfjob->depsgraph, seq_prefetch_cfra(pfjob));
+  DEG_evaluate_on_framechange(worker->depsgraph, worker->cfra);
 }
 
 static void seq_prefetch_init_depsgraph(PrefetchJob *pfjob)
@@ -223,17 +268,21 @@ static void seq_prefetch_init_depsgraph(PrefetchJob *pfjob)
   Scene *scene = pfjob->scene;
   ViewLayer *view_layer = BKE_view_layer_default_render(scene);
 
-  pfjob->depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
-  DEG_debug_name_set(pfjob->depsgraph, "SEQUENCER PREFETCH");
+  for (int i = 0; i < pfjob->workers_len; i++) {
+    PrefetchWorker *worker = &pfjob->workers[i];
+    worker->depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
+    DEG_debug_name_set(worker->depsgraph, "SEQUENCER PREFETCH");
 
-  /* Make sure there is a correct evaluated scene pointer. */
-  DEG_graph_build_for_render_pipeline(pfjob->depsgraph);
+    /* Make sure there is a correct evaluated scene pointer. */
+    DEG_graph_build_for_render_pipeline(worker->depsgraph);
 
-  /* Update immediately so we have proper evaluated scene. */
-  seq_prefetch_update_depsgraph(pfjob);
+    /* Update immediately so we have proper evaluated scene. */
+    worker->cfra = seq_prefetch_cfra(pfjob);
+    seq_prefetch_update_depsgraph(worker);
 
-  pfjob->scene_eval = DEG_get_evaluated_scene(pfjob->depsgraph);
-  pfjob->scene_eval->ed->cache_flag = 0;
+    worker->scene_eval = DEG_get_evaluated_scene(worker->depsgraph);
+    worker->scene_eval->ed->cache_flag = 0;
+  }
 }
 
 static void seq_prefetch_update_area(PrefetchJob *pfjob)
@@ -281,7 +330,7 @@ void SEQ_prefetch_stop(Scene *scene)
   pfjob->stop = true;
 
   while (pfjob->running) {
-    BLI_condition_notify_one(&pfjob->prefetch_suspend_cond);
+    BLI_condition_notify_all(&pfjob->prefetch_suspend_cond);
   }
 }
 
@@ -290,32 +339,36 @@ static void seq_prefetch_update_context(const SeqRenderData *context)
   PrefetchJob *pfjob;
   pfjob = seq_prefetch_job_get(context->scene);
 
-  SEQ_render_new_render_data(pfjob->bmain_eval,
-                             pfjob->depsgraph,
-                             pfjob->scene_eval,
-                             context->rectx,
-                             context->recty,
-                             context->preview_render_size,
-                             false,
-                             &pfjob->context_cpy);
-  pfjob->context_cpy.is_prefetch_render = true;
-  pfjob->context_cpy.task_id = SEQ_TASK_PREFETCH_RENDER;
-
-  SEQ_render_new_render_data(pfjob->bmain,
-                             pfjob->depsgraph,
-                             pfjob->scene,
-                             context->rectx,
-                             context->recty,
-                             context->preview_render_size,
-                             false,
-                             &pfjob->context);
-  pfjob->context.is_prefetch_render = false;
-
-  /* Same ID as prefetch context, because context will be swapped, but we still
-   * want to assign this ID to cache entries created in this thread.
-   * This is to allow "temp cache" work correctly for both threads.
-   */
-  pfjob->context.task_id = SEQ_TASK_PREFETCH_RENDER;
+  for (int i = 0; i < pfjob->workers_len; i++) {
+    PrefetchWorker *worker = &pfjob->workers[i];
+
+    SEQ_render_new_render_data(pfjob->bmain_eval,
+                               worker->depsgraph,
+                               worker->scene_eval,
+                               context->rectx,
+                               context->recty,
+                               context->preview_render_size,
+                               false,
+                               &worker->context_cpy);
+    worker->context_cpy.is_prefetch_render = true;
+    worker->context_cpy.task_id = SEQ_TASK_PREFETCH_RENDER + i;
+
+    SEQ_render_new_render_data(pfjob->bmain,
+                               worker->depsgraph,
+                               pfjob->scene,
+                               context->rectx,
+                               context->recty,
+                               context->preview_render_size,
+                               false,
+                               &worker->context);
+    worker->context.is_prefetch_render = false;
+
+    /* Same ID as prefetch context, because context will be swapped, but we still
+     * want to assign this ID to cache entries created in this thread.
+     * This is to allow "temp cache" work correctly for all threads.
+     */
+    worker->context.task_id = SEQ_TASK_PREFETCH_RENDER + i;
+  }
 }
 
 static void seq_prefetch_update_scene(Scene *scene)
@@ -336,7 +389,14 @@ static void seq_prefetch_resume(Scene *scene)
   PrefetchJob *pfjob = seq_prefetch_job_get(scene);
 
   if (pfjob && pfjob->waiting) {
-    BLI_condition_notify_one(&pfjob->prefetch_suspend_cond);
+    BLI_condition_notify_all(&pfjob->prefetch_suspend_cond);
+  }
+}
+
+static void seq_prefetch_threads_remove(PrefetchJob *pfjob)
+{
+  for (int i = 0; i < pfjob->workers_len; i++) {
+    BLI_threadpool_remove(&pfjob->threads, &pfjob->workers[i]);
   }
 }
 
@@ -349,7 +409,7 @@ void seq_prefetch_free(Scene *scene)
 
   SEQ_prefetch_stop(scene);
 
-  BLI_threadpool_remove(&pfjob->threads, pfjob);
+  seq_prefetch_threads_remove(pfjob);
   BLI_threadpool_end(&pfjob->threads);
   BLI_mutex_end(&pfjob->prefetch_suspend_mutex);
   BLI_condition_end(&pfjob->prefetch_suspend_cond);
@@ -361,18 +421,18 @@ void seq_prefetch_free(Scene *scene)
 
 /* Skip frame if we need to render 3D scene strip. Rendering 3D scene requires main lock or setting
  * up render job that doesn't have API to do openGL renders which can be used for sequencer. */
-static bool seq_prefetch_do_skip_frame(PrefetchJob *pfjob, ListBase *seqbase)
+static bool seq_prefetch_do_skip_frame(PrefetchWorker *worker, ListBase *seqbase)
 {
-  float cfra = seq_prefetch_cfra(pfjob);
+  float cfra = worker->cfra;
   Sequence *seq_arr[MAXSEQ + 1];
   int count = seq_get_shown_sequences(seqbase, cfra, 0, seq_arr);
-  SeqRenderData *ctx = &pfjob->context_cpy;
+  SeqRenderData *ctx = &worker->context_cpy;
   ImBuf *ibuf = NULL;
 
   /* Disable prefetching 3D scene strips, but check for disk cache. */
   for (int i = 0; i < count; i++) {
     if (seq_arr[i]->type == SEQ_TYPE_META &&
-        seq_prefetch_do_skip_frame(pfjob, &seq_arr[i]->seqbase)) {
+        seq_prefetch_do_skip_frame(worker, &seq_arr[i]->seqbase)) {
       return true;
     }
 
@@ -429,31 +489,79 @@ static bool seq_prefetch_need_suspend(PrefetchJob *pfjob)
          (seq_prefetch_cfra(pfjob) >= pfjob->scene->r.efra);
 }
 
+/* Called with `prefetch_suspend_mutex` locked. */
 static void seq_prefetch_do_suspend(PrefetchJob *pfjob)
 {
-  BLI_mutex_lock(&pfjob->prefetch_suspend_mutex);
   while (seq_prefetch_need_suspend(pfjob) &&
          (pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) && !pfjob->stop) {
-    pfjob->waiting = true;
+    pfjob->workers_waiting++;
+    pfjob->waiting = (pfjob->workers_waiting == pfjob->workers_running);
     BLI_condition_wait(&pfjob->prefetch_suspend_cond, &pfjob->prefetch_suspend_mutex);
+    pfjob->workers_waiting--;
+    pfjob->waiting = false;
     seq_prefetch_update_area(pfjob);
   }
-  pfjob->waiting = false;
+}
+
+/**
+ * Hand out the next frame to render to \a worker.
+ * \return False when prefetching is done.
+ */
+static bool seq_prefetch_frame_next(PrefetchWorker *worker, const bool is_first)
+{
+  PrefetchJob *pfjob = worker->pfjob;
+  bool do_prefetch = true;
+
+  BLI_mutex_lock(&pfjob->prefetch_suspend_mutex);
+
+  if (!is_first) {
+    /* Suspend thread if there is nothing to be prefetched. */
+    seq_prefetch_do_suspend(pfjob);
+
+    /* Avoid "collision" with main thread, but make sure to fetch at least few frames */
+    if (pfjob->num_frames_prefetched > 5 &&
+        (seq_prefetch_cfra(pfjob) - pfjob->scene->r.cfra) < 2) {
+      do_prefetch = false;
+    }
+
+    seq_prefetch_update_area(pfjob);
+  }
+
+  if (!(pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) || pfjob->stop ||
+      (seq_prefetch_cfra(pfjob) > pfjob->scene->r.efra)) {
+    do_prefetch = false;
+  }
+
+  if (do_prefetch) {
+    worker->cfra = seq_prefetch_cfra(pfjob);
+    pfjob->num_frames_prefetched++;
+  }
+  else {
+    /* Let the other workers finish as well. */
+    pfjob->stop = true;
+    BLI_condition_notify_all(&pfjob->prefetch_suspend_cond);
+  }
+
   BLI_mutex_unlock(&pfjob->prefetch_suspend_mutex);
+
+  return do_prefetch;
 }
 
-static void *seq_prefetch_frames(void *job)
+static void *seq_prefetch_frames(void *worker_v)
 {
-  PrefetchJob *pfjob = (PrefetchJob *)job;
+  PrefetchWorker *worker = (PrefetchWorker *)worker_v;
+  PrefetchJob *pfjob = worker->pfjob;
 
-  while (seq_prefetch_cfra(pfjob) <= pfjob->scene->r.efra) {
-    pfjob->scene_eval->ed->prefetch_job = NULL;
+  bool is_first = true;
+  while (seq_prefetch_frame_next(worker, is_first)) {
+    is_first = false;
+    worker->scene_eval->ed->prefetch_job = NULL;
 
-    seq_prefetch_update_depsgraph(pfjob);
-    AnimData *adt = BKE_animdata_from_id(&pfjob->context_cpy.scene->id);
-    AnimationEvalContext anim_eval_context = seq_prefetch_anim_eval_context(pfjob);
+    seq_prefetch_update_depsgraph(worker);
+    AnimData *adt = BKE_animdata_from_id(&worker->context_cpy.scene->id);
+    AnimationEvalContext anim_eval_context = seq_prefetch_anim_eval_context(worker);
     BKE_animsys_evaluate_animdata(
-        &pfjob->context_cpy.scene->id, adt, &anim_eval_context, ADT_RECALC_ALL, false);
+        &worker->context_cpy.scene->id, adt, &anim_eval_context, ADT_RECALC_ALL, false);
 
     /* This is quite hacky solution:
      * We need cross-reference original scene with copy for cache.
@@ -461,38 +569,30 @@ static void *seq_prefetch_frames(void *job)
      * Scene copy don't reference original scene. Perhaps, this could be done by depsgraph.
      * Set to NULL before return!
      */
-    pfjob->scene_eval->ed->prefetch_job = pfjob;
+    worker->scene_eval->ed->prefetch_job = pfjob;
 
     ListBase *seqbase = SEQ_active_seqbase_get(SEQ_editing_get(pfjob->scene, false));
-    if (seq_prefetch_do_skip_frame(pfjob, seqbase)) {
-      pfjob->num_frames_prefetched++;
+    if (seq_prefetch_do_skip_frame(worker, seqbase)) {
       continue;
     }
 
-    ImBuf *ibuf = SEQ_render_give_ibuf(&pfjob->context_cpy, seq_prefetch_cfra(pfjob), 0);
-    seq_cache_free_temp_cache(pfjob->scene, pfjob->context.task_id, seq_prefetch_cfra(pfjob));
+    ImBuf *ibuf = SEQ_render_give_ibuf(&worker->context_cpy, worker->cfra, 0);
+    seq_cache_free_temp_cache(pfjob->scene, worker->context.task_id, worker->cfra);
     IMB_freeImBuf(ibuf);
+  }
 
-    /* Suspend thread if there is nothing to be prefetched. */
-    seq_prefetch_do_suspend(pfjob);
-
-    /* Avoid "collision" with main thread, but make sure to fetch at least few frames */
-    if (pfjob->num_frames_prefetched > 5 &&
-        (seq_prefetch_cfra(pfjob) - pfjob->scene->r.cfra) < 2) {
-      break;
-    }
-
-    if (!(pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) || pfjob->stop) {
-      break;
-    }
+  seq_cache_free_temp_cache(pfjob->scene, worker->context.task_id, worker->cfra);
+  worker->scene_eval->ed->prefetch_job = NULL;
 
-    seq_prefetch_update_area(pfjob);
-    pfjob->num_frames_prefetched++;
+  BLI_mutex_lock(&pfjob->prefetch_suspend_mutex);
+  pfjob->workers_running--;
+  if (pfjob->workers_running == 0) {
+    pfjob->running = false;
   }
-
-  seq_cache_free_temp_cache(pfjob->scene, pfjob->context.task_id, seq_prefetch_cfra(pfjob));
-  pfjob->running = false;
-  pfjob->scene_eval->ed->prefetch_job = NULL;
+  else {
+    pfjob->waiting = (pfjob->workers_waiting == pfjob->workers_running);
+  }
+  BLI_mutex_unlock(&pfjob->prefetch_suspend_mutex);
 
   return NULL;
 }
@@ -506,7 +606,12 @@ static PrefetchJob *seq_prefetch_start_ex(const SeqRenderData *context, float cf
       pfjob = (PrefetchJob *)MEM_callocN(sizeof(PrefetchJob), "PrefetchJob");
       context->scene->ed->prefetch_job = pfjob;
 
-      BLI_threadpool_init(&pfjob->threads, seq_prefetch_frames, 1);
+      pfjob->workers_len = seq_prefetch_workers_len(context);
+      for (int i = 0; i < pfjob->workers_len; i++) {
+        pfjob->workers[i].pfjob = pfjob;
+      }
+
+      BLI_threadpool_init(&pfjob->threads, seq_prefetch_frames, pfjob->workers_len);
       BLI_mutex_init(&pfjob->prefetch_suspend_mutex);
       BLI_condition_init(&pfjob->prefetch_suspend_cond);
 
@@ -523,12 +628,16 @@ static PrefetchJob *seq_prefetch_start_ex(const SeqRenderData *context, float cf
   pfjob->waiting = false;
   pfjob->stop = false;
   pfjob->running = true;
+  pfjob->workers_running = pfjob->workers_len;
+  pfjob->workers_waiting = 0;
 
   seq_prefetch_update_scene(context->scene);
   seq_prefetch_update_context(context);
 
-  BLI_threadpool_remove(&pfjob->threads, pfjob);
-  BLI_threadpool_insert(&pfjob->threads, pfjob);
+  seq_prefetch_threads_remove(pfjob);
+  for (int i = 0; i < pfjob->workers_len; i++) {
+    BLI_threadpool_insert(&pfjob->threads, &pfjob->workers[i]);
+  }
 
   return pfjob;
 }
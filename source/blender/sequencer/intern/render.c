@@ -37,6 +37,7 @@
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
+#include "BLI_task.h"
 
 #include "BKE_anim_data.h"
 #include "BKE_animsys.h"
@@ -1873,6 +1874,88 @@ static ImBuf *seq_render_strip_stack_apply_effect(
   return out;
 }
 
+/**
+ * Strips which only read their own file, so rendering several of them at once doesn't touch
+ * shared state (besides the locked cache). Scenes, effects and metas render other strips or use
+ * the render pipeline, modifiers may use other strips as mask.
+ */
+static bool seq_render_strip_is_independent(Sequence *seq)
+{
+  if (!ELEM(seq->type, SEQ_TYPE_IMAGE, SEQ_TYPE_MOVIE)) {
+    return false;
+  }
+  LISTBASE_FOREACH (SequenceModifierData *, smd, &seq->modifiers) {
+    if (smd->mask_sequence != NULL) {
+      return false;
+    }
+  }
+  return true;
+}
+
+typedef struct StripStackInputsTaskData {
+  const SeqRenderData *context;
+  Sequence **seq_arr;
+  ImBuf **ibufs;
+  float timeline_frame;
+} StripStackInputsTaskData;
+
+static void seq_render_strip_stack_inputs_fn(void *__restrict userdata,
+                                             const int index,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  StripStackInputsTaskData *data = userdata;
+  SeqRenderState state;
+  seq_render_state_init(&state);
+  data->ibufs[index] = seq_render_strip(
+      data->context, &state, data->seq_arr[index], data->timeline_frame);
+}
+
+/**
+ * Render the inputs of the strips blended on top of each other in parallel, decoding several
+ * movies at once instead of one after the other. Only independent inputs are rendered here,
+ * \a r_ibufs stays NULL for the others which are rendered while blending as usual.
+ */
+static void seq_render_strip_stack_inputs(const SeqRenderData *context,
+                                          Sequence **seq_arr,
+                                          const int start,
+                                          const int count,
+                                          float timeline_frame,
+                                          ImBuf **r_ibufs)
+{
+  Sequence *seq_inputs[MAXSEQ + 1];
+  int inputs_len = 0;
+
+  for (int i = start; i < count; i++) {
+    Sequence *seq = seq_arr[i];
+    if ((seq_get_early_out_for_blend_mode(seq) == EARLY_DO_EFFECT) &&
+        seq_render_strip_is_independent(seq)) {
+      seq_inputs[inputs_len++] = seq;
+    }
+  }
+
+  if (inputs_len < 2) {
+    return;
+  }
+
+  ImBuf *ibufs[MAXSEQ + 1];
+  StripStackInputsTaskData data = {
+      .context = context,
+      .seq_arr = seq_inputs,
+      .ibufs = ibufs,
+      .timeline_frame = timeline_frame,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, inputs_len, &data, seq_render_strip_stack_inputs_fn, &settings);
+
+  for (int i = start, j = 0; i < count && j < inputs_len; i++) {
+    if (seq_arr[i] == seq_inputs[j]) {
+      r_ibufs[i] = ibufs[j++];
+    }
+  }
+}
+
 static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
                                      SeqRenderState *state,
                                      ListBase *seqbasep,
@@ -1936,12 +2019,17 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
   }
 
   i++;
+
+  ImBuf *ibufs_input[MAXSEQ + 1] = {NULL};
+  seq_render_strip_stack_inputs(context, seq_arr, i, count, timeline_frame, ibufs_input);
+
   for (; i < count; i++) {
     Sequence *seq = seq_arr[i];
 
     if (seq_get_early_out_for_blend_mode(seq) == EARLY_DO_EFFECT) {
       ImBuf *ibuf1 = out;
-      ImBuf *ibuf2 = seq_render_strip(context, state, seq, timeline_frame);
+      ImBuf *ibuf2 = ibufs_input[i] ? ibufs_input[i] :
+                                      seq_render_strip(context, state, seq, timeline_frame);
 
       out = seq_render_strip_stack_apply_effect(context, seq, timeline_frame, ibuf1, ibuf2);
 
@@ -32,6 +32,7 @@
 
 #include "BLI_linklist.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_cloth.h"
@@ -833,7 +834,8 @@ BLI_INLINE LinkNode *hair_spring_next(LinkNode *spring_link)
  *   (3,4), (2,3), (1,2)
  * This is currently the only way to figure out hair geometry inside this code ...
  */
-static LinkNode *cloth_continuum_add_hair_segments(HairGrid *grid,
+static LinkNode *cloth_continuum_add_hair_segments(HairGridSegment *segments,
+                                                   int *segments_num,
                                                    const float cell_scale,
                                                    const float cell_offset[3],
                                                    Cloth *cloth,
@@ -841,47 +843,30 @@ static LinkNode *cloth_continuum_add_hair_segments(HairGrid *grid,
 {
   Implicit_Data *data = cloth->implicit;
   LinkNode *next_spring_link = nullptr; /* return value */
-  ClothSpring *spring1, *spring2, *spring3;
+  ClothSpring *spring3;
   // ClothVertex *verts = cloth->verts;
   // ClothVertex *vert3, *vert4;
-  float x1[3], v1[3], x2[3], v2[3], x3[3], v3[3], x4[3], v4[3];
-  float dir1[3], dir2[3], dir3[3];
+  float x2[3], v2[3], x3[3], v3[3], x4[3], v4[3];
 
-  spring1 = nullptr;
-  spring2 = nullptr;
   spring3 = (ClothSpring *)spring_link->link;
 
-  zero_v3(x1);
-  zero_v3(v1);
-  zero_v3(dir1);
   zero_v3(x2);
   zero_v3(v2);
-  zero_v3(dir2);
 
   // vert3 = &verts[spring3->kl];
   cloth_get_grid_location(data, cell_scale, cell_offset, spring3->kl, x3, v3);
   // vert4 = &verts[spring3->ij];
   cloth_get_grid_location(data, cell_scale, cell_offset, spring3->ij, x4, v4);
-  sub_v3_v3v3(dir3, x4, x3);
-  normalize_v3(dir3);
 
   while (spring_link) {
     /* move on */
-    spring1 = spring2;
-    spring2 = spring3;
-
     // vert3 = vert4;
 
-    copy_v3_v3(x1, x2);
-    copy_v3_v3(v1, v2);
     copy_v3_v3(x2, x3);
     copy_v3_v3(v2, v3);
     copy_v3_v3(x3, x4);
     copy_v3_v3(v3, v4);
 
-    copy_v3_v3(dir1, dir2);
-    copy_v3_v3(dir2, dir3);
-
     /* read next segment */
     next_spring_link = spring_link->next;
     spring_link = hair_spring_next(spring_link);
@@ -890,29 +875,20 @@ static LinkNode *cloth_continuum_add_hair_segments(HairGrid *grid,
       spring3 = (ClothSpring *)spring_link->link;
       // vert4 = &verts[spring3->ij];
       cloth_get_grid_location(data, cell_scale, cell_offset, spring3->ij, x4, v4);
-      sub_v3_v3v3(dir3, x4, x3);
-      normalize_v3(dir3);
     }
     else {
-      spring3 = nullptr;
       // vert4 = NULL;
       zero_v3(x4);
       zero_v3(v4);
-      zero_v3(dir3);
     }
 
-    SIM_hair_volume_add_segment(grid,
-                                x1,
-                                v1,
-                                x2,
-                                v2,
-                                x3,
-                                v3,
-                                x4,
-                                v4,
-                                spring1 ? dir1 : nullptr,
-                                dir2,
-                                spring3 ? dir3 : nullptr);
+    /* Only the segment itself is used for sampling the grid,
+     * see #SIM_hair_volume_add_segment. */
+    HairGridSegment *segment = &segments[(*segments_num)++];
+    copy_v3_v3(segment->x[0], x2);
+    copy_v3_v3(segment->v[0], v2);
+    copy_v3_v3(segment->x[1], x3);
+    copy_v3_v3(segment->v[1], v3);
   }
 
   return next_spring_link;
@@ -935,6 +911,8 @@ static void cloth_continuum_fill_grid(HairGrid *grid, Cloth *cloth)
 #else
   LinkNode *link;
   float cellsize, gmin[3], cell_scale, cell_offset[3];
+  HairGridSegment *segments;
+  int segments_num = 0;
 
   /* scale and offset for transforming vertex locations into grid space
    * (cell size is 0..1, gmin becomes origin)
@@ -944,27 +922,61 @@ static void cloth_continuum_fill_grid(HairGrid *grid, Cloth *cloth)
   mul_v3_v3fl(cell_offset, gmin, cell_scale);
   negate_v3(cell_offset);
 
+  /* Gather the segments first (there is at most one per spring), so the grid can be filled in
+   * parallel afterwards. */
+  segments = (HairGridSegment *)MEM_mallocN(
+      sizeof(*segments) * max_ii(BLI_linklist_count(cloth->springs), 1), __func__);
+
   link = cloth->springs;
   while (link) {
     ClothSpring *spring = (ClothSpring *)link->link;
     if (spring->type == CLOTH_SPRING_TYPE_STRUCTURAL) {
-      link = cloth_continuum_add_hair_segments(grid, cell_scale, cell_offset, cloth, link);
+      link = cloth_continuum_add_hair_segments(
+          segments, &segments_num, cell_scale, cell_offset, cloth, link);
     }
     else {
       link = link->next;
     }
   }
+
+  SIM_hair_volume_add_segments(grid, segments, segments_num);
+  MEM_freeN(segments);
 #endif
   SIM_hair_volume_normalize_vertex_grid(grid);
 }
 
+typedef struct ClothContinuumVelocityData {
+  Implicit_Data *data;
+  HairGrid *grid;
+  float fluid_factor;
+  float smoothfac;
+} ClothContinuumVelocityData;
+
+static void cloth_continuum_velocity_cb(void *__restrict userdata,
+                                        const int i,
+                                        const TaskParallelTLS *__restrict /*tls*/)
+{
+  const ClothContinuumVelocityData *cvd = (const ClothContinuumVelocityData *)userdata;
+  float x[3], v[3], nv[3];
+
+  /* calculate volumetric velocity influence */
+  SIM_mass_spring_get_position(cvd->data, i, x);
+  SIM_mass_spring_get_new_velocity(cvd->data, i, v);
+
+  SIM_hair_volume_grid_velocity(cvd->grid, x, v, cvd->fluid_factor, nv);
+
+  interp_v3_v3v3(nv, v, nv, cvd->smoothfac);
+
+  /* apply on hair data */
+  SIM_mass_spring_set_new_velocity(cvd->data, i, nv);
+}
+
 static void cloth_continuum_step(ClothModifierData *clmd, float dt)
 {
   ClothSimSettings *parms = clmd->sim_parms;
   Cloth *cloth = clmd->clothObject;
   Implicit_Data *data = cloth->implicit;
   int mvert_num = cloth->mvert_num;
-  ClothVertex *vert;
 
   const float fluid_factor = 0.95f; /* blend between PIC and FLIP methods */
   float smoothfac = parms->velocity_smooth;
@@ -974,7 +986,6 @@ static void cloth_continuum_step(ClothModifierData *clmd, float dt)
   float density_target = parms->density_target;
   float density_strength = parms->density_strength;
   float gmin[3], gmax[3];
-  int i;
 
   /* clear grid info */
   zero_v3_int(clmd->hair_grid_res);
@@ -994,20 +1005,16 @@ static void cloth_continuum_step(ClothModifierData *clmd, float dt)
     /* main hair continuum solver */
     SIM_hair_volume_solve_divergence(grid, dt, density_target, density_strength);
 
-    for (i = 0, vert = cloth->verts; i < mvert_num; i++, vert++) {
-      float x[3], v[3], nv[3];
-
-      /* calculate volumetric velocity influence */
-      SIM_mass_spring_get_position(data, i, x);
-      SIM_mass_spring_get_new_velocity(data, i, v);
+    ClothContinuumVelocityData cvd;
+    cvd.data = data;
+    cvd.grid = grid;
+    cvd.fluid_factor = fluid_factor;
+    cvd.smoothfac = smoothfac;
 
-      SIM_hair_volume_grid_velocity(grid, x, v, fluid_factor, nv);
-
-      interp_v3_v3v3(nv, v, nv, smoothfac);
-
-      /* apply on hair data */
-      SIM_mass_spring_set_new_velocity(data, i, nv);
-    }
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (mvert_num > 1000);
+    BLI_task_parallel_range(0, mvert_num, &cvd, cloth_continuum_velocity_cb, &settings);
 
     /* store basic grid info in the modifier data */
     SIM_hair_volume_grid_geometry(grid,
@@ -24,6 +24,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_texture_types.h"
@@ -630,6 +631,10 @@ BLI_INLINE void hair_volume_eval_grid_vertex_sample(HairGridVert *vert,
   }
 }
 
+/* Number of discrete samples along a segment and their radius of influence in grid cells. */
+static const int hair_segment_samples_num = 10;
+static const float hair_segment_sample_radius = 1.5f;
+
 /* XXX simplified test implementation using a series of discrete sample along the segment,
  * instead of finding the closest point for all affected grid vertices.
  */
@@ -646,12 +651,12 @@ void SIM_hair_volume_add_segment(HairGrid *grid,
                                  const float UNUSED(dir2[3]),
                                  const float UNUSED(dir3[3]))
 {
-  const float radius = 1.5f;
+  const float radius = hair_segment_sample_radius;
   const float dist_scale = grid->inv_cellsize;
 
   const int res[3] = {grid->res[0], grid->res[1], grid->res[2]};
   const int stride[3] = {1, res[0], res[0] * res[1]};
-  const int num_samples = 10;
+  const int num_samples = hair_segment_samples_num;
 
   int s;
 
@@ -682,18 +687,139 @@ void SIM_hair_volume_add_segment(HairGrid *grid,
     }
   }
 }
+
+typedef struct HairGridSample {
+  float x[3], v[3];
+} HairGridSample;
+
+typedef struct HairVolumeAddSamplesData {
+  HairGrid *grid;
+  const HairGridSample *samples;
+  /* Samples affecting each grid layer, see #SIM_hair_volume_add_segments. */
+  const int *layer_offsets;
+  const int *layer_samples;
+} HairVolumeAddSamplesData;
+
+static void hair_volume_add_samples_layer_cb(void *__restrict userdata,
+                                             const int k,
+                                             const TaskParallelTLS *__restrict /*tls*/)
+{
+  const HairVolumeAddSamplesData *data = (const HairVolumeAddSamplesData *)userdata;
+  HairGrid *grid = data->grid;
+  const float radius = hair_segment_sample_radius;
+  const float dist_scale = grid->inv_cellsize;
+
+  const int res[3] = {grid->res[0], grid->res[1], grid->res[2]};
+  const int stride[3] = {1, res[0], res[0] * res[1]};
+
+  for (int n = data->layer_offsets[k]; n < data->layer_offsets[k + 1]; n++) {
+    const HairGridSample *sample = &data->samples[data->layer_samples[n]];
+    const float *x = sample->x;
+
+    int imin = max_ii(floor_int(x[0]) - 2, 0);
+    int imax = min_ii(floor_int(x[0]) + 2, res[0] - 1);
+    int jmin = max_ii(floor_int(x[1]) - 2, 0);
+    int jmax = min_ii(floor_int(x[1]) + 2, res[1] - 1);
+
+    for (int j = jmin; j <= jmax; j++) {
+      for (int i = imin; i <= imax; i++) {
+        float loc[3] = {(float)i, (float)j, (float)k};
+        HairGridVert *vert = grid->verts + i * stride[0] + j * stride[1] + k * stride[2];
+
+        hair_volume_eval_grid_vertex_sample(vert, loc, radius, dist_scale, x, sample->v);
+      }
+    }
+  }
+}
+
+/* Same as calling #SIM_hair_volume_add_segment for every segment in order, but the grid is
+ * filled in parallel. The samples are sorted into the grid layers they affect, so every layer
+ * can be filled by its own task while summing the samples in the same order as before.
+ */
+void SIM_hair_volume_add_segments(HairGrid *grid,
+                                  const HairGridSegment *segments,
+                                  const int segments_num)
+{
+  const int res_z = grid->res[2];
+  const int samples_num = segments_num * hair_segment_samples_num;
+
+  HairGridSample *samples = (HairGridSample *)MEM_mallocN(sizeof(*samples) * samples_num,
+                                                          __func__);
+  int *layer_offsets = (int *)MEM_callocN(sizeof(*layer_offsets) * (res_z + 1), __func__);
+
+  /* Sample the segments and count the samples affecting each layer. */
+  for (int n = 0; n < segments_num; n++) {
+    const HairGridSegment *segment = &segments[n];
+    for (int s = 0; s < hair_segment_samples_num; s++) {
+      HairGridSample *sample = &samples[n * hair_segment_samples_num + s];
+      float f = (float)s / (float)(hair_segment_samples_num - 1);
+      interp_v3_v3v3(sample->x, segment->x[0], segment->x[1], f);
+      interp_v3_v3v3(sample->v, segment->v[0], segment->v[1], f);
+
+      int kmin = max_ii(floor_int(sample->x[2]) - 2, 0);
+      int kmax = min_ii(floor_int(sample->x[2]) + 2, res_z - 1);
+      for (int k = kmin; k <= kmax; k++) {
+        layer_offsets[k + 1]++;
+      }
+    }
+  }
+
+  for (int k = 0; k < res_z; k++) {
+    layer_offsets[k + 1] += layer_offsets[k];
+  }
+
+  int *layer_samples = (int *)MEM_mallocN(sizeof(*layer_samples) * max_ii(layer_offsets[res_z], 1),
+                                          __func__);
+  int *layer_fill = (int *)MEM_mallocN(sizeof(*layer_fill) * res_z, __func__);
+  memcpy(layer_fill, layer_offsets, sizeof(*layer_fill) * res_z);
+
+  for (int n = 0; n < samples_num; n++) {
+    int kmin = max_ii(floor_int(samples[n].x[2]) - 2, 0);
+    int kmax = min_ii(floor_int(samples[n].x[2]) + 2, res_z - 1);
+    for (int k = kmin; k <= kmax; k++) {
+      layer_samples[layer_fill[k]++] = n;
+    }
+  }
+  MEM_freeN(layer_fill);
+
+  HairVolumeAddSamplesData data;
+  data.grid = grid;
+  data.samples = samples;
+  data.layer_offsets = layer_offsets;
+  data.layer_samples = layer_samples;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (samples_num > 1000);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, res_z, &data, hair_volume_add_samples_layer_cb, &settings);
+
+  MEM_freeN(samples);
+  MEM_freeN(layer_offsets);
+  MEM_freeN(layer_samples);
+}
 #endif
 
+static void hair_volume_normalize_vertex_cb(void *__restrict userdata,
+                                            const int i,
+                                            const TaskParallelTLS *__restrict /*tls*/)
+{
+  HairGrid *grid = (HairGrid *)userdata;
+  float density = grid->verts[i].density;
+  if (density > 0.0f) {
+    mul_v3_fl(grid->verts[i].velocity, 1.0f / density);
+  }
+}
+
 void SIM_hair_volume_normalize_vertex_grid(HairGrid *grid)
 {
-  int i, size = hair_grid_size(grid->res);
+  const int size = hair_grid_size(grid->res);
   /* divide velocity with density */
-  for (i = 0; i < size; i++) {
-    float density = grid->verts[i].density;
-    if (density > 0.0f) {
-      mul_v3_fl(grid->verts[i].velocity, 1.0f / density);
-    }
-  }
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (size > 4096);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, size, grid, hair_volume_normalize_vertex_cb, &settings);
 }
 
 /* Cells with density below this are considered empty. */
@@ -714,6 +840,175 @@ BLI_INLINE float hair_volume_density_divergence(float density,
   return 0.0f;
 }
 
+#define MARGIN_i0 (i < 1)
+#define MARGIN_j0 (j < 1)
+#define MARGIN_k0 (k < 1)
+#define MARGIN_i1 (i >= resA[0] - 1)
+#define MARGIN_j1 (j >= resA[1] - 1)
+#define MARGIN_k1 (k >= resA[2] - 1)
+
+#define NEIGHBOR_MARGIN_i0 (i < 2)
+#define NEIGHBOR_MARGIN_j0 (j < 2)
+#define NEIGHBOR_MARGIN_k0 (k < 2)
+#define NEIGHBOR_MARGIN_i1 (i >= resA[0] - 2)
+#define NEIGHBOR_MARGIN_j1 (j >= resA[1] - 2)
+#define NEIGHBOR_MARGIN_k1 (k >= resA[2] - 2)
+
+typedef struct HairVolumeSolveData {
+  const HairGrid *grid;
+  /* Grid vertex at the origin of the padded grid, which has a margin of one cell. */
+  HairGridVert *vert_start;
+  float flowfac, inv_flowfac;
+  float target_density, target_strength;
+  /* Divergence (written) and pressure (read) vectors on the padded grid. */
+  float *B;
+  const float *p;
+} HairVolumeSolveData;
+
+static void hair_volume_divergence_layer_cb(void *__restrict userdata,
+                                            const int k,
+                                            const TaskParallelTLS *__restrict /*tls*/)
+{
+  const HairVolumeSolveData *data = (const HairVolumeSolveData *)userdata;
+  const HairGrid *grid = data->grid;
+  const int resA[3] = {grid->res[0] + 2, grid->res[1] + 2, grid->res[2] + 2};
+
+  const int stride0 = 1;
+  const int stride1 = grid->res[0];
+  const int stride2 = grid->res[1] * grid->res[0];
+  const int strideA0 = 1;
+  const int strideA1 = grid->res[0] + 2;
+  const int strideA2 = (grid->res[1] + 2) * (grid->res[0] + 2);
+
+  for (int j = 0; j < resA[1]; j++) {
+    for (int i = 0; i < resA[0]; i++) {
+      int u = i * strideA0 + j * strideA1 + k * strideA2;
+      bool is_margin = MARGIN_i0 || MARGIN_i1 || MARGIN_j0 || MARGIN_j1 || MARGIN_k0 ||
+                       MARGIN_k1;
+
+      if (is_margin) {
+        data->B[u] = 0.0f;
+        continue;
+      }
+
+      const HairGridVert *vert = data->vert_start + i * stride0 + j * stride1 + k * stride2;
+
+      const float *v0 = vert->velocity;
+      float dx = 0.0f, dy = 0.0f, dz = 0.0f;
+      if (!NEIGHBOR_MARGIN_i0) {
+        dx += v0[0] - (vert - stride0)->velocity[0];
+      }
+      if (!NEIGHBOR_MARGIN_i1) {
+        dx += (vert + stride0)->velocity[0] - v0[0];
+      }
+      if (!NEIGHBOR_MARGIN_j0) {
+        dy += v0[1] - (vert - stride1)->velocity[1];
+      }
+      if (!NEIGHBOR_MARGIN_j1) {
+        dy += (vert + stride1)->velocity[1] - v0[1];
+      }
+      if (!NEIGHBOR_MARGIN_k0) {
+        dz += v0[2] - (vert - stride2)->velocity[2];
+      }
+      if (!NEIGHBOR_MARGIN_k1) {
+        dz += (vert + stride2)->velocity[2] - v0[2];
+      }
+
+      float divergence = -0.5f * data->flowfac * (dx + dy + dz);
+
+      /* adjustment term for target density */
+      float target = hair_volume_density_divergence(
+          vert->density, data->target_density, data->target_strength);
+
+      /* B vector contains the finite difference approximation of the velocity divergence.
+       * Note: according to the discretized Navier-Stokes equation the rhs vector
+       * and resulting pressure gradient should be multiplied by the (inverse) density;
+       * however, this is already included in the weighting of hair velocities on the grid!
+       */
+      data->B[u] = divergence - target;
+
+#if 0
+      {
+        float wloc[3], loc[3];
+        float col0[3] = {0.0, 0.0, 0.0};
+        float colp[3] = {0.0, 1.0, 1.0};
+        float coln[3] = {1.0, 0.0, 1.0};
+        float col[3];
+        float fac;
+
+        loc[0] = (float)(i - 1);
+        loc[1] = (float)(j - 1);
+        loc[2] = (float)(k - 1);
+        grid_to_world(grid, wloc, loc);
+
+        if (divergence > 0.0f) {
+          fac = CLAMPIS(divergence * target_strength, 0.0, 1.0);
+          interp_v3_v3v3(col, col0, colp, fac);
+        }
+        else {
+          fac = CLAMPIS(-divergence * target_strength, 0.0, 1.0);
+          interp_v3_v3v3(col, col0, coln, fac);
+        }
+        if (fac > 0.05f) {
+          BKE_sim_debug_data_add_circle(
+              grid->debug_data, wloc, 0.01f, col[0], col[1], col[2], "grid", 5522, i, j, k);
+        }
+      }
+#endif
+    }
+  }
+}
+
+static void hair_volume_pressure_gradient_layer_cb(void *__restrict userdata,
+                                                   const int k,
+                                                   const TaskParallelTLS *__restrict /*tls*/)
+{
+  const HairVolumeSolveData *data = (const HairVolumeSolveData *)userdata;
+  const HairGrid *grid = data->grid;
+  const int resA[3] = {grid->res[0] + 2, grid->res[1] + 2, grid->res[2] + 2};
+
+  const int stride0 = 1;
+  const int stride1 = grid->res[0];
+  const int stride2 = grid->res[1] * grid->res[0];
+  const int strideA0 = 1;
+  const int strideA1 = grid->res[0] + 2;
+  const int strideA2 = (grid->res[1] + 2) * (grid->res[0] + 2);
+
+  for (int j = 0; j < resA[1]; j++) {
+    for (int i = 0; i < resA[0]; i++) {
+      int u = i * strideA0 + j * strideA1 + k * strideA2;
+      bool is_margin = MARGIN_i0 || MARGIN_i1 || MARGIN_j0 || MARGIN_j1 || MARGIN_k0 ||
+                       MARGIN_k1;
+      if (is_margin) {
+        continue;
+      }
+
+      HairGridVert *vert = data->vert_start + i * stride0 + j * stride1 + k * stride2;
+      if (vert->density > density_threshold) {
+        const float p_left = data->p[u - strideA0];
+        const float p_right = data->p[u + strideA0];
+        const float p_down = data->p[u - strideA1];
+        const float p_up = data->p[u + strideA1];
+        const float p_bottom = data->p[u - strideA2];
+        const float p_top = data->p[u + strideA2];
+
+        /* finite difference estimate of pressure gradient */
+        float dvel[3];
+        dvel[0] = p_right - p_left;
+        dvel[1] = p_up - p_down;
+        dvel[2] = p_top - p_bottom;
+        mul_v3_fl(dvel, -0.5f * data->inv_flowfac);
+
+        /* pressure gradient describes velocity delta */
+        add_v3_v3v3(vert->velocity_smooth, vert->velocity, dvel);
+      }
+      else {
+        zero_v3(vert->velocity_smooth);
+      }
+    }
+  }
+}
+
 bool SIM_hair_volume_solve_divergence(HairGrid *grid,
                                       float /*dt*/,
                                       float target_density,
@@ -740,103 +1035,25 @@ bool SIM_hair_volume_solve_divergence(HairGrid *grid,
   HairGridVert *vert;
   int i, j, k;
 
-#define MARGIN_i0 (i < 1)
-#define MARGIN_j0 (j < 1)
-#define MARGIN_k0 (k < 1)
-#define MARGIN_i1 (i >= resA[0] - 1)
-#define MARGIN_j1 (j >= resA[1] - 1)
-#define MARGIN_k1 (k >= resA[2] - 1)
-
-#define NEIGHBOR_MARGIN_i0 (i < 2)
-#define NEIGHBOR_MARGIN_j0 (j < 2)
-#define NEIGHBOR_MARGIN_k0 (k < 2)
-#define NEIGHBOR_MARGIN_i1 (i >= resA[0] - 2)
-#define NEIGHBOR_MARGIN_j1 (j >= resA[1] - 2)
-#define NEIGHBOR_MARGIN_k1 (k >= resA[2] - 2)
-
   BLI_assert(num_cells >= 1);
 
   /* Calculate divergence */
   lVector B(num_cellsA);
-  for (k = 0; k < resA[2]; k++) {
-    for (j = 0; j < resA[1]; j++) {
-      for (i = 0; i < resA[0]; i++) {
-        int u = i * strideA0 + j * strideA1 + k * strideA2;
-        bool is_margin = MARGIN_i0 || MARGIN_i1 || MARGIN_j0 || MARGIN_j1 || MARGIN_k0 ||
-                         MARGIN_k1;
-
-        if (is_margin) {
-          B[u] = 0.0f;
-          continue;
-        }
-
-        vert = vert_start + i * stride0 + j * stride1 + k * stride2;
-
-        const float *v0 = vert->velocity;
-        float dx = 0.0f, dy = 0.0f, dz = 0.0f;
-        if (!NEIGHBOR_MARGIN_i0) {
-          dx += v0[0] - (vert - stride0)->velocity[0];
-        }
-        if (!NEIGHBOR_MARGIN_i1) {
-          dx += (vert + stride0)->velocity[0] - v0[0];
-        }
-        if (!NEIGHBOR_MARGIN_j0) {
-          dy += v0[1] - (vert - stride1)->velocity[1];
-        }
-        if (!NEIGHBOR_MARGIN_j1) {
-          dy += (vert + stride1)->velocity[1] - v0[1];
-        }
-        if (!NEIGHBOR_MARGIN_k0) {
-          dz += v0[2] - (vert - stride2)->velocity[2];
-        }
-        if (!NEIGHBOR_MARGIN_k1) {
-          dz += (vert + stride2)->velocity[2] - v0[2];
-        }
-
-        float divergence = -0.5f * flowfac * (dx + dy + dz);
-
-        /* adjustment term for target density */
-        float target = hair_volume_density_divergence(
-            vert->density, target_density, target_strength);
-
-        /* B vector contains the finite difference approximation of the velocity divergence.
-         * Note: according to the discretized Navier-Stokes equation the rhs vector
-         * and resulting pressure gradient should be multiplied by the (inverse) density;
-         * however, this is already included in the weighting of hair velocities on the grid!
-         */
-        B[u] = divergence - target;
-
-#if 0
-        {
-          float wloc[3], loc[3];
-          float col0[3] = {0.0, 0.0, 0.0};
-          float colp[3] = {0.0, 1.0, 1.0};
-          float coln[3] = {1.0, 0.0, 1.0};
-          float col[3];
-          float fac;
-
-          loc[0] = (float)(i - 1);
-          loc[1] = (float)(j - 1);
-          loc[2] = (float)(k - 1);
-          grid_to_world(grid, wloc, loc);
-
-          if (divergence > 0.0f) {
-            fac = CLAMPIS(divergence * target_strength, 0.0, 1.0);
-            interp_v3_v3v3(col, col0, colp, fac);
-          }
-          else {
-            fac = CLAMPIS(-divergence * target_strength, 0.0, 1.0);
-            interp_v3_v3v3(col, col0, coln, fac);
-          }
-          if (fac > 0.05f) {
-            BKE_sim_debug_data_add_circle(
-                grid->debug_data, wloc, 0.01f, col[0], col[1], col[2], "grid", 5522, i, j, k);
-          }
-        }
-#endif
-      }
-    }
-  }
+  HairVolumeSolveData solve_data;
+  solve_data.grid = grid;
+  solve_data.vert_start = vert_start;
+  solve_data.flowfac = flowfac;
+  solve_data.inv_flowfac = inv_flowfac;
+  solve_data.target_density = target_density;
+  solve_data.target_strength = target_strength;
+  solve_data.B = B.data();
+  solve_data.p = nullptr;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (num_cellsA > 4096);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, resA[2], &solve_data, hair_volume_divergence_layer_cb, &settings);
 
   /* Main Poisson equation system:
    * This is derived from the discretezation of the Poisson equation
@@ -919,41 +1136,9 @@ bool SIM_hair_volume_solve_divergence(HairGrid *grid,
 
   if (cg.info() == Eigen::Success) {
     /* Calculate velocity = grad(p) */
-    for (k = 0; k < resA[2]; k++) {
-      for (j = 0; j < resA[1]; j++) {
-        for (i = 0; i < resA[0]; i++) {
-          int u = i * strideA0 + j * strideA1 + k * strideA2;
-          bool is_margin = MARGIN_i0 || MARGIN_i1 || MARGIN_j0 || MARGIN_j1 || MARGIN_k0 ||
-                           MARGIN_k1;
-          if (is_margin) {
-            continue;
-          }
-
-          vert = vert_start + i * stride0 + j * stride1 + k * stride2;
-          if (vert->density > density_threshold) {
-            float p_left = p[u - strideA0];
-            float p_right = p[u + strideA0];
-            float p_down = p[u - strideA1];
-            float p_up = p[u + strideA1];
-            float p_bottom = p[u - strideA2];
-            float p_top = p[u + strideA2];
-
-            /* finite difference estimate of pressure gradient */
-            float dvel[3];
-            dvel[0] = p_right - p_left;
-            dvel[1] = p_up - p_down;
-            dvel[2] = p_top - p_bottom;
-            mul_v3_fl(dvel, -0.5f * inv_flowfac);
-
-            /* pressure gradient describes velocity delta */
-            add_v3_v3v3(vert->velocity_smooth, vert->velocity, dvel);
-          }
-          else {
-            zero_v3(vert->velocity_smooth);
-          }
-        }
-      }
-    }
+    solve_data.p = p.data();
+    BLI_task_parallel_range(
+        0, resA[2], &solve_data, hair_volume_pressure_gradient_layer_cb, &settings);
 
 #if 0
     {
@@ -223,6 +223,14 @@ void SIM_hair_volume_add_segment(struct HairGrid *grid,
                                  const float dir1[3],
                                  const float dir2[3],
                                  const float dir3[3]);
+/* Segment between two hair vertices, in grid space. */
+typedef struct HairGridSegment {
+  float x[2][3];
+  float v[2][3];
+} HairGridSegment;
+void SIM_hair_volume_add_segments(struct HairGrid *grid,
+                                  const HairGridSegment *segments,
+                                  int segments_num);
 
 void SIM_hair_volume_normalize_vertex_grid(struct HairGrid *grid);
 
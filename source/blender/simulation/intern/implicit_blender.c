@@ -33,7 +33,9 @@
 #  include "DNA_scene_types.h"
 #  include "DNA_texture_types.h"
 
+#  include "BLI_alloca.h"
 #  include "BLI_math.h"
+#  include "BLI_task.h"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.h"
@@ -770,6 +772,182 @@ BLI_INLINE void root_to_world_m3(Implicit_Data *data,
 }
 
 /* ================================ */
+/* Parallel solver operations.
+ *
+ * Vertices are split into chunks of fixed size, and reductions add up the chunk results in order,
+ * so results do not depend on the number of threads or on scheduling. The sparse matrix product
+ * is done per vertex (row), using a list of the off-diagonal blocks every vertex is part of. */
+
+#  define CG_CHUNK_SIZE 1024
+/* Threading is not worth it for small systems. */
+#  define CG_PARALLEL_LIMIT 4096
+
+typedef struct CGVertexBlocks {
+  /* Off-diagonal blocks of vertex i are blocks[offsets[i]] to blocks[offsets[i + 1] - 1]. */
+  unsigned int *offsets;
+  unsigned int *blocks;
+} CGVertexBlocks;
+
+/* Build the lists for the matrix structure, which is the same for all matrices of the system. */
+static void cg_vertex_blocks_init(CGVertexBlocks *vb, const fmatrix3x3 *A)
+{
+  const unsigned int numverts = A[0].vcount;
+  const unsigned int numblocks = A[0].vcount + A[0].scount;
+
+  vb->offsets = MEM_callocN(sizeof(*vb->offsets) * (numverts + 1), __func__);
+  for (unsigned int i = numverts; i < numblocks; i++) {
+    vb->offsets[A[i].r + 1]++;
+    if (A[i].c != A[i].r) {
+      vb->offsets[A[i].c + 1]++;
+    }
+  }
+  for (unsigned int i = 0; i < numverts; i++) {
+    vb->offsets[i + 1] += vb->offsets[i];
+  }
+
+  unsigned int *fill = MEM_dupallocN(vb->offsets);
+  vb->blocks = MEM_mallocN(sizeof(*vb->blocks) * MAX2(vb->offsets[numverts], 1), __func__);
+  for (unsigned int i = numverts; i < numblocks; i++) {
+    vb->blocks[fill[A[i].r]++] = i;
+    if (A[i].c != A[i].r) {
+      vb->blocks[fill[A[i].c]++] = i;
+    }
+  }
+  MEM_freeN(fill);
+}
+
+static void cg_vertex_blocks_free(CGVertexBlocks *vb)
+{
+  MEM_freeN(vb->offsets);
+  MEM_freeN(vb->blocks);
+}
+
+typedef struct CGTaskData {
+  unsigned int numverts;
+  lfVector *to;
+  lfVector *a;
+  lfVector *b;
+  float b_fac;
+  /* Matrix product. */
+  const fmatrix3x3 *matrix;
+  const CGVertexBlocks *vb;
+  /* Dot product, per chunk. */
+  float *chunk_sums;
+} CGTaskData;
+
+static void cg_task_range(const CGTaskData *data,
+                          const int chunk,
+                          unsigned int *r_start,
+                          unsigned int *r_end)
+{
+  *r_start = (unsigned int)chunk * CG_CHUNK_SIZE;
+  *r_end = MIN2(*r_start + CG_CHUNK_SIZE, data->numverts);
+}
+
+static void cg_run_chunks(CGTaskData *data, TaskParallelRangeFunc func)
+{
+  const int chunks_num = (int)((data->numverts + CG_CHUNK_SIZE - 1) / CG_CHUNK_SIZE);
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = data->numverts >= CG_PARALLEL_LIMIT;
+  BLI_task_parallel_range(0, chunks_num, data, func, &settings);
+}
+
+static void cg_mul_bfmatrix_lfvector_task(void *__restrict userdata,
+                                          const int chunk,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CGTaskData *data = userdata;
+  const fmatrix3x3 *from = data->matrix;
+  const lfVector *x = data->a;
+  unsigned int start, end;
+  cg_task_range(data, chunk, &start, &end);
+
+  for (unsigned int i = start; i < end; i++) {
+    float acc[3] = {0.0f, 0.0f, 0.0f};
+    muladd_fmatrix_fvector(acc, from[i].m, x[i]);
+
+    for (unsigned int k = data->vb->offsets[i]; k < data->vb->offsets[i + 1]; k++) {
+      const fmatrix3x3 *block = &from[data->vb->blocks[k]];
+      /* Only the lower triangle is stored, the transposed block is used for the column. */
+      if (block->r == i) {
+        muladd_fmatrix_fvector(acc, block->m, x[block->c]);
+      }
+      if (block->c == i) {
+        muladd_fmatrixT_fvector(acc, block->m, x[block->r]);
+      }
+    }
+    copy_v3_v3(data->to[i], acc);
+  }
+}
+
+/* Same as #mul_bfmatrix_lfvector. */
+static void mul_bfmatrix_lfvector_parallel(lfVector *to,
+                                           const fmatrix3x3 *from,
+                                           const CGVertexBlocks *vb,
+                                           lfVector *fLongVector)
+{
+  CGTaskData data = {
+      .numverts = from[0].vcount, .to = to, .a = fLongVector, .matrix = from, .vb = vb};
+  cg_run_chunks(&data, cg_mul_bfmatrix_lfvector_task);
+}
+
+static void cg_dot_lfvector_task(void *__restrict userdata,
+                                 const int chunk,
+                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CGTaskData *data = userdata;
+  unsigned int start, end;
+  cg_task_range(data, chunk, &start, &end);
+
+  float sum = 0.0f;
+  for (unsigned int i = start; i < end; i++) {
+    sum += dot_v3v3(data->a[i], data->b[i]);
+  }
+  data->chunk_sums[chunk] = sum;
+}
+
+/* Same as #dot_lfvector. */
+static float dot_lfvector_parallel(lfVector *fLongVectorA,
+                                   lfVector *fLongVectorB,
+                                   unsigned int verts)
+{
+  const unsigned int chunks_num = (verts + CG_CHUNK_SIZE - 1) / CG_CHUNK_SIZE;
+  float *chunk_sums = BLI_array_alloca(chunk_sums, MAX2(chunks_num, 1));
+  CGTaskData data = {.numverts = verts,
+                     .a = fLongVectorA,
+                     .b = fLongVectorB,
+                     .chunk_sums = chunk_sums};
+  cg_run_chunks(&data, cg_dot_lfvector_task);
+
+  float sum = 0.0f;
+  for (unsigned int chunk = 0; chunk < chunks_num; chunk++) {
+    sum += chunk_sums[chunk];
+  }
+  return sum;
+}
+
+static void cg_add_lfvector_lfvectorS_task(void *__restrict userdata,
+                                           const int chunk,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CGTaskData *data = userdata;
+  unsigned int start, end;
+  cg_task_range(data, chunk, &start, &end);
+
+  for (unsigned int i = start; i < end; i++) {
+    VECADDS(data->to[i], data->a[i], data->b[i], data->b_fac);
+  }
+}
+
+/* Same as #add_lfvector_lfvectorS. */
+static void add_lfvector_lfvectorS_parallel(
+    lfVector *to, lfVector *fLongVectorA, lfVector *fLongVectorB, float bS, unsigned int verts)
+{
+  CGTaskData data = {
+      .numverts = verts, .to = to, .a = fLongVectorA, .b = fLongVectorB, .b_fac = bS};
+  cg_run_chunks(&data, cg_add_lfvector_lfvectorS_task);
+}
 
 DO_INLINE void filter(lfVector *V, fmatrix3x3 *S)
 {
@@ -852,6 +1030,7 @@ static int cg_filtered(lfVector *ldV, fmatrix3x3 *lA, lfVector *lB, lfVector *z,
 
 static int cg_filtered(lfVector *ldV,
                        fmatrix3x3 *lA,
+                       const CGVertexBlocks *vb,
                        lfVector *lB,
                        lfVector *z,
                        fmatrix3x3 *S,
@@ -875,11 +1054,11 @@ static int cg_filtered(lfVector *ldV,
   /* d0 = filter(B)^T * P * filter(B) */
   cp_lfvector(fB, lB, numverts);
   filter(fB, S);
-  bnorm2 = dot_lfvector(fB, fB, numverts);
+  bnorm2 = dot_lfvector_parallel(fB, fB, numverts);
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_lfvector_parallel(AdV, lA, vb, ldV);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
   filter(r, S);
 
@@ -888,7 +1067,7 @@ static int cg_filtered(lfVector *ldV,
   filter(c, S);
 
   /* delta = r^T * c */
-  delta_new = dot_lfvector(r, c, numverts);
+  delta_new = dot_lfvector_parallel(r, c, numverts);
 
 #  ifdef IMPLICIT_PRINT_SOLVER_INPUT_OUTPUT
   printf("==== A ====\n");
@@ -902,21 +1081,21 @@ static int cg_filtered(lfVector *ldV,
 #  endif
 
   while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
+    mul_bfmatrix_lfvector_parallel(q, lA, vb, c);
     filter(q, S);
 
-    alpha = delta_new / dot_lfvector(c, q, numverts);
+    alpha = delta_new / dot_lfvector_parallel(c, q, numverts);
 
-    add_lfvector_lfvectorS(ldV, ldV, c, alpha, numverts);
+    add_lfvector_lfvectorS_parallel(ldV, ldV, c, alpha, numverts);
 
-    add_lfvector_lfvectorS(r, r, q, -alpha, numverts);
+    add_lfvector_lfvectorS_parallel(r, r, q, -alpha, numverts);
 
     /* s = P^-1 * r */
     cp_lfvector(s, r, numverts);
     delta_old = delta_new;
-    delta_new = dot_lfvector(r, s, numverts);
+    delta_new = dot_lfvector_parallel(r, s, numverts);
 
-    add_lfvector_lfvectorS(c, s, c, delta_new / delta_old, numverts);
+    add_lfvector_lfvectorS_parallel(c, s, c, delta_new / delta_old, numverts);
     filter(c, S);
 
     conjgrad_loopcount++;
@@ -1162,7 +1341,11 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 
   subadd_bfmatrixS_bfmatrixS(data->A, data->dFdV, dt, data->dFdX, (dt * dt));
 
-  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V);
+  /* All matrices of the system share the structure of A. */
+  CGVertexBlocks vb;
+  cg_vertex_blocks_init(&vb, data->A);
+
+  mul_bfmatrix_lfvector_parallel(dFdXmV, data->dFdX, &vb, data->V);
 
   add_lfvectorS_lfvectorS(data->B, data->F, dt, dFdXmV, (dt * dt), numverts);
 
@@ -1171,7 +1354,9 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
+  cg_filtered(data->dV, data->A, &vb, data->B, data->z, data->S, result);
+
+  cg_vertex_blocks_free(&vb);
 
   // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
 
@@ -410,6 +410,7 @@ static void wm_init_userdef(Main *bmain)
   }
 
   MEM_CacheLimiter_set_maximum(((size_t)U.memcachelimit) * 1024 * 1024);
+  IMB_ffmpeg_hw_decoding_set((U.movie_decode_flag & USER_MOVIE_DECODE_HARDWARE) != 0);
   BKE_sound_init(bmain);
 
   /* Update the temporary directory from the preferences or fallback to the system default. */
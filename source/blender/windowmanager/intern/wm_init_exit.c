@@ -49,6 +49,7 @@
 #include "BLI_timer.h"
 #include "BLI_utildefines.h"
 
+#include "BLO_readfile.h"
 #include "BLO_undofile.h"
 #include "BLO_writefile.h"
 
@@ -577,6 +578,7 @@ void WM_exit_ex(bContext *C, const bool do_python)
   BKE_mask_clipboard_free();
   BKE_vfont_clipboard_free();
   BKE_node_clipboard_free();
+  BLO_read_stats_last_free();
 
 #ifdef WITH_COMPOSITOR
   COM_deinitialize();
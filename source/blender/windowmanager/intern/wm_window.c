@@ -1584,14 +1584,22 @@ static int wm_window_timer(const bContext *C)
   return retval;
 }
 
+/* Sleep time when there are no events, and how long after the last event to sleep less. */
+#define WM_EVENT_IDLE_SLEEP_MS 5
+#define WM_EVENT_ACTIVE_SLEEP_MS 1
+#define WM_EVENT_ACTIVE_TIME 0.5
+
 void wm_window_process_events(const bContext *C)
 {
+  static double last_event_time = 0.0;
+
   BLI_assert(BLI_thread_is_main());
 
   int hasevent = GHOST_ProcessEvents(g_system, 0); /* 0 is no wait */
 
   if (hasevent) {
     GHOST_DispatchEvents(g_system);
+    last_event_time = PIL_check_seconds_timer();
   }
   hasevent |= wm_window_timer(C);
 #ifdef WITH_XR_OPENXR
@@ -1600,9 +1608,11 @@ void wm_window_process_events(const bContext *C)
   hasevent |= wm_xr_events_handle(CTX_wm_manager(C));
 #endif
 
-  /* no event, we sleep 5 milliseconds */
   if (hasevent == 0) {
-    PIL_sleep_ms(5);
+    /* No event, sleep a bit. Shortly after an event more are likely to follow (for example
+     * when navigating the viewport), so poll more often then. */
+    const bool is_active = (PIL_check_seconds_timer() - last_event_time) < WM_EVENT_ACTIVE_TIME;
+    PIL_sleep_ms(is_active ? WM_EVENT_ACTIVE_SLEEP_MS : WM_EVENT_IDLE_SLEEP_MS);
   }
 }
 
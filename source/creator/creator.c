@@ -293,6 +293,10 @@ int main(int argc,
         MEM_use_guarded_allocator();
         break;
       }
+      if (STREQ(argv[i], "--debug-memory-sampled")) {
+        /* Enabled early so allocations made during start-up are included too. */
+        MEM_use_sampled_stats();
+      }
       if (STREQ(argv[i], "--")) {
         break;
       }
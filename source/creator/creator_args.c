@@ -577,6 +577,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_args_print_arg_doc(ba, "--debug-cycles");
 #  endif
   BLI_args_print_arg_doc(ba, "--debug-memory");
+  BLI_args_print_arg_doc(ba, "--debug-memory-sampled");
   BLI_args_print_arg_doc(ba, "--debug-jobs");
   BLI_args_print_arg_doc(ba, "--debug-python");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph");
@@ -1054,6 +1055,20 @@ static int arg_handle_debug_mode_memory_set(int UNUSED(argc),
   return 0;
 }
 
+static const char arg_handle_debug_mode_memory_sampled_set_doc[] =
+    "\n\t"
+    "Keep a sample of memory allocations to estimate memory usage per allocation name,\n"
+    "\twith low overhead. Printed by the memory statistics operator and available from Python\n"
+    "\tas 'bpy.app.memory_stats'.";
+static int arg_handle_debug_mode_memory_sampled_set(int UNUSED(argc),
+                                                    const char **UNUSED(argv),
+                                                    void *UNUSED(data))
+{
+  /* Already enabled in 'main', before any allocations happen. */
+  MEM_use_sampled_stats();
+  return 0;
+}
+
 static const char arg_handle_debug_value_set_doc[] =
     "<value>\n"
     "\tSet debug value of <value> on startup.";
@@ -2106,6 +2121,11 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_args_add(ba, NULL, "--debug-cycles", CB(arg_handle_debug_mode_cycles), NULL);
 #  endif
   BLI_args_add(ba, NULL, "--debug-memory", CB(arg_handle_debug_mode_memory_set), NULL);
+  BLI_args_add(ba,
+               NULL,
+               "--debug-memory-sampled",
+               CB(arg_handle_debug_mode_memory_sampled_set),
+               NULL);
 
   BLI_args_add(ba, NULL, "--debug-value", CB(arg_handle_debug_value_set), NULL);
   BLI_args_add(ba,
@@ -0,0 +1,5 @@
+# Apache License, Version 2.0
+
+from .environment import TestEnvironment
+from .results import TestResults, compare_results
+from .test import Test, TestCollection, time_repetitions
@@ -0,0 +1,93 @@
+# Apache License, Version 2.0
+
+import json
+import os
+import pathlib
+import subprocess
+import sys
+
+OUTPUT_PREFIX = "BENCHMARK_OUTPUT: "
+
+
+class TestEnvironment:
+    """
+    Runs functions of the test modules inside of Blender, and collects their results.
+    """
+
+    def __init__(self, blender_executable, scenes_dir=None, verbose=False):
+        self.blender_executable = pathlib.Path(blender_executable)
+        self.scenes_dir = pathlib.Path(scenes_dir) if scenes_dir else None
+        self.verbose = verbose
+        self.base_dir = pathlib.Path(__file__).parent.parent
+
+    def scene_files(self, pattern="*.blend"):
+        """ Standard scenes to run file based tests on, sorted by name. """
+        if not self.scenes_dir or not self.scenes_dir.is_dir():
+            return []
+        return sorted(self.scenes_dir.glob(pattern))
+
+    def revision(self):
+        """ Git revision of the source tree, to tell results of different commits apart. """
+        try:
+            return subprocess.check_output(
+                ["git", "rev-parse", "HEAD"],
+                cwd=str(self.base_dir),
+                stderr=subprocess.DEVNULL,
+                universal_newlines=True).strip()
+        except (OSError, subprocess.CalledProcessError):
+            return ""
+
+    def call_blender(self, function, args=None, blendfile=None, background=True):
+        """
+        Call `function` (a function of a module in `tests/`) inside of a new Blender process,
+        passing it `args` (which must be JSON serializable), and return its return value.
+        """
+        code = (
+            "import json, sys\n"
+            "sys.path.insert(0, {base_dir!r})\n"
+            "from {module} import {name}\n"
+            "result = {name}(json.loads({args!r}))\n"
+            "print({prefix!r} + json.dumps(result), flush=True)\n"
+        ).format(
+            base_dir=str(self.base_dir),
+            module=function.__module__,
+            name=function.__name__,
+            args=json.dumps(args if args is not None else {}),
+            prefix=OUTPUT_PREFIX,
+        )
+
+        command = [str(self.blender_executable), "--factory-startup", "-noaudio"]
+        if background:
+            command.append("--background")
+        if blendfile:
+            command.append(str(blendfile))
+        command += ["--python-exit-code", "1", "--python-expr", code]
+        if not background:
+            # Windows stay open after the script otherwise.
+            command += ["--python-expr", "import bpy; bpy.ops.wm.quit_blender()"]
+
+        env = dict(os.environ)
+        # Make timings comparable, independent of the user configuration.
+        env["BLENDER_USER_CONFIG"] = ""
+        env["BLENDER_USER_SCRIPTS"] = ""
+
+        process = subprocess.run(
+            command,
+            env=env,
+            stdout=subprocess.PIPE,
+            stderr=subprocess.STDOUT,
+            universal_newlines=True)
+
+        result = None
+        for line in process.stdout.splitlines():
+            if line.startswith(OUTPUT_PREFIX):
+                result = json.loads(line[len(OUTPUT_PREFIX):])
+            elif self.verbose:
+                print(line, file=sys.stderr)
+
+        if result is None:
+            if not self.verbose:
+                sys.stderr.write(process.stdout)
+            raise RuntimeError("{} failed with exit code {}".format(
+                function.__name__, process.returncode))
+        return result
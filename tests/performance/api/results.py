@@ -0,0 +1,63 @@
+# Apache License, Version 2.0
+
+import datetime
+import json
+import platform
+
+
+class TestResults:
+    """ Results of a benchmark run, stored as JSON to compare them across revisions. """
+
+    def __init__(self, revision="", blender_executable="", tests=None, date=None, system=None):
+        self.revision = revision
+        self.blender_executable = blender_executable
+        self.tests = tests if tests is not None else {}
+        self.date = date or datetime.datetime.now().isoformat(timespec="seconds")
+        self.system = system or {
+            "platform": platform.platform(),
+            "processor": platform.processor(),
+        }
+
+    def to_json(self):
+        return {
+            "revision": self.revision,
+            "blender_executable": self.blender_executable,
+            "date": self.date,
+            "system": self.system,
+            "tests": self.tests,
+        }
+
+    @staticmethod
+    def from_json(data):
+        return TestResults(
+            revision=data["revision"],
+            blender_executable=data["blender_executable"],
+            tests=data["tests"],
+            date=data["date"],
+            system=data["system"],
+        )
+
+    def write(self, filepath):
+        with open(filepath, "w") as f:
+            json.dump(self.to_json(), f, indent=2, sort_keys=True)
+
+    @staticmethod
+    def read(filepath):
+        with open(filepath) as f:
+            return TestResults.from_json(json.load(f))
+
+
+def compare_results(base, other, threshold):
+    """
+    Compare the median times of the tests found in both results.
+
+    Return a list of (name, base_time, other_time, ratio, is_regression) tuples, a test regresses
+    when it is slower by more than `threshold` (a fraction of the base time).
+    """
+    rows = []
+    for name in sorted(set(base.tests) & set(other.tests)):
+        base_time = base.tests[name]["time"]
+        other_time = other.tests[name]["time"]
+        ratio = other_time / base_time if base_time > 0.0 else 1.0
+        rows.append((name, base_time, other_time, ratio, ratio > 1.0 + threshold))
+    return rows
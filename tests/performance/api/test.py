@@ -0,0 +1,75 @@
+# Apache License, Version 2.0
+
+import abc
+import fnmatch
+import importlib
+import pkgutil
+import statistics
+import time
+
+
+class Test(abc.ABC):
+    """
+    A single benchmark. `run` returns the time in seconds of each repetition of the measured
+    operation, the median of those is used to compare results.
+    """
+
+    @abc.abstractmethod
+    def name(self):
+        """ Unique name of the test, used to match results between revisions. """
+
+    @abc.abstractmethod
+    def category(self):
+        """ Category of the test, e.g. "file_load" or "depsgraph". """
+
+    @abc.abstractmethod
+    def run(self, env):
+        """ Run the test in given environment and return the list of timings. """
+
+    def full_name(self):
+        return "{}/{}".format(self.category(), self.name())
+
+    def measure(self, env):
+        samples = self.run(env)
+        return {
+            "category": self.category(),
+            "time": statistics.median(samples),
+            "min": min(samples),
+            "samples": samples,
+        }
+
+
+def time_repetitions(function, repeat):
+    """
+    Call `function` `repeat` times and return the time in seconds of every call.
+    Meant to be used inside of Blender, by the functions called with `TestEnvironment`.
+    """
+    samples = []
+    for _ in range(repeat):
+        time_start = time.perf_counter()
+        function()
+        samples.append(time.perf_counter() - time_start)
+    return samples
+
+
+class TestCollection:
+    """
+    All tests of the modules in `tests/`, each module has a `generate(env)` function returning
+    a list of tests.
+    """
+
+    def __init__(self, env, name_filter="*"):
+        import tests
+
+        self.tests = []
+        for module_info in sorted(pkgutil.iter_modules(tests.__path__), key=lambda m: m.name):
+            module = importlib.import_module("tests." + module_info.name)
+            for test in module.generate(env):
+                if fnmatch.fnmatch(test.full_name(), name_filter):
+                    self.tests.append(test)
+
+    def __iter__(self):
+        return iter(self.tests)
+
+    def __len__(self):
+        return len(self.tests)
@@ -0,0 +1,3 @@
+# Apache License, Version 2.0
+
+# Every module of this package has a `generate(env)` function, see `api.TestCollection`.
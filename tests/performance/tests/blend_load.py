@@ -0,0 +1,31 @@
+# Apache License, Version 2.0
+
+import api
+
+
+def _run(args):
+    import bpy
+
+    def load():
+        bpy.ops.wm.open_mainfile(filepath=args["filepath"], load_ui=False)
+
+    return api.time_repetitions(load, args["repeat"])
+
+
+class BlendLoadTest(api.Test):
+    def __init__(self, filepath, repeat=5):
+        self.filepath = filepath
+        self.repeat = repeat
+
+    def name(self):
+        return self.filepath.stem
+
+    def category(self):
+        return "file_load"
+
+    def run(self, env):
+        return env.call_blender(_run, {"filepath": str(self.filepath), "repeat": self.repeat})
+
+
+def generate(env):
+    return [BlendLoadTest(filepath) for filepath in env.scene_files()]
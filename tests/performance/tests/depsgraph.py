@@ -0,0 +1,76 @@
+# Apache License, Version 2.0
+
+import api
+
+
+def _run_animation(args):
+    import bpy
+
+    scene = bpy.context.scene
+    frame_start = scene.frame_start
+    frame_end = min(scene.frame_end, frame_start + args["frames"] - 1)
+
+    samples = []
+    for _ in range(args["repeat"]):
+        scene.frame_set(frame_start)
+        samples += api.time_repetitions(
+            lambda: scene.frame_set(scene.frame_current + 1), frame_end - frame_start)
+    return samples
+
+
+def _run_many_objects(args):
+    import bpy
+
+    # Many animated objects with constraints, to measure evaluation scheduling overhead.
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    scene = bpy.context.scene
+    target = bpy.data.objects.new("Target", None)
+    scene.collection.objects.link(target)
+    for i in range(args["objects"]):
+        ob = bpy.data.objects.new("Empty", None)
+        scene.collection.objects.link(ob)
+        ob.location = (i % 100, i // 100, 0.0)
+        ob.keyframe_insert("rotation_euler", frame=1)
+        ob.rotation_euler.z = 3.0
+        ob.keyframe_insert("rotation_euler", frame=100)
+        ob.constraints.new('TRACK_TO').target = target
+
+    scene.frame_set(1)
+    return api.time_repetitions(lambda: scene.frame_set(scene.frame_current + 1), args["repeat"])
+
+
+class AnimationTest(api.Test):
+    def __init__(self, filepath, frames=50, repeat=3):
+        self.filepath = filepath
+        self.frames = frames
+        self.repeat = repeat
+
+    def name(self):
+        return self.filepath.stem
+
+    def category(self):
+        return "depsgraph"
+
+    def run(self, env):
+        return env.call_blender(
+            _run_animation, {"frames": self.frames, "repeat": self.repeat}, self.filepath)
+
+
+class ManyObjectsTest(api.Test):
+    def __init__(self, objects=10000, repeat=50):
+        self.objects = objects
+        self.repeat = repeat
+
+    def name(self):
+        return "many_objects"
+
+    def category(self):
+        return "depsgraph"
+
+    def run(self, env):
+        return env.call_blender(
+            _run_many_objects, {"objects": self.objects, "repeat": self.repeat})
+
+
+def generate(env):
+    return [ManyObjectsTest()] + [AnimationTest(filepath) for filepath in env.scene_files()]
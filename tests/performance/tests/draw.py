@@ -0,0 +1,50 @@
+# Apache License, Version 2.0
+
+import api
+
+
+def _run(args):
+    import bpy
+
+    if args["filepath"]:
+        bpy.ops.wm.open_mainfile(filepath=args["filepath"])
+    else:
+        bpy.ops.mesh.primitive_monkey_add()
+        bpy.ops.object.modifier_add(type='SUBSURF')
+        bpy.context.active_object.modifiers[-1].levels = 3
+
+    # Redraw the whole window, which includes drawing the viewport with the current settings.
+    window = bpy.context.window_manager.windows[0]
+    override = {"window": window, "screen": window.screen}
+
+    def draw():
+        bpy.ops.wm.redraw_timer(override, type='DRAW_WIN', iterations=1)
+
+    draw()
+    return api.time_repetitions(draw, args["repeat"])
+
+
+class DrawTest(api.Test):
+    def __init__(self, name, filepath=None, repeat=50):
+        self._name = name
+        self.filepath = filepath
+        self.repeat = repeat
+
+    def name(self):
+        return self._name
+
+    def category(self):
+        return "draw"
+
+    def run(self, env):
+        # Drawing needs a window, so Blender can not run in the background.
+        return env.call_blender(_run, {
+            "filepath": str(self.filepath) if self.filepath else "",
+            "repeat": self.repeat,
+        }, background=False)
+
+
+def generate(env):
+    tests = [DrawTest("monkey_subsurf")]
+    tests += [DrawTest(filepath.stem, filepath) for filepath in env.scene_files()]
+    return tests
@@ -0,0 +1,68 @@
+# Apache License, Version 2.0
+
+import api
+
+
+def _run(args):
+    import bpy
+
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+
+    bpy.ops.mesh.primitive_grid_add(x_subdivisions=100, y_subdivisions=100)
+    ob = bpy.context.active_object
+
+    # Chain the given nodes between the group input and output geometry.
+    group = bpy.data.node_groups.new("Benchmark", 'GeometryNodeTree')
+    group.inputs.new('NodeSocketGeometry', "Geometry")
+    group.outputs.new('NodeSocketGeometry', "Geometry")
+    socket = group.nodes.new('NodeGroupInput').outputs[0]
+    for node_type, settings in args["nodes"]:
+        node = group.nodes.new(node_type)
+        for key, value in settings.items():
+            node.inputs[key].default_value = value
+        group.links.new(socket, node.inputs[0])
+        socket = node.outputs[0]
+    group.links.new(socket, group.nodes.new('NodeGroupOutput').inputs[0])
+
+    modifier = ob.modifiers.new("Nodes", 'NODES')
+    modifier.node_group = group
+
+    def evaluate():
+        ob.data.vertices[0].co.z += 0.001
+        ob.data.update()
+        bpy.context.evaluated_depsgraph_get()
+
+    evaluate()
+    return api.time_repetitions(evaluate, args["repeat"])
+
+
+class GeometryNodesTest(api.Test):
+    def __init__(self, name, nodes, repeat=10):
+        self._name = name
+        self.nodes = nodes
+        self.repeat = repeat
+
+    def name(self):
+        return self._name
+
+    def category(self):
+        return "geometry_nodes"
+
+    def run(self, env):
+        return env.call_blender(_run, {"nodes": self.nodes, "repeat": self.repeat})
+
+
+def generate(env):
+    return [
+        GeometryNodesTest("subdivision_surface", [
+            ('GeometryNodeSubdivisionSurface', {"Level": 2}),
+        ]),
+        GeometryNodesTest("point_distribute_instance", [
+            ('GeometryNodePointDistribute', {"Density Max": 100.0}),
+            ('GeometryNodeTransform', {"Scale": (1.0, 1.0, 2.0)}),
+        ]),
+        GeometryNodesTest("triangulate_transform", [
+            ('GeometryNodeTriangulate', {}),
+            ('GeometryNodeTransform', {"Translation": (0.0, 0.0, 1.0)}),
+        ]),
+    ]
@@ -0,0 +1,66 @@
+# Apache License, Version 2.0
+
+import api
+
+
+def _run(args):
+    import bpy
+
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    scene = bpy.context.scene
+
+    bpy.ops.mesh.primitive_grid_add(x_subdivisions=args["resolution"],
+                                    y_subdivisions=args["resolution"])
+    ob = bpy.context.active_object
+    for modifier_type, settings in args["stack"]:
+        modifier = ob.modifiers.new(modifier_type, modifier_type)
+        for key, value in settings.items():
+            setattr(modifier, key, value)
+
+    def evaluate():
+        # Changing the location of the vertices invalidates the whole modifier stack.
+        ob.data.vertices[0].co.z += 0.001
+        ob.data.update()
+        bpy.context.evaluated_depsgraph_get()
+
+    evaluate()
+    return api.time_repetitions(evaluate, args["repeat"])
+
+
+class ModifierStackTest(api.Test):
+    def __init__(self, name, stack, resolution=200, repeat=10):
+        self._name = name
+        self.stack = stack
+        self.resolution = resolution
+        self.repeat = repeat
+
+    def name(self):
+        return self._name
+
+    def category(self):
+        return "modifiers"
+
+    def run(self, env):
+        return env.call_blender(_run, {
+            "stack": self.stack,
+            "resolution": self.resolution,
+            "repeat": self.repeat,
+        })
+
+
+def generate(env):
+    return [
+        ModifierStackTest("subsurf", [("SUBSURF", {"levels": 2})]),
+        ModifierStackTest("displace_smooth", [
+            ("DISPLACE", {"strength": 0.1}),
+            ("SMOOTH", {"iterations": 10}),
+        ]),
+        ModifierStackTest("array_bevel", [
+            ("ARRAY", {"count": 4}),
+            ("BEVEL", {"segments": 2}),
+        ], resolution=100),
+        ModifierStackTest("solidify_weld", [
+            ("SOLIDIFY", {"thickness": 0.1}),
+            ("WELD", {"merge_threshold": 0.01}),
+        ]),
+    ]
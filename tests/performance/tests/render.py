@@ -0,0 +1,62 @@
+# Apache License, Version 2.0
+
+import api
+
+
+def _run(args):
+    import bpy
+
+    if args["filepath"]:
+        bpy.ops.wm.open_mainfile(filepath=args["filepath"], load_ui=False)
+    else:
+        bpy.ops.wm.read_factory_settings(use_empty=False)
+        for i in range(args["objects"]):
+            bpy.ops.mesh.primitive_uv_sphere_add(location=(i % 20, i // 20, 0.0))
+
+    # Render a tiny image with a single sample, so the time is dominated by exporting the scene
+    # to the render engine rather than by the rendering itself.
+    scene = bpy.context.scene
+    scene.render.engine = args["engine"]
+    scene.render.resolution_x = 32
+    scene.render.resolution_y = 32
+    scene.render.resolution_percentage = 100
+    if args["engine"] == 'CYCLES':
+        scene.cycles.samples = 1
+        scene.cycles.device = 'CPU'
+
+    def render():
+        bpy.ops.render.render()
+
+    return api.time_repetitions(render, args["repeat"])
+
+
+class RenderSyncTest(api.Test):
+    def __init__(self, name, engine, filepath=None, objects=400, repeat=3):
+        self._name = name
+        self.engine = engine
+        self.filepath = filepath
+        self.objects = objects
+        self.repeat = repeat
+
+    def name(self):
+        return self._name
+
+    def category(self):
+        return "render_sync"
+
+    def run(self, env):
+        return env.call_blender(_run, {
+            "engine": self.engine,
+            "filepath": str(self.filepath) if self.filepath else "",
+            "objects": self.objects,
+            "repeat": self.repeat,
+        })
+
+
+def generate(env):
+    tests = [RenderSyncTest("cycles_spheres", 'CYCLES')]
+    tests += [
+        RenderSyncTest("cycles_" + filepath.stem, 'CYCLES', filepath)
+        for filepath in env.scene_files()
+    ]
+    return tests